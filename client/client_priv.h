@@ -100,6 +100,9 @@ enum options_client
   OPT_SKIP_ANNOTATE_ROWS_EVENTS,
   OPT_SSL_CRL, OPT_SSL_CRLPATH,
   OPT_PRINT_ROW_COUNT, OPT_PRINT_ROW_EVENT_POSITIONS,
+  OPT_DUMP_PARALLEL,
+  OPT_IMPORT_SPLIT_SIZE,
+  OPT_SLAP_PERCENTILES, OPT_SLAP_RATE,
   OPT_MAX_CLIENT_OPTION /* should be always the last */
 };
 
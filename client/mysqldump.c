@@ -118,6 +118,7 @@ static my_bool  verbose= 0, opt_no_create_info= 0, opt_no_data= 0, opt_no_data_m
 static my_bool insert_pat_inited= 0, debug_info_flag= 0, debug_check_flag= 0,
                select_field_names_inited= 0;
 static ulong opt_max_allowed_packet, opt_net_buffer_length;
+static uint opt_parallel= 0;
 static MYSQL mysql_connection,*mysql=0;
 static DYNAMIC_STRING insert_pat, select_field_names;
 static char  *opt_password=0,*current_user=0,
@@ -458,6 +459,12 @@ static struct my_option my_long_options[] =
   {"order-by-primary", OPT_ORDER_BY_PRIMARY,
    "Sorts each table's rows by primary key, or first unique key, if such a key exists.  Useful when dumping a MyISAM table to be loaded into an InnoDB table, but will make the dump itself take considerably longer.",
    &opt_order_by_primary, &opt_order_by_primary, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
+  {"parallel", OPT_DUMP_PARALLEL,
+   "Number of additional connections that write the data files of --tab. "
+   "They all read the same consistent snapshot, so this requires "
+   "--single-transaction.",
+   &opt_parallel, &opt_parallel, 0, GET_UINT, REQUIRED_ARG, 0, 0, 256, 0, 0,
+   0},
   {"password", 'p',
    "Password to use when connecting to server. If password is not given it's solicited on the tty.",
    0, 0, 0, GET_STR, OPT_ARG, 0, 0, 0, 0, 0, 0},
@@ -581,6 +588,7 @@ static int dump_tablespaces_for_tables(char *db, char **table_names, int tables)
 static int dump_tablespaces_for_databases(char** databases);
 static int dump_tablespaces(char* ts_where);
 static void print_comment(FILE *, my_bool, const char *, ...);
+static void add_parallel_dump(const char *db, const char *query);
 
 /*
   Print the supplied message if in verbose mode
@@ -1050,6 +1058,12 @@ static int get_options(int *argc, char ***argv)
   }
   if (opt_single_transaction || opt_lock_all_tables)
     lock_tables= 0;
+  if (opt_parallel && (!path || !opt_single_transaction))
+  {
+    fprintf(stderr, "%s: --parallel requires --tab and "
+            "--single-transaction.\n", my_progname_short);
+    return(EX_USAGE);
+  }
   if (enclosed && opt_enclosed)
   {
     fprintf(stderr, "%s: You can't use ..enclosed.. and ..optionally-enclosed.. at the same time.\n", my_progname_short);
@@ -1685,51 +1699,52 @@ static void maybe_exit(int error)
 
 
 /*
-  db_connect -- connects to the host and selects DB.
+  connect_to_server -- connects to the host and sets up the session
+  for dumping.
 */
 
-static int connect_to_db(char *host, char *user,char *passwd)
+static int connect_to_server(MYSQL *mysql_con, char *host, char *user,
+                             char *passwd)
 {
   char buff[20+FN_REFLEN];
   my_bool reconnect;
-  DBUG_ENTER("connect_to_db");
+  DBUG_ENTER("connect_to_server");
 
   verbose_msg("-- Connecting to %s...\n", host ? host : "localhost");
-  mysql_init(&mysql_connection);
+  mysql_init(mysql_con);
   if (opt_compress)
-    mysql_options(&mysql_connection,MYSQL_OPT_COMPRESS,NullS);
+    mysql_options(mysql_con,MYSQL_OPT_COMPRESS,NullS);
 #ifdef HAVE_OPENSSL
   if (opt_use_ssl)
   {
-    mysql_ssl_set(&mysql_connection, opt_ssl_key, opt_ssl_cert, opt_ssl_ca,
+    mysql_ssl_set(mysql_con, opt_ssl_key, opt_ssl_cert, opt_ssl_ca,
                   opt_ssl_capath, opt_ssl_cipher);
-    mysql_options(&mysql_connection, MYSQL_OPT_SSL_CRL, opt_ssl_crl);
-    mysql_options(&mysql_connection, MYSQL_OPT_SSL_CRLPATH, opt_ssl_crlpath);
+    mysql_options(mysql_con, MYSQL_OPT_SSL_CRL, opt_ssl_crl);
+    mysql_options(mysql_con, MYSQL_OPT_SSL_CRLPATH, opt_ssl_crlpath);
   }
-  mysql_options(&mysql_connection,MYSQL_OPT_SSL_VERIFY_SERVER_CERT,
+  mysql_options(mysql_con,MYSQL_OPT_SSL_VERIFY_SERVER_CERT,
                 (char*)&opt_ssl_verify_server_cert);
 #endif
   if (opt_protocol)
-    mysql_options(&mysql_connection,MYSQL_OPT_PROTOCOL,(char*)&opt_protocol);
-  mysql_options(&mysql_connection, MYSQL_SET_CHARSET_NAME, default_charset);
+    mysql_options(mysql_con,MYSQL_OPT_PROTOCOL,(char*)&opt_protocol);
+  mysql_options(mysql_con, MYSQL_SET_CHARSET_NAME, default_charset);
 
   if (opt_plugin_dir && *opt_plugin_dir)
-    mysql_options(&mysql_connection, MYSQL_PLUGIN_DIR, opt_plugin_dir);
+    mysql_options(mysql_con, MYSQL_PLUGIN_DIR, opt_plugin_dir);
 
   if (opt_default_auth && *opt_default_auth)
-    mysql_options(&mysql_connection, MYSQL_DEFAULT_AUTH, opt_default_auth);
+    mysql_options(mysql_con, MYSQL_DEFAULT_AUTH, opt_default_auth);
 
-  mysql_options(&mysql_connection, MYSQL_OPT_CONNECT_ATTR_RESET, 0);
-  mysql_options4(&mysql_connection, MYSQL_OPT_CONNECT_ATTR_ADD,
+  mysql_options(mysql_con, MYSQL_OPT_CONNECT_ATTR_RESET, 0);
+  mysql_options4(mysql_con, MYSQL_OPT_CONNECT_ATTR_ADD,
                  "program_name", "mysqldump");
-  mysql= &mysql_connection;          /* So we can mysql_close() it properly */
-  if (!mysql_real_connect(&mysql_connection,host,user,passwd,
+  if (!mysql_real_connect(mysql_con,host,user,passwd,
                           NULL,opt_mysql_port,opt_mysql_unix_port, 0))
   {
-    DB_error(&mysql_connection, "when trying to connect");
+    DB_error(mysql_con, "when trying to connect");
     DBUG_RETURN(1);
   }
-  if ((mysql_get_server_version(&mysql_connection) < 40100) ||
+  if ((mysql_get_server_version(mysql_con) < 40100) ||
       (opt_compatible_mode & 3))
   {
     /* Don't dump SET NAMES with a pre-4.1 server (bug#7997).  */
@@ -1743,10 +1758,10 @@ static int connect_to_db(char *host, char *user,char *passwd)
     cannot reconnect.
   */
   reconnect= 0;
-  mysql_options(&mysql_connection, MYSQL_OPT_RECONNECT, &reconnect);
+  mysql_options(mysql_con, MYSQL_OPT_RECONNECT, &reconnect);
   my_snprintf(buff, sizeof(buff), "/*!40100 SET @@SQL_MODE='%s' */",
               compatible_mode_normal_str);
-  if (mysql_query_with_error_report(mysql, 0, buff))
+  if (mysql_query_with_error_report(mysql_con, 0, buff))
     DBUG_RETURN(1);
   /*
     set time_zone to UTC to allow dumping date types between servers with
@@ -1755,10 +1770,17 @@ static int connect_to_db(char *host, char *user,char *passwd)
   if (opt_tz_utc)
   {
     my_snprintf(buff, sizeof(buff), "/*!40103 SET TIME_ZONE='+00:00' */");
-    if (mysql_query_with_error_report(mysql, 0, buff))
+    if (mysql_query_with_error_report(mysql_con, 0, buff))
       DBUG_RETURN(1);
   }
   DBUG_RETURN(0);
+} /* connect_to_server */
+
+
+static int connect_to_db(char *host, char *user,char *passwd)
+{
+  mysql= &mysql_connection;          /* So we can mysql_close() it properly */
+  return connect_to_server(&mysql_connection, host, user, passwd);
 } /* connect_to_db */
 
 
@@ -3793,7 +3815,10 @@ static void dump_table(char *table, char *db)
       order_by= 0;
     }
 
-    if (mysql_real_query(mysql, query_string.str, (ulong)query_string.length))
+    if (opt_parallel)
+      add_parallel_dump(db, query_string.str);
+    else if (mysql_real_query(mysql, query_string.str,
+                              (ulong)query_string.length))
     {
       dynstr_free(&query_string);
       DB_error(mysql, "when executing 'SELECT INTO OUTFILE'");
@@ -5533,6 +5558,231 @@ static int start_transaction(MYSQL *mysql_con)
 }
 
 
+/*
+  With --parallel the data files of --tab are written by extra connections.
+
+  The connections start their transactions while the main connection holds
+  FLUSH TABLES WITH READ LOCK, so they all read the same snapshot as the
+  main connection. dump_table() queues the SELECT ... INTO OUTFILE of every
+  table and the first idle worker executes it.
+*/
+
+typedef struct st_parallel_dump_job
+{
+  struct st_parallel_dump_job *next;
+  char *db;
+  char *query;
+} PARALLEL_DUMP_JOB;
+
+static MYSQL *parallel_connections= 0;
+static pthread_t *parallel_threads= 0;
+static uint parallel_connection_count= 0, parallel_thread_count= 0;
+static pthread_mutex_t parallel_mutex;
+static pthread_cond_t parallel_cond;
+static PARALLEL_DUMP_JOB *parallel_jobs= 0;
+static PARALLEL_DUMP_JOB **parallel_jobs_last= &parallel_jobs;
+/* No more jobs will be queued */
+static my_bool parallel_end= 0;
+/* A job failed, and without --force the remaining ones are skipped */
+static my_bool parallel_error= 0;
+
+
+pthread_handler_t parallel_dump_worker(void *arg)
+{
+  MYSQL *mysql_con= (MYSQL*) arg;
+  char current_db[FN_REFLEN];
+  PARALLEL_DUMP_JOB *job;
+
+  current_db[0]= 0;
+  if (mysql_thread_init())
+  {
+    fprintf(stderr, "%s: mysql_thread_init() failed\n", my_progname_short);
+    pthread_mutex_lock(&parallel_mutex);
+    parallel_error= 1;
+    if (!first_error)
+      first_error= EX_MYSQLERR;
+    pthread_mutex_unlock(&parallel_mutex);
+    return 0;
+  }
+
+  pthread_mutex_lock(&parallel_mutex);
+  for (;;)
+  {
+    const char *when= 0;
+
+    while (!parallel_jobs && !parallel_end)
+      pthread_cond_wait(&parallel_cond, &parallel_mutex);
+    if (!(job= parallel_jobs))
+      break;
+    if (!(parallel_jobs= job->next))
+      parallel_jobs_last= &parallel_jobs;
+    if (parallel_error && !ignore_errors)
+    {
+      my_free(job);
+      continue;
+    }
+    pthread_mutex_unlock(&parallel_mutex);
+
+    if (strcmp(current_db, job->db))
+    {
+      if (mysql_select_db(mysql_con, job->db))
+        when= "when selecting the database";
+      else
+        strmake_buf(current_db, job->db);
+    }
+    if (!when && mysql_real_query(mysql_con, job->query,
+                                  (ulong) strlen(job->query)))
+      when= "when executing 'SELECT INTO OUTFILE'";
+    my_free(job);
+
+    pthread_mutex_lock(&parallel_mutex);
+    if (when)
+    {
+      fprintf(stderr, "%s: Got error: %d: \"%s\" %s\n", my_progname_short,
+              mysql_errno(mysql_con), mysql_error(mysql_con), when);
+      fflush(stderr);
+      parallel_error= 1;
+      if (!first_error)
+        first_error= EX_MYSQLERR;
+    }
+  }
+  pthread_mutex_unlock(&parallel_mutex);
+  mysql_thread_end();
+  return 0;
+}
+
+
+/*
+  Open the --parallel connections and start the workers
+
+  Must be called while the main connection holds FLUSH TABLES WITH READ LOCK.
+*/
+
+static int start_parallel_dump()
+{
+  uint i;
+  DBUG_ENTER("start_parallel_dump");
+
+  verbose_msg("-- Starting %u parallel connections...\n", opt_parallel);
+  if (!(parallel_connections= (MYSQL*) my_malloc(opt_parallel * sizeof(MYSQL),
+                                                 MYF(MY_WME))) ||
+      !(parallel_threads= (pthread_t*) my_malloc(opt_parallel *
+                                                 sizeof(pthread_t),
+                                                 MYF(MY_WME))))
+    DBUG_RETURN(1);
+  pthread_mutex_init(&parallel_mutex, NULL);
+  pthread_cond_init(&parallel_cond, NULL);
+
+  for (i= 0; i < opt_parallel; i++)
+  {
+    MYSQL *mysql_con= &parallel_connections[i];
+    parallel_connection_count++;       /* connect_to_server() initializes it */
+    if (connect_to_server(mysql_con, current_host, current_user,
+                          opt_password) ||
+        start_transaction(mysql_con))
+      DBUG_RETURN(1);
+  }
+  for (i= 0; i < opt_parallel; i++)
+  {
+    if (pthread_create(&parallel_threads[i], NULL, parallel_dump_worker,
+                       &parallel_connections[i]))
+    {
+      fprintf(stderr, "%s: Could not create thread\n", my_progname_short);
+      DBUG_RETURN(1);
+    }
+    parallel_thread_count++;
+  }
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Queue a query for the --parallel workers
+*/
+
+static void add_parallel_dump(const char *db, const char *query)
+{
+  PARALLEL_DUMP_JOB *job;
+  char *db_copy, *query_copy;
+
+  if (!my_multi_malloc(MYF(MY_WME),
+                       &job, sizeof(*job),
+                       &db_copy, strlen(db) + 1,
+                       &query_copy, strlen(query) + 1,
+                       NullS))
+    die(EX_EOM, "Couldn't allocate memory");
+  job->next= 0;
+  job->db= db_copy;
+  job->query= query_copy;
+  strmov(db_copy, db);
+  strmov(query_copy, query);
+
+  pthread_mutex_lock(&parallel_mutex);
+  *parallel_jobs_last= job;
+  parallel_jobs_last= &job->next;
+  pthread_cond_signal(&parallel_cond);
+  pthread_mutex_unlock(&parallel_mutex);
+}
+
+
+/*
+  Wait until the --parallel workers have executed all queued queries and
+  close their connections
+
+  RETURN
+    0  ok
+    1  a query failed, the error has been reported
+*/
+
+static int end_parallel_dump()
+{
+  PARALLEL_DUMP_JOB *job, *next;
+  uint i;
+  int error;
+  DBUG_ENTER("end_parallel_dump");
+
+  if (!parallel_threads)
+  {
+    my_free(parallel_connections);
+    parallel_connections= 0;
+    DBUG_RETURN(0);
+  }
+
+  pthread_mutex_lock(&parallel_mutex);
+  parallel_end= 1;
+  pthread_cond_broadcast(&parallel_cond);
+  pthread_mutex_unlock(&parallel_mutex);
+  for (i= 0; i < parallel_thread_count; i++)
+  {
+    if (pthread_join(parallel_threads[i], NULL))
+      fprintf(stderr, "%s: Could not join worker thread.\n",
+              my_progname_short);
+  }
+  for (i= 0; i < parallel_connection_count; i++)
+    mysql_close(&parallel_connections[i]);
+
+  /* Left over if no worker could be started */
+  for (job= parallel_jobs; job; job= next)
+  {
+    next= job->next;
+    my_free(job);
+  }
+  error= parallel_error;
+
+  pthread_mutex_destroy(&parallel_mutex);
+  pthread_cond_destroy(&parallel_cond);
+  my_free(parallel_threads);
+  my_free(parallel_connections);
+  parallel_threads= 0;
+  parallel_connections= 0;
+  parallel_connection_count= parallel_thread_count= 0;
+  parallel_jobs= 0;
+  parallel_jobs_last= &parallel_jobs;
+  parallel_end= parallel_error= 0;
+  DBUG_RETURN(error);
+}
+
+
 static ulong find_set(TYPELIB *lib, const char *x, size_t length,
                       char **err_pos, uint *err_len)
 {
@@ -6127,8 +6377,12 @@ int main(int argc, char **argv)
     consistent_binlog_pos= check_consistent_binlog_pos(NULL, NULL);
   }
 
+  /*
+    The --parallel connections must start their transactions while the
+    tables are locked to see the same snapshot as this one.
+  */
   if ((opt_lock_all_tables || (opt_master_data && !consistent_binlog_pos) ||
-       (opt_single_transaction && flush_logs)) &&
+       (opt_single_transaction && flush_logs) || opt_parallel) &&
       do_flush_tables_read_lock(mysql))
     goto err;
 
@@ -6160,6 +6414,9 @@ int main(int argc, char **argv)
   if (opt_single_transaction && start_transaction(mysql))
     goto err;
 
+  if (opt_parallel && start_parallel_dump())
+    goto err;
+
   /* Add 'STOP SLAVE to beginning of dump */
   if (opt_slave_apply && add_stop_slave())
     goto err;
@@ -6221,6 +6478,9 @@ int main(int argc, char **argv)
   if (opt_slave_apply && add_slave_statements())
     goto err;
 
+  if (opt_parallel && end_parallel_dump())
+    goto err;
+
   /* ensure dumped data flushed */
   if (md_result_file && fflush(md_result_file))
   {
@@ -6239,6 +6499,9 @@ int main(int argc, char **argv)
     server.
   */
 err:
+  if (opt_parallel)
+    end_parallel_dump();
+
   /* if --dump-slave , start the slave sql thread */
   if (opt_slave_data)
     do_start_slave_sql(mysql);
@@ -31,6 +31,7 @@
 
 #include "client_priv.h"
 #include "mysql_version.h"
+#include "errmsg.h"
 
 #include <welcome_copyright_notice.h>   /* ORACLE_WELCOME_COPYRIGHT_NOTICE */
 
@@ -41,6 +42,16 @@ pthread_mutex_t init_mutex;
 pthread_mutex_t counter_mutex;
 pthread_cond_t count_threshhold;
 
+/* A part of a file that is loaded over its own connection */
+typedef struct st_import_chunk
+{
+  char *filename;
+  my_off_t start, end;
+  /* State of the LOAD DATA LOCAL INFILE handler */
+  File file;
+  int error;
+} IMPORT_CHUNK;
+
 static void db_error_with_table(MYSQL *mysql, char *table);
 static void db_error(MYSQL *mysql);
 static char *field_escape(char *to,const char *from,uint length);
@@ -49,7 +60,7 @@ static char *add_load_option(char *ptr,const char *object,
 
 static my_bool	verbose=0,lock_tables=0,ignore_errors=0,opt_delete=0,
 		replace=0,silent=0,ignore=0,opt_compress=0,
-                opt_low_priority= 0, tty_password= 0;
+                opt_low_priority= 0, tty_password= 0, opt_disable_keys= 0;
 static my_bool debug_info_flag= 0, debug_check_flag= 0;
 static uint opt_use_threads=0, opt_local_file=0, my_end_arg= 0;
 static char	*opt_password=0, *current_user=0,
@@ -61,6 +72,7 @@ static uint     opt_mysql_port= 0, opt_protocol= 0;
 static char * opt_mysql_unix_port=0;
 static char *opt_plugin_dir= 0, *opt_default_auth= 0;
 static longlong opt_ignore_lines= -1;
+static ulonglong opt_split_size= 0;
 #include <sslopt-vars.h>
 
 static char **argv_to_free;
@@ -94,6 +106,10 @@ static struct my_option my_long_options[] =
    GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
   {"delete", 'd', "First delete all rows from table.", &opt_delete,
    &opt_delete, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
+  {"disable-keys", 'K',
+   "Disable the non-unique keys of the table while loading it, and rebuild "
+   "them afterwards.", &opt_disable_keys, &opt_disable_keys, 0, GET_BOOL,
+   NO_ARG, 0, 0, 0, 0, 0, 0},
   {"fields-terminated-by", OPT_FTB,
    "Fields in the input file are terminated by the given string.", 
    &fields_terminated, &fields_terminated, 0, 
@@ -162,6 +178,14 @@ static struct my_option my_long_options[] =
   {"socket", 'S', "The socket file to use for connection.",
    &opt_mysql_unix_port, &opt_mysql_unix_port, 0, GET_STR,
    REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"split-size", OPT_IMPORT_SPLIT_SIZE,
+   "Split files bigger than this into chunks at line boundaries, and load "
+   "the chunks of a file in parallel. Requires --local and --use-threads. "
+   "Files that use --fields-enclosed-by, --fields-optionally-enclosed-by, "
+   "--fields-escaped-by or --lines-terminated-by are not split. "
+   "0 means never split.",
+   &opt_split_size, &opt_split_size, 0, GET_ULL, REQUIRED_ARG, 0, 0, 0, 0, 0,
+   0},
 #include <sslopt-longopts.h>
   {"use-threads", OPT_USE_THREADS,
    "Load files in parallel. The argument is the number "
@@ -283,6 +307,11 @@ static int get_options(int *argc, char ***argv)
     fprintf(stderr, "You can't use --ignore (-i) and --replace (-r) at the same time.\n");
     return(1);
   }
+  if (opt_split_size && (!opt_local_file || !opt_use_threads || lock_tables))
+  {
+    fprintf(stderr, "You must use --split-size with --local and --use-threads, and without --lock-tables.\n");
+    return(1);
+  }
   if (*argc < 2)
   {
     usage();
@@ -297,11 +326,116 @@ static int get_options(int *argc, char ***argv)
 
 
 
-static int write_to_table(char *filename, MYSQL *mysql)
+/* Append the table name quoted with ` */
+
+static char *add_table_name(char *end, const char *tablename)
+{
+  const char *pos;
+
+  *end++= '`';
+  /* Turn any ` into `` in table name. */
+  for (pos= tablename; *pos; pos++)
+  {
+    if (*pos == '`')
+      *end++= '`';
+    *end++= *pos;
+  }
+  *end++= '`';
+  *end= '\0';
+  return end;
+}
+
+
+static int table_query(MYSQL *mysql, const char *prefix, char *tablename,
+                       const char *suffix)
+{
+  char sql_statement[FN_REFLEN*2+64];
+
+  strmov(add_table_name(strmov(sql_statement, prefix), tablename), suffix);
+  if (mysql_query(mysql, sql_statement))
+  {
+    db_error_with_table(mysql, tablename);
+    return 1;
+  }
+  return 0;
+}
+
+
+/*
+  LOAD DATA LOCAL INFILE handler that reads only the bytes of a chunk
+*/
+
+static int chunk_infile_init(void **ptr, const char *filename
+                             __attribute__((unused)), void *userdata)
+{
+  IMPORT_CHUNK *chunk= (IMPORT_CHUNK*) userdata;
+
+  *ptr= chunk;
+  chunk->error= 0;
+  if ((chunk->file= my_open(chunk->filename, O_RDONLY | O_BINARY,
+                            MYF(0))) < 0 ||
+      my_seek(chunk->file, chunk->start, MY_SEEK_SET, MYF(0)) ==
+      MY_FILEPOS_ERROR)
+  {
+    chunk->error= my_errno;
+    return 1;
+  }
+  return 0;
+}
+
+
+static int chunk_infile_read(void *ptr, char *buf, uint buf_len)
+{
+  IMPORT_CHUNK *chunk= (IMPORT_CHUNK*) ptr;
+  my_off_t pos= my_tell(chunk->file, MYF(0));
+  size_t length;
+
+  if (pos >= chunk->end)
+    return 0;
+  length= (size_t) MY_MIN(buf_len, chunk->end - pos);
+  if ((length= my_read(chunk->file, (uchar*) buf, length, MYF(0))) ==
+      (size_t) -1)
+  {
+    chunk->error= my_errno;
+    return -1;
+  }
+  return (int) length;
+}
+
+
+static void chunk_infile_end(void *ptr)
+{
+  IMPORT_CHUNK *chunk= (IMPORT_CHUNK*) ptr;
+
+  if (chunk->file >= 0)
+    my_close(chunk->file, MYF(0));
+  chunk->file= -1;
+}
+
+
+static int chunk_infile_error(void *ptr, char *error_msg, uint error_msg_len)
+{
+  IMPORT_CHUNK *chunk= (IMPORT_CHUNK*) ptr;
+
+  my_snprintf(error_msg, error_msg_len, "Can't read file '%s' (errno: %d)",
+              chunk->filename, chunk->error);
+  return CR_UNKNOWN_ERROR;
+}
+
+
+/*
+  Load a file, or only a chunk of it, into the table named after the file
+
+  --delete and --disable-keys are not done for a chunk: the caller does them
+  once for all chunks of the file.
+*/
+
+static int write_to_table(char *filename, MYSQL *mysql, IMPORT_CHUNK *chunk)
 {
   char tablename[FN_REFLEN], hard_path[FN_REFLEN],
        escaped_name[FN_REFLEN * 2 + 1],
-       sql_statement[FN_REFLEN*16+256], *end, *pos;
+       sql_statement[FN_REFLEN*16+256], *end;
+  ulonglong start_time;
   DBUG_ENTER("write_to_table");
   DBUG_PRINT("enter",("filename: %s",filename));
 
@@ -311,7 +445,7 @@ static int write_to_table(char *filename, MYSQL *mysql)
   else
     my_load_path(hard_path, filename, NULL); /* filename includes the path */
 
-  if (opt_delete)
+  if (opt_delete && !chunk)
   {
     if (verbose)
       fprintf(stdout, "Deleting the old data from table %s\n", tablename);
@@ -326,10 +460,17 @@ static int write_to_table(char *filename, MYSQL *mysql)
       DBUG_RETURN(1);
     }
   }
+  if (opt_disable_keys && !chunk &&
+      table_query(mysql, "ALTER TABLE ", tablename, " DISABLE KEYS"))
+    DBUG_RETURN(1);
   to_unix_path(hard_path);
   if (verbose)
   {
-    if (opt_local_file)
+    if (chunk)
+      fprintf(stdout, "Loading bytes %llu-%llu of LOCAL file: %s into %s\n",
+              (ulonglong) chunk->start, (ulonglong) chunk->end, hard_path,
+              tablename);
+    else if (opt_local_file)
       fprintf(stdout, "Loading data from LOCAL file: %s into %s\n",
 	      hard_path, tablename);
     else
@@ -346,15 +487,7 @@ static int write_to_table(char *filename, MYSQL *mysql)
     end= strmov(end, " REPLACE");
   if (ignore)
     end= strmov(end, " IGNORE");
-  end= strmov(end, " INTO TABLE `");
-  /* Turn any ` into `` in table name. */
-  for (pos= tablename; *pos; pos++)
-  {
-    if (*pos == '`')
-      *end++= '`';
-    *end++= *pos;
-  }
-  end= strmov(end, "`");
+  end= add_table_name(strmov(end, " INTO TABLE "), tablename);
 
   if (fields_terminated || enclosed || opt_enclosed || escaped)
       end= strmov(end, " FIELDS");
@@ -364,18 +497,36 @@ static int write_to_table(char *filename, MYSQL *mysql)
 		       " OPTIONALLY ENCLOSED BY");
   end= add_load_option(end, escaped, " ESCAPED BY");
   end= add_load_option(end, lines_terminated, " LINES TERMINATED BY");
-  if (opt_ignore_lines >= 0)
+  if (opt_ignore_lines >= 0 && (!chunk || !chunk->start))
     end= strmov(longlong10_to_str(opt_ignore_lines, 
 				  strmov(end, " IGNORE "),10), " LINES");
   if (opt_columns)
     end= strmov(strmov(strmov(end, " ("), opt_columns), ")");
   *end= '\0';
 
+  if (chunk)
+    mysql_set_local_infile_handler(mysql, chunk_infile_init,
+                                   chunk_infile_read, chunk_infile_end,
+                                   chunk_infile_error, chunk);
+  start_time= microsecond_interval_timer();
   if (mysql_query(mysql, sql_statement))
   {
     db_error_with_table(mysql, tablename);
     DBUG_RETURN(1);
   }
+  if (chunk)
+  {
+    mysql_set_local_infile_default(mysql);
+    if (verbose)
+    {
+      double seconds= (microsecond_interval_timer() - start_time) / 1e6;
+      fprintf(stdout, "Loaded bytes %llu-%llu of %s in %.2f seconds "
+              "(%.2f MB/s)\n",
+              (ulonglong) chunk->start, (ulonglong) chunk->end, hard_path,
+              seconds, seconds > 0 ?
+              (chunk->end - chunk->start) / seconds / (1024 * 1024) : 0.0);
+    }
+  }
   if (!silent)
   {
     if (mysql_info(mysql)) /* If NULL-pointer, print nothing */
@@ -384,6 +535,9 @@ static int write_to_table(char *filename, MYSQL *mysql)
 	      mysql_info(mysql));
     }
   }
+  if (opt_disable_keys && !chunk &&
+      table_query(mysql, "ALTER TABLE ", tablename, " ENABLE KEYS"))
+    DBUG_RETURN(1);
   DBUG_RETURN(0);
 }
 
@@ -603,7 +757,7 @@ pthread_handler_t worker_thread(void *arg)
   /*
     We are not currently catching the error here.
   */
-  if((error= write_to_table(raw_table_name, mysql)))
+  if((error= write_to_table(raw_table_name, mysql, NULL)))
     if (exitcode == 0)
       exitcode= error;
 
@@ -621,6 +775,199 @@ pthread_handler_t worker_thread(void *arg)
 }
 
 
+pthread_handler_t chunk_worker_thread(void *arg)
+{
+  int error;
+  IMPORT_CHUNK *chunk= (IMPORT_CHUNK*) arg;
+  MYSQL *mysql= 0;
+
+  if (mysql_thread_init())
+    goto error;
+
+  if (!(mysql= db_connect(current_host,current_db,current_user,opt_password)))
+    goto error;
+
+  if (mysql_query(mysql, "/*!40101 set @@character_set_database=binary */;"))
+  {
+    db_error(mysql); /* We shall countinue here, if --force was given */
+    goto error;
+  }
+
+  if ((error= write_to_table(chunk->filename, mysql, chunk)))
+    if (exitcode == 0)
+      exitcode= error;
+
+error:
+  if (mysql)
+    db_disconnect(current_host, mysql);
+
+  pthread_mutex_lock(&counter_mutex);
+  counter--;
+  pthread_cond_signal(&count_threshhold);
+  pthread_mutex_unlock(&counter_mutex);
+  mysql_thread_end();
+  pthread_exit(0);
+  return 0;
+}
+
+
+/*
+  Find the end of the chunk of a file that starts at start
+
+  The chunk ends after the first line terminator that follows the first
+  opt_split_size bytes, so that no line is split. A newline that is escaped
+  by a backslash, or that may be, is not a line terminator.
+*/
+
+static my_off_t find_chunk_end(File file, my_off_t start, my_off_t file_length)
+{
+  uchar buff[IO_SIZE];
+  my_off_t pos;
+  uint escapes= 0;
+  my_bool escapes_known= 0;
+
+  if (file_length - start <= opt_split_size)
+    return file_length;
+  /* Start at the last byte of the chunk, to see if it escapes a newline */
+  pos= start + opt_split_size - 1;
+  if (my_seek(file, pos, MY_SEEK_SET, MYF(0)) == MY_FILEPOS_ERROR)
+    return file_length;
+  for (;;)
+  {
+    size_t length= my_read(file, buff, sizeof(buff), MYF(0)), i;
+    if (!length || length == (size_t) -1)
+      return file_length;
+    for (i= 0; i < length; i++)
+    {
+      if (buff[i] == '\n' && escapes_known && !(escapes & 1))
+        return pos + i + 1;
+      if (buff[i] == '\\')
+        escapes++;
+      else
+      {
+        escapes= 0;
+        escapes_known= 1;
+      }
+    }
+    pos+= length;
+  }
+}
+
+
+/*
+  Load the files one after another, each file in chunks over up to
+  opt_use_threads connections
+*/
+
+static int load_files_in_chunks(char **argv)
+{
+  MYSQL *mysql;
+  DYNAMIC_ARRAY chunks;
+  pthread_t *worker_threads= 0;
+  uint worker_thread_count, i;
+  my_bool can_split= !(enclosed || opt_enclosed || escaped ||
+                       lines_terminated);
+
+  if (!(mysql= db_connect(current_host,current_db,current_user,opt_password)))
+    return 1;
+  if (my_init_dynamic_array(&chunks, sizeof(IMPORT_CHUNK), 16, 16, MYF(0)))
+  {
+    db_disconnect(current_host, mysql);
+    return 1;
+  }
+
+  for (; *argv != NULL; argv++)
+  {
+    char tablename[FN_REFLEN];
+    IMPORT_CHUNK chunk;
+    my_off_t file_length;
+    File file;
+
+    fn_format(tablename, *argv, "", "", 1 | 2);
+    if ((file= my_open(*argv, O_RDONLY | O_BINARY, MYF(MY_WME))) < 0)
+    {
+      if (exitcode == 0)
+        exitcode= 1;
+      if (!ignore_errors)
+        break;
+      continue;
+    }
+    file_length= my_seek(file, 0L, MY_SEEK_END, MYF(0));
+    reset_dynamic(&chunks);
+    chunk.filename= *argv;
+    chunk.file= -1;
+    chunk.error= 0;
+    chunk.start= 0;
+    do
+    {
+      chunk.end= can_split ? find_chunk_end(file, chunk.start, file_length) :
+                             file_length;
+      if (insert_dynamic(&chunks, (uchar*) &chunk))
+        break;
+      chunk.start= chunk.end;
+    } while (chunk.start < file_length);
+    my_close(file, MYF(0));
+
+    if (opt_delete && verbose)
+      fprintf(stdout, "Deleting the old data from table %s\n", tablename);
+    if ((opt_delete && table_query(mysql, "DELETE FROM ", tablename, "")) ||
+        (opt_disable_keys &&
+         table_query(mysql, "ALTER TABLE ", tablename, " DISABLE KEYS")))
+    {
+      if (exitcode == 0)
+        exitcode= 1;
+      continue;
+    }
+
+    if (!(worker_threads= (pthread_t*) my_realloc(worker_threads,
+                                                  chunks.elements *
+                                                  sizeof(*worker_threads),
+                                                  MYF(MY_ALLOW_ZERO_PTR |
+                                                      MY_FREE_ON_ERROR))))
+      break;
+    for (worker_thread_count= 0, i= 0; i < chunks.elements; i++)
+    {
+      pthread_mutex_lock(&counter_mutex);
+      while (counter == opt_use_threads)
+      {
+        struct timespec abstime;
+
+        set_timespec(abstime, 3);
+        pthread_cond_timedwait(&count_threshhold, &counter_mutex, &abstime);
+      }
+      counter++;
+      pthread_mutex_unlock(&counter_mutex);
+      if (pthread_create(&worker_threads[worker_thread_count], NULL,
+                         chunk_worker_thread,
+                         dynamic_element(&chunks, i, IMPORT_CHUNK*)) != 0)
+      {
+        pthread_mutex_lock(&counter_mutex);
+        counter--;
+        pthread_mutex_unlock(&counter_mutex);
+        fprintf(stderr,"%s: Could not create thread\n", my_progname);
+        continue;
+      }
+      worker_thread_count++;
+    }
+    for (i= 0; i < worker_thread_count; i++)
+    {
+      if (pthread_join(worker_threads[i], NULL))
+        fprintf(stderr,"%s: Could not join worker thread.\n", my_progname);
+    }
+
+    if (opt_disable_keys &&
+        table_query(mysql, "ALTER TABLE ", tablename, " ENABLE KEYS") &&
+        exitcode == 0)
+      exitcode= 1;
+  }
+
+  my_free(worker_threads);
+  delete_dynamic(&chunks);
+  db_disconnect(current_host, mysql);
+  return 0;
+}
+
+
 int main(int argc, char **argv)
 {
   int error=0;
@@ -637,7 +984,18 @@ int main(int argc, char **argv)
   }
   sf_leaking_memory=0; /* from now on we cleanup properly */
 
-  if (opt_use_threads && !lock_tables)
+  if (opt_split_size)
+  {
+    pthread_mutex_init(&init_mutex, NULL);
+    pthread_mutex_init(&counter_mutex, NULL);
+    pthread_cond_init(&count_threshhold, NULL);
+    if (load_files_in_chunks(argv) && exitcode == 0)
+      exitcode= 1;
+    pthread_mutex_destroy(&init_mutex);
+    pthread_mutex_destroy(&counter_mutex);
+    pthread_cond_destroy(&count_threshhold);
+  }
+  else if (opt_use_threads && !lock_tables)
   {
     char **save_argv;
     uint worker_thread_count= 0, table_count= 0, i= 0;
@@ -733,7 +1091,7 @@ int main(int argc, char **argv)
     if (lock_tables)
       lock_table(mysql, argc, argv);
     for (; *argv != NULL; argv++)
-      if ((error= write_to_table(*argv, mysql)))
+      if ((error= write_to_table(*argv, mysql, NULL)))
         if (exitcode == 0)
           exitcode= error;
     db_disconnect(current_host, mysql);
@@ -134,7 +134,7 @@ static my_bool opt_compress= FALSE, tty_password= FALSE,
                opt_silent= FALSE,
                auto_generate_sql_autoincrement= FALSE,
                auto_generate_sql_guid_primary= FALSE,
-               auto_generate_sql= FALSE;
+               auto_generate_sql= FALSE, opt_percentiles= FALSE;
 const char *auto_generate_sql_type= "mixed";
 
 static unsigned long connect_flags= CLIENT_MULTI_RESULTS |
@@ -144,6 +144,7 @@ static unsigned long connect_flags= CLIENT_MULTI_RESULTS |
 static int verbose;
 static uint commit_rate;
 static uint detach_rate;
+static uint opt_rate;
 const char *num_int_cols_opt;
 const char *num_char_cols_opt;
 
@@ -173,6 +174,15 @@ File csv_file;
 
 static uint opt_protocol= 0;
 
+/*
+  Histogram of the query latencies in microseconds. Latencies below
+  2 << LATENCY_SUB_BITS are exact, the others are in 1 << LATENCY_SUB_BITS
+  buckets per power of two, like a HDR histogram with 2 significant bits.
+*/
+#define LATENCY_SUB_BITS 3
+#define LATENCY_BUCKETS (64 << LATENCY_SUB_BITS)
+static ulonglong latency_histogram[LATENCY_BUCKETS];
+
 static int get_options(int *argc,char ***argv);
 static uint opt_mysql_port= 0;
 
@@ -224,6 +234,8 @@ struct conclusions {
   long int min_timing;
   uint users;
   unsigned long long avg_rows;
+  /* Query latency percentiles in microseconds, with --percentiles */
+  ulonglong latency_p50, latency_p99, latency_p999;
   /* The following are not used yet */
   unsigned long long max_rows;
   unsigned long long min_rows;
@@ -268,6 +280,50 @@ static const char ALPHANUMERICS[]=
 #define ALPHANUMERICS_SIZE (sizeof(ALPHANUMERICS)-1)
 
 
+static uint latency_bucket(ulonglong usec)
+{
+  uint bits;
+
+  if (usec < (2 << LATENCY_SUB_BITS))
+    return (uint) usec;
+  for (bits= 0; (usec >> bits) > 1; bits++) ;
+  return ((bits - LATENCY_SUB_BITS) << LATENCY_SUB_BITS) +
+         (uint) (usec >> (bits - LATENCY_SUB_BITS));
+}
+
+
+/* The highest latency in the bucket */
+
+static ulonglong latency_bucket_max(uint bucket)
+{
+  uint shift;
+
+  if (bucket < (2 << LATENCY_SUB_BITS))
+    return bucket;
+  shift= (bucket >> LATENCY_SUB_BITS) - 1;
+  return ((((ulonglong) (bucket & ((1 << LATENCY_SUB_BITS) - 1)) |
+            (1 << LATENCY_SUB_BITS)) + 1) << shift) - 1;
+}
+
+
+static ulonglong latency_percentile(double fraction)
+{
+  ulonglong total= 0, rank, seen= 0;
+  uint i;
+
+  for (i= 0; i < LATENCY_BUCKETS; i++)
+    total+= latency_histogram[i];
+  rank= (ulonglong) (fraction * total + 0.999999);
+  set_if_bigger(rank, 1);
+  for (i= 0; i < LATENCY_BUCKETS; i++)
+  {
+    if ((seen+= latency_histogram[i]) >= rank)
+      return latency_bucket_max(i);
+  }
+  return 0;
+}
+
+
 static long int timedif(struct timeval a, struct timeval b)
 {
     register int us, s;
@@ -436,6 +492,7 @@ void concurrency_loop(MYSQL *mysql, uint current, option_string *eptr)
                                 MYF(MY_ZEROFILL|MY_FAE|MY_WME));
 
   bzero(&conclusion, sizeof(conclusions));
+  bzero(latency_histogram, sizeof(latency_histogram));
 
   if (auto_actual_queries)
     client_limit= auto_actual_queries;
@@ -651,6 +708,10 @@ static struct my_option my_long_options[] =
   {"password", 'p',
     "Password to use when connecting to server. If password is not given it's "
       "asked from the tty.", 0, 0, 0, GET_STR, OPT_ARG, 0, 0, 0, 0, 0, 0},
+  {"percentiles", OPT_SLAP_PERCENTILES,
+    "Report the 50th, 99th and 99.9th percentile of the query latency.",
+    &opt_percentiles, &opt_percentiles, 0, GET_BOOL, NO_ARG,
+    0, 0, 0, 0, 0, 0},
 #ifdef __WIN__
   {"pipe", 'W', "Use named pipes to connect to server.", 0, 0, 0, GET_NO_ARG,
     NO_ARG, 0, 0, 0, 0, 0, 0},
@@ -683,6 +744,12 @@ static struct my_option my_long_options[] =
   {"query", 'q', "Query to run or file containing query to run.",
     &user_supplied_query, &user_supplied_query,
     0, GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"rate", OPT_SLAP_RATE,
+    "Start queries at this fixed rate per second in every client, instead of "
+    "starting the next query when the previous one has completed. The "
+    "latency of a query is then counted from when it should have started. "
+    "0 means no fixed rate.",
+    &opt_rate, &opt_rate, 0, GET_UINT, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
   {"silent", 's', "Run program in silent mode - no output.",
     &opt_silent, &opt_silent, 0, GET_BOOL,  NO_ARG,
     0, 0, 0, 0, 0, 0},
@@ -1840,6 +1907,8 @@ pthread_handler_t run_task(void *p)
   MYSQL_ROW row;
   statement *ptr;
   thread_context *con= (thread_context *)p;
+  ulonglong *histogram= 0, run_start= 0, query_start= 0;
+  uint i;
 
   DBUG_ENTER("run_task");
   DBUG_PRINT("info", ("task script \"%s\"", con->stmt ? con->stmt->string : ""));
@@ -1883,6 +1952,12 @@ pthread_handler_t run_task(void *p)
   if (commit_rate)
     run_query(mysql, "SET AUTOCOMMIT=0", strlen("SET AUTOCOMMIT=0"));
 
+  /* Collected here and added to latency_histogram at the end */
+  if (opt_percentiles)
+    histogram= (ulonglong*) my_malloc(sizeof(latency_histogram),
+                                      MYF(MY_ZEROFILL|MY_FAE|MY_WME));
+  run_start= microsecond_interval_timer();
+
 limit_not_met:
     for (ptr= con->stmt, detach_counter= 0; 
          ptr && ptr->length; 
@@ -1902,6 +1977,16 @@ pthread_handler_t run_task(void *p)
           goto end;
       }
 
+      if (opt_rate)
+      {
+        ulonglong now= microsecond_interval_timer();
+        query_start= run_start + queries * 1000000 / opt_rate;
+        if (query_start > now)
+          my_sleep((ulong) (query_start - now));
+      }
+      else if (histogram)
+        query_start= microsecond_interval_timer();
+
       /* 
         We have to execute differently based on query type. This should become a function.
       */
@@ -1964,6 +2049,11 @@ pthread_handler_t run_task(void *p)
           }
         }
       } while(mysql_next_result(mysql) == 0);
+      if (histogram)
+      {
+        ulonglong now= microsecond_interval_timer();
+        histogram[latency_bucket(now > query_start ? now - query_start : 0)]++;
+      }
       queries++;
 
       if (commit_rate && (++commit_counter == commit_rate))
@@ -1988,9 +2078,15 @@ pthread_handler_t run_task(void *p)
   mysql_thread_end();
 
   pthread_mutex_lock(&counter_mutex);
+  if (histogram)
+  {
+    for (i= 0; i < LATENCY_BUCKETS; i++)
+      latency_histogram[i]+= histogram[i];
+  }
   thread_counter--;
   pthread_cond_signal(&count_threshhold);
   pthread_mutex_unlock(&counter_mutex);
+  my_free(histogram);
 
   DBUG_RETURN(0);
 }
@@ -2178,6 +2274,10 @@ print_conclusions(conclusions *con)
                     con->max_timing / 1000, con->max_timing % 1000);
   printf("\tNumber of clients running queries: %d\n", con->users);
   printf("\tAverage number of queries per client: %llu\n", con->avg_rows); 
+  if (opt_percentiles)
+    printf("\tQuery latency percentiles (50th, 99th, 99.9th): "
+           "%llu %llu %llu microseconds\n",
+           con->latency_p50, con->latency_p99, con->latency_p999);
   printf("\n");
 }
 
@@ -2186,9 +2286,10 @@ print_conclusions_csv(conclusions *con)
 {
   char buffer[HUGE_STRING_LENGTH];
   const char *ptr= auto_generate_sql_type ? auto_generate_sql_type : "query";
+  int length;
 
-  snprintf(buffer, HUGE_STRING_LENGTH, 
-           "%s,%s,%ld.%03ld,%ld.%03ld,%ld.%03ld,%d,%llu\n",
+  length= snprintf(buffer, HUGE_STRING_LENGTH, 
+           "%s,%s,%ld.%03ld,%ld.%03ld,%ld.%03ld,%d,%llu",
            con->engine ? con->engine : "", /* Storage engine we ran against */
            ptr, /* Load type */
            con->avg_timing / 1000, con->avg_timing % 1000, /* Time to load */
@@ -2197,6 +2298,10 @@ print_conclusions_csv(conclusions *con)
            con->users, /* Children used */
            con->avg_rows  /* Queries run */
           );
+  if (opt_percentiles)
+    snprintf(buffer + length, HUGE_STRING_LENGTH - length, ",%llu,%llu,%llu",
+             con->latency_p50, con->latency_p99, con->latency_p999);
+  strcat(buffer, "\n");
   my_write(csv_file, (uchar*) buffer, (uint)strlen(buffer), MYF(0));
 }
 
@@ -2227,6 +2332,13 @@ generate_stats(conclusions *con, option_string *eng, stats *sptr)
   }
   con->avg_timing= con->avg_timing/iterations;
 
+  if (opt_percentiles)
+  {
+    con->latency_p50= latency_percentile(0.5);
+    con->latency_p99= latency_percentile(0.99);
+    con->latency_p999= latency_percentile(0.999);
+  }
+
   if (eng && eng->string)
     con->engine= eng->string;
   else
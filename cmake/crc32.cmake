@@ -2,4 +2,15 @@ IF(CMAKE_SYSTEM_PROCESSOR MATCHES "ppc64")
     SET(HAVE_CRC32_VPMSUM 1)
     SET(CRC32_LIBRARY crc32-vpmsum)
     ADD_SUBDIRECTORY(extra/crc32-vpmsum)
+ELSEIF(CMAKE_SYSTEM_PROCESSOR MATCHES "x86_64|amd64|AMD64|i[3-6]86" AND
+       CMAKE_C_COMPILER_ID MATCHES "GNU|Clang")
+    # my_checksum() uses PCLMULQDQ if the CPU has it
+    INCLUDE(CheckCSourceCompiles)
+    CHECK_C_SOURCE_COMPILES("
+    #include <wmmintrin.h>
+    #include <smmintrin.h>
+    __attribute__((target(\"pclmul,sse4.1\")))
+    int f(__m128i a) { return _mm_extract_epi32(_mm_clmulepi64_si128(a, a, 0), 1); }
+    int main() { return __builtin_cpu_supports(\"pclmul\"); }"
+    HAVE_CRC32_PCLMUL)
 ENDIF()
@@ -0,0 +1,52 @@
+# Copyright (c) 2019, MariaDB Corporation.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; version 2 of the License.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+
+# zstd is used for the compression of binary log events,
+# see log_bin_compress_algorithm.
+MACRO(CHECK_ZSTD)
+  SET(WITH_ZSTD "auto" CACHE STRING
+    "Enable zstd compression of the binary log")
+  IF(WITH_ZSTD STREQUAL "yes" OR WITH_ZSTD STREQUAL "auto")
+    FIND_PACKAGE(zstd QUIET)
+    IF(ZSTD_FOUND)
+      SET(CMAKE_REQUIRED_LIBRARIES ${ZSTD_LIBRARIES})
+      SET(CMAKE_REQUIRED_INCLUDES ${ZSTD_INCLUDE_DIR})
+      CHECK_C_SOURCE_COMPILES(
+      "
+      #include <zstd.h>
+      int main()
+      {
+        return ZSTD_isError(ZSTD_compress(0, 0, 0, 0, 1));
+      }"
+      HAVE_ZSTD)
+      SET(CMAKE_REQUIRED_LIBRARIES)
+      SET(CMAKE_REQUIRED_INCLUDES)
+    ENDIF()
+    IF(HAVE_ZSTD)
+      SET(LIBZSTD ${ZSTD_LIBRARIES})
+      INCLUDE_DIRECTORIES(SYSTEM ${ZSTD_INCLUDE_DIR})
+      MESSAGE_ONCE(zstd "Binary log zstd compression enabled")
+    ELSE()
+      UNSET(LIBZSTD)
+      UNSET(HAVE_ZSTD)
+      MESSAGE_ONCE(zstd "Binary log zstd compression not enabled")
+      IF(WITH_ZSTD STREQUAL "yes")
+        MESSAGE(FATAL_ERROR "Requested WITH_ZSTD=yes however zstd was not found")
+      ENDIF()
+    ENDIF()
+  ELSEIF(NOT WITH_ZSTD STREQUAL "no")
+    MESSAGE(FATAL_ERROR "Invalid value for WITH_ZSTD. Must be 'yes', 'no', or 'auto'.")
+  ENDIF()
+ENDMACRO()
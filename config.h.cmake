@@ -105,7 +105,9 @@
 /* Libraries */
 #cmakedefine HAVE_LIBWRAP 1
 #cmakedefine HAVE_SYSTEMD 1
+#cmakedefine HAVE_ZSTD 1
 #cmakedefine HAVE_CRC32_VPMSUM 1
+#cmakedefine HAVE_CRC32_PCLMUL 1
 
 /* Does "struct timespec" have a "sec" and "nsec" field? */
 #cmakedefine HAVE_TIMESPEC_TS_SEC 1
@@ -183,6 +185,7 @@
 #cmakedefine HAVE_MMAP64 1
 #cmakedefine HAVE_PERROR 1
 #cmakedefine HAVE_POLL 1
+#cmakedefine HAVE_POSIX_FADVISE 1
 #cmakedefine HAVE_POSIX_FALLOCATE 1
 #cmakedefine HAVE_LINUX_FALLOC_H 1
 #cmakedefine HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE 1
@@ -36,6 +36,7 @@
 # include <unistd.h>
 #endif
 #include <my_getopt.h>
+#include <my_sys.h>
 #include <m_string.h>
 #include <welcome_copyright_notice.h> /* ORACLE_WELCOME_COPYRIGHT_NOTICE */
 
@@ -94,6 +95,8 @@ static bool			do_one_page;
 static my_bool do_leaf;
 static my_bool per_page_details;
 static ulint n_merge;
+/* Number of threads that check or rewrite the pages of a file. */
+static uint n_threads;
 extern ulong			srv_checksum_algorithm;
 static ulint physical_page_size;  /* Page size in bytes on disk. */
 static ulint logical_page_size;   /* Page size when uncompressed. */
@@ -460,6 +463,7 @@ ulint read_file(
 				with crypt_scheme encrypted
 @param[in]	is_compressed	true if page0 fsp_flags contained
 				page compression flag
+@param[in]	page_no		page number
 @retval true if page is corrupted otherwise false. */
 static
 bool
@@ -467,7 +471,8 @@ is_page_corrupted(
 	byte*		buf,
 	const page_size_t&	page_size,
 	bool		is_encrypted,
-	bool		is_compressed)
+	bool		is_compressed,
+	unsigned long long	page_no)
 {
 
 	/* enable if page is corrupted. */
@@ -503,13 +508,13 @@ is_page_corrupted(
 				"space::" ULINTPF " page::%llu"
 				"; log sequence number:first = " ULINTPF
 				"; second = " ULINTPF "\n",
-				space_id, cur_page_num, logseq, logseqfield);
+				space_id, page_no, logseq, logseqfield);
 			if (logseq != logseqfield) {
 				fprintf(log_file,
 					"Fail; space::" ULINTPF " page::%llu"
 					" invalid (fails log "
 					"sequence number check)\n",
-					space_id, cur_page_num);
+					space_id, page_no);
 			}
 		}
 	}
@@ -525,7 +530,7 @@ is_page_corrupted(
 	normal method. */
 	if (is_encrypted && key_version != 0) {
 		is_corrupted = !fil_space_verify_crypt_checksum(buf,
-			page_size, space_id, (ulint)cur_page_num);
+			page_size, space_id, (ulint)page_no);
 	} else {
 		is_corrupted = true;
 	}
@@ -540,17 +545,17 @@ is_page_corrupted(
 
 /********************************************//*
  Check if page is doublewrite buffer or not.
- @param [in] page	buffer page
+ @param [in] page_no	page number in the system tablespace
 
  @retval true  if page is doublewrite buffer otherwise false.
 */
 static
 bool
 is_page_doublewritebuffer(
-	const byte*	page)
+	unsigned long long	page_no)
 {
-	if ((cur_page_num >= FSP_EXTENT_SIZE)
-		&& (cur_page_num < FSP_EXTENT_SIZE * 3)) {
+	if ((page_no >= FSP_EXTENT_SIZE)
+		&& (page_no < FSP_EXTENT_SIZE * 3)) {
 		/* page is doublewrite buffer. */
 		return (true);
 	}
@@ -1264,6 +1269,8 @@ static struct my_option innochecksum_options[] = {
     &do_leaf, &do_leaf, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
   {"merge", 'm', "leaf page count if merge given number of consecutive pages",
    &n_merge, &n_merge, 0, GET_ULONG, REQUIRED_ARG, 0, 0, (longlong)10L, 0, 1, 0},
+  {"parallel", 'j', "Number of threads to check or rewrite pages.",
+   &n_threads, &n_threads, 0, GET_UINT, REQUIRED_ARG, 1, 1, 64, 0, 1, 0},
 
   {0, 0, 0, 0, 0, 0, GET_NO_ARG, NO_ARG, 0, 0, 0, 0, 0, 0}
 };
@@ -1290,7 +1297,8 @@ static void usage(void)
 	printf("Usage: %s [-c] [-s <start page>] [-e <end page>] "
 		"[-p <page>] [-i] [-v]  [-a <allow mismatches>] [-n] "
 		"[-C <strict-check>] [-w <write>] [-S] [-D <page type dump>] "
-		"[-l <log>] [-l] [-m <merge pages>] <filename or [-]>\n", my_progname);
+		"[-l <log>] [-l] [-m <merge pages>] [-j <threads>] "
+		"<filename or [-]>\n", my_progname);
 	printf("See " REFMAN "innochecksum.html for usage hints.\n");
 	my_print_help(innochecksum_options);
 	my_print_variables(innochecksum_options);
@@ -1465,7 +1473,7 @@ int verify_checksum(
 	bool is_corrupted = false;
 
 	is_corrupted = is_page_corrupted(
-		buf, page_size, is_encrypted, is_compressed);
+		buf, page_size, is_encrypted, is_compressed, cur_page_num);
 
 	if (is_corrupted) {
 		fprintf(stderr, "Fail: page::%llu invalid\n",
@@ -1525,6 +1533,224 @@ rewrite_checksum(
 	return (exit_status);
 }
 
+/** Number of bytes that a thread reads at a time in check_pages() */
+#define CHECK_PAGES_READ_SIZE	(1U << 20)
+
+/** The pages of a file that are checked by check_pages() */
+struct check_pages_ctxt_t {
+	const char*		filename;
+	File			fd;
+	const page_size_t*	page_size;
+	bool			is_encrypted;
+	bool			is_compressed;
+	bool			is_system_tablespace;
+	/** Protects the fields below and the output */
+	pthread_mutex_t		mutex;
+	/** First page that has not been read yet */
+	unsigned long long	next_page;
+	/** End of the page range (exclusive) */
+	unsigned long long	end_page;
+	unsigned long long*	mismatch_count;
+	/** Set on error, to stop all the threads */
+	int			exit_status;
+};
+
+/** Check or rewrite the pages of a file, in chunks of
+CHECK_PAGES_READ_SIZE that are assigned to the threads in order.
+@param[in,out]	arg	check_pages_ctxt_t
+@return NULL */
+static
+void*
+check_pages_thread(
+	void*	arg)
+{
+	check_pages_ctxt_t*	ctxt = static_cast<check_pages_ctxt_t*>(arg);
+	const ulint		size = ctxt->page_size->physical();
+	const ulint		n_pages = ut_max(ulint(1),
+						 CHECK_PAGES_READ_SIZE / size);
+	byte*			buf_ptr = static_cast<byte*>(
+		malloc(n_pages * size + UNIV_PAGE_SIZE_MAX));
+	byte*			buf = static_cast<byte*>(
+		ut_align(buf_ptr, UNIV_PAGE_SIZE_MAX));
+
+	my_thread_init();
+
+	if (!buf_ptr) {
+		pthread_mutex_lock(&ctxt->mutex);
+		fprintf(stderr, "Error: out of memory\n");
+		ctxt->exit_status = 1;
+		pthread_mutex_unlock(&ctxt->mutex);
+	}
+
+	for (;;) {
+		pthread_mutex_lock(&ctxt->mutex);
+		if (ctxt->exit_status
+		    || ctxt->next_page >= ctxt->end_page) {
+			pthread_mutex_unlock(&ctxt->mutex);
+			break;
+		}
+		const unsigned long long first = ctxt->next_page;
+		const ulint n = ulint(ut_min(ctxt->end_page - first,
+					     (unsigned long long) n_pages));
+		ctxt->next_page += n;
+		pthread_mutex_unlock(&ctxt->mutex);
+
+		const my_off_t offset = my_off_t(first) * size;
+		size_t bytes = my_pread(ctxt->fd, buf, n * size, offset,
+					MYF(0));
+
+		if (bytes != n * size) {
+			pthread_mutex_lock(&ctxt->mutex);
+			fprintf(stderr, "Error reading " ULINTPF " bytes at "
+				"page::%llu of %s", n * size, first,
+				ctxt->filename);
+			perror(" ");
+			ctxt->exit_status = 1;
+			pthread_mutex_unlock(&ctxt->mutex);
+			break;
+		}
+
+		for (ulint i = 0; i < n; i++) {
+			byte*	page = buf + i * size;
+			const unsigned long long page_no = first + i;
+			bool	skip = ctxt->is_system_tablespace
+				&& is_page_doublewritebuffer(page_no);
+
+			switch (mach_read_from_2(page + FIL_PAGE_TYPE)) {
+			case FIL_PAGE_PAGE_COMPRESSED:
+			case FIL_PAGE_PAGE_COMPRESSED_ENCRYPTED:
+				skip = true;
+			}
+
+			if (skip) {
+				continue;
+			}
+
+			if (!no_check
+			    && is_page_corrupted(page, *ctxt->page_size,
+						 ctxt->is_encrypted,
+						 ctxt->is_compressed,
+						 page_no)) {
+				pthread_mutex_lock(&ctxt->mutex);
+				fprintf(stderr, "Fail: page::%llu invalid\n",
+					page_no);
+				if (++*ctxt->mismatch_count
+				    > allow_mismatches
+				    && !ctxt->exit_status) {
+					fprintf(stderr,
+						"Exceeded the "
+						"maximum allowed "
+						"checksum mismatch "
+						"count::%llu current::%llu\n",
+						*ctxt->mismatch_count,
+						allow_mismatches);
+					ctxt->exit_status = 1;
+				}
+				pthread_mutex_unlock(&ctxt->mutex);
+
+				if (ctxt->exit_status) {
+					break;
+				}
+			}
+
+			/* Encrypted and page compressed tables are not
+			rewritten, see rewrite_checksum(). */
+			if (do_write
+			    && !ctxt->is_encrypted && !ctxt->is_compressed
+			    && update_checksum(page, static_cast<ulong>(size),
+					       ctxt->page_size->is_compressed())
+			    && my_pwrite(ctxt->fd, page, size,
+					 my_off_t(page_no) * size, MYF(0))
+			    != size) {
+				pthread_mutex_lock(&ctxt->mutex);
+				fprintf(stderr, "Failed to write page::%llu "
+					"to %s: %s\n", page_no,
+					ctxt->filename, strerror(errno));
+				ctxt->exit_status = 1;
+				pthread_mutex_unlock(&ctxt->mutex);
+				break;
+			}
+		}
+	}
+
+	free(buf_ptr);
+	my_thread_end();
+	return(NULL);
+}
+
+/** Check or rewrite the pages of a file in --parallel threads. This is
+used instead of the main checksumming loop when no per-page output is
+requested.
+@param[in]	filename	file name
+@param[in]	fil_in		file, with page 0 already processed
+@param[in]	size		file size in bytes
+@param[in]	page_size	page size
+@param[in]	is_encrypted	true if tablespace is encrypted
+@param[in]	is_compressed	true if tablespace is page compressed
+@param[in]	is_system_tablespace	true if the file is of the system
+					tablespace
+@param[in,out]	mismatch_count	Number of pages failed in checksum verify
+@retval 0 if all the pages were checked, or 1 if an error was detected */
+static
+int
+check_pages(
+	const char*		filename,
+	FILE*			fil_in,
+	unsigned long long	size,
+	const page_size_t&	page_size,
+	bool			is_encrypted,
+	bool			is_compressed,
+	bool			is_system_tablespace,
+	unsigned long long*	mismatch_count)
+{
+	const unsigned long long pages = size / page_size.physical();
+	check_pages_ctxt_t	ctxt;
+	pthread_t		threads[64];
+	uint			n;
+
+	ctxt.filename = filename;
+	ctxt.fd = fileno(fil_in);
+	ctxt.page_size = &page_size;
+	ctxt.is_encrypted = is_encrypted;
+	ctxt.is_compressed = is_compressed;
+	ctxt.is_system_tablespace = is_system_tablespace;
+	ctxt.next_page = start_page ? start_page : 1;
+	ctxt.end_page = use_end_page && end_page < pages
+		? end_page + 1 : pages;
+	ctxt.mismatch_count = mismatch_count;
+	ctxt.exit_status = 0;
+	pthread_mutex_init(&ctxt.mutex, NULL);
+
+	/* stdio may have buffered page 0 for writing */
+	fflush(fil_in);
+
+	for (n = 0; n < n_threads; n++) {
+		if (pthread_create(&threads[n], NULL, check_pages_thread,
+				   &ctxt)) {
+			perror("pthread_create");
+			ctxt.exit_status = 1;
+			break;
+		}
+	}
+
+	while (n) {
+		pthread_join(threads[--n], NULL);
+	}
+
+	pthread_mutex_destroy(&ctxt.mutex);
+
+	if (!ctxt.exit_status && ctxt.end_page == pages
+	    && size % page_size.physical()) {
+		fprintf(stderr, "Error: bytes read (" ULINTPF ") "
+			"doesn't match page size (" ULINTPF ")\n",
+			ulint(size % page_size.physical()),
+			page_size.physical());
+		ctxt.exit_status = 1;
+	}
+
+	return(ctxt.exit_status);
+}
+
 int main(
 	int	argc,
 	char	**argv)
@@ -1795,6 +2021,24 @@ int main(
 			}
 		}
 
+		/* Without per-page output, the pages can be checked and
+		rewritten by several threads. */
+		if (n_threads > 1 && !read_from_stdin && !is_log_enabled
+		    && !page_type_summary && !page_type_dump
+		    && !per_page_details) {
+			exit_status = check_pages(filename, fil_in, size,
+						  page_size, is_encrypted,
+						  is_compressed,
+						  is_system_tablespace,
+						  &mismatch_count);
+			if (exit_status) {
+				goto my_exit;
+			}
+			fclose(fil_in);
+			fil_in = NULL;
+			continue;
+		}
+
 		/* seek to the necessary position */
 		if (start_page) {
 			if (!read_from_stdin) {
@@ -1894,7 +2138,8 @@ int main(
 
 			if (is_system_tablespace) {
 				/* enable when page is double write buffer.*/
-				skip_page = is_page_doublewritebuffer(buf);
+				skip_page = is_page_doublewritebuffer(
+					cur_page_num);
 			} else {
 				skip_page = false;
 			}
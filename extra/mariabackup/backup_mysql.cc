@@ -533,30 +533,19 @@ Query the server to find out what backup capabilities it supports.
 bool
 detect_mysql_capabilities_for_backup()
 {
-	const char *query = "SELECT 'INNODB_CHANGED_PAGES', COUNT(*) FROM "
-				"INFORMATION_SCHEMA.PLUGINS "
-			    "WHERE PLUGIN_NAME LIKE 'INNODB_CHANGED_PAGES'";
-	char *innodb_changed_pages = NULL;
+	char *innodb_track_changed_pages = NULL;
 	mysql_variable vars[] = {
-		{"INNODB_CHANGED_PAGES", &innodb_changed_pages}, {NULL, NULL}};
+		{"innodb_track_changed_pages", &innodb_track_changed_pages},
+		{NULL, NULL}};
 
 	if (xtrabackup_incremental) {
 
-		read_mysql_variables(mysql_connection, query, vars, true);
+		read_mysql_variables(mysql_connection,
+			"SHOW GLOBAL VARIABLES "
+			"LIKE 'innodb_track_changed_pages'", vars, true);
 
-		ut_ad(innodb_changed_pages != NULL);
-
-		have_changed_page_bitmaps = (atoi(innodb_changed_pages) == 1);
-
-		/* INNODB_CHANGED_PAGES are listed in
-		INFORMATION_SCHEMA.PLUGINS in MariaDB, but
-		FLUSH NO_WRITE_TO_BINLOG CHANGED_PAGE_BITMAPS
-		is not supported for versions below 10.1.6
-		(see MDEV-7472) */
-		if (server_flavor == FLAVOR_MARIADB &&
-		    mysql_server_version < 100106) {
-			have_changed_page_bitmaps = false;
-		}
+		have_changed_page_bitmaps = innodb_track_changed_pages
+			&& !strcmp(innodb_track_changed_pages, "ON");
 
 		free_mysql_variables(vars);
 	}
@@ -1731,17 +1720,6 @@ select_history()
 	return(true);
 }
 
-bool
-flush_changed_page_bitmaps()
-{
-	if (xtrabackup_incremental && have_changed_page_bitmaps &&
-	    !xtrabackup_incremental_force_scan) {
-		xb_mysql_query(mysql_connection,
-			"FLUSH NO_WRITE_TO_BINLOG CHANGED_PAGE_BITMAPS", false);
-	}
-	return(true);
-}
-
 
 /*********************************************************************//**
 Deallocate memory, disconnect from MySQL server, etc.
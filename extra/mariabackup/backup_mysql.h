@@ -39,9 +39,6 @@ capture_tool_command(int argc, char **argv);
 bool
 select_history();
 
-bool
-flush_changed_page_bitmaps();
-
 void
 backup_cleanup();
 
@@ -27,11 +27,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
 #include "common.h"
 #include "xtrabackup.h"
 #include "srv0srv.h"
+#include "log0online.h"
 
-/* TODO: copy-pasted shared definitions from the XtraDB bitmap write code.
-Remove these on the first opportunity, i.e. single-binary XtraBackup.  */
-
-/* log0online.h */
+/* Reader side definitions of the XtraDB bitmap code. The file format is
+defined in log0online.h. */
 
 /** Single bitmap file information */
 struct log_online_bitmap_file_t {
@@ -55,58 +54,8 @@ struct log_online_bitmap_file_range_t {
 	}	*files;
 };
 
-/* log0online.c */
-
-/** File name stem for bitmap files. */
-static const char* bmp_file_name_stem = "ib_modified_log_";
-
-/** The bitmap file block size in bytes.  All writes will be multiples of this.
- */
-enum {
-	MODIFIED_PAGE_BLOCK_SIZE = 4096
-};
-
-/** Offsets in a file bitmap block */
-enum {
-	MODIFIED_PAGE_IS_LAST_BLOCK = 0,/* 1 if last block in the current
-					write, 0 otherwise. */
-	MODIFIED_PAGE_START_LSN = 4,	/* The starting tracked LSN of this and
-					other blocks in the same write */
-	MODIFIED_PAGE_END_LSN = 12,	/* The ending tracked LSN of this and
-					other blocks in the same write */
-	MODIFIED_PAGE_SPACE_ID = 20,	/* The space ID of tracked pages in
-					this block */
-	MODIFIED_PAGE_1ST_PAGE_ID = 24,	/* The page ID of the first tracked
-					page in this block */
-	MODIFIED_PAGE_BLOCK_UNUSED_1 = 28,/* Unused in order to align the start
-					  of bitmap at 8 byte boundary */
-	MODIFIED_PAGE_BLOCK_BITMAP = 32,/* Start of the bitmap itself */
-	MODIFIED_PAGE_BLOCK_UNUSED_2 = MODIFIED_PAGE_BLOCK_SIZE - 8,
-					/* Unused in order to align the end of
-					bitmap at 8 byte boundary */
-	MODIFIED_PAGE_BLOCK_CHECKSUM = MODIFIED_PAGE_BLOCK_SIZE - 4
-					/* The checksum of the current block */
-};
-
-/** Length of the bitmap data in a block */
-enum { MODIFIED_PAGE_BLOCK_BITMAP_LEN
-       = MODIFIED_PAGE_BLOCK_UNUSED_2 - MODIFIED_PAGE_BLOCK_BITMAP };
-
-/** Length of the bitmap data in a block in page ids */
-enum { MODIFIED_PAGE_BLOCK_ID_COUNT = MODIFIED_PAGE_BLOCK_BITMAP_LEN * 8 };
-
 typedef ib_uint64_t	bitmap_word_t;
 
-/****************************************************************//**
-Calculate a bitmap block checksum.  Algorithm borrowed from
-log_block_calc_checksum.
-@return checksum */
-UNIV_INLINE
-ulint
-log_online_calc_checksum(
-/*=====================*/
-	const byte*	block);	/*!<in: bitmap block */
-
 /****************************************************************//**
 Provide a comparisson function for the RB-tree tree (space,
 block_start_page) pairs.  Actual implementation does not matter as
@@ -137,39 +86,6 @@ log_online_compare_bmp_keys(
 	return k1_space < k2_space ? -1 : 1;
 }
 
-/****************************************************************//**
-Calculate a bitmap block checksum.  Algorithm borrowed from
-log_block_calc_checksum.
-@return checksum */
-UNIV_INLINE
-ulint
-log_online_calc_checksum(
-/*=====================*/
-	const byte*	block)	/*!<in: bitmap block */
-{
-	ulint	sum;
-	ulint	sh;
-	ulint	i;
-
-	sum = 1;
-	sh = 0;
-
-	for (i = 0; i < MODIFIED_PAGE_BLOCK_CHECKSUM; i++) {
-
-		ulint	b = block[i];
-		sum &= 0x7FFFFFFFUL;
-		sum += b;
-		sum += b << sh;
-		sh++;
-		if (sh > 24) {
-
-			sh = 0;
-		}
-	}
-
-	return sum;
-}
-
 /****************************************************************//**
 Read one bitmap data page and check it for corruption.
 
@@ -242,7 +158,7 @@ log_online_is_bitmap_file(
 		 || file_info->type == OS_FILE_TYPE_LINK)
 		&& (sscanf(file_info->name, "%[a-z_]%lu_" LSN_PF ".xdb", stem,
 			   bitmap_file_seq_num, bitmap_file_start_lsn) == 3)
-		&& (!strcmp(stem, bmp_file_name_stem)));
+		&& (!strcmp(stem, LOG_ONLINE_FILE_NAME_STEM)));
 }
 
 /*********************************************************************//**
@@ -442,7 +358,8 @@ log_online_open_bitmap_file_read_only(
 
 	xb_ad(name[0] != '\0');
 
-	snprintf(bitmap_file->name, FN_REFLEN, "%s%s", srv_data_home, name);
+	snprintf(bitmap_file->name, FN_REFLEN, "%s%c%s", srv_data_home,
+		 OS_PATH_SEPARATOR, name);
 	bitmap_file->file = os_file_create_simple_no_error_handling(
 		0, bitmap_file->name,
 		OS_FILE_OPEN, OS_FILE_READ_ONLY, true, &success);
@@ -513,7 +430,7 @@ log_online_diagnose_bitmap_eof(
 	return TRUE;
 }
 
-/* End of copy-pasted definitions */
+/* End of reader side definitions */
 
 /** Iterator structure over changed page bitmap */
 struct xb_page_bitmap_range_struct {
@@ -56,6 +56,8 @@ typedef struct {
 	ds_file_t		*dest_file;
 	ds_compress_ctxt_t	*comp_ctxt;
 	size_t			bytes_processed;
+	/* Worker threads compressing the chunks of this file, in order */
+	comp_thread_ctxt_t	**busy;
 } ds_compress_file_t;
 
 /* Compression options */
@@ -160,12 +162,15 @@ compress_open(ds_ctxt_t *ctxt, const char *path, MY_STAT *mystat)
 	}
 
 	file = (ds_file_t *) my_malloc(sizeof(ds_file_t) +
-				       sizeof(ds_compress_file_t),
+				       sizeof(ds_compress_file_t) +
+				       comp_ctxt->nthreads *
+				       sizeof(comp_thread_ctxt_t *),
 				       MYF(MY_FAE));
 	comp_file = (ds_compress_file_t *) (file + 1);
 	comp_file->dest_file = dest_file;
 	comp_file->comp_ctxt = comp_ctxt;
 	comp_file->bytes_processed = 0;
+	comp_file->busy = (comp_thread_ctxt_t **) (comp_file + 1);
 
 	file->ptr = comp_file;
 	file->path = dest_file->path;
@@ -199,15 +204,28 @@ compress_write(ds_file_t *file, const uchar *buf, size_t len)
 
 	ptr = (const char *) buf;
 	while (len > 0) {
-		uint max_thread;
-
-		/* Send data to worker threads for compression */
-		for (i = 0; i < nthreads; i++) {
+		uint	nbusy = 0;
+
+		/* Send data to the idle worker threads for compression. With
+		--parallel other copy threads may be using some of them; take
+		only the idle ones, and wait for one only if none is idle, so
+		that the files are compressed concurrently instead of taking
+		turns on the whole pool. */
+		for (i = 0; i <= nthreads && len > 0; i++) {
 			size_t chunk_len;
 
-			thd = threads + i;
-
-			pthread_mutex_lock(&thd->ctrl_mutex);
+			if (i < nthreads) {
+				thd = threads + i;
+				if (pthread_mutex_trylock(&thd->ctrl_mutex)) {
+					continue;
+				}
+			} else if (nbusy == 0) {
+				thd = threads + (comp_file->bytes_processed /
+						 COMPRESS_CHUNK_SIZE) % nthreads;
+				pthread_mutex_lock(&thd->ctrl_mutex);
+			} else {
+				break;
+			}
 
 			chunk_len = (len > COMPRESS_CHUNK_SIZE) ?
 				COMPRESS_CHUNK_SIZE : len;
@@ -219,18 +237,14 @@ compress_write(ds_file_t *file, const uchar *buf, size_t len)
 			pthread_cond_signal(&thd->data_cond);
 			pthread_mutex_unlock(&thd->data_mutex);
 
+			comp_file->busy[nbusy++] = thd;
 			len -= chunk_len;
-			if (len == 0) {
-				break;
-			}
 			ptr += chunk_len;
 		}
 
-		max_thread = (i < nthreads) ? i :  nthreads - 1;
-
 		/* Reap and stream the compressed data */
-		for (i = 0; i <= max_thread; i++) {
-			thd = threads + i;
+		for (i = 0; i < nbusy; i++) {
+			thd = comp_file->busy[i];
 
 			pthread_mutex_lock(&thd->data_mutex);
 			while (thd->data_avail == TRUE) {
@@ -238,7 +252,7 @@ compress_write(ds_file_t *file, const uchar *buf, size_t len)
 						  &thd->data_mutex);
 			}
 
-			xb_a(threads[i].to_len > 0);
+			xb_a(thd->to_len > 0);
 
 			if (ds_write(dest_file, "NEWBNEWB", 8) ||
 			    write_uint64_le(dest_file,
@@ -248,18 +262,17 @@ compress_write(ds_file_t *file, const uchar *buf, size_t len)
 				return 1;
 			}
 
-			comp_file->bytes_processed += threads[i].from_len;
+			comp_file->bytes_processed += thd->from_len;
 
-			if (write_uint32_le(dest_file, threads[i].adler) ||
-			    ds_write(dest_file, threads[i].to,
-					   threads[i].to_len)) {
+			if (write_uint32_le(dest_file, thd->adler) ||
+			    ds_write(dest_file, thd->to, thd->to_len)) {
 				msg("compress: write to the destination stream "
 				    "failed.\n");
 				return 1;
 			}
 
-			pthread_mutex_unlock(&threads[i].data_mutex);
-			pthread_mutex_unlock(&threads[i].ctrl_mutex);
+			pthread_mutex_unlock(&thd->data_mutex);
+			pthread_mutex_unlock(&thd->ctrl_mutex);
 		}
 	}
 
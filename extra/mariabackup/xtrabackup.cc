@@ -227,6 +227,8 @@ parameters are declared in mysqld.cc: */
 long innobase_buffer_pool_awe_mem_mb = 0;
 long innobase_file_io_threads = 4;
 long innobase_read_io_threads = 4;
+/** Whether --innodb-read-io-threads was specified */
+static bool innobase_read_io_threads_set;
 long innobase_write_io_threads = 4;
 
 longlong innobase_page_size = (1LL << 14); /* 16KB */
@@ -1625,6 +1627,10 @@ xb_get_one_option(int optid,
   case OPT_INNODB_LOG_FILE_SIZE:
     break;
 
+  case OPT_INNODB_READ_IO_THREADS:
+    innobase_read_io_threads_set = true;
+    break;
+
   case OPT_INNODB_FLUSH_METHOD:
     ut_a(srv_file_flush_method
 	 <= IF_WIN(SRV_ALL_O_DIRECT_FSYNC, SRV_O_DIRECT_NO_FSYNC));
@@ -4260,9 +4266,22 @@ xtrabackup_backup_func()
 	log_copying_stop = os_event_create(0);
 	os_thread_create(log_copying_thread, NULL, &log_copying_thread_id);
 
-	/* FLUSH CHANGED_PAGE_BITMAPS call */
-	if (!flush_changed_page_bitmaps()) {
-		goto fail;
+	/* The server writes the changed page bitmap up to a checkpoint
+	before writing the checkpoint, so the bitmap covers the LSN range
+	from incremental_lsn to checkpoint_lsn_start already. */
+	if (xtrabackup_incremental) {
+		if (have_changed_page_bitmaps
+		    && !xtrabackup_incremental_force_scan) {
+			changed_page_bitmap = xb_page_bitmap_init();
+		}
+		if (!changed_page_bitmap) {
+			msg("mariabackup: using the full scan for incremental "
+			    "backup\n");
+		} else if (incremental_lsn != checkpoint_lsn_start) {
+			/* Do not print that bitmaps are used when dummy
+			bitmap is built for an empty LSN range. */
+			msg("mariabackup: using the changed page bitmap\n");
+		}
 	}
 	debug_sync_point("xtrabackup_suspend_at_start");
 
@@ -5567,15 +5586,37 @@ xtrabackup_prepare_func(char** argv)
 		goto error_cleanup;
 	}
 
-	/* increase IO threads */
-	if (srv_n_file_io_threads < 10) {
-		srv_n_read_io_threads = 4;
-		srv_n_write_io_threads = 4;
+	/* The redo log is applied to the pages in the read I/O
+	completion threads, so use one of them per CPU, unless
+	--innodb-read-io-threads was specified. */
+	if (!innobase_read_io_threads_set) {
+		srv_n_read_io_threads = ut_min(ulint(my_getncpus()), ulint(64));
+		srv_n_read_io_threads = ut_max(srv_n_read_io_threads, ulint(4));
+	}
+	srv_n_write_io_threads = ut_max(srv_n_write_io_threads, ulint(4));
+
+	/* Split a large buffer pool into instances of at least 1GiB,
+	so that the threads applying the redo log do not all contend
+	for the same buffer pool mutex. */
+	srv_buf_pool_instances = ut_min(ulint(xtrabackup_use_memory >> 30),
+					ulint(MAX_BUFFER_POOLS));
+	if (srv_buf_pool_instances > 1) {
+		srv_buf_pool_chunk_unit = ulong(ut_2pow_round(
+			srv_buf_pool_size / srv_buf_pool_instances,
+			ulint(1) << 20));
+		srv_buf_pool_size = srv_buf_pool_chunk_unit
+			* srv_buf_pool_instances;
+		srv_n_page_cleaners = srv_buf_pool_instances;
+	} else {
+		srv_buf_pool_instances = 1;
 	}
 
 	msg("mariabackup: Starting InnoDB instance for recovery.\n"
 	    "mariabackup: Using %lld bytes for buffer pool "
 	    "(set by --use-memory parameter)\n", xtrabackup_use_memory);
+	msg("mariabackup: Using %lu buffer pool instances and "
+	    "%lu read I/O threads\n",
+	    ulong(srv_buf_pool_instances), ulong(srv_n_read_io_threads));
 
 	srv_max_buf_pool_modified_pct = (double)max_buf_pool_modified_pct;
 
@@ -109,6 +109,13 @@ typedef struct st_heap_block
 
 struct st_heap_info;			/* For referense */
 
+typedef struct st_hp_blob_desc		/* A BLOB column in the record */
+{
+  uint offset;				/* Offset of the column in record */
+  uint packlength;			/* Bytes used to store the length */
+} HP_BLOB_DESC;
+
+
 typedef struct st_hp_keydef		/* Key definition with open */
 {
   uint flag;				/* HA_NOSAME | HA_NULL_PART_KEY */
@@ -159,6 +166,9 @@ typedef struct st_heap_share
   LIST open_list;
   uint auto_key;
   uint auto_key_type;			/* real type of the auto key segment */
+  uint blobs;				/* Number of BLOB columns */
+  HP_BLOB_DESC *blob_descs;
+  struct st_hp_blob_chunk *blob_chunks;	/* Values of all BLOB columns */
 } HP_SHARE;
 
 struct st_hp_hash_info;
@@ -181,6 +191,7 @@ typedef struct st_heap_info
   uint file_version;                    /* Version at scan */
   uint lastkey_len;
   my_bool implicit_emptied;
+  struct st_hp_blob_chunk **blob_buff;	/* BLOB values of the new record */
   THR_LOCK_DATA lock;
   LIST open_list;
 } HP_INFO;
@@ -193,6 +204,8 @@ typedef struct st_heap_create_info
   uint auto_key_type;
   uint keys;
   uint reclength;
+  uint blobs;				/* BLOB columns, internal tables only */
+  HP_BLOB_DESC *blob_descs;
   ulong max_records;
   ulong min_records;
   ulonglong max_table_size;
@@ -415,6 +415,12 @@ int json_get_path_start(json_engine_t *je, CHARSET_INFO *i_cs,
 
 int json_get_path_next(json_engine_t *je, json_path_t *p);
 
+/*
+  Skip the OBJECT or ARRAY value json_get_path_next() has just returned,
+  so that the next json_get_path_next() call goes to the value after it.
+*/
+int json_get_path_skip_level(json_engine_t *je);
+
 
 int json_path_parts_compare(
         const json_path_step_t *a, const json_path_step_t *a_end,
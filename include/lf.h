@@ -50,6 +50,7 @@ int lf_dynarray_iterate(LF_DYNARRAY *array, lf_dynarray_func func, void *arg);
 
 #define LF_PINBOX_PINS 4
 #define LF_PURGATORY_SIZE 100
+#define LF_PURGATORY_MAX_SIZE 1000
 
 typedef void lf_pinbox_free_func(void *, void *, void*);
 
@@ -68,6 +69,7 @@ typedef struct {
   void  **stack_ends_here;
   void  *purgatory;
   uint32 purgatory_count;
+  uint32 purgatory_limit;                   /* scan the pins at this count */
   uint32 volatile link;
   /* avoid false sharing */
   char pad[CPU_LEVEL1_DCACHE_LINESIZE];
@@ -46,18 +46,33 @@ Count bits in 32bit integer
   under "Counting bits set, in parallel"
 
  (Original code public domain).
+
+  The popcnt instruction is used if the compiler may generate it.
 */
 static inline uint my_count_bits_uint32(uint32 v)
 {
+#ifdef __POPCNT__
+  return (uint) __builtin_popcount(v);
+#else
   v = v - ((v >> 1) & 0x55555555);
   v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
   return (((v + (v >> 4)) & 0xF0F0F0F) * 0x1010101) >> 24;
+#endif
 }
 
 
 static inline uint my_count_bits(ulonglong x)
 {
+#ifdef __POPCNT__
+  return (uint) __builtin_popcountll(x);
+#elif SIZEOF_VOIDP == 8
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  return (uint) ((((x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL) *
+                  0x0101010101010101ULL) >> 56);
+#else
   return my_count_bits_uint32((uint32)x) + my_count_bits_uint32((uint32)(x >> 32));
+#endif
 }
 
 
@@ -67,6 +67,7 @@ typedef struct st_tree {
   void *custom_arg;
   MEM_ROOT mem_root;
   my_bool with_delete;
+  my_bool insert_at_end;                /* Last insert was a new biggest key */
   tree_element_free free;
   myf my_flags;
   uint flag;
@@ -34,6 +34,8 @@ struct st_net_server
   before_header_callback_fn m_before_header;
   after_header_callback_fn m_after_header;
   void *m_user_data;
+  /* Deflate state of the compressed protocol, see my_compress_stream() */
+  void *m_compress_stream;
 };
 
 typedef struct st_net_server NET_SERVER;
@@ -23,7 +23,9 @@ extern "C" {
 
 typedef struct st_timer {
   struct timespec expire_time;
+  struct timespec queue_time;           /* Key in the queue, <= expire_time */
   my_bool expired;
+  my_bool in_queue;
   uint index_in_queue;
   void (*func)(void*);
   void *func_arg;
@@ -38,6 +40,7 @@ void thr_timer_init(thr_timer_t *timer_data, void(*function)(void*),
                     void *arg);
 my_bool thr_timer_settime(thr_timer_t *timer_data, ulonglong microseconds);
 void    thr_timer_end(thr_timer_t *timer_data);
+void    thr_timer_cancel(thr_timer_t *timer_data);
 
 #ifdef	__cplusplus
 }
@@ -79,10 +79,16 @@ my_bool vio_reset(Vio* vio, enum enum_vio_type type,
 size_t	vio_read(Vio *vio, uchar *	buf, size_t size);
 size_t  vio_read_buff(Vio *vio, uchar * buf, size_t size);
 size_t	vio_write(Vio *vio, const uchar * buf, size_t size);
+#ifndef _WIN32
+struct iovec;
+size_t	vio_writev(Vio *vio, const struct iovec *iov, int iovcnt);
+#endif
 int	vio_blocking(Vio *vio, my_bool onoff, my_bool *old_mode);
 my_bool	vio_is_blocking(Vio *vio);
 /* setsockopt TCP_NODELAY at IPPROTO_TCP level, when possible */
 int vio_nodelay(Vio *vio, my_bool on);
+/* setsockopt TCP_CORK at IPPROTO_TCP level, when possible */
+int vio_cork(Vio *vio, my_bool on);
 int	vio_fastsend(Vio *vio);
 /* setsockopt SO_KEEPALIVE at SOL_SOCKET level, when possible */
 int	vio_keepalive(Vio *vio, my_bool	onoff);
@@ -223,6 +229,7 @@ struct st_vio
 {
   MYSQL_SOCKET  mysql_socket;     /* Instrumented socket */
   my_bool		localhost;	/* Are we from localhost? */
+  my_bool		corked;		/* TCP_CORK is set, see vio_cork() */
   int			fcntl_mode;	/* Buffered fcntl(sd,F_GETFL) */
   struct sockaddr_storage local;	/* Local internet address */
   struct sockaddr_storage remote;	/* Remote internet address */
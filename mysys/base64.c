@@ -85,43 +85,38 @@ int
 my_base64_encode(const void *src, size_t src_len, char *dst)
 {
   const unsigned char *s= (const unsigned char*)src;
-  size_t i= 0;
+  const unsigned char *end= s + src_len;
   size_t len= 0;
 
-  for (; i < src_len; len += 4)
+  /* All complete groups of 3 bytes, without checks for padding */
+  for (; end - s >= 3; s+= 3, len+= 4)
   {
-    unsigned c;
+    unsigned c= ((unsigned) s[0] << 16) | ((unsigned) s[1] << 8) | s[2];
 
     if (len == 76)
     {
       len= 0;
       *dst++= '\n';
     }
-
-    c= s[i++];
-    c <<= 8;
-
-    if (i < src_len)
-      c += s[i];
-    c <<= 8;
-    i++;
-
-    if (i < src_len)
-      c += s[i];
-    i++;
-
     *dst++= base64_table[(c >> 18) & 0x3f];
     *dst++= base64_table[(c >> 12) & 0x3f];
+    *dst++= base64_table[(c >> 6) & 0x3f];
+    *dst++= base64_table[(c >> 0) & 0x3f];
+  }
 
-    if (i > (src_len + 1))
-      *dst++= '=';
-    else
-      *dst++= base64_table[(c >> 6) & 0x3f];
+  /* The remaining 1 or 2 bytes, padded with '=' */
+  if (s < end)
+  {
+    unsigned c= (unsigned) s[0] << 16;
 
-    if (i > src_len)
-      *dst++= '=';
-    else
-      *dst++= base64_table[(c >> 0) & 0x3f];
+    if (len == 76)
+      *dst++= '\n';
+    if (end - s == 2)
+      c|= (unsigned) s[1] << 8;
+    *dst++= base64_table[(c >> 18) & 0x3f];
+    *dst++= base64_table[(c >> 12) & 0x3f];
+    *dst++= end - s == 2 ? base64_table[(c >> 6) & 0x3f] : '=';
+    *dst++= '=';
   }
   *dst= '\0';
 
@@ -325,6 +320,27 @@ my_base64_decode(const char *src_base, size_t len,
 
   for ( ; ; )
   {
+    /*
+      Decode groups of 4 base64 characters without spaces or padding
+      directly. Anything else goes through the decoder stream below.
+    */
+    while (decoder.end - decoder.src >= 4)
+    {
+      int c0= from_base64_table[(uchar) decoder.src[0]];
+      int c1= from_base64_table[(uchar) decoder.src[1]];
+      int c2= from_base64_table[(uchar) decoder.src[2]];
+      int c3= from_base64_table[(uchar) decoder.src[3]];
+      uint c;
+
+      if ((c0 | c1 | c2 | c3) < 0)
+        break;
+      c= ((uint) c0 << 18) | ((uint) c1 << 12) | ((uint) c2 << 6) | (uint) c3;
+      *d++= (c >> 16) & 0xff;
+      *d++= (c >>  8) & 0xff;
+      *d++= (c >>  0) & 0xff;
+      decoder.src+= 4;
+    }
+
     decoder.c= 0;
     decoder.state= 0;
 
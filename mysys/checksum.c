@@ -18,6 +18,105 @@
 #include <my_sys.h>
 #include <zlib.h>
 
+#ifdef HAVE_CRC32_PCLMUL
+#include <wmmintrin.h>
+#include <smmintrin.h>
+
+/*
+  CRC-32 of a block of a multiple of 16 bytes, at least 64, computed by
+  folding it with carry-less multiplication, see "Fast CRC Computation
+  for Generic Polynomials Using PCLMULQDQ Instruction" by Intel.
+  It gives the same result as crc32() of zlib.
+*/
+
+__attribute__((target("pclmul,sse4.1")))
+static uint32 crc32_pclmul(uint32 crc, const uchar *buf, size_t len)
+{
+  static const ulonglong __attribute__((aligned(16)))
+    k1k2[]= { 0x0154442bd4ULL, 0x01c6e41596ULL },
+    k3k4[]= { 0x01751997d0ULL, 0x00ccaa009eULL },
+    k5k0[]= { 0x0163cd6124ULL, 0x0000000000ULL },
+    poly[]= { 0x01db710641ULL, 0x01f7011641ULL };
+  __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+  DBUG_ASSERT(len >= 64 && !(len & 15));
+  x1= _mm_loadu_si128((const __m128i*) (buf + 0x00));
+  x2= _mm_loadu_si128((const __m128i*) (buf + 0x10));
+  x3= _mm_loadu_si128((const __m128i*) (buf + 0x20));
+  x4= _mm_loadu_si128((const __m128i*) (buf + 0x30));
+  x1= _mm_xor_si128(x1, _mm_cvtsi32_si128((int) ~crc));
+  x0= _mm_load_si128((const __m128i*) k1k2);
+  buf+= 64;
+  len-= 64;
+
+  /* Fold 4 blocks of 16 bytes in parallel */
+  while (len >= 64)
+  {
+    x5= _mm_clmulepi64_si128(x1, x0, 0x00);
+    x6= _mm_clmulepi64_si128(x2, x0, 0x00);
+    x7= _mm_clmulepi64_si128(x3, x0, 0x00);
+    x8= _mm_clmulepi64_si128(x4, x0, 0x00);
+    x1= _mm_clmulepi64_si128(x1, x0, 0x11);
+    x2= _mm_clmulepi64_si128(x2, x0, 0x11);
+    x3= _mm_clmulepi64_si128(x3, x0, 0x11);
+    x4= _mm_clmulepi64_si128(x4, x0, 0x11);
+    y5= _mm_loadu_si128((const __m128i*) (buf + 0x00));
+    y6= _mm_loadu_si128((const __m128i*) (buf + 0x10));
+    y7= _mm_loadu_si128((const __m128i*) (buf + 0x20));
+    y8= _mm_loadu_si128((const __m128i*) (buf + 0x30));
+    x1= _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+    x2= _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+    x3= _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+    x4= _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+    buf+= 64;
+    len-= 64;
+  }
+
+  /* Fold into 128 bits */
+  x0= _mm_load_si128((const __m128i*) k3k4);
+  x5= _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1= _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1= _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+  x5= _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1= _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1= _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+  x5= _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1= _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1= _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+  /* Fold the remaining blocks of 16 bytes */
+  while (len >= 16)
+  {
+    x2= _mm_loadu_si128((const __m128i*) buf);
+    x5= _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1= _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1= _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    buf+= 16;
+    len-= 16;
+  }
+
+  /* Fold 128 bits to 64 bits */
+  x2= _mm_clmulepi64_si128(x1, x0, 0x10);
+  x3= _mm_setr_epi32(~0, 0, ~0, 0);
+  x1= _mm_srli_si128(x1, 8);
+  x1= _mm_xor_si128(x1, x2);
+  x0= _mm_loadl_epi64((const __m128i*) k5k0);
+  x2= _mm_srli_si128(x1, 4);
+  x1= _mm_and_si128(x1, x3);
+  x1= _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1= _mm_xor_si128(x1, x2);
+
+  /* Barrett reduction to 32 bits */
+  x0= _mm_load_si128((const __m128i*) poly);
+  x2= _mm_and_si128(x1, x3);
+  x2= _mm_clmulepi64_si128(x2, x0, 0x10);
+  x2= _mm_and_si128(x2, x3);
+  x2= _mm_clmulepi64_si128(x2, x0, 0x00);
+  x1= _mm_xor_si128(x1, x2);
+  return ~(uint32) _mm_extract_epi32(x1, 1);
+}
+#endif /* HAVE_CRC32_PCLMUL */
+
 /*
   Calculate a long checksum for a memoryblock.
 
@@ -35,6 +134,16 @@ ha_checksum my_checksum(ha_checksum crc, const uchar *pos, size_t length)
                                     unsigned long len);
   crc= (ha_checksum) crc32ieee_vpmsum((uint) crc, pos, (uint) length);
 #else
+#ifdef HAVE_CRC32_PCLMUL
+  if (length >= 64 && __builtin_cpu_supports("pclmul") &&
+      __builtin_cpu_supports("sse4.1"))
+  {
+    size_t blocks= length & ~(size_t) 15;
+    crc= (ha_checksum) crc32_pclmul((uint32) crc, pos, blocks);
+    pos+= blocks;
+    length-= blocks;
+  }
+#endif
   crc= (ha_checksum) crc32((uint)crc, pos, (uint) length);
 #endif
   DBUG_PRINT("info", ("crc: %lu", (ulong) crc));
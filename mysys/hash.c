@@ -279,7 +279,12 @@ uchar* my_hash_first_from_hash_value(const HASH *hash,
     do
     {
       pos= dynamic_element(&hash->array,idx,HASH_LINK*);
-      if (!hashcmp(hash,pos,key,length))
+      /*
+        Equal keys have equal hash values, so comparing the stored hash
+        value first avoids calling get_key and comparing the keys of the
+        other records in the chain
+      */
+      if (pos->hash_nr == hash_value && !hashcmp(hash,pos,key,length))
       {
 	DBUG_PRINT("exit",("found key at %d",idx));
 	*current_record= idx;
@@ -310,10 +315,11 @@ uchar* my_hash_next(const HASH *hash, const uchar *key, size_t length,
   if (*current_record != NO_RECORD)
   {
     HASH_LINK *data=dynamic_element(&hash->array,0,HASH_LINK*);
+    my_hash_value_type hash_nr= data[*current_record].hash_nr;
     for (idx=data[*current_record].next; idx != NO_RECORD ; idx=pos->next)
     {
       pos=data+idx;
-      if (!hashcmp(hash,pos,key,length))
+      if (pos->hash_nr == hash_nr && !hashcmp(hash,pos,key,length))
       {
 	*current_record= idx;
 	return pos->data;
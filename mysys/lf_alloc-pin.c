@@ -193,6 +193,7 @@ LF_PINS *lf_pinbox_get_pins(LF_PINBOX *pinbox)
   */
   el->link= pins;
   el->purgatory_count= 0;
+  el->purgatory_limit= LF_PURGATORY_SIZE;
   el->pinbox= pinbox;
   var= my_thread_var;
   /*
@@ -272,7 +273,7 @@ static int ptr_cmp(void **a, void **b)
 void lf_pinbox_free(LF_PINS *pins, void *addr)
 {
   add_to_purgatory(pins, addr);
-  if (pins->purgatory_count % LF_PURGATORY_SIZE == 0)
+  if (pins->purgatory_count >= pins->purgatory_limit)
    lf_pinbox_real_free(pins);
 }
 
@@ -402,6 +403,14 @@ static void lf_pinbox_real_free(LF_PINS *pins)
     /* pinned - keeping */
     add_to_purgatory(pins, cur);
   }
+  /*
+    A scan reads the pins of all threads, so with many threads scan less
+    often to keep its cost per freed object constant, but don't let the
+    purgatory grow without bound.
+  */
+  pins->purgatory_limit= pins->purgatory_count +
+    MY_MIN(MY_MAX(LF_PURGATORY_SIZE, pinbox->pins_in_array),
+           LF_PURGATORY_MAX_SIZE);
   if (last)
     pinbox->free_func(first, last, pinbox->free_func_arg);
 }
@@ -245,8 +245,16 @@ typedef struct st_simple_key_cache_cb
     #define KEYCACHE_TIMEOUT  1
     #define KEYCACHE_DEBUG
     #define KEYCACHE_DEBUG_LOG  "my_key_cache_debug.log"
+
+  Without SERIALIZED_READ_FROM_CACHE, reads of at most
+  SERIALIZED_READ_MAX_LENGTH bytes from a block are still copied without
+  releasing the cache lock.
 */
 
+#ifndef SERIALIZED_READ_MAX_LENGTH
+#define SERIALIZED_READ_MAX_LENGTH 1024
+#endif
+
 #define STRUCT_PTR(TYPE, MEMBER, a)                                           \
           (TYPE *) ((char *) (a) - offsetof(TYPE, MEMBER))
 
@@ -2900,16 +2908,23 @@ uchar *simple_key_cache_read(SIMPLE_KEY_CACHE_CB *keycache,
         {
           DBUG_ASSERT(block->status & (BLOCK_READ | BLOCK_IN_USE));
 #if !defined(SERIALIZED_READ_FROM_CACHE)
-          keycache_pthread_mutex_unlock(&keycache->cache_lock);
-#endif
-
-          /* Copy data from the cache buffer */
-          memcpy(buff, block->buffer+offset, (size_t) read_length);
-
-#if !defined(SERIALIZED_READ_FROM_CACHE)
-          keycache_pthread_mutex_lock(&keycache->cache_lock);
-          DBUG_ASSERT(block->status & (BLOCK_READ | BLOCK_IN_USE));
+          /*
+            Copying a key block is cheaper than releasing and acquiring
+            the contended cache_lock once more
+          */
+          if (read_length > SERIALIZED_READ_MAX_LENGTH)
+          {
+            keycache_pthread_mutex_unlock(&keycache->cache_lock);
+            memcpy(buff, block->buffer+offset, (size_t) read_length);
+            keycache_pthread_mutex_lock(&keycache->cache_lock);
+            DBUG_ASSERT(block->status & (BLOCK_READ | BLOCK_IN_USE));
+          }
+          else
 #endif
+          {
+            /* Copy data from the cache buffer */
+            memcpy(buff, block->buffer+offset, (size_t) read_length);
+          }
         }
       }
 
@@ -58,3 +58,89 @@ void radixsort_for_str_ptr(uchar **base, uint number_of_elements, size_t size_of
   next:;
   }
 }
+
+
+/*
+  Radixsort for pointers to fixed length strings, most significant byte
+  first. The strings are distributed into buckets by one byte at a time,
+  and a bucket that has become small is sorted by comparing the remaining
+  bytes, so that unlike radixsort_for_str_ptr() the cost does not grow with
+  the length of the strings. Bytes that are equal in all strings of a
+  bucket are skipped with a single counting pass.
+  Needs an extra buffer of number_of_elements pointers.
+*/
+
+#define MSD_RADIX_MIN_BUCKET 64    /* compare buckets smaller than this */
+#define MSD_RADIX_MAX_DEPTH  16    /* compare after this many splits */
+
+typedef struct st_msd_suffix
+{
+  size_t offset, length;
+} MSD_SUFFIX;
+
+static int msd_suffix_cmp(const void *arg, const void *a, const void *b)
+{
+  const MSD_SUFFIX *suffix= (const MSD_SUFFIX*) arg;
+  return memcmp(*(uchar**) a + suffix->offset,
+                *(uchar**) b + suffix->offset, suffix->length);
+}
+
+static void msd_radixsort(uchar **base, uint number_of_elements,
+                          size_t offset, size_t size_of_element,
+                          uchar **buffer, uint depth)
+{
+  uchar **end= base + number_of_elements, **ptr;
+  uint32 count[257];
+  uint i, start;
+
+  for (;; offset++)
+  {
+    if (offset == size_of_element)
+      return;
+    if (number_of_elements < MSD_RADIX_MIN_BUCKET ||
+        depth == MSD_RADIX_MAX_DEPTH)
+    {
+      MSD_SUFFIX suffix;
+      suffix.offset= offset;
+      suffix.length= size_of_element - offset;
+      my_qsort2(base, number_of_elements, sizeof(uchar*), msd_suffix_cmp,
+                &suffix);
+      return;
+    }
+    bzero((uchar*) count, sizeof(count));
+    for (ptr= base ; ptr < end ; ptr++)
+      count[ptr[0][offset] + 1]++;
+    for (i= 1 ; i < 257 ; i++)
+    {
+      if (count[i] == number_of_elements)
+        break;
+    }
+    if (i == 257)
+      break;
+  }
+
+  /* count[i] becomes the start of bucket i, and then its end */
+  for (i= 1 ; i < 256 ; i++)
+    count[i]+= count[i - 1];
+  for (ptr= base ; ptr < end ; ptr++)
+    buffer[count[ptr[0][offset]]++]= *ptr;
+  memcpy(base, buffer, number_of_elements * sizeof(uchar*));
+
+  for (i= 0, start= 0 ; i < 256 ; start= count[i++])
+  {
+    if (count[i] - start > 1)
+      msd_radixsort(base + start, count[i] - start, offset + 1,
+                    size_of_element, buffer, depth + 1);
+  }
+}
+
+my_bool msd_radixsort_is_applicable(uint n_items)
+{
+  return n_items >= 1000;
+}
+
+void msd_radixsort_for_str_ptr(uchar **base, uint number_of_elements,
+                               size_t size_of_element, uchar **buffer)
+{
+  msd_radixsort(base, number_of_elements, 0, size_of_element, buffer, 0);
+}
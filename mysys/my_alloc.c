@@ -441,6 +441,32 @@ void free_root(MEM_ROOT *root, myf MyFlags)
   DBUG_VOID_RETURN;
 }
 
+/*
+  Free everything allocated in a memory root, but keep the blocks for
+  reuse if they are not too big
+
+  SYNOPSIS
+    recycle_root()
+      root		Memory root
+      keep_size		Keep all blocks if together they take at most
+			this many bytes
+
+  NOTES
+    This is for a root that is reused for one task after the other, like
+    the statement memory root of a connection. With free_root() every
+    task would allocate and free the same blocks again.
+    If more than keep_size bytes are allocated, this is
+    free_root(root, MY_KEEP_PREALLOC).
+*/
+
+void recycle_root(MEM_ROOT *root, size_t keep_size)
+{
+  if (root->total_alloc <= keep_size)
+    free_root(root, MYF(MY_MARK_BLOCKS_FREE | MY_KEEP_PREALLOC));
+  else
+    free_root(root, MYF(MY_KEEP_PREALLOC));
+}
+
 /*
   Find block that contains an object and set the pre_alloc to it
 */
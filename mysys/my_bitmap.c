@@ -149,6 +149,11 @@ static inline void bitmap_unlock(MY_BITMAP *map __attribute__((unused)))
 
 static inline uint get_first_set(my_bitmap_map value, uint word_pos)
 {
+#if defined(__GNUC__) && !defined(WORDS_BIGENDIAN)
+  /* The bits of a little endian word are in the order of the bitmap */
+  DBUG_ASSERT(value);
+  return (word_pos*32) + (uint) __builtin_ctz(value);
+#else
   uchar *byte_ptr= (uchar*)&value;
   uchar byte_value;
   uint byte_pos, bit_pos;
@@ -164,6 +169,7 @@ static inline uint get_first_set(my_bitmap_map value, uint word_pos)
     }
   }
   return MY_BIT_NONE;                           /* Impossible */
+#endif
 }
 
 /*
@@ -605,7 +611,10 @@ uint bitmap_bits_set(const MY_BITMAP *map)
   uint res= 0;
   DBUG_ASSERT(map->bitmap);
 
-  for (; data_ptr < end; data_ptr++)
+  /* Count two words at a time, which is cheaper on 64 bit machines */
+  for (; data_ptr + 1 < end; data_ptr+= 2)
+    res+= my_count_bits(((ulonglong) data_ptr[1] << 32) | data_ptr[0]);
+  if (data_ptr < end)
     res+= my_count_bits_uint32(*data_ptr);
 
   /*Reset last bits to zero*/
@@ -702,8 +711,7 @@ uint bitmap_get_next_set(const MY_BITMAP *map, uint bitmap_bit)
 
 uint bitmap_get_first(const MY_BITMAP *map)
 {
-  uchar *byte_ptr;
-  uint i,j,k;
+  uint i;
   my_bitmap_map *data_ptr, *end= map->last_word_ptr;
 
   DBUG_ASSERT(map->bitmap);
@@ -717,20 +725,7 @@ uint bitmap_get_first(const MY_BITMAP *map)
     return MY_BIT_NONE;
 
 found:
-  byte_ptr= (uchar*)data_ptr;
-  for (j=0; ; j++, byte_ptr++)
-  {
-    if (*byte_ptr != 0xFF)
-    {
-      for (k=0; ; k++)
-      {
-        if (!(*byte_ptr & (1 << k)))
-          return (i*32) + (j*8) + k;
-      }
-    }
-  }
-  DBUG_ASSERT(0);
-  return MY_BIT_NONE;                           /* Impossible */
+  return get_first_set(~*data_ptr, i);
 }
 
 
@@ -127,6 +127,107 @@ int my_compress_buffer(uchar *dest, size_t *destLen,
     return err;
 }
 
+struct st_my_compress_stream
+{
+  z_stream stream;
+  int level;
+};
+
+/*
+  Compress data with a deflate stream that is kept between calls
+
+  SYNOPSIS
+    my_compress_stream()
+    state	In/out: compression state of the caller, 0 before the first
+		call. It is freed with my_compress_stream_end().
+    level	zlib compression level
+    dest	Buffer for the result, at least 'len' bytes
+    source	Data to compress
+    len		In: length of 'source'. Out: length of the data in 'dest'
+    complen	out: length of the original data if 'dest' holds compressed
+		data, 0 if 'source' was copied as it is because it was too
+		short or did not get shorter
+
+  NOTES
+    Every call produces a complete zlib stream, like my_compress() does.
+    Only the deflate state is reused, which saves allocating and
+    initializing it for every block.
+
+  RETURN
+    1   error. 'len' is not changed
+    0   ok
+*/
+
+my_bool my_compress_stream(void **state, int level, uchar *dest,
+                           const uchar *source, size_t *len, size_t *complen)
+{
+  struct st_my_compress_stream *cs= (struct st_my_compress_stream*) *state;
+  int err;
+  DBUG_ENTER("my_compress_stream");
+
+  *complen= 0;
+  if (*len < MIN_COMPRESS_LENGTH)
+    goto copy;
+
+  if (!cs)
+  {
+    if (!(cs= (struct st_my_compress_stream*) my_malloc(sizeof(*cs),
+                                                         MYF(MY_WME))))
+      DBUG_RETURN(1);
+    cs->stream.zalloc= (alloc_func)my_az_allocator;
+    cs->stream.zfree= (free_func)my_az_free;
+    cs->stream.opaque= (voidpf)0;
+    if (deflateInit(&cs->stream, level) != Z_OK)
+    {
+      my_free(cs);
+      DBUG_RETURN(1);
+    }
+    cs->level= level;
+    *state= cs;
+  }
+  else if (deflateReset(&cs->stream) != Z_OK)
+    DBUG_RETURN(1);
+
+  if (cs->level != level)
+  {
+    if (deflateParams(&cs->stream, level, Z_DEFAULT_STRATEGY) != Z_OK)
+      DBUG_RETURN(1);
+    cs->level= level;
+  }
+
+  cs->stream.next_in= (Bytef*) source;
+  cs->stream.avail_in= (uInt) *len;
+  cs->stream.next_out= (Bytef*) dest;
+  cs->stream.avail_out= (uInt) *len;
+  err= deflate(&cs->stream, Z_FINISH);
+  if (err == Z_STREAM_END && cs->stream.total_out < *len)
+  {
+    *complen= *len;
+    *len= cs->stream.total_out;
+    DBUG_RETURN(0);
+  }
+  if (err != Z_STREAM_END && err != Z_OK && err != Z_BUF_ERROR)
+    DBUG_RETURN(1);
+  DBUG_PRINT("note",("Packet got longer on compression; Not compressed"));
+
+copy:
+  memcpy(dest, source, *len);
+  DBUG_RETURN(0);
+}
+
+
+void my_compress_stream_end(void **state)
+{
+  struct st_my_compress_stream *cs= (struct st_my_compress_stream*) *state;
+  if (cs)
+  {
+    deflateEnd(&cs->stream);
+    my_free(cs);
+    *state= 0;
+  }
+}
+
+
 uchar *my_compress_alloc(const uchar *packet, size_t *len, size_t *complen)
 {
   uchar *compbuf;
@@ -92,9 +92,36 @@ be any number of TL_WRITE_CONCURRENT_INSERT locks aktive at the same time.
 #include <errno.h>
 
 my_bool thr_lock_inited=0;
-ulong locks_immediate = 0L, locks_waited = 0L;
+ulong locks_waited = 0L;
 enum thr_lock_type thr_upgraded_concurrent_insert_lock = TL_WRITE;
 
+/*
+  Every granted lock is counted in Table_locks_immediate. The counter is
+  split by thread, so that threads locking different tables don't write
+  to the same cache line.
+*/
+#define LOCKS_IMMEDIATE_INSTANCES 16
+
+static struct st_locks_immediate
+{
+  ulong count;
+  char pad[CPU_LEVEL1_DCACHE_LINESIZE - sizeof(ulong)];
+} locks_immediate[LOCKS_IMMEDIATE_INSTANCES];
+
+#define count_lock_immediate(DATA)                                      \
+  statistic_increment(locks_immediate[(DATA)->owner->thread_id %        \
+                                      LOCKS_IMMEDIATE_INSTANCES].count, \
+                      &THR_LOCK_lock)
+
+ulong thr_lock_immediate_count(void)
+{
+  ulong count= 0;
+  uint i;
+  for (i= 0; i < LOCKS_IMMEDIATE_INSTANCES; i++)
+    count+= locks_immediate[i].count;
+  return count;
+}
+
 #ifdef WITH_WSREP
 static wsrep_thd_is_brute_force_fun wsrep_thd_is_brute_force= NULL;
 static wsrep_abort_thd_fun wsrep_abort_thd= NULL;
@@ -732,7 +759,7 @@ wsrep_break_lock(
     wait_queue->data=data;
     data->cond=get_cond();
 
-    statistic_increment(locks_immediate,&THR_LOCK_lock);
+    count_lock_immediate(data);
     return TRUE;
   }
   return FALSE;
@@ -813,7 +840,7 @@ thr_lock(THR_LOCK_DATA *data, THR_LOCK_INFO *owner, ulong lock_wait_timeout)
 	check_locks(lock,"read lock with old write lock", lock_type, 0);
 	if (lock->get_status)
 	  (*lock->get_status)(data->status_param, 0);
-	statistic_increment(locks_immediate,&THR_LOCK_lock);
+	count_lock_immediate(data);
 	goto end;
       }
       if (lock->write.data->type == TL_WRITE_ONLY)
@@ -837,7 +864,7 @@ thr_lock(THR_LOCK_DATA *data, THR_LOCK_INFO *owner, ulong lock_wait_timeout)
       check_locks(lock,"read lock with no write locks", lock_type, 0);
       if (lock->get_status)
 	(*lock->get_status)(data->status_param, 0);
-      statistic_increment(locks_immediate,&THR_LOCK_lock);
+      count_lock_immediate(data);
       goto end;
     }
     /*
@@ -875,7 +902,7 @@ thr_lock(THR_LOCK_DATA *data, THR_LOCK_INFO *owner, ulong lock_wait_timeout)
           We don't have to do get_status here as we will do it when we change
           the delayed lock to a real write lock
         */
-	statistic_increment(locks_immediate,&THR_LOCK_lock);
+	count_lock_immediate(data);
 	goto end;
       }
     }
@@ -954,7 +981,7 @@ thr_lock(THR_LOCK_DATA *data, THR_LOCK_INFO *owner, ulong lock_wait_timeout)
 	if (lock->get_status)
 	  (*lock->get_status)(data->status_param,
                               lock_type == TL_WRITE_CONCURRENT_INSERT);
-	statistic_increment(locks_immediate,&THR_LOCK_lock);
+	count_lock_immediate(data);
 	goto end;
       }
       DBUG_PRINT("lock",("write locked 2 by thread: %lu",
@@ -989,7 +1016,7 @@ thr_lock(THR_LOCK_DATA *data, THR_LOCK_INFO *owner, ulong lock_wait_timeout)
 	  if (lock->get_status)
 	    (*lock->get_status)(data->status_param, concurrent_insert);
 	  check_locks(lock,"only write lock", lock_type, 0);
-	  statistic_increment(locks_immediate,&THR_LOCK_lock);
+	  count_lock_immediate(data);
 	  goto end;
 	}
       }
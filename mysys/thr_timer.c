@@ -17,6 +17,12 @@
 /*
   Implementation if OS independent timers.
   This is done based on pthread primitives, especially pthread_cond_timedwait()
+
+  A timer that is cancelled with thr_timer_cancel() is left in the queue
+  until its time comes. If it's set again before that to a later time, only
+  its expire_time is changed and the timer thread moves it in the queue
+  when it reaches the old time. This way a timer that is set and cancelled
+  for every statement doesn't usually need any queue operations.
 */
 
 #include "mysys_priv.h"
@@ -70,7 +76,7 @@ my_bool init_thr_timer(uint alloc_timers)
   my_bool res= 0;
   DBUG_ENTER("init_thr_timer");
 
-  init_queue(&timer_queue, alloc_timers+2, offsetof(thr_timer_t,expire_time),
+  init_queue(&timer_queue, alloc_timers+2, offsetof(thr_timer_t,queue_time),
              0, compare_timespec, NullS,
              offsetof(thr_timer_t, index_in_queue)+1, 1);
   mysql_mutex_init(key_LOCK_timer, &LOCK_timer, MY_MUTEX_INIT_FAST);
@@ -79,8 +85,9 @@ my_bool init_thr_timer(uint alloc_timers)
   /* Set dummy element with max time into the queue to simplify usage */
   bzero(&max_timer_data, sizeof(max_timer_data));
   set_max_time(&max_timer_data.expire_time);
+  max_timer_data.queue_time= max_timer_data.expire_time;
   queue_insert(&timer_queue, (uchar*) &max_timer_data);
-  next_timer_expire_time= max_timer_data.expire_time;
+  next_timer_expire_time= max_timer_data.queue_time;
 
   /* Create a thread to handle timers */
   pthread_attr_init(&thr_attr);
@@ -115,6 +122,10 @@ void end_thr_timer(void)
   mysql_mutex_unlock(&LOCK_timer);
   pthread_join(timer_thread, NULL);
 
+  /* Let thr_timer_end() of cancelled timers know they are gone */
+  while (timer_queue.elements)
+    ((thr_timer_t*) queue_remove_top(&timer_queue))->in_queue= 0;
+
   mysql_mutex_destroy(&LOCK_timer);
   mysql_cond_destroy(&COND_timer);
   delete_queue(&timer_queue);
@@ -160,28 +171,50 @@ void thr_timer_init(thr_timer_t *timer_data, void(*function)(void*),
 
 my_bool thr_timer_settime(thr_timer_t *timer_data, ulonglong micro_seconds)
 {
-  int reschedule;
+  int reschedule= 0;
+  struct timespec expire_time;
   DBUG_ENTER("thr_timer_settime");
   DBUG_PRINT("enter",("thread: %s  micro_seconds: %llu",my_thread_name(),
                       micro_seconds));
 
   DBUG_ASSERT(timer_data->expired == 1);
 
-  set_timespec_nsec(timer_data->expire_time, micro_seconds*1000);
-  timer_data->expired= 0;
+  set_timespec_nsec(expire_time, micro_seconds*1000);
 
   mysql_mutex_lock(&LOCK_timer);        /* Lock from threads & timers */
-  if (queue_insert_safe(&timer_queue,(uchar*) timer_data))
+  /* The timer thread may look at the timer if it's still in the queue */
+  timer_data->expire_time= expire_time;
+  timer_data->expired= 0;
+  if (timer_data->in_queue)
   {
-    DBUG_PRINT("info", ("timer queue full"));
-    fprintf(stderr,"Warning: thr_timer queue is full\n");
-    timer_data->expired= 1;
-    mysql_mutex_unlock(&LOCK_timer);
-    DBUG_RETURN(1);
-  }    
-
-  /* Reschedule timer if the current one has more time left than new one */
-  reschedule= cmp_timespec(next_timer_expire_time, timer_data->expire_time);
+    /*
+      The timer was cancelled but is still in the queue. If it's due later
+      than before, the timer thread will move it when the old time comes.
+    */
+    if (cmp_timespec(timer_data->expire_time, timer_data->queue_time) < 0)
+    {
+      timer_data->queue_time= timer_data->expire_time;
+      queue_replace(&timer_queue, timer_data->index_in_queue);
+      reschedule= cmp_timespec(next_timer_expire_time,
+                               timer_data->queue_time);
+    }
+  }
+  else
+  {
+    timer_data->queue_time= timer_data->expire_time;
+    if (queue_insert_safe(&timer_queue,(uchar*) timer_data))
+    {
+      DBUG_PRINT("info", ("timer queue full"));
+      fprintf(stderr,"Warning: thr_timer queue is full\n");
+      timer_data->expired= 1;
+      mysql_mutex_unlock(&LOCK_timer);
+      DBUG_RETURN(1);
+    }
+    timer_data->in_queue= 1;
+
+    /* Reschedule timer if the current one has more time left than new one */
+    reschedule= cmp_timespec(next_timer_expire_time, timer_data->queue_time);
+  }
   mysql_mutex_unlock(&LOCK_timer);
   if (reschedule > 0)
   {
@@ -199,23 +232,50 @@ my_bool thr_timer_settime(thr_timer_t *timer_data, ulonglong micro_seconds)
 /*
   Remove timer from list of timers
 
-  notes: Timer will be marked as expired
+  notes: Timer will be marked as expired.
+  This must be called before the timer data is freed, also if the timer
+  was cancelled with thr_timer_cancel().
 */
 
 void thr_timer_end(thr_timer_t *timer_data)
 {
   DBUG_ENTER("thr_timer_end");
 
+  /* Only the timer thread removes it from the queue behind our back */
+  if (!timer_data->in_queue)
+  {
+    DBUG_ASSERT(timer_data->expired);
+    DBUG_VOID_RETURN;
+  }
   mysql_mutex_lock(&LOCK_timer);
-  if (!timer_data->expired)
+  if (timer_data->in_queue)
   {
     DBUG_ASSERT(timer_data->index_in_queue != 0);
     DBUG_ASSERT(queue_element(&timer_queue, timer_data->index_in_queue) ==
                 (uchar*) timer_data);
     queue_remove(&timer_queue, timer_data->index_in_queue);
-    /* Mark as expired for asserts to work */
-    timer_data->expired= 1;
+    timer_data->in_queue= 0;
   }
+  /* Mark as expired for asserts to work */
+  timer_data->expired= 1;
+  mysql_mutex_unlock(&LOCK_timer);
+  DBUG_VOID_RETURN;
+}
+
+
+/*
+  Cancel a timer, but leave it in the queue to be reused by the next
+  thr_timer_settime()
+
+  notes: Timer will be marked as expired
+*/
+
+void thr_timer_cancel(thr_timer_t *timer_data)
+{
+  DBUG_ENTER("thr_timer_cancel");
+
+  mysql_mutex_lock(&LOCK_timer);
+  timer_data->expired= 1;
   mysql_mutex_unlock(&LOCK_timer);
   DBUG_VOID_RETURN;
 }
@@ -242,19 +302,35 @@ static sig_handler process_timers(struct timespec *now)
     void *func_arg;
 
     timer_data= (thr_timer_t*) queue_top(&timer_queue);
-    function=   timer_data->func;
-    func_arg=   timer_data->func_arg;
-    timer_data->expired= 1;			/* Mark expired */
-    /*
-      We remove timer before calling timer function to allow thread to
-      delete it's timer data any time.
-    */
-    queue_remove_top(&timer_queue);		/* Remove timer */
-    (*function)(func_arg);                      /* Inform thread of timeout */
+    if (timer_data->expired)
+    {
+      /* Cancelled by thr_timer_cancel() */
+      timer_data->in_queue= 0;
+      queue_remove_top(&timer_queue);
+    }
+    else if (cmp_timespec(timer_data->expire_time, (*now)) > 0)
+    {
+      /* Set to a later time after it was cancelled */
+      timer_data->queue_time= timer_data->expire_time;
+      queue_replace_top(&timer_queue);
+    }
+    else
+    {
+      function=   timer_data->func;
+      func_arg=   timer_data->func_arg;
+      timer_data->expired= 1;			/* Mark expired */
+      timer_data->in_queue= 0;
+      /*
+        We remove timer before calling timer function to allow thread to
+        delete it's timer data any time.
+      */
+      queue_remove_top(&timer_queue);		/* Remove timer */
+      (*function)(func_arg);                    /* Inform thread of timeout */
+    }
 
     /* Check if next one has also expired */
     timer_data= (thr_timer_t*) queue_top(&timer_queue);
-    if (cmp_timespec(timer_data->expire_time, (*now)) > 0)
+    if (cmp_timespec(timer_data->queue_time, (*now)) > 0)
       break;                                    /* All data processed */
   }
   DBUG_VOID_RETURN;
@@ -279,12 +355,12 @@ static void *timer_handler(void *arg __attribute__((unused)))
 
     set_timespec(now, 0);
 
-    top_time= &(((thr_timer_t*) queue_top(&timer_queue))->expire_time);
+    top_time= &(((thr_timer_t*) queue_top(&timer_queue))->queue_time);
 
     if (cmp_timespec((*top_time), now) <= 0)
     {
       process_timers(&now);
-      top_time= &(((thr_timer_t*) queue_top(&timer_queue))->expire_time);
+      top_time= &(((thr_timer_t*) queue_top(&timer_queue))->queue_time);
     }
 
     abstime= *top_time;
@@ -398,8 +474,9 @@ static void run_thread_benchmark(int param)
       printf("Thread: %s  timers aborted\n",my_thread_name());
       break;
     }
-    thr_timer_end(&timer_data);
+    thr_timer_cancel(&timer_data);
   }
+  thr_timer_end(&timer_data);
   DBUG_VOID_RETURN;
 }
 
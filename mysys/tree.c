@@ -108,6 +108,7 @@ void init_tree(TREE *tree, size_t default_alloc_size, size_t memory_limit,
   tree->null_element.left=tree->null_element.right=0;
   tree->my_flags= my_flags;
   tree->flag= 0;
+  tree->insert_at_end= 0;
   if (!free_element && size >= 0 &&
       ((uint) size <= sizeof(void*) || ((uint) size & (sizeof(void*)-1))))
   {
@@ -242,9 +243,31 @@ TREE_ELEMENT *tree_insert(TREE *tree, void *key, uint key_size,
 {
   int cmp;
   TREE_ELEMENT *element,***parent;
+  my_bool at_end= 1;
 
   parent= tree->parents;
   *parent = &tree->root; element= tree->root;
+  if (tree->insert_at_end && element != &tree->null_element)
+  {
+    /*
+      The keys may come in order, like row ids from an index scan.
+      Compare the key only with the biggest key in the tree first.
+    */
+    while (element->right != &tree->null_element)
+    {
+      *++parent= &element->right; element= element->right;
+    }
+    cmp= (*tree->compare)(custom_arg, ELEMENT_KEY(tree,element), key);
+    if (cmp < 0)
+    {
+      *++parent= &element->right; element= element->right;
+    }
+    if (cmp <= 0)
+      goto found;
+    tree->insert_at_end= 0;
+    parent= tree->parents;
+    element= tree->root;
+  }
   for (;;)
   {
     if (element == &tree->null_element ||
@@ -258,8 +281,12 @@ TREE_ELEMENT *tree_insert(TREE *tree, void *key, uint key_size,
     else
     {
       *++parent = &element->left; element= element->left;
+      at_end= 0;
     }
   }
+  tree->insert_at_end= at_end && element == &tree->null_element;
+
+found:
   if (element == &tree->null_element)
   {
     uint alloc_size;
@@ -19,6 +19,7 @@
 #include <table.h>
 #include <sql_show.h>
 #include <mysql/plugin_audit.h>
+#include <sql_digest_stats.h>
 #include "query_response_time.h"
 
 
@@ -103,6 +104,154 @@ static struct st_mysql_information_schema query_response_time_info_descriptor=
 { MYSQL_INFORMATION_SCHEMA_INTERFACE_VERSION };
 
 
+ST_FIELD_INFO query_digest_statistics_fields_info[] =
+{
+  { "DIGEST",        32,                          MYSQL_TYPE_STRING,   0, 0,               0, 0 },
+  { "DIGEST_TEXT",   65535,                       MYSQL_TYPE_STRING,   0, 0,               0, 0 },
+  { "COUNT",         MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0 },
+  { "ERRORS",        MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0 },
+  { "ROWS_SENT",     MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0 },
+  { "ROWS_EXAMINED", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0 },
+  { "TOTAL_TIME",    MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0 },
+  { "MIN_TIME",      MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0 },
+  { "MAX_TIME",      MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0 },
+  { "P50_TIME",      MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0 },
+  { "P95_TIME",      MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0 },
+  { "P99_TIME",      MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0 },
+  { "PARSE_TIME",    MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0 },
+  { "LOCK_TIME",     MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0 },
+  { 0, 0, MYSQL_TYPE_NULL, 0, 0, 0, 0 }
+};
+
+
+struct query_digest_statistics_fill_arg
+{
+  THD *thd;
+  TABLE *table;
+};
+
+
+static my_bool query_digest_statistics_store(const Digest_stats *stats,
+                                             const char *text,
+                                             size_t text_length, void *arg)
+{
+  query_digest_statistics_fill_arg *fill_arg=
+    (query_digest_statistics_fill_arg*) arg;
+  TABLE *table= fill_arg->table;
+  char digest[MD5_HASH_SIZE * 2];
+
+  array_to_hex(digest, stats->md5, MD5_HASH_SIZE);
+  restore_record(table, s->default_values);
+  table->field[0]->store(digest, sizeof(digest), system_charset_info);
+  table->field[1]->store(text, text_length, system_charset_info);
+  table->field[2]->store((longlong) stats->count, TRUE);
+  table->field[3]->store((longlong) stats->errors, TRUE);
+  table->field[4]->store((longlong) stats->rows_sent, TRUE);
+  table->field[5]->store((longlong) stats->rows_examined, TRUE);
+  table->field[6]->store((longlong) stats->sum_time, TRUE);
+  table->field[7]->store((longlong) stats->min_time, TRUE);
+  table->field[8]->store((longlong) stats->max_time, TRUE);
+  table->field[9]->store((longlong) stats->percentile_time(0.50), TRUE);
+  table->field[10]->store((longlong) stats->percentile_time(0.95), TRUE);
+  table->field[11]->store((longlong) stats->percentile_time(0.99), TRUE);
+  table->field[12]->store((longlong) stats->sum_parse_time, TRUE);
+  table->field[13]->store((longlong) stats->sum_lock_time, TRUE);
+  return schema_table_store_record(fill_arg->thd, table);
+}
+
+
+static int query_digest_statistics_fill(THD *thd, TABLE_LIST *tables,
+                                        COND *cond __attribute__((unused)))
+{
+  query_digest_statistics_fill_arg arg= { thd, tables->table };
+  return digest_stats_iterate(query_digest_statistics_store, &arg);
+}
+
+
+static int query_digest_statistics_reset()
+{
+  digest_stats_reset();
+  return 0;
+}
+
+
+static int query_digest_statistics_init(void *p)
+{
+  ST_SCHEMA_TABLE *i_s_query_digest_statistics= (ST_SCHEMA_TABLE *) p;
+  i_s_query_digest_statistics->fields_info=
+    query_digest_statistics_fields_info;
+  i_s_query_digest_statistics->fill_table= query_digest_statistics_fill;
+  i_s_query_digest_statistics->reset_table= query_digest_statistics_reset;
+  return 0;
+}
+
+
+ST_FIELD_INFO query_digest_response_time_fields_info[] =
+{
+  { "DIGEST", 32,                          MYSQL_TYPE_STRING,   0, 0,                                  0, 0 },
+  { "TIME",   MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED | MY_I_S_MAYBE_NULL, 0, 0 },
+  { "COUNT",  MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED,                    0, 0 },
+  { 0, 0, MYSQL_TYPE_NULL, 0, 0, 0, 0 }
+};
+
+
+/**
+  Store a row for every non-empty bucket of the histogram of a digest.
+
+  TIME is the upper bound of the bucket in microseconds, NULL for the last
+  bucket that counts all the longer statements.
+*/
+
+static my_bool query_digest_response_time_store(const Digest_stats *stats,
+                                                const char *text,
+                                                size_t text_length, void *arg)
+{
+  query_digest_statistics_fill_arg *fill_arg=
+    (query_digest_statistics_fill_arg*) arg;
+  TABLE *table= fill_arg->table;
+  char digest[MD5_HASH_SIZE * 2];
+
+  array_to_hex(digest, stats->md5, MD5_HASH_SIZE);
+  for (uint i= 0; i < DIGEST_STATS_BUCKETS; i++)
+  {
+    if (!stats->histogram[i])
+      continue;
+    restore_record(table, s->default_values);
+    table->field[0]->store(digest, sizeof(digest), system_charset_info);
+    if (i < DIGEST_STATS_BUCKETS - 1)
+    {
+      table->field[1]->set_notnull();
+      table->field[1]->store((longlong) digest_stats_bucket_bound(i), TRUE);
+    }
+    else
+      table->field[1]->set_null();
+    table->field[2]->store((longlong) stats->histogram[i], TRUE);
+    if (schema_table_store_record(fill_arg->thd, table))
+      return TRUE;
+  }
+  return FALSE;
+}
+
+
+static int query_digest_response_time_fill(THD *thd, TABLE_LIST *tables,
+                                           COND *cond __attribute__((unused)))
+{
+  query_digest_statistics_fill_arg arg= { thd, tables->table };
+  return digest_stats_iterate(query_digest_response_time_store, &arg);
+}
+
+
+static int query_digest_response_time_init(void *p)
+{
+  ST_SCHEMA_TABLE *i_s_query_digest_response_time= (ST_SCHEMA_TABLE *) p;
+  i_s_query_digest_response_time->fields_info=
+    query_digest_response_time_fields_info;
+  i_s_query_digest_response_time->fill_table= query_digest_response_time_fill;
+  i_s_query_digest_response_time->reset_table= query_digest_statistics_reset;
+  return 0;
+}
+
+
 static void query_response_time_audit_notify(MYSQL_THD thd,
                                              unsigned int event_class,
                                              const void *event)
@@ -161,5 +310,35 @@ maria_declare_plugin(query_response_time)
   NULL,
   "1.0",
   MariaDB_PLUGIN_MATURITY_STABLE
+},
+{
+  MYSQL_INFORMATION_SCHEMA_PLUGIN,
+  &query_response_time_info_descriptor,
+  "QUERY_DIGEST_STATISTICS",
+  "MariaDB Corporation",
+  "Statement Statistics by Digest INFORMATION_SCHEMA Plugin",
+  PLUGIN_LICENSE_GPL,
+  query_digest_statistics_init,
+  NULL,
+  0x0100,
+  NULL,
+  NULL,
+  "1.0",
+  MariaDB_PLUGIN_MATURITY_EXPERIMENTAL
+},
+{
+  MYSQL_INFORMATION_SCHEMA_PLUGIN,
+  &query_response_time_info_descriptor,
+  "QUERY_DIGEST_RESPONSE_TIME",
+  "MariaDB Corporation",
+  "Execution Time Histograms by Digest INFORMATION_SCHEMA Plugin",
+  PLUGIN_LICENSE_GPL,
+  query_digest_response_time_init,
+  NULL,
+  0x0100,
+  NULL,
+  NULL,
+  "1.0",
+  MariaDB_PLUGIN_MATURITY_EXPERIMENTAL
 }
 maria_declare_plugin_end;
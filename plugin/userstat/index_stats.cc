@@ -11,6 +11,8 @@ static int index_stats_fill(THD *thd, TABLE_LIST *tables, COND *cond)
 {
   TABLE *table= tables->table;
 
+  /* Include the statements of this connection that are not merged yet */
+  merge_table_index_stats(thd);
   mysql_mutex_lock(&LOCK_global_index_stats);
   for (uint i= 0; i < global_index_stats.records; i++)
   {
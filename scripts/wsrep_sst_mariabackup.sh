@@ -374,7 +374,7 @@ get_stream()
     if [[ $sfmt == 'xbstream' ]];then 
         wsrep_log_info "Streaming with xbstream"
         if [[ "$WSREP_SST_OPT_ROLE"  == "joiner" ]];then
-            strmcmd="${XBSTREAM_BIN} -x"
+            strmcmd="${XBSTREAM_BIN} -x --parallel=$nproc"
         else
             strmcmd="${XBSTREAM_BIN} -c \${INFO_FILE}"
         fi
@@ -665,6 +665,7 @@ fi
 
 read_cnf
 setup_ports
+get_proc
 
 if ${INNOBACKUPEX_BIN} /tmp --help 2>/dev/null | grep -q -- '--version-check'; then 
     disver="--no-version-check"
@@ -675,6 +676,11 @@ if [[ ${FORCE_FTWRL:-0} -eq 1 ]];then
     iopts+=" --no-backup-locks "
 fi
 
+# Copy the data files with one thread per processor unless configured
+if [[ ! $iopts =~ --parallel ]] && [[ -z $(parse_cnf "mariabackup xtrabackup" parallel "") ]];then
+    iopts+=" --parallel=$nproc "
+fi
+
 
 INNOEXTRA=""
 
@@ -941,8 +947,6 @@ then
         wsrep_log_info "Waiting for SST streaming to complete!"
         monitor_process $jpid
 
-        get_proc
-
         if [[ ! -s ${DATA}/xtrabackup_checkpoints ]];then 
             wsrep_log_error "xtrabackup_checkpoints missing, failed innobackupex/SST on donor"
             exit 2
@@ -0,0 +1,191 @@
+#!/usr/bin/perl
+# Copyright (c) 2019, MariaDB Corporation.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; version 2 of the License.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+#
+# Run the OLTP, analytic and DDL workloads of the slap directory with
+# mysqlslap, and write the results as CSV, one line per workload and
+# concurrency:
+#
+# suite,workload,concurrency,avg_seconds,min_seconds,max_seconds,clients,
+# queries,p50_us,p99_us,p999_us
+#
+# A suite is defined by the files slap/<suite>-*.sql. <suite>-prepare.sql
+# creates and fills the tables, in a new schema for every iteration. Each
+# other file is a workload, whose statements every client runs in a loop
+# until --queries statements have been run in total. %ROWS% and %ENGINE%
+# in the files are replaced by the values of --rows and --engine. A
+# workload file may override --concurrency and --queries with lines
+# "-- concurrency: N" and "-- queries: N".
+#
+# The data is generated with the SEQUENCE engine and RAND(seed), so the
+# same options give the same data on every run.
+
+use Getopt::Long;
+use File::Basename;
+use File::Temp qw(tempfile);
+
+$opt_mysqlslap= "mysqlslap";
+$opt_dir= dirname($0) . "/slap";
+$opt_suite= "oltp,analytic,ddl";
+$opt_engine= "InnoDB";
+$opt_rows= 100000;
+$opt_concurrency= "1,8,32";
+$opt_iterations= 3;
+$opt_queries= 10000;
+$opt_output= "-";
+$opt_user= $opt_password= $opt_host= $opt_port= $opt_socket= "";
+$opt_help= 0;
+
+GetOptions("mysqlslap=s", "dir=s", "suite=s", "engine=s", "rows=i",
+           "concurrency=s", "iterations=i", "queries=i", "output=s",
+           "user=s", "password=s", "host=s", "port=i", "socket=s",
+           "help") || usage();
+usage() if ($opt_help);
+
+@connect_args= ();
+push(@connect_args, "--user=$opt_user") if ($opt_user ne "");
+push(@connect_args, "--password=$opt_password") if ($opt_password ne "");
+push(@connect_args, "--host=$opt_host") if ($opt_host ne "");
+push(@connect_args, "--port=$opt_port") if ($opt_port ne "");
+push(@connect_args, "--socket=$opt_socket") if ($opt_socket ne "");
+
+open(OUT, $opt_output eq "-" ? ">-" : ">$opt_output") ||
+  die "Can't open $opt_output: $!\n";
+print OUT "suite,workload,concurrency,avg_seconds,min_seconds,max_seconds," .
+  "clients,queries,p50_us,p99_us,p999_us\n";
+
+$errors= 0;
+foreach $suite (split(/,/, $opt_suite))
+{
+  $prepare= "$opt_dir/$suite-prepare.sql";
+  die "Unknown suite $suite: $prepare not found\n" if (! -f $prepare);
+  ($create)= read_statements($prepare);
+
+  foreach $file (sort glob("$opt_dir/$suite-*.sql"))
+  {
+    next if ($file eq $prepare);
+    ($query, %settings)= read_statements($file);
+    $workload= basename($file, ".sql");
+    $workload =~ s/^\Q$suite\E-//;
+    $concurrency= $settings{concurrency} || $opt_concurrency;
+    $queries= $settings{queries} || $opt_queries;
+    foreach $clients (split(/,/, $concurrency))
+    {
+      $errors+= !run_workload($suite, $workload, $clients, $queries,
+                              $create, $query);
+    }
+  }
+}
+close(OUT);
+exit($errors ? 1 : 0);
+
+#
+# Read an SQL file as mysqlslap statements separated by ';', without
+# comments. Return the statements and the settings of the file.
+#
+
+sub read_statements
+{
+  my ($file)= @_;
+  my ($sql, %settings)= ("");
+
+  open(SQL, "<$file") || die "Can't open $file: $!\n";
+  while (<SQL>)
+  {
+    if (/^--\s*(concurrency|queries):\s*(\d+)/)
+    {
+      $settings{$1}= $2;
+      next;
+    }
+    next if (/^--/ || /^\s*$/);
+    chomp;
+    $sql.= "$_ ";
+  }
+  close(SQL);
+  $sql =~ s/%ROWS%/$opt_rows/g;
+  $sql =~ s/%ENGINE%/$opt_engine/g;
+  $sql =~ s/;\s*/;/g;
+  $sql =~ s/;$//;
+  return ($sql, %settings);
+}
+
+#
+# Run a workload with mysqlslap and append its result to the output.
+# Return 1 on success.
+#
+
+sub run_workload
+{
+  my ($suite, $workload, $clients, $queries, $create, $query)= @_;
+  my ($create_fh, $create_file)= tempfile();
+  my ($query_fh, $query_file)= tempfile();
+  my (undef, $csv_file)= tempfile();
+  my ($res, $line);
+
+  print $create_fh $create;
+  close($create_fh);
+  print $query_fh $query;
+  close($query_fh);
+
+  $res= system($opt_mysqlslap, @connect_args,
+               "--create-schema=slap_$suite", "--create=$create_file",
+               "--query=$query_file", "--delimiter=;",
+               "--concurrency=$clients", "--iterations=$opt_iterations",
+               "--number-of-queries=$queries", "--percentiles",
+               "--csv=$csv_file", "--silent");
+  if ($res == 0 && open(CSV, "<$csv_file"))
+  {
+    $line= <CSV>;
+    close(CSV);
+  }
+  unlink($create_file, $query_file, $csv_file);
+
+  if (!defined($line))
+  {
+    print STDERR "Workload $suite-$workload failed with concurrency $clients\n";
+    return 0;
+  }
+  # Replace the engine and load type columns of mysqlslap
+  $line =~ s/^[^,]*,[^,]*,//;
+  print OUT "$suite,$workload,$clients,$line";
+  return 1;
+}
+
+sub usage
+{
+  print <<EOF;
+Usage: $0 [options]
+
+Run reproducible OLTP, analytic and DDL workloads with mysqlslap and print
+the results as CSV.
+
+Options:
+--mysqlslap=path      mysqlslap to run (Default: $opt_mysqlslap)
+--dir=dir             Directory of the workload files (Default: $opt_dir)
+--suite=list          Comma separated suites to run (Default: $opt_suite)
+--engine=name         Storage engine of the tables (Default: $opt_engine)
+--rows=N              Number of rows of the main table (Default: $opt_rows)
+--concurrency=list    Comma separated numbers of clients
+                      (Default: $opt_concurrency)
+--iterations=N        Number of times to run every workload
+                      (Default: $opt_iterations)
+--queries=N           Number of statements of a workload run
+                      (Default: $opt_queries)
+--output=file         CSV file to write, - for stdout (Default: $opt_output)
+--user, --password, --host, --port, --socket
+                      Passed to mysqlslap
+EOF
+  exit(0);
+}
@@ -0,0 +1,61 @@
+-- Tables of the analytic workloads, a subset of the TPC-H schema.
+-- There are %ROWS% orders of 4 line items each.
+CREATE TABLE customer (
+  c_custkey INT NOT NULL PRIMARY KEY,
+  c_nationkey INT NOT NULL,
+  c_mktsegment CHAR(10) NOT NULL,
+  KEY (c_mktsegment)
+) ENGINE=%ENGINE%;
+CREATE TABLE orders (
+  o_orderkey INT NOT NULL PRIMARY KEY,
+  o_custkey INT NOT NULL,
+  o_orderstatus CHAR(1) NOT NULL,
+  o_totalprice DECIMAL(15,2) NOT NULL,
+  o_orderdate DATE NOT NULL,
+  o_orderpriority CHAR(15) NOT NULL,
+  o_shippriority INT NOT NULL,
+  KEY (o_custkey),
+  KEY (o_orderdate)
+) ENGINE=%ENGINE%;
+CREATE TABLE lineitem (
+  l_orderkey INT NOT NULL,
+  l_linenumber INT NOT NULL,
+  l_quantity DECIMAL(15,2) NOT NULL,
+  l_extendedprice DECIMAL(15,2) NOT NULL,
+  l_discount DECIMAL(15,2) NOT NULL,
+  l_tax DECIMAL(15,2) NOT NULL,
+  l_returnflag CHAR(1) NOT NULL,
+  l_linestatus CHAR(1) NOT NULL,
+  l_shipdate DATE NOT NULL,
+  l_commitdate DATE NOT NULL,
+  l_receiptdate DATE NOT NULL,
+  PRIMARY KEY (l_orderkey, l_linenumber),
+  KEY (l_shipdate)
+) ENGINE=%ENGINE%;
+INSERT INTO customer
+  SELECT seq, seq % 25,
+         ELT(1 + seq % 5, 'AUTOMOBILE', 'BUILDING', 'FURNITURE',
+             'HOUSEHOLD', 'MACHINERY')
+  FROM seq_1_to_%ROWS% WHERE seq % 10 = 0;
+INSERT INTO orders
+  SELECT seq, 10 * (1 + FLOOR(RAND(seq) * %ROWS% / 10)),
+         ELT(1 + seq % 3, 'F', 'O', 'P'),
+         ROUND(RAND(seq + 1) * 500000, 2),
+         '1992-01-01' + INTERVAL FLOOR(RAND(seq + 2) * 2400) DAY,
+         ELT(1 + seq % 5, '1-URGENT', '2-HIGH', '3-MEDIUM',
+             '4-NOT SPECIFIED', '5-LOW'),
+         0
+  FROM seq_1_to_%ROWS%;
+INSERT INTO lineitem
+  SELECT o_orderkey, l.seq,
+         1 + FLOOR(RAND(o_orderkey * 4 + l.seq) * 50),
+         ROUND(RAND(o_orderkey * 4 + l.seq + 1) * 100000, 2),
+         FLOOR(RAND(o_orderkey * 4 + l.seq + 2) * 11) / 100,
+         FLOOR(RAND(o_orderkey * 4 + l.seq + 3) * 9) / 100,
+         ELT(1 + (o_orderkey + l.seq) % 3, 'A', 'N', 'R'),
+         ELT(1 + (o_orderkey + l.seq) % 2, 'F', 'O'),
+         o_orderdate + INTERVAL l.seq * 7 DAY,
+         o_orderdate + INTERVAL 30 DAY,
+         o_orderdate + INTERVAL l.seq * 7 + 5 DAY
+  FROM orders, seq_1_to_4 l;
+ANALYZE TABLE customer, orders, lineitem;
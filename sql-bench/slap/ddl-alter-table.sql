@@ -0,0 +1,9 @@
+-- concurrency: 1
+-- queries: 60
+-- Index creation and removal, and column addition and removal
+ALTER TABLE sbtest ADD INDEX c (c);
+ALTER TABLE sbtest DROP INDEX c;
+ALTER TABLE sbtest ADD COLUMN d INT NOT NULL DEFAULT 0;
+ALTER TABLE sbtest DROP COLUMN d;
+ALTER TABLE sbtest ADD COLUMN e CHAR(10) NOT NULL DEFAULT '' AFTER id;
+ALTER TABLE sbtest DROP COLUMN e;
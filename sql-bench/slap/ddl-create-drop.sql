@@ -0,0 +1,12 @@
+-- queries: 1000
+-- Creation and removal of a table in every client
+SET @t= CONCAT('t', CONNECTION_ID());
+SET @s= CONCAT('CREATE TABLE ', @t, ' (a INT PRIMARY KEY, b CHAR(60), KEY (b)) ENGINE=%ENGINE%');
+PREPARE s FROM @s;
+EXECUTE s;
+SET @s= CONCAT('INSERT INTO ', @t, ' SELECT seq, SHA2(seq, 224) FROM seq_1_to_100');
+PREPARE s FROM @s;
+EXECUTE s;
+SET @s= CONCAT('DROP TABLE ', @t);
+PREPARE s FROM @s;
+EXECUTE s;
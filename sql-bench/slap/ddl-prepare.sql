@@ -0,0 +1,13 @@
+-- Table of the DDL workloads, the same as for the OLTP workloads
+CREATE TABLE sbtest (
+  id INT NOT NULL PRIMARY KEY,
+  k INT NOT NULL,
+  c CHAR(120) NOT NULL,
+  pad CHAR(60) NOT NULL,
+  KEY k (k)
+) ENGINE=%ENGINE%;
+INSERT INTO sbtest
+  SELECT seq, FLOOR(1 + RAND(seq) * %ROWS%),
+         SHA2(seq, 384), SHA2(-seq, 224)
+  FROM seq_1_to_%ROWS%;
+ANALYZE TABLE sbtest;
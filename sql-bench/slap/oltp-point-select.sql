@@ -0,0 +1,3 @@
+-- Primary key lookups
+SET @id= FLOOR(1 + RAND() * %ROWS%);
+SELECT c FROM sbtest WHERE id= @id;
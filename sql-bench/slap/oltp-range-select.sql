@@ -0,0 +1,6 @@
+-- Range scans of 100 rows, on the primary key and on a secondary key
+SET @id= FLOOR(1 + RAND() * %ROWS%);
+SELECT c FROM sbtest WHERE id BETWEEN @id AND @id + 99;
+SELECT SUM(k) FROM sbtest WHERE id BETWEEN @id AND @id + 99;
+SELECT DISTINCT c FROM sbtest WHERE id BETWEEN @id AND @id + 99 ORDER BY c;
+SELECT COUNT(*) FROM sbtest WHERE k BETWEEN @id AND @id + 99;
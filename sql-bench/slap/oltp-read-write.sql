@@ -0,0 +1,11 @@
+-- A transaction of point selects, a range select, updates and a
+-- delete followed by the insert of the same row
+BEGIN;
+SET @id= FLOOR(1 + RAND() * %ROWS%);
+SELECT c FROM sbtest WHERE id= @id;
+SELECT c FROM sbtest WHERE id= FLOOR(1 + RAND() * %ROWS%);
+SELECT c FROM sbtest WHERE id BETWEEN @id AND @id + 99;
+UPDATE sbtest SET k= k + 1 WHERE id= @id;
+DELETE FROM sbtest WHERE id= @id + 1;
+INSERT IGNORE INTO sbtest VALUES (@id + 1, @id, SHA2(@id, 384), SHA2(-@id, 224));
+COMMIT;
@@ -0,0 +1,4 @@
+-- Updates of an indexed and of a non-indexed column
+SET @id= FLOOR(1 + RAND() * %ROWS%);
+UPDATE sbtest SET k= k + 1 WHERE id= @id;
+UPDATE sbtest SET c= SHA2(RAND(), 384) WHERE id= @id;
@@ -7860,6 +7860,18 @@ void Field_varstring::hash(ulong *nr, ulong *nr2)
 
   Header is immediately followed by original data length,
   followed by compressed data.
+
+  If compression method is zstd:
+
+  Bits 1-3: number of bytes occupied by original data length
+  Bits   4: unused
+  Bits 5-8: store 9 (zstd)
+
+  Header is immediately followed by original data length,
+  followed by a zstd frame.
+
+  The method is stored in every value, so a column can hold values
+  compressed with different methods after ALTER TABLE changed its method.
 */
 
 int Field_longstr::compress(char *to, uint to_length,
@@ -7918,6 +7930,25 @@ int Field_longstr::compress(char *to, uint to_length,
 }
 
 
+/**
+  Print the COMPRESSED attribute of a column for SHOW CREATE TABLE.
+  zlib columns are printed as before, so that older servers can read them.
+*/
+
+void Field_longstr::sql_type_compressed(String &str,
+                                        const Compression_method *method)
+{
+  if (method == zlib_compression_method)
+    str.append(STRING_WITH_LEN(" /*!100301 COMPRESSED*/"));
+  else
+  {
+    str.append(STRING_WITH_LEN(" /*!100401 COMPRESSED="));
+    str.append(method->name);
+    str.append(STRING_WITH_LEN("*/"));
+  }
+}
+
+
 /*
   Memory is allocated only when original data was actually compressed.
   Otherwise val_ptr points at data located immediately after header.
@@ -10546,10 +10577,11 @@ Column_definition::Column_definition(THD *thd, Field *old_field,
   {
     default_value= orig_field->default_value;
     check_constraint= orig_field->check_constraint;
-    if (orig_field->unireg_check == Field::TMYSQL_COMPRESSED)
+    if (Compression_method *method=
+          Field::unireg_check_compression_method(orig_field->unireg_check))
     {
-      unireg_check= Field::TMYSQL_COMPRESSED;
-      compression_method_ptr= zlib_compression_method;
+      unireg_check= orig_field->unireg_check;
+      compression_method_ptr= method;
     }
   }
   else
@@ -10693,6 +10725,34 @@ bool Column_definition::has_default_expression()
 }
 
 
+/**
+  Compression method of a column, as stored in the frm by its unireg_check
+
+  @return 0 if the column is not compressed
+*/
+
+Compression_method *Field::unireg_check_compression_method(utype unireg_check)
+{
+  switch (unireg_check) {
+  case TMYSQL_COMPRESSED:
+    return zlib_compression_method;
+  case ZSTD_COMPRESSED:
+    /* Values are stored but can't be read if built without zstd */
+    return zstd_compression_method->name ? zstd_compression_method :
+                                           zlib_compression_method;
+  default:
+    return 0;
+  }
+}
+
+
+Field::utype Field::compressed_unireg_check(const Compression_method *method)
+{
+  return method == zstd_compression_method ? ZSTD_COMPRESSED :
+                                             TMYSQL_COMPRESSED;
+}
+
+
 bool Column_definition::set_compressed(const char *method)
 {
   enum enum_field_types sql_type= real_field_type();
@@ -10701,10 +10761,12 @@ bool Column_definition::set_compressed(const char *method)
       sql_type == MYSQL_TYPE_BLOB || sql_type == MYSQL_TYPE_MEDIUM_BLOB ||
       sql_type == MYSQL_TYPE_LONG_BLOB)
   {
-    if (!method || !strcmp(method, zlib_compression_method->name))
+    Compression_method *found= method ? find_compression_method(method) :
+                                        zlib_compression_method;
+    if (found)
     {
-      unireg_check= Field::TMYSQL_COMPRESSED;
-      compression_method_ptr= zlib_compression_method;
+      unireg_check= Field::compressed_unireg_check(found);
+      compression_method_ptr= found;
       return false;
     }
     my_error(ER_UNKNOWN_COMPRESSION_METHOD, MYF(0), method);
@@ -680,7 +680,11 @@ class Field: public Value_source
     TIMESTAMP_UN_FIELD=22,      // TIMESTAMP ON UPDATE NOW()
     TIMESTAMP_DNUN_FIELD=23,    // TIMESTAMP DEFAULT NOW() ON UPDATE NOW()
     TMYSQL_COMPRESSED= 24,      // Compatibility with TMySQL
+    ZSTD_COMPRESSED= 25,        // COMPRESSED=zstd
     };
+  static Compression_method *
+    unireg_check_compression_method(utype unireg_check);
+  static utype compressed_unireg_check(const Compression_method *method);
   enum geometry_type
   {
     GEOM_GEOMETRY = 0, GEOM_POINT = 1, GEOM_LINESTRING = 2, GEOM_POLYGON = 3,
@@ -1892,6 +1896,8 @@ class Field_longstr :public Field_str
                CHARSET_INFO *cs, size_t nchars);
   String *uncompress(String *val_buffer, String *val_ptr,
                      const uchar *from, uint from_length);
+  static void sql_type_compressed(String &str,
+                                  const Compression_method *method);
 public:
   Field_longstr(uchar *ptr_arg, uint32 len_arg, uchar *null_ptr_arg,
                 uchar null_bit_arg, utype unireg_check_arg,
@@ -3649,7 +3655,7 @@ class Field_varstring_compressed: public Field_varstring {
   void sql_type(String &str) const
   {
     Field_varstring::sql_type(str);
-    str.append(STRING_WITH_LEN(" /*!100301 COMPRESSED*/"));
+    sql_type_compressed(str, compression_method_ptr);
   }
   uint32 max_display_length() const { return field_length - 1; }
   uint32 character_octet_length() const { return field_length - 1; }
@@ -3986,7 +3992,7 @@ class Field_blob_compressed: public Field_blob {
   void sql_type(String &str) const
   {
     Field_blob::sql_type(str);
-    str.append(STRING_WITH_LEN(" /*!100301 COMPRESSED*/"));
+    sql_type_compressed(str, compression_method_ptr);
   }
 
   /*
@@ -4970,6 +4976,7 @@ class Copy_field :public Sql_alloc {
   void (*do_copy2)(Copy_field *);		// Used to handle null values
 };
 
+Copy_field *coalesce_copy_fields(Copy_field *copy, Copy_field *copy_end);
 
 uint pack_length_to_packflag(uint type);
 enum_field_types get_blob_type_from_length(ulong length);
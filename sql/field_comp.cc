@@ -19,6 +19,9 @@
 #include "sql_class.h"
 #include "field_comp.h"
 #include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
 
 
 /**
@@ -129,6 +132,99 @@ static int uncompress_zlib(String *to, const uchar *from, uint from_length,
 }
 
 
+#ifdef HAVE_ZSTD
+/**
+  Compresses string using zstd
+
+  Same contract as compress_zlib(). Header bits 1-3 store the number of
+  bytes occupied by the original data length, bit 4 is unused.
+*/
+
+static uint compress_zstd(THD *thd, char *to, const char *from, uint length)
+{
+  uint level= thd->variables.column_compression_zstd_level;
+
+  /* Caller takes care of empty strings. */
+  DBUG_ASSERT(length);
+
+  if (level > 0 && length > 1)
+  {
+    uchar original_pack_length= number_storage_requirement(length);
+    size_t res;
+
+    *to= 0x90 + original_pack_length;
+    store_bigendian(length, (uchar*) to + 1, original_pack_length);
+
+    DBUG_ASSERT(length >= static_cast<uint>(original_pack_length) + 1);
+    res= ZSTD_compress(to + original_pack_length + 1,
+                       length - original_pack_length - 1,
+                       from, length, (int) level);
+    if (!ZSTD_isError(res))
+      return (uint) res + original_pack_length + 1;
+  }
+  return 0;
+}
+
+
+static int uncompress_zstd(String *to, const uchar *from, uint from_length,
+                           uint field_length)
+{
+  uchar original_pack_length= *from & 0x07;
+  ulonglong original_length;
+  size_t res;
+
+  from++;
+  from_length--;
+
+  if (from_length < original_pack_length)
+  {
+    my_error(ER_ZLIB_Z_DATA_ERROR, MYF(0));
+    return 1;
+  }
+
+  original_length= (ulonglong) read_bigendian(from, original_pack_length);
+
+  if (original_length > field_length)
+  {
+    my_error(ER_ZLIB_Z_DATA_ERROR, MYF(0));
+    return 1;
+  }
+
+  if (to->alloc((size_t) original_length))
+    return 1;
+
+  res= ZSTD_decompress((char*) to->ptr(), (size_t) original_length,
+                       from + original_pack_length,
+                       from_length - original_pack_length);
+  if (ZSTD_isError(res) || res != original_length)
+  {
+    my_error(ER_ZLIB_Z_DATA_ERROR, MYF(0));
+    return 1;
+  }
+  to->length((uint32) res);
+  return 0;
+}
+#endif
+
+
+/**
+  Find a compression method by name
+
+  @return 0 if there is no such method, or the server is built without it
+*/
+
+Compression_method *find_compression_method(const char *name)
+{
+  for (uint i= 0; i < MAX_COMPRESSION_METHODS; i++)
+  {
+    if (compression_methods[i].name &&
+        !strcmp(compression_methods[i].name, name))
+      return &compression_methods[i];
+  }
+  return 0;
+}
+
+
 Compression_method compression_methods[MAX_COMPRESSION_METHODS]=
 {
   { 0, 0, 0 },
@@ -140,7 +236,11 @@ Compression_method compression_methods[MAX_COMPRESSION_METHODS]=
   { 0, 0, 0 },
   { 0, 0, 0 },
   { "zlib", compress_zlib, uncompress_zlib },
+#ifdef HAVE_ZSTD
+  { "zstd", compress_zstd, uncompress_zstd },
+#else
   { 0, 0, 0 },
+#endif
   { 0, 0, 0 },
   { 0, 0, 0 },
   { 0, 0, 0 },
@@ -29,5 +29,8 @@ struct Compression_method
 
 extern Compression_method compression_methods[MAX_COMPRESSION_METHODS];
 #define zlib_compression_method (&compression_methods[8])
+#define zstd_compression_method (&compression_methods[9])
+
+Compression_method *find_compression_method(const char *name);
 
 #endif
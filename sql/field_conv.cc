@@ -643,6 +643,78 @@ void Copy_field::set(uchar *to,Field *from)
 }
 
 
+/**
+  Return the number of bytes a copy function copies with memcpy(),
+  or 0 if it does more than a plain memcpy().
+*/
+
+static uint memcpy_copy_length(const Copy_field *copy)
+{
+  if (copy->do_copy == do_field_eq)
+    return copy->from_length;
+  if (copy->do_copy == do_field_1)
+    return 1;
+  if (copy->do_copy == do_field_2)
+    return 2;
+  if (copy->do_copy == do_field_3)
+    return 3;
+  if (copy->do_copy == do_field_4)
+    return 4;
+  if (copy->do_copy == do_field_6)
+    return 6;
+  if (copy->do_copy == do_field_8)
+    return 8;
+  return 0;
+}
+
+
+/**
+  Merge the copies of adjacent fields that are plain memcpy() into one
+  memcpy().
+
+  This is the common case when copying between records of identical
+  layout, like in ALTER TABLE that doesn't change the columns, or when
+  filling a temporary table with NOT NULL columns. The merged copies
+  are removed from the array, so the entries must have been set with
+  Copy_field::set(Field*, Field*, bool), and the caller must not use
+  Copy_field::from_field or Copy_field::to_field of the result.
+
+  @param copy       first copy
+  @param copy_end   end of the copies
+
+  @return new end of the copies
+*/
+
+Copy_field *coalesce_copy_fields(Copy_field *copy, Copy_field *copy_end)
+{
+  Copy_field *to= copy;
+  for (Copy_field *from= copy; from != copy_end; from++)
+  {
+    uint length= memcpy_copy_length(from);
+    if (to != copy && length && length == from->from_length &&
+        length == from->to_length)
+    {
+      Copy_field *last= to - 1;
+      uint last_length= memcpy_copy_length(last);
+      if (last_length && last_length == last->from_length &&
+          last_length == last->to_length &&
+          last->from_ptr + last_length == from->from_ptr &&
+          last->to_ptr + last_length == from->to_ptr)
+      {
+        last->from_length+= length;
+        last->to_length+= length;
+        last->do_copy= last->do_copy2= do_field_eq;
+        continue;
+      }
+    }
+    if (to != from)
+      *to= *from;
+    to++;
+  }
+  return to;
+}
+
+
 /*
   To do: 
 
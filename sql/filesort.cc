@@ -187,6 +187,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
   param.init_for_filesort(sortlength(thd, filesort->sortorder, s_length,
                                      &multi_byte_charset),
                           table, max_rows, filesort->sort_positions);
+  param.sort_threads= thd->variables.sort_threads;
 
   sort->addon_buf=    param.addon_buf;
   sort->addon_field=  param.addon_field;
@@ -299,6 +300,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
     sort->buffpek.length= maxbuffer;
     buffpek= (BUFFPEK *) sort->buffpek.str;
     close_cached_file(&buffpek_pointers);
+    tracker->report_spilled_bytes(my_b_tell(&tempfile));
 	/* Open cached file if it isn't open */
     if (! my_b_inited(outfile) &&
 	open_cached_file(outfile,mysql_tmpdir,TEMP_PREFIX,READ_RECORD_BUFFER,
@@ -18,6 +18,7 @@
 #include "sql_const.h"
 #include "sql_sort.h"
 #include "table.h"
+#include <algorithm>
 
 
 namespace {
@@ -157,6 +158,100 @@ void Filesort_buffer::free_sort_buffer()
 }
 
 
+/**
+  Sort an array of pointers to keys.
+
+  @param keys    the keys to sort
+  @param count   number of keys
+  @param size    length of the keys
+  @param buffer  scratch space for count pointers, or NULL
+*/
+static void sort_keys(uchar **keys, uint count, size_t size, uchar **buffer)
+{
+  if (buffer && msd_radixsort_is_applicable(count))
+    msd_radixsort_for_str_ptr(keys, count, size, buffer);
+  else
+    my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(size), &size);
+}
+
+
+/** Minimum number of keys per thread for sorting in parallel */
+static const uint MIN_KEYS_PER_SORT_THREAD= 16384;
+
+/**
+  A step of sorting the sort buffer in parallel: sorting a chunk of
+  the keys, or merging two adjacent sorted chunks.
+*/
+struct Sort_task
+{
+  /** the keys to sort, or the two adjacent runs to merge */
+  uchar **keys;
+  /** number of keys */
+  uint count;
+  /** number of keys in the first run, or 0 to sort the keys */
+  uint mid;
+  /** scratch space for sorting, or the target of the merge */
+  uchar **buffer;
+  /** length of the keys */
+  size_t size;
+  /** the thread that executes the task */
+  pthread_t thread;
+
+  void run()
+  {
+    if (!mid)
+    {
+      sort_keys(keys, count, size, buffer);
+      return;
+    }
+
+    qsort2_cmp cmp= get_ptr_compare(size);
+    uchar **a= keys, **a_end= keys + mid;
+    uchar **b= a_end, **b_end= keys + count;
+    uchar **to= buffer;
+
+    while (a != a_end && b != b_end)
+      *to++= cmp(&size, b, a) < 0 ? *b++ : *a++;
+    memcpy(to, a, (a_end - a) * sizeof *a);
+    to+= a_end - a;
+    memcpy(to, b, (b_end - b) * sizeof *b);
+  }
+};
+
+
+extern "C" void *sort_task_thread(void *arg)
+{
+  my_thread_init();
+  static_cast<Sort_task*>(arg)->run();
+  my_thread_end();
+  return NULL;
+}
+
+
+/**
+  Execute sort tasks concurrently. The first task is executed by the
+  calling thread, and so are the tasks for which no thread could be
+  created.
+*/
+static void run_sort_tasks(Sort_task *tasks, uint n)
+{
+  bool started[MAX_SORT_THREADS];
+
+  for (uint i= 1; i < n; i++)
+    started[i]= !mysql_thread_create(0, /* Not instrumented */
+                                     &tasks[i].thread, NULL,
+                                     sort_task_thread, &tasks[i]);
+  tasks[0].run();
+  for (uint i= 1; i < n; i++)
+  {
+    if (started[i])
+      pthread_join(tasks[i].thread, NULL);
+    else
+      tasks[i].run();
+  }
+}
+
+
 void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
 {
   size_t size= param->sort_length;
@@ -164,14 +259,64 @@ void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
     return;
   uchar **keys= get_sort_keys();
   uchar **buffer= NULL;
-  if (radixsort_is_appliccable(count, param->sort_length) &&
-      (buffer= (uchar**) my_malloc(count*sizeof(char*),
-                                   MYF(MY_THREAD_SPECIFIC))))
+  uint n_chunks= MY_MIN(param->sort_threads, count / MIN_KEYS_PER_SORT_THREAD);
+
+  if (n_chunks > 1 || msd_radixsort_is_applicable(count))
+    buffer= (uchar**) my_malloc(count*sizeof(char*), MYF(MY_THREAD_SPECIFIC));
+
+  if (n_chunks <= 1 || !buffer)
   {
-    radixsort_for_str_ptr(keys, count, param->sort_length, buffer);
+    sort_keys(keys, count, size, buffer);
     my_free(buffer);
     return;
   }
-  
-  my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(size), &size);
+
+  /*
+    Sort n_chunks parts of the keys concurrently, and then merge
+    adjacent runs in pairs, also concurrently, until one run remains.
+  */
+  DBUG_ASSERT(n_chunks <= MAX_SORT_THREADS);
+  Sort_task tasks[MAX_SORT_THREADS];
+  uint bounds[MAX_SORT_THREADS + 1];
+
+  for (uint i= 0; i <= n_chunks; i++)
+    bounds[i]= uint(ulonglong(count) * i / n_chunks);
+
+  for (uint i= 0; i < n_chunks; i++)
+  {
+    tasks[i].keys= keys + bounds[i];
+    tasks[i].count= bounds[i + 1] - bounds[i];
+    tasks[i].mid= 0;
+    tasks[i].buffer= buffer + bounds[i];
+    tasks[i].size= size;
+  }
+  run_sort_tasks(tasks, n_chunks);
+
+  uchar **from= keys, **to= buffer;
+  for (uint n_runs= n_chunks; n_runs > 1; n_runs= (n_runs + 1) / 2)
+  {
+    uint n_tasks= 0;
+    for (uint i= 0; i + 1 < n_runs; i+= 2)
+    {
+      Sort_task *task= &tasks[n_tasks++];
+      task->keys= from + bounds[i];
+      task->count= bounds[i + 2] - bounds[i];
+      task->mid= bounds[i + 1] - bounds[i];
+      task->buffer= to + bounds[i];
+      task->size= size;
+    }
+    if (n_runs & 1)
+      memcpy(to + bounds[n_runs - 1], from + bounds[n_runs - 1],
+             (bounds[n_runs] - bounds[n_runs - 1]) * sizeof *keys);
+    run_sort_tasks(tasks, n_tasks);
+
+    for (uint i= 0; 2 * i < n_runs; i++)
+      bounds[i]= bounds[2 * i];
+    bounds[(n_runs + 1) / 2]= count;
+    std::swap(from, to);
+  }
+
+  if (from != keys)
+    memcpy(keys, from, count * sizeof *keys);
+  my_free(buffer);
 }
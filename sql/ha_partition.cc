@@ -77,7 +77,8 @@
                                         HA_DUPLICATE_POS | \
                                         HA_CAN_INSERT_DELAYED | \
                                         HA_READ_BEFORE_WRITE_REMOVAL |\
-                                        HA_CAN_TABLES_WITHOUT_ROLLBACK)
+                                        HA_CAN_TABLES_WITHOUT_ROLLBACK |\
+                                        HA_DO_RANGE_FILTER_PUSHDOWN)
 
 static const char *ha_par_ext= ".par";
 
@@ -378,6 +379,7 @@ void ha_partition::init_handler_variables()
 
   m_pre_calling= FALSE;
   m_pre_call_use_parallel= FALSE;
+  m_deferred_lock_type= F_UNLCK;
 
   ft_first= ft_current=  NULL;
   bulk_access_executing= FALSE;                 // For future
@@ -3907,6 +3909,20 @@ int ha_partition::external_lock(THD *thd, int lock_type)
 
   DBUG_ASSERT(!auto_increment_lock && !auto_increment_safe_stmt_log_lock);
 
+  m_deferred_lock_type= F_UNLCK;
+  if (lock_type == F_RDLCK && thd->variables.partition_defer_locking &&
+      thd->lex->sql_command == SQLCOM_SELECT && !thd->locked_tables_mode)
+  {
+    /*
+      Partition pruning is done after the tables are locked. Lock only the
+      partitions that are read, when the scan starts.
+    */
+    DBUG_PRINT("info", ("deferring the lock of the partitions"));
+    m_deferred_lock_type= lock_type;
+    bitmap_union(&m_partitions_to_reset, &m_part_info->lock_partitions);
+    DBUG_RETURN(0);
+  }
+
   if (lock_type == F_UNLCK)
     used_partitions= &m_locked_partitions;
   else
@@ -3969,6 +3985,45 @@ int ha_partition::external_lock(THD *thd, int lock_type)
 }
 
 
+/**
+  Lock the partitions to read that are not locked yet, if external_lock()
+  was deferred.
+
+  Must be called before the partitions in read_partitions are used for
+  reading. The partitions are unlocked by external_lock(F_UNLCK).
+
+  @return Operation status
+    @retval 0     Success
+    @retval != 0  Error code
+*/
+
+int ha_partition::lock_read_partitions()
+{
+  uint i;
+  int error;
+  THD *thd= ha_thd();
+  DBUG_ENTER("ha_partition::lock_read_partitions");
+
+  if (m_deferred_lock_type == F_UNLCK)
+    DBUG_RETURN(0);
+
+  for (i= bitmap_get_first_set(&m_part_info->read_partitions);
+       i < m_tot_parts;
+       i= bitmap_get_next_set(&m_part_info->read_partitions, i))
+  {
+    if (bitmap_is_set(&m_locked_partitions, i))
+      continue;
+    DBUG_PRINT("info", ("external_lock(thd, %d) part %u",
+                        m_deferred_lock_type, i));
+    if (unlikely((error= m_file[i]->ha_external_lock(thd,
+                                                     m_deferred_lock_type))))
+      DBUG_RETURN(error);
+    bitmap_set_bit(&m_locked_partitions, i);
+  }
+  DBUG_RETURN(0);
+}
+
+
 /*
   Get the lock(s) for the table and perform conversion of locks if needed
 
@@ -4919,6 +4974,9 @@ int ha_partition::rnd_init(bool scan)
     goto err1;
   }
 
+  if (unlikely((error= lock_read_partitions())))
+    goto err1;
+
   /*
     We have a partition and we are scanning with rnd_next
     so we bump our cache
@@ -5361,6 +5419,9 @@ int ha_partition::index_init(uint inx, bool sorted)
     m_using_extended_keys= FALSE;
   }
 
+  if (unlikely((error= lock_read_partitions())))
+    DBUG_RETURN(error);
+
   if (init_record_priority_queue())
     DBUG_RETURN(HA_ERR_OUT_OF_MEM);
 
@@ -5759,6 +5820,10 @@ int ha_partition::index_read_idx_map(uchar *buf, uint index,
 
     get_partition_set(table, buf, index, &m_start_key, &m_part_spec);
 
+    if (unlikely((error= lock_read_partitions())))
+      DBUG_RETURN(error);
+    error= HA_ERR_KEY_NOT_FOUND;
+
     /*
       We have either found exactly 1 partition
       (in which case start_part == end_part)
@@ -6269,6 +6334,9 @@ ha_rows ha_partition::multi_range_read_info_const(uint keyno,
   DBUG_ENTER("ha_partition::multi_range_read_info_const");
   DBUG_PRINT("enter", ("partition this: %p", this));
 
+  if (unlikely(lock_read_partitions()))
+    DBUG_RETURN(HA_POS_ERROR);
+
   m_mrr_new_full_buffer_size= 0;
   save_part_spec= m_part_spec;
 
@@ -6664,6 +6732,9 @@ int ha_partition::ft_init()
     goto err1;
   }
 
+  if (unlikely((error= lock_read_partitions())))
+    goto err1;
+
   DBUG_PRINT("info", ("ft_init on partition %u", (uint) part_id));
   /*
     ft_end() is needed for partitioning to reset internal data if scan
@@ -7168,6 +7239,22 @@ bool ha_partition::check_parallel_search()
   }
   DBUG_PRINT("info",("partition is not skip_order"));
 
+  /*
+    LIMIT without ORDER BY and GROUP BY may be satisfied from the first
+    partition, unless the user told us that the table has so many partitions
+    that it is worth to scan them all at once.
+  */
+  {
+    ulong min_parts= ha_thd()->variables.partition_parallel_scan_min_partitions;
+    if (min_parts &&
+        bitmap_bits_set(&m_part_info->read_partitions) >= min_parts)
+    {
+      DBUG_PRINT("info",("partition reading %u partitions",
+                         bitmap_bits_set(&m_part_info->read_partitions)));
+      goto parallel;
+    }
+  }
+
 not_parallel:
   DBUG_PRINT("return",("partition FALSE"));
   DBUG_RETURN(FALSE);
@@ -9361,6 +9448,9 @@ ha_rows ha_partition::records_in_range(uint inx, key_range *min_key,
   uint partition_index= 0, part_id;
   DBUG_ENTER("ha_partition::records_in_range");
 
+  if (unlikely(lock_read_partitions()))
+    DBUG_RETURN(HA_POS_ERROR);
+
   min_rows_to_check= min_rows_for_estimate();
 
   while ((part_id= get_biggest_used_partition(&partition_index))
@@ -9474,6 +9564,9 @@ ha_rows ha_partition::records()
   uint i;
   DBUG_ENTER("ha_partition::records");
 
+  if (unlikely(lock_read_partitions()))
+    DBUG_RETURN(HA_POS_ERROR);
+
   for (i= bitmap_get_first_set(&m_part_info->read_partitions);
        i < m_tot_parts;
        i= bitmap_get_next_set(&m_part_info->read_partitions, i))
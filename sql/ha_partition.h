@@ -369,6 +369,11 @@ class ha_partition :public handler
 
   /** keep track of locked partitions */
   MY_BITMAP m_locked_partitions;
+  /**
+    Lock type of an external_lock() that was deferred until the partitions
+    to read are known, F_UNLCK if none. See lock_read_partitions().
+  */
+  int m_deferred_lock_type;
   /** Stores shared auto_increment etc. */
   Partition_share *part_share;
   /** Temporary storage for new partitions Handler_shares during ALTER */
@@ -819,6 +824,7 @@ class ha_partition :public handler
   int partition_scan_set_up(uchar * buf, bool idx_read_flag);
   bool check_parallel_search();
   int handle_pre_scan(bool reverse_order, bool use_parallel);
+  int lock_read_partitions();
   int handle_unordered_next(uchar * buf, bool next_same);
   int handle_unordered_scan_next_partition(uchar * buf);
   int handle_ordered_index_scan(uchar * buf, bool reverse_order);
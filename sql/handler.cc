@@ -43,6 +43,7 @@
 #include "debug_sync.h"         // DEBUG_SYNC
 #include "sql_audit.h"
 #include "ha_sequence.h"
+#include "rowid_filter.h"
 
 #ifdef WITH_PARTITION_STORAGE_ENGINE
 #include "ha_partition.h"
@@ -4791,17 +4792,20 @@ void handler::get_dynamic_partition_info(PARTITION_STATS *stat_info,
 
 
 /*
-  Updates the global table stats with the TABLE this handler represents
+  Updates the table stats of the thread with the TABLE this handler
+  represents. They are merged into the global table stats by
+  merge_table_index_stats().
 */
 
 void handler::update_global_table_stats()
 {
   TABLE_STATS * table_stats;
+  THD *thd= table->in_use;
 
-  status_var_add(table->in_use->status_var.rows_read, rows_read);
+  status_var_add(thd->status_var.rows_read, rows_read);
   DBUG_ASSERT(rows_tmp_read == 0);
 
-  if (!table->in_use->userstat_running)
+  if (!thd->userstat_running)
   {
     rows_read= rows_changed= 0;
     return;
@@ -4813,54 +4817,34 @@ void handler::update_global_table_stats()
   DBUG_ASSERT(table->s);
   DBUG_ASSERT(table->s->table_cache_key.str);
 
-  mysql_mutex_lock(&LOCK_global_table_stats);
-  /* Gets the global table stats, creating one if necessary. */
-  if (!(table_stats= (TABLE_STATS*)
-        my_hash_search(&global_table_stats,
-                    (uchar*) table->s->table_cache_key.str,
-                    table->s->table_cache_key.length)))
-  {
-    if (!(table_stats = ((TABLE_STATS*)
-                         my_malloc(sizeof(TABLE_STATS),
-                                   MYF(MY_WME | MY_ZEROFILL)))))
-    {
-      /* Out of memory error already given */
-      goto end;
-    }
-    memcpy(table_stats->table, table->s->table_cache_key.str,
-           table->s->table_cache_key.length);
-    table_stats->table_name_length= (uint)table->s->table_cache_key.length;
+  /* Gets the table stats of the thread, creating one if necessary. */
+  if ((table_stats= get_pending_table_stats(thd,
+                                            table->s->table_cache_key.str,
+                                            table->s->table_cache_key.length)))
+  {
     table_stats->engine_type= ht->db_type;
-    /* No need to set variables to 0, as we use MY_ZEROFILL above */
-
-    if (my_hash_insert(&global_table_stats, (uchar*) table_stats))
-    {
-      /* Out of memory error is already given */
-      my_free(table_stats);
-      goto end;
-    }
+    table_stats->rows_read+=    rows_read;
+    table_stats->rows_changed+= rows_changed;
+    table_stats->rows_changed_x_indexes+= (rows_changed *
+                                           (table->s->keys ? table->s->keys :
+                                            1));
+    thd->table_index_stats_pending= true;
   }
-  // Updates the global table stats.
-  table_stats->rows_read+=    rows_read;
-  table_stats->rows_changed+= rows_changed;
-  table_stats->rows_changed_x_indexes+= (rows_changed *
-                                         (table->s->keys ? table->s->keys :
-                                          1));
   rows_read= rows_changed= 0;
-end:
-  mysql_mutex_unlock(&LOCK_global_table_stats);
 }
 
 
 /*
-  Updates the global index stats with this handler's accumulated index reads.
+  Updates the index stats of the thread with this handler's accumulated
+  index reads.
 */
 
 void handler::update_global_index_stats()
 {
+  THD *thd= table->in_use;
   DBUG_ASSERT(table->s);
 
-  if (!table->in_use->userstat_running)
+  if (!thd->userstat_running)
   {
     /* Reset all index read values */
     bzero(index_rows_read, sizeof(index_rows_read[0]) * table->s->keys);
@@ -4879,30 +4863,16 @@ void handler::update_global_index_stats()
       if (!key_info->cache_name)
         continue;
       key_length= table->s->table_cache_key.length + key_info->name.length + 1;
-      mysql_mutex_lock(&LOCK_global_index_stats);
-      // Gets the global index stats, creating one if necessary.
-      if (!(index_stats= (INDEX_STATS*) my_hash_search(&global_index_stats,
-                                                    key_info->cache_name,
-                                                    key_length)))
+      // Gets the index stats of the thread, creating one if necessary.
+      if ((index_stats= get_pending_index_stats(thd,
+                                                (const char*)
+                                                key_info->cache_name,
+                                                key_length)))
       {
-        if (!(index_stats = ((INDEX_STATS*)
-                             my_malloc(sizeof(INDEX_STATS),
-                                       MYF(MY_WME | MY_ZEROFILL)))))
-          goto end;                             // Error is already given
-
-        memcpy(index_stats->index, key_info->cache_name, key_length);
-        index_stats->index_name_length= key_length;
-        if (my_hash_insert(&global_index_stats, (uchar*) index_stats))
-        {
-          my_free(index_stats);
-          goto end;
-        }
+        index_stats->rows_read+= index_rows_read[index];
+        thd->table_index_stats_pending= true;
       }
-      /* Updates the global index stats. */
-      index_stats->rows_read+= index_rows_read[index];
       index_rows_read[index]= 0;
-end:
-      mysql_mutex_unlock(&LOCK_global_index_stats);
     }
   }
 }
@@ -5732,6 +5702,9 @@ int handler::compare_key2(key_range *range) const
 
 /**
   ICP callback - to be called by an engine to check the pushed condition
+
+  The pushed rowid filter, if any, is checked here as well. An engine may
+  call this only for the sake of the filter, with no index condition pushed.
 */
 extern "C" enum icp_result handler_index_cond_check(void* h_arg)
 {
@@ -5746,11 +5719,21 @@ extern "C" enum icp_result handler_index_cond_check(void* h_arg)
 
   if (h->end_range && h->compare_key2(h->end_range) > 0)
     return ICP_OUT_OF_RANGE;
-  h->increment_statistics(&SSV::ha_icp_attempts);
-  if ((res= h->pushed_idx_cond->val_int()? ICP_MATCH : ICP_NO_MATCH) ==
-      ICP_MATCH)
+  if (h->pushed_idx_cond)
+  {
+    h->increment_statistics(&SSV::ha_icp_attempts);
+    if ((res= h->pushed_idx_cond->val_int()? ICP_MATCH : ICP_NO_MATCH) !=
+        ICP_MATCH)
+      return res;
     h->increment_statistics(&SSV::ha_icp_match);
-  return res;
+  }
+  if (h->pushed_rowid_filter)
+  {
+    h->position(h->table->record[0]);
+    if (!h->pushed_rowid_filter->check(h->ref))
+      return ICP_NO_MATCH;
+  }
+  return ICP_MATCH;
 }
 
 int handler::index_read_idx_map(uchar * buf, uint index, const uchar * key,
@@ -6216,6 +6199,7 @@ int handler::ha_reset()
     check_table_binlog_row_based_result= 0;
   /* Reset information about pushed engine conditions */
   cancel_pushed_idx_cond();
+  cancel_pushed_rowid_filter();
   /* Reset information about pushed index conditions */
   clear_top_table_fields();
   DBUG_RETURN(reset());
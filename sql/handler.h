@@ -46,6 +46,7 @@
 
 class Alter_info;
 class Virtual_column_info;
+class Range_rowid_filter;
 class sequence_definition;
 
 // the following is for checking tables
@@ -316,6 +317,19 @@ enum enum_alter_inplace_result {
 */
 #define HA_SLOW_RND_POS  (1ULL << 55)
 
+/*
+  The engine can check a rowid filter pushed with handler::rowid_filter_push()
+  while scanning a secondary index, before it fetches the full row.
+*/
+#define HA_DO_RANGE_FILTER_PUSHDOWN  (1ULL << 56)
+
+/*
+  index_next() from a positioned cursor is much cheaper than a new
+  index_read_map(). DS-MRR then reads forward from the match of the previous
+  key to look up the next one of the sorted keys.
+*/
+#define HA_FAST_INDEX_NEXT  (1ULL << 57)
+
 /* bits in index_flags(index_number) for what you can do with index */
 #define HA_READ_NEXT            1       /* TODO really use this flag */
 #define HA_READ_PREV            2       /* supports ::index_prev */
@@ -2968,6 +2982,9 @@ class handler :public Sql_alloc
   Item *pushed_idx_cond;
   uint pushed_idx_cond_keyno;  /* The index which the above condition is for */
 
+  /* Rowid filter checked together with the pushed index condition */
+  Range_rowid_filter *pushed_rowid_filter;
+
   Discrete_interval auto_inc_interval_for_cur_row;
   /**
      Number of reserved auto-increment intervals. Serves as a heuristic
@@ -3032,6 +3049,7 @@ class handler :public Sql_alloc
     tracker(NULL),
     pushed_idx_cond(NULL),
     pushed_idx_cond_keyno(MAX_KEY),
+    pushed_rowid_filter(NULL),
     auto_inc_intervals_count(0),
     m_psi(NULL), set_top_table_fields(FALSE), top_table(0),
     top_table_field(0), top_table_fields(0),
@@ -4056,6 +4074,26 @@ class handler :public Sql_alloc
    in_range_check_pushed_down= false;
  }
 
+ /**
+   Push down a rowid filter to the handler.
+
+   The handler should check the filter for every tuple of a secondary
+   index it reads, after the pushed index condition (if any) and before
+   it fetches the full row. Tuples whose rowid is not in the filter are
+   skipped. Only handlers with HA_DO_RANGE_FILTER_PUSHDOWN take a filter.
+
+   @param filter  the filter to be checked by the handler
+
+   @return FALSE if the handler will check the filter
+ */
+ virtual bool rowid_filter_push(Range_rowid_filter *filter) { return TRUE; }
+
+ /** Reset information about the pushed rowid filter */
+ virtual void cancel_pushed_rowid_filter()
+ {
+   pushed_rowid_filter= NULL;
+ }
+
  /* Needed for partition / spider */
   virtual TABLE_LIST *get_next_global_for_child() { return NULL; }
 
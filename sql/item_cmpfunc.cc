@@ -29,6 +29,7 @@
 #include "mariadb.h"
 #include "sql_priv.h"
 #include <m_ctype.h>
+#include <my_bit.h>
 #include "sql_select.h"
 #include "sql_parse.h"                          // check_stack_overrun
 #include "sql_time.h"                  // make_truncated_value_warning
@@ -3503,6 +3504,18 @@ bool in_vector::find(Item *item)
   if (!result || !used_count)
     return false;				// Null value
 
+  if (hash_slots)
+  {
+    for (uint slot= hash_value(result) & hash_mask; hash_slots[slot];
+         slot= (slot + 1) & hash_mask)
+    {
+      if ((*compare)(collation, base + (hash_slots[slot] - 1) * size,
+                     result) == 0)
+        return true;
+    }
+    return false;
+  }
+
   uint start,end;
   start=0; end=used_count-1;
   while (start != end)
@@ -3519,6 +3532,41 @@ bool in_vector::find(Item *item)
   return ((*compare)(collation, base+start*size, result) == 0);
 }
 
+
+/**
+  Build a hash index over the sorted array.
+
+  For long lists a hash lookup is cheaper than bisection, which does
+  log2(used_count) comparisons per row. The table is sized to keep the
+  load factor at or below 1/2. If the memory can't be allocated, find()
+  silently keeps using bisection.
+*/
+
+void in_vector::create_hash_index(THD *thd)
+{
+  hash_slots= NULL;
+  if (!has_hash_value() || used_count < IN_VECTOR_HASH_THRESHOLD)
+    return;
+
+  uint slots= my_round_up_to_next_power(used_count) * 2;
+  uint *table= (uint*) thd_calloc(thd, slots * sizeof(uint));
+  if (!table)
+    return;
+  hash_mask= slots - 1;
+  for (uint pos= 0; pos < used_count; pos++)
+  {
+    /* Equal elements are adjacent in the sorted array, store only one */
+    if (pos && !compare_elems(pos - 1, pos))
+      continue;
+    uint slot= hash_value((uchar*) base + pos * size) & hash_mask;
+    while (table[slot])
+      slot= (slot + 1) & hash_mask;
+    table[slot]= pos + 1;
+  }
+  hash_slots= table;
+}
+
+
 in_string::in_string(THD *thd, uint elements, qsort2_cmp cmp_func,
                      CHARSET_INFO *cs)
   :in_vector(thd, elements, sizeof(String), cmp_func, cs),
@@ -3563,6 +3611,15 @@ uchar *in_string::get_value(Item *item)
   return (uchar*) item->val_str(&tmp);
 }
 
+ulong in_string::hash_value(const uchar *value)
+{
+  const String *str= (const String*) value;
+  ulong nr1= 1, nr2= 4;
+  collation->coll->hash_sort(collation, (const uchar*) str->ptr(),
+                             str->length(), &nr1, &nr2);
+  return nr1;
+}
+
 Item *in_string::create_item(THD *thd)
 {
   return new (thd->mem_root) Item_string_for_in_vector(thd, collation);
@@ -3626,6 +3683,17 @@ uchar *in_longlong::get_value(Item *item)
   return (uchar*) &tmp;
 }
 
+ulong in_longlong::hash_value(const uchar *value)
+{
+  /*
+    Only the value is hashed: values that differ only in unsigned_flag
+    either compare equal or compare as different in cmp_longlong().
+  */
+  ulonglong nr= (ulonglong) ((const packed_longlong*) value)->val;
+  nr*= 0x9E3779B97F4A7C15ULL;
+  return (ulong) (nr ^ (nr >> 32));
+}
+
 Item *in_longlong::create_item(THD *thd)
 { 
   /* 
@@ -4189,14 +4257,15 @@ bool Item_func_in::fix_length_and_dec()
 
 
 /**
-  Populate Item_func_in::array with constant not-NULL arguments and sort them.
+  Populate Item_func_in::array with constant not-NULL arguments, sort them
+  and build a hash index for long lists.
 
   Sets "have_null" to true if some of the values appeared to be NULL.
   Note, explicit NULLs were found during prepare_predicant_and_values().
   So "have_null" can already be true before the fix_in_vector() call.
   Here we additionally catch implicit NULLs.
 */
-void Item_func_in::fix_in_vector()
+void Item_func_in::fix_in_vector(THD *thd)
 {
   DBUG_ASSERT(array);
   uint j=0;
@@ -4215,7 +4284,10 @@ void Item_func_in::fix_in_vector()
     }
   }
   if ((array->used_count= j))
+  {
     array->sort();
+    array->create_hash_index(thd);
+  }
 }
 
 
@@ -4355,7 +4427,7 @@ bool Item_func_in::fix_for_row_comparison_using_bisection(THD *thd)
   cmp_item_row *cmp= &((in_row*)array)->tmp;
   if (cmp->prepare_comparators(thd, func_name(), this, 0))
     return true;
-  fix_in_vector();
+  fix_in_vector(thd);
   return false;
 }
 
@@ -5047,20 +5119,47 @@ void Item_cond_and::mark_as_condition_AND_part(TABLE_LIST *embedding)
 */
 
 
+/*
+  The arguments that are expensive to evaluate, like subqueries and stored
+  functions, are evaluated after all the cheap ones, so that a row that
+  fails a simple comparison doesn't pay for them. The result doesn't depend
+  on the order.
+*/
+
 longlong Item_cond_and::val_int()
 {
   DBUG_ASSERT(fixed == 1);
   List_iterator_fast<Item> li(list);
   Item *item;
+  uint expensive_args= 0;
   null_value= 0;
   while ((item=li++))
   {
+    if (item->is_expensive())
+    {
+      expensive_args++;
+      continue;
+    }
     if (!item->val_bool())
     {
       if (abort_on_null || !(null_value= item->null_value))
 	return 0;				// return FALSE
     }
   }
+  if (expensive_args)
+  {
+    li.rewind();
+    while ((item=li++))
+    {
+      if (!item->is_expensive())
+        continue;
+      if (!item->val_bool())
+      {
+        if (abort_on_null || !(null_value= item->null_value))
+          return 0;                             // return FALSE
+      }
+    }
+  }
   return null_value ? 0 : 1;
 }
 
@@ -5354,6 +5453,22 @@ bool fix_escape_item(THD *thd, Item *escape_item, String *tmp_str,
   return FALSE;
 }
 
+/**
+  Check if LIKE '%pattern%' on a multi-byte collation can be done
+  with a byte search.
+
+  This is the case for the binary collations of utf8 and utf8mb4: UTF-8
+  is self-synchronizing, so a byte match of a well-formed pattern starts
+  and ends on character boundaries, and an ASCII escape or wildcard
+  character never occurs inside a multi-byte character.
+*/
+
+static bool like_mb_is_bytewise(CHARSET_INFO *cs, int escape)
+{
+  return (cs->state & MY_CS_BINSORT) && (cs->state & MY_CS_UNICODE) &&
+         cs->mbminlen == 1 && !cs->sort_order && escape < 0x80;
+}
+
 bool Item_func_like::fix_fields(THD *thd, Item **ref)
 {
   DBUG_ASSERT(fixed == 0);
@@ -5390,7 +5505,9 @@ bool Item_func_like::fix_fields(THD *thd, Item **ref)
       {
         const char* tmp = first + 1;
         for (; *tmp != wild_many && *tmp != wild_one && *tmp != escape; tmp++) ;
-        canDoTurboBM = (tmp == last) && !use_mb(args[0]->collation.collation);
+        canDoTurboBM = (tmp == last) &&
+                       (!use_mb(args[0]->collation.collation) ||
+                        like_mb_is_bytewise(cmp_collation.collation, escape));
       }
       if (canDoTurboBM)
       {
@@ -5458,6 +5575,27 @@ void Regexp_processor_pcre::set_recursion_limit(THD *thd)
 }
 
 
+/* Initial and maximal size of the JIT stack of a thread */
+#define REGEXP_JIT_STACK_START  (32*1024)
+#define REGEXP_JIT_STACK_MAX    (512*1024)
+
+/**
+  Return the JIT stack of the current thread, for pcre_exec().
+
+  The stack is allocated when the thread first matches a JIT compiled
+  pattern and freed with the THD. If the allocation fails, pcre uses
+  a small stack on the machine stack.
+*/
+static pcre_jit_stack *thd_regexp_jit_stack(void *)
+{
+  THD *thd= current_thd;
+  if (!thd->regexp_jit_stack)
+    thd->regexp_jit_stack= pcre_jit_stack_alloc(REGEXP_JIT_STACK_START,
+                                                REGEXP_JIT_STACK_MAX);
+  return thd->regexp_jit_stack;
+}
+
+
 /**
   Convert string to lib_charset, if needed.
 */
@@ -5492,22 +5630,23 @@ bool Regexp_processor_pcre::compile(String *pattern, bool send_error)
 {
   const char *pcreErrorStr;
   int pcreErrorOffset;
+  Compiled_pattern *entry;
+  pcre *code;
 
-  if (is_compiled())
+  if ((entry= find_compiled(pattern)))
   {
-    if (!stringcmp(pattern, &m_prev_pattern))
-      return false;
-    cleanup();
-    m_prev_pattern.copy(*pattern);
+    use_compiled(entry);
+    return false;
   }
 
-  if (!(pattern= convert_if_needed(pattern, &pattern_converter)))
+  String *lib_pattern;
+  if (!(lib_pattern= convert_if_needed(pattern, &pattern_converter)))
     return true;
 
-  m_pcre= pcre_compile(pattern->c_ptr_safe(), m_library_flags,
-                       &pcreErrorStr, &pcreErrorOffset, NULL);
+  code= pcre_compile(lib_pattern->c_ptr_safe(), m_library_flags,
+                     &pcreErrorStr, &pcreErrorOffset, NULL);
 
-  if (unlikely(m_pcre == NULL))
+  if (unlikely(code == NULL))
   {
     if (send_error)
     {
@@ -5517,10 +5656,84 @@ bool Regexp_processor_pcre::compile(String *pattern, bool send_error)
     }
     return true;
   }
+
+  /* Replace the least recently used pattern if the cache is full */
+  if (m_cached < REGEXP_CACHE_SIZE)
+    entry= &m_cache[m_cached++];
+  else
+  {
+    entry= &m_cache[0];
+    for (uint i= 1; i < m_cached; i++)
+      if (m_cache[i].last_used < entry->last_used)
+        entry= &m_cache[i];
+    pcre_free_study(entry->study);
+    pcre_free(entry->code);
+  }
+  entry->code= code;
+  entry->flags= m_library_flags;
+  entry->pattern.copy(*pattern);
+  /*
+    JIT compile the pattern, if pcre is built with JIT support. Otherwise
+    pcre_study() only collects data that speeds up the interpreter.
+    An error is not fatal, pcre_exec() works without the study data.
+  */
+  entry->study= pcre_study(code, PCRE_STUDY_JIT_COMPILE, &pcreErrorStr);
+  if (entry->study && (entry->study->flags & PCRE_EXTRA_EXECUTABLE_JIT))
+    pcre_assign_jit_stack(entry->study, thd_regexp_jit_stack, NULL);
+  use_compiled(entry);
   return false;
 }
 
 
+/**
+  Find an already compiled pattern.
+*/
+Regexp_processor_pcre::Compiled_pattern *
+Regexp_processor_pcre::find_compiled(const String *pattern)
+{
+  for (uint i= 0; i < m_cached; i++)
+  {
+    Compiled_pattern *entry= &m_cache[i];
+    if (entry->flags == m_library_flags &&
+        entry->pattern.charset() == pattern->charset() &&
+        !stringcmp(pattern, &entry->pattern))
+      return entry;
+  }
+  return NULL;
+}
+
+
+/**
+  Make a compiled pattern the one that exec() matches against.
+*/
+void Regexp_processor_pcre::use_compiled(Compiled_pattern *entry)
+{
+  entry->last_used= ++m_use_count;
+  m_pcre= entry->code;
+  m_pcre_extra.flags= PCRE_EXTRA_MATCH_LIMIT_RECURSION;
+  if (entry->study)
+  {
+    m_pcre_extra.flags|= entry->study->flags &
+                         (PCRE_EXTRA_STUDY_DATA | PCRE_EXTRA_EXECUTABLE_JIT);
+    m_pcre_extra.study_data= entry->study->study_data;
+    m_pcre_extra.executable_jit= entry->study->executable_jit;
+  }
+}
+
+
+void Regexp_processor_pcre::cleanup()
+{
+  for (uint i= 0; i < m_cached; i++)
+  {
+    pcre_free_study(m_cache[i].study);
+    pcre_free(m_cache[i].code);
+    m_cache[i].pattern.free();
+  }
+  m_pcre_extra.flags= PCRE_EXTRA_MATCH_LIMIT_RECURSION;
+  reset();
+}
+
+
 bool Regexp_processor_pcre::compile(Item *item, bool send_error)
 {
   char buff[MAX_FIELD_WIDTH];
@@ -1299,6 +1299,12 @@ class Item_func_nullif :public Item_func_case_expression
 
 /* A vector of values of some type  */
 
+/*
+  Lists of at least this many values get a hash index in addition to
+  the sorted array, see in_vector::create_hash_index()
+*/
+#define IN_VECTOR_HASH_THRESHOLD 64
+
 class in_vector :public Sql_alloc
 {
 public:
@@ -1308,12 +1314,19 @@ class in_vector :public Sql_alloc
   CHARSET_INFO *collation;
   uint count;
   uint used_count;
-  in_vector() {}
+  /*
+    Open addressing hash index over the sorted array. A slot holds the
+    position of an element plus one, 0 means an empty slot. NULL if
+    find() uses bisection.
+  */
+  uint *hash_slots;
+  uint hash_mask;
+  in_vector() :hash_slots(NULL), hash_mask(0) {}
   in_vector(THD *thd, uint elements, uint element_length, qsort2_cmp cmp_func,
   	    CHARSET_INFO *cmp_coll)
     :base((char*) thd_calloc(thd, elements * element_length)),
      size(element_length), compare(cmp_func), collation(cmp_coll),
-     count(elements), used_count(elements) {}
+     count(elements), used_count(elements), hash_slots(NULL), hash_mask(0) {}
   virtual ~in_vector() {}
   virtual void set(uint pos,Item *item)=0;
   virtual uchar *get_value(Item *item)=0;
@@ -1322,6 +1335,15 @@ class in_vector :public Sql_alloc
     my_qsort2(base,used_count,size,compare,(void*)collation);
   }
   bool find(Item *item);
+
+  /*
+    Hash function for values returned by get_value(). Values that compare
+    equal must have equal hash values. Vectors that can't provide such a
+    function return false from has_hash_value() and always use bisection.
+  */
+  virtual bool has_hash_value() const { return false; }
+  virtual ulong hash_value(const uchar *value) { return 0; }
+  void create_hash_index(THD *thd);
   
   /* 
     Create an instance of Item_{type} (e.g. Item_decimal) constant object
@@ -1372,6 +1394,8 @@ class in_string :public in_vector
   ~in_string();
   void set(uint pos,Item *item);
   uchar *get_value(Item *item);
+  bool has_hash_value() const { return true; }
+  ulong hash_value(const uchar *value);
   Item* create_item(THD *thd);
   void value_to_item(uint pos, Item *item)
   {    
@@ -1399,6 +1423,8 @@ class in_longlong :public in_vector
   in_longlong(THD *thd, uint elements);
   void set(uint pos,Item *item);
   uchar *get_value(Item *item);
+  bool has_hash_value() const { return true; }
+  ulong hash_value(const uchar *value);
   Item* create_item(THD *thd);
   void value_to_item(uint pos, Item *item)
   {
@@ -2345,14 +2371,14 @@ class Item_func_in :public Item_func_opt_neg,
   {
     return agg_arg_charsets_for_comparison(cmp_collation, args, arg_count);
   }
-  void fix_in_vector();
+  void fix_in_vector(THD *thd);
   bool value_list_convert_const_to_int(THD *thd);
   bool fix_for_scalar_comparison_using_bisection(THD *thd)
   {
     array= m_comparator.type_handler()->make_in_vector(thd, this, arg_count - 1);
     if (!array)      // OOM
       return true;
-    fix_in_vector();
+    fix_in_vector(thd);
     return false;
   }
   bool fix_for_scalar_comparison_using_cmp_items(THD *thd, uint found_types);
@@ -2743,6 +2769,23 @@ class Item_func_like :public Item_bool_func2
 
 class Regexp_processor_pcre
 {
+  /*
+    A compiled pattern. A non-constant pattern argument keeps the
+    REGEXP_CACHE_SIZE patterns that were used last, so that rows with
+    a few different patterns do not recompile them for every row.
+  */
+  struct Compiled_pattern
+  {
+    pcre *code;
+    pcre_extra *study;
+    String pattern;
+    int flags;
+    ulonglong last_used;
+  };
+  static const uint REGEXP_CACHE_SIZE= 8;
+  Compiled_pattern m_cache[REGEXP_CACHE_SIZE];
+  uint m_cached;
+  ulonglong m_use_count;
   pcre *m_pcre;
   pcre_extra m_pcre_extra;
   bool m_conversion_is_needed;
@@ -2750,9 +2793,10 @@ class Regexp_processor_pcre
   int m_library_flags;
   CHARSET_INFO *m_data_charset;
   CHARSET_INFO *m_library_charset;
-  String m_prev_pattern;
   int m_pcre_exec_rc;
   int m_SubStrVec[30];
+  Compiled_pattern *find_compiled(const String *pattern);
+  void use_compiled(Compiled_pattern *entry);
   void pcre_exec_warn(int rc) const;
   int pcre_exec_with_warn(const pcre *code, const pcre_extra *extra,
                           const char *subject, int length, int startoffset,
@@ -2763,6 +2807,7 @@ class Regexp_processor_pcre
   String pattern_converter;
   String replace_converter;
   Regexp_processor_pcre() :
+    m_cached(0), m_use_count(0),
     m_pcre(NULL), m_conversion_is_needed(true), m_is_const(0),
     m_library_flags(0),
     m_data_charset(&my_charset_utf8_general_ci),
@@ -2815,13 +2860,9 @@ class Regexp_processor_pcre
   void reset()
   {
     m_pcre= NULL;
-    m_prev_pattern.length(0);
-  }
-  void cleanup()
-  {
-    pcre_free(m_pcre);
-    reset();
+    m_cached= 0;
   }
+  void cleanup();
   bool is_compiled() const { return m_pcre != NULL; }
   bool is_const() const { return m_is_const; }
   void set_const(bool arg) { m_is_const= arg; }
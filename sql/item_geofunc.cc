@@ -1455,6 +1455,11 @@ longlong Item_func_spatial_precise_rel::val_int()
       null_value= g1.store_shapes(&trn) || g2.store_shapes(&trn);
       break;
     case SP_DISJOINT_FUNC:
+      if (!g1.mbr.intersects(&g2.mbr))
+      {
+        result= 1;
+        goto exit;
+      }
       func.add_operation(Gcalc_function::v_find_f |
                          Gcalc_function::op_not |
                          Gcalc_function::op_intersection, 2);
@@ -1469,6 +1474,8 @@ longlong Item_func_spatial_precise_rel::val_int()
       break;
     case SP_OVERLAPS_FUNC:
     case SP_CROSSES_FUNC:
+      if (!g1.mbr.intersects(&g2.mbr))
+        goto exit;
       func.add_operation(Gcalc_function::op_intersection, 2);
       if (func.reserve_op_buffer(3))
         break;
@@ -1493,6 +1500,8 @@ longlong Item_func_spatial_precise_rel::val_int()
       func.repeat_expression(shape_a);
       break;
     case SP_TOUCHES_FUNC:
+      if (!g1.mbr.intersects(&g2.mbr))
+        goto exit;
       if (func.reserve_op_buffer(5))
         break;
       func.add_operation(Gcalc_function::op_intersection, 2);
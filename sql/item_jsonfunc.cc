@@ -761,6 +761,24 @@ static bool path_ok(const json_path_with_flags *paths_list, int n_paths,
 }
 
 
+/*
+  Check that no value inside of the value at the path p can match any
+  of the paths, so it doesn't have to be walked through path by path.
+*/
+static bool path_mismatch_inside(const json_path_with_flags *paths_list,
+                                 int n_paths, const json_path_t *p,
+                                 json_value_types vt)
+{
+  for (; n_paths > 0; n_paths--, paths_list++)
+  {
+    if ((paths_list->p.types_used & JSON_PATH_DOUBLE_WILD) ||
+        json_path_compare(&paths_list->p, p, vt) != -1)
+      return FALSE;
+  }
+  return TRUE;
+}
+
+
 String *Item_func_json_extract::read_json(String *str,
                                           json_value_types *type,
                                           char **out_val, int *value_len)
@@ -817,7 +835,13 @@ String *Item_func_json_extract::read_json(String *str,
   while (json_get_path_next(&je, &p) == 0)
   {
     if (!path_exact(paths, arg_count-1, &p, je.value_type))
+    {
+      if (!json_value_scalar(&je) &&
+          path_mismatch_inside(paths, arg_count-1, &p, je.value_type) &&
+          json_get_path_skip_level(&je))
+        break;
       continue;
+    }
 
     value= je.value_begin;
 
@@ -778,12 +778,21 @@ class Item_sum_sum :public Item_sum_num,
   my_decimal direct_sum_decimal;
   my_decimal dec_buffs[2];
   uint curr_dec_buff;
+  /*
+    For DECIMAL arguments that fit in longlong: the sum of the values
+    scaled by 10^int_sum_scale that is not added to dec_buffs yet.
+    See add_int_sum().
+  */
+  longlong int_sum;
+  uint int_sum_scale;
+  bool use_int_sum;
   bool fix_length_and_dec();
+  void add_int_sum();
 
 public:
   Item_sum_sum(THD *thd, Item *item_par, bool distinct):
     Item_sum_num(thd, item_par), direct_added(FALSE),
-    direct_reseted_field(FALSE)
+    direct_reseted_field(FALSE), int_sum(0), use_int_sum(FALSE)
   {
     set_distinct(distinct);
   }
@@ -824,6 +833,7 @@ class Item_sum_sum :public Item_sum_num,
 
 private:
   void add_helper(bool perform_removal);
+  void add_decimal(const my_decimal *val, bool subtract);
   ulonglong count;
 };
 
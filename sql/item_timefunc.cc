@@ -1931,21 +1931,44 @@ bool Item_func_from_unixtime::get_date(THD *thd, MYSQL_TIME *ltime,
 }
 
 
+/*
+  Find the time zone of a time zone parameter. If the parameter is not
+  constant, the zone of the previous row is reused when the name is the
+  same, to not take tz_LOCK in my_tz_find() for every row.
+*/
+Time_zone *Item_func_convert_tz::find_tz(THD *thd, Item *arg,
+                                         String *last_name,
+                                         bool *last_name_set,
+                                         Time_zone *last_tz)
+{
+  String str;
+  String *name= arg->val_str_ascii(&str);
+
+  if (!name)
+    return 0;
+  if (*last_name_set && !stringcmp(name, last_name))
+    return last_tz;
+  if (arg->const_item())
+    return my_tz_find(thd, name);
+  *last_name_set= !last_name->copy(*name);
+  return my_tz_find(thd, name);
+}
+
+
 bool Item_func_convert_tz::get_date(THD *thd, MYSQL_TIME *ltime,
                                     date_mode_t fuzzydate __attribute__((unused)))
 {
   my_time_t my_time_tmp;
-  String str;
 
   if (!from_tz_cached)
   {
-    from_tz= my_tz_find(thd, args[1]->val_str_ascii(&str));
+    from_tz= find_tz(thd, args[1], &from_tz_name, &from_tz_name_set, from_tz);
     from_tz_cached= args[1]->const_item();
   }
 
   if (!to_tz_cached)
   {
-    to_tz= my_tz_find(thd, args[2]->val_str_ascii(&str));
+    to_tz= find_tz(thd, args[2], &to_tz_name, &to_tz_name_set, to_tz);
     to_tz_cached= args[2]->const_item();
   }
 
@@ -1974,6 +1997,9 @@ bool Item_func_convert_tz::get_date(THD *thd, MYSQL_TIME *ltime,
 void Item_func_convert_tz::cleanup()
 {
   from_tz_cached= to_tz_cached= 0;
+  from_tz_name_set= to_tz_name_set= 0;
+  from_tz_name.free();
+  to_tz_name.free();
   Item_datetimefunc::cleanup();
 }
 
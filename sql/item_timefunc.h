@@ -908,9 +908,18 @@ class Item_func_convert_tz :public Item_datetimefunc
   */
   bool from_tz_cached, to_tz_cached;
   Time_zone *from_tz, *to_tz;
+  /*
+    If a time zone parameter is not constant, the name that from_tz/to_tz
+    was found for, so that rows with the same zone don't call my_tz_find()
+  */
+  String from_tz_name, to_tz_name;
+  bool from_tz_name_set, to_tz_name_set;
+  Time_zone *find_tz(THD *thd, Item *arg, String *last_name,
+                     bool *last_name_set, Time_zone *last_tz);
  public:
   Item_func_convert_tz(THD *thd, Item *a, Item *b, Item *c):
-    Item_datetimefunc(thd, a, b, c), from_tz_cached(0), to_tz_cached(0) {}
+    Item_datetimefunc(thd, a, b, c), from_tz_cached(0), to_tz_cached(0),
+    from_tz_name_set(0), to_tz_name_set(0) {}
   const char *func_name() const { return "convert_tz"; }
   bool fix_length_and_dec()
   {
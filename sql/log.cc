@@ -53,6 +53,7 @@
 #include "sql_plugin.h"
 #include "debug_sync.h"
 #include "sql_show.h"
+#include "key.h"                                // key_copy, key_hashnr
 #include "my_pthread.h"
 #include "semisync_master.h"
 #include "wsrep_mysqld.h"
@@ -94,6 +95,8 @@ static const LEX_CSTRING write_error_msg=
 
 static my_bool opt_optimize_thread_scheduling= TRUE;
 ulong binlog_checksum_options;
+ulong binlog_gtid_index_span;
+ulong binlog_writeset_history_size;
 #ifndef DBUG_OFF
 ulong opt_binlog_dbug_fsync_sleep= 0;
 #endif
@@ -521,6 +524,14 @@ class binlog_cache_mngr {
                                      param_ptr_binlog_cache_use,
                                      param_ptr_binlog_cache_disk_use);
      last_commit_pos_file[0]= 0;
+     my_init_dynamic_array(&writeset, sizeof(ulonglong), 16, 16, MYF(0));
+     writeset_invalid= false;
+     writeset_table_id= ~0ULL;
+  }
+
+  ~binlog_cache_mngr()
+  {
+    delete_dynamic(&writeset);
   }
 
   void reset(bool do_stmt, bool do_trx)
@@ -534,6 +545,11 @@ class binlog_cache_mngr {
       last_commit_pos_file[0]= 0;
       last_commit_pos_offset= 0;
     }
+    if (trx_cache.empty())
+    {
+      reset_dynamic(&writeset);
+      writeset_invalid= false;
+    }
   }
 
   binlog_cache_data* get_binlog_cache_data(bool is_transactional)
@@ -575,12 +591,32 @@ class binlog_cache_mngr {
   /* Set if we get an error during commit that must be returned from unlog(). */
   bool delayed_error;
 
+  /*
+    Hashes of the unique key values of the rows changed by the transaction,
+    see binlog_writeset_add_row(). If writeset_invalid is set, they don't
+    describe all the changes.
+  */
+  DYNAMIC_ARRAY writeset;
+  bool writeset_invalid;
+  /* Table that is known to have no foreign keys */
+  ulonglong writeset_table_id;
+
 private:
 
   binlog_cache_mngr& operator=(const binlog_cache_mngr& info);
   binlog_cache_mngr(const binlog_cache_mngr& info);
 };
 
+/*
+  Element of MYSQL_BIN_LOG::writeset_history: the last transaction that
+  changed a row with a unique key value of the hash key.
+*/
+struct Binlog_writeset_entry
+{
+  ulonglong key;
+  ulonglong seq;
+};
+
 bool LOGGER::is_log_table_enabled(uint log_table_type)
 {
   switch (log_table_type) {
@@ -2605,7 +2641,8 @@ bool MYSQL_LOG::open(
 #endif
                      const char *log_name, enum_log_type log_type_arg,
                      const char *new_name, ulong next_log_number,
-                     enum cache_type io_cache_type_arg)
+                     enum cache_type io_cache_type_arg,
+                     size_t io_cache_size_arg)
 {
   char buff[FN_REFLEN];
   MY_STAT f_stat;
@@ -2617,6 +2654,7 @@ bool MYSQL_LOG::open(
   DBUG_PRINT("enter", ("log_type: %d", (int) log_type_arg));
 
   write_error= 0;
+  io_cache_size= io_cache_size_arg;
 
   if (!(name= my_strdup(log_name, MYF(MY_WME))))
   {
@@ -2661,7 +2699,8 @@ bool MYSQL_LOG::open(
   else if ((seek_offset= mysql_file_tell(file, MYF(MY_WME))))
     goto err;
 
-  if (init_io_cache(&log_file, file, IO_SIZE, io_cache_type, seek_offset, 0,
+  if (init_io_cache(&log_file, file, io_cache_size, io_cache_type,
+                    seek_offset, 0,
                     MYF(MY_WME | MY_NABP |
                         ((log_type == LOG_BIN) ? MY_WAIT_IF_FULL : 0))))
     goto err;
@@ -2706,7 +2745,7 @@ bool MYSQL_LOG::open(
 
 MYSQL_LOG::MYSQL_LOG()
   : name(0), write_error(FALSE), inited(FALSE), log_type(LOG_UNKNOWN),
-    log_state(LOG_CLOSED)
+    log_state(LOG_CLOSED), io_cache_size(IO_SIZE)
 {
   /*
     We don't want to initialize LOCK_Log here as such initialization depends on
@@ -2842,7 +2881,7 @@ void MYSQL_QUERY_LOG::reopen_file()
 #ifdef HAVE_PSI_INTERFACE
        m_log_file_key,
 #endif
-       save_name, log_type, 0, 0, io_cache_type);
+       save_name, log_type, 0, 0, io_cache_type, io_cache_size);
   my_free(save_name);
 
   mysql_mutex_unlock(&LOCK_log);
@@ -3080,6 +3119,14 @@ bool MYSQL_QUERY_LOG::write(THD *thd, time_t current_time,
           goto err;
       thd->free_items();
     }
+    if (thd->variables.log_slow_verbosity & LOG_SLOW_VERBOSITY_EXPLAIN_JSON &&
+        thd->lex->explain)
+    {
+      StringBuffer<1024> buf;
+      if (!print_explain_json_for_slow_log(thd->lex, thd, &buf))
+        if (my_b_write(&log_file, (uchar*) buf.ptr(), buf.length()))
+          goto err;
+    }
     if (thd->db.str && strcmp(thd->db.str, db))
     {						// Database changed
       if (my_b_printf(&log_file,"use %s;\n",thd->db.str))
@@ -3132,7 +3179,7 @@ bool MYSQL_QUERY_LOG::write(THD *thd, time_t current_time,
     }
     if (my_b_write(&log_file, (uchar*) sql_text, sql_text_len) ||
         my_b_write(&log_file, (uchar*) ";\n",2) ||
-        flush_io_cache(&log_file))
+        (!opt_log_slow_buffer_size && flush_io_cache(&log_file)))
       goto err;
 
     }
@@ -3152,6 +3199,90 @@ bool MYSQL_QUERY_LOG::write(THD *thd, time_t current_time,
 }
 
 
+/**
+  Write the buffered slow log entries to the file, see log_slow_buffer_size
+*/
+
+void MYSQL_QUERY_LOG::flush_buffer()
+{
+  mysql_mutex_lock(&LOCK_log);
+  if (is_open() && my_b_bytes_in_cache(&log_file) &&
+      flush_io_cache(&log_file) && !write_error)
+  {
+    write_error= 1;
+    sql_print_error(ER_DEFAULT(ER_ERROR_ON_WRITE), name, errno);
+  }
+  mysql_mutex_unlock(&LOCK_log);
+}
+
+
+/*
+  The thread that writes the buffered slow log entries to the file every
+  second, if log_slow_buffer_size is set
+*/
+
+static pthread_t slow_log_flush_thread;
+static bool slow_log_flush_thread_started, slow_log_flush_thread_stop;
+static mysql_mutex_t LOCK_slow_log_flush;
+static mysql_cond_t COND_slow_log_flush;
+
+extern "C" void *slow_log_flush_handler(void *arg __attribute__((unused)))
+{
+  my_thread_init();
+  mysql_mutex_lock(&LOCK_slow_log_flush);
+  while (!slow_log_flush_thread_stop)
+  {
+    struct timespec abstime;
+    set_timespec(abstime, 1);
+    mysql_cond_timedwait(&COND_slow_log_flush, &LOCK_slow_log_flush,
+                         &abstime);
+    mysql_mutex_unlock(&LOCK_slow_log_flush);
+    if (MYSQL_QUERY_LOG *slow_log= logger.get_slow_log_file_handler())
+      slow_log->flush_buffer();
+    mysql_mutex_lock(&LOCK_slow_log_flush);
+  }
+  mysql_mutex_unlock(&LOCK_slow_log_flush);
+  my_thread_end();
+  return NULL;
+}
+
+
+void start_slow_log_flush_thread()
+{
+  if (!opt_log_slow_buffer_size)
+    return;
+  mysql_mutex_init(0, &LOCK_slow_log_flush, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(0, &COND_slow_log_flush, 0);
+  slow_log_flush_thread_stop= false;
+  if (mysql_thread_create(0, /* Not instrumented */
+                          &slow_log_flush_thread, NULL,
+                          slow_log_flush_handler, NULL))
+  {
+    sql_print_warning("Can't create the slow log flush thread, the slow "
+                      "log is written when its buffer is full");
+    mysql_cond_destroy(&COND_slow_log_flush);
+    mysql_mutex_destroy(&LOCK_slow_log_flush);
+    return;
+  }
+  slow_log_flush_thread_started= true;
+}
+
+
+void stop_slow_log_flush_thread()
+{
+  if (!slow_log_flush_thread_started)
+    return;
+  mysql_mutex_lock(&LOCK_slow_log_flush);
+  slow_log_flush_thread_stop= true;
+  mysql_cond_signal(&COND_slow_log_flush);
+  mysql_mutex_unlock(&LOCK_slow_log_flush);
+  pthread_join(slow_log_flush_thread, NULL);
+  mysql_cond_destroy(&COND_slow_log_flush);
+  mysql_mutex_destroy(&LOCK_slow_log_flush);
+  slow_log_flush_thread_started= false;
+}
+
+
 /**
   @todo
   The following should be using fn_format();  We just need to
@@ -3218,8 +3349,14 @@ MYSQL_BIN_LOG::MYSQL_BIN_LOG(uint *sync_period)
     before main().
   */
   index_file_name[0] = 0;
+  gtid_index_log_name[0]= 0;
   bzero((char*) &index_file, sizeof(index_file));
   bzero((char*) &purge_index_file, sizeof(purge_index_file));
+  bzero((char*) &gtid_index, sizeof(gtid_index));
+  bzero((char*) &writeset_history, sizeof(writeset_history));
+  bzero((char*) &writeset_mem_root, sizeof(writeset_mem_root));
+  writeset_seq= writeset_barrier= writeset_group_start= 0;
+  writeset_group_commit_id= 0;
 }
 
 void MYSQL_BIN_LOG::stop_background_thread()
@@ -3270,10 +3407,15 @@ void MYSQL_BIN_LOG::cleanup()
       my_free(b);
     }
 
+    gtid_index_reset();
+    delete_dynamic(&gtid_index);
+    my_hash_free(&writeset_history);
+    free_root(&writeset_mem_root, MYF(0));
     mysql_mutex_destroy(&LOCK_log);
     mysql_mutex_destroy(&LOCK_index);
     mysql_mutex_destroy(&LOCK_xid_list);
     mysql_mutex_destroy(&LOCK_binlog_background_thread);
+    mysql_mutex_destroy(&LOCK_binlog_sync);
     mysql_mutex_destroy(&LOCK_binlog_end_pos);
     mysql_cond_destroy(&COND_relay_log_updated);
     mysql_cond_destroy(&COND_bin_log_updated);
@@ -3318,6 +3460,8 @@ void MYSQL_BIN_LOG::init_pthread_objects()
 
   mysql_mutex_init(key_BINLOG_LOCK_binlog_background_thread,
                    &LOCK_binlog_background_thread, MY_MUTEX_INIT_FAST);
+  mysql_mutex_init(key_BINLOG_LOCK_binlog_sync,
+                   &LOCK_binlog_sync, MY_MUTEX_INIT_FAST);
   mysql_cond_init(key_BINLOG_COND_binlog_background_thread,
                   &COND_binlog_background_thread, 0);
   mysql_cond_init(key_BINLOG_COND_binlog_background_thread_end,
@@ -3325,6 +3469,68 @@ void MYSQL_BIN_LOG::init_pthread_objects()
 
   mysql_mutex_init(m_key_LOCK_binlog_end_pos, &LOCK_binlog_end_pos,
                    MY_MUTEX_INIT_SLOW);
+  my_init_dynamic_array(&gtid_index, sizeof(Binlog_gtid_index_entry), 16, 16,
+                        MYF(0));
+  my_hash_init(&writeset_history, &my_charset_bin, 1024,
+               offsetof(Binlog_writeset_entry, key), sizeof(ulonglong),
+               0, 0, 0);
+  init_alloc_root(&writeset_mem_root, "binlog_writeset", 8192, 0, MYF(0));
+}
+
+
+/*
+  Empty the GTID index, and make it belong to the active binlog file.
+*/
+
+void MYSQL_BIN_LOG::gtid_index_reset()
+{
+  lock_binlog_end_pos();
+  for (uint i= 0; i < gtid_index.elements; i++)
+    delete dynamic_element(&gtid_index, i, Binlog_gtid_index_entry*)->glev;
+  reset_dynamic(&gtid_index);
+  if (normalize_binlog_name(gtid_index_log_name, log_file_name, false))
+    gtid_index_log_name[0]= 0;
+  unlock_binlog_end_pos();
+}
+
+
+/*
+  Add the binlog state at the event group boundary at offset of the active
+  binlog file to its GTID index, unless the previous entry is closer than
+  binlog_gtid_index_span bytes.
+
+  Called under LOCK_log, when the binlog state matches the offset and
+  binlog_end_pos is already moved to it, or will be once the file is synced
+  with binlog_sync_pipeline.
+*/
+
+void MYSQL_BIN_LOG::gtid_index_add(my_off_t offset)
+{
+  ulong span= binlog_gtid_index_span;
+  Binlog_gtid_index_entry entry;
+  my_off_t last= BIN_LOG_HEADER_SIZE;
+  mysql_mutex_assert_owner(&LOCK_log);
+
+  if (!span || is_relay_log)
+    return;
+  if (gtid_index.elements)
+    last= dynamic_element(&gtid_index, gtid_index.elements - 1,
+                          Binlog_gtid_index_entry*)->offset;
+  if (offset < last + span)
+    return;
+
+  entry.offset= offset;
+  if (!(entry.glev= new Gtid_list_log_event(&rpl_global_gtid_binlog_state, 0)))
+    return;
+  if (!entry.glev->is_valid())
+  {
+    delete entry.glev;
+    return;
+  }
+  lock_binlog_end_pos();
+  if (insert_dynamic(&gtid_index, (uchar*) &entry))
+    delete entry.glev;
+  unlock_binlog_end_pos();
 }
 
 
@@ -3617,6 +3823,7 @@ bool MYSQL_BIN_LOG::open(const char *log_name,
         Gtid_list_log_event gl_ev(&rpl_global_gtid_binlog_state, 0);
         if (write_event(&gl_ev))
           goto err;
+        gtid_index_reset();
 
         /* Output a binlog checkpoint event at the start of the binlog file. */
 
@@ -5620,6 +5827,77 @@ binlog_cache_mngr *THD::binlog_setup_trx_data()
   DBUG_RETURN(cache_mngr);
 }
 
+/*
+  Add the hashes of the unique key values of a row to the write-set of the
+  transaction, see MYSQL_BIN_LOG::writeset_commit_id().
+
+  record is a before or after image of the row, with valid values for the
+  columns in cols or cols2; NULL cols means all columns. If a changed row
+  can't be identified by its unique keys, the write-set is marked invalid.
+*/
+
+void binlog_writeset_add_row(THD *thd, TABLE *table, const uchar *record,
+                             const MY_BITMAP *cols, const MY_BITMAP *cols2)
+{
+  binlog_cache_mngr *cache_mngr=
+    (binlog_cache_mngr*) thd_get_ha_data(thd, binlog_hton);
+  uchar key[MAX_KEY_LENGTH];
+  bool invalid= false;
+  DBUG_ENTER("binlog_writeset_add_row");
+
+  if (!cache_mngr || cache_mngr->writeset_invalid)
+    DBUG_VOID_RETURN;
+  if (!binlog_writeset_history_size ||
+      table->s->primary_key >= MAX_KEY ||
+      cache_mngr->writeset.elements >= binlog_writeset_history_size)
+    goto mark_invalid;
+  if (cache_mngr->writeset_table_id != table->s->table_map_id)
+  {
+    /* The changes done by foreign key actions are not logged */
+    if (!table->file->can_switch_engines())
+      goto mark_invalid;
+    cache_mngr->writeset_table_id= table->s->table_map_id;
+  }
+
+  table->move_fields(table->field, record, table->record[0]);
+  for (uint i= 0; !invalid && i < table->s->keys; i++)
+  {
+    KEY *key_info= table->key_info + i;
+    ulong nr1, nr2= 4;
+    ulonglong hash;
+
+    if (!(key_info->flags & HA_NOSAME))
+      continue;
+    for (uint j= 0; j < key_info->user_defined_key_parts; j++)
+    {
+      Field *field= key_info->key_part[j].field;
+      if ((cols && !bitmap_is_set(cols, field->field_index) &&
+           !(cols2 && bitmap_is_set(cols2, field->field_index))) ||
+          !field->stored_in_db())
+        invalid= true;
+    }
+    if (invalid)
+      break;
+    key_copy(key, record, key_info, 0);
+    nr1= key_hashnr(key_info, key_info->user_defined_key_parts, key);
+    my_charset_bin.coll->hash_sort(&my_charset_bin,
+                                   (uchar*) table->s->table_cache_key.str,
+                                   table->s->table_cache_key.length,
+                                   &nr1, &nr2);
+    hash= nr1;
+    if (insert_dynamic(&cache_mngr->writeset, (uchar*) &hash))
+      invalid= true;
+  }
+  table->move_fields(table->field, table->record[0], record);
+  if (!invalid)
+    DBUG_VOID_RETURN;
+
+mark_invalid:
+  cache_mngr->writeset_invalid= true;
+  reset_dynamic(&cache_mngr->writeset);
+  DBUG_VOID_RETURN;
+}
+
 /*
   Function to start a statement and optionally a transaction for the
   binary log.
@@ -6352,6 +6630,9 @@ bool MYSQL_BIN_LOG::write(Log_event *event_info, my_bool *with_annotate)
 
       if (thd->lex->stmt_accessed_non_trans_temp_table())
         cache_data->set_changes_to_non_trans_temp_table();
+      /* The rows changed by a statement are not known */
+      if (event_info->get_type_code() == QUERY_EVENT)
+        cache_mngr->writeset_invalid= true;
 
       thd->binlog_start_trans_and_stmt();
     }
@@ -7799,6 +8080,8 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
   group_commit_entry *current, *last_in_queue;
   group_commit_entry *queue= NULL;
   bool check_purge= false;
+  bool write_error= false;
+  bool sync_later= false;
   ulong UNINIT_VAR(binlog_id);
   uint64 commit_id;
   DBUG_ENTER("MYSQL_BIN_LOG::trx_group_commit_leader");
@@ -7874,6 +8157,7 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
     for (current= queue; current != NULL; current= current->next)
     {
       binlog_cache_mngr *cache_mngr= current->cache_mngr;
+      uint64 trx_commit_id= commit_id;
 
       /*
         We already checked before that at least one cache is non-empty; if both
@@ -7881,9 +8165,14 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
       */
       DBUG_ASSERT(!cache_mngr->stmt_cache.empty() || !cache_mngr->trx_cache.empty());
 
+      if (binlog_writeset_history_size)
+        trx_commit_id= writeset_commit_id(current);
       if (unlikely((current->error= write_transaction_or_stmt(current,
-                                                              commit_id))))
+                                                              trx_commit_id))))
+      {
         current->commit_errno= errno;
+        write_error= true;
+      }
 
       strmake_buf(cache_mngr->last_commit_pos_file, log_file_name);
       commit_offset= my_b_write_tell(&log_file);
@@ -7909,8 +8198,17 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
       }
     }
 
+    /*
+      With binlog_sync_pipeline, the file is only flushed here and synced
+      after LOCK_log is released, so that the next group commit can write
+      while this one waits for the disk. Not if the file is to be rotated,
+      the new file must not be opened before the old one is synced.
+    */
+    sync_later= opt_binlog_sync_pipeline && get_sync_period() == 1 &&
+                my_b_write_tell(&log_file) < (my_off_t) max_size;
     bool synced= 0;
-    if (unlikely(flush_and_sync(&synced)))
+    if (unlikely(sync_later ? flush_io_cache(&log_file) :
+                              flush_and_sync(&synced)))
     {
       for (current= queue; current != NULL; current= current->next)
       {
@@ -7956,7 +8254,10 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
         semi-sync might not have put the transaction into
         it's list before dump-thread tries to send it
       */
-      update_binlog_end_pos(commit_offset);
+      if (!sync_later)
+        update_binlog_end_pos(commit_offset);
+      if (likely(!write_error))
+        gtid_index_add(commit_offset);
 
       if (unlikely(any_error))
         sql_print_error("Failed to run 'after_flush' hooks");
@@ -7996,17 +8297,67 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
     commit_offset= my_b_write_tell(&log_file);
   }
 
-  DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_after_binlog_sync");
-  mysql_mutex_lock(&LOCK_after_binlog_sync);
-  /*
-    We cannot unlock LOCK_log until we have locked LOCK_after_binlog_sync;
-    otherwise scheduling could allow the next group commit to run ahead of us,
-    messing up the order of commit_ordered() calls. But as soon as
-    LOCK_after_binlog_sync is obtained, we can let the next group commit start.
-  */
-  mysql_mutex_unlock(&LOCK_log);
+  if (sync_later)
+  {
+    /*
+      Same as for LOCK_after_binlog_sync below, LOCK_binlog_sync keeps the
+      order of the groups. close() also waits for it, so the file can not
+      be closed or rotated before it is synced.
+    */
+    mysql_mutex_lock(&LOCK_binlog_sync);
+    mysql_mutex_unlock(&LOCK_log);
+    DEBUG_SYNC(leader->thd, "commit_after_release_LOCK_log");
 
-  DEBUG_SYNC(leader->thd, "commit_after_release_LOCK_log");
+    if (unlikely(mysql_file_sync(log_file.file, MYF(MY_WME|MY_SYNC_FILESIZE))))
+    {
+      for (current= queue; current != NULL; current= current->next)
+      {
+        if (!current->error)
+        {
+          current->error= ER_ERROR_ON_WRITE;
+          current->commit_errno= errno;
+          current->error_cache= NULL;
+        }
+      }
+    }
+    else
+    {
+#ifndef DBUG_OFF
+      if (opt_binlog_dbug_fsync_sleep > 0)
+        my_sleep(opt_binlog_dbug_fsync_sleep);
+#endif
+      /*
+        A later writer may have synced the file and moved binlog_end_pos
+        past us already, while we held neither mutex.
+      */
+      lock_binlog_end_pos();
+      if (commit_offset > binlog_end_pos)
+      {
+        binlog_end_pos= commit_offset;
+        signal_bin_log_update();
+      }
+      unlock_binlog_end_pos();
+    }
+
+    DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_after_binlog_sync");
+    mysql_mutex_lock(&LOCK_after_binlog_sync);
+    mysql_mutex_unlock(&LOCK_binlog_sync);
+  }
+  else
+  {
+    DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_after_binlog_sync");
+    mysql_mutex_lock(&LOCK_after_binlog_sync);
+    /*
+      We cannot unlock LOCK_log until we have locked LOCK_after_binlog_sync;
+      otherwise scheduling could allow the next group commit to run ahead of
+      us, messing up the order of commit_ordered() calls. But as soon as
+      LOCK_after_binlog_sync is obtained, we can let the next group commit
+      start.
+    */
+    mysql_mutex_unlock(&LOCK_log);
+
+    DEBUG_SYNC(leader->thd, "commit_after_release_LOCK_log");
+  }
 
   /*
     Loop through threads and run the binlog_sync hook
@@ -8115,6 +8466,75 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
 }
 
 
+/*
+  Choose the commit id of a transaction from its write-set, instead of from
+  the group commit it is part of.
+
+  A parallel slave runs the transactions with the same commit id in
+  parallel, and starts one with a new commit id only after all before it
+  have started to commit. So a transaction keeps the commit id of the
+  previous one unless it changed a unique key value that was changed since
+  the first transaction with that commit id. A transaction without a valid
+  write-set gets a new commit id, and so does the one after it.
+
+  The last binlog_writeset_history_size unique key values are remembered,
+  when there are more the history is forgotten as if the transaction had
+  no valid write-set.
+
+  Called under LOCK_log, in binlog order.
+*/
+
+uint64 MYSQL_BIN_LOG::writeset_commit_id(group_commit_entry *entry)
+{
+  binlog_cache_mngr *mngr= entry->cache_mngr;
+  DYNAMIC_ARRAY *writeset= &mngr->writeset;
+  ulonglong seq= ++writeset_seq;
+  ulonglong last= writeset_barrier;
+  bool barrier;
+  mysql_mutex_assert_owner(&LOCK_log);
+
+  barrier= mngr->writeset_invalid || !writeset->elements ||
+           !mngr->stmt_cache.empty() ||
+           writeset_history.records + writeset->elements >
+           binlog_writeset_history_size;
+  for (uint i= 0; !barrier && i < writeset->elements; i++)
+  {
+    ulonglong key= *dynamic_element(writeset, i, ulonglong*);
+    Binlog_writeset_entry *element= (Binlog_writeset_entry*)
+      my_hash_search(&writeset_history, (uchar*) &key, sizeof(key));
+    if (element)
+    {
+      set_if_bigger(last, element->seq);
+      element->seq= seq;
+    }
+    else if (!(element= (Binlog_writeset_entry*)
+                        alloc_root(&writeset_mem_root,
+                                   sizeof(Binlog_writeset_entry))))
+      barrier= true;
+    else
+    {
+      element->key= key;
+      element->seq= seq;
+      barrier= my_hash_insert(&writeset_history, (uchar*) element);
+    }
+  }
+  if (barrier)
+  {
+    my_hash_reset(&writeset_history);
+    free_root(&writeset_mem_root, MYF(MY_MARK_BLOCKS_FREE));
+    last= seq - 1;
+    writeset_barrier= seq;
+  }
+
+  if (last >= writeset_group_start || !writeset_group_commit_id)
+  {
+    writeset_group_start= seq;
+    writeset_group_commit_id= (uint64) entry->thd->query_id;
+  }
+  return writeset_group_commit_id;
+}
+
+
 int
 MYSQL_BIN_LOG::write_transaction_or_stmt(group_commit_entry *entry,
                                          uint64 commit_id)
@@ -8406,6 +8826,10 @@ void MYSQL_BIN_LOG::close(uint exiting)
 
   mysql_mutex_assert_owner(&LOCK_log);
 
+  /* Wait for a group commit that syncs the file after releasing LOCK_log */
+  mysql_mutex_lock(&LOCK_binlog_sync);
+  mysql_mutex_unlock(&LOCK_binlog_sync);
+
   if (log_state == LOG_OPENED)
   {
 #ifdef HAVE_REPLICATION
@@ -315,7 +315,8 @@ class MYSQL_LOG
             const char *log_name,
             enum_log_type log_type,
             const char *new_name, ulong next_file_number,
-            enum cache_type io_cache_type_arg);
+            enum cache_type io_cache_type_arg,
+            size_t io_cache_size_arg= IO_SIZE);
   bool init_and_set_log_file_name(const char *log_name,
                                   const char *new_name,
                                   ulong next_log_number,
@@ -341,6 +342,7 @@ class MYSQL_LOG
   enum_log_type log_type;
   volatile enum_log_state log_state;
   enum cache_type io_cache_type;
+  size_t io_cache_size;
   friend class Log_event;
 #ifdef HAVE_PSI_INTERFACE
   /** Instrumentation key to use for file io in @c log_file */
@@ -359,6 +361,7 @@ class MYSQL_QUERY_LOG: public MYSQL_LOG
 public:
   MYSQL_QUERY_LOG() : last_time(0) {}
   void reopen_file();
+  void flush_buffer();
   bool write(time_t event_time, const char *user_host, size_t user_host_len, my_thread_id thread_id,
              const char *command_type, size_t command_type_len,
              const char *sql_text, size_t sql_text_len);
@@ -374,7 +377,8 @@ class MYSQL_QUERY_LOG: public MYSQL_LOG
                 key_file_slow_log,
 #endif
                 generate_name(log_name, "-slow.log", 0, buf),
-                LOG_NORMAL, 0, 0, WRITE_CACHE);
+                LOG_NORMAL, 0, 0, WRITE_CACHE,
+                opt_log_slow_buffer_size ? opt_log_slow_buffer_size : IO_SIZE);
   }
   bool open_query_log(const char *log_name)
   {
@@ -420,9 +424,20 @@ class MYSQL_QUERY_LOG: public MYSQL_LOG
 
 class binlog_cache_mngr;
 class binlog_cache_data;
+class Gtid_list_log_event;
 struct rpl_gtid;
 struct wait_for_commit;
 
+/*
+  Entry of the GTID index of the active binlog file: the binlog state at an
+  event group boundary.
+*/
+struct Binlog_gtid_index_entry
+{
+  my_off_t offset;
+  Gtid_list_log_event *glev;
+};
+
 class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
 {
  private:
@@ -494,6 +509,27 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   /* LOCK_log and LOCK_index are inited by init_pthread_objects() */
   mysql_mutex_t LOCK_index;
   mysql_mutex_t LOCK_binlog_end_pos;
+  /*
+    Held by a group commit leader while it syncs the file after releasing
+    LOCK_log, see binlog_sync_pipeline. Locked after LOCK_log.
+  */
+  mysql_mutex_t LOCK_binlog_sync;
+  /*
+    Sparse GTID index of the active binlog file, Binlog_gtid_index_entry
+    in the order of the offsets, see binlog_gtid_index_span. Changed under
+    LOCK_log and LOCK_binlog_end_pos, read under either of them.
+  */
+  DYNAMIC_ARRAY gtid_index;
+  char gtid_index_log_name[FN_REFLEN];
+  /*
+    The last transaction that changed each recent unique key value, and the
+    first transaction with the current commit id, see writeset_commit_id().
+    Changed under LOCK_log.
+  */
+  HASH writeset_history;
+  MEM_ROOT writeset_mem_root;
+  ulonglong writeset_seq, writeset_barrier, writeset_group_start;
+  uint64 writeset_group_commit_id;
   mysql_mutex_t LOCK_xid_list;
   mysql_cond_t  COND_xid_list;
   mysql_cond_t  COND_relay_log_updated, COND_bin_log_updated;
@@ -566,6 +602,7 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   void do_checkpoint_request(ulong binlog_id);
   void purge();
   int write_transaction_or_stmt(group_commit_entry *entry, uint64 commit_id);
+  uint64 writeset_commit_id(group_commit_entry *entry);
   int queue_for_group_commit(group_commit_entry *entry);
   bool write_transaction_to_binlog_events(group_commit_entry *entry);
   void trx_group_commit_leader(group_commit_entry *leader);
@@ -925,6 +962,19 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   void unlock_binlog_end_pos() { mysql_mutex_unlock(&LOCK_binlog_end_pos); }
   mysql_mutex_t* get_binlog_end_pos_lock() { return &LOCK_binlog_end_pos; }
 
+  void gtid_index_reset();
+  void gtid_index_add(my_off_t offset);
+  /*
+    The GTID index of the binlog file log_name (as normalized by
+    normalize_binlog_name()), or NULL if it is not the active file.
+    Call under lock_binlog_end_pos().
+  */
+  const DYNAMIC_ARRAY *get_gtid_index(const char *log_name)
+  {
+    mysql_mutex_assert_owner(&LOCK_binlog_end_pos);
+    return strcmp(log_name, gtid_index_log_name) ? NULL : &gtid_index;
+  }
+
   int wait_for_update_binlog_end_pos(THD* thd, struct timespec * timeout);
 
   /*
@@ -1118,6 +1168,8 @@ extern sql_print_message_func sql_print_message_handlers[];
 int error_log_print(enum loglevel level, const char *format,
                     va_list args);
 
+void start_slow_log_flush_thread();
+void stop_slow_log_flush_thread();
 bool slow_log_print(THD *thd, const char *query, uint query_length,
                     ulonglong current_utime);
 
@@ -1136,6 +1188,8 @@ File open_binlog(IO_CACHE *log, const char *log_file_name,
 
 void make_default_log_name(char **out, const char* log_ext, bool once);
 void binlog_reset_cache(THD *thd);
+void binlog_writeset_add_row(THD *thd, TABLE *table, const uchar *record,
+                             const MY_BITMAP *cols, const MY_BITMAP *cols2);
 
 extern MYSQL_PLUGIN_IMPORT MYSQL_BIN_LOG mysql_bin_log;
 extern handlerton *binlog_hton;
@@ -53,6 +53,9 @@
 #include "rpl_constants.h"
 #include "sql_digest.h"
 #include "zlib.h"
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
 #include "my_atomic.h"
 
 #define my_b_write_string(A, B) my_b_write((A), (uchar*)(B), (uint) (sizeof(B) - 1))
@@ -754,12 +757,13 @@ char *str_to_hex(char *to, const char *from, size_t len)
 
 #define BINLOG_COMPRESSED_HEADER_LEN 1
 #define BINLOG_COMPRESSED_ORIGINAL_LENGTH_MAX_BYTES 4
+#define BINLOG_COMPRESSED_ZSTD_LEVEL 3
 /**
   Compressed Record
     Record Header: 1 Byte
              7 Bit: Always 1, mean compressed;
-           4-6 Bit: Compressed algorithm - Always 0, means zlib
-                    It maybe support other compression algorithm in the future.
+           4-6 Bit: Compressed algorithm, enum_binlog_compress_alg:
+                    0 means zlib, 1 means zstd
            0-3 Bit: Bytes of "Record Original Length"
     Record Original Length: 1-4 Bytes
     Compressed Buf:
@@ -771,9 +775,13 @@ char *str_to_hex(char *to, const char *from, size_t len)
 
 uint32 binlog_get_compress_len(uint32 len)
 {
+    size_t bound= compressBound(len);
+#ifdef HAVE_ZSTD
+    set_if_bigger(bound, ZSTD_compressBound(len));
+#endif
     /* 5 for the begin content, 1 reserved for a '\0'*/
     return ALIGN_SIZE((BINLOG_COMPRESSED_HEADER_LEN + BINLOG_COMPRESSED_ORIGINAL_LENGTH_MAX_BYTES) 
-                        + compressBound(len) + 1);
+                        + (uint32) bound + 1);
 }
 
 /**
@@ -784,10 +792,13 @@ uint32 binlog_get_compress_len(uint32 len)
       the content uncompressed.
          2) The 'comlen' should stored the length of 'dst', and it will
       be set as the size of compressed content after return.
+         3) zlib is used instead of zstd if the server is built without
+      zstd.
 
    return zero if successful, others otherwise.
 */
-int binlog_buf_compress(const char *src, char *dst, uint32 len, uint32 *comlen)
+int binlog_buf_compress(const char *src, char *dst, uint32 len, uint32 *comlen,
+                        uint alg)
 {
   uchar lenlen;
   if (len & 0xFF000000)
@@ -816,6 +827,19 @@ int binlog_buf_compress(const char *src, char *dst, uint32 len, uint32 *comlen)
     dst[1] = uchar(len);
     lenlen = 1;
   }
+#ifdef HAVE_ZSTD
+  if (alg == BINLOG_COMPRESS_ZSTD)
+  {
+    dst[0] = 0x80 | (BINLOG_COMPRESS_ZSTD << 4) | (lenlen & 0x07);
+    size_t res= ZSTD_compress(dst + BINLOG_COMPRESSED_HEADER_LEN + lenlen,
+                              *comlen - BINLOG_COMPRESSED_HEADER_LEN - lenlen - 1,
+                              src, len, BINLOG_COMPRESSED_ZSTD_LEVEL);
+    if (ZSTD_isError(res))
+      return 1;
+    *comlen = (uint32)res + BINLOG_COMPRESSED_HEADER_LEN + lenlen;
+    return 0;
+  }
+#endif
   dst[0] = 0x80 | (lenlen & 0x07);
 
   uLongf tmplen = (uLongf)*comlen - BINLOG_COMPRESSED_HEADER_LEN - lenlen - 1;
@@ -1115,9 +1139,19 @@ int binlog_buf_uncompress(const char *src, char *dst, uint32 len,
       return 1;
     }
     break;
+#ifdef HAVE_ZSTD
+  case BINLOG_COMPRESS_ZSTD:
+  {
+    size_t res= ZSTD_decompress(dst, buflen, src + 1 + lenlen,
+                                len - 1 - lenlen);
+    if (ZSTD_isError(res))
+      return 1;
+    buflen= (uLongf) res;
+    break;
+  }
+#endif
   default:
-    //TODO
-    //bad algorithm
+    //bad algorithm, or zstd without zstd support
     return 1;
   }
 
@@ -1900,52 +1934,89 @@ int Log_event::read_log_event(IO_CACHE* file, String* packet,
   DBUG_RETURN(0);
 }
 
-Log_event* Log_event::read_log_event(IO_CACHE* file,
-                                     const Format_description_log_event *fdle,
-                                     my_bool crc_check)
+/**
+  Read an event from a binlog or relay log without parsing it.
+
+  @param[out] error  description of the error, unless the end of the file
+                     was reached
+
+  @retval 0             success
+  @retval LOG_READ_EOF  end of file, nothing was read
+  @retval other         error
+*/
+
+int Log_event::read_log_event_data(IO_CACHE* file, String* event,
+                                   const Format_description_log_event *fdle,
+                                   const char **error)
 {
-  DBUG_ENTER("Log_event::read_log_event(IO_CACHE*,Format_description_log_event*...)");
+  int res;
+  DBUG_ENTER("Log_event::read_log_event_data");
   DBUG_ASSERT(fdle != 0);
-  String event;
-  const char *error= 0;
-  Log_event *res= 0;
 
-  switch (read_log_event(file, &event, fdle, BINLOG_CHECKSUM_ALG_OFF))
+  switch ((res= read_log_event(file, event, fdle, BINLOG_CHECKSUM_ALG_OFF)))
   {
     case 0:
-      break;
     case LOG_READ_EOF: // no error here; we are at the file's end
-      goto err;
+      break;
     case LOG_READ_BOGUS:
-      error= "Event invalid";
-      goto err;
+      *error= "Event invalid";
+      break;
     case LOG_READ_IO:
-      error= "read error";
-      goto err;
+      *error= "read error";
+      break;
     case LOG_READ_MEM:
-      error= "Out of memory";
-      goto err;
+      *error= "Out of memory";
+      break;
     case LOG_READ_TRUNC:
-      error= "Event truncated";
-      goto err;
+      *error= "Event truncated";
+      break;
     case LOG_READ_TOO_LARGE:
-      error= "Event too big";
-      goto err;
+      *error= "Event too big";
+      break;
     case LOG_READ_DECRYPT:
-      error= "Event decryption failure";
-      goto err;
+      *error= "Event decryption failure";
+      break;
     case LOG_READ_CHECKSUM_FAILURE:
     default:
       DBUG_ASSERT(0);
-      error= "internal error";
-      goto err;
+      *error= "internal error";
+      break;
   }
+  DBUG_RETURN(res);
+}
+
+
+/**
+  Report an event that could not be read or parsed.
+*/
+
+void Log_event::report_read_error(const String *event, const char *error)
+{
+  if (event->length() >= OLD_HEADER_LEN)
+    sql_print_error("Error in Log_event::read_log_event(): '%s',"
+                    " data_len: %lu, event_type: %u", error,
+                    (ulong) uint4korr(event->ptr() + EVENT_LEN_OFFSET),
+                    (uint) (uchar) event->ptr()[EVENT_TYPE_OFFSET]);
+  else
+    sql_print_error("Error in Log_event::read_log_event(): '%s'", error);
+}
+
+
+Log_event* Log_event::read_log_event(IO_CACHE* file,
+                                     const Format_description_log_event *fdle,
+                                     my_bool crc_check)
+{
+  DBUG_ENTER("Log_event::read_log_event(IO_CACHE*,Format_description_log_event*...)");
+  DBUG_ASSERT(fdle != 0);
+  String event;
+  const char *error= 0;
+  Log_event *res= 0;
 
-  if ((res= read_log_event(event.ptr(), event.length(),
+  if (!read_log_event_data(file, &event, fdle, &error) &&
+      (res= read_log_event(event.ptr(), event.length(),
                            &error, fdle, crc_check)))
     res->register_temp_buf(event.release(), true);
 
-err:
   if (unlikely(error))
   {
     DBUG_ASSERT(!res);
@@ -1953,13 +2024,7 @@ Log_event* Log_event::read_log_event(IO_CACHE* file,
     if (force_opt)
       DBUG_RETURN(new Unknown_log_event());
 #endif
-    if (event.length() >= OLD_HEADER_LEN)
-      sql_print_error("Error in Log_event::read_log_event(): '%s',"
-                      " data_len: %lu, event_type: %u", error,
-                      (ulong) uint4korr(&event[EVENT_LEN_OFFSET]),
-                      (uint) (uchar)event[EVENT_TYPE_OFFSET]);
-    else
-      sql_print_error("Error in Log_event::read_log_event(): '%s'", error);
+    report_read_error(&event, error);
     /*
       The SQL slave thread will check if file->error<0 to know
       if there was an I/O error. Even if there is no "low-level" I/O errors
@@ -4244,7 +4309,8 @@ bool Query_compressed_log_event::write()
   bool ret = true;
   q_len = alloc_size = binlog_get_compress_len(q_len);
   query = (char *)my_safe_alloca(alloc_size);
-  if(query && !binlog_buf_compress(query_tmp, (char *)query, q_len_tmp, &q_len))
+  if(query && !binlog_buf_compress(query_tmp, (char *)query, q_len_tmp, &q_len,
+                                   (uint) opt_bin_log_compress_algorithm))
   {
     ret = Query_log_event::write();
   }
@@ -10749,7 +10815,7 @@ Rows_log_event::Rows_log_event(THD *thd_arg, TABLE *tbl_arg, ulong tid,
 #ifdef HAVE_REPLICATION
     , m_curr_row(NULL), m_curr_row_end(NULL),
     m_key(NULL), m_key_info(NULL), m_key_nr(0),
-    master_had_triggers(0)
+    m_hash_scan(NULL), master_had_triggers(0)
 #endif
 {
   /*
@@ -10801,7 +10867,7 @@ Rows_log_event::Rows_log_event(const char *buf, uint event_len,
 #if !defined(MYSQL_CLIENT) && defined(HAVE_REPLICATION)
     , m_curr_row(NULL), m_curr_row_end(NULL),
     m_key(NULL), m_key_info(NULL), m_key_nr(0),
-    master_had_triggers(0)
+    m_hash_scan(NULL), master_had_triggers(0)
 #endif
 {
   DBUG_ENTER("Rows_log_event::Rows_log_event(const char*,...)");
@@ -11500,6 +11566,9 @@ int Rows_log_event::do_apply_event(rpl_group_info *rgi)
     if (!is_auto_inc_in_extra_columns())
       thd->variables.sql_mode= MODE_NO_AUTO_VALUE_ON_ZERO;
 
+    if (likely(!error))
+      hash_scan_rows(rgi);
+
     // row processing loop
 
     /* 
@@ -11566,6 +11635,8 @@ int Rows_log_event::do_apply_event(rpl_group_info *rgi)
     } // row processing loop
     while (error == 0 && (m_curr_row != m_rows_end));
 
+    free_hash_scan();
+
     /*
       Restore the sql_mode after the rows event is processed.
     */
@@ -11846,7 +11917,8 @@ bool Rows_log_event::write_compressed()
   m_rows_buf = (uchar *)my_safe_alloca(alloc_size);
   if(m_rows_buf &&
      !binlog_buf_compress((const char *)m_rows_buf_tmp, (char *)m_rows_buf,
-                          (uint32)(m_rows_cur_tmp - m_rows_buf_tmp), &comlen))
+                          (uint32)(m_rows_cur_tmp - m_rows_buf_tmp), &comlen,
+                          (uint) opt_bin_log_compress_algorithm))
   {
     m_rows_cur= comlen + m_rows_buf;
     ret= Log_event::write();
@@ -13648,6 +13720,220 @@ static int row_not_found_error(rpl_group_info *rgi)
          ? HA_ERR_KEY_NOT_FOUND : HA_ERR_RECORD_CHANGED;
 }
 
+/**
+  A row of a DELETE or UPDATE rows event, located by
+  Rows_log_event::hash_scan_rows().
+*/
+struct Rows_hash_scan_row
+{
+  ulong hash;                   /* record_hash() of the before image */
+  const uchar *row;             /* Start of the row in the event */
+  uchar *record;                /* Before image, in record[0] format */
+  uchar *ref;                   /* Position of the table row, or NULL */
+  Rows_hash_scan_row *next;     /* Next row of the event */
+};
+
+struct Rows_hash_scan
+{
+  MEM_ROOT mem_root;
+  HASH hash;                    /* Rows not matched yet, by hash */
+  Rows_hash_scan_row *first;
+  Rows_hash_scan_row *next;     /* Next row for find_row() */
+};
+
+
+/*
+  Hash of table->record[0], equal for records that record_compare()
+  finds equal
+*/
+static ulong record_hash(TABLE *table)
+{
+  ulong nr1= 1, nr2= 4;
+
+  for (Field **ptr= table->field; *ptr; ptr++)
+  {
+    Field *field= *ptr;
+    if ((field->flags & BLOB_FLAG) && !field->is_null())
+    {
+      /* Hash the value, not the pointer to it */
+      Field_blob *blob= (Field_blob*) field;
+      my_charset_bin.coll->hash_sort(&my_charset_bin, blob->get_ptr(),
+                                     blob->get_length(), &nr1, &nr2);
+    }
+    else
+      field->hash(&nr1, &nr2);
+  }
+  return nr1;
+}
+
+
+/**
+  Locate all rows of a DELETE or UPDATE rows event in a single table scan.
+
+  Without a usable key find_row() scans the table once for every row of
+  the event. Instead the before images are put in a hash by their values
+  and the table is scanned once, remembering the position of the table
+  row that matches each before image. find_row() then reads the rows by
+  these positions. Table rows with equal values are matched with the
+  before images in the order of the scan.
+
+  Nothing is done unless slave_rows_hash_scan is set. If the rows can't
+  be located this way, m_hash_scan stays NULL and find_row() looks for
+  them one by one.
+*/
+
+void Rows_log_event::hash_scan_rows(rpl_group_info *rgi)
+{
+  TABLE *table= m_table;
+  handler *file= table->file;
+  Rows_hash_scan *scan;
+  Rows_hash_scan_row **last, *row;
+  const uchar *saved_row= m_curr_row;
+  const bool is_update= get_general_type_code() == UPDATE_ROWS_EVENT;
+  uint count= 0;
+  int error= 0;
+  DBUG_ENTER("Rows_log_event::hash_scan_rows");
+
+  if (!opt_slave_rows_hash_scan ||
+      (get_general_type_code() != DELETE_ROWS_EVENT && !is_update) ||
+      m_key_info || table->versioned() ||
+      ((file->ha_table_flags() & HA_PRIMARY_KEY_REQUIRED_FOR_POSITION) &&
+       table->s->primary_key < MAX_KEY))
+    DBUG_VOID_RETURN;
+
+  if (!(scan= (Rows_hash_scan*) my_malloc(sizeof(Rows_hash_scan),
+                                          MYF(MY_THREAD_SPECIFIC))))
+    DBUG_VOID_RETURN;
+  init_alloc_root(&scan->mem_root, "Rows_hash_scan", 8192, 0,
+                  MYF(MY_THREAD_SPECIFIC));
+  my_hash_init(&scan->hash, &my_charset_bin, 64,
+               offsetof(Rows_hash_scan_row, hash), sizeof(ulong), 0, 0, 0);
+  scan->first= scan->next= NULL;
+  m_hash_scan= scan;
+
+  /* Put the before images in the hash */
+  last= &scan->first;
+  for (m_curr_row= m_rows_buf; m_curr_row != m_rows_end; count++)
+  {
+    prepare_record(table, m_width, FALSE);
+    if (unlikely((error= unpack_current_row(rgi))))
+      goto err;
+    if (!(row= (Rows_hash_scan_row*)
+               alloc_root(&scan->mem_root,
+                          sizeof(Rows_hash_scan_row) + table->s->reclength)))
+      goto err;
+    row->hash= record_hash(table);
+    row->row= m_curr_row;
+    row->record= (uchar*) (row + 1);
+    row->ref= NULL;
+    row->next= NULL;
+    memcpy(row->record, table->record[0], table->s->reclength);
+    /* Keep BLOB values, they may be in a buffer of the field */
+    for (Field **ptr= table->field; *ptr; ptr++)
+    {
+      Field *field= *ptr;
+      if ((field->flags & BLOB_FLAG) && !field->is_null())
+      {
+        Field_blob *blob= (Field_blob*) field;
+        uchar *value;
+        if (!(value= (uchar*) memdup_root(&scan->mem_root, blob->get_ptr(),
+                                          blob->get_length())))
+          goto err;
+        blob->set_ptr_offset(row->record - table->record[0],
+                             blob->get_length(), value);
+      }
+    }
+    if (my_hash_insert(&scan->hash, (uchar*) row))
+      goto err;
+    *last= row;
+    last= &row->next;
+
+    m_curr_row= m_curr_row_end;
+    if (is_update)
+    {
+      /* Skip the after image */
+      if (unlikely((error= unpack_current_row(rgi, &m_cols_ai))))
+        goto err;
+      m_curr_row= m_curr_row_end;
+    }
+  }
+  m_curr_row= saved_row;
+  m_curr_row_end= NULL;
+
+  /* A single row is found as fast by find_row() */
+  if (count < 2)
+    goto err;
+
+  /* Match the table rows with the before images */
+  table->use_all_columns();
+  if (unlikely((error= file->ha_rnd_init_with_error(1))))
+  {
+    table->default_column_bitmaps();
+    goto err;
+  }
+  while (scan->hash.records &&
+         !(error= file->ha_rnd_next(table->record[0])))
+  {
+    HASH_SEARCH_STATE state;
+    ulong hash= record_hash(table);
+
+    for (row= (Rows_hash_scan_row*)
+              my_hash_first(&scan->hash, (uchar*) &hash, sizeof(hash),
+                            &state);
+         row;
+         row= (Rows_hash_scan_row*)
+              my_hash_next(&scan->hash, (uchar*) &hash, sizeof(hash),
+                           &state))
+    {
+      memcpy(table->record[1], row->record, table->s->reclength);
+      if (!record_compare(table))
+      {
+        file->position(table->record[0]);
+        if (!(row->ref= (uchar*) memdup_root(&scan->mem_root, file->ref,
+                                             file->ref_length)))
+        {
+          error= HA_ERR_OUT_OF_MEM;
+          break;
+        }
+        my_hash_delete(&scan->hash, (uchar*) row);
+        break;
+      }
+    }
+    if (unlikely(error))
+      break;
+  }
+  file->ha_rnd_end();
+  table->default_column_bitmaps();
+  if (error && error != HA_ERR_END_OF_FILE)
+  {
+    DBUG_PRINT("info", ("error: %s", HA_ERR(error)));
+    goto err;
+  }
+
+  scan->next= scan->first;
+  statistic_increment(slave_rows_hash_scans, LOCK_status);
+  DBUG_VOID_RETURN;
+
+err:
+  m_curr_row= saved_row;
+  m_curr_row_end= NULL;
+  free_hash_scan();
+  DBUG_VOID_RETURN;
+}
+
+
+void Rows_log_event::free_hash_scan()
+{
+  if (m_hash_scan)
+  {
+    my_hash_free(&m_hash_scan->hash);
+    free_root(&m_hash_scan->mem_root, MYF(0));
+    my_free(m_hash_scan);
+    m_hash_scan= NULL;
+  }
+}
+
+
 /**
   Locate the current row in event's table.
 
@@ -13770,6 +14056,31 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
    */ 
   store_record(table,record[1]);    
 
+  if (m_hash_scan && m_hash_scan->next &&
+      m_hash_scan->next->row == m_curr_row)
+  {
+    /* The row was located by hash_scan_rows() */
+    Rows_hash_scan_row *row= m_hash_scan->next;
+    m_hash_scan->next= row->next;
+    DBUG_PRINT("info",("locating record using hash scan (rnd_pos)"));
+    if (!row->ref)
+    {
+      DBUG_PRINT("info", ("Record not found"));
+      error= HA_ERR_END_OF_FILE;
+      goto end;
+    }
+    if (unlikely((error= table->file->ha_rnd_init_with_error(0))))
+      goto end;
+    if (unlikely((error= table->file->ha_rnd_pos(table->record[0],
+                                                 row->ref))))
+    {
+      DBUG_PRINT("info",("rnd_pos returns error %d",error));
+      table->file->print_error(error, MYF(0));
+      table->file->ha_rnd_end();
+    }
+    goto end;
+  }
+
   if (m_key_info)
   {
     DBUG_PRINT("info",("locating record using key #%u [%s] (index_read)",
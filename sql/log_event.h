@@ -1339,6 +1339,10 @@ class Log_event
   static int read_log_event(IO_CACHE* file, String* packet,
                             const Format_description_log_event *fdle,
                             enum enum_binlog_checksum_alg checksum_alg_arg);
+  static int read_log_event_data(IO_CACHE* file, String* event,
+                                 const Format_description_log_event *fdle,
+                                 const char **error);
+  static void report_read_error(const String *event, const char *error);
   /* 
      The value is set by caller of FD constructor and
      Log_event::write_header() for the rest.
@@ -4619,10 +4623,13 @@ class Rows_log_event : public Log_event
   uchar    *m_key;      /* Buffer to keep key value during searches */
   KEY      *m_key_info; /* Pointer to KEY info for m_key_nr */
   uint      m_key_nr;   /* Key number */
+  struct Rows_hash_scan *m_hash_scan; /* Rows located by hash_scan_rows() */
   bool master_had_triggers;     /* set after tables opening */
 
   int find_key(); // Find a best key to use in find_row()
   int find_row(rpl_group_info *);
+  void hash_scan_rows(rpl_group_info *);
+  void free_hash_scan();
   int write_row(rpl_group_info *, const bool);
   int update_sequence();
 
@@ -5203,7 +5210,15 @@ extern TYPELIB binlog_checksum_typelib;
 */
 
 
-int binlog_buf_compress(const char *src, char *dst, uint32 len, uint32 *comlen);
+/* Values of log_bin_compress_algorithm, stored in compressed records */
+enum enum_binlog_compress_alg
+{
+  BINLOG_COMPRESS_ZLIB= 0,
+  BINLOG_COMPRESS_ZSTD= 1
+};
+
+int binlog_buf_compress(const char *src, char *dst, uint32 len, uint32 *comlen,
+                        uint alg);
 int binlog_buf_uncompress(const char *src, char *dst, uint32 len, uint32 *newlen);
 uint32 binlog_get_compress_len(uint32 len);
 uint32 binlog_get_uncompress_len(const char *buf);
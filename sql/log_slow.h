@@ -22,6 +22,7 @@
 #define LOG_SLOW_VERBOSITY_INNODB         (1U << 0)
 #define LOG_SLOW_VERBOSITY_QUERY_PLAN     (1U << 1)
 #define LOG_SLOW_VERBOSITY_EXPLAIN        (1U << 2)
+#define LOG_SLOW_VERBOSITY_EXPLAIN_JSON   (1U << 3)
 
 #define QPLAN_INIT            QPLAN_QC_NO
 
@@ -123,6 +123,8 @@ class MDL_map
   void init();
   void destroy();
   MDL_lock *find_or_insert(LF_PINS *pins, const MDL_key *key);
+  MDL_lock *fast_path_acquire(LF_PINS *pins, const MDL_key *key,
+                              int64 increment);
   unsigned long get_lock_owner(LF_PINS *pins, const MDL_key *key);
   void remove(LF_PINS *pins, MDL_lock *lock);
   LF_PINS *get_pins() { return lf_hash_get_pins(&m_locks); }
@@ -281,6 +283,51 @@ Deadlock_detection_visitor::opt_change_victim_to(MDL_context *new_victim)
 
 #define MDL_BIT(A) static_cast<MDL_lock::bitmap_t>(1U << A)
 
+/**
+  Fast path for DML locks.
+
+  SR and SW locks on objects which are compatible with all locks on
+  the object are granted by incrementing a counter in
+  MDL_lock::m_fast_path_state, without taking MDL_lock::m_rwlock and
+  without adding the ticket to MDL_lock::m_granted (see
+  MDL_context::try_acquire_lock_impl()). This keeps the MDL_lock of a
+  table used by many connections from being written by all of them.
+
+  Such locks are only conflicting with "obtrusive" lock types, see
+  MDL_FAST_PATH_OBTRUSIVE_TYPES. While obtrusive locks are granted or
+  waited for, MDL_FAST_PATH_HAS_OBTRUSIVE is set, and SR and SW locks
+  are acquired on the slow path. A request for an obtrusive lock sees
+  the locks granted on the fast path through the counters, as they
+  belong to other contexts: a context moves its own fast path tickets
+  to MDL_lock::m_granted ("materializes" them) before it requests an
+  obtrusive lock and before it waits, so that the deadlock detector
+  sees all edges of the wait-for graph which can be part of a loop.
+
+  The counters are changed with atomic operations only. The flags are
+  set and cleared under MDL_lock::m_rwlock.
+*/
+
+#define MDL_FAST_PATH_SR_INCREMENT   1LL
+#define MDL_FAST_PATH_SW_INCREMENT   (1LL << 28)
+#define MDL_FAST_PATH_COUNT_MASK     ((1LL << 56) - 1)
+/** Obtrusive locks are granted or waited for. */
+#define MDL_FAST_PATH_HAS_OBTRUSIVE  (1LL << 60)
+/** MDL_lock is being removed from MDL_map. */
+#define MDL_FAST_PATH_IS_DESTROYED   (1LL << 61)
+
+#define MDL_FAST_PATH_OBTRUSIVE_TYPES                                  \
+  (MDL_BIT(MDL_SHARED_READ_ONLY) | MDL_BIT(MDL_SHARED_NO_WRITE) |       \
+   MDL_BIT(MDL_SHARED_NO_READ_WRITE) | MDL_BIT(MDL_EXCLUSIVE))
+
+my_bool opt_mdl_fast_path;
+
+static inline int64 mdl_fast_path_increment(enum_mdl_type type)
+{
+  DBUG_ASSERT(type == MDL_SHARED_READ || type == MDL_SHARED_WRITE);
+  return type == MDL_SHARED_READ ? MDL_FAST_PATH_SR_INCREMENT :
+                                   MDL_FAST_PATH_SW_INCREMENT;
+}
+
 /**
   The lock context. Created internally for an acquired lock.
   For a given name, there exists only one MDL_lock instance,
@@ -467,7 +514,32 @@ class MDL_lock
 
   bool is_empty() const
   {
-    return (m_granted.is_empty() && m_waiting.is_empty());
+    return (m_granted.is_empty() && m_waiting.is_empty() &&
+            !(fast_path_state() & MDL_FAST_PATH_COUNT_MASK));
+  }
+
+  int64 fast_path_state() const
+  {
+    return my_atomic_load64(const_cast<volatile int64*>(&m_fast_path_state));
+  }
+  bitmap_t fast_path_granted_bitmap() const
+  {
+    int64 state= fast_path_state();
+    return ((state & (MDL_FAST_PATH_SW_INCREMENT - 1) ?
+             MDL_BIT(MDL_SHARED_READ) : 0) |
+            (state & (MDL_FAST_PATH_COUNT_MASK &
+                      ~(MDL_FAST_PATH_SW_INCREMENT - 1)) ?
+             MDL_BIT(MDL_SHARED_WRITE) : 0));
+  }
+  bool fast_path_acquire(int64 increment);
+  void fast_path_release(LF_PINS *pins, int64 increment);
+  void set_has_obtrusive(enum_mdl_type type);
+  void update_has_obtrusive();
+  bool mark_destroyed()
+  {
+    int64 state= 0;
+    return my_atomic_cas64(&m_fast_path_state, &state,
+                           MDL_FAST_PATH_IS_DESTROYED);
   }
 
   const bitmap_t *incompatible_granted_types_bitmap() const
@@ -528,16 +600,24 @@ class MDL_lock
   */
   ulong m_hog_lock_count;
 
+  /**
+    Numbers of SR and SW locks granted on the fast path, which are not
+    in m_granted, and MDL_FAST_PATH_* flags.
+  */
+  volatile int64 m_fast_path_state;
+
 public:
 
   MDL_lock()
     : m_hog_lock_count(0),
+      m_fast_path_state(0),
       m_strategy(0)
   { mysql_prlock_init(key_MDL_lock_rwlock, &m_rwlock); }
 
   MDL_lock(const MDL_key *key_arg)
   : key(key_arg),
     m_hog_lock_count(0),
+    m_fast_path_state(0),
     m_strategy(&m_scoped_lock_strategy)
   {
     DBUG_ASSERT(key_arg->mdl_namespace() == MDL_key::GLOBAL ||
@@ -560,6 +640,7 @@ class MDL_lock
     DBUG_ASSERT(key_arg->mdl_namespace() != MDL_key::GLOBAL &&
                 key_arg->mdl_namespace() != MDL_key::COMMIT);
     new (&lock->key) MDL_key(key_arg);
+    lock->m_fast_path_state= 0;
     if (key_arg->mdl_namespace() == MDL_key::SCHEMA)
       lock->m_strategy= &m_scoped_lock_strategy;
     else
@@ -773,6 +854,39 @@ MDL_lock* MDL_map::find_or_insert(LF_PINS *pins, const MDL_key *mdl_key)
 }
 
 
+/**
+  Find MDL_lock object corresponding to the key, create it if it does
+  not exist, and grant a lock on the fast path.
+
+  @retval non-NULL - Success. MDL_lock instance for the key. The lock
+                     is counted in MDL_lock::m_fast_path_state.
+  @retval NULL     - The lock can't be granted on the fast path as there
+                     are obtrusive locks on the object or the object is
+                     being destroyed, or out of memory. The slow path must
+                     be used, which also reports errors.
+*/
+
+MDL_lock *MDL_map::fast_path_acquire(LF_PINS *pins, const MDL_key *mdl_key,
+                                     int64 increment)
+{
+  MDL_lock *lock;
+
+  DBUG_ASSERT(mdl_key->mdl_namespace() != MDL_key::GLOBAL &&
+              mdl_key->mdl_namespace() != MDL_key::COMMIT);
+
+  while (!(lock= (MDL_lock*) lf_hash_search(&m_locks, pins, mdl_key->ptr(),
+                                            mdl_key->length())))
+    if (lf_hash_insert(&m_locks, pins, (uchar*) mdl_key) == -1)
+      return NULL;
+
+  if (!lock->fast_path_acquire(increment))
+    lock= NULL;
+  lf_hash_search_unpin(pins);
+
+  return lock;
+}
+
+
 /**
  * Return thread id of the owner of the lock, if it is owned.
  */
@@ -831,6 +945,17 @@ void MDL_map::remove(LF_PINS *pins, MDL_lock *lock)
     return;
   }
 
+  /*
+    A lock may have been granted on the fast path since the caller has
+    checked that MDL_lock is empty, or MDL_lock may be destroyed already
+    if the caller releases a fast path lock.
+  */
+  if (!lock->mark_destroyed())
+  {
+    mysql_prlock_unlock(&lock->m_rwlock);
+    return;
+  }
+
   lock->m_strategy= 0;
   mysql_prlock_unlock(&lock->m_rwlock);
   lf_hash_delete(&m_locks, pins, lock->key.ptr(), lock->key.length());
@@ -1569,7 +1694,14 @@ MDL_lock::can_grant_lock(enum_mdl_type type_arg,
   */
   if (ignore_lock_priority || !(m_waiting.bitmap() & waiting_incompat_map))
   {
-    if (! (m_granted.bitmap() & granted_incompat_map))
+    /*
+      Locks granted on the fast path belong to other contexts, since
+      the requestor has materialized its own ones before requesting
+      a lock which conflicts with them.
+    */
+    if (fast_path_granted_bitmap() & granted_incompat_map)
+      can_grant= FALSE;
+    else if (! (m_granted.bitmap() & granted_incompat_map))
       can_grant= TRUE;
     else
     {
@@ -1654,6 +1786,7 @@ void MDL_lock::remove_ticket(LF_PINS *pins, Ticket_list MDL_lock::*list,
 {
   mysql_prlock_wrlock(&m_rwlock);
   (this->*list).remove_ticket(ticket);
+  update_has_obtrusive();
   if (is_empty())
     mdl_locks.remove(pins, this);
   else
@@ -1678,6 +1811,94 @@ void MDL_lock::remove_ticket(LF_PINS *pins, Ticket_list MDL_lock::*list,
 }
 
 
+/**
+  Grant a lock on the fast path, unless there are obtrusive locks on
+  the object or the object is being destroyed.
+
+  @param increment  MDL_FAST_PATH_SR_INCREMENT or MDL_FAST_PATH_SW_INCREMENT
+
+  @retval TRUE   The lock was granted.
+  @retval FALSE  The lock must be acquired on the slow path.
+*/
+
+bool MDL_lock::fast_path_acquire(int64 increment)
+{
+  int64 state= fast_path_state();
+  do
+  {
+    if (state & (MDL_FAST_PATH_HAS_OBTRUSIVE | MDL_FAST_PATH_IS_DESTROYED))
+      return FALSE;
+  } while (!my_atomic_cas64(&m_fast_path_state, &state, state + increment));
+  return TRUE;
+}
+
+
+/**
+  Release a lock granted on the fast path.
+
+  When obtrusive locks are waiting, they might be granted now, and when
+  this was the last lock on the object, the object is removed. Both
+  require m_rwlock. As the object may then be destroyed by another
+  thread as soon as the counter is decremented, it is pinned before.
+*/
+
+void MDL_lock::fast_path_release(LF_PINS *pins, int64 increment)
+{
+  int64 state= fast_path_state();
+  do
+  {
+    if ((state & MDL_FAST_PATH_HAS_OBTRUSIVE) ||
+        (state & MDL_FAST_PATH_COUNT_MASK) == increment)
+    {
+      lf_pin(pins, 3, (uchar*) this - LF_HASH_OVERHEAD);
+      my_atomic_add64(&m_fast_path_state, -increment);
+      mysql_prlock_wrlock(&m_rwlock);
+      if (is_empty())
+        mdl_locks.remove(pins, this);
+      else
+      {
+        reschedule_waiters();
+        mysql_prlock_unlock(&m_rwlock);
+      }
+      lf_unpin(pins, 3);
+      return;
+    }
+  } while (!my_atomic_cas64(&m_fast_path_state, &state, state - increment));
+}
+
+
+/**
+  Stop granting locks on the fast path when an obtrusive lock is
+  requested.
+
+  @pre m_rwlock is write-locked.
+*/
+
+void MDL_lock::set_has_obtrusive(enum_mdl_type type)
+{
+  if (m_strategy == &m_object_lock_strategy &&
+      (MDL_BIT(type) & MDL_FAST_PATH_OBTRUSIVE_TYPES) &&
+      !(fast_path_state() & MDL_FAST_PATH_HAS_OBTRUSIVE))
+    my_atomic_add64(&m_fast_path_state, MDL_FAST_PATH_HAS_OBTRUSIVE);
+}
+
+
+/**
+  Allow granting locks on the fast path again when no obtrusive locks
+  are granted or waited for any more.
+
+  @pre m_rwlock is write-locked.
+*/
+
+void MDL_lock::update_has_obtrusive()
+{
+  if ((fast_path_state() & MDL_FAST_PATH_HAS_OBTRUSIVE) &&
+      !((m_granted.bitmap() | m_waiting.bitmap()) &
+        MDL_FAST_PATH_OBTRUSIVE_TYPES))
+    my_atomic_add64(&m_fast_path_state, -MDL_FAST_PATH_HAS_OBTRUSIVE);
+}
+
+
 /**
   Check if we have any pending locks which conflict with existing
   shared lock.
@@ -1739,6 +1960,40 @@ bool MDL_ticket::is_incompatible_when_waiting(enum_mdl_type type) const
 }
 
 
+/**
+  Check if a lock can be granted on the fast path.
+
+  Only SR and SW locks on objects are. Contexts which must be notified
+  of conflicting lock requests (HANDLER and INSERT DELAYED threads,
+  see MDL_context::set_needs_thr_lock_abort()) don't use the fast path,
+  nor do Galera nodes, since brute force aborts look for the locks
+  conflicting with the applier in MDL_lock::m_granted.
+*/
+
+static bool mdl_fast_path_eligible(const MDL_context *ctx,
+                                   const MDL_request *mdl_request)
+{
+  if (!opt_mdl_fast_path || ctx->get_needs_thr_lock_abort() ||
+      (mdl_request->type != MDL_SHARED_READ &&
+       mdl_request->type != MDL_SHARED_WRITE))
+    return false;
+
+  switch (mdl_request->key.mdl_namespace()) {
+  case MDL_key::GLOBAL:
+  case MDL_key::SCHEMA:
+  case MDL_key::COMMIT:
+    return false;
+  default:
+    break;
+  }
+#ifdef WITH_WSREP
+  if (WSREP_ON)
+    return false;
+#endif /* WITH_WSREP */
+  return true;
+}
+
+
 /**
   Check whether the context already holds a compatible lock ticket
   on an object.
@@ -1826,6 +2081,7 @@ MDL_context::try_acquire_lock(MDL_request *mdl_request)
       is no need to release it.
     */
     DBUG_ASSERT(! ticket->m_lock->is_empty());
+    ticket->m_lock->update_has_obtrusive();
     mysql_prlock_unlock(&ticket->m_lock->m_rwlock);
     MDL_ticket::destroy(ticket);
   }
@@ -1913,6 +2169,27 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
                                    )))
     return TRUE;
 
+  if (mdl_fast_path_eligible(this, mdl_request))
+  {
+    int64 increment= mdl_fast_path_increment(mdl_request->type);
+    if ((lock= mdl_locks.fast_path_acquire(m_pins, key, increment)))
+    {
+      ticket->m_lock= lock;
+      ticket->m_is_fast_path= true;
+      m_tickets[mdl_request->duration].push_front(ticket);
+      mdl_request->ticket= ticket;
+      return FALSE;
+    }
+  }
+  else if (MDL_BIT(mdl_request->type) & MDL_FAST_PATH_OBTRUSIVE_TYPES)
+  {
+    /*
+      Locks granted to this context on the fast path must be visible
+      to can_grant_lock() and to the deadlock detector.
+    */
+    materialize_fast_path_locks();
+  }
+
   /* The below call implicitly locks MDL_lock::m_rwlock on success. */
   if (!(lock= mdl_locks.find_or_insert(m_pins, key)))
   {
@@ -1921,6 +2198,7 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
   }
 
   ticket->m_lock= lock;
+  lock->set_has_obtrusive(mdl_request->type);
 
   if (lock->can_grant_lock(mdl_request->type, this, false))
   {
@@ -2090,6 +2368,7 @@ MDL_context::acquire_lock(MDL_request *mdl_request, double lock_wait_timeout)
 
   if (lock_wait_timeout == 0)
   {
+    lock->update_has_obtrusive();
     mysql_prlock_unlock(&lock->m_rwlock);
     MDL_ticket::destroy(ticket);
     my_error(ER_LOCK_WAIT_TIMEOUT, MYF(0));
@@ -2336,6 +2615,9 @@ MDL_context::upgrade_shared_lock(MDL_ticket *mdl_ticket,
   if (acquire_lock(&mdl_xlock_request, lock_wait_timeout))
     DBUG_RETURN(TRUE);
 
+  /* The tickets are merged in MDL_lock::m_granted. */
+  materialize_fast_path_locks();
+
   is_new_ticket= ! has_lock(mdl_svp, mdl_xlock_request.ticket);
 
   /* Merge the acquired and the original lock. @todo: move to a method. */
@@ -2627,7 +2909,10 @@ void MDL_context::release_lock(enum_mdl_duration duration, MDL_ticket *ticket)
 
   DBUG_ASSERT(this == ticket->get_ctx());
 
-  lock->remove_ticket(m_pins, &MDL_lock::m_granted, ticket);
+  if (ticket->m_is_fast_path)
+    lock->fast_path_release(m_pins, mdl_fast_path_increment(ticket->m_type));
+  else
+    lock->remove_ticket(m_pins, &MDL_lock::m_granted, ticket);
 
   m_tickets[duration].remove(ticket);
   MDL_ticket::destroy(ticket);
@@ -2636,6 +2921,41 @@ void MDL_context::release_lock(enum_mdl_duration duration, MDL_ticket *ticket)
 }
 
 
+/**
+  Move the tickets of the locks which were granted to this context on
+  the fast path to MDL_lock::m_granted, so that they are seen by other
+  contexts.
+
+  This is done before the context requests an obtrusive lock, as
+  MDL_lock::can_grant_lock() takes all locks counted on the fast path
+  for the locks of other contexts, and before it waits, so that the
+  deadlock detector finds all loops this context is part of: the locks
+  which are not visible belong to contexts which are not waiting.
+*/
+
+void MDL_context::materialize_fast_path_locks()
+{
+  for (int i= 0; i < MDL_DURATION_END; i++)
+  {
+    Ticket_iterator it(m_tickets[i]);
+    MDL_ticket *ticket;
+
+    while ((ticket= it++))
+    {
+      if (!ticket->m_is_fast_path)
+        continue;
+      MDL_lock *lock= ticket->m_lock;
+      mysql_prlock_wrlock(&lock->m_rwlock);
+      lock->m_granted.add_ticket(ticket);
+      my_atomic_add64(&lock->m_fast_path_state,
+                      -mdl_fast_path_increment(ticket->m_type));
+      mysql_prlock_unlock(&lock->m_rwlock);
+      ticket->m_is_fast_path= false;
+    }
+  }
+}
+
+
 /**
   Release lock with explicit duration.
 
@@ -2740,6 +3060,7 @@ void MDL_ticket::downgrade_lock(enum_mdl_type type)
   m_lock->m_granted.remove_ticket(this);
   m_type= type;
   m_lock->m_granted.add_ticket(this);
+  m_lock->update_has_obtrusive();
   m_lock->reschedule_waiters();
   mysql_prlock_unlock(&m_lock->m_rwlock);
 }
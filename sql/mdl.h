@@ -635,7 +635,8 @@ class MDL_ticket : public MDL_wait_for_subgraph
      m_duration(duration_arg),
 #endif
      m_ctx(ctx_arg),
-     m_lock(NULL)
+     m_lock(NULL),
+     m_is_fast_path(false)
   {}
 
   static MDL_ticket *create(MDL_context *ctx_arg, enum_mdl_type type_arg
@@ -664,6 +665,13 @@ class MDL_ticket : public MDL_wait_for_subgraph
   */
   MDL_lock *m_lock;
 
+  /**
+    TRUE if the lock was granted on the fast path, i.e. it is counted in
+    MDL_lock::m_fast_path_state and the ticket is not in
+    MDL_lock::m_granted. Context private.
+  */
+  bool m_is_fast_path;
+
 private:
   MDL_ticket(const MDL_ticket &);               /* not implemented */
   MDL_ticket &operator=(const MDL_ticket &);    /* not implemented */
@@ -832,6 +840,9 @@ class MDL_context
             will see the new value eventually.
     */
     m_needs_thr_lock_abort= needs_thr_lock_abort;
+    /* Notifications are only sent to owners of locks in m_granted. */
+    if (needs_thr_lock_abort)
+      materialize_fast_path_locks();
   }
   bool get_needs_thr_lock_abort() const
   {
@@ -946,9 +957,12 @@ class MDL_context
 
   bool visit_subgraph(MDL_wait_for_graph_visitor *dvisitor);
 
+  void materialize_fast_path_locks();
+
   /** Inform the deadlock detector there is an edge in the wait-for graph. */
   void will_wait_for(MDL_wait_for_subgraph *waiting_for_arg)
   {
+    materialize_fast_path_locks();
     mysql_prlock_wrlock(&m_LOCK_waiting_for);
     m_waiting_for=  waiting_for_arg;
     mysql_prlock_unlock(&m_LOCK_waiting_for);
@@ -1001,6 +1015,9 @@ extern "C" int thd_is_connected(MYSQL_THD thd);
 */
 extern "C" ulong max_write_lock_count;
 
+/* Grant SR and SW locks on objects without taking MDL_lock::m_rwlock. */
+extern my_bool opt_mdl_fast_path;
+
 extern MYSQL_PLUGIN_IMPORT
 int mdl_iterate(int (*callback)(MDL_ticket *ticket, void *arg), void *arg);
 #endif
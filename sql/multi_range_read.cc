@@ -20,6 +20,12 @@
 #include "key.h"
 #include "sql_statistics.h"
 
+/*
+  The number of index records Mrr_ordered_index_reader::read_key_tuple() reads
+  forward from the match of the previous key before it searches the index
+*/
+#define MRR_READ_FORWARD_RECORDS 4
+
 /****************************************************************************
  * Default MRR implementation (MRR to non-MRR converter)
  ***************************************************************************/
@@ -462,6 +468,7 @@ void Mrr_ordered_index_reader::interrupt_read()
              table->key_info[table->s->primary_key].key_length);
   }
   read_was_interrupted= TRUE;
+  cursor_on_last_key= FALSE;
 
   /* Save the last rowid */
   memcpy(saved_rowid, file->ref, file->ref_length);
@@ -533,6 +540,8 @@ int Mrr_ordered_index_reader::refill_buffer(bool initial)
   
   /* Force get_next() to start with kv_it.init() call: */
   scanning_key_val_iter= FALSE;
+  /* The new key tuples may be less than the last one looked up */
+  cursor_on_last_key= FALSE;
 
   if (source_exhausted && key_buffer->is_empty())
     DBUG_RETURN(HA_ERR_END_OF_FILE);
@@ -568,6 +577,12 @@ int Mrr_ordered_index_reader::init(handler *h_arg, RANGE_SEQ_IF *seq_funcs,
                                       key_info->user_defined_key_parts ==
                                       my_count_bits(keypar.key_tuple_map));
 
+  can_read_forward= keypar.index_ranges_unique &&
+                    (file->ha_table_flags() & HA_FAST_INDEX_NEXT) &&
+                    MY_TEST(file->index_flags(file->active_index, 0, 1) &
+                            HA_READ_ORDER);
+  cursor_on_last_key= FALSE;
+
   mrr_iter= seq_funcs->init(seq_init_param, n_ranges, mode);
   is_mrr_assoc= !MY_TEST(mode & HA_MRR_NO_ASSOCIATION);
   mrr_funcs= *seq_funcs;
@@ -578,6 +593,56 @@ int Mrr_ordered_index_reader::init(handler *h_arg, RANGE_SEQ_IF *seq_funcs,
 }
 
 
+/*
+  @brief Read the index record matching a lookup key tuple
+
+  @param index_tuple  The key tuple to look up
+
+  @details
+    The key tuples are looked up in ascending order. If the index is unique
+    and the cursor is on the match of the previous key tuple, the following
+    MRR_READ_FORWARD_RECORDS index records are read first: when the keys are
+    dense a match, or the proof that there is none, is found this way without
+    a new search from the root of the index, and the engine can use its
+    read-ahead for the following records. Otherwise the index is searched
+    with index_read_map().
+
+  @retval 0                     OK, the match is in table->record[0]
+  @retval HA_ERR_KEY_NOT_FOUND  No match
+  @retval other code            Error
+*/
+
+int Mrr_ordered_index_reader::read_key_tuple(uchar *index_tuple)
+{
+  TABLE *table= file->get_table();
+  int res;
+
+  if (cursor_on_last_key)
+  {
+    KEY_PART_INFO *part= table->key_info[file->active_index].key_part;
+    for (uint i= 0; i < MRR_READ_FORWARD_RECORDS; i++)
+    {
+      if (file->ha_index_next(table->record[0]))
+        break;
+      int cmp= key_cmp(part, index_tuple, keypar.key_tuple_length);
+      if (cmp == 0)
+        return 0;
+      if (cmp > 0)
+      {
+        /* The record may match the next key tuple, it is to be searched */
+        cursor_on_last_key= FALSE;
+        return HA_ERR_KEY_NOT_FOUND;
+      }
+    }
+  }
+
+  res= file->ha_index_read_map(table->record[0], index_tuple,
+                               keypar.key_tuple_map, HA_READ_KEY_EXACT);
+  cursor_on_last_key= !res && can_read_forward;
+  return res;
+}
+
+
 static int rowid_cmp_reverse(void *file, uchar *a, uchar *b)
 {
   return - ((handler*)file)->cmp_ref(a, b);
@@ -1319,10 +1384,7 @@ int Key_value_records_iterator::init(Mrr_ordered_index_reader *owner_arg)
     last_identical_key_ptr= identical_key_it.read_ptr1;
   }
   identical_key_it.init(owner->key_buffer);
-  res= owner->file->ha_index_read_map(owner->file->get_table()->record[0], 
-                                      index_tuple, 
-                                      owner->keypar.key_tuple_map, 
-                                      HA_READ_KEY_EXACT);
+  res= owner->read_key_tuple(index_tuple);
 
   if (res)
   {
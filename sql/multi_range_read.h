@@ -298,6 +298,8 @@ class Mrr_ordered_index_reader : public Mrr_index_reader
 private:
   Key_value_records_iterator kv_it;
 
+  int read_key_tuple(uchar *index_tuple);
+
   bool scanning_key_val_iter;
   
   /* Buffer to store (key, range_id) pairs */
@@ -317,6 +319,20 @@ class Mrr_ordered_index_reader : public Mrr_index_reader
   
   /* TRUE == reached eof when enumerating ranges */
   bool source_exhausted;
+
+  /*
+    TRUE <=> the index is unique and the engine prefers reading it forward
+    with index_next() to searching it (HA_FAST_INDEX_NEXT)
+  */
+  bool can_read_forward;
+
+  /*
+    TRUE <=> the index cursor is on the only match of the last looked up
+    key tuple, and the next key tuple in the buffer is greater than it.
+    Then read_key_tuple() tries to reach the next match with index_next()
+    calls before it searches the index.
+  */
+  bool cursor_on_last_key;
    
   /* 
     Following members are for interrupt_read()/resume_read(). The idea is that 
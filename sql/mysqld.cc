@@ -38,6 +38,7 @@
                           // date_time_format_make
 #include "tztime.h"       // my_tz_free, my_tz_init, my_tz_SYSTEM
 #include "hostname.h"     // hostname_cache_free, hostname_cache_init
+#include "sql_digest_stats.h" // digest_stats_init, digest_stats_free
 #include "sql_acl.h"      // acl_free, grant_free, acl_init,
                           // grant_init
 #include "sql_base.h"
@@ -379,12 +380,16 @@ static longlong start_memory_used;
 bool opt_bin_log, opt_bin_log_used=0, opt_ignore_builtin_innodb= 0;
 bool opt_bin_log_compress;
 uint opt_bin_log_compress_min_len;
+ulong opt_bin_log_compress_algorithm;
+uint net_compression_level;
 my_bool opt_log, debug_assert_if_crashed_table= 0, opt_help= 0;
 my_bool debug_assert_on_not_freed_memory= 0;
 my_bool disable_log_notes, opt_support_flashback= 0;
 static my_bool opt_abort;
 ulonglong log_output_options;
 my_bool opt_userstat_running;
+ulong opt_userstat_merge_interval;
+ulong opt_log_slow_digest_interval, opt_log_slow_buffer_size;
 bool opt_error_log= IF_WIN(1,0);
 bool opt_disable_networking=0, opt_skip_show_db=0;
 bool opt_skip_name_resolve=0;
@@ -469,7 +474,9 @@ my_bool sp_automatic_privileges= 1;
 
 ulong opt_binlog_rows_event_max_size;
 my_bool opt_master_verify_checksum= 0;
+ulong binlog_dump_net_buffer_length;
 my_bool opt_slave_sql_verify_checksum= 1;
+my_bool opt_slave_rows_hash_scan= 0;
 const char *binlog_format_names[]= {"MIXED", "STATEMENT", "ROW", NullS};
 volatile sig_atomic_t calling_initgroups= 0; /**< Used in SIGSEGV handler. */
 uint mysqld_port, select_errors, dropping_tables, ha_open_options;
@@ -520,6 +527,7 @@ ulong transactions_multi_engine;
 ulong rpl_transactions_multi_engine;
 ulong transactions_gtid_foreign_engine;
 ulonglong slave_skipped_errors;
+ulonglong slave_rows_hash_scans;
 ulong feature_files_opened_with_delayed_keys= 0, feature_check_constraint= 0;
 ulonglong denied_connections;
 my_decimal decimal_zero;
@@ -566,6 +574,7 @@ ulong opt_slave_domain_parallel_threads= 0;
 ulong opt_slave_parallel_mode= SLAVE_PARALLEL_CONSERVATIVE;
 ulong opt_binlog_commit_wait_count= 0;
 ulong opt_binlog_commit_wait_usec= 0;
+my_bool opt_binlog_sync_pipeline= 0;
 ulong opt_slave_parallel_max_queued= 131072;
 my_bool opt_gtid_ignore_duplicates= FALSE;
 
@@ -709,6 +718,7 @@ SHOW_COMP_OPTION have_ssl, have_symlink, have_dlopen, have_query_cache;
 SHOW_COMP_OPTION have_geometry, have_rtree_keys;
 SHOW_COMP_OPTION have_crypt, have_compress;
 SHOW_COMP_OPTION have_profiling;
+SHOW_COMP_OPTION have_pcre_jit;
 SHOW_COMP_OPTION have_openssl;
 
 /* Thread specific variables */
@@ -902,6 +912,7 @@ PSI_mutex_key key_LOCK_des_key_file;
 
 PSI_mutex_key key_BINLOG_LOCK_index, key_BINLOG_LOCK_xid_list,
   key_BINLOG_LOCK_binlog_background_thread,
+  key_BINLOG_LOCK_binlog_sync,
   key_LOCK_binlog_end_pos,
   key_delayed_insert_mutex, key_hash_filo_lock, key_LOCK_active_mi,
   key_LOCK_connection_count, key_LOCK_crypt, key_LOCK_delayed_create,
@@ -962,6 +973,7 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_BINLOG_LOCK_index, "MYSQL_BIN_LOG::LOCK_index", 0},
   { &key_BINLOG_LOCK_xid_list, "MYSQL_BIN_LOG::LOCK_xid_list", 0},
   { &key_BINLOG_LOCK_binlog_background_thread, "MYSQL_BIN_LOG::LOCK_binlog_background_thread", 0},
+  { &key_BINLOG_LOCK_binlog_sync, "MYSQL_BIN_LOG::LOCK_binlog_sync", 0},
   { &key_LOCK_binlog_end_pos, "MYSQL_BIN_LOG::LOCK_binlog_end_pos", 0 },
   { &key_RELAYLOG_LOCK_index, "MYSQL_RELAY_LOG::LOCK_index", 0},
   { &key_LOCK_relaylog_end_pos, "MYSQL_RELAY_LOG::LOCK_binlog_end_pos", 0},
@@ -1242,6 +1254,7 @@ void init_net_server_extension(THD *thd)
   thd->m_net_server_extension.m_user_data= thd;
   thd->m_net_server_extension.m_before_header= net_before_header_psi;
   thd->m_net_server_extension.m_after_header= net_after_header_psi;
+  thd->m_net_server_extension.m_compress_stream= NULL;
   /* Activate this private extension for the mysqld server. */
   thd->net.extension= & thd->m_net_server_extension;
 }
@@ -2108,6 +2121,7 @@ void clean_up(bool print_message)
     my_bitmap_free(&slave_error_mask);
 #endif
   stop_handle_manager();
+  stop_slow_log_flush_thread();
   release_ddl_log();
 
   logger.cleanup_base();
@@ -2158,6 +2172,7 @@ void clean_up(bool print_message)
   free_max_user_conn();
   free_global_user_stats();
   free_global_client_stats();
+  digest_stats_free();
   free_global_table_stats();
   free_global_index_stats();
   delete_dynamic(&all_options);                 // This should be empty
@@ -3616,6 +3631,10 @@ static void init_pcre()
   // pcre can underestimate its stack usage. Use a safe value, as in the manual
   set_if_bigger(my_pcre_frame_size, 500);
   my_pcre_frame_size += 16; // Again, safety margin, see the manual
+  int jit;
+  if (pcre_config(PCRE_CONFIG_JIT, &jit))
+    jit= 0;
+  have_pcre_jit= jit ? SHOW_OPTION_YES : SHOW_OPTION_NO;
 }
 
 
@@ -5455,6 +5474,7 @@ static int init_server_components()
   init_update_queries();
   init_global_user_stats();
   init_global_client_stats();
+  digest_stats_init();
   if (!opt_bootstrap)
     servers_init(0);
   init_status_vars();
@@ -5878,6 +5898,7 @@ int mysqld_main(int argc, char **argv)
 
   create_shutdown_event();
   start_handle_manager();
+  start_slow_log_flush_thread();
 
   /* Copy default global rpl_filter to global_rpl_filter */
   copy_filter_setting(global_rpl_filter, get_or_create_rpl_filter("", 0));
@@ -7393,6 +7414,15 @@ static int show_open_tables(THD *thd, SHOW_VAR *var, char *buff,
   return 0;
 }
 
+static int show_table_locks_immediate(THD *thd, SHOW_VAR *var, char *buff,
+                                      enum enum_var_type scope)
+{
+  var->type= SHOW_LONG;
+  var->value= buff;
+  *((long *) buff)= (long) thr_lock_immediate_count();
+  return 0;
+}
+
 static int show_prepared_stmt_count(THD *thd, SHOW_VAR *var, char *buff,
                                     enum enum_var_type scope)
 {
@@ -7730,6 +7760,17 @@ DEF_SHOW_FUNC(net_wait_num, SHOW_LONGLONG)
 DEF_SHOW_FUNC(avg_net_wait_time, SHOW_LONG)
 DEF_SHOW_FUNC(avg_trx_wait_time, SHOW_LONG)
 
+static SHOW_VAR semi_sync_master_trx_wait_histogram_vars[]=
+{
+  {"100us", (char*) &rpl_semi_sync_master_trx_wait_histogram[0], SHOW_LONGLONG},
+  {"1ms",   (char*) &rpl_semi_sync_master_trx_wait_histogram[1], SHOW_LONGLONG},
+  {"10ms",  (char*) &rpl_semi_sync_master_trx_wait_histogram[2], SHOW_LONGLONG},
+  {"100ms", (char*) &rpl_semi_sync_master_trx_wait_histogram[3], SHOW_LONGLONG},
+  {"1s",    (char*) &rpl_semi_sync_master_trx_wait_histogram[4], SHOW_LONGLONG},
+  {"more",  (char*) &rpl_semi_sync_master_trx_wait_histogram[5], SHOW_LONGLONG},
+  {NullS, NullS, SHOW_LONG}
+};
+
 #ifdef HAVE_YASSL
 
 static char *
@@ -7956,6 +7997,7 @@ SHOW_VAR status_vars[]= {
   {"Binlog_cache_use",         (char*) &binlog_cache_use,       SHOW_LONG},
   {"Binlog_stmt_cache_disk_use",(char*) &binlog_stmt_cache_disk_use,  SHOW_LONG},
   {"Binlog_stmt_cache_use",    (char*) &binlog_stmt_cache_use,       SHOW_LONG},
+  {"Buffer_memory_reclaimed",  (char*) offsetof(STATUS_VAR, buffer_memory_reclaimed), SHOW_LONGLONG_STATUS},
   {"Busy_time",                (char*) offsetof(STATUS_VAR, busy_time), SHOW_DOUBLE_STATUS},
   {"Bytes_received",           (char*) offsetof(STATUS_VAR, bytes_received), SHOW_LONGLONG_STATUS},
   {"Bytes_sent",               (char*) offsetof(STATUS_VAR, bytes_sent), SHOW_LONGLONG_STATUS},
@@ -8062,6 +8104,7 @@ SHOW_VAR status_vars[]= {
   {"Rpl_semi_sync_master_tx_wait_time", (char*) &SHOW_FNAME(trx_wait_time), SHOW_FUNC},
   {"Rpl_semi_sync_master_tx_waits", (char*) &SHOW_FNAME(trx_wait_num), SHOW_FUNC},
   {"Rpl_semi_sync_master_tx_avg_wait_time", (char*) &SHOW_FNAME(avg_trx_wait_time), SHOW_FUNC},
+  {"Rpl_semi_sync_master_tx_wait_histogram", (char*) semi_sync_master_trx_wait_histogram_vars, SHOW_ARRAY},
   {"Rpl_semi_sync_master_net_wait_time", (char*) &SHOW_FNAME(net_wait_time), SHOW_FUNC},
   {"Rpl_semi_sync_master_net_waits", (char*) &SHOW_FNAME(net_wait_num), SHOW_FUNC},
   {"Rpl_semi_sync_master_net_avg_wait_time", (char*) &SHOW_FNAME(avg_net_wait_time), SHOW_FUNC},
@@ -8098,6 +8141,7 @@ SHOW_VAR status_vars[]= {
   {"Slave_heartbeat_period",   (char*) &show_heartbeat_period, SHOW_SIMPLE_FUNC},
   {"Slave_received_heartbeats",(char*) &show_slave_received_heartbeats, SHOW_SIMPLE_FUNC},
   {"Slave_retried_transactions",(char*)&slave_retried_transactions, SHOW_LONG},
+  {"Slave_rows_hash_scans",    (char*) &slave_rows_hash_scans,  SHOW_LONGLONG},
   {"Slave_running",            (char*) &show_slave_running,     SHOW_SIMPLE_FUNC},
   {"Slave_skipped_errors",     (char*) &slave_skipped_errors, SHOW_LONGLONG},
 #endif
@@ -8144,7 +8188,7 @@ SHOW_VAR status_vars[]= {
   */
   {"Subquery_cache_hit",       (char*) &subquery_cache_hit,     SHOW_LONG},
   {"Subquery_cache_miss",      (char*) &subquery_cache_miss,    SHOW_LONG},
-  {"Table_locks_immediate",    (char*) &locks_immediate,        SHOW_LONG},
+  {"Table_locks_immediate",    (char*) &show_table_locks_immediate, SHOW_SIMPLE_FUNC},
   {"Table_locks_waited",       (char*) &locks_waited,           SHOW_LONG},
   {"Table_open_cache_active_instances", (char*) &tc_active_instances, SHOW_UINT},
   {"Table_open_cache_hits",    (char*) offsetof(STATUS_VAR, table_open_cache_hits), SHOW_LONGLONG_STATUS},
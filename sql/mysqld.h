@@ -112,6 +112,8 @@ extern MY_BITMAP temp_pool;
 extern bool opt_large_files;
 extern bool opt_update_log, opt_bin_log, opt_error_log, opt_bin_log_compress; 
 extern uint opt_bin_log_compress_min_len;
+extern ulong opt_bin_log_compress_algorithm;
+extern uint net_compression_level;
 extern my_bool opt_log, opt_bootstrap;
 extern my_bool opt_backup_history_log;
 extern my_bool opt_backup_progress_log;
@@ -261,6 +263,7 @@ extern ulong opt_slave_parallel_max_queued;
 extern ulong opt_slave_parallel_mode;
 extern ulong opt_binlog_commit_wait_count;
 extern ulong opt_binlog_commit_wait_usec;
+extern my_bool opt_binlog_sync_pipeline;
 extern my_bool opt_gtid_ignore_duplicates;
 extern ulong back_log;
 extern ulong executed_events;
@@ -324,6 +327,7 @@ extern PSI_mutex_key key_LOCK_des_key_file;
 
 extern PSI_mutex_key key_BINLOG_LOCK_index, key_BINLOG_LOCK_xid_list,
   key_BINLOG_LOCK_binlog_background_thread,
+  key_BINLOG_LOCK_binlog_sync,
   key_LOCK_binlog_end_pos,
   key_delayed_insert_mutex, key_hash_filo_lock, key_LOCK_active_mi,
   key_LOCK_connection_count, key_LOCK_crypt, key_LOCK_delayed_create,
@@ -836,6 +840,8 @@ extern uint extra_connection_count;
 extern uint64 global_gtid_counter;
 extern my_bool opt_gtid_strict_mode;
 extern my_bool opt_userstat_running, debug_assert_if_crashed_table;
+extern ulong opt_userstat_merge_interval;
+extern ulong opt_log_slow_digest_interval, opt_log_slow_buffer_size;
 extern uint mysqld_extra_port;
 extern ulong opt_progress_report_time;
 extern ulong extra_max_connections;
@@ -844,12 +850,16 @@ extern ulong thread_created;
 extern scheduler_functions *thread_scheduler, *extra_thread_scheduler;
 extern char *opt_log_basename;
 extern my_bool opt_master_verify_checksum;
+extern ulong binlog_dump_net_buffer_length;
 extern my_bool opt_stack_trace, disable_log_notes;
 extern my_bool opt_expect_abort;
 extern my_bool opt_slave_sql_verify_checksum;
+extern my_bool opt_slave_rows_hash_scan;
 extern my_bool opt_mysql56_temporal_format, strict_password_validation;
 extern my_bool opt_explicit_defaults_for_timestamp;
 extern ulong binlog_checksum_options;
+extern ulong binlog_gtid_index_span;
+extern ulong binlog_writeset_history_size;
 extern bool max_user_connections_checking;
 extern ulong opt_binlog_dbug_fsync_sleep;
 
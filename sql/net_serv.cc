@@ -46,6 +46,9 @@
 #include <signal.h>
 #include "probes_mysql.h"
 #include "proxy_protocol.h"
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
 
 #ifdef EMBEDDED_LIBRARY
 #undef MYSQL_SERVER
@@ -112,6 +115,7 @@ void sql_print_error(const char *format,...);
 */
 extern ulonglong test_flags;
 extern ulong bytes_sent, bytes_received, net_big_packet_count;
+extern uint net_compression_level;
 #ifdef HAVE_QUERY_CACHE
 #define USE_QUERY_CACHE
 extern void query_cache_insert(void *thd, const char *packet, size_t length,
@@ -191,6 +195,11 @@ void net_end(NET *net)
   DBUG_ENTER("net_end");
   my_free(net->buff);
   net->buff=0;
+#if defined(MYSQL_SERVER) && defined(HAVE_COMPRESS)
+  if (net->extension)
+    my_compress_stream_end(&static_cast<st_net_server*>
+                           (net->extension)->m_compress_stream);
+#endif
   DBUG_VOID_RETURN;
 }
 
@@ -239,6 +248,41 @@ my_bool net_realloc(NET *net, size_t length)
 }
 
 
+/**
+  Shrink the packet buffer to length bytes, if it has grown beyond that.
+
+  This is done only when the buffer holds neither unread nor unsent data.
+  If the smaller buffer cannot be allocated, the old one is kept.
+
+  @return number of bytes freed
+*/
+
+size_t net_shrink(NET *net, size_t length)
+{
+  uchar *buff;
+  size_t pkt_length= (length+IO_SIZE-1) & ~(IO_SIZE-1);
+  size_t freed;
+  DBUG_ENTER("net_shrink");
+
+  if (pkt_length >= net->max_packet || net->remain_in_buf ||
+      net->write_pos != net->buff)
+    DBUG_RETURN(0);
+  DBUG_PRINT("enter",("max_packet: %lu  length: %lu",
+                      net->max_packet, (ulong) pkt_length));
+  if ((buff= (uchar*) my_realloc((char*) net->buff, pkt_length +
+                                 NET_HEADER_SIZE + COMP_HEADER_SIZE + 1,
+                                 MYF(net->thread_specific_malloc ?
+                                     MY_THREAD_SPECIFIC : 0))))
+  {
+    freed= net->max_packet - pkt_length;
+    net->buff= net->write_pos= net->read_pos= buff;
+    net->buff_end= buff+(net->max_packet= (ulong) pkt_length);
+    DBUG_RETURN(freed);
+  }
+  DBUG_RETURN(0);
+}
+
+
 /**
   Check if there is any data to be read from the socket.
 
@@ -551,6 +595,62 @@ net_write_command(NET *net,uchar command,
     1
 */
 
+#if defined(MYSQL_SERVER) && !defined(_WIN32)
+/**
+  Send the data cached in the buffer, followed by a big packet.
+
+  Both are handed to a single vio_writev() call, instead of copying the
+  start of the packet into the buffer and writing them one after another.
+  Whatever that call does not write is sent with net_real_write(), which
+  also handles errors and timeouts.
+
+  @note Not used with compression, which needs the data in one buffer.
+*/
+
+static my_bool
+net_write_buff_and_packet(NET *net, const uchar *packet, size_t len)
+{
+  struct iovec iov[2];
+  size_t buff_len= (size_t) (net->write_pos - net->buff);
+  size_t length, buff_written, packet_written;
+
+  DBUG_ASSERT(!net->compress);
+  net->write_pos= net->buff;
+  if (unlikely(net->error == 2))
+    return 1;                                   /* socket can't be used */
+
+  iov[0].iov_base= net->buff;
+  iov[0].iov_len= buff_len;
+  iov[1].iov_base= (void*) packet;
+  iov[1].iov_len= len;
+  net->reading_or_writing= 2;
+  length= vio_writev(net->vio, iov, 2);
+  net->reading_or_writing= 0;
+  if ((long) length <= 0)
+    length= 0;                  /* Let net_real_write() retry or fail */
+  else
+    update_statistics(thd_increment_bytes_sent(net->thd, length));
+
+  buff_written= MY_MIN(length, buff_len);
+  packet_written= length - buff_written;
+#ifdef USE_QUERY_CACHE
+  if (buff_written)
+    query_cache_insert(net->thd, (char*) net->buff, buff_written,
+                       net->pkt_nr);
+  if (packet_written)
+    query_cache_insert(net->thd, (char*) packet, packet_written,
+                       net->pkt_nr);
+#endif
+  if (buff_written < buff_len &&
+      net_real_write(net, net->buff + buff_written, buff_len - buff_written))
+    return 1;
+  if (packet_written < len)
+    return net_real_write(net, packet + packet_written,
+                          len - packet_written) ? 1 : 0;
+  return 0;
+}
+#endif
+
 static my_bool
 net_write_buff(NET *net, const uchar *packet, size_t len)
 {
@@ -567,6 +667,11 @@ net_write_buff(NET *net, const uchar *packet, size_t len)
   {
     if (net->write_pos != net->buff)
     {
+#if defined(MYSQL_SERVER) && !defined(_WIN32)
+      /* The rest would be written directly, send it with the buffer */
+      if (!net->compress && len - left_length > net->max_packet)
+        return net_write_buff_and_packet(net, packet, len);
+#endif
       /* Fill up already used packet and write it */
       memcpy((char*) net->write_pos,packet,left_length);
       if (net_real_write(net, net->buff, 
@@ -648,11 +753,29 @@ net_real_write(NET *net,const uchar *packet, size_t len)
       net->reading_or_writing= 0;
       DBUG_RETURN(1);
     }
-    memcpy(b+header_length,packet,len);
+#ifdef MYSQL_SERVER
+    struct st_net_server *server_extension=
+      static_cast<st_net_server*> (net->extension);
+    if (server_extension && net->compress != 2)
+    {
+      /* Compress into the packet, reusing the deflate state */
+      if (my_compress_stream(&server_extension->m_compress_stream,
+                             (int) net_compression_level, b+header_length,
+                             packet, &len, &complen))
+      {
+        memcpy(b+header_length,packet,len);
+        complen=0;
+      }
+    }
+    else
+#endif
+    {
+      memcpy(b+header_length,packet,len);
 
-    /* Don't compress error packets (compress == 2) */
-    if (net->compress == 2 || my_compress(b+header_length, &len, &complen))
-      complen=0;
+      /* Don't compress error packets (compress == 2) */
+      if (net->compress == 2 || my_compress(b+header_length, &len, &complen))
+        complen=0;
+    }
     int3store(&b[NET_HEADER_SIZE],complen);
     int3store(b,len);
     b[3]=(uchar) (net->compress_pkt_nr++);
@@ -342,6 +342,7 @@ class TABLE_READ_PLAN;
   class TRP_INDEX_INTERSECT;
   class TRP_INDEX_MERGE;
   class TRP_GROUP_MIN_MAX;
+  class TRP_SKIP_SCAN;
 
 struct st_index_scan_info;
 struct st_ror_scan_info;
@@ -380,6 +381,9 @@ TABLE_READ_PLAN *merge_same_index_scans(PARAM *param, SEL_IMERGE *imerge,
 static
 TRP_GROUP_MIN_MAX *get_best_group_min_max(PARAM *param, SEL_TREE *tree,
                                           double read_time);
+static
+TRP_SKIP_SCAN *get_best_skip_scan(PARAM *param, SEL_TREE *tree,
+                                  double read_time);
 
 #ifndef DBUG_OFF
 static void print_sel_tree(PARAM *param, SEL_TREE *tree, key_map *tree_map,
@@ -2362,6 +2366,26 @@ class TRP_GROUP_MIN_MAX : public TABLE_READ_PLAN
 };
 
 
+/*
+  Plan for a QUICK_SKIP_SCAN_SELECT scan.
+*/
+
+class TRP_SKIP_SCAN : public TABLE_READ_PLAN
+{
+private:
+  SEL_ARG *key; /* Intervals over the second key part of the index */
+  uint index;   /* The index in the table */
+public:
+  TRP_SKIP_SCAN(SEL_ARG *key_arg, uint index_arg)
+   : key(key_arg), index(index_arg)
+  {}
+  virtual ~TRP_SKIP_SCAN() {}                 /* Remove gcc warning */
+
+  QUICK_SELECT_I *make_quick(PARAM *param, bool retrieve_full_rows,
+                             MEM_ROOT *parent_alloc);
+};
+
+
 typedef struct st_index_scan_info
 {
   uint      idx;      /* # of used key in param->keys */
@@ -2649,6 +2673,7 @@ int SQL_SELECT::test_quick_select(THD *thd, key_map keys_to_use,
 
     TABLE_READ_PLAN *best_trp= NULL;
     TRP_GROUP_MIN_MAX *group_trp;
+    TRP_SKIP_SCAN *skip_trp;
     double best_read_time= read_time;
 
     if (cond)
@@ -2668,6 +2693,14 @@ int SQL_SELECT::test_quick_select(THD *thd, key_map keys_to_use,
         if (tree->type != SEL_TREE::KEY && tree->type != SEL_TREE::KEY_SMALLER)
           tree= NULL;
       }
+      if (param.mem_limit_exceeded())
+      {
+        push_warning_printf(thd, Sql_condition::WARN_LEVEL_WARN,
+                            ER_RANGE_OPTIMIZER_MEM_EXCEEDED,
+                            ER_THD(thd, ER_RANGE_OPTIMIZER_MEM_EXCEEDED),
+                            thd->variables.range_optimizer_max_mem_size);
+        tree= NULL;
+      }
     }
 
     /*
@@ -2686,6 +2719,17 @@ int SQL_SELECT::test_quick_select(THD *thd, key_map keys_to_use,
       }
     }
 
+    /*
+      Try to construct a QUICK_SKIP_SCAN_SELECT. This must be done before
+      remove_nonrange_trees() drops the trees it is made from.
+    */
+    if ((skip_trp= get_best_skip_scan(&param, tree, best_read_time)))
+    {
+      set_if_smaller(param.table->quick_condition_rows, skip_trp->records);
+      best_trp= skip_trp;
+      best_read_time= best_trp->read_cost;
+    }
+
     if (tree)
     {
       /*
@@ -7341,6 +7385,8 @@ SEL_TREE *Item_func_in::get_func_mm_tree(RANGE_OPT_PARAM *param,
         {
           tree=  tree_and(param, tree, get_ne_mm_tree(param, field,
                                                       *arg, *arg));
+          if (param->statement_should_be_aborted())
+            DBUG_RETURN(NULL);
         }
       }
     }
@@ -7356,6 +7402,8 @@ SEL_TREE *Item_func_in::get_func_mm_tree(RANGE_OPT_PARAM *param,
       {
         tree= tree_or(param, tree, get_mm_parts(param, field,
                                                 Item_func::EQ_FUNC, *arg));
+        if (param->statement_should_be_aborted())
+          DBUG_RETURN(NULL);
       }
     }
   }
@@ -11187,7 +11235,7 @@ int read_keys_and_merge_scans(THD *thd,
     unique= new Unique(refpos_order_cmp, (void *)file,
                        file->ref_length,
                        (size_t)thd->variables.sortbuff_size,
-		       intersection ? quick_selects.elements : 0);                     
+		       intersection ? quick_selects.elements : 0, true);
     if (!unique)
       goto err;
     *unique_ptr= unique;
@@ -12096,6 +12144,16 @@ QUICK_GROUP_MIN_MAX_SELECT::get_explain(MEM_ROOT *local_alloc)
 }
 
 
+Explain_quick_select*
+QUICK_SKIP_SCAN_SELECT::get_explain(MEM_ROOT *local_alloc)
+{
+  Explain_quick_select *res;
+  if ((res= new (local_alloc) Explain_quick_select(QS_TYPE_SKIP_SCAN)))
+    res->range.set(local_alloc, &head->key_info[index], max_used_key_length);
+  return res;
+}
+
+
 Explain_quick_select*
 QUICK_INDEX_SORT_SELECT::get_explain(MEM_ROOT *local_alloc)
 {
@@ -12353,6 +12411,14 @@ void QUICK_GROUP_MIN_MAX_SELECT::add_used_key_part_to_set()
 }
 
 
+void QUICK_SKIP_SCAN_SELECT::add_used_key_part_to_set()
+{
+  for (uint i= 0; i < used_key_parts; i++)
+    head->field[index_info->key_part[i].field->field_index]->
+      register_field_in_read_map();
+}
+
+
 void QUICK_ROR_INTERSECT_SELECT::add_used_key_part_to_set()
 {
   List_iterator_fast<QUICK_SELECT_WITH_RECORD> it(quick_selects);
@@ -14856,6 +14922,329 @@ void QUICK_GROUP_MIN_MAX_SELECT::add_keys_and_lengths(String *key_names,
 }
 
 
+/*******************************************************************************
+* Implementation of QUICK_SKIP_SCAN_SELECT
+*******************************************************************************/
+
+/*
+  Find the best index skip scan for a query.
+
+  SYNOPSIS
+    get_best_skip_scan()
+    param     Parameter from test_quick_select
+    tree      Range tree constructed by get_mm_tree()
+    read_time Best read time so far (=table/index scan time)
+
+  DESCRIPTION
+    Look for an index (A,B,...) where the range tree has no interval on A
+    and only single-point intervals on B, that is the WHERE clause has
+    B = const or B IN (const,...) but no range condition on A. Such an index
+    can be read with one lookup for every distinct value of A and interval
+    on B, plus one lookup to find the next distinct value of A.
+
+    The number of distinct values of A is taken from the index statistics,
+    so indexes without statistics are not considered. The plan is used
+    only when the optimizer_switch flag skip_scan is on.
+
+  RETURN
+    The best skip scan plan, or NULL if there is none
+*/
+
+static TRP_SKIP_SCAN *
+get_best_skip_scan(PARAM *param, SEL_TREE *tree, double read_time)
+{
+  TABLE *table= param->table;
+  TRP_SKIP_SCAN *read_plan= NULL;
+  const ha_rows table_records= table->stat_records();
+  DBUG_ENTER("get_best_skip_scan");
+
+  if (!optimizer_flag(param->thd, OPTIMIZER_SWITCH_SKIP_SCAN) ||
+      !tree || !table_records)
+    DBUG_RETURN(NULL);
+
+  for (uint idx= 0; idx < param->keys; idx++)
+  {
+    SEL_ARG *key= tree->keys[idx];
+    uint keynr= param->real_keynr[idx];
+    KEY *index_info= table->key_info + keynr;
+    const ulong needed_flags= HA_READ_NEXT | HA_READ_ORDER | HA_READ_RANGE;
+    uint intervals= 0;
+
+    if (!key || key->type != SEL_ARG::KEY_RANGE || key->part != 1 ||
+        (table->file->index_flags(keynr, 1, 1) & needed_flags) !=
+        needed_flags ||
+        (index_info->flags & HA_SPATIAL))
+      continue;
+
+    SEL_ARG *interval;
+    for (interval= key->first(); interval; interval= interval->next)
+    {
+      if (!interval->is_singlepoint())
+        break;
+      intervals++;
+    }
+    if (interval)
+      continue;                        /* Not all intervals are points */
+
+    double prefix_rows= index_info->actual_rec_per_key(0);
+    double point_rows= index_info->actual_rec_per_key(1);
+    if (prefix_rows <= 0 || point_rows <= 0)
+      continue;                        /* No statistics */
+
+    double groups= MY_MAX(rows2double(table_records) / prefix_rows, 1.0);
+    ha_rows rows= (ha_rows) MY_MIN(groups * intervals * point_rows,
+                                   rows2double(table_records));
+    /* A lookup for every interval in a group and one for the next group */
+    uint lookups= (uint) MY_MIN(groups * (intervals + 1), (double) UINT_MAX);
+    double cost;
+    if (table->covering_keys.is_set(keynr))
+      cost= table->file->keyread_time(keynr, lookups, rows);
+    else
+      cost= table->file->read_time(keynr, lookups, rows);
+    cost+= rows2double(rows) / TIME_FOR_COMPARE;
+    DBUG_PRINT("info", ("index %s: groups %g, records %lu, cost %g",
+                        index_info->name.str, groups, (ulong) rows, cost));
+
+    param->possible_keys.set_bit(keynr);
+    if (cost < read_time &&
+        (read_plan= new (param->mem_root) TRP_SKIP_SCAN(key, keynr)))
+    {
+      read_plan->read_cost= cost;
+      read_plan->records= rows;
+      read_time= cost;
+    }
+  }
+  DBUG_RETURN(read_plan);
+}
+
+
+QUICK_SELECT_I *
+TRP_SKIP_SCAN::make_quick(PARAM *param, bool retrieve_full_rows,
+                          MEM_ROOT *parent_alloc)
+{
+  QUICK_SKIP_SCAN_SELECT *quick;
+  DBUG_ENTER("TRP_SKIP_SCAN::make_quick");
+
+  if (!(quick= new QUICK_SKIP_SCAN_SELECT(param->thd, param->table, index,
+                                          read_cost, records)))
+    DBUG_RETURN(NULL);
+
+  for (SEL_ARG *interval= key->first(); interval; interval= interval->next)
+  {
+    if (quick->add_range(param->thd, interval))
+    {
+      delete quick;
+      DBUG_RETURN(NULL);
+    }
+  }
+  DBUG_RETURN(quick);
+}
+
+
+QUICK_SKIP_SCAN_SELECT::QUICK_SKIP_SCAN_SELECT(THD *thd, TABLE *table,
+                                               uint use_index,
+                                               double read_cost_arg,
+                                               ha_rows records_arg)
+  :file(table->file), index_info(table->key_info + use_index),
+   min_key(NULL), max_key(NULL),
+   prefix_len(index_info->key_part[0].store_length),
+   range_len(index_info->key_part[1].store_length),
+   cur_range(0), have_prefix(FALSE), in_range(FALSE)
+{
+  head=       table;
+  index=      use_index;
+  record=     head->record[0];
+  read_time=  read_cost_arg;
+  records=    records_arg;
+  used_key_parts= 2;
+  max_used_key_length= prefix_len + range_len;
+
+  init_sql_alloc(&alloc, "QUICK_SKIP_SCAN_SELECT",
+                 thd->variables.range_alloc_block_size, 0,
+                 MYF(MY_THREAD_SPECIFIC));
+  thd->mem_root= &alloc;
+  my_init_dynamic_array(&ranges, sizeof(QUICK_RANGE*), 16, 16,
+                        MYF(MY_THREAD_SPECIFIC));
+}
+
+
+QUICK_SKIP_SCAN_SELECT::~QUICK_SKIP_SCAN_SELECT()
+{
+  DBUG_ENTER("QUICK_SKIP_SCAN_SELECT::~QUICK_SKIP_SCAN_SELECT");
+  range_end();
+  delete_dynamic(&ranges);              /* ranges are allocated in alloc */
+  free_root(&alloc, MYF(0));
+  DBUG_VOID_RETURN;
+}
+
+
+/*
+  Append a single-point interval over the second key part to the ranges.
+*/
+
+bool QUICK_SKIP_SCAN_SELECT::add_range(THD *thd, SEL_ARG *sel_range)
+{
+  QUICK_RANGE *range;
+  DBUG_ASSERT(sel_range->is_singlepoint());
+  uint range_flag= (sel_range->maybe_null && sel_range->min_value[0]) ?
+                   NULL_RANGE : EQ_RANGE;
+  range= new (&alloc) QUICK_RANGE(thd, sel_range->min_value, range_len,
+                                  make_keypart_map(1),
+                                  sel_range->max_value, range_len,
+                                  make_keypart_map(1), range_flag);
+  if (!range)
+    return TRUE;
+  return insert_dynamic(&ranges, (uchar*) &range);
+}
+
+
+int QUICK_SKIP_SCAN_SELECT::init()
+{
+  if (min_key)                          /* Already initialized. */
+    return 0;
+  /*
+    One byte more than the key, as QUICK_RANGE does, for keys compared with
+    uint3korr().
+  */
+  if (!(min_key= (uchar*) alloc_root(&alloc, max_used_key_length + 1)) ||
+      !(max_key= (uchar*) alloc_root(&alloc, max_used_key_length + 1)))
+    return 1;
+  return 0;
+}
+
+
+int QUICK_SKIP_SCAN_SELECT::reset(void)
+{
+  int result;
+  DBUG_ENTER("QUICK_SKIP_SCAN_SELECT::reset");
+
+  have_prefix= in_range= FALSE;
+  cur_range= 0;
+  if (file->inited == handler::RND && (result= file->ha_rnd_end()))
+    DBUG_RETURN(result);
+  if (file->inited == handler::NONE &&
+      (result= file->ha_index_init(index, 1)))
+  {
+    file->print_error(result, MYF(0));
+    DBUG_RETURN(result);
+  }
+  DBUG_RETURN(0);
+}
+
+
+void QUICK_SKIP_SCAN_SELECT::range_end()
+{
+  if (file->inited != handler::NONE)
+    file->ha_index_or_rnd_end();
+}
+
+
+/*
+  Find the next distinct value of the first key part.
+
+  SYNOPSIS
+    QUICK_SKIP_SCAN_SELECT::next_prefix()
+
+  DESCRIPTION
+    Read the first key of the index, or the first key after the current
+    prefix, and store its first key part in min_key and max_key.
+
+  RETURN
+    0                    on success
+    HA_ERR_END_OF_FILE   if there are no more prefixes
+    other                if some error occurred
+*/
+
+int QUICK_SKIP_SCAN_SELECT::next_prefix()
+{
+  int result;
+  /* The end of the last range must not stop the jump to the next prefix */
+  file->end_range= NULL;
+  if (!have_prefix)
+    result= file->ha_index_first(record);
+  else
+    result= file->ha_index_read_map(record, min_key, make_keypart_map(0),
+                                    HA_READ_AFTER_KEY);
+  if (result)
+    return result == HA_ERR_KEY_NOT_FOUND ? HA_ERR_END_OF_FILE : result;
+  key_copy(min_key, record, index_info, prefix_len);
+  memcpy(max_key, min_key, prefix_len);
+  have_prefix= TRUE;
+  return 0;
+}
+
+
+/*
+  Get the next row of the skip scan.
+
+  DESCRIPTION
+    Read the rows of every range of the second key part, with the current
+    value of the first key part as prefix. When all ranges are read, jump
+    to the next value of the first key part.
+
+  RETURN
+    0                    on success
+    HA_ERR_END_OF_FILE   if returned all keys
+    other                if some error occurred
+*/
+
+int QUICK_SKIP_SCAN_SELECT::get_next()
+{
+  int result;
+  DBUG_ENTER("QUICK_SKIP_SCAN_SELECT::get_next");
+
+  for (;;)
+  {
+    if (in_range)
+    {
+      if ((result= file->read_range_next()) != HA_ERR_END_OF_FILE)
+        DBUG_RETURN(result);
+      in_range= FALSE;
+      cur_range++;
+    }
+    if (!have_prefix || cur_range == ranges.elements)
+    {
+      if ((result= next_prefix()))
+        DBUG_RETURN(result);
+      cur_range= 0;
+    }
+
+    QUICK_RANGE *range;
+    get_dynamic(&ranges, (uchar*) &range, cur_range);
+    memcpy(min_key + prefix_len, range->min_key, range_len);
+    memcpy(max_key + prefix_len, range->max_key, range_len);
+
+    key_range start_key, end_key;
+    start_key.key= min_key;
+    start_key.length= max_used_key_length;
+    start_key.keypart_map= make_prev_keypart_map(2);
+    start_key.flag= HA_READ_KEY_EXACT;
+    end_key.key= max_key;
+    end_key.length= max_used_key_length;
+    end_key.keypart_map= make_prev_keypart_map(2);
+    end_key.flag= HA_READ_AFTER_KEY;
+
+    result= file->read_range_first(&start_key, &end_key,
+                                   MY_TEST(range->flag & EQ_RANGE), TRUE);
+    if (result != HA_ERR_END_OF_FILE)
+    {
+      in_range= !result;
+      DBUG_RETURN(result);
+    }
+    cur_range++;
+  }
+}
+
+
+void QUICK_SKIP_SCAN_SELECT::add_keys_and_lengths(String *key_names,
+                                                  String *used_lengths)
+{
+  bool first= TRUE;
+
+  add_key_and_length(key_names, used_lengths, &first);
+}
+
+
 /* Check whether the number for equality ranges exceeds the set threshold */ 
 
 bool eq_ranges_exceeds_limit(RANGE_SEQ_IF *seq, void *seq_init_param,
@@ -15129,4 +15518,12 @@ void QUICK_GROUP_MIN_MAX_SELECT::dbug_dump(int indent, bool verbose)
   }
 }
 
+
+void QUICK_SKIP_SCAN_SELECT::dbug_dump(int indent, bool verbose)
+{
+  fprintf(DBUG_FILE,
+          "%*squick_skip_scan_select: index %s (%d), %d ranges\n",
+          indent, "", index_info->name.str, index, ranges.elements);
+}
+
 #endif /* !DBUG_OFF */
@@ -664,12 +664,20 @@ class RANGE_OPT_PARAM
   bool force_default_mrr;
   KEY_PART *key[MAX_KEY]; /* First key parts of keys used in the query */
 
+  /* TRUE if range analysis has used more than range_optimizer_max_mem_size */
+  bool mem_limit_exceeded() const
+  {
+    return thd->variables.range_optimizer_max_mem_size &&
+           mem_root->total_alloc > thd->variables.range_optimizer_max_mem_size;
+  }
+
   bool statement_should_be_aborted() const
   {
     return
       thd->is_fatal_error ||
       thd->is_error() ||
-      alloced_sel_args > SEL_ARG::MAX_SEL_ARGS;
+      alloced_sel_args > SEL_ARG::MAX_SEL_ARGS ||
+      mem_limit_exceeded();
   }
 };
 
@@ -926,7 +934,8 @@ class QUICK_SELECT_I
     QS_TYPE_FULLTEXT   = 4,
     QS_TYPE_ROR_INTERSECT = 5,
     QS_TYPE_ROR_UNION = 6,
-    QS_TYPE_GROUP_MIN_MAX = 7
+    QS_TYPE_GROUP_MIN_MAX = 7,
+    QS_TYPE_SKIP_SCAN = 8
   };
 
   /* Get type of this quick select - one of the QS_TYPE_* values */
@@ -1593,6 +1602,59 @@ class QUICK_GROUP_MIN_MAX_SELECT : public QUICK_SELECT_I
 };
 
 
+/*
+  Index skip scan for conditions on the second key part of an index.
+
+  This class reads the rows of queries of the form
+
+       SELECT ... FROM T WHERE B IN (b_1,...,b_n) [AND ...]
+
+  through an index (A,B,...) without a condition on A. For every distinct
+  value of A it reads the rows with the prefix (a, b_i) for every b_i, and
+  then jumps to the next distinct value of A with an index lookup. This is
+  cheaper than a full scan when A has few distinct values.
+
+  The rows are returned in index order. The WHERE condition is not removed
+  and is checked for every returned row.
+*/
+
+class QUICK_SKIP_SCAN_SELECT : public QUICK_SELECT_I
+{
+private:
+  handler * const file;  /* The handler used to get data. */
+  KEY  *index_info;      /* The index chosen for data access */
+  uchar *min_key;        /* Prefix + lower bound of the current range */
+  uchar *max_key;        /* Prefix + upper bound of the current range */
+  const uint prefix_len; /* Length of the first key part */
+  const uint range_len;  /* Length of the second key part */
+  DYNAMIC_ARRAY ranges;  /* Array of range ptrs for the second key part */
+  uint cur_range;        /* Index of the range being read in ranges */
+  bool have_prefix;      /* TRUE if min_key holds the current prefix */
+  bool in_range;         /* TRUE if read_range_next() can be called */
+  int next_prefix();
+public:
+  MEM_ROOT alloc; /* Memory pool for this quick select data. */
+
+  QUICK_SKIP_SCAN_SELECT(THD *thd, TABLE *table, uint use_index,
+                         double read_cost, ha_rows records);
+  ~QUICK_SKIP_SCAN_SELECT();
+  bool add_range(THD *thd, SEL_ARG *sel_range);
+  int init();
+  void need_sorted_output() { /* always do it */ }
+  int reset();
+  int get_next();
+  void range_end();
+  bool reverse_sorted() { return false; }
+  int get_type() { return QS_TYPE_SKIP_SCAN; }
+  void add_keys_and_lengths(String *key_names, String *used_lengths);
+  void add_used_key_part_to_set();
+#ifndef DBUG_OFF
+  void dbug_dump(int indent, bool verbose);
+#endif
+  Explain_quick_select *get_explain(MEM_ROOT *alloc);
+};
+
+
 class QUICK_SELECT_DESC: public QUICK_RANGE_SELECT
 {
 public:
@@ -185,9 +185,28 @@
   with window functions that share the same PARTITION BY list.
 */
 
+/*
+  When the optimizer switch 'split_materialized_cache' is set 'on' the
+  partitions of a split materialized table T are cached: T is not emptied
+  before it is filled for the next values of the pushed equalities, so that
+  the rows of the partitions for several values are kept in T together.
+  This is correct as the partitions are disjoint and the equalities pushed
+  into T are still checked when T is accessed in the embedding select.
+  When T is accessed for the values whose partition is already in T it is
+  not filled at all. If T grows bigger than tmp_memory_table_size all
+  cached partitions are discarded.
+  Only equalities between integer columns are supported, as then equal
+  values have equal images in the cache of the values. The optimizer takes
+  the caching into account when T is expected to fit into memory: T is
+  then materialized at most once for each distinct value of the pushed key.
+*/
+
 #include "mariadb.h"
 #include "sql_select.h"
 
+/* The length of the image of a pushed value in SplM_opt_info::cached_keys */
+#define SPLM_CACHE_KEY_PART_LENGTH (1 + 8)
+
 /* Info on a splitting field */
 struct SplM_field_info
 {
@@ -246,8 +265,20 @@ class SplM_opt_info : public Sql_alloc
   double unsplit_card;
   /* Lastly evaluated execution plan for 'join' with pushed equalities */
   SplM_plan_info *last_plan;
+  /*
+    The values pushed into T by the chosen splitting when the partitions
+    of T are cached (see TABLE::is_split_partition_cached())
+  */
+  List<Item> cache_key_items;
+  /* The images of the values of cache_key_items whose partitions are in T */
+  HASH cached_keys;
+  /* The buffer for the image of the current values of cache_key_items */
+  uchar *cache_key_buff;
+  /* The length of the above image */
+  uint cache_key_length;
 
   SplM_plan_info *find_plan(TABLE *table, uint key, uint parts);
+  bool are_pushed_keys_cacheable(table_map remaining_tables);
 };
 
 
@@ -459,6 +490,7 @@ bool JOIN::check_for_splittable_materialized()
     return false;
 
   spl_opt_info->join= this;
+  my_hash_clear(&spl_opt_info->cached_keys);
   spl_opt_info->tables_usable_for_splitting= 0;
   spl_opt_info->spl_field_cnt= spl_field_cnt;
   spl_opt_info->spl_fields= spl_field;
@@ -809,6 +841,38 @@ SplM_plan_info *SplM_opt_info::find_plan(TABLE *table, uint key, uint parts)
 }
 
 
+/*
+  @brief
+     Check whether the partitions for the pushable equalities can be cached
+
+  @param
+    remaining_tables  used to filter out the equalities that cannot
+                      be pushed.
+
+  @details
+    The partitions of T can be cached if every equality that is pushed
+    into T compares an integer column of T with an integer column of
+    the embedding select.
+*/
+
+bool SplM_opt_info::are_pushed_keys_cacheable(table_map remaining_tables)
+{
+  List_iterator_fast<KEY_FIELD> li(added_key_fields);
+  KEY_FIELD *added_key_field;
+  while ((added_key_field= li++))
+  {
+    if (remaining_tables & added_key_field->val->used_tables())
+      continue;
+    Item_func_eq *eq_item= (Item_func_eq *) (added_key_field->cond);
+    if (added_key_field->val->real_item()->type() != Item::FIELD_ITEM ||
+        added_key_field->val->cmp_type() != INT_RESULT ||
+        eq_item->arguments()[0]->cmp_type() != INT_RESULT)
+      return false;
+  }
+  return true;
+}
+
+
 /*
   @breaf
     Enable/Disable a keyuses that can be used for splitting
@@ -884,6 +948,7 @@ SplM_plan_info * JOIN_TAB::choose_best_splitting(double record_count,
   SplM_plan_info *spl_plan= 0;
   uint best_key= 0;
   uint best_key_parts= 0;
+  double split_count= record_count;
 
   /*
     Check whether there are keys that can be used to join T employing splitting
@@ -987,7 +1052,23 @@ SplM_plan_info * JOIN_TAB::choose_best_splitting(double record_count,
     }
     if (spl_plan)
     {
-      if(record_count * spl_plan->cost < spl_opt_info->unsplit_cost)
+      /*
+        If the partitions of T are cached and T fits into memory, T is
+        materialized at most once for every distinct value of the key
+        used for splitting
+      */
+      if (optimizer_flag(thd, OPTIMIZER_SWITCH_SPLIT_MATERIALIZED_CACHE) &&
+          spl_opt_info->unsplit_card * table->s->reclength <
+            thd->variables.tmp_memory_table_size &&
+          spl_opt_info->are_pushed_keys_cacheable(remaining_tables))
+      {
+        KEY *key_info= spl_plan->table->key_info + spl_plan->key;
+        double distinct_keys= spl_plan->table->stat_records() /
+                              key_info->actual_rec_per_key(spl_plan->parts-1);
+        set_if_bigger(distinct_keys, 1.0);
+        set_if_smaller(split_count, distinct_keys);
+      }
+      if (split_count * spl_plan->cost < spl_opt_info->unsplit_cost)
       {
         /*
           The best plan that employs splitting is cheaper than
@@ -1003,7 +1084,7 @@ SplM_plan_info * JOIN_TAB::choose_best_splitting(double record_count,
   spl_plan= spl_opt_info->last_plan;
   if (spl_plan)
   {
-    startup_cost= record_count * spl_plan->cost;
+    startup_cost= split_count * spl_plan->cost;
     records= (ha_rows) (records * spl_plan->split_sel);
   }
   else
@@ -1028,7 +1109,9 @@ SplM_plan_info * JOIN_TAB::choose_best_splitting(double record_count,
     usable for splitting whose right parts do not depend on any of
     remaining tables can be pushed into join for T.
     The function also marks the select that specifies T as
-    UNCACHEABLE_DEPENDENT_INJECTED.
+    UNCACHEABLE_DEPENDENT_INJECTED. If the optimizer switch
+    'split_materialized_cache' is set 'on' and the partitions of T can be
+    cached the function prepares the cache of the pushed values.
 
   @retval
     false  on success
@@ -1067,10 +1150,128 @@ bool JOIN::inject_best_splitting_cond(table_map remaining_tables)
   st_select_lex_unit *unit= select_lex->master_unit();
   unit->uncacheable|= UNCACHEABLE_DEPENDENT_INJECTED;
 
+  if (optimizer_flag(thd, OPTIMIZER_SWITCH_SPLIT_MATERIALIZED_CACHE) &&
+      select_lex->uncacheable == UNCACHEABLE_DEPENDENT_INJECTED &&
+      unit->uncacheable == UNCACHEABLE_DEPENDENT_INJECTED &&
+      spl_opt_info->are_pushed_keys_cacheable(remaining_tables))
+  {
+    spl_opt_info->cache_key_items.empty();
+    li.rewind();
+    while ((added_key_field= li++))
+    {
+      if (remaining_tables & added_key_field->val->used_tables())
+        continue;
+      if (spl_opt_info->cache_key_items.push_back(added_key_field->val,
+                                                  thd->mem_root))
+        return true;
+    }
+    spl_opt_info->cache_key_length= SPLM_CACHE_KEY_PART_LENGTH *
+                                    spl_opt_info->cache_key_items.elements;
+    if (!(spl_opt_info->cache_key_buff=
+            (uchar *) thd->alloc(spl_opt_info->cache_key_length)) ||
+        my_hash_init(&spl_opt_info->cached_keys, &my_charset_bin, 32, 0,
+                     spl_opt_info->cache_key_length, NULL, my_free, 0))
+      return true;
+  }
+
+  return false;
+}
+
+
+/**
+  @brief
+    Check whether the partition of this split materialized table is cached
+
+  @details
+    The function is called for a split materialized table T whose
+    partitions are cached before T is filled for the current values of
+    the equalities pushed into T. If the partition for these values is
+    already in T the function returns true and T is not to be filled.
+    Otherwise the values are added to the cache and T is to be filled
+    without being emptied. If T has become too big for the memory all
+    its rows are deleted and the cache is emptied before this.
+    If anything fails the caching is switched off for T, so that T is
+    emptied before it is filled as without caching.
+
+  @retval
+    true   if the partition for the current values is in T
+    false  otherwise
+*/
+
+bool TABLE::is_split_partition_cached()
+{
+  SplM_opt_info *spl_info= spl_opt_info;
+  uchar *key, *pos, *rec;
+  Item *item;
+  if (!caches_split_partitions())
+    return false;
+
+  key= pos= spl_info->cache_key_buff;
+  List_iterator_fast<Item> li(spl_info->cache_key_items);
+  while ((item= li++))
+  {
+    longlong val= item->val_int();
+    pos[0]= (uchar) item->null_value;
+    int8store(pos + 1, item->null_value ? 0 : val);
+    pos+= SPLM_CACHE_KEY_PART_LENGTH;
+  }
+
+  if (!pos_in_table_list->get_unit()->executed)
+    my_hash_reset(&spl_info->cached_keys);          // T is empty yet
+  else if (my_hash_search(&spl_info->cached_keys, key,
+                          spl_info->cache_key_length))
+    return true;
+  else
+  {
+    file->info(HA_STATUS_VARIABLE);
+    if ((ulonglong) file->stats.records * s->reclength >=
+        in_use->variables.tmp_memory_table_size)
+    {
+      my_hash_reset(&spl_info->cached_keys);
+      if (file->ha_delete_all_rows())
+        goto err;
+    }
+  }
+
+  if (!(rec= (uchar *) my_memdup(key, spl_info->cache_key_length,
+                                 MYF(MY_WME))))
+    goto err;
+  if (my_hash_insert(&spl_info->cached_keys, rec))
+  {
+    my_free(rec);
+    goto err;
+  }
+  return false;
+
+err:
+  my_hash_free(&spl_info->cached_keys);
   return false;
 }
 
 
+/*
+  @brief
+    Check whether the partitions of this split materialized table are cached
+*/
+
+bool TABLE::caches_split_partitions()
+{
+  return spl_opt_info && my_hash_inited(&spl_opt_info->cached_keys);
+}
+
+
+/*
+  @brief
+    Free the cache of the partitions of the table materialized by this join
+*/
+
+void JOIN::free_split_partition_cache()
+{
+  if (spl_opt_info)
+    my_hash_free(&spl_opt_info->cached_keys);
+}
+
+
 /**
   @brief
     Fix the splitting chosen for a splittable table in the final query plan
@@ -207,6 +207,29 @@ bool net_send_error(THD *thd, uint sql_errno, const char *err,
 */
 
 #ifndef EMBEDDED_LIBRARY
+/**
+  Flush the result of a command to the client.
+
+  If the client has already sent the next command, without waiting for
+  this result, the results of these pipelined commands are sent in full
+  TCP segments until the last one.
+*/
+
+static bool net_flush_result(NET *net)
+{
+  Vio *vio= net->vio;
+  bool pipelined= vio && vio->has_data(vio);
+  bool error;
+
+  if (pipelined)
+    vio_cork(vio, TRUE);
+  error= net_flush(net);
+  if (!pipelined && vio && vio->corked)
+    vio_cork(vio, FALSE);
+  return error;
+}
+
+
 bool
 net_send_ok(THD *thd,
             uint server_status, uint statement_warn_count,
@@ -286,7 +309,7 @@ net_send_ok(THD *thd,
 
   error= my_net_write(net, (const unsigned char*)store.ptr(), store.length());
   if (likely(!error) && (!skip_flush || is_eof))
-    error= net_flush(net);
+    error= net_flush_result(net);
 
   thd->server_status&= ~SERVER_SESSION_STATE_CHANGED;
 
@@ -350,7 +373,7 @@ net_send_eof(THD *thd, uint server_status, uint statement_warn_count)
     thd->get_stmt_da()->set_overwrite_status(true);
     error= write_eof_packet(thd, net, server_status, statement_warn_count);
     if (likely(!error))
-      error= net_flush(net);
+      error= net_flush_result(net);
     thd->get_stmt_da()->set_overwrite_status(false);
     DBUG_PRINT("info", ("EOF sent, so no more error sending allowed"));
   }
@@ -0,0 +1,402 @@
+/*
+   Copyright (c) 2018 MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/*
+  This file contains the implementation of rowid filters built from range
+  scans, see rowid_filter.h for the description of the technique.
+*/
+
+#include "mariadb.h"
+#include "sql_select.h"
+#include "opt_range.h"
+#include "rowid_filter.h"
+
+
+Range_rowid_filter::Range_rowid_filter(TABLE *tab, SQL_SELECT *sel, uint key,
+                                       ha_rows est_elements_arg,
+                                       double selectivity_arg,
+                                       size_t max_size)
+  :table(tab), select(sel), array(NULL), elem_size(tab->file->ref_length),
+   max_elements(max_size / tab->file->ref_length), elements(0),
+   built(FALSE), usable(FALSE), tracker(NULL),
+   key_no(key), est_elements(est_elements_arg),
+   selectivity(selectivity_arg)
+{}
+
+
+Range_rowid_filter::~Range_rowid_filter()
+{
+  delete select;
+  my_free(array);
+}
+
+
+static int rowid_cmp(void *elem_size, const void *a, const void *b)
+{
+  return memcmp(a, b, *(uint *) elem_size);
+}
+
+
+/**
+  @brief
+    Fill the filter with the rowids of the rows in the range of key_no
+
+  @details
+    The range is read as an index-only scan. The array of rowids is sorted
+    so that check() can do a binary search. If the range turns out to have
+    more rows than @@max_rowid_filter_size allows, the filter is left
+    unusable and the table is read as if no filter had been chosen.
+
+  @retval
+    FALSE  OK
+  @retval
+    TRUE   Error
+*/
+
+bool Range_rowid_filter::build(THD *thd)
+{
+  handler *file= table->file;
+  QUICK_RANGE_SELECT *quick= (QUICK_RANGE_SELECT *) select->quick;
+  MY_BITMAP *save_read_set= table->read_set;
+  MY_BITMAP *save_write_set= table->write_set;
+  bool save_in_range_check_pushed_down= file->in_range_check_pushed_down;
+  int error;
+  DBUG_ENTER("Range_rowid_filter::build");
+
+  built= TRUE;
+  if (!(array= (uchar *) my_malloc(max_elements * elem_size,
+                                   MYF(MY_THREAD_SPECIFIC))))
+    DBUG_RETURN(FALSE);                         /* Just don't use the filter */
+
+  if (file->inited != handler::NONE)
+    file->ha_index_or_rnd_end();
+
+  /*
+    We are going to read just rowids. The columns of key_no are needed too,
+    for the checks of the range bounds.
+  */
+  bitmap_clear_all(&table->tmp_set);
+  table->column_bitmaps_set(&table->tmp_set, &table->tmp_set);
+  table->mark_columns_used_by_index_no_reset(key_no, &table->tmp_set);
+  table->mark_columns_used_by_index_no_reset(table->s->primary_key,
+                                             &table->tmp_set);
+  file->column_bitmaps_signal();
+  file->ha_start_keyread(key_no);
+  /* Read the range with this handler, not with a DS-MRR clone */
+  quick->mrr_flags|= HA_MRR_USE_DEFAULT_IMPL;
+  /*
+    A condition pushed for the index of the JOIN_TAB doesn't check the
+    bounds of this range
+  */
+  file->in_range_check_pushed_down= FALSE;
+
+  usable= TRUE;
+  if (!(error= quick->init()) && !(error= quick->reset()))
+  {
+    while (!(error= quick->get_next()))
+    {
+      /* The join execution will notice the kill by itself */
+      if (unlikely(thd->check_killed()) || elements == max_elements)
+      {
+        usable= FALSE;
+        break;
+      }
+      file->position(table->record[0]);
+      memcpy(array + elements * elem_size, file->ref, elem_size);
+      elements++;
+    }
+  }
+  quick->range_end();
+  file->ha_end_keyread();
+  file->in_range_check_pushed_down= save_in_range_check_pushed_down;
+  table->column_bitmaps_set(save_read_set, save_write_set);
+
+  if (error && error != HA_ERR_END_OF_FILE && usable)
+  {
+    usable= FALSE;
+    if (!thd->is_error())
+      file->print_error(error, MYF(0));
+    DBUG_RETURN(TRUE);
+  }
+
+  /* The range scan is not needed anymore */
+  delete select;
+  select= NULL;
+
+  if (!usable)
+  {
+    my_free(array);
+    array= NULL;
+    DBUG_RETURN(FALSE);
+  }
+
+  my_qsort2(array, elements, elem_size, (qsort2_cmp) rowid_cmp, &elem_size);
+  if (tracker)
+    tracker->on_build(elements);
+  DBUG_PRINT("info", ("rowid filter on %s: %lu elements",
+                      table->key_info[key_no].name.str, (ulong) elements));
+  DBUG_RETURN(FALSE);
+}
+
+
+/**
+  Check whether the given rowid is in the filter
+*/
+
+bool Range_rowid_filter::check(const uchar *rowid)
+{
+  size_t lo= 0, hi= elements;
+  bool found= FALSE;
+  while (lo < hi)
+  {
+    size_t mid= lo + (hi - lo) / 2;
+    int cmp= memcmp(array + mid * elem_size, rowid, elem_size);
+    if (cmp == 0)
+    {
+      found= TRUE;
+      break;
+    }
+    if (cmp < 0)
+      lo= mid + 1;
+    else
+      hi= mid;
+  }
+  if (tracker)
+    tracker->on_lookup(found);
+  return found;
+}
+
+
+/*
+  Cost of one lookup of a full row by its rowid, in the units of
+  handler::read_time()
+*/
+#define ROWID_FILTER_ROW_LOOKUP_COST 1.0
+
+/**
+  @brief
+    Get the index used by a JOIN_TAB that a rowid filter could be applied to
+
+  @retval
+    MAX_KEY  A filter cannot be used with the access method of the JOIN_TAB
+*/
+
+static uint rowid_filter_access_key(JOIN_TAB *tab)
+{
+  TABLE *table= tab->table;
+  uint key;
+
+  if (tab->cache || tab->filesort || tab->bush_children)
+    return MAX_KEY;
+  if (tab->type == JT_REF || tab->type == JT_EQ_REF)
+    key= tab->ref.key;
+  else if (tab->type == JT_ALL && tab->select && tab->select->quick &&
+           tab->use_quick != 2 &&
+           tab->select->quick->get_type() == QUICK_SELECT_I::QS_TYPE_RANGE)
+    key= tab->select->quick->index;
+  else
+    return MAX_KEY;
+
+  /* An index-only scan doesn't fetch full rows, there is nothing to save */
+  if (table->covering_keys.is_set(key) && !table->no_keyread)
+    return MAX_KEY;
+  /* The filter is only checked for secondary index tuples */
+  if (key == table->s->primary_key && table->file->primary_key_is_clustered())
+    return MAX_KEY;
+  return key;
+}
+
+
+/**
+  @brief
+    Choose the cheapest rowid filter for a JOIN_TAB, if any pays off
+
+  @details
+    A filter built from a range over index B saves a row lookup for every
+    row read by the access method of the JOIN_TAB that is not in the range.
+    This is weighed against the cost of the index-only scan of the range,
+    of sorting the collected rowids and of a lookup in the filter for every
+    row read by the JOIN_TAB.
+
+  @retval
+    FALSE  OK
+  @retval
+    TRUE   Error
+*/
+
+static bool make_range_rowid_filter(JOIN *join, JOIN_TAB *tab, uint access_key)
+{
+  THD *thd= join->thd;
+  TABLE *table= tab->table;
+  handler *file= table->file;
+  size_t max_size= thd->variables.max_rowid_filter_size;
+  double records= rows2double(table->stat_records());
+  double accessed= tab->partial_join_cardinality;
+  double best_gain= 0;
+  uint best_key= MAX_KEY;
+  DBUG_ENTER("make_range_rowid_filter");
+
+  if (records < 1 || accessed < 1)
+    DBUG_RETURN(FALSE);
+
+  key_map::Iterator it(table->quick_keys);
+  uint key;
+  while ((key= it++) != key_map::Iterator::BITMAP_END)
+  {
+    if (key == access_key ||
+        (key == table->s->primary_key && file->primary_key_is_clustered()) ||
+        !(file->index_flags(key, 0, 1) & HA_KEYREAD_ONLY))
+      continue;
+
+    double rows= rows2double(table->quick_rows[key]);
+    if (rows < 1 || rows * file->ref_length > max_size)
+      continue;
+    double selectivity= MY_MIN(rows / records, 1.0);
+    double log_rows= log(rows + 1) / M_LN2;
+    double build_cost= file->keyread_time(key, table->quick_n_ranges[key],
+                                          table->quick_rows[key]) +
+                       rows * log_rows / TIME_FOR_COMPARE_ROWID;
+    double check_cost= accessed * log_rows / TIME_FOR_COMPARE_ROWID;
+    double gain= accessed * (1 - selectivity) * ROWID_FILTER_ROW_LOOKUP_COST -
+                 build_cost - check_cost;
+    if (gain > best_gain)
+    {
+      best_gain= gain;
+      best_key= key;
+    }
+  }
+
+  if (best_key == MAX_KEY)
+    DBUG_RETURN(FALSE);
+
+  /*
+    The range analysis that found the range over best_key ran in
+    make_join_statistics(), and only the estimates are left from it.
+    Redo it for best_key alone to get the range scan that fills the filter.
+  */
+  int error;
+  SQL_SELECT *select= make_select(table, join->const_table_map,
+                                  join->const_table_map,
+                                  *get_sargable_cond(join, table),
+                                  (SORT_INFO*) 0, 1, &error);
+  if (!select)
+    DBUG_RETURN(MY_TEST(error));
+  key_map keys;
+  keys.clear_all();
+  keys.set_bit(best_key);
+  if (select->test_quick_select(thd, keys, (table_map) 0, HA_POS_ERROR,
+                                TRUE, FALSE, FALSE) <= 0 ||
+      select->quick->get_type() != QUICK_SELECT_I::QS_TYPE_RANGE ||
+      select->quick->index != best_key)
+  {
+    delete select;
+    DBUG_RETURN(thd->is_fatal_error);
+  }
+
+  ha_rows rows= table->quick_rows[best_key];
+  if (!(tab->rowid_filter=
+        new Range_rowid_filter(table, select, best_key, rows,
+                               MY_MIN(rows2double(rows) / records, 1.0),
+                               max_size)))
+  {
+    delete select;
+    DBUG_RETURN(TRUE);
+  }
+  DBUG_RETURN(FALSE);
+}
+
+
+/**
+  @brief
+    Choose rowid filters for the tables of the join
+
+  @details
+    This is done after the join order and the access methods have been
+    chosen, since the benefit of a filter depends on how many rows the
+    access method of a table reads in the chosen plan. Filters are only
+    pushed to engines that support HA_DO_RANGE_FILTER_PUSHDOWN.
+
+  @retval
+    FALSE  OK
+  @retval
+    TRUE   Error
+*/
+
+bool JOIN::make_range_rowid_filters()
+{
+  DBUG_ENTER("JOIN::make_range_rowid_filters");
+
+  if (!thd->variables.max_rowid_filter_size ||
+      select_lex->uncacheable ||
+      thd->lex->sql_command == SQLCOM_UPDATE_MULTI ||
+      thd->lex->sql_command == SQLCOM_DELETE_MULTI)
+    DBUG_RETURN(FALSE);
+
+  for (JOIN_TAB *tab= first_linear_tab(this, WITH_BUSH_ROOTS,
+                                       WITHOUT_CONST_TABLES);
+       tab;
+       tab= next_linear_tab(this, tab, WITH_BUSH_ROOTS))
+  {
+    TABLE *table= tab->table;
+    uint access_key;
+    if (!table || tab->rowid_filter || table->s->primary_key == MAX_KEY ||
+        !(table->file->ha_table_flags() & HA_DO_RANGE_FILTER_PUSHDOWN) ||
+        table->quick_keys.is_clear_all() ||
+        (access_key= rowid_filter_access_key(tab)) == MAX_KEY)
+      continue;
+
+    /* The rowid must be equal to the image of the primary key columns */
+    KEY *pk= table->key_info + table->s->primary_key;
+    KEY_PART_INFO *key_part= pk->key_part;
+    KEY_PART_INFO *key_part_end= key_part + pk->user_defined_key_parts;
+    for (; key_part < key_part_end; key_part++)
+    {
+      if (key_part->key_part_flag & HA_PART_KEY_SEG)
+        break;
+    }
+    if (key_part < key_part_end)
+      continue;
+
+    if (make_range_rowid_filter(this, tab, access_key))
+      DBUG_RETURN(TRUE);
+  }
+  DBUG_RETURN(FALSE);
+}
+
+
+/**
+  @brief
+    Fill the rowid filter of the JOIN_TAB and push it to the engine
+
+  @details
+    This is done on the first access to the table. If the filter cannot be
+    filled or the engine doesn't take it, the table is read without it.
+
+  @retval
+    FALSE  OK
+  @retval
+    TRUE   Error
+*/
+
+bool JOIN_TAB::build_range_rowid_filter()
+{
+  DBUG_ENTER("JOIN_TAB::build_range_rowid_filter");
+  if (rowid_filter->build(join->thd))
+    DBUG_RETURN(TRUE);
+  if (rowid_filter->is_usable())
+    table->file->rowid_filter_push(rowid_filter);
+  DBUG_RETURN(FALSE);
+}
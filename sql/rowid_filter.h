@@ -0,0 +1,88 @@
+/*
+   Copyright (c) 2018 MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef ROWID_FILTER_INCLUDED
+#define ROWID_FILTER_INCLUDED
+
+/*
+  Rowid filters
+
+  Consider a query
+
+    SELECT * FROM t1 WHERE t1.a BETWEEN 10 AND 20 AND t1.b < 100
+
+  with secondary indexes on both t1.a and t1.b, where the optimizer picks
+  a range scan over idx(a). For every index tuple with a matching 'a' the
+  full row is fetched and only then the condition on 'b' discards it.
+
+  If the range "t1.b < 100" is cheap to scan in idx(b) and selective, it
+  pays off to first collect the rowids of all rows in that range into an
+  in-memory sorted array (a rowid filter), and then, while scanning
+  idx(a), to look up the rowid of every index tuple in the filter before
+  the full row is fetched. Rows whose rowid is not in the filter cannot
+  satisfy the WHERE condition and are skipped without a row lookup.
+
+  The engine checks the filter in the same place where it checks a pushed
+  index condition, see handler_index_cond_check(). Engines announce the
+  support with HA_DO_RANGE_FILTER_PUSHDOWN and accept a filter in
+  handler::rowid_filter_push().
+
+  Whether a filter is used for a JOIN_TAB is decided after the join order
+  has been chosen, see JOIN::make_range_rowid_filters(). The filter is
+  filled lazily on the first access to the table. Filters are disabled
+  when @@max_rowid_filter_size is 0.
+*/
+
+class SQL_SELECT;
+class Rowid_filter_tracker;
+
+class Range_rowid_filter : public Sql_alloc
+{
+  TABLE *table;
+  /* The range scan over key_no that fills the filter */
+  SQL_SELECT *select;
+  /* Sorted array of rowids, elem_size bytes each */
+  uchar *array;
+  uint elem_size;
+  size_t max_elements;
+  size_t elements;
+  bool built;
+  /* FALSE if the filter could not be filled and must not be used */
+  bool usable;
+  Rowid_filter_tracker *tracker;
+
+public:
+  /* The index whose range scan fills the filter */
+  const uint key_no;
+  /* Expected number of rowids in the filter and its selectivity */
+  const ha_rows est_elements;
+  const double selectivity;
+
+  Range_rowid_filter(TABLE *tab, SQL_SELECT *sel, uint key,
+                     ha_rows est_elements_arg, double selectivity_arg,
+                     size_t max_size);
+  ~Range_rowid_filter();
+
+  bool build(THD *thd);
+  bool check(const uchar *rowid);
+
+  bool is_built() const { return built; }
+  bool is_usable() const { return usable; }
+  void set_tracker(Rowid_filter_tracker *tracker_arg)
+  { tracker= tracker_arg; }
+};
+
+#endif /* ROWID_FILTER_INCLUDED */
@@ -47,6 +47,8 @@ ulonglong rpl_semi_sync_master_net_wait_num = 0;
 ulong rpl_semi_sync_master_clients          = 0;
 ulonglong rpl_semi_sync_master_net_wait_time = 0;
 ulonglong rpl_semi_sync_master_trx_wait_time = 0;
+ulonglong
+  rpl_semi_sync_master_trx_wait_histogram[SEMI_SYNC_WAIT_HISTOGRAM_SIZE];
 
 Repl_semi_sync_master repl_semisync_master;
 Ack_receiver ack_receiver;
@@ -337,6 +339,7 @@ int Active_tranx::clear_active_tranx_nodes(const char *log_file_name,
 Repl_semi_sync_master::Repl_semi_sync_master()
   : m_active_tranxs(NULL),
     m_init_done(false),
+    m_waiters(NULL),
     m_reply_file_name_inited(false),
     m_reply_file_pos(0L),
     m_wait_file_name_inited(false),
@@ -364,8 +367,6 @@ int Repl_semi_sync_master::init_object()
   /* Mutex initialization can only be done after MY_INIT(). */
   mysql_mutex_init(key_LOCK_binlog,
                    &LOCK_binlog, MY_MUTEX_INIT_FAST);
-  mysql_cond_init(key_COND_binlog_send,
-                  &COND_binlog_send, NULL);
 
   if (rpl_semi_sync_master_enabled)
   {
@@ -454,7 +455,6 @@ void Repl_semi_sync_master::cleanup()
   if (m_init_done)
   {
     mysql_mutex_destroy(&LOCK_binlog);
-    mysql_cond_destroy(&COND_binlog_send);
     m_init_done= 0;
   }
 
@@ -471,23 +471,70 @@ void Repl_semi_sync_master::unlock()
   mysql_mutex_unlock(&LOCK_binlog);
 }
 
+/* Wake up all waiting threads. Must be called under LOCK_binlog. */
 void Repl_semi_sync_master::cond_broadcast()
 {
-  mysql_cond_broadcast(&COND_binlog_send);
+  mysql_mutex_assert_owner(&LOCK_binlog);
+  for (Semi_sync_waiter *waiter= m_waiters; waiter; waiter= waiter->next)
+    mysql_cond_signal(&waiter->cond);
 }
 
-int Repl_semi_sync_master::cond_timewait(struct timespec *wait_time)
+int Repl_semi_sync_master::cond_timewait(Semi_sync_waiter *waiter,
+                                         struct timespec *wait_time)
 {
   int wait_res;
 
   DBUG_ENTER("Repl_semi_sync_master::cond_timewait()");
 
-  wait_res= mysql_cond_timedwait(&COND_binlog_send,
+  wait_res= mysql_cond_timedwait(&waiter->cond,
                                  &LOCK_binlog, wait_time);
 
   DBUG_RETURN(wait_res);
 }
 
+void Repl_semi_sync_master::add_waiter(Semi_sync_waiter *waiter)
+{
+  mysql_mutex_assert_owner(&LOCK_binlog);
+  if ((waiter->next= m_waiters))
+    m_waiters->prev= &waiter->next;
+  waiter->prev= &m_waiters;
+  m_waiters= waiter;
+}
+
+void Repl_semi_sync_master::remove_waiter(Semi_sync_waiter *waiter)
+{
+  mysql_mutex_assert_owner(&LOCK_binlog);
+  if ((*waiter->prev= waiter->next))
+    waiter->next->prev= waiter->prev;
+}
+
+/*
+  Wake up the threads waiting for positions up to the reply position, and
+  set the wait position to the smallest position of the others, which
+  stay asleep. Must be called under LOCK_binlog.
+*/
+void Repl_semi_sync_master::signal_waiters()
+{
+  mysql_mutex_assert_owner(&LOCK_binlog);
+  m_wait_file_name_inited= false;
+  for (Semi_sync_waiter *waiter= m_waiters; waiter; waiter= waiter->next)
+  {
+    if (Active_tranx::compare(m_reply_file_name, m_reply_file_pos,
+                              waiter->log_file_name,
+                              waiter->log_file_pos) >= 0)
+      mysql_cond_signal(&waiter->cond);
+    else if (!m_wait_file_name_inited ||
+             Active_tranx::compare(waiter->log_file_name,
+                                   waiter->log_file_pos,
+                                   m_wait_file_name, m_wait_file_pos) < 0)
+    {
+      strmake_buf(m_wait_file_name, waiter->log_file_name);
+      m_wait_file_pos= waiter->log_file_pos;
+      m_wait_file_name_inited= true;
+    }
+  }
+}
+
 void Repl_semi_sync_master::add_slave()
 {
   lock();
@@ -567,7 +614,6 @@ int Repl_semi_sync_master::report_reply_binlog(uint32 server_id,
                                                my_off_t log_file_pos)
 {
   int   cmp;
-  bool  can_release_threads = false;
   bool  need_copy_send_pos = true;
 
   DBUG_ENTER("Repl_semi_sync_master::report_reply_binlog");
@@ -636,24 +682,17 @@ int Repl_semi_sync_master::report_reply_binlog(uint32 server_id,
     if (cmp >= 0)
     {
       /* Yes, at least one waiting thread can now proceed:
-       * let us release all waiting threads with a broadcast
+       * let us release the threads waiting up to the reply position.
        */
-      can_release_threads = true;
-      m_wait_file_name_inited = false;
+      DBUG_PRINT("semisync", ("%s: signal waiting threads.",
+                              "Repl_semi_sync_master::report_reply_binlog"));
+      signal_waiters();
     }
   }
 
  l_end:
   unlock();
 
-  if (can_release_threads)
-  {
-    DBUG_PRINT("semisync", ("%s: signal all waiting threads.",
-                            "Repl_semi_sync_master::report_reply_binlog"));
-
-    cond_broadcast();
-  }
-
   DBUG_RETURN(0);
 }
 
@@ -788,15 +827,20 @@ int Repl_semi_sync_master::commit_trx(const char* trx_wait_binlog_name,
     int wait_result;
     PSI_stage_info old_stage;
     THD *thd= current_thd;
+    Semi_sync_waiter waiter;
 
     set_timespec(start_ts, 0);
+    waiter.log_file_name= trx_wait_binlog_name;
+    waiter.log_file_pos= trx_wait_binlog_pos;
+    mysql_cond_init(key_COND_binlog_send, &waiter.cond, NULL);
 
     DEBUG_SYNC(thd, "rpl_semisync_master_commit_trx_before_lock");
     /* Acquire the mutex. */
     lock();
+    add_waiter(&waiter);
 
     /* This must be called after acquired the lock */
-    THD_ENTER_COND(thd, &COND_binlog_send, &LOCK_binlog,
+    THD_ENTER_COND(thd, &waiter.cond, &LOCK_binlog,
                    & stage_waiting_for_semi_sync_ack_from_slave,
                    & old_stage);
 
@@ -882,7 +926,7 @@ int Repl_semi_sync_master::commit_trx(const char* trx_wait_binlog_name,
                               m_wait_timeout,
                               m_wait_file_name, (ulong)m_wait_file_pos));
 
-      wait_result = cond_timewait(&abstime);
+      wait_result = cond_timewait(&waiter, &abstime);
       rpl_semi_sync_master_wait_sessions--;
 
       if (wait_result != 0)
@@ -912,8 +956,13 @@ int Repl_semi_sync_master::commit_trx(const char* trx_wait_binlog_name,
         }
         else
         {
+          uint bucket= 0;
+          for (long limit= 100; bucket < SEMI_SYNC_WAIT_HISTOGRAM_SIZE - 1 &&
+                                wait_time >= limit; limit*= 10)
+            bucket++;
           rpl_semi_sync_master_trx_wait_num++;
           rpl_semi_sync_master_trx_wait_time += wait_time;
+          rpl_semi_sync_master_trx_wait_histogram[bucket]++;
         }
       }
     }
@@ -935,9 +984,11 @@ int Repl_semi_sync_master::commit_trx(const char* trx_wait_binlog_name,
     else
       rpl_semi_sync_master_no_transactions++;
 
+    remove_waiter(&waiter);
     /* The lock held will be released by thd_exit_cond, so no need to
        call unlock() here */
     THD_EXIT_COND(thd, &old_stage);
+    mysql_cond_destroy(&waiter.cond);
   }
 
   DBUG_RETURN(0);
@@ -1270,6 +1321,8 @@ int Repl_semi_sync_master::after_reset_master()
   rpl_semi_sync_master_wait_pos_backtraverse = 0;
   rpl_semi_sync_master_trx_wait_num = 0;
   rpl_semi_sync_master_trx_wait_time = 0;
+  bzero(rpl_semi_sync_master_trx_wait_histogram,
+        sizeof(rpl_semi_sync_master_trx_wait_histogram));
   rpl_semi_sync_master_net_wait_num = 0;
   rpl_semi_sync_master_net_wait_time = 0;
 
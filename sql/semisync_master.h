@@ -363,6 +363,19 @@ class Active_tranx
 
 };
 
+/**
+  A session waiting in Repl_semi_sync_master::commit_trx() for the reply
+  of its binlog position. Each waiter has its own condition, so that a
+  reply only wakes up the sessions that it releases.
+*/
+struct Semi_sync_waiter
+{
+  const char *log_file_name;
+  my_off_t log_file_pos;
+  mysql_cond_t cond;
+  Semi_sync_waiter *next, **prev;
+};
+
 /**
    The extension class for the master of semi-synchronous replication
 */
@@ -375,10 +388,11 @@ class Repl_semi_sync_master
   /* True when init_object has been called */
   bool m_init_done;
 
-  /* This cond variable is signaled when enough binlog has been sent to slave,
-   * so that a waiting trx can return the 'ok' to the client for a commit.
+  /* The sessions waiting for the reply of a slave, protected by LOCK_binlog.
+   * A waiter is signaled when enough binlog has been sent to slave, so that
+   * the waiting trx can return the 'ok' to the client for a commit.
    */
-  mysql_cond_t  COND_binlog_send;
+  Semi_sync_waiter *m_waiters;
 
   /* Mutex that protects the following state variables and the active
    * transaction list.
@@ -437,7 +451,10 @@ class Repl_semi_sync_master
   void lock();
   void unlock();
   void cond_broadcast();
-  int  cond_timewait(struct timespec *wait_time);
+  int  cond_timewait(Semi_sync_waiter *waiter, struct timespec *wait_time);
+  void add_waiter(Semi_sync_waiter *waiter);
+  void remove_waiter(Semi_sync_waiter *waiter);
+  void signal_waiters();
 
   /* Is semi-sync replication on? */
   bool is_on() {
@@ -653,6 +670,10 @@ extern ulonglong rpl_semi_sync_master_net_wait_num;
 extern ulonglong rpl_semi_sync_master_trx_wait_num;
 extern ulonglong rpl_semi_sync_master_net_wait_time;
 extern ulonglong rpl_semi_sync_master_trx_wait_time;
+/* Transaction waits up to 100us, 1ms, 10ms, 100ms, 1s and longer */
+#define SEMI_SYNC_WAIT_HISTOGRAM_SIZE 6
+extern ulonglong
+  rpl_semi_sync_master_trx_wait_histogram[SEMI_SYNC_WAIT_HISTOGRAM_SIZE];
 extern unsigned long long rpl_semi_sync_master_request_ack;
 extern unsigned long long rpl_semi_sync_master_get_ack;
 
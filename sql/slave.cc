@@ -7460,10 +7460,11 @@ static Log_event* next_event(rpl_group_info *rgi, ulonglong *event_size)
       MYSQL_BIN_LOG::open() will write the buffered description event.
     */
     old_pos= rli->event_relay_log_pos;
-    if ((ev= Log_event::read_log_event(cur_log,
-                                       rli->relay_log.description_event_for_exec,
-                                       opt_slave_sql_verify_checksum)))
-
+    String event;
+    const char *read_error= 0;
+    if (!Log_event::read_log_event_data(cur_log, &event,
+                                        rli->relay_log.description_event_for_exec,
+                                        &read_error))
     {
       /*
         read it while we have a lock, to avoid a mutex lock in
@@ -7474,9 +7475,31 @@ static Log_event* next_event(rpl_group_info *rgi, ulonglong *event_size)
 
       if (hot_log)
         mysql_mutex_unlock(log_lock);
+
+      /*
+        Verify the checksum and construct the event only now, so that the
+        I/O thread is not kept waiting for LOCK_log to queue the events
+        that follow while we do it.
+      */
+      if (!(ev= Log_event::read_log_event(event.ptr(), event.length(),
+                                          &read_error,
+                                          rli->relay_log.description_event_for_exec,
+                                          opt_slave_sql_verify_checksum)))
+      {
+        Log_event::report_read_error(&event, read_error);
+        errmsg= "slave SQL thread aborted because of an invalid event "
+                "in the relay log";
+        goto err;
+      }
+      ev->register_temp_buf(event.release(), true);
       rli->sql_thread_caught_up= false;
       DBUG_RETURN(ev);
     }
+    if (read_error)
+    {
+      Log_event::report_read_error(&event, read_error);
+      cur_log->error= -1;
+    }
     if (opt_reckless_slave)                     // For mysql-test
       cur_log->error = 0;
     if (unlikely(cur_log->error < 0))
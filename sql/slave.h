@@ -147,6 +147,7 @@ extern my_bool opt_replicate_annotate_row_events;
 extern ulonglong relay_log_space_limit;
 extern ulonglong opt_read_binlog_speed_limit;
 extern ulonglong slave_skipped_errors;
+extern ulonglong slave_rows_hash_scans;
 extern const char *relay_log_index;
 extern const char *relay_log_basename;
 
@@ -3287,7 +3287,17 @@ sp_lex_keeper::reset_lex_and_exec_core(THD *thd, uint *nextp,
     thd->lex->safe_to_cache_query= 0;
 #endif
 
-  if (open_tables)
+  /*
+    An expression that uses no tables and calls no stored functions, like
+    in SET i= i + 1 or WHILE i < 10, does not have to open and close tables
+    or to end the statement transaction. Such instructions are common in
+    tight loops.
+  */
+  bool uses_tables= open_tables &&
+                    (m_lex->query_tables || m_lex->sroutines_list.elements ||
+                     lex_query_tables_own_last);
+
+  if (uses_tables)
     res= check_dependencies_in_with_clauses(m_lex->with_clauses_list) ||
          instr->exec_open_and_lock_tables(thd, m_lex->query_tables);
 
@@ -3302,8 +3312,9 @@ sp_lex_keeper::reset_lex_and_exec_core(THD *thd, uint *nextp,
     key read.
   */
   if (open_tables)
-  {
     m_lex->unit.cleanup();
+  if (uses_tables)
+  {
     /* Here we also commit or rollback the current statement. */
     if (! thd->in_sub_stmt)
     {
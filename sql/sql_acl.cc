@@ -151,6 +151,8 @@ class ACL_USER :public ACL_USER_BASE
   LEX_CSTRING auth_string;
   LEX_CSTRING default_rolename;
   LEX_CSTRING salt;
+  /* Next entry of acl_users with the same user name, see acl_users_by_name */
+  ACL_USER *next_same_name;
 
   ACL_USER *copy(MEM_ROOT *root)
   {
@@ -607,6 +609,14 @@ static bool allow_all_hosts=1;
 static HASH acl_check_hosts, column_priv_hash, proc_priv_hash, func_priv_hash;
 static HASH package_spec_priv_hash, package_body_priv_hash;
 static DYNAMIC_ARRAY acl_wild_hosts;
+/*
+  The first entry of acl_users of every user name. The other entries with
+  the same name follow it in ACL_USER::next_same_name, in acl_users order.
+  It is built with acl_check_hosts, and it is only used while
+  acl_users_by_name_valid is set, that is, until acl_users is modified.
+*/
+static HASH acl_users_by_name;
+static bool acl_users_by_name_valid;
 static Hash_filo<acl_entry> *acl_cache;
 static uint grant_version=0; /* Version of priv tables. incremented by acl_load */
 static ulong get_access(TABLE *form,uint fieldnr, uint *next_field=0);
@@ -1618,6 +1628,7 @@ static LEX_CSTRING &guess_auth_plugin(THD *thd, size_t password_len)
 
 static void push_new_user(const ACL_USER &user)
 {
+  acl_users_by_name_valid= false;
   push_dynamic(&acl_users, &user);
   if (!user.host.hostname ||
       (user.host.hostname[0] == wild_many && !user.host.hostname[1]))
@@ -2124,6 +2135,8 @@ void acl_free(bool end)
   delete_dynamic(&acl_wild_hosts);
   delete_dynamic(&acl_proxy_users);
   my_hash_free(&acl_check_hosts);
+  my_hash_free(&acl_users_by_name);
+  acl_users_by_name_valid= false;
   my_hash_free(&acl_roles_mappings);
   if (!end)
     acl_cache->clear(1); /* purecov: inspected */
@@ -2204,6 +2217,8 @@ bool acl_reload(THD *thd)
   old_mem= acl_memroot;
   delete_dynamic(&acl_wild_hosts);
   my_hash_free(&acl_check_hosts);
+  my_hash_free(&acl_users_by_name);
+  acl_users_by_name_valid= false;
 
   if ((result= acl_load(thd, tables)))
   {					// Error. Revert to old list
@@ -2541,6 +2556,14 @@ static uchar* check_get_key(ACL_USER *buff, size_t *length,
 }
 
 
+static uchar* acl_user_name_get_key(ACL_USER *buff, size_t *length,
+                                    my_bool not_used __attribute__((unused)))
+{
+  *length= buff->user.length;
+  return (uchar*) buff->user.str;
+}
+
+
 static void acl_update_role(const char *rolename, ulong privileges)
 {
   ACL_ROLE *role= find_acl_role(rolename);
@@ -2829,6 +2852,30 @@ static void init_check_host(void)
   }
   freeze_size(&acl_wild_hosts);
   freeze_size(&acl_check_hosts.array);
+
+  /*
+    Index the users by name. Walk acl_users backwards, so that every chain
+    of ACL_USER::next_same_name is in acl_users order.
+  */
+  (void) my_hash_init(&acl_users_by_name, &my_charset_bin,
+                      acl_users.elements, 0, 0,
+                      (my_hash_get_key) acl_user_name_get_key, 0, 0);
+  acl_users_by_name_valid= true;
+  for (uint i= acl_users.elements; i-- > 0; )
+  {
+    ACL_USER *acl_user= dynamic_element(&acl_users, i, ACL_USER*);
+    ACL_USER *first= (ACL_USER*) my_hash_search(&acl_users_by_name,
+                                                (uchar*) acl_user->user.str,
+                                                acl_user->user.length);
+    if (first)
+      my_hash_delete(&acl_users_by_name, (uchar*) first);
+    acl_user->next_same_name= first;
+    if (my_hash_insert(&acl_users_by_name, (uchar*) acl_user))
+    {
+      acl_users_by_name_valid= false;          // End of memory
+      break;
+    }
+  }
   DBUG_VOID_RETURN;
 }
 
@@ -2845,6 +2892,7 @@ static void rebuild_check_host(void)
 {
   delete_dynamic(&acl_wild_hosts);
   my_hash_free(&acl_check_hosts);
+  my_hash_free(&acl_users_by_name);
   init_check_host();
 }
 
@@ -3390,6 +3438,17 @@ bool is_acl_user(const char *host, const char *user)
 }
 
 
+/*
+  The first entry of acl_users with the given user name, if
+  acl_users_by_name_valid
+*/
+static ACL_USER *first_user_by_name(const char *user)
+{
+  return (ACL_USER*) my_hash_search(&acl_users_by_name, (const uchar*) user,
+                                    strlen(user));
+}
+
+
 /*
   unlike find_user_exact and find_user_wild,
   this function finds anonymous users too, it's when a
@@ -3399,6 +3458,33 @@ static ACL_USER *find_user_or_anon(const char *host, const char *user, const cha
 {
   ACL_USER *result= NULL;
   mysql_mutex_assert_owner(&acl_cache->lock);
+  if (acl_users_by_name_valid)
+  {
+    /*
+      The first match of the user, or of an anonymous user, whichever comes
+      first in acl_users
+    */
+    for (ACL_USER *acl_user_tmp= first_user_by_name(user); acl_user_tmp;
+         acl_user_tmp= acl_user_tmp->next_same_name)
+    {
+      if (compare_hostname(&acl_user_tmp->host, host, ip))
+      {
+        result= acl_user_tmp;
+        break;
+      }
+    }
+    for (ACL_USER *acl_user_tmp= first_user_by_name("");
+         acl_user_tmp && (!result || acl_user_tmp < result);
+         acl_user_tmp= acl_user_tmp->next_same_name)
+    {
+      if (compare_hostname(&acl_user_tmp->host, host, ip))
+      {
+        result= acl_user_tmp;
+        break;
+      }
+    }
+    return result;
+  }
   for (uint i=0; i < acl_users.elements; i++)
   {
     ACL_USER *acl_user_tmp= dynamic_element(&acl_users, i, ACL_USER*);
@@ -3421,6 +3507,16 @@ static ACL_USER *find_user_exact(const char *host, const char *user)
 {
   mysql_mutex_assert_owner(&acl_cache->lock);
 
+  if (acl_users_by_name_valid)
+  {
+    for (ACL_USER *acl_user= first_user_by_name(user); acl_user;
+         acl_user= acl_user->next_same_name)
+    {
+      if (acl_user->eq(user, host))
+        return acl_user;
+    }
+    return 0;
+  }
   for (uint i=0 ; i < acl_users.elements ; i++)
   {
     ACL_USER *acl_user=dynamic_element(&acl_users, i, ACL_USER*);
@@ -3437,6 +3533,16 @@ static ACL_USER * find_user_wild(const char *host, const char *user, const char
 {
   mysql_mutex_assert_owner(&acl_cache->lock);
 
+  if (acl_users_by_name_valid)
+  {
+    for (ACL_USER *acl_user= first_user_by_name(user); acl_user;
+         acl_user= acl_user->next_same_name)
+    {
+      if (acl_user->wild_eq(user, host, ip))
+        return acl_user;
+    }
+    return 0;
+  }
   for (uint i=0 ; i < acl_users.elements ; i++)
   {
     ACL_USER *acl_user=dynamic_element(&acl_users,i,ACL_USER*);
@@ -9540,6 +9646,7 @@ static int handle_grant_struct(enum enum_acl_lists struct_no, bool drop,
       elements--;
       switch ( struct_no ) {
       case USER_ACL:
+        acl_users_by_name_valid= false;
         free_acl_user(dynamic_element(&acl_users, idx, ACL_USER*));
         delete_dynamic_element(&acl_users, idx);
         break;
@@ -9584,6 +9691,7 @@ static int handle_grant_struct(enum enum_acl_lists struct_no, bool drop,
     {
       switch ( struct_no ) {
       case USER_ACL:
+        acl_users_by_name_valid= false;
         acl_user->user= safe_lexcstrdup_root(&acl_memroot, user_to->user);
         update_hostname(&acl_user->host, strdup_root(&acl_memroot, user_to->host.str));
         acl_user->hostname_length= strlen(acl_user->host.hostname);
@@ -70,6 +70,12 @@ void Filesort_tracker::print_json_members(Json_writer *writer)
                                                                get_r_loops()));
   }
 
+  if (spilled_bytes)
+  {
+    writer->add_member("r_spilled_bytes").
+            add_size((longlong) rint(spilled_bytes / get_r_loops()));
+  }
+
   if (sort_buffer_size != 0)
   {
     writer->add_member("r_buffer_size");
@@ -34,7 +34,9 @@ log, should the query be slow.
 
 2. Timing data. Measuring the time it took to run parts of query has noticeable
 overhead. Because of that, we measure the time only when running "ANALYZE
-$stmt").
+$stmt"). Row-level operations can be timed only once in
+analyze_time_sample_rate calls, the total time is then extrapolated from the
+timed calls.
 
 */
 
@@ -47,21 +49,42 @@ class Exec_time_tracker
   ulonglong count;
   ulonglong cycles;
   ulonglong last_start;
+  /* How many of the 'count' calls were timed */
+  ulonglong timed_count;
+  /* Time one in sample_rate calls */
+  ulong sample_rate;
+  /* Calls to skip before the next timed one */
+  ulong sample_skip;
+  bool timing;
 
   void cycles_stop_tracking()
   {
+    if (!timing)
+      return;
     ulonglong end= my_timer_cycles();
     cycles += end - last_start;
     if (unlikely(end < last_start))
       cycles += ULONGLONG_MAX;
+    timed_count++;
   }
 public:
-  Exec_time_tracker() : count(0), cycles(0) {}
+  Exec_time_tracker() :
+    count(0), cycles(0), timed_count(0), sample_rate(1), sample_skip(0),
+    timing(false)
+  {}
+
+  void set_sample_rate(ulong rate) { sample_rate= rate ? rate : 1; }
   
   // interface for collecting time
   void start_tracking()
   {
-    last_start= my_timer_cycles();
+    if ((timing= !sample_skip))
+    {
+      sample_skip= sample_rate - 1;
+      last_start= my_timer_cycles();
+    }
+    else
+      sample_skip--;
   }
 
   void stop_tracking()
@@ -75,7 +98,11 @@ class Exec_time_tracker
   double get_time_ms() const
   {
     // convert 'cycles' to milliseconds.
-    return 1000 * ((double)cycles) / sys_timer_info.cycles.frequency;
+    double ms= 1000 * ((double)cycles) / sys_timer_info.cycles.frequency;
+    // extrapolate from the timed calls, if not all calls were timed
+    if (timed_count && timed_count < count)
+      ms*= (double) count / timed_count;
+    return ms;
   }
 };
 
@@ -162,6 +189,47 @@ class Table_access_tracker
 };
 
 
+/*
+  A class for collecting statistics about a rowid filter: how many rowids
+  were put into it, and how many rowids were looked up and found there.
+*/
+
+class Rowid_filter_tracker
+{
+public:
+  Rowid_filter_tracker() :
+    r_builds(0), r_container_elements(0), r_lookups(0), r_hits(0)
+  {}
+
+  ha_rows r_builds; /* How many times the filter was filled */
+  ha_rows r_container_elements; /* Rowids put into the filter */
+  ha_rows r_lookups; /* Rowids checked against the filter */
+  ha_rows r_hits; /* Rowids found in the filter */
+
+  bool has_lookups() { return (r_lookups != 0); }
+  double get_avg_elements()
+  {
+    return r_builds ? ((double)r_container_elements / r_builds) : 0;
+  }
+  double get_r_selectivity()
+  {
+    return r_lookups ? ((double)r_hits / r_lookups) : 1.0;
+  }
+
+  inline void on_build(ha_rows elements)
+  {
+    r_builds++;
+    r_container_elements+= elements;
+  }
+  inline void on_lookup(bool hit)
+  {
+    r_lookups++;
+    if (hit)
+      r_hits++;
+  }
+};
+
+
 class Json_writer;
 
 /*
@@ -181,7 +249,7 @@ class Filesort_tracker : public Sql_alloc
     time_tracker(do_timing), r_limit(0), r_used_pq(0),
     r_examined_rows(0), r_sorted_rows(0), r_output_rows(0),
     sort_passes(0),
-    sort_buffer_size(0)
+    sort_buffer_size(0), spilled_bytes(0)
   {}
   
   /* Functions that filesort uses to report various things about its execution */
@@ -216,6 +284,11 @@ class Filesort_tracker : public Sql_alloc
     sort_passes += passes;
   }
 
+  inline void report_spilled_bytes(ulonglong bytes)
+  {
+    spilled_bytes+= bytes;
+  }
+
   inline void report_sort_buffer_size(size_t bufsize)
   {
     if (sort_buffer_size)
@@ -282,5 +355,8 @@ class Filesort_tracker : public Sql_alloc
     other          - value
   */
   ulonglong sort_buffer_size;
+
+  /* How many bytes were written to the merge file (divide by r_count) */
+  ulonglong spilled_bytes;
 };
 
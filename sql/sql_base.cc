@@ -57,6 +57,7 @@
 #include "sql_table.h"                          // build_table_filename
 #include "datadict.h"   // dd_frm_is_view()
 #include "sql_hset.h"   // Hash_set
+#include "sql_connect.h" // merge_table_index_stats
 #include "rpl_rli.h"   // rpl_group_info
 #ifdef  __WIN__
 #include <io.h>
@@ -855,6 +856,17 @@ void close_thread_tables(THD *thd)
   while (thd->open_tables)
     (void) close_thread_table(thd, &thd->open_tables);
 
+  if (thd->table_index_stats_pending)
+  {
+    time_t now= opt_userstat_merge_interval ? my_time(0) : 0;
+    if (now - thd->last_table_index_stats_merge_time >=
+        (time_t) opt_userstat_merge_interval)
+    {
+      merge_table_index_stats(thd);
+      thd->last_table_index_stats_merge_time= now;
+    }
+  }
+
   DBUG_VOID_RETURN;
 }
 
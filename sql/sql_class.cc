@@ -69,6 +69,7 @@
 #include "wsrep_thd.h"
 #include "sql_connect.h"
 #include "my_atomic.h"
+#include "pcre.h"
 
 #ifdef HAVE_SYS_SYSCALL_H
 #include <sys/syscall.h>
@@ -638,6 +639,7 @@ THD::THD(my_thread_id id, bool is_wsrep_applier, bool skip_global_sys_var_lock)
    m_stmt_da(&main_da),
    tdc_hash_pins(0),
    xid_hash_pins(0),
+   regexp_jit_stack(0),
    m_tmp_tables_locked(false)
 #ifdef WITH_WSREP
   ,
@@ -703,17 +705,22 @@ THD::THD(my_thread_id id, bool is_wsrep_applier, bool skip_global_sys_var_lock)
   is_slave_error= thread_specific_used= FALSE;
   my_hash_clear(&handler_tables_hash);
   my_hash_clear(&ull_hash);
+  my_hash_clear(&pending_table_stats);
+  my_hash_clear(&pending_index_stats);
+  last_table_index_stats_merge_time= 0;
+  table_index_stats_pending= false;
   tmp_table=0;
   cuted_fields= 0L;
   m_sent_row_count= 0L;
   limit_found_rows= 0;
   m_row_count_func= -1;
   statement_id_counter= 0UL;
+  expr_cache_memory_used= 0;
   // Must be reset to handle error with THD's created for init of mysqld
   lex->current_select= 0;
   start_utime= utime_after_query= 0;
   system_time.start.val= system_time.sec= system_time.sec_part= 0;
-  utime_after_lock= 0L;
+  utime_after_lock= utime_after_parse= 0L;
   progress.arena= 0;
   progress.report_to_client= 0;
   progress.max_counter= 0;
@@ -1513,6 +1520,9 @@ void THD::cleanup(void)
   auto_inc_intervals_in_cur_stmt_for_binlog.empty();
 
   mysql_ull_cleanup(this);
+  merge_table_index_stats(this);
+  my_hash_free(&pending_table_stats);
+  my_hash_free(&pending_index_stats);
   /* All metadata locks must have been released by now. */
   DBUG_ASSERT(!mdl_context.has_locks());
 
@@ -1603,6 +1613,11 @@ THD::~THD()
   if (!status_in_global)
     add_status_to_global();
 
+#ifndef EMBEDDED_LIBRARY
+  /* A cancelled query timer may still be in the timer queue */
+  thr_timer_end(&query_timer);
+#endif
+
   /*
     Other threads may have a lock on LOCK_thd_kill to ensure that this
     THD is not deleted while they access it. The following mutex_lock
@@ -1651,6 +1666,8 @@ THD::~THD()
     lf_hash_put_pins(tdc_hash_pins);
   if (xid_hash_pins)
     lf_hash_put_pins(xid_hash_pins);
+  if (regexp_jit_stack)
+    pcre_jit_stack_free(regexp_jit_stack);
   /* Ensure everything is freed */
   status_var.local_memory_used-= sizeof(THD);
 
@@ -1708,6 +1725,7 @@ void add_to_status(STATUS_VAR *to_var, STATUS_VAR *from_var)
   to_var->table_open_cache_hits+= from_var->table_open_cache_hits;
   to_var->table_open_cache_misses+= from_var->table_open_cache_misses;
   to_var->table_open_cache_overflows+= from_var->table_open_cache_overflows;
+  to_var->buffer_memory_reclaimed+= from_var->buffer_memory_reclaimed;
 
   /*
     Update global_memory_used. We have to do this with atomic_add as the
@@ -1765,6 +1783,8 @@ void add_diff_to_status(STATUS_VAR *to_var, STATUS_VAR *from_var,
                                     dec_var->table_open_cache_misses;
   to_var->table_open_cache_overflows+= from_var->table_open_cache_overflows -
                                        dec_var->table_open_cache_overflows;
+  to_var->buffer_memory_reclaimed+= from_var->buffer_memory_reclaimed -
+                                    dec_var->buffer_memory_reclaimed;
 
   /*
     We don't need to accumulate memory_used as these are not reset or used by
@@ -4191,6 +4211,7 @@ void TMP_TABLE_PARAM::init()
   materialized_subquery= 0;
   force_not_null_cols= 0;
   skip_create_table= 0;
+  group_update_pending= 0;
   DBUG_VOID_RETURN;
 }
 
@@ -6622,6 +6643,7 @@ int THD::binlog_write_row(TABLE* table, bool is_trans,
   if (unlikely(ev == 0))
     return HA_ERR_OUT_OF_MEM;
 
+  binlog_writeset_add_row(this, table, record, NULL, NULL);
   return ev->add_row_data(row_data, len);
 }
 
@@ -6679,6 +6701,9 @@ int THD::binlog_update_row(TABLE* table, bool is_trans,
   if (unlikely(ev == 0))
     return HA_ERR_OUT_OF_MEM;
 
+  binlog_writeset_add_row(this, table, before_record, table->read_set, NULL);
+  binlog_writeset_add_row(this, table, after_record, table->read_set,
+                          table->write_set);
   int error=  ev->add_row_data(before_row, before_size) ||
               ev->add_row_data(after_row, after_size);
 
@@ -6740,7 +6765,7 @@ int THD::binlog_delete_row(TABLE* table, bool is_trans,
   if (unlikely(ev == 0))
     return HA_ERR_OUT_OF_MEM;
 
-
+  binlog_writeset_add_row(this, table, record, old_read_set, NULL);
   int error= ev->add_row_data(row_data, len);
 
   /* restore read set for the rest of execution */
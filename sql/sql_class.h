@@ -79,6 +79,7 @@ class user_var_entry;
 struct Trans_binlog_info;
 class rpl_io_thread_info;
 class rpl_sql_thread_info;
+struct real_pcre_jit_stack;
 
 enum enum_ha_read_modes { RFIRST, RNEXT, RPREV, RLAST, RKEY, RNEXT_SAME };
 enum enum_duplicates { DUP_ERROR, DUP_REPLACE, DUP_UPDATE };
@@ -240,6 +241,8 @@ typedef struct st_copy_info {
   enum enum_duplicates handle_duplicates;
   int escape_char, last_errno;
   bool ignore;
+  /* Look up conflicting rows before inserting, see write_record() */
+  bool probe_duplicates;
   /* for INSERT ... UPDATE */
   List<Item> *update_fields;
   List<Item> *update_values;
@@ -550,6 +553,7 @@ typedef struct system_variables
   uint dynamic_variables_size;    /* how many bytes are in use */
   
   ulonglong max_heap_table_size;
+  ulonglong expression_cache_max_memory;
   ulonglong tmp_memory_table_size;
   ulonglong tmp_disk_table_size;
   ulonglong long_query_time;
@@ -569,6 +573,7 @@ typedef struct system_variables
   ulonglong group_concat_max_len;
   ulonglong default_regex_flags;
   ulonglong max_mem_used;
+  ulonglong range_optimizer_max_mem_size;
 
   /**
      Place holders to store Multi-source variables in sys_var.cc during
@@ -600,10 +605,12 @@ typedef struct system_variables
   ulong net_retry_count;
   ulong net_wait_timeout;
   ulong net_write_timeout;
+  ulong optimizer_plan_cache_tolerance;
   ulong optimizer_prune_level;
   ulong optimizer_search_depth;
   ulong optimizer_selectivity_sampling_limit;
   ulong optimizer_use_condition_selectivity;
+  ulong partition_parallel_scan_min_partitions;
   ulong use_stat_tables;
   ulong histogram_size;
   ulong histogram_type;
@@ -621,11 +628,14 @@ typedef struct system_variables
   ulong range_alloc_block_size;
   ulong query_alloc_block_size;
   ulong query_prealloc_size;
+  ulong query_alloc_keep_size;
   ulong trans_alloc_block_size;
   ulong trans_prealloc_size;
   ulong log_warnings;
   /* Flags for slow log filtering */
   ulong log_slow_rate_limit; 
+  ulong log_slow_digest_limit;
+  ulong analyze_time_sample_rate;
   ulong binlog_format; ///< binlog format for this thd (see enum_binlog_format)
   ulong binlog_row_image;
   ulong progress_report_time;
@@ -659,7 +669,10 @@ typedef struct system_variables
   my_bool old_mode;
   my_bool old_passwords;
   my_bool big_tables;
+  my_bool tmp_memory_table_blobs;
+  my_bool partition_defer_locking;
   my_bool only_standard_compliant_cte;
+  my_bool share_cte_materialization;
   my_bool query_cache_strip_comments;
   my_bool sql_log_slow;
   my_bool sql_log_bin;
@@ -711,6 +724,7 @@ typedef struct system_variables
   ulong wsrep_retry_autocommit;
   ulong wsrep_OSU_method;
   double long_query_time_double, max_statement_time_double;
+  double sample_percentage;
 
   my_bool pseudo_slave_mode;
 
@@ -727,7 +741,10 @@ typedef struct system_variables
   uint idle_write_transaction_timeout;
   uint column_compression_threshold;
   uint column_compression_zlib_level;
+  uint column_compression_zstd_level;
   uint in_subquery_conversion_threshold;
+  uint sort_threads;
+  uint max_rowid_filter_size;
 
   vers_asof_timestamp_t vers_asof_timestamp;
   ulong vers_alter_history;
@@ -859,6 +876,7 @@ typedef struct system_status_var
   ulonglong table_open_cache_hits;
   ulonglong table_open_cache_misses;
   ulonglong table_open_cache_overflows;
+  ulonglong buffer_memory_reclaimed;
   double last_query_cost;
   double cpu_time, busy_time;
   uint32 threads_running;
@@ -2383,6 +2401,8 @@ class THD :public Statement,
   // track down slow pthread_create
   ulonglong  prior_thr_create_utime, thr_create_utime;
   ulonglong  start_utime, utime_after_lock, utime_after_query;
+  /* Only set when the digest statistics are collected */
+  ulonglong  utime_after_parse;
 
   // Process indicator
   struct {
@@ -2970,6 +2990,8 @@ class THD :public Statement,
   ulong      tmp_tables_disk_used;
   ulonglong  tmp_tables_size;
   ulonglong  bytes_sent_old;
+  /* Memory used by the in-memory hash tables of the expression caches */
+  ulonglong  expr_cache_memory_used;
   ulonglong  affected_rows;                     /* Number of changed rows */
 
   pthread_t  real_id;                           /* For debugging */
@@ -3176,6 +3198,15 @@ class THD :public Statement,
   uint select_commands, update_commands, other_commands;
   ulonglong start_cpu_time;
   ulonglong start_bytes_received;
+  /*
+    TABLE_STATISTICS and INDEX_STATISTICS of this thread that are not
+    merged into global_table_stats and global_index_stats yet.
+    See merge_table_index_stats().
+  */
+  HASH pending_table_stats, pending_index_stats;
+  /* Last time when the pending table and index stats were merged. */
+  time_t last_table_index_stats_merge_time;
+  bool table_index_stats_pending;
 
   /* Used by the sys_var class to store temporary values */
   union
@@ -4656,6 +4687,9 @@ class THD :public Statement,
   LF_PINS *xid_hash_pins;
   bool fix_xid_hash_pins();
 
+  /* Stack of the JIT compiled regular expressions, allocated on first use */
+  real_pcre_jit_stack *regexp_jit_stack;
+
 /* Members related to temporary tables. */
 public:
   /* Opened table states. */
@@ -4814,7 +4848,7 @@ class THD :public Statement,
     if (spcont || in_sub_stmt || slave_thread)
       return;
     if (!query_timer.expired)
-      thr_timer_end(&query_timer);
+      thr_timer_cancel(&query_timer);
 #endif
   }
   void restore_set_statement_var()
@@ -5517,6 +5551,8 @@ class TMP_TABLE_PARAM :public Sql_alloc
   List<Item> copy_funcs;
   Copy_field *copy_field, *copy_field_end;
   uchar	    *group_buff;
+  /* Group key of the row whose update end_update() has deferred */
+  uchar	    *prev_group_buff;
   Item	    **items_to_copy;			/* Fields in tmp table */
   TMP_ENGINE_COLUMNDEF *recinfo, *start_recinfo;
   KEY *keyinfo;
@@ -5582,6 +5618,11 @@ class TMP_TABLE_PARAM :public Sql_alloc
     TRUE <=> create_tmp_table will create only the TABLE structure.
   */
   bool skip_create_table;
+  /*
+    TRUE if record[0] of the table holds an updated group row that
+    end_update() has not written yet, see flush_group_update().
+  */
+  bool group_update_pending;
 
   TMP_TABLE_PARAM()
     :copy_field(0), group_parts(0),
@@ -5589,7 +5630,8 @@ class TMP_TABLE_PARAM :public Sql_alloc
      using_outer_summary_function(0),
      schema_table(0), materialized_subquery(0), force_not_null_cols(0),
      precomputed_group_by(0),
-     force_copy_fields(0), bit_fields_as_long(0), skip_create_table(0)
+     force_copy_fields(0), bit_fields_as_long(0), skip_create_table(0),
+     group_update_pending(0)
   {}
   ~TMP_TABLE_PARAM()
   {
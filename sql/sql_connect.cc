@@ -529,6 +529,161 @@ void init_global_index_stats(void)
 }
 
 
+/*
+  Get the statistics of a table that a thread has not merged into the
+  global table stats yet, creating them if necessary.
+
+  The statistics are only accessed by the thread itself, so no mutex is
+  needed.
+
+  @return the statistics, or NULL if out of memory
+*/
+
+TABLE_STATS *get_pending_table_stats(THD *thd, const char *name,
+                                     size_t length)
+{
+  TABLE_STATS *table_stats;
+
+  if (!my_hash_inited(&thd->pending_table_stats) &&
+      my_hash_init(&thd->pending_table_stats, system_charset_info, 16,
+                   0, 0, (my_hash_get_key) get_key_table_stats,
+                   (my_hash_free_key) free_table_stats, 0))
+    return NULL;
+  if ((table_stats= (TABLE_STATS*) my_hash_search(&thd->pending_table_stats,
+                                                 (uchar*) name, length)))
+    return table_stats;
+  if (!(table_stats= (TABLE_STATS*) my_malloc(sizeof(TABLE_STATS),
+                                              MYF(MY_WME | MY_ZEROFILL))))
+    return NULL;
+  memcpy(table_stats->table, name, length);
+  table_stats->table_name_length= length;
+  if (my_hash_insert(&thd->pending_table_stats, (uchar*) table_stats))
+  {
+    my_free(table_stats);
+    return NULL;
+  }
+  return table_stats;
+}
+
+
+/*
+  Get the statistics of an index that a thread has not merged into the
+  global index stats yet, creating them if necessary.
+
+  @return the statistics, or NULL if out of memory
+*/
+
+INDEX_STATS *get_pending_index_stats(THD *thd, const char *name,
+                                     size_t length)
+{
+  INDEX_STATS *index_stats;
+
+  if (!my_hash_inited(&thd->pending_index_stats) &&
+      my_hash_init(&thd->pending_index_stats, system_charset_info, 16,
+                   0, 0, (my_hash_get_key) get_key_index_stats,
+                   (my_hash_free_key) free_index_stats, 0))
+    return NULL;
+  if ((index_stats= (INDEX_STATS*) my_hash_search(&thd->pending_index_stats,
+                                                 (uchar*) name, length)))
+    return index_stats;
+  if (!(index_stats= (INDEX_STATS*) my_malloc(sizeof(INDEX_STATS),
+                                              MYF(MY_WME | MY_ZEROFILL))))
+    return NULL;
+  memcpy(index_stats->index, name, length);
+  index_stats->index_name_length= length;
+  if (my_hash_insert(&thd->pending_index_stats, (uchar*) index_stats))
+  {
+    my_free(index_stats);
+    return NULL;
+  }
+  return index_stats;
+}
+
+
+/*
+  Merge the table and index statistics of a thread into the global ones.
+
+  The statistics are collected per thread by close_thread_table(), and
+  merged at most every userstat_merge_interval seconds, so that the
+  global mutexes are not taken for every table of every statement.
+
+  The merged per thread statistics are kept with zero counters, so that
+  the tables used by the next statements don't need to be allocated
+  again, unless there are many of them.
+*/
+
+void merge_table_index_stats(THD *thd)
+{
+  if (!thd->table_index_stats_pending)
+    return;
+
+  if (thd->pending_table_stats.records)
+  {
+    mysql_mutex_lock(&LOCK_global_table_stats);
+    for (ulong i= 0; i < thd->pending_table_stats.records; i++)
+    {
+      TABLE_STATS *pending= (TABLE_STATS*)
+        my_hash_element(&thd->pending_table_stats, i);
+      TABLE_STATS *table_stats;
+
+      if (pending->rows_read + pending->rows_changed == 0)
+        continue;
+      if ((table_stats= (TABLE_STATS*)
+           my_hash_search(&global_table_stats, (uchar*) pending->table,
+                          pending->table_name_length)))
+      {
+        table_stats->rows_read+=              pending->rows_read;
+        table_stats->rows_changed+=           pending->rows_changed;
+        table_stats->rows_changed_x_indexes+= pending->rows_changed_x_indexes;
+      }
+      else if ((table_stats= (TABLE_STATS*) my_malloc(sizeof(TABLE_STATS),
+                                                      MYF(MY_WME))))
+      {
+        *table_stats= *pending;
+        if (my_hash_insert(&global_table_stats, (uchar*) table_stats))
+          my_free(table_stats);
+      }
+      pending->rows_read= pending->rows_changed= 0;
+      pending->rows_changed_x_indexes= 0;
+    }
+    mysql_mutex_unlock(&LOCK_global_table_stats);
+    if (thd->pending_table_stats.records > 128)
+      my_hash_reset(&thd->pending_table_stats);
+  }
+
+  if (thd->pending_index_stats.records)
+  {
+    mysql_mutex_lock(&LOCK_global_index_stats);
+    for (ulong i= 0; i < thd->pending_index_stats.records; i++)
+    {
+      INDEX_STATS *pending= (INDEX_STATS*)
+        my_hash_element(&thd->pending_index_stats, i);
+      INDEX_STATS *index_stats;
+
+      if (pending->rows_read == 0)
+        continue;
+      if ((index_stats= (INDEX_STATS*)
+           my_hash_search(&global_index_stats, (uchar*) pending->index,
+                          pending->index_name_length)))
+        index_stats->rows_read+= pending->rows_read;
+      else if ((index_stats= (INDEX_STATS*) my_malloc(sizeof(INDEX_STATS),
+                                                      MYF(MY_WME))))
+      {
+        *index_stats= *pending;
+        if (my_hash_insert(&global_index_stats, (uchar*) index_stats))
+          my_free(index_stats);
+      }
+      pending->rows_read= 0;
+    }
+    mysql_mutex_unlock(&LOCK_global_index_stats);
+    if (thd->pending_index_stats.records > 128)
+      my_hash_reset(&thd->pending_index_stats);
+  }
+
+  thd->table_index_stats_pending= false;
+}
+
+
 void free_global_user_stats(void)
 {
   my_hash_free(&global_user_stats);
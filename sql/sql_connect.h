@@ -94,6 +94,11 @@ bool login_connection(THD *thd);
 void prepare_new_connection_state(THD* thd);
 void end_connection(THD *thd);
 void update_global_user_stats(THD* thd, bool create_user, time_t now);
+TABLE_STATS *get_pending_table_stats(THD *thd, const char *name,
+                                     size_t length);
+INDEX_STATS *get_pending_index_stats(THD *thd, const char *name,
+                                     size_t length);
+void merge_table_index_stats(THD *thd);
 int get_or_create_user_conn(THD *thd, const char *user,
                             const char *host, const USER_RESOURCES *mqh);
 int check_for_max_user_connections(THD *thd, USER_CONN *uc);
@@ -88,6 +88,7 @@
 
 #define MAX_SORT_MEMORY 2048*1024
 #define MIN_SORT_MEMORY 1024
+#define MAX_SORT_THREADS 64   /* max value of @@sort_threads */
 
 /* Some portable defines */
 
@@ -1132,6 +1132,7 @@ bool TABLE_LIST::set_as_with_table(THD *thd, With_element *with_elem)
   derived->first_select()->set_linkage(DERIVED_TABLE_TYPE);
   select_lex->add_statistics(derived);
   with_elem->inc_references();
+  with_elem->table_refs.link_in_list(this, &this->next_with_table_ref);
   return false;
 }
 
@@ -161,6 +161,8 @@ class With_element : public Sql_alloc
   SQL_I_List<Item_subselect> sq_with_rec_ref;
   /* List of derived tables containing recursive references to this CTE */
   SQL_I_List<TABLE_LIST> derived_with_rec_ref;
+  /* List of all table references to this CTE */
+  SQL_I_List<TABLE_LIST> table_refs;
 
   With_element(LEX_CSTRING *name,
                List <LEX_CSTRING> list,
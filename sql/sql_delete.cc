@@ -121,7 +121,11 @@ bool Update_plan::save_explain_data_intern(MEM_ROOT *mem_root,
   }
   
   if (is_analyze)
+  {
+    explain->table_tracker.
+      set_sample_rate(table->in_use->variables.analyze_time_sample_rate);
     table->file->set_time_tracker(&explain->table_tracker);
+  }
 
   select_lex->set_explain_type(TRUE);
   explain->select_type= select_lex->type;
@@ -696,7 +700,7 @@ bool mysql_delete(THD *thd, TABLE_LIST *table_list, COND *conds,
     ha_rows tmplimit=limit;
     deltempfile= new (thd->mem_root) Unique (refpos_order_cmp, table->file,
                                              table->file->ref_length,
-                                             MEM_STRIP_BUF_SIZE);
+                                             MEM_STRIP_BUF_SIZE, 0, true);
 
     THD_STAGE_INFO(thd, stage_searching_rows_for_update);
     while (!(error=info.read_record()) && !thd->killed &&
@@ -1201,7 +1205,7 @@ multi_delete::initialize_tables(JOIN *join)
     TABLE *table=walk->table;
     *tempfiles_ptr++= new (thd->mem_root) Unique (refpos_order_cmp, table->file,
                                                   table->file->ref_length,
-                                                  MEM_STRIP_BUF_SIZE);
+                                                  MEM_STRIP_BUF_SIZE, 0, true);
   }
   init_ftfuncs(thd, thd->lex->current_select, 1);
   DBUG_RETURN(thd->is_fatal_error);
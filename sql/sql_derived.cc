@@ -1064,6 +1064,118 @@ bool TABLE_LIST::fill_recursive(THD *thd)
 }
 
 
+/*
+  Reset the field translation table of a filled derived table/view to the
+  fields of its materialized table
+
+  @retval false  OK
+  @retval true   Out of memory
+*/
+
+static bool reset_field_translation_to_table(THD *thd, TABLE_LIST *derived)
+{
+  Field_iterator_table field_iterator;
+  field_iterator.set_table(derived->table);
+  for (uint i= 0;
+       !field_iterator.end_of_fields();
+       field_iterator.next(), i= i + 1)
+  {
+    Item *item;
+
+    if (!(item= field_iterator.create_item(thd)))
+      return true;
+    thd->change_item_tree(&derived->field_translation[i].item, item);
+  }
+  return false;
+}
+
+
+/*
+  Check whether a reference to a non-recursive CTE yields the same rows as
+  the other references to it
+
+  @details
+    The specifications of the references are clones of the same query.
+    They yield the same rows unless the specification of one of them was
+    changed by the optimizer of the embedding query: a condition pushed
+    into it, or splitting, which makes the unit dependent.
+*/
+
+static bool is_shareable_cte_reference(TABLE_LIST *derived)
+{
+  st_select_lex_unit *unit= derived->get_unit();
+  if (!derived->is_materialized_derived() || unit->uncacheable ||
+      !derived->table || !derived->table->is_created())
+    return false;
+  for (st_select_lex *sl= unit->first_select(); sl; sl= sl->next_select())
+  {
+    if (sl->cond_pushed_into_where || sl->cond_pushed_into_having)
+      return false;
+  }
+  return true;
+}
+
+
+/*
+  Fill the other materialized references to a CTE from a filled one
+
+  @param thd      Thread handle
+  @param derived  reference to the CTE that has just been filled
+
+  @details
+    With share_cte_materialization the specification of a non-recursive
+    CTE is executed for the first materialized reference only. Its rows
+    are copied into the tables of the other references that are not
+    filled yet, and the units of these references are marked as executed.
+    The tables of the other references keep their own keys, which are
+    built by the copying.
+
+    The copying is done right after the first reference is filled, as
+    later its table may be in the middle of a scan by the join.
+
+  @retval false  OK
+  @retval true   Error
+*/
+
+static bool share_cte_materialization(THD *thd, TABLE_LIST *derived)
+{
+  With_element *with= derived->with;
+  TABLE *src= derived->table;
+  bool res= false;
+  DBUG_ENTER("share_cte_materialization");
+
+  if (with->is_recursive || with->table_refs.elements < 2 ||
+      thd->lex->describe || !is_shareable_cte_reference(derived))
+    DBUG_RETURN(false);
+
+  for (TABLE_LIST *ref= with->table_refs.first;
+       ref && !res;
+       ref= ref->next_with_table_ref)
+  {
+    st_select_lex_unit *unit= ref->get_unit();
+    if (ref == derived || unit->executed || !is_shareable_cte_reference(ref))
+      continue;
+    TABLE *dst= ref->table;
+    if (dst->s->fields != src->s->fields ||
+        dst->s->reclength != src->s->reclength)
+      continue;
+    DBUG_PRINT("info", ("Filling '%s' from '%s'",
+                        ref->alias.str, derived->alias.str));
+    res= src->insert_all_rows_into_tmp_table(thd, dst,
+                                             &ref->derived_result->
+                                               tmp_table_param,
+                                             false);
+    src->file->ha_index_or_rnd_end();
+    if (res)
+      break;
+    unit->executed= TRUE;
+    if (ref->field_translation)
+      res= reset_field_translation_to_table(thd, ref);
+  }
+  DBUG_RETURN(res);
+}
+
+
 /*
   Execute subquery of a materialized derived table/view and fill the result
   table.
@@ -1091,7 +1203,6 @@ bool TABLE_LIST::fill_recursive(THD *thd)
 
 bool mysql_derived_fill(THD *thd, LEX *lex, TABLE_LIST *derived)
 {
-  Field_iterator_table field_iterator;
   SELECT_LEX_UNIT *unit= derived->get_unit();
   bool derived_is_recursive= derived->is_recursive_with_table();
   bool res= FALSE;
@@ -1112,7 +1223,9 @@ bool mysql_derived_fill(THD *thd, LEX *lex, TABLE_LIST *derived)
   if (unit->executed && !derived_is_recursive &&
       (unit->uncacheable & UNCACHEABLE_DEPENDENT))
   {
-    if ((res= derived->table->file->ha_delete_all_rows()))
+    /* The cached partitions of a split materialized table are kept */
+    if (!derived->table->caches_split_partitions() &&
+        (res= derived->table->file->ha_delete_all_rows()))
       goto err;
     JOIN *join= unit->first_select()->join;
     join->first_record= false;
@@ -1172,24 +1285,12 @@ bool mysql_derived_fill(THD *thd, LEX *lex, TABLE_LIST *derived)
       res= TRUE;
     unit->executed= TRUE;
 
-    if (derived->field_translation)
-    {
-      /* reset translation table to materialized table */
-      field_iterator.set_table(derived->table);
-      for (uint i= 0;
-           !field_iterator.end_of_fields();
-           field_iterator.next(), i= i + 1)
-      {
-        Item *item;
-
-        if (!(item= field_iterator.create_item(thd)))
-        {
-          res= TRUE;
-          break;
-        }
-        thd->change_item_tree(&derived->field_translation[i].item, item);
-      }
-    }
+    /* reset translation table to materialized table */
+    if (!res && derived->field_translation)
+      res= reset_field_translation_to_table(thd, derived);
+
+    if (!res && derived->with && thd->variables.share_cte_materialization)
+      res= share_cte_materialization(thd, derived);
   }
 err:
   if (res || (!lex->describe && !unit->uncacheable &&
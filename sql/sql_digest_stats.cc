@@ -0,0 +1,408 @@
+/* Copyright (c) 2019, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/**
+  @file
+
+  Server level statistics of statements by digest.
+
+  The statistics are kept for at most digest_stats_size digests, the least
+  recently executed digests are evicted. They are split into instances by
+  the digest, each with its own mutex, hash and LRU list, so that statements
+  with different digests don't serialize on a single mutex. The limit
+  applies to each instance proportionally.
+
+  The digest of a statement is computed by the parser, see parse_sql().
+*/
+
+#include "mariadb.h"
+#include "sql_class.h"
+#include "sql_digest.h"
+#include "sql_digest_stream.h"
+#include "sql_digest_stats.h"
+#include "sql_list.h"
+
+ulong digest_stats_size;
+ulong digest_stats_histogram_base;
+
+#define DIGEST_STATS_INSTANCES 16
+
+struct Digest_stats_element
+{
+  Digest_stats stats;
+  char *text;
+  size_t text_length;
+  Digest_stats_element *next, **prev;
+};
+
+struct Digest_stats_instance
+{
+  /** Protects hash, lru and the elements in them */
+  mysql_mutex_t LOCK_digest_stats;
+  HASH hash;
+  /** Least recently executed digests first */
+  I_P_List <Digest_stats_element,
+            I_P_List_adapter<Digest_stats_element,
+                             &Digest_stats_element::next,
+                             &Digest_stats_element::prev>,
+            I_P_List_null_counter,
+            I_P_List_fast_push_back<Digest_stats_element> > lru;
+  /** Avoid false sharing between instances */
+  char pad[CPU_LEVEL1_DCACHE_LINESIZE];
+};
+
+static Digest_stats_instance digest_stats_instances[DIGEST_STATS_INSTANCES];
+
+/** Upper bounds of the histogram buckets, in microseconds */
+static ulonglong digest_stats_bounds[DIGEST_STATS_BUCKETS];
+
+#ifdef HAVE_PSI_INTERFACE
+static PSI_mutex_key key_LOCK_digest_stats;
+static PSI_mutex_info all_digest_stats_mutexes[]=
+{
+  { &key_LOCK_digest_stats, "LOCK_digest_stats", 0 }
+};
+#endif
+
+
+static Digest_stats_instance *digest_stats_instance(const uchar *md5)
+{
+  return &digest_stats_instances[md5[0] % DIGEST_STATS_INSTANCES];
+}
+
+
+extern "C" void free_digest_stats_element(Digest_stats_element *element)
+{
+  my_free(element);
+}
+
+
+void digest_stats_init()
+{
+#ifdef HAVE_PSI_INTERFACE
+  mysql_mutex_register("sql", all_digest_stats_mutexes,
+                       array_elements(all_digest_stats_mutexes));
+#endif
+  ulonglong bound= 1;
+  for (uint i= 0; i < DIGEST_STATS_BUCKETS - 1; i++)
+  {
+    digest_stats_bounds[i]= bound;
+    bound= bound > ULONGLONG_MAX / digest_stats_histogram_base ?
+           ULONGLONG_MAX : bound * digest_stats_histogram_base;
+  }
+  digest_stats_bounds[DIGEST_STATS_BUCKETS - 1]= ULONGLONG_MAX;
+
+  for (uint i= 0; i < DIGEST_STATS_INSTANCES; i++)
+  {
+    Digest_stats_instance *instance= &digest_stats_instances[i];
+    mysql_mutex_init(key_LOCK_digest_stats, &instance->LOCK_digest_stats,
+                     MY_MUTEX_INIT_FAST);
+    my_hash_init(&instance->hash, &my_charset_bin, 64,
+                 offsetof(Digest_stats_element, stats.md5), MD5_HASH_SIZE,
+                 0, (my_hash_free_key) free_digest_stats_element, 0);
+    instance->lru.empty();
+  }
+}
+
+
+void digest_stats_free()
+{
+  if (!my_hash_inited(&digest_stats_instances[0].hash))
+    return;
+  for (uint i= 0; i < DIGEST_STATS_INSTANCES; i++)
+  {
+    Digest_stats_instance *instance= &digest_stats_instances[i];
+    instance->lru.empty();
+    my_hash_free(&instance->hash);
+    mysql_mutex_destroy(&instance->LOCK_digest_stats);
+  }
+}
+
+
+/**
+  Forget the statistics of all digests.
+*/
+
+void digest_stats_reset()
+{
+  for (uint i= 0; i < DIGEST_STATS_INSTANCES; i++)
+  {
+    Digest_stats_instance *instance= &digest_stats_instances[i];
+    mysql_mutex_lock(&instance->LOCK_digest_stats);
+    instance->lru.empty();
+    my_hash_reset(&instance->hash);
+    mysql_mutex_unlock(&instance->LOCK_digest_stats);
+  }
+}
+
+
+/**
+  Create the element for a digest, with the digest text.
+
+  @return the element, or NULL if out of memory
+*/
+
+static Digest_stats_element *
+new_digest_stats_element(const sql_digest_storage *digest, const uchar *md5)
+{
+  Digest_stats_element *element;
+  char *text;
+  StringBuffer<256> digest_text;
+
+  compute_digest_text(digest, &digest_text);
+  if (!my_multi_malloc(MYF(0),
+                       &element, sizeof(Digest_stats_element),
+                       &text, digest_text.length() + 1,
+                       NullS))
+    return NULL;
+  bzero(&element->stats, sizeof(element->stats));
+  memcpy(element->stats.md5, md5, MD5_HASH_SIZE);
+  element->stats.min_time= ULONGLONG_MAX;
+  element->text= text;
+  element->text_length= digest_text.length();
+  memcpy(text, digest_text.ptr(), digest_text.length());
+  text[digest_text.length()]= 0;
+  return element;
+}
+
+
+/**
+  Account the statement that has just been executed to its digest.
+
+  Nothing is done unless the parser has computed the digest of the
+  statement.
+*/
+
+void digest_stats_update(THD *thd)
+{
+  sql_digest_storage *digest;
+  uchar md5[MD5_HASH_SIZE];
+  ulonglong time, parse_time, lock_time;
+  uint bucket;
+  Digest_stats_element *element, *new_element= NULL;
+  Digest_stats_instance *instance;
+  ulong limit= digest_stats_size;
+  DBUG_ENTER("digest_stats_update");
+
+  if (!limit || !thd->m_digest || thd->in_sub_stmt)
+    DBUG_VOID_RETURN;
+  digest= &thd->m_digest->m_digest_storage;
+  if (digest->is_empty())
+    DBUG_VOID_RETURN;
+
+  compute_digest_md5(digest, md5);
+  instance= digest_stats_instance(md5);
+  limit= MY_MAX(limit / DIGEST_STATS_INSTANCES, 1);
+  time= thd->utime_after_query > thd->start_utime ?
+        thd->utime_after_query - thd->start_utime : 0;
+  /* utime_after_parse is older than start_utime if it wasn't parsed */
+  parse_time= thd->utime_after_parse > thd->start_utime ?
+              thd->utime_after_parse - thd->start_utime : 0;
+  /* Like Lock_time of the slow query log */
+  lock_time= thd->utime_after_lock > thd->start_utime ?
+             thd->utime_after_lock - thd->start_utime : 0;
+  for (bucket= 0; bucket < DIGEST_STATS_BUCKETS - 1; bucket++)
+    if (time < digest_stats_bounds[bucket])
+      break;
+
+  mysql_mutex_lock(&instance->LOCK_digest_stats);
+  while (!(element= (Digest_stats_element*)
+                    my_hash_search(&instance->hash, md5, MD5_HASH_SIZE)))
+  {
+    if (new_element)
+    {
+      while (instance->hash.records >= limit)
+      {
+        Digest_stats_element *oldest= instance->lru.pop_front();
+        my_hash_delete(&instance->hash, (uchar*) oldest);
+      }
+      if (my_hash_insert(&instance->hash, (uchar*) new_element))
+      {
+        mysql_mutex_unlock(&instance->LOCK_digest_stats);
+        my_free(new_element);
+        DBUG_VOID_RETURN;
+      }
+      instance->lru.push_back(new_element);
+      element= new_element;
+      new_element= NULL;
+      break;
+    }
+    /* Don't compute the digest text under the mutex */
+    mysql_mutex_unlock(&instance->LOCK_digest_stats);
+    if (!(new_element= new_digest_stats_element(digest, md5)))
+      DBUG_VOID_RETURN;
+    mysql_mutex_lock(&instance->LOCK_digest_stats);
+  }
+  if (element->next)
+  {
+    instance->lru.remove(element);
+    instance->lru.push_back(element);
+  }
+
+  Digest_stats *stats= &element->stats;
+  stats->count++;
+  if (thd->get_stmt_da()->is_error())
+    stats->errors++;
+  stats->rows_sent+= thd->get_sent_row_count();
+  stats->rows_examined+= thd->get_examined_row_count();
+  stats->sum_time+= time;
+  stats->sum_parse_time+= parse_time;
+  stats->sum_lock_time+= lock_time;
+  set_if_smaller(stats->min_time, time);
+  set_if_bigger(stats->max_time, time);
+  stats->histogram[bucket]++;
+  mysql_mutex_unlock(&instance->LOCK_digest_stats);
+
+  /* Another thread has added the digest meanwhile */
+  my_free(new_element);
+  DBUG_VOID_RETURN;
+}
+
+
+/**
+  Get a copy of the statistics of a digest.
+
+  @retval false  found, copied to stats
+  @retval true   the digest has no statistics
+*/
+
+bool digest_stats_get(const uchar *md5, Digest_stats *stats)
+{
+  Digest_stats_instance *instance= digest_stats_instance(md5);
+  Digest_stats_element *element;
+
+  mysql_mutex_lock(&instance->LOCK_digest_stats);
+  if ((element= (Digest_stats_element*)
+                my_hash_search(&instance->hash, md5, MD5_HASH_SIZE)))
+    *stats= element->stats;
+  mysql_mutex_unlock(&instance->LOCK_digest_stats);
+  return element == NULL;
+}
+
+
+/**
+  Call action for the statistics of every digest.
+
+  The action is called under the mutex of the instance of the digest, and
+  thus must not execute statements.
+
+  @retval false  ok
+  @retval true   action returned true, the iteration was stopped
+*/
+
+bool digest_stats_iterate(digest_stats_action action, void *arg)
+{
+  for (uint i= 0; i < DIGEST_STATS_INSTANCES; i++)
+  {
+    Digest_stats_instance *instance= &digest_stats_instances[i];
+    bool res= false;
+
+    mysql_mutex_lock(&instance->LOCK_digest_stats);
+    for (ulong j= 0; !res && j < instance->hash.records; j++)
+    {
+      Digest_stats_element *element=
+        (Digest_stats_element*) my_hash_element(&instance->hash, j);
+      res= action(&element->stats, element->text, element->text_length, arg);
+    }
+    mysql_mutex_unlock(&instance->LOCK_digest_stats);
+    if (res)
+      return true;
+  }
+  return false;
+}
+
+
+/**
+  Decide whether a slow statement is one of the first ones of its digest
+  in the current sampling interval, see log_slow_digest_limit.
+
+  @param limit     statements of a digest to log in an interval
+  @param interval  length of the interval in seconds
+
+  @retval true   log the statement
+  @retval false  the statement has no digest statistics, or its digest has
+                 already logged limit statements in the interval
+*/
+
+bool digest_stats_sample_slow_log(THD *thd, ulong limit, ulong interval)
+{
+  sql_digest_storage *digest;
+  uchar md5[MD5_HASH_SIZE];
+  Digest_stats_instance *instance;
+  Digest_stats_element *element;
+  time_t now= thd->query_start();
+  bool res= false;
+
+  if (!digest_stats_size || !thd->m_digest)
+    return false;
+  digest= &thd->m_digest->m_digest_storage;
+  if (digest->is_empty())
+    return false;
+
+  compute_digest_md5(digest, md5);
+  instance= digest_stats_instance(md5);
+  mysql_mutex_lock(&instance->LOCK_digest_stats);
+  if ((element= (Digest_stats_element*)
+                my_hash_search(&instance->hash, md5, MD5_HASH_SIZE)))
+  {
+    Digest_stats *stats= &element->stats;
+    if (now - stats->slow_log_interval_start >= (time_t) interval)
+    {
+      stats->slow_log_interval_start= now;
+      stats->slow_log_sampled= 0;
+    }
+    if ((res= stats->slow_log_sampled < limit))
+      stats->slow_log_sampled++;
+  }
+  mysql_mutex_unlock(&instance->LOCK_digest_stats);
+  return res;
+}
+
+
+/**
+  Get the upper bound of a histogram bucket.
+
+  @return the bound in microseconds, or ULONGLONG_MAX for the last bucket
+*/
+
+ulonglong digest_stats_bucket_bound(uint bucket)
+{
+  DBUG_ASSERT(bucket < DIGEST_STATS_BUCKETS);
+  return digest_stats_bounds[bucket];
+}
+
+
+/**
+  Estimate a percentile of the execution time from the histogram.
+
+  @param fraction  percentile as a fraction, e.g. 0.99
+
+  @return upper bound of the histogram bucket with the percentile, in
+          microseconds, bounded by the maximum time seen
+*/
+
+ulonglong Digest_stats::percentile_time(double fraction) const
+{
+  ulonglong rank= (ulonglong) (fraction * count + 0.5);
+  ulonglong seen= 0;
+
+  set_if_bigger(rank, 1);
+  for (uint i= 0; i < DIGEST_STATS_BUCKETS - 1; i++)
+  {
+    if ((seen+= histogram[i]) >= rank)
+      return MY_MIN(digest_stats_bounds[i], max_time);
+  }
+  return max_time;
+}
@@ -0,0 +1,73 @@
+/* Copyright (c) 2019, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef SQL_DIGEST_STATS_INCLUDED
+#define SQL_DIGEST_STATS_INCLUDED
+
+#include "my_md5.h"
+
+class THD;
+
+/**
+  Number of buckets of the latency histogram of a digest.
+
+  Bucket i counts the statements that took less than
+  digest_stats_histogram_base^i microseconds, the last bucket counts all
+  the longer ones.
+*/
+#define DIGEST_STATS_BUCKETS 32
+
+/**
+  Statistics of the statements that have the same digest
+*/
+
+struct Digest_stats
+{
+  uchar md5[MD5_HASH_SIZE];
+  ulonglong count;
+  ulonglong errors;
+  ulonglong rows_sent;
+  ulonglong rows_examined;
+  /* Execution time in microseconds */
+  ulonglong sum_time, min_time, max_time;
+  /* Time spent in the parser and until the tables were locked */
+  ulonglong sum_parse_time, sum_lock_time;
+  ulonglong histogram[DIGEST_STATS_BUCKETS];
+  /* Start of the slow log sampling interval and statements logged in it */
+  time_t slow_log_interval_start;
+  ulong slow_log_sampled;
+
+  ulonglong percentile_time(double fraction) const;
+};
+
+typedef my_bool (*digest_stats_action)(const Digest_stats *stats,
+                                       const char *text, size_t text_length,
+                                       void *arg);
+
+/** Maximum number of digests kept, 0 disables the statistics */
+extern ulong digest_stats_size;
+/** Base of the upper bounds of the histogram buckets */
+extern ulong digest_stats_histogram_base;
+
+void digest_stats_init();
+void digest_stats_free();
+void digest_stats_update(THD *thd);
+bool digest_stats_get(const uchar *md5, Digest_stats *stats);
+bool digest_stats_iterate(digest_stats_action action, void *arg);
+void digest_stats_reset();
+ulonglong digest_stats_bucket_bound(uint bucket);
+bool digest_stats_sample_slow_log(THD *thd, ulong limit, ulong interval);
+
+#endif /* SQL_DIGEST_STATS_INCLUDED */
@@ -210,26 +210,48 @@ int Explain_query::print_explain(select_result_sink *output,
 }
 
 
-void Explain_query::print_explain_json(select_result_sink *output,
-                                       bool is_analyze)
+/*
+  Write the JSON EXPLAIN output to a Json_writer
+
+  @return true if there is no query plan
+*/
+
+bool Explain_query::print_explain_json(Json_writer *writer, bool is_analyze)
 {
-  Json_writer writer;
-  writer.start_object();
+  writer->start_object();
+
+  if (is_analyze && optimization_time_tracker.get_loops())
+  {
+    writer->add_member("query_optimization").start_object();
+    writer->add_member("r_total_time_ms").
+            add_double(optimization_time_tracker.get_time_ms());
+    writer->end_object();
+  }
 
   if (upd_del_plan)
-    upd_del_plan->print_explain_json(this, &writer, is_analyze);
+    upd_del_plan->print_explain_json(this, writer, is_analyze);
   else if (insert_plan)
-    insert_plan->print_explain_json(this, &writer, is_analyze);
+    insert_plan->print_explain_json(this, writer, is_analyze);
   else
   {
     /* Start printing from node with id=1 */
     Explain_node *node= get_node(1);
     if (!node)
-      return; /* No query plan */
-    node->print_explain_json(this, &writer, is_analyze);
+      return true; /* No query plan */
+    node->print_explain_json(this, writer, is_analyze);
   }
 
-  writer.end_object();
+  writer->end_object();
+  return false;
+}
+
+
+void Explain_query::print_explain_json(select_result_sink *output,
+                                       bool is_analyze)
+{
+  Json_writer writer;
+  if (print_explain_json(&writer, is_analyze))
+    return;
 
   CHARSET_INFO *cs= system_charset_info;
   List<Item> item_list;
@@ -247,6 +269,34 @@ bool print_explain_for_slow_log(LEX *lex, THD *thd, String *str)
 }
 
 
+/*
+  Return the ANALYZE FORMAT=JSON output as comment lines for the slow log
+*/
+
+bool print_explain_json_for_slow_log(LEX *lex, THD *thd, String *str)
+{
+  Json_writer writer;
+  if (lex->explain->print_explain_json(&writer, /*is_analyze*/ true))
+    return true;
+
+  const char *line= writer.output.ptr();
+  const char *end= line + writer.output.length();
+  str->append("#\n");
+  while (line < end)
+  {
+    const char *eol= (const char*) memchr(line, '\n', end - line);
+    if (!eol)
+      eol= end;
+    str->append(STRING_WITH_LEN("# explain_json: "));
+    str->append(line, eol - line);
+    str->append('\n');
+    line= eol + 1;
+  }
+  str->append("#\n");
+  return false;
+}
+
+
 /* 
   Return tabular EXPLAIN output as a text string
 */
@@ -1481,6 +1531,8 @@ void Explain_table_access::tag_to_json(Json_writer *writer, enum explain_extra_t
       /* Handled as "duplicates_removal: { ... } */
     case ET_FULL_SCAN_ON_NULL_KEY:
       /* Handled in full_scan_on_null_key */
+    case ET_USING_ROWID_FILTER:
+      /* Handled as "rowid_filter: { ... }" */
       break;
     case ET_FIRST_MATCH:
       writer->add_member("first_match").add_str(firstmatch_table_name.c_ptr());
@@ -1517,6 +1569,9 @@ void Explain_table_access::tag_to_json(Json_writer *writer, enum explain_extra_t
     case ET_IMPOSSIBLE_ON_CONDITION:
       writer->add_member("impossible_on_condition").add_bool(true);
       break;
+    case ET_USING_SKIP_SCAN:
+      writer->add_member("using_index_for_skip_scan").add_bool(true);
+      break;
     case ET_USING_WHERE_WITH_PUSHED_CONDITION:
       /*
         It would be nice to print the pushed condition, but current Storage
@@ -1644,6 +1699,13 @@ void Explain_table_access::print_explain_json(Explain_query *query,
   if (!ref_list.is_empty())
     print_json_array(writer, "ref", ref_list);
 
+  if (rowid_filter)
+  {
+    writer->add_member("rowid_filter").start_object();
+    rowid_filter->print_explain_json(writer, is_analyze);
+    writer->end_object();
+  }
+
   /* r_loops (not present in tabular output) */
   if (is_analyze)
   {
@@ -1822,6 +1884,9 @@ const char * extra_tag_text[]=
   "Const row not found",
   "Unique row not found",
   "Impossible ON condition",
+
+  "Using rowid filter",
+  "Using index for skip scan",
 };
 
 
@@ -1905,7 +1970,8 @@ void Explain_quick_select::print_extra(String *str)
 {
   if (quick_type == QUICK_SELECT_I::QS_TYPE_RANGE || 
       quick_type == QUICK_SELECT_I::QS_TYPE_RANGE_DESC ||
-      quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX)
+      quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX ||
+      quick_type == QUICK_SELECT_I::QS_TYPE_SKIP_SCAN)
   {
     /* print nothing */
   }
@@ -1991,7 +2057,8 @@ void Explain_quick_select::print_key(String *str)
 {
   if (quick_type == QUICK_SELECT_I::QS_TYPE_RANGE || 
       quick_type == QUICK_SELECT_I::QS_TYPE_RANGE_DESC || 
-      quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX)
+      quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX ||
+      quick_type == QUICK_SELECT_I::QS_TYPE_SKIP_SCAN)
   {
     if (str->length() > 0)
       str->append(',');
@@ -2017,7 +2084,8 @@ void Explain_quick_select::print_key_len(String *str)
 {
   if (quick_type == QUICK_SELECT_I::QS_TYPE_RANGE || 
       quick_type == QUICK_SELECT_I::QS_TYPE_RANGE_DESC ||
-      quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX)
+      quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX ||
+      quick_type == QUICK_SELECT_I::QS_TYPE_SKIP_SCAN)
   {
     char buf[64];
     size_t length;
@@ -2516,3 +2584,26 @@ void Explain_range_checked_fer::print_json(Json_writer *writer,
     writer->end_object();
   }
 }
+
+
+void Explain_rowid_filter::print_explain_json(Json_writer *writer,
+                                              bool is_analyze)
+{
+  writer->add_member("key").add_str(key_name);
+  writer->add_member("rows").add_ll(rows);
+  writer->add_member("selectivity_pct").add_double(selectivity * 100.0);
+  if (is_analyze)
+  {
+    writer->add_member("r_rows");
+    if (tracker.r_builds)
+      writer->add_double(tracker.get_avg_elements());
+    else
+      writer->add_null();
+    writer->add_member("r_lookups").add_ll(tracker.r_lookups);
+    writer->add_member("r_selectivity_pct");
+    if (tracker.has_lookups())
+      writer->add_double(tracker.get_r_selectivity() * 100.0);
+    else
+      writer->add_null();
+  }
+}
@@ -473,6 +473,7 @@ class Explain_query : public Sql_alloc
   bool print_explain_str(THD *thd, String *out_str, bool is_analyze);
 
   void print_explain_json(select_result_sink *output, bool is_analyze);
+  bool print_explain_json(Json_writer *writer, bool is_analyze);
 
   /* If true, at least part of EXPLAIN can be printed */
   bool have_query_plan() { return insert_plan || upd_del_plan|| get_node(1) != NULL; }
@@ -481,6 +482,9 @@ class Explain_query : public Sql_alloc
 
   MEM_ROOT *mem_root;
 
+  /* Time spent in JOIN::optimize() of the top-level selects of ANALYZE */
+  Exec_time_tracker optimization_time_tracker;
+
   Explain_update *get_upd_del_plan() { return upd_del_plan; }
 private:
   /* Explain_delete inherits from Explain_update */
@@ -546,6 +550,9 @@ enum explain_extra_tag
   ET_UNIQUE_ROW_NOT_FOUND,
   ET_IMPOSSIBLE_ON_CONDITION,
 
+  ET_USING_ROWID_FILTER,
+  ET_USING_SKIP_SCAN,
+
   ET_total
 };
 
@@ -619,7 +626,8 @@ class Explain_quick_select : public Sql_alloc
   {
     return (quick_type == QUICK_SELECT_I::QS_TYPE_RANGE || 
             quick_type == QUICK_SELECT_I::QS_TYPE_RANGE_DESC ||
-            quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX);
+            quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX ||
+            quick_type == QUICK_SELECT_I::QS_TYPE_SKIP_SCAN);
   }
   
   /* This is used when quick_type == QUICK_SELECT_I::QS_TYPE_RANGE */
@@ -670,6 +678,26 @@ class Explain_range_checked_fer : public Sql_alloc
   void print_json(Json_writer *writer, bool is_analyze);
 };
 
+/*
+  EXPLAIN data structure for a rowid filter used when reading a table
+*/
+
+class Explain_rowid_filter : public Sql_alloc
+{
+public:
+  /* The index whose range is put into the filter */
+  const char *key_name;
+  /* Expected number of rowids in the filter */
+  ha_rows rows;
+  /* Expected fraction of the rows of the table that pass the filter */
+  double selectivity;
+
+  /* ANALYZE members */
+  Rowid_filter_tracker tracker;
+
+  void print_explain_json(Json_writer *writer, bool is_analyze);
+};
+
 /*
   EXPLAIN data structure for a single JOIN_TAB.
 */
@@ -689,7 +717,8 @@ class Explain_table_access : public Sql_alloc
     cache_cond(NULL),
     pushed_index_cond(NULL),
     sjm_nest(NULL),
-    pre_join_sort(NULL)
+    pre_join_sort(NULL),
+    rowid_filter(NULL)
   {}
   ~Explain_table_access() { delete sjm_nest; }
 
@@ -789,6 +818,9 @@ class Explain_table_access : public Sql_alloc
   */
   Explain_aggr_filesort *pre_join_sort;
 
+  /* Valid with ET_USING_ROWID_FILTER */
+  Explain_rowid_filter *rowid_filter;
+
   /* ANALYZE members */
 
   /* Tracker for reading the table */
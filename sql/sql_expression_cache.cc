@@ -33,6 +33,16 @@
   impact in the case when the cache is not applicable)
 */
 #define EXPCACHE_CHECK_HIT_RATIO_AFTER 200
+/**
+  Maximum number of lookups skipped after a window with a low hit ratio.
+  Skips start at EXPCACHE_CHECK_HIT_RATIO_AFTER and double after every
+  further bad window, so an unhelpful cache costs at most a few percent.
+*/
+#define EXPCACHE_MAX_SKIP_LOOKUPS (EXPCACHE_CHECK_HIT_RATIO_AFTER * 64)
+/**
+  Maximum record length of the caches that use an in-memory hash table
+*/
+#define EXPCACHE_HASH_MAX_RECORD_LENGTH 256
 
 /*
   Expression cache is used only for caching subqueries now, so its statistic
@@ -44,9 +54,13 @@ Expression_cache_tmptable::Expression_cache_tmptable(THD *thd,
                                                      List<Item> &dependants,
                                                      Item *value)
   :cache_table(NULL), table_thd(thd), tracker(NULL), items(dependants), val(value),
-   hit(0), miss(0), inited (0)
+   hit(0), miss(0), window_hit(0), window_miss(0), skip_left(0),
+   skip_length(EXPCACHE_CHECK_HIT_RATIO_AFTER), probed(0), hash_memory(0),
+   use_hash(0), inited (0)
 {
   DBUG_ENTER("Expression_cache_tmptable::Expression_cache_tmptable");
+  my_hash_clear(&hash);
+  clear_alloc_root(&hash_root);
   DBUG_VOID_RETURN;
 };
 
@@ -57,7 +71,9 @@ Expression_cache_tmptable::Expression_cache_tmptable(THD *thd,
 
 void Expression_cache_tmptable::disable_cache()
 {
-  if (cache_table->file->inited)
+  if (use_hash)
+    free_hash();
+  else if (cache_table->file->inited)
     cache_table->file->ha_index_end();
   free_tmp_table(table_thd, cache_table);
   cache_table= NULL;
@@ -67,6 +83,59 @@ void Expression_cache_tmptable::disable_cache()
 }
 
 
+/**
+  Set up the in-memory hash table if the cache can use it
+
+  @details
+  The hash table is keyed by the key images of the parameters, so it is
+  used only if equal images mean equal values: strings, which compare by
+  their collations, are left to the HEAP table. The records must be small
+  and without blobs, as they are copied whole into the hash table.
+
+  @retval FALSE OK (the hash table is used if use_hash is set)
+  @retval TRUE  Out of memory
+*/
+
+bool Expression_cache_tmptable::init_hash()
+{
+  if (!table_thd->variables.expression_cache_max_memory ||
+      cache_table->s->reclength > EXPCACHE_HASH_MAX_RECORD_LENGTH)
+    return FALSE;
+  for (Field **field= cache_table->field; *field; field++)
+  {
+    if (((*field)->flags & BLOB_FLAG) ||
+        (field != cache_table->field &&
+         (*field)->cmp_type() == STRING_RESULT))
+      return FALSE;
+  }
+
+  init_alloc_root(&hash_root, "expression_cache_hash", 4096, 0,
+                  MYF(MY_THREAD_SPECIFIC));
+  if (my_hash_init(&hash, &my_charset_bin, 64, 0, ref.key_length, NULL, NULL,
+                   HASH_THREAD_SPECIFIC))
+  {
+    free_root(&hash_root, MYF(0));
+    return TRUE;
+  }
+  use_hash= TRUE;
+  return FALSE;
+}
+
+
+/**
+  Free the in-memory hash table
+*/
+
+void Expression_cache_tmptable::free_hash()
+{
+  my_hash_free(&hash);
+  free_root(&hash_root, MYF(0));
+  table_thd->expr_cache_memory_used-= hash_memory;
+  hash_memory= 0;
+  use_hash= FALSE;
+}
+
+
 /**
   Field enumerator for TABLE::add_tmp_key
 
@@ -132,9 +201,9 @@ void Expression_cache_tmptable::init()
     DBUG_VOID_RETURN;
   }
 
-  if (cache_table->s->db_type() != heap_hton)
+  if (cache_table->s->db_type() != heap_hton || cache_table->s->blob_fields)
   {
-    DBUG_PRINT("error", ("we need only heap table"));
+    DBUG_PRINT("error", ("we need only heap table without blobs"));
     goto error;
   }
 
@@ -155,8 +224,13 @@ void Expression_cache_tmptable::init()
   ref.has_record= 0;
   ref.use_count= 0;
 
+  if (init_hash())
+  {
+    DBUG_PRINT("error", ("creating hash table failed"));
+    goto error;
+  }
 
-  if (open_tmp_table(cache_table))
+  if (!use_hash && open_tmp_table(cache_table))
   {
     DBUG_PRINT("error", ("Opening (creating) temporary table failed"));
     goto error;
@@ -216,26 +290,34 @@ Expression_cache::result Expression_cache_tmptable::check_value(Item **value)
 
   if (cache_table)
   {
-    DBUG_PRINT("info", ("status: %u  has_record %u",
-                        (uint)cache_table->status, (uint)ref.has_record));
-    if ((res= join_read_key2(table_thd, NULL, cache_table, &ref)) == 1)
-      DBUG_RETURN(ERROR);
+    if (skip_left)
+    {
+      DBUG_PRINT("info", ("hit rate is low, %lu lookups to skip", skip_left));
+      skip_left--;
+      probed= FALSE;
+      DBUG_RETURN(Expression_cache::MISS);
+    }
+    probed= TRUE;
 
-    if (res)
+    if (use_hash)
+      res= lookup_hash();
+    else
     {
-      if (((++miss) == EXPCACHE_CHECK_HIT_RATIO_AFTER) &&
-          ((double)hit / ((double)hit + miss)) <
-          EXPCACHE_MIN_HIT_RATE_FOR_MEM_TABLE)
-      {
-        DBUG_PRINT("info",
-                   ("Early check: hit rate is not so good to keep the cache"));
-        disable_cache();
-      }
+      DBUG_PRINT("info", ("status: %u  has_record %u",
+                          (uint)cache_table->status, (uint)ref.has_record));
+      if ((res= join_read_key2(table_thd, NULL, cache_table, &ref)) == 1)
+        DBUG_RETURN(ERROR);
+    }
 
+    if (res)
+    {
+      miss++;
+      check_window(FALSE);
       DBUG_RETURN(MISS);
     }
 
     hit++;
+    check_window(TRUE);
     *value= cached_result;
     DBUG_RETURN(Expression_cache::HIT);
   }
@@ -243,6 +325,120 @@ Expression_cache::result Expression_cache_tmptable::check_value(Item **value)
 }
 
 
+/**
+  Account a lookup in the current window of lookups
+
+  @param is_hit          TRUE if the lookup has found the parameters
+
+  @details
+  At the end of every window of EXPCACHE_CHECK_HIT_RATIO_AFTER lookups
+  the hit ratio of the window is checked. If it is too low to pay off,
+  the following lookups are skipped (the expression is just evaluated),
+  for twice as many lookups after every further bad window. A good window
+  resets the length of the skips.
+*/
+
+void Expression_cache_tmptable::check_window(bool is_hit)
+{
+  if (is_hit)
+    window_hit++;
+  else
+    window_miss++;
+  if (window_hit + window_miss < EXPCACHE_CHECK_HIT_RATIO_AFTER)
+    return;
+
+  if ((double) window_hit / ((double) window_hit + window_miss) <
+      EXPCACHE_MIN_HIT_RATE_FOR_MEM_TABLE)
+  {
+    DBUG_PRINT("info", ("hit rate is not so good to use the cache"));
+    skip_left= skip_length;
+    skip_length= MY_MIN(skip_length * 2, EXPCACHE_MAX_SKIP_LOOKUPS);
+  }
+  else
+    skip_length= EXPCACHE_CHECK_HIT_RATIO_AFTER;
+  window_hit= window_miss= 0;
+}
+
+
+/**
+  Look the current parameters up in the in-memory hash table
+
+  @details
+  On success the found record is copied to record[0] of the cache table,
+  where cached_result reads the value from.
+
+  @retval 0   found
+  @retval -1  not found
+*/
+
+int Expression_cache_tmptable::lookup_hash()
+{
+  uchar *entry;
+  if ((ref.key_err= cp_buffer_from_ref(table_thd, cache_table, &ref)) ||
+      !(entry= my_hash_search(&hash, ref.key_buff, ref.key_length)))
+    return -1;
+  memcpy(cache_table->record[0], entry + ref.key_length,
+         cache_table->s->reclength);
+  return 0;
+}
+
+
+/**
+  Put the record in record[0] into the in-memory hash table
+
+  @details
+  The record is stored under the key image made by the lookup that has
+  missed it. When the memory of the expression caches of the statement
+  is exhausted, the cache is either disabled, if it has a poor hit rate,
+  or emptied to make room, as a full HEAP table would be.
+
+  @retval FALSE OK
+  @retval TRUE  Error
+*/
+
+my_bool Expression_cache_tmptable::put_hash()
+{
+  size_t entry_length= ref.key_length + cache_table->s->reclength;
+  ulonglong entry_memory= entry_length + HASH_OVERHEAD;
+  uchar *entry;
+
+  if (ref.key_err)
+    return FALSE;                               // can't be found anyway
+
+  if (table_thd->expr_cache_memory_used + entry_memory >
+      table_thd->variables.expression_cache_max_memory)
+  {
+    double hit_rate= ((double)hit / ((double)hit + miss));
+    DBUG_ASSERT(miss > 0);
+    if (hit_rate < EXPCACHE_MIN_HIT_RATE_FOR_MEM_TABLE)
+    {
+      DBUG_PRINT("info", ("hit rate is not so good to keep the cache"));
+      disable_cache();
+      return FALSE;
+    }
+    my_hash_reset(&hash);
+    free_root(&hash_root, MYF(MY_KEEP_PREALLOC));
+    table_thd->expr_cache_memory_used-= hash_memory;
+    hash_memory= 0;
+    /* The other caches of the statement may have taken all the memory */
+    if (table_thd->expr_cache_memory_used + entry_memory >
+        table_thd->variables.expression_cache_max_memory)
+      return FALSE;
+  }
+
+  if (!(entry= (uchar*) alloc_root(&hash_root, entry_length)))
+    return TRUE;
+  memcpy(entry, ref.key_buff, ref.key_length);
+  memcpy(entry + ref.key_length, cache_table->record[0],
+         cache_table->s->reclength);
+  if (my_hash_insert(&hash, entry))
+    return TRUE;
+  hash_memory+= entry_memory;
+  table_thd->expr_cache_memory_used+= entry_memory;
+  return FALSE;
+}
+
+
 /**
   Put a new entry into the expression cache
 
@@ -267,12 +463,24 @@ my_bool Expression_cache_tmptable::put_value(Item *value)
     DBUG_PRINT("info", ("No table so behave as we successfully put value"));
     DBUG_RETURN(FALSE);
   }
+  if (!probed)
+  {
+    DBUG_PRINT("info", ("The lookup was skipped, so is the value"));
+    DBUG_RETURN(FALSE);
+  }
 
   *(items.head_ref())= value;
   fill_record(table_thd, cache_table, cache_table->field, items, TRUE, TRUE);
   if (unlikely(table_thd->is_error()))
     goto err;;
 
+  if (use_hash)
+  {
+    if (put_hash())
+      goto err;
+    DBUG_RETURN(FALSE);
+  }
+
   if (unlikely((error=
                 cache_table->file->ha_write_tmp_row(cache_table->record[0]))))
   {
@@ -101,6 +101,18 @@ class Expression_cache_tracker :public Sql_alloc
 
 /**
   Implementation of expression cache over a temporary table
+
+  @details
+  When the parameters of the expression are of small fixed-size types, the
+  index of the temporary table is replaced by an in-memory hash table from
+  the key images of the parameters to the records of the table, and the
+  HEAP table itself is never created. The memory of these hash tables is
+  limited for all caches of a statement together by
+  expression_cache_max_memory.
+
+  The cache stops probing and filling itself for a while when the hit rate
+  of the last EXPCACHE_CHECK_HIT_RATIO_AFTER lookups was low, and resumes
+  afterwards, as the hit rate may change with the outer rows.
 */
 
 class Expression_cache_tmptable :public Expression_cache
@@ -133,6 +145,11 @@ class Expression_cache_tmptable :public Expression_cache
 
 private:
   void disable_cache();
+  bool init_hash();
+  void free_hash();
+  int lookup_hash();
+  my_bool put_hash();
+  void check_window(bool is_hit);
 
   /* tmp table parameters */
   TMP_TABLE_PARAM cache_table_param;
@@ -152,6 +169,18 @@ class Expression_cache_tmptable :public Expression_cache
   Item *val;
   /* hit/miss counters */
   ulong hit, miss;
+  /* hit/miss counters of the current window of lookups */
+  ulong window_hit, window_miss;
+  /* Number of lookups left to skip, and the length of the next skip */
+  ulong skip_left, skip_length;
+  /* Set if the last check_value() has looked the parameters up */
+  bool probed;
+  /* In-memory hash table over the key images, used instead of the index */
+  HASH hash;
+  MEM_ROOT hash_root;
+  /* Memory used by the hash table, accounted in THD::expr_cache_memory_used */
+  ulonglong hash_memory;
+  bool use_hash;
   /* Set on if the object has been succesfully initialized with init() */
   bool inited;
 };
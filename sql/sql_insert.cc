@@ -1649,6 +1649,40 @@ int vers_insert_history_row(TABLE *table)
   return table->file->ha_write_row(table->record[0]);
 }
 
+/**
+  Find the unique key on which write_record() can look up a conflicting
+  row before inserting a new one.
+
+  The lookup is only correct when the table has a single unique key, as
+  a row that is not found on it could conflict on another key, and when
+  the key value is known before the insert, so not with AUTO_INCREMENT
+  or NULL values.
+
+  @return number of the key, MAX_KEY if there is none
+*/
+
+static uint duplicate_probe_key(TABLE *table)
+{
+  uint probe_key= MAX_KEY;
+
+  /* Engines with HA_DUPLICATE_POS find the conflicting row cheaply */
+  if (table->next_number_field || table->versioned() ||
+      (table->file->ha_table_flags() & HA_DUPLICATE_POS))
+    return MAX_KEY;
+
+  for (uint keynr= 0; keynr < table->s->keys; keynr++)
+  {
+    if (!(table->key_info[keynr].flags & HA_NOSAME))
+      continue;
+    if (probe_key != MAX_KEY ||
+        (table->key_info[keynr].flags & HA_NULL_PART_KEY))
+      return MAX_KEY;
+    probe_key= keynr;
+  }
+  return probe_key;
+}
+
+
 /*
   Write a record to table with optional deleting of conflicting records,
   invoke proper triggers if needed.
@@ -3373,7 +3373,7 @@ int JOIN_TAB_SCAN::open()
 int JOIN_TAB_SCAN::next()
 {
   int err= 0;
-  int skip_rc;
+  int skip_rc= 0;
   READ_RECORD *info= &join_tab->read_record;
   SQL_SELECT *select= join_tab->cache_select;
   THD *thd= join->thd;
@@ -3388,13 +3388,16 @@ int JOIN_TAB_SCAN::next()
     join_tab->tracker->r_rows++;
   }
 
-  while (!err && select && (skip_rc= select->skip_record(thd)) <= 0)
+  while (!err &&
+         (!cache->may_have_matches_by_join_key() ||
+          (select && (skip_rc= select->skip_record(thd)) <= 0)))
   {
     if (unlikely(thd->check_killed()) || skip_rc < 0)
       return 1;
     /* 
-      Move to the next record if the last retrieved record does not
-      meet the condition pushed to the table join_tab.
+      Move to the next record if the last retrieved record cannot match
+      any record in the join buffer or does not meet the condition pushed
+      to the table join_tab.
     */
     err= info->read_record();
     if (!err)
@@ -3659,6 +3662,33 @@ uchar *JOIN_CACHE_BNLH::get_matching_chain_by_join_key()
 }
 
 
+/*
+  Check whether the current record of join_tab may have matches in the buffer
+
+  SYNOPSIS
+    may_have_matches_by_join_key()
+
+  DESCRIPTION
+    The function looks for the join key built from the record of join_tab
+    in the hash table of the join cache and remembers the found chain of
+    matching records in the member curr_matching_chain. As the function is
+    called by JOIN_TAB_SCAN::next() for every record of join_tab before
+    the condition pushed to join_tab is checked for it, the records whose
+    join key is not in the buffer are rejected without evaluating the
+    condition, and prepare_look_for_matches does not have to repeat the
+    search.
+
+  RETURN VALUE
+    TRUE    the join buffer contains records with the join key of the record
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::may_have_matches_by_join_key()
+{
+  return (curr_matching_chain= get_matching_chain_by_join_key()) != 0;
+}
+
+
 /*
   Prepare to iterate over the BNLH join cache buffer to look for matches 
 
@@ -3673,11 +3703,11 @@ uchar *JOIN_CACHE_BNLH::get_matching_chain_by_join_key()
     has been placed into the record buffer of the joined table.
     If the value of the parameter skip_last is TRUE then the last
     record from the join buffer is ignored.
-    The function builds the hashed key from the join fields of join_tab
-    and uses this key to look in the hash table of the join cache for
-    the chain of matching records in in the join buffer. If it finds
-    such a chain it sets  the member last_rec_ref_ptr to point to the
-    last link of the chain while setting the member next_rec_ref_po 0.
+    The function takes the chain of matching records in the join buffer
+    that has been found by may_have_matches_by_join_key for the hashed key
+    built from the join fields of join_tab. If there is such a chain it
+    sets the member last_rec_ref_ptr to point to the last link of the chain
+    while setting the member next_rec_ref_po 0.
     
   RETURN VALUE    
     TRUE    there are no matching records in the buffer to iterate over 
@@ -3686,9 +3716,8 @@ uchar *JOIN_CACHE_BNLH::get_matching_chain_by_join_key()
     
 bool JOIN_CACHE_BNLH::prepare_look_for_matches(bool skip_last)
 {
-  uchar *curr_matching_chain;
   last_matching_rec_ref_ptr= next_matching_rec_ref_ptr= 0;
-  if (!(curr_matching_chain= get_matching_chain_by_join_key()))
+  if (!curr_matching_chain)
     return 1;
   last_matching_rec_ref_ptr= get_next_rec_ref(curr_matching_chain); 
   return 0;
@@ -488,6 +488,14 @@ class JOIN_CACHE :public Sql_alloc
     match the record of the joined table read into the record buffer
   */ 
   virtual bool prepare_look_for_matches(bool skip_last)= 0;
+  /*
+    Shall check whether the record of the joined table read into the record
+    buffer may have matches in the join buffer judging by its join key only.
+    This is called before the condition pushed to the joined table is
+    evaluated, so that the condition is not evaluated for the records that
+    cannot be joined anyway.
+  */
+  virtual bool may_have_matches_by_join_key() { return TRUE; }
   /* 
     Shall return a pointer to the record from join buffer that is checked
     as the next candidate for a match with the current record from join_tab.
@@ -1163,6 +1171,12 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     list.
   */
   uchar *next_matching_rec_ref_ptr;
+  /*
+    The chain of records from the join buffer matching the join key of
+    the record of join_tab last checked by may_have_matches_by_join_key(),
+    or 0 if there are no such records
+  */
+  uchar *curr_matching_chain;
 
   /*
     Get the chain of records from buffer matching the current candidate
@@ -1170,6 +1184,8 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
   */
   uchar *get_matching_chain_by_join_key();
 
+  bool may_have_matches_by_join_key();
+
   bool prepare_look_for_matches(bool skip_last);
 
   uchar *get_next_candidate_for_match();
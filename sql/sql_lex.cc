@@ -2376,6 +2376,7 @@ void st_select_lex::init_query()
   first_execution= 1;
   first_natural_join_processing= 1;
   first_cond_optimization= 1;
+  cached_join_plan= 0;
   parsing_place= NO_MATTER;
   exclude_from_table_unique_test= no_wrap_view_item= FALSE;
   nest_level= 0;
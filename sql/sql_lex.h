@@ -807,6 +807,7 @@ typedef class st_select_lex_node SELECT_LEX_NODE;
 class THD;
 class select_result;
 class JOIN;
+class Cached_join_plan;
 class select_unit;
 class Procedure;
 class Explain_query;
@@ -815,6 +816,7 @@ void delete_explain_query(LEX *lex);
 void create_explain_query(LEX *lex, MEM_ROOT *mem_root);
 void create_explain_query_if_not_exists(LEX *lex, MEM_ROOT *mem_root);
 bool print_explain_for_slow_log(LEX *lex, THD *thd, String *str);
+bool print_explain_json_for_slow_log(LEX *lex, THD *thd, String *str);
 
 class st_select_lex_unit: public st_select_lex_node {
 protected:
@@ -1211,6 +1213,13 @@ class st_select_lex: public st_select_lex_node
   bool first_execution;
   bool first_natural_join_processing;
   bool first_cond_optimization;
+  /*
+    The join order chosen when this select was last optimized with a full
+    join order search, for reuse by the next executions of a prepared
+    statement or a stored procedure statement (see
+    optimizer_plan_cache_tolerance). Allocated on the statement arena.
+  */
+  Cached_join_plan *cached_join_plan;
   /* do not wrap view fields with Item_ref */
   bool no_wrap_view_item;
   /* exclude this select from check of unique_table() */
@@ -149,6 +149,46 @@ class READ_INFO: public Load_data_param
   int	*stack,*stack_pos;
   bool	found_end_of_line,start_of_line,eof;
   int level; /* for load xml */
+  /*
+    Bytes that read_field() must look at one by one: the escape character,
+    the first bytes of the terminators, the enclosing character and, for
+    multi-byte character sets, the non-ASCII bytes. Runs of other bytes
+    are copied from the read buffer at once.
+  */
+  bool special_byte[256];
+
+  void set_special_byte(int chr)
+  {
+    if (chr >= 0 && chr < (int) sizeof(special_byte))
+      special_byte[chr]= true;
+  }
+
+  /*
+    Append the bytes from the read buffer up to the next special byte,
+    leaving room for the longest multi-byte character in 'data'.
+
+    @return  the number of bytes appended
+  */
+  size_t read_plain_bytes()
+  {
+    if (stack_pos != stack)
+      return 0;
+    const uchar *start= cache.read_pos;
+    const uchar *end= cache.read_end;
+    size_t room= data.alloced_length() - data.length() - charset()->mbmaxlen;
+    if ((size_t) (end - start) > room)
+      end= start + room;
+    const uchar *pos= start;
+    while (pos < end && !special_byte[*pos])
+      pos++;
+    size_t length= pos - start;
+    if (length)
+    {
+      data.append((const char *) start, length);
+      cache.read_pos= (uchar *) pos;
+    }
+    return length;
+  }
 
   bool getbyte(char *to)
   {
@@ -1342,6 +1382,14 @@ READ_INFO::READ_INFO(THD *thd, File file_par,
     m_line_term.reset();
   enclosed_char= enclosed_par.length() ? (uchar) enclosed_par[0] : INT_MAX;
 
+  memset(special_byte, 0, sizeof(special_byte));
+  set_special_byte(escape_char);
+  set_special_byte(enclosed_char);
+  set_special_byte(m_field_term.initial_byte());
+  set_special_byte(m_line_term.initial_byte());
+  if (use_mb(charset()))
+    memset(special_byte + 0x80, 1, sizeof(special_byte) - 0x80);
+
   /* Set of a stack for unget if long terminators */
   uint length= MY_MAX(charset()->mbmaxlen, MY_MAX(m_field_term.length(),
                                                   m_line_term.length())) + 1;
@@ -1493,6 +1541,8 @@ int READ_INFO::read_field()
     // Make sure we have enough space for the longest multi-byte character.
     while (data.length() + charset()->mbmaxlen <= data.alloced_length())
     {
+      if (read_plain_bytes())
+        continue;
       chr = GET;
       if (chr == my_b_EOF)
 	goto found_eof;
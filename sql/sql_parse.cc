@@ -85,6 +85,7 @@
 #include "rpl_mi.h"
 
 #include "sql_digest.h"
+#include "sql_digest_stats.h"
 
 #include "sp_head.h"
 #include "sp.h"
@@ -1428,6 +1429,12 @@ bool do_command(THD *thd)
   DBUG_ASSERT(!thd->apc_target.is_enabled());
 
 out:
+  /*
+    Send the results of pipelined commands that ended with an error
+    before waiting for the next command, see net_flush_result().
+  */
+  if (net->vio && net->vio->corked && !net->vio->has_data(net->vio))
+    vio_cork(net->vio, FALSE);
   thd->lex->restore_set_statement_var();
   /* The statement instrumentation must be closed in all cases. */
   DBUG_ASSERT(thd->m_digest == NULL);
@@ -1876,6 +1883,7 @@ bool dispatch_command(enum enum_server_command command, THD *thd,
 
       ulong length= (ulong)(packet_end - beginning_of_next_stmt);
 
+      digest_stats_update(thd);
       log_slow_statement(thd);
       DBUG_ASSERT(!thd->apc_target.is_enabled());
 
@@ -1911,6 +1919,7 @@ bool dispatch_command(enum enum_server_command command, THD *thd,
 
       /* PSI begin */
       thd->m_digest= & thd->m_digest_state;
+      thd->m_digest->reset(thd->m_token_array, max_digest_length);
 
       thd->m_statement_psi= MYSQL_START_STATEMENT(&thd->m_statement_state,
                                                   com_statement_info[command].m_key,
@@ -2421,6 +2430,7 @@ bool dispatch_command(enum enum_server_command command, THD *thd,
 
   thd->update_all_stats();
 
+  digest_stats_update(thd);
   log_slow_statement(thd);
 
   THD_STAGE_INFO(thd, stage_cleaning_up);
@@ -2435,10 +2445,20 @@ bool dispatch_command(enum enum_server_command command, THD *thd,
   thd->m_digest= NULL;
 
   if (!is_com_multi)
-    thd->packet.shrink(thd->variables.net_buffer_length); // Reclaim some memory
+  {
+    /* Reclaim some memory, don't keep big buffers while the connection idles */
+    size_t packet_length= thd->packet.alloced_length();
+    thd->packet.shrink(thd->variables.net_buffer_length);
+    thd->status_var.buffer_memory_reclaimed+=
+      packet_length - thd->packet.alloced_length();
+#ifndef EMBEDDED_LIBRARY
+    thd->status_var.buffer_memory_reclaimed+=
+      net_shrink(&thd->net, thd->variables.net_buffer_length);
+#endif
+  }
 
   thd->reset_kill_query();  /* Ensure that killed_errmsg is released */
-  free_root(thd->mem_root,MYF(MY_KEEP_PREALLOC));
+  recycle_root(thd->mem_root, thd->variables.query_alloc_keep_size);
 
 #if defined(ENABLED_PROFILING)
   thd->profiling.finish_current_query();
@@ -2508,7 +2528,11 @@ void log_slow_statement(THD *thd)
       this query to the log or not.
     */ 
     if (thd->variables.log_slow_rate_limit > 1 &&
-        (global_query_id % thd->variables.log_slow_rate_limit) != 0)
+        (global_query_id % thd->variables.log_slow_rate_limit) != 0 &&
+        !(thd->variables.log_slow_digest_limit &&
+          digest_stats_sample_slow_log(thd,
+                                       thd->variables.log_slow_digest_limit,
+                                       opt_log_slow_digest_interval)))
       goto end;
 
     THD_STAGE_INFO(thd, stage_logging_slow_query);
@@ -8043,6 +8067,9 @@ void mysql_parse(THD *thd, char *rawbuf, uint length,
 
     bool err= parse_sql(thd, parser_state, NULL, true);
 
+    if (digest_stats_size)
+      thd->utime_after_parse= microsecond_interval_timer();
+
     if (likely(!err))
     {
       thd->m_statement_psi=
@@ -10086,13 +10113,15 @@ bool parse_sql(THD *thd, Parser_state *parser_state,
     /* Start Digest */
     parser_state->m_digest_psi= MYSQL_DIGEST_START(thd->m_statement_psi);
 
-    if (parser_state->m_input.m_compute_digest ||
-       (parser_state->m_digest_psi != NULL))
+    if ((parser_state->m_input.m_compute_digest ||
+         parser_state->m_digest_psi != NULL ||
+         digest_stats_size) && thd->m_digest != NULL)
     {
       /*
         If either:
         - the caller wants to compute a digest
         - the performance schema wants to compute a digest
+        - the digest statistics are collected
         set the digest listener in the lexer.
       */
       parser_state->m_lip.m_digest= thd->m_digest;
@@ -1187,11 +1187,120 @@ check_slave_start_position(binlog_send_info *info, const char **errormsg,
   return err;
 }
 
+/*
+  Adjust the slave connection state for starting to send events right after
+  the binlog state glev, i.e. at the start of a binlog file or at an entry of
+  its GTID index.
+*/
+static void
+gtid_adjust_start_state(slave_connection_state *state,
+                        Gtid_list_log_event *glev,
+                        slave_connection_state *until_gtid_state)
+{
+  uint32 i;
+
+  /*
+    As a special case, we allow to start from binlog file N if the
+    requested GTID is the last event (in the corresponding domain) in
+    binlog file (N-1), but then we need to remove that GTID from the slave
+    state, rather than skipping events waiting for it to turn up.
+
+    If slave is doing START SLAVE UNTIL, check for any UNTIL conditions
+    that are already included in a previous binlog file. Delete any such
+    from the UNTIL hash, to mark that such domains have already reached
+    their UNTIL condition.
+  */
+  for (i= 0; i < glev->count; ++i)
+  {
+    const rpl_gtid *gtid= state->find(glev->list[i].domain_id);
+    if (!gtid)
+    {
+      /*
+        Contains_all_slave_gtid() returns false if there is any domain in
+        Gtid_list_event which is not in the requested slave position.
+
+        We may delete a domain from the slave state inside this loop, but
+        we only do this when it is the very last GTID logged for that
+        domain in earlier binlogs, and then we can not encounter it in any
+        further GTIDs in the Gtid_list.
+      */
+      DBUG_ASSERT(0);
+    } else if (gtid->server_id == glev->list[i].server_id &&
+               gtid->seq_no == glev->list[i].seq_no)
+    {
+      /*
+        The slave requested to start from the very beginning of this
+        domain in this binlog file. So delete the entry from the state,
+        we do not need to skip anything.
+      */
+      state->remove(gtid);
+    }
+
+    if (until_gtid_state &&
+        (gtid= until_gtid_state->find(glev->list[i].domain_id)) &&
+        gtid->server_id == glev->list[i].server_id &&
+        gtid->seq_no <= glev->list[i].seq_no)
+    {
+      /*
+        We've already reached the stop position in UNTIL for this domain,
+        since it is before the start position.
+      */
+      until_gtid_state->remove(gtid);
+    }
+  }
+}
+
+
+/*
+  Find the last entry of the GTID index of the active binlog file log_name
+  whose binlog state contains all GTIDs requested by the slave, see
+  contains_all_slave_gtid(). Such entries come first in the index, as the
+  binlog state only grows.
+
+  Returns the binlog state of the entry and sets *out_pos to its offset, or
+  returns NULL if there is no such entry. Either way LOCK_binlog_end_pos is
+  left locked, for the caller to use the returned entry.
+*/
+static Gtid_list_log_event *
+gtid_index_find_start(const char *log_name, slave_connection_state *state,
+                      my_off_t *out_pos)
+{
+  const DYNAMIC_ARRAY *index;
+  Binlog_gtid_index_entry *entry= NULL;
+  uint low= 0, high;
+
+  mysql_bin_log.lock_binlog_end_pos();
+  if (!(index= mysql_bin_log.get_gtid_index(log_name)))
+    return NULL;
+  high= index->elements;
+  while (low < high)
+  {
+    uint mid= (low + high) / 2;
+    Binlog_gtid_index_entry *e=
+      dynamic_element(index, mid, Binlog_gtid_index_entry*);
+    if (contains_all_slave_gtid(state, e->glev))
+    {
+      entry= e;
+      low= mid + 1;
+    }
+    else
+      high= mid;
+  }
+  if (!entry)
+    return NULL;
+  *out_pos= entry->offset;
+  return entry->glev;
+}
+
+
 /*
   Find the name of the binlog file to start reading for a slave that connects
   using GTID state.
 
-  Returns the file name in out_name, which must be of size at least FN_REFLEN.
+  Returns the file name in out_name, which must be of size at least FN_REFLEN,
+  and the offset in it to start from in out_pos. The offset is past the
+  start of the file if the file is the active binlog file and its GTID index
+  has an entry before the slave position, see binlog_gtid_index_span.
 
   Returns NULL on ok, error message on error.
 
@@ -1216,6 +1325,7 @@ check_slave_start_position(binlog_send_info *info, const char **errormsg,
 */
 static const char *
 gtid_find_binlog_file(slave_connection_state *state, char *out_name,
+                      my_off_t *out_pos,
                       slave_connection_state *until_gtid_state)
 {
   MEM_ROOT memroot;
@@ -1271,59 +1381,14 @@ gtid_find_binlog_file(slave_connection_state *state, char *out_name,
     {
       strmake(out_name, buf, FN_REFLEN);
 
+      *out_pos= BIN_LOG_HEADER_SIZE;
       if (glev)
       {
-        uint32 i;
-
-        /*
-          As a special case, we allow to start from binlog file N if the
-          requested GTID is the last event (in the corresponding domain) in
-          binlog file (N-1), but then we need to remove that GTID from the slave
-          state, rather than skipping events waiting for it to turn up.
-
-          If slave is doing START SLAVE UNTIL, check for any UNTIL conditions
-          that are already included in a previous binlog file. Delete any such
-          from the UNTIL hash, to mark that such domains have already reached
-          their UNTIL condition.
-        */
-        for (i= 0; i < glev->count; ++i)
-        {
-          const rpl_gtid *gtid= state->find(glev->list[i].domain_id);
-          if (!gtid)
-          {
-            /*
-              Contains_all_slave_gtid() returns false if there is any domain in
-              Gtid_list_event which is not in the requested slave position.
-
-              We may delete a domain from the slave state inside this loop, but
-              we only do this when it is the very last GTID logged for that
-              domain in earlier binlogs, and then we can not encounter it in any
-              further GTIDs in the Gtid_list.
-            */
-            DBUG_ASSERT(0);
-          } else if (gtid->server_id == glev->list[i].server_id &&
-                     gtid->seq_no == glev->list[i].seq_no)
-          {
-            /*
-              The slave requested to start from the very beginning of this
-              domain in this binlog file. So delete the entry from the state,
-              we do not need to skip anything.
-            */
-            state->remove(gtid);
-          }
-
-          if (until_gtid_state &&
-              (gtid= until_gtid_state->find(glev->list[i].domain_id)) &&
-              gtid->server_id == glev->list[i].server_id &&
-              gtid->seq_no <= glev->list[i].seq_no)
-          {
-            /*
-              We've already reached the stop position in UNTIL for this domain,
-              since it is before the start position.
-            */
-            until_gtid_state->remove(gtid);
-          }
-        }
+        Gtid_list_log_event *start_glev=
+          gtid_index_find_start(buf, state, out_pos);
+        gtid_adjust_start_state(state, start_glev ? start_glev : glev,
+                                until_gtid_state);
+        mysql_bin_log.unlock_binlog_end_pos();
       }
 
       goto end;
@@ -2109,15 +2174,12 @@ static int init_binlog_sender(binlog_send_info *info,
       return 1;
     }
     if ((info->errmsg= gtid_find_binlog_file(&info->gtid_state,
-                                             search_file_name,
+                                             search_file_name, pos,
                                              info->until_gtid_state)))
     {
       info->error= ER_MASTER_FATAL_ERROR_READING_BINLOG;
       return 1;
     }
-
-    /* start from beginning of binlog file */
-    *pos = 4;
   }
   else
   {
@@ -2766,6 +2828,19 @@ void mysql_binlog_send(THD* thd, char* log_ident, my_off_t pos,
   */
   info->heartbeat_period= get_heartbeat_period(thd);
 
+  /*
+    Let the events be sent in bigger writes. Nothing has been written to
+    the slave yet, so there is no buffered data to lose in net_realloc().
+  */
+  if (binlog_dump_net_buffer_length > info->net->max_packet &&
+      binlog_dump_net_buffer_length < info->net->max_packet_size &&
+      net_realloc(info->net, binlog_dump_net_buffer_length))
+  {
+    info->errmsg= "Failed to allocate the network buffer";
+    info->error= ER_UNKNOWN_ERROR;
+    goto err;
+  }
+
   while (!should_stop(info))
   {
     /*
@@ -54,6 +54,7 @@
 #include "sql_statistics.h"
 #include "sql_cte.h"
 #include "sql_window.h"
+#include "rowid_filter.h"
 #include "tztime.h"
 
 #include "debug_sync.h"          // DEBUG_SYNC
@@ -108,12 +109,14 @@ static void optimize_straight_join(JOIN *join, table_map join_tables);
 static bool greedy_search(JOIN *join, table_map remaining_tables,
                           uint depth, uint prune_level,
                           uint use_cond_selectivity);
+class Join_search_state;
 static bool best_extension_by_limited_search(JOIN *join,
                                              table_map remaining_tables,
                                              uint idx, double record_count,
                                              double read_time, uint depth,
                                              uint prune_level,
-                                             uint use_cond_selectivity);
+                                             uint use_cond_selectivity,
+                                             Join_search_state *search_state);
 static uint determine_search_depth(JOIN* join);
 C_MODE_START
 static int join_tab_cmp(const void *dummy, const void* ptr1, const void* ptr2);
@@ -180,6 +183,7 @@ static enum_nested_loop_state
 end_update(JOIN *join, JOIN_TAB *join_tab, bool end_of_records);
 static enum_nested_loop_state
 end_unique_update(JOIN *join, JOIN_TAB *join_tab, bool end_of_records);
+static bool flush_group_update(TABLE *table, TMP_TABLE_PARAM *param);
 
 static int join_read_const_table(THD *thd, JOIN_TAB *tab, POSITION *pos);
 static int join_read_system(JOIN_TAB *tab);
@@ -293,7 +297,6 @@ static double table_cond_selectivity(JOIN *join, uint idx, JOIN_TAB *s,
                                      table_map rem_tables);
 void set_postjoin_aggr_write_func(JOIN_TAB *tab);
 
-static Item **get_sargable_cond(JOIN *join, TABLE *table);
 
 #ifndef DBUG_OFF
 
@@ -1440,13 +1443,28 @@ int JOIN::optimize()
 {
   int res= 0;
   join_optimization_state init_state= optimization_state;
+  // to prevent double initialization on EXPLAIN
+  if (optimization_state != JOIN::OPTIMIZATION_PHASE_1_DONE &&
+      optimization_state != JOIN::NOT_OPTIMIZED)
+    return FALSE;
+
+  /*
+    ANALYZE reports the optimization time of the statement. Subqueries and
+    derived tables are optimized from within their top-level select, so
+    only the top-level selects are timed.
+  */
+  Exec_time_tracker *time_tracker= NULL;
+  if (unlikely(thd->lex->analyze_stmt) && !select_lex->outer_select())
+  {
+    create_explain_query_if_not_exists(thd->lex, thd->mem_root);
+    time_tracker= &thd->lex->explain->optimization_time_tracker;
+    time_tracker->start_tracking();
+  }
+
   if (optimization_state == JOIN::OPTIMIZATION_PHASE_1_DONE)
     res= optimize_stage2();
   else
   {
-    // to prevent double initialization on EXPLAIN
-    if (optimization_state != JOIN::NOT_OPTIMIZED)
-      return FALSE;
     optimization_state= JOIN::OPTIMIZATION_IN_PROGRESS;
     res= optimize_inner();
   }
@@ -1457,6 +1475,8 @@ int JOIN::optimize()
       res= build_explain();
     optimization_state= JOIN::OPTIMIZATION_DONE;
   }
+  if (time_tracker)
+    time_tracker->stop_tracking();
   return res;
 }
 
@@ -2643,6 +2663,9 @@ int JOIN::optimize_stage2()
   if (init_join_caches())
     DBUG_RETURN(1);
 
+  if (make_range_rowid_filters())
+    DBUG_RETURN(1);
+
   error= 0;
 
   if (select_options & SELECT_DESCRIBE)
@@ -4145,6 +4168,7 @@ JOIN::destroy()
     delete(save_qep);
   if (ext_keyuses_for_splitting)
     delete(ext_keyuses_for_splitting);
+  free_split_partition_cache();
   delete procedure;
   DBUG_RETURN(error);
 }
@@ -4408,7 +4432,7 @@ void mark_join_nest_as_const(JOIN *join,
     - "t1 LEFT JOIN (...) ON ..." uses the join nest's ON expression.
 */
 
-static Item **get_sargable_cond(JOIN *join, TABLE *table)
+Item **get_sargable_cond(JOIN *join, TABLE *table)
 {
   Item **retval;
   if (table->pos_in_table_list->on_expr)
@@ -7563,6 +7587,119 @@ static void choose_initial_table_order(JOIN *join)
 }
 
 
+/*
+  Check whether the join order of a select may be cached between
+  executions of a prepared statement or a stored procedure statement.
+
+  Only the join of the select itself is cached: the order of the tables of
+  semi-join nests depends on the chosen semi-join strategies, so selects
+  with semi-joins are always optimized with a full search.
+*/
+
+static bool join_plan_cache_applies(JOIN *join)
+{
+  THD *thd= join->thd;
+  return thd->variables.optimizer_plan_cache_tolerance &&
+         !thd->stmt_arena->is_conventional() &&
+         !join->emb_sjm_nest &&
+         !join->select_lex->sj_nests.elements &&
+         join->table_count - join->const_tables > 1;
+}
+
+
+/*
+  Try to use the join order saved by a previous execution of the statement
+
+  @param join         the join being optimized
+  @param join_tables  set of the tables in the query
+
+  @detail
+    The tables are arranged in join->best_ref in the saved order, and
+    the access methods are chosen for that order as with STRAIGHT_JOIN.
+    This takes the current parameter values and statistics into account,
+    but does not search for another join order.
+
+  @retval TRUE   join->best_positions holds the plan with the saved order
+  @retval FALSE  The saved order is not applicable, or the estimates of
+                 the plan are not within optimizer_plan_cache_tolerance
+                 of the ones it was chosen with. A full search is needed.
+*/
+
+static bool reuse_cached_join_plan(JOIN *join, table_map join_tables)
+{
+  Cached_join_plan *plan= join->select_lex->cached_join_plan;
+  if (!plan || plan->table_count != join->table_count ||
+      plan->const_table_map != join->const_table_map)
+    return FALSE;
+
+  bool valid= TRUE;
+  uint n_tables= join->table_count - join->const_tables;
+  JOIN_TAB **ref= join->best_ref + join->const_tables;
+  table_map prefix_tables= join->const_table_map;
+  for (uint i= 0; i < n_tables && valid; i++)
+  {
+    uint j= i;
+    while (j < n_tables && ref[j]->table->map != plan->order[i])
+      j++;
+    if (j == n_tables)
+    {
+      valid= FALSE;
+      break;
+    }
+    swap_variables(JOIN_TAB*, ref[i], ref[j]);
+    if ((ref[i]->dependent & ~prefix_tables) ||
+        (join->const_tables + i && check_interleaving_with_nj(ref[i])))
+      valid= FALSE;
+    prefix_tables|= ref[i]->table->map;
+  }
+  /* check_interleaving_with_nj() has changed the nested join counters */
+  join->cur_embedding_map= 0;
+  reset_nj_counters(join, join->join_list);
+  if (!valid)
+    return FALSE;
+
+  optimize_straight_join(join, join_tables);
+
+  double tolerance= 1.0 +
+    join->thd->variables.optimizer_plan_cache_tolerance / 100.0;
+  return join->best_read <= plan->read_time * tolerance &&
+         join->best_read * tolerance >= plan->read_time &&
+         join->join_record_count <= plan->record_count * tolerance &&
+         join->join_record_count * tolerance >= plan->record_count;
+}
+
+
+/*
+  Save the join order found by a full search for the next executions
+
+  @retval TRUE   Out of memory
+  @retval FALSE  ok
+*/
+
+static bool save_cached_join_plan(JOIN *join)
+{
+  THD *thd= join->thd;
+  Cached_join_plan *plan= join->select_lex->cached_join_plan;
+  if (!plan || plan->table_count != join->table_count)
+  {
+    MEM_ROOT *mem_root= thd->stmt_arena->mem_root;
+    if (!(plan= new (mem_root) Cached_join_plan) ||
+        !(plan->order= (table_map*) alloc_root(mem_root, sizeof(table_map) *
+                                               join->table_count)))
+      return TRUE;
+    plan->table_count= join->table_count;
+    join->select_lex->cached_join_plan= plan;
+  }
+  plan->const_table_map= join->const_table_map;
+  for (uint i= join->const_tables; i < join->table_count; i++)
+    plan->order[i - join->const_tables]=
+      join->best_positions[i].table->table->map;
+  plan->read_time= join->best_read;
+  plan->record_count= join->join_record_count;
+  return FALSE;
+}
+
+
 /**
   Selects and invokes a search strategy for an optimal query plan.
 
@@ -7590,6 +7727,7 @@ choose_plan(JOIN *join, table_map join_tables)
   uint use_cond_selectivity= 
          join->thd->variables.optimizer_use_condition_selectivity;
   bool straight_join= MY_TEST(join->select_options & SELECT_STRAIGHT_JOIN);
+  bool use_plan_cache= !straight_join && join_plan_cache_applies(join);
   DBUG_ENTER("choose_plan");
 
   join->cur_embedding_map= 0;
@@ -7636,8 +7774,20 @@ choose_plan(JOIN *join, table_map join_tables)
   {
     optimize_straight_join(join, join_tables);
   }
+  else if (use_plan_cache && reuse_cached_join_plan(join, join_tables))
+  {
+    /* The join order of the previous execution is still good enough */
+  }
   else
   {
+    if (use_plan_cache && join->select_lex->cached_join_plan)
+    {
+      /* reuse_cached_join_plan() has reordered join->best_ref */
+      my_qsort2(join->best_ref + join->const_tables,
+                join->table_count - join->const_tables, sizeof(JOIN_TAB*),
+                jtab_sort_func, (void*)join->emb_sjm_nest);
+      choose_initial_table_order(join);
+    }
     DBUG_ASSERT(search_depth <= MAX_TABLES + 1);
     if (search_depth == 0)
       /* Automatically determine a reasonable value for 'search_depth' */
@@ -7645,6 +7795,8 @@ choose_plan(JOIN *join, table_map join_tables)
     if (greedy_search(join, join_tables, search_depth, prune_level,
                       use_cond_selectivity))
       DBUG_RETURN(TRUE);
+    if (use_plan_cache && save_cached_join_plan(join))
+      DBUG_RETURN(TRUE);
   }
 
   /* 
@@ -7952,6 +8104,168 @@ optimize_straight_join(JOIN *join, table_map join_tables)
 }
 
 
+/*
+  State of the join order search with optimizer_prune_level=2, shared by
+  all recursive calls of best_extension_by_limited_search() made by one
+  greedy_search().
+
+  - best_access_path() results for the tables that can extend the prefix
+    of every length. They are computed once per prefix, before the
+    candidates are ordered by cost, and reused when the candidates are
+    tried.
+
+  - A memo of the cheapest prefix seen for every set of joined tables.
+    A prefix over the same set of tables as a memoised one, which is not
+    cheaper and produces no fewer rows, can't lead to a cheaper plan and
+    is pruned. With semi-joins the cost of a prefix depends on the order
+    of its tables, so the memo is not used then.
+*/
+
+struct Join_prefix_memo_entry
+{
+  /* The first table of the prefix, NULL for empty slots */
+  JOIN_TAB *first;
+  /* The tables that are not in the prefix */
+  table_map remaining;
+  double read_time;
+  double record_count;
+};
+
+class Join_search_state : public Sql_alloc
+{
+  uint table_count;
+  POSITION *positions;
+  POSITION *loose_scan_positions;
+  /* Bitmap of the tables with a cached position, for every prefix length */
+  table_map *cached;
+  /* The order of join->best_ref to restore, for every prefix length */
+  JOIN_TAB **saved_order;
+  Join_prefix_memo_entry *memo;
+  uint memo_mask;
+  uint memo_elements;
+
+public:
+  /* Scratch space for ordering the candidates of one prefix */
+  JOIN_TAB **candidates;
+  JOIN_TAB **others;
+  double *costs;
+
+  bool init(JOIN *join, uint tables_to_optimize);
+
+  void reset_memo()
+  {
+    if (memo)
+      bzero(memo, sizeof(Join_prefix_memo_entry) * (memo_mask + 1));
+    memo_elements= 0;
+  }
+  void reset_positions(uint idx) { cached[idx]= 0; }
+  JOIN_TAB **saved_best_ref(uint idx)
+  {
+    return saved_order + idx * table_count;
+  }
+
+  POSITION *position(uint idx, JOIN_TAB *s, POSITION **loose_scan_pos)
+  {
+    uint n= idx * table_count + (uint) (s - s->join->join_tab);
+    *loose_scan_pos= loose_scan_positions + n;
+    return positions + n;
+  }
+  void set_cached(uint idx, JOIN_TAB *s) { cached[idx]|= s->table->map; }
+  bool is_cached(uint idx, JOIN_TAB *s) const
+  {
+    return MY_TEST(cached[idx] & s->table->map);
+  }
+
+  bool is_dominated(JOIN *join, table_map remaining,
+                    double read_time, double record_count);
+};
+
+
+bool Join_search_state::init(JOIN *join, uint tables_to_optimize)
+{
+  THD *thd= join->thd;
+  table_count= join->table_count;
+  uint n= table_count * table_count;
+  if (!(positions= (POSITION*) thd->alloc(sizeof(POSITION) * n)) ||
+      !(loose_scan_positions= (POSITION*) thd->alloc(sizeof(POSITION) * n)) ||
+      !(cached= (table_map*) thd->calloc(sizeof(table_map) * table_count)) ||
+      !(saved_order= (JOIN_TAB**) thd->alloc(sizeof(JOIN_TAB*) * n)) ||
+      !(candidates= (JOIN_TAB**) thd->alloc(sizeof(JOIN_TAB*) * table_count)) ||
+      !(others= (JOIN_TAB**) thd->alloc(sizeof(JOIN_TAB*) * table_count)) ||
+      !(costs= (double*) thd->alloc(sizeof(double) * table_count)))
+    return TRUE;
+
+  memo= NULL;
+  memo_mask= 0;
+  memo_elements= 0;
+  if (!join->select_lex->sj_nests.elements)
+  {
+    /* Enough for all subsets of a small join, capped for big ones */
+    uint slots= 1U << MY_MIN(tables_to_optimize + 1, 16);
+    if (!(memo= (Join_prefix_memo_entry*)
+          thd->calloc(sizeof(Join_prefix_memo_entry) * slots)))
+      return TRUE;
+    memo_mask= slots - 1;
+  }
+  return FALSE;
+}
+
+
+/*
+  Check whether a prefix over the same tables, that is at least as cheap
+  and produces at most as many rows, was seen. Otherwise remember this
+  prefix if it is the cheapest one over its tables.
+
+  @param remaining     The tables that are not in the prefix
+  @param read_time     The cost of the prefix
+  @param record_count  The number of rows the prefix produces
+
+  @retval TRUE   The prefix can be pruned
+  @retval FALSE  The prefix must be extended
+*/
+
+bool Join_search_state::is_dominated(JOIN *join, table_map remaining,
+                                     double read_time, double record_count)
+{
+  if (!memo)
+    return FALSE;
+  /*
+    The cost of a complete plan depends on whether its first table is
+    join->sort_by_table, so with ORDER BY or GROUP BY only the prefixes
+    with the same first table are compared.
+  */
+  JOIN_TAB *first= join->positions[join->const_tables].table;
+  ulonglong hash= (ulonglong) remaining * 0x9E3779B97F4A7C15ULL;
+  for (uint slot= (uint) (hash >> 32) & memo_mask; ;
+       slot= (slot + 1) & memo_mask)
+  {
+    Join_prefix_memo_entry *entry= memo + slot;
+    if (!entry->first)
+    {
+      /* Keep the load factor at or below 1/2 */
+      if (memo_elements >= (memo_mask + 1) / 2)
+        return FALSE;
+      memo_elements++;
+    }
+    else if (entry->remaining != remaining ||
+             (join->sort_by_table && entry->first != first))
+      continue;
+    else if (entry->read_time <= read_time &&
+             entry->record_count <= record_count)
+      return TRUE;
+    else if (entry->read_time < read_time ||
+             entry->record_count < record_count)
+      return FALSE;
+    /* An empty slot or a memoised prefix that this one is cheaper than */
+    entry->first= first;
+    entry->remaining= remaining;
+    entry->read_time= read_time;
+    entry->record_count= record_count;
+    return FALSE;
+  }
+}
+
+
 /**
   Find a good, possibly optimal, query execution plan (QEP) by a greedy search.
 
@@ -8061,12 +8375,26 @@ greedy_search(JOIN      *join,
                                          :
                                          ~(table_map)0));
 
+  Join_search_state *search_state= NULL;
+  if (prune_level >= 2)
+  {
+    search_state= new (join->thd->mem_root) Join_search_state;
+    if (!search_state || search_state->init(join, size_remain))
+      DBUG_RETURN(TRUE);
+  }
+
   do {
     /* Find the extension of the current QEP with the lowest cost */
     join->best_read= DBL_MAX;
+    /*
+      The prefixes seen by the previous step may be incompatible with the
+      tables fixed since then, so they must not prune this step's search.
+    */
+    if (search_state)
+      search_state->reset_memo();
     if (best_extension_by_limited_search(join, remaining_tables, idx, record_count,
                                          read_time, search_depth, prune_level,
-                                         use_cond_selectivity))
+                                         use_cond_selectivity, search_state))
       DBUG_RETURN(TRUE);
     /*
       'best_read < DBL_MAX' means that optimizer managed to find
@@ -8759,9 +9087,14 @@ double table_cond_selectivity(JOIN *join, uint idx, JOIN_TAB *s,
                           (0 < search_depth <= join->tables+1).
   @param prune_level      pruning heuristics that should be applied during
                           optimization
-                          (values: 0 = EXHAUSTIVE, 1 = PRUNE_BY_TIME_OR_ROWS)
+                          (values: 0 = EXHAUSTIVE, 1 = PRUNE_BY_TIME_OR_ROWS,
+                          2 = PRUNE_BY_TIME_OR_ROWS plus trying the cheapest
+                          extensions first and pruning by the memo of
+                          prefix costs)
   @param use_cond_selectivity  specifies how the selectivity of the conditions
                           pushed to a table should be taken into account
+  @param search_state     the state shared by the recursive calls when
+                          prune_level == 2, NULL otherwise
 
   @retval
     FALSE       ok
@@ -8777,7 +9110,8 @@ best_extension_by_limited_search(JOIN      *join,
                                  double    read_time,
                                  uint      search_depth,
                                  uint      prune_level,
-                                 uint      use_cond_selectivity)
+                                 uint      use_cond_selectivity,
+                                 Join_search_state *search_state)
 {
   DBUG_ENTER("best_extension_by_limited_search");
 
@@ -8816,6 +9150,55 @@ best_extension_by_limited_search(JOIN      *join,
   if (join->emb_sjm_nest)
     allowed_tables= join->emb_sjm_nest->sj_inner_tables & ~join->const_table_map;
 
+  uint n_tables_left= 0;
+  if (search_state)
+  {
+    /*
+      Find the best access methods of all extensions first and try the
+      cheapest ones first: the earlier a cheap complete plan is found, the
+      more of the other prefixes are pruned by cost.
+    */
+    uint n_candidates= 0, n_others= 0;
+    search_state->reset_positions(idx);
+    for (JOIN_TAB **pos= join->best_ref + idx ; (s= *pos) ; pos++)
+    {
+      search_state->saved_best_ref(idx)[n_tables_left++]= s;
+      table_map real_table_bit= s->table->map;
+      if ((remaining_tables & real_table_bit) && 
+          (allowed_tables & real_table_bit) &&
+          !(remaining_tables & s->dependent) && 
+          (!idx || !check_interleaving_with_nj(s)))
+      {
+        POSITION *loose_scan_pos;
+        POSITION *position= search_state->position(idx, s, &loose_scan_pos);
+        best_access_path(join, s, remaining_tables, idx, disable_jbuf,
+                         record_count, position, loose_scan_pos);
+        search_state->set_cached(idx, s);
+        if (idx)
+          restore_prev_nj_state(s);
+
+        double records= position->records_read < DBL_MAX / record_count ?
+                        record_count * position->records_read : DBL_MAX;
+        double cost= position->read_time + records / (double) TIME_FOR_COMPARE;
+        /* Insertion sort, keeps the original order of equally cheap tables */
+        uint i= n_candidates++;
+        for (; i > 0 && search_state->costs[i - 1] > cost; i--)
+        {
+          search_state->costs[i]= search_state->costs[i - 1];
+          search_state->candidates[i]= search_state->candidates[i - 1];
+        }
+        search_state->costs[i]= cost;
+        search_state->candidates[i]= s;
+      }
+      else
+        search_state->others[n_others++]= s;
+    }
+    memcpy(join->best_ref + idx, search_state->candidates,
+           sizeof(JOIN_TAB*) * n_candidates);
+    memcpy(join->best_ref + idx + n_candidates, search_state->others,
+           sizeof(JOIN_TAB*) * n_others);
+  }
+
   for (JOIN_TAB **pos= join->best_ref + idx ; (s= *pos) ; pos++)
   {
     table_map real_table_bit= s->table->map;
@@ -8829,8 +9212,15 @@ best_extension_by_limited_search(JOIN      *join,
 
       /* Find the best access method from 's' to the current partial plan */
       POSITION loose_scan_pos;
-      best_access_path(join, s, remaining_tables, idx, disable_jbuf,
-                       record_count, position, &loose_scan_pos);
+      if (search_state && search_state->is_cached(idx, s))
+      {
+        POSITION *cached_loose_scan_pos;
+        *position= *search_state->position(idx, s, &cached_loose_scan_pos);
+        loose_scan_pos= *cached_loose_scan_pos;
+      }
+      else
+        best_access_path(join, s, remaining_tables, idx, disable_jbuf,
+                         record_count, position, &loose_scan_pos);
 
       /* Compute the cost of extending the plan with 's', avoid overflow */
       if (position->records_read < DBL_MAX / record_count)
@@ -8860,7 +9250,7 @@ best_extension_by_limited_search(JOIN      *join,
         Prune some less promising partial plans. This heuristic may miss
         the optimal QEPs, thus it results in a non-exhaustive search.
       */
-      if (prune_level == 1)
+      if (prune_level >= 1)
       {
         if (best_record_count > current_record_count ||
             best_read_time > current_read_time ||
@@ -8898,6 +9288,20 @@ best_extension_by_limited_search(JOIN      *join,
       join->positions[idx].cond_selectivity= pushdown_cond_selectivity;
       double partial_join_cardinality= current_record_count *
                                         pushdown_cond_selectivity;
+      if (search_state &&
+          search_state->is_dominated(join, remaining_tables & ~real_table_bit,
+                                     current_read_time,
+                                     partial_join_cardinality))
+      {
+        DBUG_EXECUTE("opt", print_plan(join, idx+1,
+                                       current_record_count,
+                                       read_time,
+                                       current_read_time,
+                                       "pruned_by_memo"););
+        restore_prev_nj_state(s);
+        restore_prev_sj_state(remaining_tables, s, idx);
+        continue;
+      }
       if ( (search_depth > 1) && (remaining_tables & ~real_table_bit) & allowed_tables )
       { /* Recursively expand the current partial plan */
         swap_variables(JOIN_TAB*, join->best_ref[idx], *pos);
@@ -8908,7 +9312,8 @@ best_extension_by_limited_search(JOIN      *join,
                                              current_read_time,
                                              search_depth - 1,
                                              prune_level,
-                                             use_cond_selectivity))
+                                             use_cond_selectivity,
+                                             search_state))
           DBUG_RETURN(TRUE);
         swap_variables(JOIN_TAB*, join->best_ref[idx], *pos);
       }
@@ -8943,6 +9348,10 @@ best_extension_by_limited_search(JOIN      *join,
       restore_prev_sj_state(remaining_tables, s, idx);
     }
   }
+  /* The caller iterates over join->best_ref, restore its order */
+  if (search_state)
+    memcpy(join->best_ref + idx, search_state->saved_best_ref(idx),
+           sizeof(JOIN_TAB*) * n_tables_left);
   DBUG_RETURN(FALSE);
 }
 
@@ -12472,6 +12881,13 @@ void JOIN_TAB::cleanup()
     delete filesort->select;
   delete filesort;
   filesort= NULL;
+  if (rowid_filter)
+  {
+    if (table && table->file->pushed_rowid_filter == rowid_filter)
+      table->file->cancel_pushed_rowid_filter();
+    delete rowid_filter;
+    rowid_filter= NULL;
+  }
   /* Skip non-existing derived tables/views result tables */
   if (table &&
       (table->s->tmp_table != INTERNAL_TMP_TABLE || table->is_created()))
@@ -12625,6 +13041,7 @@ bool JOIN_TAB::preread_init()
   if ((!derived->get_unit()->executed  ||
        derived->is_recursive_with_table() ||
        derived->get_unit()->uncacheable) &&
+      !table->is_split_partition_cached() &&
       mysql_handle_single_derived(join->thd->lex,
                                     derived, DT_CREATE | DT_FILL))
       return TRUE;
@@ -17147,7 +17564,7 @@ create_tmp_table(THD *thd, TMP_TABLE_PARAM *param, List<Item> &fields,
   bool  use_packed_rows= false;
   bool  not_all_columns= !(select_options & TMP_TABLE_ALL_COLUMNS);
   char  *tmpname,path[FN_REFLEN];
-  uchar	*pos, *group_buff, *bitmaps;
+  uchar	*pos, *group_buff, *prev_group_buff, *bitmaps;
   uchar *null_flags;
   Field **reg_field, **from_field, **default_field;
   uint *blob_field;
@@ -17255,6 +17672,8 @@ create_tmp_table(THD *thd, TMP_TABLE_PARAM *param, List<Item> &fields,
                         &tmpname, (uint) strlen(path)+1,
                         &group_buff, (group && ! using_unique_constraint ?
                                       param->group_length : 0),
+                        &prev_group_buff, (group && ! using_unique_constraint ?
+                                           param->group_length : 0),
                         &bitmaps, bitmap_buffer_size(field_count)*6,
                         NullS))
   {
@@ -17531,7 +17950,8 @@ create_tmp_table(THD *thd, TMP_TABLE_PARAM *param, List<Item> &fields,
 
   /* If result table is small; use a heap */
   /* future: storage engine selection can be made dynamic? */
-  if (blob_count || using_unique_constraint
+  if ((blob_count && !thd->variables.tmp_memory_table_blobs) ||
+      using_unique_constraint
       || (thd->variables.big_tables && !(select_options & SELECT_SMALL_RESULT))
       || (select_options & TMP_TABLE_FORCE_MYISAM)
       || thd->variables.tmp_memory_table_size == 0)
@@ -17694,7 +18114,7 @@ create_tmp_table(THD *thd, TMP_TABLE_PARAM *param, List<Item> &fields,
     field->set_table_name(&table->alias);
   }
 
-  param->copy_field_end=copy;
+  param->copy_field_end= coalesce_copy_fields(param->copy_field, copy);
   param->recinfo= recinfo;              	// Pointer to after last field
   store_record(table,s->default_values);        // Make empty default record
 
@@ -17721,6 +18141,8 @@ create_tmp_table(THD *thd, TMP_TABLE_PARAM *param, List<Item> &fields,
     DBUG_PRINT("info",("Creating group key in temporary table"));
     table->group=group;				/* Table is grouped by key */
     param->group_buff=group_buff;
+    param->prev_group_buff= prev_group_buff;
+    param->group_update_pending= false;
     share->keys=1;
     share->uniques= MY_TEST(using_unique_constraint);
     table->key_info= table->s->key_info= keyinfo;
@@ -17841,7 +18263,12 @@ create_tmp_table(THD *thd, TMP_TABLE_PARAM *param, List<Item> &fields,
                      keyinfo->user_defined_key_parts * sizeof(KEY_PART_INFO))))
       goto err;
     bzero((void*) key_part_info, keyinfo->user_defined_key_parts * sizeof(KEY_PART_INFO));
-    table->keys_in_use_for_query.set_bit(0);
+    /*
+      A key over blobs only finds duplicates, in MEMORY tables too, see
+      heap_prepare_hp_create_info(). It can't be used for lookups.
+    */
+    if (!share->uniques)
+      table->keys_in_use_for_query.set_bit(0);
     share->keys_in_use.set_bit(0);
     table->key_info= table->s->key_info= keyinfo;
     keyinfo->key_part=key_part_info;
@@ -19358,6 +19785,10 @@ sub_select(JOIN *join,JOIN_TAB *join_tab,bool end_of_records)
   if (!join_tab->preread_init_done && join_tab->preread_init())
     DBUG_RETURN(NESTED_LOOP_ERROR);
 
+  if (join_tab->rowid_filter && !join_tab->rowid_filter->is_built() &&
+      join_tab->build_range_rowid_filter())
+    DBUG_RETURN(NESTED_LOOP_ERROR);
+
   join->return_tab= join_tab;
 
   if (join_tab->last_inner)
@@ -20856,15 +21287,19 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
 	   bool end_of_records)
 {
   TABLE *const table= join_tab->table;
+  TMP_TABLE_PARAM *const param= join_tab->tmp_table_param;
   ORDER   *group;
   int	  error;
   DBUG_ENTER("end_update");
 
   if (end_of_records)
+  {
+    if (flush_group_update(table, param))
+      DBUG_RETURN(NESTED_LOOP_ERROR);
     DBUG_RETURN(NESTED_LOOP_OK);
+  }
 
   join->found_records++;
-  copy_fields(join_tab->tmp_table_param);	// Groups are copied twice.
   /* Make a key of group index */
   for (group=table->group ; group ; group=group->next)
   {
@@ -20883,31 +21318,46 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
     if (item->maybe_null)
       group->buff[-1]= (char) group->field->is_null();
   }
+  if (param->group_update_pending)
+  {
+    if (!memcmp(param->group_buff, param->prev_group_buff,
+                param->group_length))
+    {
+      /*
+        Same group as the previous row. Its row is still in record[0],
+        update it there without looking it up in the table.
+      */
+      update_tmptable_sum_func(join->sum_funcs, table);
+      goto end;
+    }
+    if (flush_group_update(table, param))
+      DBUG_RETURN(NESTED_LOOP_ERROR);
+  }
+  copy_fields(param);				// Groups are copied twice.
   if (!table->file->ha_index_read_map(table->record[1],
-                                      join_tab->tmp_table_param->group_buff,
+                                      param->group_buff,
                                       HA_WHOLE_KEY,
                                       HA_READ_KEY_EXACT))
   {						/* Update old record */
     restore_record(table,record[1]);
     update_tmptable_sum_func(join->sum_funcs,table);
-    if (unlikely((error= table->file->ha_update_tmp_row(table->record[1],
-                                                        table->record[0]))))
-    {
-      table->file->print_error(error,MYF(0));	/* purecov: inspected */
-      DBUG_RETURN(NESTED_LOOP_ERROR);            /* purecov: inspected */
-    }
+    /*
+      Write the row when the group changes, so that the following rows
+      of the same group are aggregated in record[0].
+    */
+    memcpy(param->prev_group_buff, param->group_buff, param->group_length);
+    param->group_update_pending= true;
     goto end;
   }
 
   init_tmptable_sum_functions(join->sum_funcs);
-  if (unlikely(copy_funcs(join_tab->tmp_table_param->items_to_copy,
-                          join->thd)))
+  if (unlikely(copy_funcs(param->items_to_copy, join->thd)))
     DBUG_RETURN(NESTED_LOOP_ERROR);           /* purecov: inspected */
   if (unlikely((error= table->file->ha_write_tmp_row(table->record[0]))))
   {
     if (create_internal_tmp_table_from_heap(join->thd, table,
-                                       join_tab->tmp_table_param->start_recinfo,
-                                            &join_tab->tmp_table_param->recinfo,
+                                            param->start_recinfo,
+                                            &param->recinfo,
                                             error, 0, NULL))
       DBUG_RETURN(NESTED_LOOP_ERROR);            // Not a table_is_full error
     /* Change method to update rows */
@@ -20929,6 +21379,32 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
 }
 
 
+/**
+  Write the group row that end_update() has aggregated in record[0].
+
+  The row was read into record[1] by the last index lookup, and the
+  handler is still positioned on it.
+
+  @retval false  ok
+  @retval true   error, reported
+*/
+
+static bool flush_group_update(TABLE *table, TMP_TABLE_PARAM *param)
+{
+  int error;
+  if (!param->group_update_pending)
+    return false;
+  param->group_update_pending= false;
+  if (unlikely((error= table->file->ha_update_tmp_row(table->record[1],
+                                                      table->record[0]))))
+  {
+    table->file->print_error(error,MYF(0));	/* purecov: inspected */
+    return true;                                /* purecov: inspected */
+  }
+  return false;
+}
+
+
 /** Like end_update, but this is done with unique constraints instead of keys.  */
 
 static enum_nested_loop_state
@@ -22278,7 +22754,8 @@ test_if_skip_sort_order(JOIN_TAB *tab,ORDER *order,ha_rows select_limit,
           quick_type == QUICK_SELECT_I::QS_TYPE_INDEX_INTERSECT ||
           quick_type == QUICK_SELECT_I::QS_TYPE_ROR_INTERSECT ||
           quick_type == QUICK_SELECT_I::QS_TYPE_ROR_UNION ||
-          quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX)
+          quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX ||
+          quick_type == QUICK_SELECT_I::QS_TYPE_SKIP_SCAN)
       {
         tab->limit= 0;
         goto use_filesort;               // Use filesort
@@ -22684,8 +23161,8 @@ JOIN_TAB::remove_duplicates()
     thd->reset_killed();
 
   table->file->info(HA_STATUS_VARIABLE);
-  if (table->s->db_type() == heap_hton ||
-      (!table->s->blob_fields &&
+  if (!table->s->blob_fields &&
+      (table->s->db_type() == heap_hton ||
        ((ALIGN_SIZE(keylength) + HASH_OVERHEAD) * table->file->stats.records <
 	thd->variables.sortbuff_size)))
     error=remove_dup_with_hash_index(join->thd, table, field_count, first_field,
@@ -25082,9 +25559,16 @@ bool JOIN_TAB::save_explain_data(Explain_table_access *eta,
   tracker= &eta->tracker;
   jbuf_tracker= &eta->jbuf_tracker;
 
-  /* Enable the table access time tracker only for "ANALYZE stmt" */
-  if (thd->lex->analyze_stmt)
+  /*
+    Enable the table access time tracker only for "ANALYZE stmt", and for
+    the ANALYZE output of log_slow_verbosity=explain_json
+  */
+  if (thd->lex->analyze_stmt ||
+      (thd->variables.log_slow_verbosity & LOG_SLOW_VERBOSITY_EXPLAIN_JSON))
+  {
+    eta->op_tracker.set_sample_rate(thd->variables.analyze_time_sample_rate);
     table->file->set_time_tracker(&eta->op_tracker);
+  }
 
   /* No need to save id and select_type here, they are kept in Explain_select */
 
@@ -25376,6 +25860,19 @@ bool JOIN_TAB::save_explain_data(Explain_table_access *eta,
         }
       }
     }
+    if (rowid_filter)
+    {
+      Explain_rowid_filter *erf;
+      if (!(erf= new (thd->mem_root) Explain_rowid_filter))
+        return 1;
+      erf->key_name=
+        thd->strdup(table->key_info[rowid_filter->key_no].name.str);
+      erf->rows= rowid_filter->est_elements;
+      erf->selectivity= rowid_filter->selectivity;
+      eta->rowid_filter= erf;
+      rowid_filter->set_tracker(&erf->tracker);
+      eta->push_extra(ET_USING_ROWID_FILTER);
+    }
     if (table_list /* SJM bushes don't have table_list */ &&
         table_list->schema_table &&
         table_list->schema_table->i_s_requested_object & OPTIMIZE_I_S_TABLE)
@@ -25412,6 +25909,9 @@ bool JOIN_TAB::save_explain_data(Explain_table_access *eta,
     if (table->reginfo.not_exists_optimize)
       eta->push_extra(ET_NOT_EXISTS);
 
+    if (quick_type == QUICK_SELECT_I::QS_TYPE_SKIP_SCAN)
+      eta->push_extra(ET_USING_SKIP_SCAN);
+
     if (quick_type == QUICK_SELECT_I::QS_TYPE_RANGE)
     {
       explain_append_mrr_info((QUICK_RANGE_SELECT*)(tab_select->quick),
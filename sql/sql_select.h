@@ -239,6 +239,7 @@ class AGGR_OP;
 class Filesort;
 struct SplM_plan_info;
 class SplM_opt_info;
+class Range_rowid_filter;
 
 typedef struct st_join_table {
   st_join_table() {}
@@ -260,6 +261,9 @@ typedef struct st_join_table {
     NULL means no index condition pushdown was performed.
   */
   Item          *pre_idx_push_select_cond;
+
+  /* Rowid filter checked by the engine when reading this table, or NULL */
+  Range_rowid_filter *rowid_filter;
   /*
     Pointer to the associated ON expression. on_expr_ref=!NULL except for
     degenerate joins. 
@@ -619,6 +623,7 @@ typedef struct st_join_table {
   double scan_time();
   ha_rows get_examined_rows();
   bool preread_init();
+  bool build_range_rowid_filter();
 
   bool is_sjm_nest() { return MY_TEST(bush_children); }
   
@@ -1040,6 +1045,23 @@ class AGGR_OP :public Sql_alloc
 };
 
 
+/*
+  A join order saved in st_select_lex::cached_join_plan: the tables of the
+  join after the constant ones, in the order they are joined, and the
+  estimates of the plan when the order was chosen.
+*/
+
+class Cached_join_plan :public Sql_alloc
+{
+public:
+  uint table_count;
+  table_map const_table_map;
+  table_map *order;
+  double read_time;
+  double record_count;
+};
+
+
 class JOIN :public Sql_alloc
 {
 private:
@@ -1616,6 +1638,7 @@ class JOIN :public Sql_alloc
   bool optimize_unflattened_subqueries();
   bool optimize_constant_subqueries();
   int init_join_caches();
+  bool make_range_rowid_filters();
   bool make_sum_func_list(List<Item> &all_fields, List<Item> &send_fields,
 			  bool before_group_by, bool recompute= FALSE);
 
@@ -1754,6 +1777,7 @@ class JOIN :public Sql_alloc
   bool check_for_splittable_materialized();
   void add_keyuses_for_splitting();
   bool inject_best_splitting_cond(table_map remaining_tables);
+  void free_split_partition_cache();
   bool fix_all_splittings_in_plan();
 
   bool transform_in_predicates_into_in_subq(THD *thd);
@@ -2366,6 +2390,8 @@ void eliminate_tables(JOIN *join);
 /* Index Condition Pushdown entry point function */
 void push_index_cond(JOIN_TAB *tab, uint keyno);
 
+Item **get_sargable_cond(JOIN *join, TABLE *table);
+
 #define OPT_LINK_EQUAL_FIELDS    1
 
 /* EXPLAIN-related utility functions */
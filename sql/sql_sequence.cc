@@ -674,6 +674,11 @@ int sequence_definition::write(TABLE *table, bool all_fields)
     values up to this one can be used.
     If next_free_value >= reserved_until we have to reserve new
     values from the sequence.
+
+    Values from the reserved range are taken with a compare and swap of
+    next_free_value under the shared lock, so that concurrent NEXT VALUE
+    calls don't serialize. Everything that changes reserved_until or
+    real_increment, or sets next_free_value, holds the exclusive lock.
 */
 
 longlong SEQUENCE::next_value(TABLE *table, bool second_round, int *error)
@@ -684,7 +689,24 @@ longlong SEQUENCE::next_value(TABLE *table, bool second_round, int *error)
 
   *error= 0;
   if (!second_round)
+  {
+    DBUG_ASSERT(((ha_sequence*) table->file)->is_locked() == 0);
+    mysql_rwlock_rdlock(&mutex);
+    res_value= (longlong) my_atomic_load64_explicit((int64*) &next_free_value,
+                                                    MY_MEMORY_ORDER_RELAXED);
+    while ((real_increment > 0 && res_value < reserved_until) ||
+           (real_increment < 0 && res_value > reserved_until))
+    {
+      if (my_atomic_cas64((int64*) &next_free_value, (int64*) &res_value,
+                          (int64) increment_value(res_value)))
+      {
+        mysql_rwlock_unlock(&mutex);
+        DBUG_RETURN(res_value);
+      }
+    }
+    mysql_rwlock_unlock(&mutex);
     write_lock(table);
+  }
 
   res_value= next_free_value;
   next_free_value= increment_value(next_free_value);
@@ -4912,7 +4912,12 @@ static int fill_schema_table_from_frm(THD *thd, TABLE *table,
     goto end;
   }
 
-  share= tdc_acquire_share(thd, &table_list, GTS_TABLE | GTS_VIEW);
+  /*
+    Scanning all tables must not evict the definitions of the tables that
+    are in use from the table definition cache.
+  */
+  share= tdc_acquire_share(thd, &table_list,
+                           GTS_TABLE | GTS_VIEW | GTS_NOCACHE);
   if (!share)
   {
     if (thd->get_stmt_da()->sql_errno() == ER_NO_SUCH_TABLE ||
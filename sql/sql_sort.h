@@ -71,6 +71,7 @@ class Sort_param {
   uint ref_length;            // Length of record ref.
   uint res_length;            // Length of records in final sorted file/buffer.
   uint max_keys_per_buffer;   // Max keys / buffer.
+  uint sort_threads;          // Threads for sorting a buffer (@@sort_threads)
   uint min_dupl_count;
   ha_rows max_rows;           // Select limit, or HA_POS_ERROR if unlimited.
   ha_rows examined_rows;      // Number of examined rows.
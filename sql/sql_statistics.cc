@@ -325,7 +325,7 @@ class Column_statistics_collected :public Column_statistics
 
   inline void init(THD *thd, Field * table_field);
   inline bool add(ha_rows rowno);
-  inline void finish(ha_rows rows); 
+  inline void finish(ha_rows rows, double sample_fraction);
   inline void cleanup();
 };
 
@@ -1540,6 +1540,7 @@ class Histogram_builder
   uint curr_bucket;        /* number of the current bucket to be built     */
   ulonglong count;         /* number of values retrieved                   */
   ulonglong count_distinct;    /* number of distinct values retrieved      */
+  ulonglong count_single;  /* number of values retrieved only once         */
 
 public: 
   Histogram_builder(Field *col, uint col_len, ha_rows rows)
@@ -1554,13 +1555,18 @@ class Histogram_builder
     curr_bucket= 0;
     count= 0;
     count_distinct= 0;    
+    count_single= 0;
   }
 
   ulonglong get_count_distinct() { return count_distinct; }
 
+  ulonglong get_count_single() { return count_single; }
+
   int next(void *elem, element_count elem_cnt)
   {
     count_distinct++;
+    if (elem_cnt == 1)
+      count_single++;
     count+= elem_cnt;
     if (curr_bucket == hist_width)
       return 0;
@@ -1590,6 +1596,20 @@ int histogram_build_walk(void *elem, element_count elem_cnt, void *arg)
   return hist_builder->next(elem, elem_cnt);
 }
 
+
+/*
+  Count the distinct values (arg[0]) and the values met only once (arg[1])
+*/
+
+static int count_distinct_single_walk(void *elem, element_count elem_cnt,
+                                      void *arg)
+{
+  ((ulonglong *) arg)[0]++;
+  if (elem_cnt == 1)
+    ((ulonglong *) arg)[1]++;
+  return 0;
+}
+
 C_MODE_END
 
 
@@ -1666,25 +1686,34 @@ class Count_distinct_field: public Sql_alloc
   /*
     @brief
     Calculate the number of elements accumulated in the container of 'tree'
+
+    @param
+    single_values  If not NULL, the number of the elements that have been
+                   added only once is returned here
   */
-  ulonglong get_value()
+  ulonglong get_value(ulonglong *single_values= NULL)
   {
-    ulonglong count;
-    if (tree->elements == 0)
+    ulonglong count[2];
+    if (tree->elements == 0 && !single_values)
       return (ulonglong) tree->elements_in_tree();
-    count= 0;  
-    tree->walk(table_field->table, count_distinct_walk, (void*) &count);
-    return count;
+    count[0]= count[1]= 0;
+    tree->walk(table_field->table, count_distinct_single_walk, (void*) count);
+    if (single_values)
+      *single_values= count[1];
+    return count[0];
   }
 
   /*
     @brief
     Build the histogram for the elements accumulated in the container of 'tree'
   */
-  ulonglong get_value_with_histogram(ha_rows rows)
+  ulonglong get_value_with_histogram(ha_rows rows,
+                                     ulonglong *single_values= NULL)
   {
     Histogram_builder hist_builder(table_field, tree_key_length, rows);
     tree->walk(table_field->table,  histogram_build_walk, (void *) &hist_builder);
+    if (single_values)
+      *single_values= hist_builder.get_count_single();
     return hist_builder.get_count_distinct();
   }
 
@@ -2508,11 +2537,19 @@ bool Column_statistics_collected::add(ha_rows rowno)
   Get the results of aggregation when collecting the statistics on a column
   
   @param
-  rows          The total number of rows in the table 
+  rows             The number of rows the statistics was collected from
+  @param
+  sample_fraction  The fraction of the rows of the table that was sampled
+
+  @details
+  When only a sample of the rows was read, the number of distinct values
+  in the table is estimated with the Duj1 estimator of Haas and Stokes
+  from the number of distinct values in the sample and the number of the
+  values met in the sample only once.
 */
 
 inline
-void Column_statistics_collected::finish(ha_rows rows)
+void Column_statistics_collected::finish(ha_rows rows, double sample_fraction)
 {
   double val;
 
@@ -2531,14 +2568,28 @@ void Column_statistics_collected::finish(ha_rows rows)
   if (count_distinct)
   {
     ulonglong distincts;
+    ulonglong single_values= 0;
+    ulonglong *singles= sample_fraction < 1 ? &single_values : NULL;
     uint hist_size= count_distinct->get_hist_size();
     if (hist_size == 0)
-      distincts= count_distinct->get_value();
+      distincts= count_distinct->get_value(singles);
     else
-      distincts= count_distinct->get_value_with_histogram(rows - nulls);
+      distincts= count_distinct->get_value_with_histogram(rows - nulls,
+                                                          singles);
     if (distincts)
     {
-      val= (double) (rows - nulls) / distincts;
+      double non_nulls= (double) (rows - nulls);
+      if (sample_fraction < 1)
+      {
+        double total_non_nulls= non_nulls / sample_fraction;
+        double est_distincts= non_nulls * distincts /
+                              (non_nulls - single_values +
+                               single_values * sample_fraction);
+        set_if_smaller(est_distincts, total_non_nulls);
+        val= total_non_nulls / est_distincts;
+      }
+      else
+        val= non_nulls / distincts;
       set_avg_frequency(val); 
       set_not_null(COLUMN_STAT_AVG_FREQUENCY);
     }
@@ -2727,12 +2778,25 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
   Field *table_field;
   ha_rows rows= 0;
   handler *file=table->file;
+  double sample_fraction= thd->variables.sample_percentage / 100;
+  const ha_rows MIN_THRESHOLD_FOR_SAMPLING= 50000;
 
   DBUG_ENTER("collect_statistics_for_table");
 
   table->collected_stats->cardinality_is_null= TRUE;
   table->collected_stats->cardinality= 0;
 
+  if (thd->variables.sample_percentage == 0)
+  {
+    /* Sample about MIN_THRESHOLD_FOR_SAMPLING rows of big tables */
+    file->info(HA_STATUS_VARIABLE);
+    if (file->stats.records <= MIN_THRESHOLD_FOR_SAMPLING)
+      sample_fraction= 1;
+    else
+      sample_fraction= (double) MIN_THRESHOLD_FOR_SAMPLING /
+                       file->stats.records;
+  }
+
   for (field_ptr= table->field; *field_ptr; field_ptr++)
   {
     table_field= *field_ptr;   
@@ -2756,6 +2820,10 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
       if (rc)
         break;
 
+      /* Bernoulli sampling: every row is taken with the same probability */
+      if (sample_fraction < 1 && my_rnd(&thd->rand) >= sample_fraction)
+        continue;
+
       for (field_ptr= table->field; *field_ptr; field_ptr++)
       {
         table_field= *field_ptr;
@@ -2780,7 +2848,8 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
   if (!rc)
   {
     table->collected_stats->cardinality_is_null= FALSE;
-    table->collected_stats->cardinality= rows;
+    table->collected_stats->cardinality=
+      sample_fraction < 1 ? (ha_rows) (rows / sample_fraction) : rows;
   }
 
   bitmap_clear_all(table->write_set);
@@ -2791,7 +2860,7 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
       continue;
     bitmap_set_bit(table->write_set, table_field->field_index); 
     if (!rc)
-      table_field->collected_stats->finish(rows);
+      table_field->collected_stats->finish(rows, sample_fraction);
     else
       table_field->collected_stats->cleanup();
   }
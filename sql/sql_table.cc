@@ -10298,6 +10298,7 @@ copy_data_between_tables(THD *thd, TABLE *from, TABLE *to,
   }
   if (dfield_ptr)
     *dfield_ptr= NULL;
+  copy_end= coalesce_copy_fields(copy, copy_end);
 
   if (order)
   {
@@ -2203,6 +2203,196 @@ class Frame_scan_cursor : public Frame_cursor
   }
 };
 
+/*
+  A cursor that computes MIN() or MAX() over the frame between a top bound
+  and a bottom bound.
+
+  @detail
+    Frame_scan_cursor adds every row of the frame to the sum function for
+    every current row, which is quadratic for wide frames. This cursor
+    divides the rows of the partition into aligned blocks of 2^k rows, for
+    every k, and remembers the number of the row that holds the least (for
+    MAX() the greatest) value of every block. The blocks are built as the
+    bottom bound moves forward. A frame is covered by at most 2*log2(n)
+    blocks, and only their extreme rows are added to the sum function.
+*/
+
+class Frame_min_max_cursor : public Frame_cursor
+{
+public:
+  Frame_min_max_cursor(THD *thd, Item_sum *item,
+                       const Frame_cursor &top_bound,
+                       const Frame_cursor &bottom_bound) :
+    top_bound(top_bound), bottom_bound(bottom_bound),
+    is_max(item->sum_func() == Item_sum::MAX_FUNC),
+    value1(NULL), value2(NULL), partition_start(0), built_rows(0)
+  {
+    Item *arg= item->get_arg(0);
+    memset(levels, 0, sizeof(levels));
+    /* The caches are set up the same way as in Item_sum_hybrid */
+    if (!(value1= arg->get_cache(thd)) || !(value2= arg->get_cache(thd)))
+      return;
+    value1->setup(thd, arg);
+    value2->setup(thd, arg);
+    if (!arg->const_item())
+    {
+      value1->set_used_tables(RAND_TABLE_BIT);
+      value2->set_used_tables(RAND_TABLE_BIT);
+    }
+    cmp.set_cmp_func(item, (Item**) &value1, (Item**) &value2, FALSE);
+  }
+
+  ~Frame_min_max_cursor()
+  {
+    for (uint k= 1; k < MAX_LEVELS; k++)
+      delete levels[k];
+  }
+
+  void init(READ_RECORD *info)
+  {
+    cursor.init(info);
+  }
+
+  void pre_next_partition(ha_rows rownum)
+  {
+    curr_rownum= rownum;
+    partition_start= rownum;
+    built_rows= 0;
+    for (uint k= 1; k < MAX_LEVELS && levels[k]; k++)
+      levels[k]->clear();
+    clear_sum_functions();
+  }
+
+  void next_partition(ha_rows rownum)
+  {
+    compute_values_for_current_row();
+  }
+
+  void pre_next_row()
+  {
+    clear_sum_functions();
+  }
+
+  void next_row()
+  {
+    curr_rownum++;
+    compute_values_for_current_row();
+  }
+
+  ha_rows get_curr_rownum() const
+  {
+    return curr_rownum;
+  }
+
+private:
+  static const uint MAX_LEVELS= 64;
+
+  const Frame_cursor &top_bound;
+  const Frame_cursor &bottom_bound;
+  Table_read_cursor cursor;
+  ha_rows curr_rownum;
+  bool is_max;
+
+  /* Caches for the values of the two rows being compared */
+  Item_cache *value1, *value2;
+  Arg_comparator cmp;
+
+  ha_rows partition_start;
+  /* Number of rows of the partition that have been put into blocks */
+  ha_rows built_rows;
+  /*
+    levels[k]->at(i) is the number of the extreme row among the rows
+    [i * 2^k, (i+1) * 2^k) of the partition. Level 0 is not stored, as
+    every block there is a single row.
+  */
+  Dynamic_array<ha_rows> *levels[MAX_LEVELS];
+
+  ha_rows block_row(uint level, ha_rows idx)
+  {
+    return level ? levels[level]->at(idx) : partition_start + idx;
+  }
+
+  bool fetch_value(ha_rows rownum, Item_cache *value)
+  {
+    cursor.move_to(rownum);
+    if (cursor.fetch())
+      return true;
+    value->cache_value();
+    return false;
+  }
+
+  /* Return the one of two rows that holds the extreme value */
+  ha_rows extreme_row(ha_rows row1, ha_rows row2)
+  {
+    if (fetch_value(row1, value1) || fetch_value(row2, value2) ||
+        value2->null_value)
+      return row1;
+    if (value1->null_value)
+      return row2;
+    int res= cmp.compare();
+    return (is_max ? res >= 0 : res <= 0) ? row1 : row2;
+  }
+
+  /* Put the next row of the partition into all blocks that it completes */
+  bool build_next_row()
+  {
+    ha_rows best= partition_start + built_rows;
+    built_rows++;
+    for (uint k= 1;
+         k < MAX_LEVELS && !(built_rows & ((((ha_rows) 1) << k) - 1));
+         k++)
+    {
+      ha_rows idx= (built_rows >> k) - 1;
+      best= extreme_row(block_row(k - 1, 2 * idx), best);
+      if (!levels[k] && !(levels[k]= new Dynamic_array<ha_rows>()))
+        return true;
+      if (levels[k]->append(best))
+        return true;
+    }
+    return false;
+  }
+
+  void add_row(ha_rows rownum)
+  {
+    cursor.move_to(rownum);
+    if (!cursor.fetch())
+      add_value_to_items();
+  }
+
+  void compute_values_for_current_row()
+  {
+    if (top_bound.is_outside_computation_bounds() ||
+        bottom_bound.is_outside_computation_bounds() || !value2)
+      return;
+
+    ha_rows start_rownum= top_bound.get_curr_rownum();
+    ha_rows bottom_rownum= bottom_bound.get_curr_rownum();
+    DBUG_PRINT("info", ("COMPUTING (%llu %llu)", start_rownum, bottom_rownum));
+    if (start_rownum > bottom_rownum || start_rownum < partition_start)
+      return;
+
+    ha_rows first= start_rownum - partition_start;
+    ha_rows last= bottom_rownum - partition_start;
+    while (built_rows <= last)
+    {
+      if (build_next_row())
+        return;
+    }
+
+    /* Cover [first, last] with the largest aligned blocks */
+    while (first <= last)
+    {
+      uint k= 0;
+      while (k + 1 < MAX_LEVELS &&
+             !(first & ((((ha_rows) 1) << (k + 1)) - 1)) &&
+             last - first >= (((ha_rows) 1) << (k + 1)) - 1)
+        k++;
+      add_row(block_row(k, first >> k));
+      first+= ((ha_rows) 1) << k;
+    }
+  }
+};
+
 /* A cursor that follows a target cursor. Each time a new row is added,
    the window functions are cleared and only have the row at which the target
    is point at added to them.
@@ -2675,8 +2865,13 @@ void get_window_functions_required_cursors(
     {
       frame_bottom->set_no_action();
       frame_top->set_no_action();
-      Frame_cursor *scan_cursor= new Frame_scan_cursor(*frame_top,
-                                                       *frame_bottom);
+      Frame_cursor *scan_cursor;
+      if (sum_func->sum_func() == Item_sum::MIN_FUNC ||
+          sum_func->sum_func() == Item_sum::MAX_FUNC)
+        scan_cursor= new Frame_min_max_cursor(thd, sum_func, *frame_top,
+                                              *frame_bottom);
+      else
+        scan_cursor= new Frame_scan_cursor(*frame_top, *frame_bottom);
       scan_cursor->add_sum_func(sum_func);
       cursor_manager->add_cursor(scan_cursor);
 
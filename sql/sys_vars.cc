@@ -50,6 +50,7 @@
 #include "derror.h"  // read_texts
 #include "sql_base.h"                           // close_cached_tables
 #include "hostname.h"                           // host_cache_size
+#include "sql_digest_stats.h"                   // digest_stats_size
 #include <myisam.h>
 #include "debug_sync.h"                         // DEBUG_SYNC
 #include "sql_show.h"
@@ -850,6 +851,14 @@ static Sys_var_mybool Sys_column_compression_zlib_wrap(
        SESSION_VAR(column_compression_zlib_wrap), CMD_LINE(OPT_ARG),
        DEFAULT(FALSE));
 
+static Sys_var_uint Sys_column_compression_zstd_level(
+       "column_compression_zstd_level",
+       "zstd compression level of the columns created with COMPRESSED=zstd "
+       "(1 gives best speed, 22 gives best compression, 0 stores the data "
+       "uncompressed)",
+       SESSION_VAR(column_compression_zstd_level), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 22), DEFAULT(3), BLOCK_SIZE(1));
+
 static const char *concurrent_insert_names[]= {"NEVER", "AUTO", "ALWAYS", 0};
 static Sys_var_enum Sys_concurrent_insert(
        "concurrent_insert", "Use concurrent insert with MyISAM",
@@ -1269,6 +1278,31 @@ static Sys_var_mybool Sys_log_bin_compress(
   "log_bin_compress", "Whether the binary log can be compressed",
   GLOBAL_VAR(opt_bin_log_compress), CMD_LINE(OPT_ARG), DEFAULT(FALSE));
 
+static const char *log_bin_compress_algorithm_names[]= { "zlib", "zstd", 0 };
+
+static bool check_log_bin_compress_algorithm(sys_var *self, THD *thd,
+                                             set_var *var)
+{
+#ifndef HAVE_ZSTD
+  if (var->save_result.ulonglong_value == BINLOG_COMPRESS_ZSTD)
+  {
+    my_error(ER_NOT_SUPPORTED_YET, MYF(0), "log_bin_compress_algorithm=zstd");
+    return true;
+  }
+#endif
+  return false;
+}
+
+static Sys_var_enum Sys_log_bin_compress_algorithm(
+  "log_bin_compress_algorithm",
+  "Compression algorithm of the events compressed with log_bin_compress. "
+  "zstd gives a better compression ratio of row images at a similar speed, "
+  "but slaves and mysqlbinlog must be built with zstd to read the events. "
+  "zlib is used if the server is built without zstd",
+  GLOBAL_VAR(opt_bin_log_compress_algorithm), CMD_LINE(REQUIRED_ARG),
+  log_bin_compress_algorithm_names, DEFAULT(BINLOG_COMPRESS_ZLIB),
+  NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(check_log_bin_compress_algorithm));
+
 /* the min length is 10, means that Begin/Commit/Rollback would never be compressed!   */
 static Sys_var_uint Sys_log_bin_compress_min_len(
   "log_bin_compress_min_len",
@@ -1521,6 +1555,23 @@ static Sys_var_uint Sys_max_digest_length(
        CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0, 1024 * 1024), DEFAULT(1024), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_digest_statistics_size(
+       "digest_statistics_size",
+       "Maximum number of statement digests that execution statistics are "
+       "collected for. The least recently executed digests are forgotten "
+       "first. 0 disables the statistics",
+       GLOBAL_VAR(digest_stats_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 1024 * 1024), DEFAULT(0), BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_digest_statistics_histogram_base(
+       "digest_statistics_histogram_base",
+       "Base of the logarithmic buckets of the execution time histograms of "
+       "the statement digests. Bucket i counts the statements that took "
+       "less than base^i microseconds",
+       READ_ONLY GLOBAL_VAR(digest_stats_histogram_base),
+       CMD_LINE(REQUIRED_ARG), VALID_RANGE(2, 1000), DEFAULT(2),
+       BLOCK_SIZE(1));
+
 static bool check_max_delayed_threads(sys_var *self, THD *thd, set_var *var)
 {
   return var->type != OPT_GLOBAL &&
@@ -1575,6 +1626,15 @@ static Sys_var_ulong Sys_metadata_locks_hash_instances(
        VALID_RANGE(1, 1024), DEFAULT(8),
        BLOCK_SIZE(1));
 
+static Sys_var_mybool Sys_metadata_locks_fast_path(
+       "metadata_locks_fast_path",
+       "Grant the metadata locks of DML statements, which only conflict "
+       "with the locks of DDL and LOCK TABLES, without locking the shared "
+       "state of the table. Such locks are not shown in "
+       "INFORMATION_SCHEMA.METADATA_LOCK_INFO. Ignored with Galera",
+       GLOBAL_VAR(opt_mdl_fast_path), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 static Sys_var_ulonglong Sys_pseudo_thread_id(
        "pseudo_thread_id",
        "This variable is for internal server use",
@@ -2193,6 +2253,36 @@ static Sys_var_ulong Sys_binlog_commit_wait_usec(
        VALID_RANGE(0, ULONG_MAX), DEFAULT(100000), BLOCK_SIZE(1));
 
 
+static Sys_var_mybool Sys_binlog_sync_pipeline(
+       "binlog_sync_pipeline",
+       "With sync_binlog=1, sync the binlog file after the next group commit "
+       "has been allowed to write to it, so that the next group is written "
+       "while the previous one is synced to disk. Commit order and "
+       "durability are unchanged.",
+       GLOBAL_VAR(opt_binlog_sync_pipeline), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
+
+static Sys_var_ulong Sys_binlog_gtid_index_span(
+       "binlog_gtid_index_span",
+       "Minimum number of bytes between the entries of the in-memory GTID "
+       "index of the active binary log. A slave connecting with GTID starts "
+       "at the last entry before its position instead of at the start of "
+       "the binlog file. 0 disables the index.",
+       GLOBAL_VAR(binlog_gtid_index_span), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, ULONG_MAX), DEFAULT(0), BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_binlog_writeset_history_size(
+       "binlog_writeset_history_size",
+       "Number of recently changed unique key values remembered to set the "
+       "commit id of a transaction in the binary log from the rows it "
+       "changed, so that a parallel slave can run transactions that don't "
+       "change the same rows in parallel. 0 uses the binlog group commit "
+       "instead.",
+       GLOBAL_VAR(binlog_writeset_history_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 10000000), DEFAULT(0), BLOCK_SIZE(1));
+
+
 static bool fix_max_join_size(sys_var *self, THD *thd, enum_var_type type)
 {
   SV *sv= type == OPT_GLOBAL ? &global_system_variables : &thd->variables;
@@ -2247,6 +2337,14 @@ static Sys_var_ulong Sys_max_recursive_iterations(
        SESSION_VAR(max_recursive_iterations), CMD_LINE(OPT_ARG),
        VALID_RANGE(0, UINT_MAX), DEFAULT(UINT_MAX), BLOCK_SIZE(1));
 
+static Sys_var_uint Sys_max_rowid_filter_size(
+       "max_rowid_filter_size",
+       "The maximum size of the sorted array of rowids of a rowid filter. "
+       "The optimizer doesn't build filters that are expected to be bigger, "
+       "0 disables rowid filters",
+       SESSION_VAR(max_rowid_filter_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, UINT_MAX32), DEFAULT(0), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_max_sort_length(
        "max_sort_length",
        "The number of bytes to use when sorting BLOB or TEXT values (only "
@@ -2335,6 +2433,13 @@ static Sys_var_ulong Sys_net_buffer_length(
        VALID_RANGE(1024, 1024*1024), DEFAULT(16384), BLOCK_SIZE(1024),
        NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(check_net_buffer_length));
 
+static Sys_var_uint Sys_net_compression_level(
+       "net_compression_level",
+       "zlib compression level of the compressed client/server protocol. "
+       "1 is the fastest, 9 gives the best compression",
+       GLOBAL_VAR(net_compression_level), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 9), DEFAULT(6), BLOCK_SIZE(1));
+
 static bool fix_net_read_timeout(sys_var *self, THD *thd, enum_var_type type)
 {
   if (type != OPT_GLOBAL)
@@ -2420,14 +2525,45 @@ static Sys_var_ulong Sys_open_files_limit(
        VALID_RANGE(0, OS_FILE_LIMIT), DEFAULT(0), BLOCK_SIZE(1));
 
 /// @todo change to enum
+static Sys_var_ulong Sys_optimizer_plan_cache_tolerance(
+       "optimizer_plan_cache_tolerance",
+       "Re-executions of prepared statements and stored procedure "
+       "statements reuse the join order chosen by the previous full join "
+       "order search if the cost and the number of rows of the join with "
+       "that order differ by at most this many percent from the ones "
+       "estimated when it was chosen. 0 disables the reuse",
+       SESSION_VAR(optimizer_plan_cache_tolerance), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 10000), DEFAULT(0), BLOCK_SIZE(1));
+
+static Sys_var_mybool Sys_partition_defer_locking(
+       "partition_defer_locking",
+       "In SELECT, lock the partitions of a partitioned table only when "
+       "they are read, after partition pruning, instead of locking all "
+       "partitions when the statement starts",
+       SESSION_VAR(partition_defer_locking), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
+static Sys_var_ulong Sys_partition_parallel_scan_min_partitions(
+       "partition_parallel_scan_min_partitions",
+       "Ask the engine of a partitioned table to scan the partitions in "
+       "parallel, if it can, also for a query with LIMIT and without "
+       "ORDER BY or GROUP BY, when the query reads at least this many "
+       "partitions. 0 means that such scans are never parallel",
+       SESSION_VAR(partition_parallel_scan_min_partitions),
+       CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, MAX_PARTITIONS), DEFAULT(0),
+       BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_optimizer_prune_level(
        "optimizer_prune_level",
        "Controls the heuristic(s) applied during query optimization to prune "
        "less-promising partial plans from the optimizer search space. "
        "Meaning: 0 - do not apply any heuristic, thus perform exhaustive "
-       "search; 1 - prune plans based on number of retrieved rows",
+       "search; 1 - prune plans based on number of retrieved rows; "
+       "2 - prune as with 1, also extend plans with the cheapest tables "
+       "first and prune plans that are more expensive than a plan over the "
+       "same tables that was already considered",
        SESSION_VAR(optimizer_prune_level), CMD_LINE(REQUIRED_ARG),
-       VALID_RANGE(0, 1), DEFAULT(1), BLOCK_SIZE(1));
+       VALID_RANGE(0, 2), DEFAULT(1), BLOCK_SIZE(1));
 
 static Sys_var_ulong Sys_optimizer_selectivity_sampling_limit(
        "optimizer_selectivity_sampling_limit",
@@ -2497,6 +2633,8 @@ export const char *optimizer_switch_names[]=
   "condition_pushdown_for_derived",
   "split_materialized",
   "condition_pushdown_for_subquery",
+  "skip_scan",
+  "split_materialized_cache",
   "default", 
   NullS
 };
@@ -2569,6 +2707,15 @@ static Sys_var_ulong Sys_read_buff_size(
        VALID_RANGE(IO_SIZE*2, INT_MAX32), DEFAULT(128*1024),
        BLOCK_SIZE(IO_SIZE));
 
+static Sys_var_mybool Sys_io_cache_readahead(
+       "io_cache_readahead",
+       "Ask the operating system to read ahead the next block of files "
+       "read sequentially through a file cache, like binary and relay logs "
+       "and temporary files of sorting, while the current block is "
+       "processed",
+       GLOBAL_VAR(my_io_cache_readahead), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 static bool check_read_only(sys_var *self, THD *thd, set_var *var)
 {
   /* Prevent self dead-lock */
@@ -2689,6 +2836,14 @@ static Sys_var_ulong Sys_range_alloc_block_size(
        VALID_RANGE(RANGE_ALLOC_BLOCK_SIZE, UINT_MAX),
        DEFAULT(RANGE_ALLOC_BLOCK_SIZE), BLOCK_SIZE(1024));
 
+static Sys_var_ulonglong Sys_range_optimizer_max_mem_size(
+       "range_optimizer_max_mem_size",
+       "Maximum amount of memory the range optimizer may use for a table. "
+       "When it is exceeded, range access is not considered for the "
+       "table. 0 means no limit",
+       SESSION_VAR(range_optimizer_max_mem_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, ULONGLONG_MAX), DEFAULT(8*1024*1024), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_multi_range_count(
        "multi_range_count", "Ignored. Use mrr_buffer_size instead",
        SESSION_VAR(multi_range_count), CMD_LINE(REQUIRED_ARG),
@@ -2721,6 +2876,15 @@ static Sys_var_ulong Sys_query_prealloc_size(
        BLOCK_SIZE(1024), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
        ON_UPDATE(fix_thd_mem_root));
 
+static Sys_var_ulong Sys_query_alloc_keep_size(
+       "query_alloc_keep_size",
+       "If the memory allocated for parsing and executing a statement is "
+       "at most this big, it is kept for the next statements of the "
+       "connection instead of being freed. 0 means only "
+       "query_prealloc_size is kept",
+       SESSION_VAR(query_alloc_keep_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, UINT_MAX), DEFAULT(0), BLOCK_SIZE(1024));
+
 
 // this has to be NO_CMD_LINE as the command-line option has a different name
 static Sys_var_mybool Sys_skip_external_locking(
@@ -3026,6 +3190,14 @@ static Sys_var_enum Slave_run_triggers_for_rbr(
        slave_run_triggers_for_rbr_names,
        DEFAULT(SLAVE_RUN_TRIGGERS_FOR_RBR_NO));
 
+static Sys_var_mybool Sys_slave_rows_hash_scan(
+       "slave_rows_hash_scan",
+       "Locate the rows of a row-based DELETE or UPDATE event on a table "
+       "without a usable index in a single table scan, using a hash of "
+       "the rows of the event, instead of scanning the table for every row",
+       GLOBAL_VAR(opt_slave_rows_hash_scan), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 static const char *slave_type_conversions_name[]= {"ALL_LOSSY", "ALL_NON_LOSSY", 0};
 static Sys_var_set Slave_type_conversions(
        "slave_type_conversions",
@@ -3052,6 +3224,15 @@ static Sys_var_mybool Sys_master_verify_checksum(
        GLOBAL_VAR(opt_master_verify_checksum), CMD_LINE(OPT_ARG),
        DEFAULT(FALSE));
 
+static Sys_var_ulong Sys_binlog_dump_net_buffer_length(
+       "binlog_dump_net_buffer_length",
+       "Size of the network buffer of the threads sending the binary log "
+       "to slaves. The events are sent when the buffer is full, so a bigger "
+       "buffer sends more events per write to the network. 0 means "
+       "net_buffer_length is used. Takes effect for new slave connections",
+       GLOBAL_VAR(binlog_dump_net_buffer_length), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 64*1024*1024), DEFAULT(0), BLOCK_SIZE(IO_SIZE));
+
 /* These names must match RPL_SKIP_XXX #defines in slave.h. */
 static const char *replicate_events_marked_for_skip_names[]= {
   "REPLICATE", "FILTER_ON_SLAVE", "FILTER_ON_MASTER", 0
@@ -3263,6 +3444,13 @@ static Sys_var_ulonglong Sys_sort_buffer(
        VALID_RANGE(MIN_SORT_MEMORY, SIZE_T_MAX), DEFAULT(MAX_SORT_MEMORY),
        BLOCK_SIZE(1));
 
+static Sys_var_uint Sys_sort_threads(
+       "sort_threads",
+       "Number of threads that sort the contents of the sort buffer "
+       "concurrently. 1 disables parallel sorting",
+       SESSION_VAR(sort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, MAX_SORT_THREADS), DEFAULT(1), BLOCK_SIZE(1));
+
 export sql_mode_t expand_sql_mode(sql_mode_t sql_mode)
 {
   if (sql_mode & MODE_ANSI)
@@ -3448,6 +3636,14 @@ static Sys_var_mybool Sys_standard_compliant_cte(
        SESSION_VAR(only_standard_compliant_cte), CMD_LINE(OPT_ARG),
        DEFAULT(TRUE));
 
+static Sys_var_mybool Sys_share_cte_materialization(
+       "share_cte_materialization",
+       "Execute the specification of a non-recursive CTE only once when "
+       "several of its references are materialized, and fill the other "
+       "references with copies of the rows",
+       SESSION_VAR(share_cte_materialization), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 
 // why ENUM and not BOOL ?
 static const char *updatable_views_with_limit_names[]= {"NO", "YES", 0};
@@ -3626,6 +3822,14 @@ static Sys_var_uint Sys_threadpool_threadpool_prio_kickup_timer(
   GLOBAL_VAR(threadpool_prio_kickup_timer), CMD_LINE(REQUIRED_ARG),
   VALID_RANGE(0, UINT_MAX), DEFAULT(1000), BLOCK_SIZE(1)
 );
+
+static Sys_var_mybool Sys_threadpool_work_stealing(
+ "thread_pool_work_stealing",
+ "If set, a worker thread that has nothing to do in its own thread group "
+ "executes an event queued in another group, whose worker threads are "
+ "all busy",
+  GLOBAL_VAR(threadpool_work_stealing), CMD_LINE(OPT_ARG), DEFAULT(FALSE)
+);
 #endif /* HAVE_POOL_OF_THREADS */
 
 /**
@@ -3722,6 +3926,14 @@ static Sys_var_ulonglong Sys_tmp_memory_table_size(
        VALID_RANGE(1024, (ulonglong)~(intptr)0), DEFAULT(16*1024*1024),
        BLOCK_SIZE(1));
 
+static Sys_var_mybool Sys_tmp_memory_table_blobs(
+       "tmp_memory_table_blobs",
+       "Allow internal temporary tables with BLOB or TEXT columns to be "
+       "created in memory. Like other in-memory temporary tables they are "
+       "converted to on-disk tables when they exceed tmp_memory_table_size",
+       SESSION_VAR(tmp_memory_table_blobs), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 static Sys_var_ulonglong Sys_tmp_disk_table_size(
        "tmp_disk_table_size",
        "Max size for data for an internal temporary on-disk MyISAM or Aria table.",
@@ -4631,6 +4843,12 @@ static Sys_var_have Sys_have_openssl(
        "will be NO.",
        READ_ONLY GLOBAL_VAR(have_openssl), NO_CMD_LINE);
 
+static Sys_var_have Sys_have_pcre_jit(
+       "have_pcre_jit", "If the regular expression functions compile "
+       "the patterns to machine code with the PCRE JIT, will be set to YES, "
+       "otherwise will be set to NO.",
+       READ_ONLY GLOBAL_VAR(have_pcre_jit), NO_CMD_LINE);
+
 static Sys_var_have Sys_have_profiling(
        "have_profiling", "If statement profiling is available, will be set to YES, "
        "otherwise will be set to NO. See SHOW PROFILES and SHOW PROFILE.",
@@ -5774,8 +5992,34 @@ static Sys_var_ulong Sys_log_slow_rate_limit(
        SESSION_VAR(log_slow_rate_limit), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(1, UINT_MAX), DEFAULT(1), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_log_slow_digest_limit(
+       "log_slow_digest_limit",
+       "Write the first # slow queries of every statement digest in each "
+       "log_slow_digest_interval to the slow log, even if "
+       "log_slow_rate_limit skips them. Requires digest_statistics_size > 0. "
+       "0 disables it",
+       SESSION_VAR(log_slow_digest_limit), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, UINT_MAX), DEFAULT(0), BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_log_slow_digest_interval(
+       "log_slow_digest_interval",
+       "Length in seconds of the interval that log_slow_digest_limit "
+       "applies to",
+       GLOBAL_VAR(opt_log_slow_digest_interval), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 86400), DEFAULT(60), BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_log_slow_buffer_size(
+       "log_slow_buffer_size",
+       "Size of the buffer of the slow query log file. If not 0, the "
+       "queries are not written to the file one by one, but when the buffer "
+       "is full, or by a background thread every second. 0 writes every "
+       "query immediately",
+       READ_ONLY GLOBAL_VAR(opt_log_slow_buffer_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 256*1024*1024), DEFAULT(0), BLOCK_SIZE(IO_SIZE));
+
 static const char *log_slow_verbosity_names[]= { "innodb", "query_plan", 
-                                                 "explain", 0 };
+                                                 "explain", "explain_json",
+                                                 0 };
 static Sys_var_set Sys_log_slow_verbosity(
        "log_slow_verbosity",
        "Verbosity level for the slow log",
@@ -5810,6 +6054,14 @@ static Sys_var_mybool Sys_userstat(
        GLOBAL_VAR(opt_userstat_running),
        CMD_LINE(OPT_ARG), DEFAULT(FALSE));
 
+static Sys_var_ulong Sys_userstat_merge_interval(
+       "userstat_merge_interval",
+       "Number of seconds that a connection collects INDEX_STATISTICS and "
+       "TABLE_STATISTICS locally before it merges them into the global "
+       "statistics. 0 merges them at the end of every statement",
+       GLOBAL_VAR(opt_userstat_merge_interval), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 3600), DEFAULT(0), BLOCK_SIZE(1));
+
 static Sys_var_mybool Sys_binlog_annotate_row_events(
        "binlog_annotate_row_events",
        "Tells the master to annotate RBR events with the statement that "
@@ -5865,6 +6117,22 @@ static Sys_var_enum Sys_histogram_type(
        SESSION_VAR(histogram_type), CMD_LINE(REQUIRED_ARG),
        histogram_types, DEFAULT(0));
 
+static Sys_var_double Sys_analyze_sample_percentage(
+       "analyze_sample_percentage",
+       "Percentage of rows from the table ANALYZE TABLE will sample to "
+       "collect table statistics. Set it to 0 to let MariaDB decide what "
+       "percentage of rows to sample.",
+       SESSION_VAR(sample_percentage), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 100), DEFAULT(100));
+
+static Sys_var_ulong Sys_analyze_time_sample_rate(
+       "analyze_time_sample_rate",
+       "Time only one in # row operations on a table in ANALYZE statements "
+       "and in log_slow_verbosity=explain_json, and extrapolate "
+       "r_total_time_ms from them. 1 times every row operation",
+       SESSION_VAR(analyze_time_sample_rate), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, UINT_MAX), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_mybool Sys_no_thread_alarm(
        "debug_no_thread_alarm",
        "Disable system thread alarm calls. Disabling it may be useful "
@@ -5905,6 +6173,15 @@ static Sys_var_harows Sys_expensive_subquery_limit(
        SESSION_VAR(expensive_subquery_limit), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0, HA_POS_ERROR), DEFAULT(100), BLOCK_SIZE(1));
 
+static Sys_var_ulonglong Sys_expression_cache_max_memory(
+       "expression_cache_max_memory",
+       "The memory that the in-memory hash tables of all subquery caches of "
+       "a statement may use together. If not 0, caches with small "
+       "fixed-size parameters and results use such hash tables instead of "
+       "temporary tables",
+       SESSION_VAR(expression_cache_max_memory), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, SIZE_T_MAX), DEFAULT(0), BLOCK_SIZE(1024));
+
 static Sys_var_mybool Sys_encrypt_tmp_disk_tables(
        "encrypt_tmp_disk_tables",
        "Encrypt temporary on-disk tables (created as part of query execution)",
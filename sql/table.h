@@ -1493,6 +1493,8 @@ struct TABLE
   void deny_splitting();
   double get_materialization_cost(); // Now used only if is_splittable()==true
   void add_splitting_info_for_key_field(struct KEY_FIELD *key_field);
+  bool is_split_partition_cached();
+  bool caches_split_partitions();
 
   /**
     System Versioning support
@@ -2126,6 +2128,8 @@ struct TABLE_LIST
   /* Bitmap of the defining with element */
   table_map with_internal_reference_map;
   TABLE_LIST * next_with_rec_ref;
+  /* Next reference to the same with element (see With_element::table_refs) */
+  TABLE_LIST * next_with_table_ref;
   bool is_derived_with_recursive_reference;
   bool block_handle_derived;
   ST_SCHEMA_TABLE *schema_table;        /* Information_schema table */
@@ -2876,7 +2880,13 @@ enum get_table_share_flags {
   GTS_VIEW                 = 2,
   GTS_NOLOCK               = 4,
   GTS_USE_DISCOVERY        = 8,
-  GTS_FORCE_DISCOVERY      = 16
+  GTS_FORCE_DISCOVERY      = 16,
+  /*
+    The share is needed only briefly, e.g. by INFORMATION_SCHEMA. If it is
+    not cached yet, don't evict other shares for it and free it as soon as
+    it is released.
+  */
+  GTS_NOCACHE              = 32
 };
 
 size_t max_row_length(TABLE *table, MY_BITMAP const *cols, const uchar *data);
@@ -61,33 +61,47 @@ static uint32 tc_contention_warning_reported;
 
 /** Data collections. */
 static LF_HASH tdc_hash; /**< Collection of TABLE_SHARE objects. */
-/** Collection of unused TABLE_SHARE objects. */
-static
-I_P_List <TDC_element,
-          I_P_List_adapter<TDC_element, &TDC_element::next, &TDC_element::prev>,
-          I_P_List_null_counter,
-          I_P_List_fast_push_back<TDC_element> > unused_shares;
-
-static tdc_version_t tdc_version;  /* Increments on each reload */
-static bool tdc_inited;
-
 
 /**
-  Protects unused shares list.
+  Collection of unused TABLE_SHARE objects.
 
-  TDC_element::prev
-  TDC_element::next
-  unused_shares
+  The collection is split into tc_instances instances by the hash of the
+  table key, so that releasing, reusing and evicting shares of different
+  tables doesn't serialize on a single mutex.
 */
 
-static mysql_mutex_t LOCK_unused_shares;
+struct Unused_shares_instance
+{
+  /**
+    Protects unused shares list of this instance.
+
+    TDC_element::prev
+    TDC_element::next
+    list
+  */
+  mysql_mutex_t LOCK_unused_shares;
+  I_P_List <TDC_element,
+            I_P_List_adapter<TDC_element, &TDC_element::next,
+                             &TDC_element::prev>,
+            I_P_List_null_counter,
+            I_P_List_fast_push_back<TDC_element> > list;
+  /** Avoid false sharing between instances */
+  char pad[CPU_LEVEL1_DCACHE_LINESIZE];
+};
+
+static Unused_shares_instance *unused_shares;
+/** Instance tdc_purge() starts to look for a share to evict from */
+static int32 tdc_purge_instance;
+
+static tdc_version_t tdc_version;  /* Increments on each reload */
+static bool tdc_inited;
 
 #ifdef HAVE_PSI_INTERFACE
 static PSI_mutex_key key_LOCK_unused_shares, key_TABLE_SHARE_LOCK_table_share,
                      key_LOCK_table_cache;
 static PSI_mutex_info all_tc_mutexes[]=
 {
-  { &key_LOCK_unused_shares, "LOCK_unused_shares", PSI_FLAG_GLOBAL },
+  { &key_LOCK_unused_shares, "LOCK_unused_shares", 0 },
   { &key_TABLE_SHARE_LOCK_table_share, "TABLE_SHARE::tdc.LOCK_table_share", 0 },
   { &key_LOCK_table_cache, "LOCK_table_cache", 0 }
 };
@@ -100,6 +114,24 @@ static PSI_cond_info all_tc_conds[]=
 #endif
 
 
+/**
+  Get instance of unused shares list for the table with the given key.
+*/
+
+static Unused_shares_instance *unused_shares_instance(const uchar *key,
+                                                      uint key_length)
+{
+  return &unused_shares[my_hash_sort(&my_charset_bin, key, key_length) %
+                        tc_instances];
+}
+
+
+static Unused_shares_instance *unused_shares_instance(TDC_element *element)
+{
+  return unused_shares_instance(element->m_key, element->m_key_length);
+}
+
+
 static int fix_thd_pins(THD *thd)
 {
   return thd->tdc_hash_pins ? 0 :
@@ -621,9 +653,15 @@ bool tdc_init(void)
   /* Extra instance is allocated to avoid false sharing */
   if (!(tc= new Table_cache_instance[tc_instances + 1]))
     DBUG_RETURN(true);
+  if (!(unused_shares= new Unused_shares_instance[tc_instances]))
+  {
+    delete [] tc;
+    DBUG_RETURN(true);
+  }
   tdc_inited= true;
-  mysql_mutex_init(key_LOCK_unused_shares, &LOCK_unused_shares,
-                   MY_MUTEX_INIT_FAST);
+  for (uint32 i= 0; i < tc_instances; i++)
+    mysql_mutex_init(key_LOCK_unused_shares,
+                     &unused_shares[i].LOCK_unused_shares, MY_MUTEX_INIT_FAST);
   tdc_version= 1L;  /* Increments on each reload */
   lf_hash_init(&tdc_hash, sizeof(TDC_element) +
                           sizeof(Share_free_tables) * (tc_instances - 1),
@@ -674,7 +712,9 @@ void tdc_deinit(void)
   {
     tdc_inited= false;
     lf_hash_destroy(&tdc_hash);
-    mysql_mutex_destroy(&LOCK_unused_shares);
+    for (uint32 i= 0; i < tc_instances; i++)
+      mysql_mutex_destroy(&unused_shares[i].LOCK_unused_shares);
+    delete [] unused_shares;
     delete [] tc;
   }
   DBUG_VOID_RETURN;
@@ -698,14 +738,21 @@ void tdc_purge(bool all)
   DBUG_ENTER("tdc_purge");
   while (all || tdc_records() > tdc_size)
   {
-    TDC_element *element;
-
-    mysql_mutex_lock(&LOCK_unused_shares);
-    if (!(element= unused_shares.pop_front()))
+    TDC_element *element= 0;
+    Unused_shares_instance *instance= 0;
+    /* Take the least recently used share of the next non-empty instance */
+    uint32 start= (uint32) my_atomic_add32_explicit(&tdc_purge_instance, 1,
+                                                    MY_MEMORY_ORDER_RELAXED);
+    for (uint32 i= 0; i < tc_instances; i++)
     {
-      mysql_mutex_unlock(&LOCK_unused_shares);
-      break;
+      instance= &unused_shares[(start + i) % tc_instances];
+      mysql_mutex_lock(&instance->LOCK_unused_shares);
+      if ((element= instance->list.pop_front()))
+        break;
+      mysql_mutex_unlock(&instance->LOCK_unused_shares);
     }
+    if (!element)
+      break;
 
     /* Concurrent thread may start using share again, reset prev and next. */
     element->prev= 0;
@@ -714,10 +761,10 @@ void tdc_purge(bool all)
     if (element->ref_count)
     {
       mysql_mutex_unlock(&element->LOCK_table_share);
-      mysql_mutex_unlock(&LOCK_unused_shares);
+      mysql_mutex_unlock(&instance->LOCK_unused_shares);
       continue;
     }
-    mysql_mutex_unlock(&LOCK_unused_shares);
+    mysql_mutex_unlock(&instance->LOCK_unused_shares);
 
     tdc_delete_share_from_hash(element);
   }
@@ -852,9 +899,11 @@ TABLE_SHARE *tdc_acquire_share(THD *thd, TABLE_LIST *tl, uint flags,
     element->ref_count++;
     element->version= tdc_refresh_version();
     element->flushed= false;
+    element->transient= flags & GTS_NOCACHE;
     mysql_mutex_unlock(&element->LOCK_table_share);
 
-    tdc_purge(false);
+    if (!(flags & GTS_NOCACHE))
+      tdc_purge(false);
     if (out_table)
     {
       status_var_increment(thd->status_var.table_open_cache_misses);
@@ -914,10 +963,13 @@ TABLE_SHARE *tdc_acquire_share(THD *thd, TABLE_LIST *tl, uint flags,
 
   was_unused= !element->ref_count;
   element->ref_count++;
+  if (!(flags & GTS_NOCACHE))
+    element->transient= false;
   mysql_mutex_unlock(&element->LOCK_table_share);
   if (was_unused)
   {
-    mysql_mutex_lock(&LOCK_unused_shares);
+    Unused_shares_instance *instance= unused_shares_instance(element);
+    mysql_mutex_lock(&instance->LOCK_unused_shares);
     if (element->prev)
     {
       /*
@@ -925,11 +977,11 @@ TABLE_SHARE *tdc_acquire_share(THD *thd, TABLE_LIST *tl, uint flags,
         Unlink share from this list
       */
       DBUG_PRINT("info", ("Unlinking from not used list"));
-      unused_shares.remove(element);
+      instance->list.remove(element);
       element->next= 0;
       element->prev= 0;
     }
-    mysql_mutex_unlock(&LOCK_unused_shares);
+    mysql_mutex_unlock(&instance->LOCK_unused_shares);
   }
 
 end:
@@ -961,6 +1013,7 @@ TABLE_SHARE *tdc_acquire_share(THD *thd, TABLE_LIST *tl, uint flags,
 
 void tdc_release_share(TABLE_SHARE *share)
 {
+  Unused_shares_instance *instance;
   DBUG_ENTER("tdc_release_share");
 
   mysql_mutex_lock(&share->tdc->LOCK_table_share);
@@ -980,28 +1033,30 @@ void tdc_release_share(TABLE_SHARE *share)
   }
   mysql_mutex_unlock(&share->tdc->LOCK_table_share);
 
-  mysql_mutex_lock(&LOCK_unused_shares);
+  instance= unused_shares_instance(share->tdc);
+  mysql_mutex_lock(&instance->LOCK_unused_shares);
   mysql_mutex_lock(&share->tdc->LOCK_table_share);
   if (--share->tdc->ref_count)
   {
     if (!share->is_view)
       mysql_cond_broadcast(&share->tdc->COND_release);
     mysql_mutex_unlock(&share->tdc->LOCK_table_share);
-    mysql_mutex_unlock(&LOCK_unused_shares);
+    mysql_mutex_unlock(&instance->LOCK_unused_shares);
     DBUG_VOID_RETURN;
   }
-  if (share->tdc->flushed || tdc_records() > tdc_size)
+  if (share->tdc->flushed || share->tdc->transient ||
+      tdc_records() > tdc_size)
   {
-    mysql_mutex_unlock(&LOCK_unused_shares);
+    mysql_mutex_unlock(&instance->LOCK_unused_shares);
     tdc_delete_share_from_hash(share->tdc);
     DBUG_VOID_RETURN;
   }
   /* Link share last in used_table_share list */
   DBUG_PRINT("info", ("moving share to unused list"));
   DBUG_ASSERT(share->tdc->next == 0);
-  unused_shares.push_back(share->tdc);
+  instance->list.push_back(share->tdc);
   mysql_mutex_unlock(&share->tdc->LOCK_table_share);
-  mysql_mutex_unlock(&LOCK_unused_shares);
+  mysql_mutex_unlock(&instance->LOCK_unused_shares);
   DBUG_VOID_RETURN;
 }
 
@@ -1094,6 +1149,8 @@ bool tdc_remove_table(THD *thd, enum_tdc_remove_table_type remove_type,
   TABLE *table;
   TDC_element *element;
   uint my_refs= 1;
+  char key[MAX_DBKEY_LENGTH];
+  Unused_shares_instance *instance;
   DBUG_ENTER("tdc_remove_table");
   DBUG_PRINT("enter",("name: %s  remove_type: %d", table_name, remove_type));
 
@@ -1102,10 +1159,12 @@ bool tdc_remove_table(THD *thd, enum_tdc_remove_table_type remove_type,
                                              MDL_EXCLUSIVE));
 
 
-  mysql_mutex_lock(&LOCK_unused_shares);
+  instance= unused_shares_instance((uchar*) key,
+                                   tdc_create_key(key, db, table_name));
+  mysql_mutex_lock(&instance->LOCK_unused_shares);
   if (!(element= tdc_lock_share(thd, db, table_name)))
   {
-    mysql_mutex_unlock(&LOCK_unused_shares);
+    mysql_mutex_unlock(&instance->LOCK_unused_shares);
     DBUG_ASSERT(remove_type != TDC_RT_REMOVE_NOT_OWN_KEEP_SHARE);
     DBUG_RETURN(false);
   }
@@ -1116,16 +1175,16 @@ bool tdc_remove_table(THD *thd, enum_tdc_remove_table_type remove_type,
   {
     if (element->prev)
     {
-      unused_shares.remove(element);
+      instance->list.remove(element);
       element->prev= 0;
       element->next= 0;
     }
-    mysql_mutex_unlock(&LOCK_unused_shares);
+    mysql_mutex_unlock(&instance->LOCK_unused_shares);
 
     tdc_delete_share_from_hash(element);
     DBUG_RETURN(true);
   }
-  mysql_mutex_unlock(&LOCK_unused_shares);
+  mysql_mutex_unlock(&instance->LOCK_unused_shares);
 
   element->ref_count++;
 
@@ -35,10 +35,13 @@ struct TDC_element
   uint m_key_length;
   tdc_version_t version;
   bool flushed;
+  /** Share was only acquired with GTS_NOCACHE, free it when unused */
+  bool transient;
   TABLE_SHARE *share;
 
   /**
-    Protects ref_count, m_flush_tickets, all_tables, flushed, all_tables_refs.
+    Protects ref_count, m_flush_tickets, all_tables, flushed, transient,
+    all_tables_refs.
   */
   mysql_mutex_t LOCK_table_share;
   mysql_cond_t COND_release;
@@ -1198,6 +1198,55 @@ static bool too_many_threads(thread_group_t *thread_group)
 }
 
 
+/**
+  Take a queued event from another thread group.
+
+  An event is only taken from a group that has no waiting worker thread to
+  wake, i.e. whose queue would otherwise wait until one of its busy workers
+  finishes. The other group's mutex is only try-locked, as the caller holds
+  the mutex of its own group.
+
+  The worker is accounted as active in the group of the connection while
+  it handles the event, so that wait_begin()/wait_end() keep the counters
+  of that group consistent. The caller moves it back, see worker_main().
+
+  @param thread_group - group of the current worker, mutex locked
+
+  @return connection with pending event, or NULL if there is none to steal
+*/
+
+static TP_connection_generic *steal_event(thread_group_t *thread_group)
+{
+  uint count= group_count;
+  uint own= (uint)(thread_group - all_groups);
+
+  for (uint i= 1; i < count; i++)
+  {
+    thread_group_t *group= &all_groups[(own + i) % count];
+    if (is_queue_empty(group) || !group->waiting_threads.is_empty())
+      continue;
+    if (mysql_mutex_trylock(&group->mutex))
+      continue;
+
+    TP_connection_generic *connection= NULL;
+    if (!group->shutdown && group->waiting_threads.is_empty() &&
+        group->active_thread_count > 0)
+    {
+      connection= queue_get(group);
+      if (connection)
+        group->active_thread_count++;
+    }
+    mysql_mutex_unlock(&group->mutex);
+    if (connection)
+    {
+      thread_group->active_thread_count--;
+      return connection;
+    }
+  }
+  return NULL;
+}
+
+
 /**
   Retrieve a connection with pending event.
   
@@ -1277,6 +1326,17 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
     }
 
 
+    /*
+      Before sleeping, help a thread group whose queue is not drained
+      because all its workers are busy.
+    */
+    if (!oversubscribed && threadpool_work_stealing)
+    {
+      connection= steal_event(thread_group);
+      if (connection)
+        break;
+    }
+
     /* And now, finally sleep */ 
     current_thread->woken = false; /* wake() sets this to true */
 
@@ -1603,7 +1663,18 @@ static void *worker_main(void *param)
     if (!connection)
       break;
     this_thread.event_count++;
+    thread_group_t *event_group= connection->thread_group;
     tp_callback(connection);
+    if (event_group != thread_group)
+    {
+      /* The event was stolen, see steal_event(). Return to own group. */
+      mysql_mutex_lock(&event_group->mutex);
+      event_group->active_thread_count--;
+      mysql_mutex_unlock(&event_group->mutex);
+      mysql_mutex_lock(&thread_group->mutex);
+      thread_group->active_thread_count++;
+      mysql_mutex_unlock(&thread_group->mutex);
+    }
   }
 
   /* Thread shutdown: cleanup per-worker-thread structure. */
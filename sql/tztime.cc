@@ -39,6 +39,7 @@
 #else
 #include <my_time.h>
 #include <my_sys.h>
+#include <my_atomic.h>
 #include <mysql_version.h>
 #include <my_getopt.h>
 #endif
@@ -141,6 +142,13 @@ typedef struct st_time_zone_info
     there are no transitions at all.
   */
   TRAN_TYPE_INFO *fallback_tti;
+  /*
+    Index of the ats and revts ranges found last, which are checked first
+    by the next conversions. Converted values are usually close in time.
+    They are only hints, so they are read and written without locks.
+  */
+  mutable int32 last_ats_range;
+  mutable int32 last_revts_range;
 
 } TIME_ZONE_INFO;
 
@@ -660,6 +668,32 @@ find_time_range(my_time_t t, const my_time_t *range_boundaries,
   return lower_bound;
 }
 
+
+/*
+  find_time_range() which first checks the range found last.
+
+  SYNOPSIS
+    find_time_range_cached()
+      t                - my_time_t value for which we looking for range
+      range_boundaries - sorted array of range starts.
+      higher_bound     - number of ranges
+      last_range       - the range found by the previous call, updated
+*/
+static uint
+find_time_range_cached(my_time_t t, const my_time_t *range_boundaries,
+                       uint higher_bound, int32 *last_range)
+{
+  uint i= (uint) my_atomic_load32_explicit(last_range,
+                                           MY_MEMORY_ORDER_RELAXED);
+  if (i < higher_bound && range_boundaries[i] <= t &&
+      (i + 1 == higher_bound || t < range_boundaries[i + 1]))
+    return i;
+
+  i= find_time_range(t, range_boundaries, higher_bound);
+  my_atomic_store32_explicit(last_range, (int32) i, MY_MEMORY_ORDER_RELAXED);
+  return i;
+}
+
 /*
   Find local time transition for given my_time_t.
 
@@ -690,7 +724,8 @@ find_transition_type(my_time_t t, const TIME_ZONE_INFO *sp)
     contain t. With this localtime_r on real data may takes less
     time than with linear search (I've seen 30% speed up).
   */
-  return &(sp->ttis[sp->types[find_time_range(t, sp->ats, sp->timecnt)]]);
+  return &(sp->ttis[sp->types[find_time_range_cached(t, sp->ats, sp->timecnt,
+                                                      &sp->last_ats_range)]]);
 }
 
 
@@ -956,7 +991,8 @@ TIME_to_gmt_sec(const MYSQL_TIME *t, const TIME_ZONE_INFO *sp, uint *error_code)
   }
 
   /* binary search for our range */
-  i= find_time_range(local_t, sp->revts, sp->revcnt);
+  i= find_time_range_cached(local_t, sp->revts, sp->revcnt,
+                            &sp->last_revts_range);
 
   /*
     As there are no offset switches at the end of TIMESTAMP range,
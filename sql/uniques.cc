@@ -78,11 +78,16 @@ int unique_intersect_write_to_ptrs(uchar* key, element_count count, Unique *uniq
 }
 
 
+/* Number of values the array of a Unique is first allocated for */
+#define UNIQUE_ARRAY_MIN_ELEMENTS 1024
+
 Unique::Unique(qsort_cmp2 comp_func, void * comp_func_fixed_arg,
 	       uint size_arg, size_t max_in_memory_size_arg,
-               uint min_dupl_count_arg)
+               uint min_dupl_count_arg, bool use_array_arg)
   :max_in_memory_size(max_in_memory_size_arg),
    size(size_arg),
+   use_array(use_array_arg && !min_dupl_count_arg && size_arg),
+   array_buff(NULL), array_elements(0), array_sorted(0), array_capacity(0),
    elements(0)
 {
   my_b_clear(&file);
@@ -100,7 +105,8 @@ Unique::Unique(qsort_cmp2 comp_func, void * comp_func_fixed_arg,
     If you change the following, change it in get_max_elements function, too.
   */
   max_elements= (ulong) (max_in_memory_size /
-                         ALIGN_SIZE(sizeof(TREE_ELEMENT)+size));
+                         (use_array ? size :
+                          ALIGN_SIZE(sizeof(TREE_ELEMENT)+size)));
   if (!max_elements)
     max_elements= 1;
 
@@ -270,6 +276,9 @@ static double get_merge_many_buffs_cost(uint *buffer,
       in_memory_elems  OUT estimate of the number of elements in memory
                            if disk is not used  
 
+    A Unique for an intersection (intersect_fl) keeps its elements in a
+    tree, a Unique for a union keeps them in an array (see use_array).
+
   RETURN
     Cost in disk seeks.
 
@@ -288,6 +297,9 @@ static double get_merge_many_buffs_cost(uint *buffer,
 
       then cost(tree_creation) = n_compares*ROWID_COMPARE_COST;
 
+      The same number of comparisons is assumed for sorting an array,
+      which holds max_in_memory_size/key_size elements instead.
+
       Total cost of creating trees:
       (n_trees - 1)*max_size_tree_cost + non_max_size_tree_cost.
 
@@ -316,7 +328,11 @@ double Unique::get_use_cost(uint *buffer, size_t nkeys, uint key_size,
   double result;
 
   max_elements_in_tree= ((size_t) max_in_memory_size /
-                         ALIGN_SIZE(sizeof(TREE_ELEMENT)+key_size));
+                         (intersect_fl ?
+                          ALIGN_SIZE(sizeof(TREE_ELEMENT)+key_size) :
+                          key_size));
+  if (!max_elements_in_tree)
+    max_elements_in_tree= 1;
 
   n_full_trees=    nkeys / max_elements_in_tree;
   last_tree_elems= nkeys % max_elements_in_tree;
@@ -369,6 +385,61 @@ Unique::~Unique()
   close_cached_file(&file);
   delete_tree(&tree, 0);
   delete_dynamic(&file_ptrs);
+  my_free(array_buff);
+}
+
+
+/*
+  Sort the values of the array and remove the duplicates.
+*/
+
+void Unique::compact_array()
+{
+  if (array_elements == array_sorted)
+    return;
+  my_qsort2(array_buff, array_elements, size, (qsort2_cmp) tree.compare,
+            tree.custom_arg);
+  uchar *last= array_buff;
+  uchar *end= array_buff + (size_t) array_elements * size;
+  for (uchar *pos= array_buff + size; pos < end; pos+= size)
+  {
+    if (tree.compare(tree.custom_arg, last, pos))
+    {
+      last+= size;
+      if (last != pos)
+        memcpy(last, pos, size);
+    }
+  }
+  array_elements= array_sorted= (ulong) ((last - array_buff) / size) + 1;
+}
+
+
+/*
+  Make room for one more value in the array.
+
+  DESCRIPTION
+    The array grows by doubling up to max_elements values. When it can't
+    grow, the duplicates are removed, and if the array is still more than
+    half full it is written to the file.
+*/
+
+bool Unique::grow_array()
+{
+  if (array_capacity < max_elements)
+  {
+    ulong capacity= MY_MIN(MY_MAX(array_capacity * 2,
+                                  UNIQUE_ARRAY_MIN_ELEMENTS), max_elements);
+    uchar *buff= (uchar*) my_realloc(array_buff, (size_t) capacity * size,
+                                     MYF(MY_THREAD_SPECIFIC | MY_WME |
+                                         MY_ALLOW_ZERO_PTR));
+    if (!buff)
+      return 1;
+    array_buff= buff;
+    array_capacity= capacity;
+    return 0;
+  }
+  compact_array();
+  return array_elements > max_elements / 2 && flush();
 }
 
 
@@ -376,6 +447,16 @@ Unique::~Unique()
 bool Unique::flush()
 {
   BUFFPEK file_ptr;
+  if (use_array)
+  {
+    compact_array();
+    file_ptr.count= array_elements;
+    file_ptr.file_pos= my_b_tell(&file);
+    elements+= array_elements;
+    array_elements= array_sorted= 0;
+    return my_b_write(&file, array_buff, (size_t) file_ptr.count * size) ||
+           insert_dynamic(&file_ptrs, (uchar*) &file_ptr);
+  }
   elements+= tree.elements_in_tree;
   file_ptr.count=tree.elements_in_tree;
   file_ptr.file_pos=my_b_tell(&file);
@@ -414,6 +495,7 @@ Unique::reset()
   }
   my_free(sort.record_pointers);
   elements= 0;
+  array_elements= array_sorted= 0;
   tree.flag= 0;
   sort.record_pointers= 0;
 }
@@ -640,9 +722,17 @@ bool Unique::walk(TABLE *table, tree_walk_action action, void *walk_action_arg)
   uchar *merge_buffer;
 
   if (elements == 0)                       /* the whole tree is in memory */
-    return tree_walk(&tree, action, walk_action_arg, left_root_right);
+  {
+    if (!use_array)
+      return tree_walk(&tree, action, walk_action_arg, left_root_right);
+    compact_array();
+    for (ulong i= 0; i < array_elements; i++)
+      if (action(array_buff + (size_t) i * size, 1, walk_action_arg))
+        return 1;
+    return 0;
+  }
 
-  sort.return_rows= elements+tree.elements_in_tree;
+  sort.return_rows= elements + elements_in_tree();
   /* flush current tree to the file to have some memory for merge buffer */
   if (flush())
     return 1;
@@ -761,9 +851,22 @@ bool Unique::get(TABLE *table)
 {
   bool rc= 1;
   uchar *sort_buffer= NULL;
-  sort.return_rows= elements+tree.elements_in_tree;
+  sort.return_rows= elements + elements_in_tree();
   DBUG_ENTER("Unique::get");
 
+  if (my_b_tell(&file) == 0 && use_array)
+  {
+    /* record_pointers must be set even if there are no elements */
+    if (!array_buff &&
+        !(array_buff= (uchar*) my_malloc(size, MYF(MY_THREAD_SPECIFIC |
+                                                   MY_WME))))
+      DBUG_RETURN(1);
+    /* The sorted array is the result; a later add allocates a new one */
+    sort.record_pointers= array_buff;
+    array_buff= NULL;
+    array_elements= array_sorted= array_capacity= 0;
+    DBUG_RETURN(0);
+  }
   if (my_b_tell(&file) == 0)
   {
     /* Whole tree is in memory;  Don't use disk if you don't need to */
@@ -24,6 +24,11 @@
    it's dumped to the file. User can request sorted values, or
    just iterate through them. In the last case tree merging is performed in
    memory simultaneously with iteration, so it should be ~2-3x faster.
+
+   If use_array is set, the values are appended to a flat array instead,
+   which is sorted and freed of duplicates when it is full or the values
+   are read. This holds several times more values than the tree in the
+   same memory. It can't be used with counters or close_for_expansion().
  */
 
 class Unique :public Sql_alloc
@@ -38,21 +43,41 @@ class Unique :public Sql_alloc
   uint full_size;
   uint min_dupl_count;   /* always 0 for unions, > 0 for intersections */
   bool with_counters;
+  bool use_array;        /* Values are kept in array_buff, not in tree */
+  uchar *array_buff;
+  ulong array_elements;  /* Number of values in array_buff */
+  ulong array_sorted;    /* The first array_sorted values are unique */
+  ulong array_capacity;
 
   bool merge(TABLE *table, uchar *buff, bool without_last_merge);
   bool flush();
+  bool grow_array();
+  void compact_array();
 
 public:
   ulong elements;
   SORT_INFO sort;
   Unique(qsort_cmp2 comp_func, void *comp_func_fixed_arg,
 	 uint size_arg, size_t max_in_memory_size_arg,
-         uint min_dupl_count_arg= 0);
+         uint min_dupl_count_arg= 0, bool use_array_arg= false);
   ~Unique();
-  ulong elements_in_tree() { return tree.elements_in_tree; }
+  ulong elements_in_tree()
+  {
+    if (!use_array)
+      return tree.elements_in_tree;
+    compact_array();
+    return array_elements;
+  }
   inline bool unique_add(void *ptr)
   {
     DBUG_ENTER("unique_add");
+    if (use_array)
+    {
+      if (array_elements == array_capacity && grow_array())
+        DBUG_RETURN(1);
+      memcpy(array_buff + (size_t) array_elements++ * size, ptr, size);
+      DBUG_RETURN(0);
+    }
     DBUG_PRINT("info", ("tree %u - %lu", tree.elements_in_tree, max_elements));
     if (!(tree.flag & TREE_ONLY_DUPS) && 
         tree.elements_in_tree >= max_elements && flush())
@@ -61,7 +86,11 @@ class Unique :public Sql_alloc
   }
 
   bool is_in_memory() { return (my_b_tell(&file) == 0); }
-  void close_for_expansion() { tree.flag= TREE_ONLY_DUPS; }
+  void close_for_expansion()
+  {
+    DBUG_ASSERT(!use_array);
+    tree.flag= TREE_ONLY_DUPS;
+  }
 
   bool get(TABLE *table);
   
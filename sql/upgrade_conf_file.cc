@@ -104,7 +104,6 @@ static const char *removed_variables[] =
 "innodb_stats_update_need_lock",
 "innodb_support_xa",
 "innodb_thread_concurrency_timer_based",
-"innodb_track_changed_pages",
 "innodb_track_redo_log_now",
 "innodb_use_fallocate",
 "innodb_use_global_flush_log_at_trx_commit",
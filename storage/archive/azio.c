@@ -66,6 +66,7 @@ int az_open (azio_stream *s, const char *path, int Flags, File fd)
   s->stream.next_in = s->inbuf;
   s->stream.next_out = s->outbuf;
   s->stream.avail_in = s->stream.avail_out = 0;
+  s->read_pos = s->read_end = s->outbuf;
   s->z_err = Z_OK;
   s->z_eof = 0;
   s->in = 0;
@@ -451,10 +452,12 @@ int destroy (s)
 }
 
 /* ===========================================================================
-  Reads the given number of uncompressed bytes from the compressed file.
-  azread returns the number of bytes actually read (0 for end of file).
+  Reads the given number of uncompressed bytes from the compressed file,
+  bypassing the read-ahead buffer.
+  azread_stream returns the number of bytes actually read (0 for end of file).
 */
-unsigned int ZEXPORT azread ( azio_stream *s, voidp buf, size_t len, int *error)
+static unsigned int azread_stream(azio_stream *s, voidp buf, size_t len,
+                                  int *error)
 {
   Bytef *start = (Bytef*)buf; /* starting point for crc computation */
   Byte  *next_out; /* == stream.next_out but not forced far (for MSDOS) */
@@ -578,6 +581,55 @@ unsigned int ZEXPORT azread ( azio_stream *s, voidp buf, size_t len, int *error)
 }
 
 
+/* ===========================================================================
+  Reads the given number of uncompressed bytes from the compressed file.
+  azread returns the number of bytes actually read (0 for end of file).
+
+  Rows are read with two short reads each, so short reads are served from
+  data inflated ahead into outbuf, which is not used when reading. This
+  saves calls to inflate() and crc32() for every row of a scan.
+*/
+unsigned int ZEXPORT azread ( azio_stream *s, voidp buf, size_t len, int *error)
+{
+  size_t avail = (size_t)(s->read_end - s->read_pos);
+  size_t copied;
+  unsigned int n;
+
+  if (len <= avail)
+  {
+    memcpy(buf, s->read_pos, len);
+    s->read_pos += len;
+    *error = 0;
+    return (uint)len;
+  }
+  memcpy(buf, s->read_pos, avail);
+  buf = (Bytef*)buf + avail;
+  len -= avail;
+  s->read_pos = s->read_end = s->outbuf;
+
+  if (len >= AZ_BUFSIZE_WRITE / 2 || s->mode != 'r')
+  {
+    n = azread_stream(s, buf, len, error);
+    return (uint)avail + n;
+  }
+
+  s->stream.next_out = s->outbuf;
+  n = azread_stream(s, s->outbuf, AZ_BUFSIZE_WRITE, error);
+  if (*error)
+  {
+    /* Return what was inflated before the error, report it when needed */
+    n = (uint)(s->stream.next_out - s->outbuf);
+  }
+  s->read_end = s->outbuf + n;
+  copied = MY_MIN(len, n);
+  memcpy(buf, s->outbuf, copied);
+  s->read_pos = s->outbuf + copied;
+  if (copied == len)
+    *error = 0;
+  return (uint)(avail + copied);
+}
+
+
 /* ===========================================================================
   Writes the given number of uncompressed bytes into the compressed file.
   azwrite returns the number of bytes actually written (0 in case of error).
@@ -716,6 +768,7 @@ int azrewind (s)
   s->z_err = Z_OK;
   s->z_eof = 0;
   s->back = EOF;
+  s->read_pos = s->read_end = s->outbuf;
   s->stream.avail_in = 0;
   s->stream.next_in = (Bytef *)s->inbuf;
   s->crc = crc32(0L, Z_NULL, 0);
@@ -767,8 +820,15 @@ my_off_t azseek (s, offset, whence)
 
   /* compute absolute position */
   if (whence == SEEK_CUR) {
-    offset += s->out;
+    offset += s->out - (s->read_end - s->read_pos);
+  }
+
+  /* Skip forward within the read-ahead buffer, or drop it */
+  if (offset >= s->out - (s->read_end - s->read_pos) && offset <= s->out) {
+    s->read_pos = s->read_end - (s->out - offset);
+    return offset;
   }
+  s->read_pos = s->read_end = s->outbuf;
 
   if (s->transparent) {
     /* map to my_seek */
@@ -800,7 +860,7 @@ my_off_t azseek (s, offset, whence)
     unsigned int size = AZ_BUFSIZE_WRITE;
     if (offset < AZ_BUFSIZE_WRITE) size = (int)offset;
 
-    size = azread(s, s->outbuf, size, &error);
+    size = azread_stream(s, s->outbuf, size, &error);
     if (error < 0) return -1L;
     offset -= size;
   }
@@ -216,6 +216,8 @@ typedef struct azio_stream {
   my_off_t  out;     /* bytes out of deflate or inflate */
   int      back;    /* one character push-back */
   int      last;    /* true if push-back is last character */
+  Byte     *read_pos; /* next read-ahead byte in outbuf, see azread() */
+  Byte     *read_end; /* end of read-ahead data in outbuf */
   unsigned char version;   /* Version */
   unsigned char minor_version;   /* Version */
   unsigned int block_size;   /* Block Size */
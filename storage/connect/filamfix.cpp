@@ -946,6 +946,11 @@ bool BGXFAM::OpenTableFile(PGLOBAL g)
     htrc(" rc=%d oflag=%p tmode=%p handle=%p fn=%s\n",
          rc, oflag, tmode, Hfile, filename);
 
+#if defined(POSIX_FADV_SEQUENTIAL)
+  // Tables are mostly scanned, let the system read ahead more
+  if (!rc && mode == MODE_READ)
+    posix_fadvise(Hfile, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif   // POSIX_FADV_SEQUENTIAL
 #endif  // UNIX
 
   if (!rc) {
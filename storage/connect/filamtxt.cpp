@@ -608,6 +608,12 @@ bool DOSFAM::OpenTableFile(PGLOBAL g)
   if (trace(1))
     htrc("File %s open Stream=%p mode=%s\n", filename, Stream, opmode);
 
+#if defined(POSIX_FADV_SEQUENTIAL)
+  // Tables are mostly scanned, let the system read ahead more
+  if (mode == MODE_READ)
+    posix_fadvise(_fileno(Stream), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif   // POSIX_FADV_SEQUENTIAL
+
   To_Fb = dbuserp->Openlist;     // Keep track of File block
 
   /*********************************************************************/
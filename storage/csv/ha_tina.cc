@@ -652,6 +652,62 @@ int ha_tina::chain_append()
 }
 
 
+/*
+  Move past the field starting at *offset without decoding it, like
+  find_current_row() does for the fields that are read.
+
+  RETURN
+    0  ok, *offset is the start of the next field
+    1  the field is damaged
+*/
+
+bool ha_tina::skip_field(my_off_t *offset, my_off_t end_offset,
+                         bool ietf_quotes)
+{
+  my_off_t curr_offset= *offset;
+  char curr_char;
+
+  if (file_buff->get_value(curr_offset) == '"')
+  {
+    for (curr_offset++; curr_offset < end_offset; curr_offset++)
+    {
+      curr_char= file_buff->get_value(curr_offset);
+      if (curr_char == '"' &&
+          (curr_offset == end_offset - 1 ||
+           file_buff->get_value(curr_offset + 1) == ','))
+      {
+        curr_offset+= 2;
+        break;
+      }
+      if ((ietf_quotes && curr_char == '"' &&
+           file_buff->get_value(curr_offset + 1) == '"') ||
+          (curr_char == '\\' && curr_offset != end_offset - 1))
+        curr_offset++;
+      else if (curr_offset == end_offset - 1)
+        return 1;
+    }
+  }
+  else
+  {
+    for ( ; curr_offset < end_offset; curr_offset++)
+    {
+      curr_char= file_buff->get_value(curr_offset);
+      if (curr_char == ',')
+      {
+        curr_offset++;
+        break;
+      }
+      if (curr_char == '\\' && curr_offset != end_offset - 1)
+        curr_offset++;
+      else if (curr_offset == end_offset - 1 && curr_char == '"')
+        return 1;
+    }
+  }
+  *offset= curr_offset;
+  return 0;
+}
+
+
 /*
   Scans for a row.
 */
@@ -720,6 +776,13 @@ int ha_tina::find_current_row(uchar *buf)
     buffer.length(0);
     if (curr_offset >= end_offset)
       goto err;
+    if (!read_all && !bitmap_is_set(table->read_set, (*field)->field_index))
+    {
+      /* Only find the end of a field that is not read */
+      if (skip_field(&curr_offset, end_offset, ietf_quotes))
+        goto err;
+      continue;
+    }
     curr_char= file_buff->get_value(curr_offset);
     /* Handle the case where the first character is a quote */
     if (curr_char == '"')
@@ -818,38 +881,35 @@ int ha_tina::find_current_row(uchar *buf)
       }
     }
 
-    if (read_all || bitmap_is_set(table->read_set, (*field)->field_index))
+    bool is_enum= ((*field)->real_type() ==  MYSQL_TYPE_ENUM);
+    /*
+      Here CHECK_FIELD_WARN checks that all values in the csv file are valid
+      which is normally the case, if they were written  by
+      INSERT -> ha_tina::write_row. '0' values on ENUM fields are considered
+      invalid by Field_enum::store() but it can store them on INSERT anyway.
+      Thus, for enums we silence the warning, as it doesn't really mean
+      an invalid value.
+    */
+    if ((*field)->store(buffer.ptr(), buffer.length(), buffer.charset(),
+                        is_enum ? CHECK_FIELD_IGNORE : CHECK_FIELD_WARN))
     {
-      bool is_enum= ((*field)->real_type() ==  MYSQL_TYPE_ENUM);
-      /*
-        Here CHECK_FIELD_WARN checks that all values in the csv file are valid
-        which is normally the case, if they were written  by
-        INSERT -> ha_tina::write_row. '0' values on ENUM fields are considered
-        invalid by Field_enum::store() but it can store them on INSERT anyway.
-        Thus, for enums we silence the warning, as it doesn't really mean
-        an invalid value.
-      */
-      if ((*field)->store(buffer.ptr(), buffer.length(), buffer.charset(),
-                          is_enum ? CHECK_FIELD_IGNORE : CHECK_FIELD_WARN))
-      {
-        if (!is_enum)
-          goto err;
-      }
-      if ((*field)->flags & BLOB_FLAG)
+      if (!is_enum)
+        goto err;
+    }
+    if ((*field)->flags & BLOB_FLAG)
+    {
+      Field_blob *blob= *(Field_blob**) field;
+      uchar *src, *tgt;
+      uint length, packlength;
+
+      packlength= blob->pack_length_no_ptr();
+      length= blob->get_length(blob->ptr);
+      memcpy(&src, blob->ptr + packlength, sizeof(char*));
+      if (src)
       {
-        Field_blob *blob= *(Field_blob**) field;
-        uchar *src, *tgt;
-        uint length, packlength;
-
-        packlength= blob->pack_length_no_ptr();
-        length= blob->get_length(blob->ptr);
-        memcpy(&src, blob->ptr + packlength, sizeof(char*));
-        if (src)
-        {
-          tgt= (uchar*) alloc_root(&blobroot, length);
-          bmove(tgt, src, length);
-          memcpy(blob->ptr + packlength, &tgt, sizeof(char*));
-        }
+        tgt= (uchar*) alloc_root(&blobroot, length);
+        bmove(tgt, src, length);
+        memcpy(blob->ptr + packlength, &tgt, sizeof(char*));
       }
     }
   }
@@ -175,6 +175,7 @@ class ha_tina: public handler
   /* The following methods were added just for TINA */
   int encode_quote(const uchar *buf);
   int find_current_row(uchar *buf);
+  bool skip_field(my_off_t *offset, my_off_t end_offset, bool ietf_quotes);
   int chain_append();
 };
 
@@ -81,14 +81,15 @@ my_off_t Transparent_file::read_next()
 }
 
 
-char Transparent_file::get_value(my_off_t offset)
+/*
+  Read the window starting at offset and return the value at offset, see
+  get_value()
+*/
+
+char Transparent_file::read_value(my_off_t offset)
 {
   size_t bytes_read;
 
-  /* check boundaries */
-  if ((lower_bound <= offset) && (((my_off_t) offset) < upper_bound))
-    return buff[offset - lower_bound];
-
   mysql_file_seek(filedes, offset, MY_SEEK_SET, MYF(0));
   /* read appropriate portion of the file */
   if ((bytes_read= mysql_file_read(filedes, buff, buff_size,
@@ -37,6 +37,13 @@ class Transparent_file
   uchar *ptr();
   my_off_t start();
   my_off_t end();
-  char get_value (my_off_t offset);
+  /* Called for every character of a row, so the common case is inline */
+  char get_value (my_off_t offset)
+  {
+    if ((lower_bound <= offset) && (offset < upper_bound))
+      return buff[offset - lower_bound];
+    return read_value(offset);
+  }
+  char read_value(my_off_t offset);
   my_off_t read_next();
 };
@@ -832,6 +832,7 @@ ha_federatedx::ha_federatedx(handlerton *hton,
    txn(0), io(0), stored_result(0)
 {
   bzero(&bulk_insert, sizeof(bulk_insert));
+  bzero(&bulk_delete, sizeof(bulk_delete));
 }
 
 
@@ -2467,6 +2468,9 @@ int ha_federatedx::delete_row(const uchar *buf)
   int error;
   DBUG_ENTER("ha_federatedx::delete_row");
 
+  if (bulk_delete.str)
+    DBUG_RETURN(bulk_delete_row());
+
   delete_string.length(0);
   delete_string.append(STRING_WITH_LEN("DELETE FROM "));
   append_ident(&delete_string, share->table_name,
@@ -2530,6 +2534,175 @@ int ha_federatedx::delete_row(const uchar *buf)
 }
 
 
+/**
+  @brief Prepares the storage engine for bulk deletes.
+
+  @details The rows are then deleted with one
+  DELETE ... WHERE (primary key) IN (...) statement per packet, instead of
+  one statement per row that compares all columns. Tables without a
+  primary key keep the deletes per row, as only the primary key tells
+  the rows apart.
+
+  @retval       0       Bulk delete started
+  @retval       1       Rows are deleted one by one
+*/
+
+bool ha_federatedx::start_bulk_delete()
+{
+  uint page_size;
+  DBUG_ENTER("ha_federatedx::start_bulk_delete");
+
+  dynstr_free(&bulk_delete);
+
+  if (table->s->primary_key == MAX_KEY)
+    DBUG_RETURN(1);
+
+  /*
+    Make sure we have an open connection so that we know the
+    maximum packet size.
+  */
+  if (txn->acquire(share, ha_thd(), FALSE, &io))
+    DBUG_RETURN(1);
+
+  page_size= (uint) my_getpagesize();
+
+  if (init_dynamic_string(&bulk_delete, NULL, page_size, page_size))
+    DBUG_RETURN(1);
+
+  bulk_delete.length= 0;
+  DBUG_RETURN(0);
+}
+
+
+/**
+  @brief Add the primary key of the current row to the bulk delete.
+*/
+
+int ha_federatedx::bulk_delete_row()
+{
+  char values_buffer[FEDERATEDX_QUERY_BUFFER_SIZE];
+  char data_buffer[FEDERATEDX_QUERY_BUFFER_SIZE];
+  String values_string(values_buffer, sizeof(values_buffer), &my_charset_bin);
+  String data_string(data_buffer, sizeof(data_buffer), &my_charset_bin);
+  KEY *key_info= table->key_info + table->s->primary_key;
+  int error;
+  DBUG_ENTER("ha_federatedx::bulk_delete_row");
+
+  values_string.length(0);
+  values_string.append('(');
+
+  Time_zone *saved_time_zone= table->in_use->variables.time_zone;
+  table->in_use->variables.time_zone= UTC;
+  for (uint i= 0; i < key_info->user_defined_key_parts; i++)
+  {
+    Field *field= key_info->key_part[i].field;
+    bool needs_quote= field->str_needs_quotes();
+    if (i)
+      values_string.append(STRING_WITH_LEN(", "));
+    data_string.length(0);
+    field->val_str(&data_string);
+    if (needs_quote)
+      values_string.append(value_quote_char);
+    data_string.print(&values_string);
+    if (needs_quote)
+      values_string.append(value_quote_char);
+  }
+  table->in_use->variables.time_zone= saved_time_zone;
+  values_string.append(')');
+
+  if ((error= txn->acquire(share, ha_thd(), FALSE, &io)))
+    DBUG_RETURN(error);
+
+  /*
+    Send the current bulk delete out if appending the current row would
+    cause the statement to overflow the packet size.
+  */
+  if (bulk_delete.length + values_string.length() + bulk_padding >
+      io->max_query_size() && bulk_delete.length &&
+      (error= flush_bulk_delete()))
+    DBUG_RETURN(error);
+
+  if (bulk_delete.length == 0)
+  {
+    char delete_buffer[FEDERATEDX_QUERY_BUFFER_SIZE];
+    String delete_string(delete_buffer, sizeof(delete_buffer),
+                         &my_charset_bin);
+    delete_string.length(0);
+    delete_string.append(STRING_WITH_LEN("DELETE FROM "));
+    append_ident(&delete_string, share->table_name,
+                 share->table_name_length, ident_quote_char);
+    delete_string.append(STRING_WITH_LEN(" WHERE ("));
+    for (uint i= 0; i < key_info->user_defined_key_parts; i++)
+    {
+      Field *field= key_info->key_part[i].field;
+      if (i)
+        delete_string.append(STRING_WITH_LEN(", "));
+      append_ident(&delete_string, field->field_name.str,
+                   field->field_name.length, ident_quote_char);
+    }
+    delete_string.append(STRING_WITH_LEN(") IN ("));
+    dynstr_append_mem(&bulk_delete, delete_string.ptr(),
+                      delete_string.length());
+  }
+  else
+    dynstr_append_mem(&bulk_delete, ",", 1);
+
+  dynstr_append_mem(&bulk_delete, values_string.ptr(),
+                    values_string.length());
+  DBUG_RETURN(0);
+}
+
+
+/**
+  @brief Send the collected bulk delete to the remote server.
+*/
+
+int ha_federatedx::flush_bulk_delete()
+{
+  int error= 0;
+  DBUG_ENTER("ha_federatedx::flush_bulk_delete");
+
+  dynstr_append_mem(&bulk_delete, ")", 1);
+  DBUG_PRINT("info", ("Delete sql: %s", bulk_delete.str));
+
+  if (io->query(bulk_delete.str, bulk_delete.length))
+    error= stash_remote_error();
+  else
+  {
+    stats.deleted+= (ha_rows) io->affected_rows();
+    stats.records-= (ha_rows) io->affected_rows();
+  }
+  bulk_delete.length= 0;
+  DBUG_RETURN(error);
+}
+
+
+/**
+  @brief End bulk delete.
+
+  @details This method will send any remaining rows to the remote server.
+  Finally, it will deinitialize the bulk delete data structure.
+
+  @return Operation status
+  @retval       0       No error
+  @retval       != 0    Error occurred at remote server. Also sets my_errno.
+*/
+
+int ha_federatedx::end_bulk_delete()
+{
+  int error= 0;
+  DBUG_ENTER("ha_federatedx::end_bulk_delete");
+
+  if (bulk_delete.str && bulk_delete.length &&
+      !(error= txn->acquire(share, ha_thd(), FALSE, &io)))
+    error= flush_bulk_delete();
+
+  dynstr_free(&bulk_delete);
+
+  DBUG_RETURN(my_errno= error);
+}
+
+
 /*
   Positions an index cursor to the index specified in the handle. Fetches the
   row if available. If the key value is null, begin at the first key of the
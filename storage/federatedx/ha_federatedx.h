@@ -278,6 +278,7 @@ class ha_federatedx: public handler
   bool ignore_duplicates, replace_duplicates;
   bool insert_dup_update, table_will_be_deleted;
   DYNAMIC_STRING bulk_insert;
+  DYNAMIC_STRING bulk_delete;
 
 private:
   /*
@@ -286,6 +287,8 @@ class ha_federatedx: public handler
   */
   uint convert_row_to_internal_format(uchar *buf, FEDERATEDX_IO_ROW *row,
                                       FEDERATEDX_IO_RESULT *result);
+  int bulk_delete_row();
+  int flush_bulk_delete();
   bool create_where_from_key(String *to, KEY *key_info,
                              const key_range *start_key,
                              const key_range *end_key,
@@ -333,7 +336,7 @@ class ha_federatedx: public handler
     return (HA_PRIMARY_KEY_IN_READ_INDEX | HA_FILE_BASED
             | HA_REC_NOT_IN_SEQ | HA_AUTO_PART_KEY | HA_CAN_INDEX_BLOBS |
             HA_BINLOG_ROW_CAPABLE | HA_BINLOG_STMT_CAPABLE | HA_CAN_REPAIR |
-            HA_PRIMARY_KEY_REQUIRED_FOR_DELETE |
+            HA_PRIMARY_KEY_REQUIRED_FOR_DELETE | HA_CAN_FORCE_BULK_DELETE |
             HA_PARTIAL_COLUMN_READ | HA_NULL_IN_KEY);
   }
   /*
@@ -396,6 +399,8 @@ class ha_federatedx: public handler
 
   void start_bulk_insert(ha_rows rows, uint flags);
   int end_bulk_insert();
+  bool start_bulk_delete();
+  int end_bulk_delete();
   int write_row(uchar *buf);
   int update_row(const uchar *old_data, const uchar *new_data);
   int delete_row(const uchar *buf);
@@ -608,6 +608,7 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   ha_rows max_rows;
   HP_KEYDEF *keydef;
   HA_KEYSEG *seg;
+  HP_BLOB_DESC *blob_desc;
   TABLE_SHARE *share= table_arg->s;
   bool found_real_auto_increment= 0;
 
@@ -617,10 +618,26 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
     parts+= table_arg->key_info[key].user_defined_key_parts;
 
   if (!(keydef= (HP_KEYDEF*) my_malloc(keys * sizeof(HP_KEYDEF) +
-				       parts * sizeof(HA_KEYSEG),
+				       parts * sizeof(HA_KEYSEG) +
+                                       share->blob_fields *
+                                       sizeof(HP_BLOB_DESC),
 				       MYF(MY_WME | MY_THREAD_SPECIFIC))))
     return my_errno;
   seg= reinterpret_cast<HA_KEYSEG*>(keydef + keys);
+  blob_desc= reinterpret_cast<HP_BLOB_DESC*>(seg + parts);
+
+  /*
+    Only internal temporary tables have BLOB columns, see HA_NO_BLOBS.
+    Their values are stored apart from the records.
+  */
+  for (uint i= 0; i < share->blob_fields; i++)
+  {
+    Field_blob *field= (Field_blob*) table_arg->field[share->blob_field[i]];
+    blob_desc[i].offset= (uint) (field->ptr - table_arg->record[0]);
+    blob_desc[i].packlength= field->pack_length_no_ptr();
+  }
+  hp_create_info->blobs= share->blob_fields;
+  hp_create_info->blob_descs= blob_desc;
   for (key= 0; key < keys; key++)
   {
     KEY *pos= table_arg->key_info+key;
@@ -702,6 +719,15 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
         seg->bit_length= seg->bit_start= 0;
         seg->bit_pos= 0;
       }
+      if (seg->flag & HA_BLOB_PART)
+      {
+        /*
+          The whole values are hashed and compared, so that the key can
+          find duplicates, but it can't be searched with a key image.
+        */
+        DBUG_ASSERT(pos->algorithm != HA_KEY_ALG_BTREE);
+        seg->bit_start= ((Field_blob*) field)->pack_length_no_ptr();
+      }
     }
   }
   mem_per_row+= MY_ALIGN(MY_MAX(share->reclength, sizeof(char*)) + 1, sizeof(char*));
@@ -713,6 +739,13 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   hp_create_info->auto_key= auto_key;
   hp_create_info->auto_key_type= auto_key_type;
   hp_create_info->max_table_size=current_thd->variables.max_heap_table_size;
+  /*
+    The size of the BLOB values is not in max_rows, so check it against the
+    limit of in-memory temporary tables.
+  */
+  if (internal_table && share->blob_fields)
+    set_if_smaller(hp_create_info->max_table_size,
+                   current_thd->variables.tmp_memory_table_size);
   hp_create_info->with_auto_increment= found_real_auto_increment;
   hp_create_info->internal_table= internal_table;
 
@@ -805,12 +838,14 @@ int ha_heap::find_unique_row(uchar *record, uint unique_idx)
   DBUG_ASSERT(keyinfo->flag & HA_NOSAME);
   if (!share->records)
     DBUG_RETURN(1); // not found
+  ulong hashnr= hp_rec_hashnr(keyinfo, record);
   HASH_INFO *pos= hp_find_hash(&keyinfo->block,
-                               hp_mask(hp_rec_hashnr(keyinfo, record),
-                                       share->blength, share->records));
+                               hp_mask(hashnr, share->blength,
+                                       share->records));
   do
   {
-    if (!hp_rec_key_cmp(keyinfo, pos->ptr_to_rec, record))
+    if (pos->hash_of_key == hashnr &&
+        !hp_rec_key_cmp(keyinfo, pos->ptr_to_rec, record))
     {
       file->current_hash_ptr= pos;
       file->current_ptr= pos->ptr_to_rec;
@@ -52,6 +52,21 @@ typedef struct st_hp_hash_info
   ulong hash_of_key;
 } HASH_INFO;
 
+/*
+  The value of a BLOB column is stored in a chunk of its own, allocated to
+  the length of the value. The record holds the length and a pointer to the
+  data, like in the record of the server. All chunks of a table are chained
+  so that they can be freed when the table is cleared.
+*/
+
+typedef struct st_hp_blob_chunk
+{
+  struct st_hp_blob_chunk *next, **prev;
+  size_t length;			/* Allocated length with header */
+} HP_BLOB_CHUNK;
+
+#define HP_BLOB_CHUNK_HEADER ALIGN_SIZE(sizeof(HP_BLOB_CHUNK))
+
 typedef struct {
   HA_KEYSEG *keyseg;
   uint key_length;
@@ -101,6 +116,11 @@ extern void hp_clear(HP_SHARE *info);
 extern void hp_clear_keys(HP_SHARE *info);
 extern uint hp_rb_pack_key(HP_KEYDEF *keydef, uchar *key, const uchar *old,
                            key_part_map keypart_map);
+extern int hp_alloc_blobs(HP_INFO *info, const uchar *record);
+extern void hp_store_blobs(HP_INFO *info, uchar *pos);
+extern void hp_free_blob_buff(HP_INFO *info);
+extern void hp_free_blobs(HP_SHARE *share, uchar *pos);
+extern void hp_free_all_blobs(HP_SHARE *share);
 
 extern mysql_mutex_t THR_LOCK_heap;
 
@@ -129,3 +149,23 @@ static inline ulong hp_mask(ulong hashnr, ulong buffmax, ulong maxlength)
   if ((hashnr & (buffmax-1)) < maxlength) return (hashnr & (buffmax-1));
   return (hashnr & ((buffmax >> 1) -1));
 }
+
+
+/* Length of a BLOB value from the first packlength bytes of the column */
+
+static inline size_t hp_blob_length(uint packlength, const uchar *pos)
+{
+  switch (packlength) {
+  case 1:
+    return (size_t) *pos;
+  case 2:
+    return (size_t) uint2korr(pos);
+  case 3:
+    return (size_t) uint3korr(pos);
+  case 4:
+    return (size_t) uint4korr(pos);
+  default:
+    break;
+  }
+  return 0;
+}
@@ -0,0 +1,170 @@
+/* Copyright (c) 2019, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/*
+  Storage of BLOB values
+
+  The values of a record are copied to chunks in hp_alloc_blobs() before
+  anything else is changed, so that running out of memory leaves the table
+  untouched. hp_store_blobs() then makes the stored record point to them.
+*/
+
+#include "heapdef.h"
+
+
+static uchar *get_blob_data(HP_BLOB_DESC *desc, const uchar *record)
+{
+  uchar *data;
+  memcpy(&data, record + desc->offset + desc->packlength, sizeof(data));
+  return data;
+}
+
+
+static void set_blob_data(HP_BLOB_DESC *desc, uchar *record, uchar *data)
+{
+  memcpy(record + desc->offset + desc->packlength, &data, sizeof(data));
+}
+
+
+/*
+  Copy the BLOB values of a record to new chunks in info->blob_buff
+
+  RETURN
+    0  ok
+    #  error, my_errno is set. HA_ERR_RECORD_FILE_FULL if the values would
+       make the table bigger than max_table_size.
+*/
+
+int hp_alloc_blobs(HP_INFO *info, const uchar *record)
+{
+  HP_SHARE *share= info->s;
+  HP_BLOB_DESC *desc, *end;
+  HP_BLOB_CHUNK **chunk= info->blob_buff;
+  ulonglong table_size= share->data_length + share->index_length;
+  DBUG_ENTER("hp_alloc_blobs");
+
+  bzero(info->blob_buff, share->blobs * sizeof(HP_BLOB_CHUNK*));
+  for (desc= share->blob_descs, end= desc + share->blobs; desc < end;
+       desc++, chunk++)
+  {
+    size_t length= hp_blob_length(desc->packlength, record + desc->offset);
+    if (!length)
+      continue;
+    table_size+= HP_BLOB_CHUNK_HEADER + length;
+    if (table_size > share->max_table_size)
+    {
+      my_errno= HA_ERR_RECORD_FILE_FULL;
+      goto err;
+    }
+    if (!(*chunk= (HP_BLOB_CHUNK*) my_malloc(HP_BLOB_CHUNK_HEADER + length,
+                                             MYF(share->internal ?
+                                                 MY_THREAD_SPECIFIC : 0))))
+      goto err;
+    (*chunk)->length= HP_BLOB_CHUNK_HEADER + length;
+    memcpy((uchar*) *chunk + HP_BLOB_CHUNK_HEADER,
+           get_blob_data(desc, record), length);
+  }
+  DBUG_RETURN(0);
+
+err:
+  hp_free_blob_buff(info);
+  DBUG_RETURN(my_errno);
+}
+
+
+/*
+  Make the record stored at pos use the chunks from hp_alloc_blobs()
+*/
+
+void hp_store_blobs(HP_INFO *info, uchar *pos)
+{
+  HP_SHARE *share= info->s;
+  HP_BLOB_DESC *desc, *end;
+  HP_BLOB_CHUNK **chunk= info->blob_buff;
+
+  for (desc= share->blob_descs, end= desc + share->blobs; desc < end;
+       desc++, chunk++)
+  {
+    if (!*chunk)
+    {
+      /* Don't keep a pointer to memory that we don't own */
+      set_blob_data(desc, pos, (uchar*) 0);
+      continue;
+    }
+    if (((*chunk)->next= share->blob_chunks))
+      share->blob_chunks->prev= &(*chunk)->next;
+    (*chunk)->prev= &share->blob_chunks;
+    share->blob_chunks= *chunk;
+    share->data_length+= (*chunk)->length;
+    set_blob_data(desc, pos, (uchar*) *chunk + HP_BLOB_CHUNK_HEADER);
+    *chunk= 0;
+  }
+}
+
+
+/*
+  Free the chunks from hp_alloc_blobs() that were not stored
+*/
+
+void hp_free_blob_buff(HP_INFO *info)
+{
+  HP_BLOB_CHUNK **chunk, **end;
+
+  for (chunk= info->blob_buff, end= chunk + info->s->blobs; chunk < end;
+       chunk++)
+  {
+    my_free(*chunk);
+    *chunk= 0;
+  }
+}
+
+
+/*
+  Free the BLOB values of the record stored at pos
+*/
+
+void hp_free_blobs(HP_SHARE *share, uchar *pos)
+{
+  HP_BLOB_DESC *desc, *end;
+
+  for (desc= share->blob_descs, end= desc + share->blobs; desc < end; desc++)
+  {
+    HP_BLOB_CHUNK *chunk;
+    if (!hp_blob_length(desc->packlength, pos + desc->offset))
+      continue;
+    chunk= (HP_BLOB_CHUNK*) (get_blob_data(desc, pos) - HP_BLOB_CHUNK_HEADER);
+    if ((*chunk->prev= chunk->next))
+      chunk->next->prev= chunk->prev;
+    share->data_length-= chunk->length;
+    my_free(chunk);
+  }
+}
+
+
+/*
+  Free the BLOB values of all records
+*/
+
+void hp_free_all_blobs(HP_SHARE *share)
+{
+  HP_BLOB_CHUNK *chunk, *next;
+
+  for (chunk= share->blob_chunks; chunk; chunk= next)
+  {
+    next= chunk->next;
+    my_free(chunk);
+  }
+  share->blob_chunks= 0;
+}
@@ -35,6 +35,8 @@ void hp_clear(HP_SHARE *info)
     (void) hp_free_level(&info->block,info->block.levels,info->block.root,
 			(uchar*) 0);
   info->block.levels=0;
+  if (info->blobs)
+    hp_free_all_blobs(info);
   hp_clear_keys(info);
   info->records= info->deleted= 0;
   info->data_length= 0;
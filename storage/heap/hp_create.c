@@ -78,6 +78,17 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
 	  if (keyinfo->algorithm == HA_KEY_ALG_BTREE)
 	    keyinfo->rb_tree.size_of_element++;
 	}
+        if (keyinfo->seg[j].flag & HA_BLOB_PART)
+        {
+          /*
+            Hash keys compare the whole values in the records, bit_start
+            is the packlength of the column.
+          */
+          DBUG_ASSERT(keyinfo->algorithm == HA_KEY_ALG_HASH);
+          keyinfo->flag|= HA_VAR_LENGTH_KEY;
+          length+= 2;
+          continue;
+        }
 	switch (keyinfo->seg[j].type) {
 	case HA_KEYTYPE_SHORT_INT:
 	case HA_KEYTYPE_LONG_INT:
@@ -161,7 +172,9 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
     }
     if (!(share= (HP_SHARE*) my_malloc((uint) sizeof(HP_SHARE)+
 				       keys*sizeof(HP_KEYDEF)+
-				       key_segs*sizeof(HA_KEYSEG),
+				       key_segs*sizeof(HA_KEYSEG)+
+                                       create_info->blobs *
+                                       sizeof(HP_BLOB_DESC),
 				       MYF(MY_ZEROFILL |
                                            (create_info->internal_table ?
                                             MY_THREAD_SPECIFIC : 0)))))
@@ -206,6 +219,10 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
       if ((keyinfo->flag & HA_AUTO_KEY) && create_info->with_auto_increment)
         share->auto_key= i + 1;
     }
+    share->blobs= create_info->blobs;
+    share->blob_descs= (HP_BLOB_DESC*) keyseg;
+    memcpy(share->blob_descs, create_info->blob_descs,
+           sizeof(HP_BLOB_DESC) * create_info->blobs);
     share->min_records= min_records;
     share->max_records= max_records;
     share->max_table_size= create_info->max_table_size;
@@ -108,15 +108,20 @@ uchar *hp_search(HP_INFO *info, HP_KEYDEF *keyinfo, const uchar *key,
 
   if (share->records)
   {
-    ulong search_pos=
-      hp_mask(hp_hashnr(keyinfo, key), share->blength, share->records);
+    ulong hashnr= hp_hashnr(keyinfo, key);
+    ulong search_pos= hp_mask(hashnr, share->blength, share->records);
     pos=hp_find_hash(&keyinfo->block, search_pos);
     if (search_pos !=
         hp_mask(pos->hash_of_key, share->blength, share->records))
       goto not_found;                           /* Wrong link */
     do
     {
-      if (!hp_key_cmp(keyinfo, pos->ptr_to_rec, key))
+      /*
+        Links of other hash values share the chain, skip them without
+        reading their records.
+      */
+      if (pos->hash_of_key == hashnr &&
+          !hp_key_cmp(keyinfo, pos->ptr_to_rec, key))
       {
 	switch (nextflag) {
 	case 0:					/* Search after key */
@@ -168,16 +173,19 @@ uchar *hp_search(HP_INFO *info, HP_KEYDEF *keyinfo, const uchar *key,
 /*
   Search next after last read;  Assumes that the table hasn't changed
   since last read !
+  pos is the last link found, so it has the hash value of the key.
 */
 
 uchar *hp_search_next(HP_INFO *info, HP_KEYDEF *keyinfo, const uchar *key,
 		      HASH_INFO *pos)
 {
+  ulong hashnr= pos->hash_of_key;
   DBUG_ENTER("hp_search_next");
 
   while ((pos= pos->next_key))
   {
-    if (! hp_key_cmp(keyinfo, pos->ptr_to_rec, key))
+    if (pos->hash_of_key == hashnr &&
+        ! hp_key_cmp(keyinfo, pos->ptr_to_rec, key))
     {
       info->current_hash_ptr=pos;
       DBUG_RETURN (info->current_ptr= pos->ptr_to_rec);
@@ -297,7 +305,15 @@ ulong hp_rec_hashnr(register HP_KEYDEF *keydef, register const uchar *rec)
 	continue;
       }
     }
-    if (seg->type == HA_KEYTYPE_TEXT)
+    if (seg->flag & HA_BLOB_PART)
+    {
+      CHARSET_INFO *cs= seg->charset;
+      size_t length= hp_blob_length(seg->bit_start, pos);
+      uchar *data;
+      memcpy(&data, pos + seg->bit_start, sizeof(data));
+      cs->coll->hash_sort(cs, data, length, &nr, &nr2);
+    }
+    else if (seg->type == HA_KEYTYPE_TEXT)
     {
       CHARSET_INFO *cs= seg->charset;
       size_t char_length= seg->length;
@@ -441,7 +457,14 @@ ulong hp_rec_hashnr(register HP_KEYDEF *keydef, register const uchar *rec)
 	continue;
       }
     }
-    if (seg->type == HA_KEYTYPE_TEXT)
+    if (seg->flag & HA_BLOB_PART)
+    {
+      size_t length= hp_blob_length(seg->bit_start, pos);
+      uchar *data;
+      memcpy(&data, pos + seg->bit_start, sizeof(data));
+      seg->charset->coll->hash_sort(seg->charset, data, length, &nr, &nr2);
+    }
+    else if (seg->type == HA_KEYTYPE_TEXT)
     {
       uint char_length= seg->length; /* TODO: fix to use my_charpos() */
       seg->charset->coll->hash_sort(seg->charset, pos, char_length,
@@ -513,7 +536,20 @@ int hp_rec_key_cmp(HP_KEYDEF *keydef, const uchar *rec1, const uchar *rec2)
       if (rec1[seg->null_pos] & seg->null_bit)
 	continue;
     }
-    if (seg->type == HA_KEYTYPE_TEXT)
+    if (seg->flag & HA_BLOB_PART)
+    {
+      const uchar *pos1= rec1 + seg->start;
+      const uchar *pos2= rec2 + seg->start;
+      size_t length1= hp_blob_length(seg->bit_start, pos1);
+      size_t length2= hp_blob_length(seg->bit_start, pos2);
+      uchar *data1, *data2;
+      memcpy(&data1, pos1 + seg->bit_start, sizeof(data1));
+      memcpy(&data2, pos2 + seg->bit_start, sizeof(data2));
+      if (seg->charset->coll->strnncollsp(seg->charset,
+                                          data1, length1, data2, length2))
+        return 1;
+    }
+    else if (seg->type == HA_KEYTYPE_TEXT)
     {
       CHARSET_INFO *cs= seg->charset;
       size_t char_length1;
@@ -1417,6 +1417,43 @@ btr_free(
 	mtr.commit();
 }
 
+/** Empty an index tree, keeping only an empty root page.
+This is used in the rollback of TRX_UNDO_EMPTY.
+@param[in,out]	index	index tree */
+void
+btr_clear(dict_index_t* index)
+{
+	ut_ad(!dict_index_is_ibuf(index));
+
+	mtr_t		mtr;
+	mtr.start();
+	if (index->table->is_temporary()) {
+		mtr.set_log_mode(MTR_LOG_NO_REDO);
+	} else {
+		index->set_modified(mtr);
+	}
+	mtr_x_lock(dict_index_get_lock(index), &mtr);
+
+	if (buf_block_t* root = btr_root_block_get(index, RW_X_LATCH, &mtr)) {
+		btr_free_but_not_root(root, mtr.get_log_mode());
+
+		/* btr_free_but_not_root() freed the whole leaf segment,
+		including its inode. Create a new one for the root page,
+		like btr_create() does. */
+		if (!fseg_create(index->table->space, index->page,
+				 PAGE_HEADER + PAGE_BTR_SEG_LEAF, &mtr)) {
+			ib::error() << "Out of space when emptying index "
+				    << index->name << " of table "
+				    << index->table->name;
+		}
+
+		btr_page_empty(root, buf_block_get_page_zip(root), index, 0,
+			       &mtr);
+	}
+
+	mtr.commit();
+}
+
 /** Read the last used AUTO_INCREMENT value from PAGE_ROOT_AUTO_INC.
 @param[in,out]	index	clustered index
 @return	the last used AUTO_INCREMENT value
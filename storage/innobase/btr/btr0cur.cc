@@ -3467,7 +3467,8 @@ btr_cur_optimistic_insert(
 			ut_ad(trx_id[1].len == DATA_ROLL_PTR_LEN);
 			ut_ad(*static_cast<const byte*>
 			      (trx_id[1].data) & 0x80);
-			if (flags & BTR_NO_UNDO_LOG_FLAG) {
+			if ((flags & BTR_NO_UNDO_LOG_FLAG)
+			    && !(thr && thr->graph->trx->bulk_insert)) {
 				ut_ad(!memcmp(trx_id->data, reset_trx_id,
 					      DATA_TRX_ID_LEN));
 			} else {
@@ -3583,9 +3584,16 @@ btr_cur_optimistic_insert(
 
 /*************************************************************//**
 Performs an insert on a page of an index tree. It is assumed that mtr
-holds an x-latch on the tree and on the cursor page. If the insert is
-made on the leaf level, to avoid deadlocks, mtr must also own x-latches
-to brothers of page, if those brothers exist.
+holds an sx-latch (or x-latch) on the tree and an x-latch on the cursor
+page. If the insert is made on the leaf level, to avoid deadlocks, mtr
+must also own x-latches to brothers of page, if those brothers exist.
+
+The sx-latch on index->lock lets readers and optimistic (leaf-only)
+inserts proceed during the split; only other tree modifications of the
+same index wait. It cannot be released once the affected pages are
+latched: btr_insert_on_non_leaf_level() locates the parent pages with
+BTR_CONT_MODIFY_TREE, which descends without latching the upper levels
+and relies on no other split or merge running in the index.
 @return DB_SUCCESS or error number */
 dberr_t
 btr_cur_pessimistic_insert(
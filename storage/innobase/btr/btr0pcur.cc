@@ -28,6 +28,10 @@ Created 2/23/1996 Heikki Tuuri
 #include "ut0byte.h"
 #include "rem0cmp.h"
 #include "trx0trx.h"
+#include "buf0rea.h"
+#include "srv0srv.h"
+
+#include <algorithm>
 
 /**************************************************************//**
 Allocates memory for a persistent cursor object and initializes the cursor.
@@ -63,6 +67,8 @@ btr_pcur_reset(
 	cursor->old_rec = NULL;
 	cursor->old_n_fields = 0;
 	cursor->old_stored = false;
+	cursor->scan_no_cache = false;
+	cursor->block_read_by_scan = false;
 
 	cursor->latch_mode = BTR_NO_LATCHES;
 	cursor->pos_state = BTR_PCUR_NOT_POSITIONED;
@@ -275,6 +281,7 @@ btr_pcur_restore_position_func(
 			BTR_LATCH_MODE_WITHOUT_INTENTION(latch_mode);
 		cursor->pos_state = BTR_PCUR_IS_POSITIONED;
 		cursor->block_when_stored = btr_pcur_get_block(cursor);
+		cursor->block_read_by_scan = false;
 
 		return(FALSE);
 	}
@@ -338,6 +345,8 @@ btr_pcur_restore_position_func(
 
 	/* If optimistic restoration did not succeed, open the cursor anew */
 
+	cursor->block_read_by_scan = false;
+
 	heap = mem_heap_create(256);
 
 	tuple = dict_index_build_data_tuple(cursor->old_rec, index, true,
@@ -407,6 +416,102 @@ btr_pcur_restore_position_func(
 	return(FALSE);
 }
 
+/** Read ahead the leaf pages that follow a page in key order.
+The node pointers to them are looked up on the parent page; the path from
+the root is only accessed if it is in the buffer pool and can be latched
+without waiting, because the caller is holding a latch on the leaf page.
+The read requests are submitted in ascending page number order, so that
+adjacent pages can be merged into larger reads.
+@param[in]	block	leaf page that the cursor is leaving
+@param[in]	index	B-tree */
+static
+void
+btr_pcur_read_ahead_logical(
+	const buf_block_t*	block,
+	const dict_index_t*	index)
+{
+	const rec_t*	rec = page_rec_get_prev_const(
+		page_get_supremum_rec(block->frame));
+
+	if (page_rec_is_infimum(rec)) {
+		return;
+	}
+
+	const ulint	space_id = block->page.id.space();
+	const ulint	n_max = BUF_READ_AHEAD_AREA(
+		buf_pool_get(block->page.id));
+	ulint		page_nos[BUF_READ_AHEAD_PAGES];
+	ulint		n_stored = 0;
+	ulint		page_no = index->page;
+	mem_heap_t*	heap = mem_heap_create(256);
+	ulint*		offsets = NULL;
+	mtr_t		mtr;
+
+	ut_ad(n_max <= BUF_READ_AHEAD_PAGES);
+
+	const dtuple_t*	tuple = dict_index_build_data_tuple(
+		rec, index, true, dict_index_get_n_unique_in_tree(index),
+		heap);
+
+	mtr.start();
+
+	for (;;) {
+		buf_block_t*	parent = buf_page_try_get(
+			page_id_t(space_id, page_no), &mtr);
+
+		if (!parent) {
+			break;
+		}
+
+		const page_t*	page = buf_block_get_frame(parent);
+
+		if (page_is_leaf(page)
+		    || btr_page_get_index_id(page) != index->id) {
+			break;
+		}
+
+		page_cur_t	cur;
+
+		page_cur_search(parent, index, tuple, PAGE_CUR_LE, &cur);
+		rec = page_cur_get_rec(&cur);
+
+		if (page_rec_is_infimum(rec)) {
+			break;
+		}
+
+		if (btr_page_get_level(page) > 1) {
+			offsets = rec_get_offsets(rec, index, offsets, false,
+						  ULINT_UNDEFINED, &heap);
+			page_no = btr_node_ptr_get_child_page_no(rec, offsets);
+			continue;
+		}
+
+		/* rec points to block; collect the pages after it. */
+		while (n_stored < n_max) {
+			rec = page_rec_get_next_const(rec);
+
+			if (page_rec_is_supremum(rec)) {
+				break;
+			}
+
+			offsets = rec_get_offsets(rec, index, offsets, false,
+						  ULINT_UNDEFINED, &heap);
+			page_nos[n_stored++] = btr_node_ptr_get_child_page_no(
+				rec, offsets);
+		}
+
+		break;
+	}
+
+	mtr.commit();
+	mem_heap_free(heap);
+
+	std::sort(page_nos, page_nos + n_stored);
+
+	buf_read_ahead_logical(space_id, block->page.size,
+			       page_nos, n_stored);
+}
+
 /*********************************************************//**
 Moves the persistent cursor to the first record on the next page. Releases the
 latch on the current page, and bufferunfixes it. Note that there must not be
@@ -450,11 +555,26 @@ btr_pcur_move_to_next_page(
 		mode = BTR_MODIFY_LEAF;
 	}
 
-	buf_block_t*	block = btr_pcur_get_block(cursor);
+	buf_block_t*		block = btr_pcur_get_block(cursor);
+	const page_id_t		next_page_id(block->page.id.space(),
+					     next_page_no);
+	const bool		next_read_by_scan = cursor->scan_no_cache
+		&& buf_page_peek_unaccessed(next_page_id);
+
+	/* A scan that bypasses the LRU list (innodb_scan_no_cache)
+	is going to read the following pages anyway. */
+	if ((srv_logical_read_ahead || cursor->scan_no_cache)
+	    && mode == BTR_SEARCH_LEAF
+	    && !buf_page_peek(next_page_id)) {
+		dict_index_t*	index = btr_pcur_get_btr_cur(cursor)->index;
+
+		if (!dict_index_is_spatial(index)) {
+			btr_pcur_read_ahead_logical(block, index);
+		}
+	}
 
 	next_block = btr_block_get(
-		page_id_t(block->page.id.space(), next_page_no),
-		block->page.size, mode,
+		next_page_id, block->page.size, mode,
 		btr_pcur_get_btr_cur(cursor)->index, mtr);
 
 	if (UNIV_UNLIKELY(!next_block)) {
@@ -468,9 +588,15 @@ btr_pcur_move_to_next_page(
 	     == btr_pcur_get_block(cursor)->page.id.page_no());
 #endif /* UNIV_BTR_DEBUG */
 
+	if (cursor->block_read_by_scan) {
+		/* Nobody else was interested in the page. */
+		buf_page_make_old(&block->page);
+	}
+
 	btr_leaf_page_release(btr_pcur_get_block(cursor), mode, mtr);
 
 	page_cur_set_before_first(next_block, btr_pcur_get_page_cur(cursor));
+	cursor->block_read_by_scan = next_read_by_scan;
 
 	ut_d(page_check_dir(next_page));
 }
@@ -552,6 +678,7 @@ btr_pcur_move_backward_from_page(
 
 	cursor->latch_mode = latch_mode;
 	cursor->old_stored = false;
+	cursor->block_read_by_scan = false;
 }
 
 /*********************************************************//**
@@ -70,6 +70,11 @@ indexes. We will allocate the latches from dynamic memory to get it to the
 same DRAM page as other hotspot semaphores */
 rw_lock_t**	btr_search_latches;
 
+/** Memory for btr_search_latches[]. Each latch is allocated in its own
+cache line(s), so that lookups in one adaptive hash index partition do
+not invalidate the latch of another partition in other CPU caches. */
+static void*	btr_search_latch_mem;
+
 /** padding to prevent other memory update hotspots from residing on
 the same memory cache line */
 UNIV_INTERN byte		btr_sea_pad2[CACHE_LINE_SIZE];
@@ -234,10 +239,19 @@ void btr_search_sys_create(ulint hash_size)
 	btr_search_latches = reinterpret_cast<rw_lock_t**>(
 		ut_malloc(sizeof(rw_lock_t*) * btr_ahi_parts, mem_key_ahi));
 
+	const ulint	latch_size = ut_calc_align(sizeof(rw_lock_t),
+						     CACHE_LINE_SIZE);
+
+	btr_search_latch_mem = ut_malloc(latch_size * btr_ahi_parts
+					 + CACHE_LINE_SIZE, mem_key_ahi);
+
+	byte*	latch_mem = static_cast<byte*>(
+		ut_align(btr_search_latch_mem, CACHE_LINE_SIZE));
+
 	for (ulint i = 0; i < btr_ahi_parts; ++i) {
 
 		btr_search_latches[i] = reinterpret_cast<rw_lock_t*>(
-			ut_malloc(sizeof(rw_lock_t), mem_key_ahi));
+			latch_mem + i * latch_size);
 
 		rw_lock_create(btr_search_latch_key,
 			       btr_search_latches[i], SYNC_SEARCH_SYS);
@@ -326,9 +340,11 @@ void btr_search_sys_free()
 	for (ulint i = 0; i < btr_ahi_parts; ++i) {
 
 		rw_lock_free(btr_search_latches[i]);
-		ut_free(btr_search_latches[i]);
 	}
 
+	ut_free(btr_search_latch_mem);
+	btr_search_latch_mem = NULL;
+
 	ut_free(btr_search_latches);
 	btr_search_latches = NULL;
 }
@@ -1047,7 +1063,12 @@ btr_search_guess_on_hash(
 	fail if the page of the cursor gets removed from the buffer pool
 	meanwhile! Thus it might not be a bug. */
 #endif
-	info->last_hash_succ = TRUE;
+	/* Avoid dirtying the cache line of info on every successful
+	lookup. Concurrent lookups in the same index would otherwise
+	keep invalidating it in each other's caches. */
+	if (!info->last_hash_succ) {
+		info->last_hash_succ = TRUE;
+	}
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	btr_search_n_succ++;
@@ -1178,6 +1199,10 @@ void btr_search_drop_page_hash_index(buf_block_t* block)
 
 	ut_a(n_fields > 0 || n_bytes > 0);
 
+	const uintmax_t	start_time
+		= MONITOR_IS_ON(MONITOR_ADAPTIVE_HASH_DROP_MICROSECOND)
+		? ut_time_us(NULL) : 0;
+
 	page = block->frame;
 	n_recs = page_get_n_recs(page);
 
@@ -1263,6 +1288,11 @@ void btr_search_drop_page_hash_index(buf_block_t* block)
 	MONITOR_INC(MONITOR_ADAPTIVE_HASH_PAGE_REMOVED);
 	MONITOR_INC_VALUE(MONITOR_ADAPTIVE_HASH_ROW_REMOVED, n_cached);
 
+	if (start_time) {
+		MONITOR_INC_VALUE(MONITOR_ADAPTIVE_HASH_DROP_MICROSECOND,
+				  ut_time_us(NULL) - start_time);
+	}
+
 cleanup:
 	assert_block_ahi_valid(block);
 	rw_lock_x_unlock(latch);
@@ -1403,6 +1433,10 @@ btr_search_build_page_hash_index(
 		if (!--n_recs) return;
 	}
 
+	const uintmax_t	start_time
+		= MONITOR_IS_ON(MONITOR_ADAPTIVE_HASH_BUILD_MICROSECOND)
+		? ut_time_us(NULL) : 0;
+
 	/* Calculate and cache fold values and corresponding records into
 	an array for fast insertion to the hash index */
 
@@ -1509,6 +1543,11 @@ btr_search_build_page_hash_index(
 
 	MONITOR_INC(MONITOR_ADAPTIVE_HASH_PAGE_ADDED);
 	MONITOR_INC_VALUE(MONITOR_ADAPTIVE_HASH_ROW_ADDED, n_cached);
+
+	if (start_time) {
+		MONITOR_INC_VALUE(MONITOR_ADAPTIVE_HASH_BUILD_MICROSECOND,
+				  ut_time_us(NULL) - start_time);
+	}
 exit_func:
 	assert_block_ahi_valid(block);
 	rw_lock_x_unlock(ahi_latch);
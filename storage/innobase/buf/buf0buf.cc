@@ -122,6 +122,62 @@ struct set_numa_interleave_t
 };
 
 #define NUMA_MEMPOLICY_INTERLEAVE_IN_SCOPE set_numa_interleave_t scoped_numa
+
+/** Determine the NUMA node that a buffer pool instance or a page cleaner
+thread is bound to when innodb_numa_bind is in effect.
+Instance (or thread) n is assigned to the (n % N)th of the N nodes
+that we are allowed to allocate memory from.
+@param[in]	n	buffer pool instance or page cleaner thread number
+@return NUMA node number
+@retval -1 if innodb_numa_bind is not in effect */
+int buf_numa_node(ulint n)
+{
+	if (!srv_numa_bind) {
+		return -1;
+	}
+
+	struct bitmask*	numa_mems_allowed = numa_get_mems_allowed();
+	int		node = -1;
+
+	n %= numa_bitmask_weight(numa_mems_allowed);
+
+	for (unsigned i = 0; i < numa_mems_allowed->size; i++) {
+		if (numa_bitmask_isbitset(numa_mems_allowed, i) && !n--) {
+			node = int(i);
+			break;
+		}
+	}
+
+	numa_bitmask_free(numa_mems_allowed);
+	return node;
+}
+
+/** Bind the memory of a buffer pool chunk to the NUMA node
+of the buffer pool instance, before any page frame is touched.
+@param[in]	mem		start of the chunk
+@param[in]	size		size of the chunk in bytes
+@param[in]	instance_no	buffer pool instance number */
+static void buf_chunk_numa_bind(void* mem, ulint size, ulint instance_no)
+{
+	int	node = buf_numa_node(instance_no);
+
+	if (node < 0) {
+		return;
+	}
+
+	struct bitmask*	nodes = numa_allocate_nodemask();
+	numa_bitmask_setbit(nodes, unsigned(node));
+
+	if (mbind(mem, size, MPOL_PREFERRED, nodes->maskp, nodes->size,
+		  MPOL_MF_MOVE) != 0) {
+		ib::warn() << "Failed to set NUMA memory policy of"
+			" buffer pool instance " << instance_no
+			<< " to MPOL_PREFERRED node " << node
+			<< " (error: " << strerror(errno) << ").";
+	}
+
+	numa_bitmask_free(nodes);
+}
 #else
 #define NUMA_MEMPOLICY_INTERLEAVE_IN_SCOPE
 #endif /* HAVE_LIBNUMA */
@@ -347,8 +403,6 @@ static const int WAIT_FOR_READ	= 100;
 static const int WAIT_FOR_WRITE = 100;
 /** Number of attempts made to read in a page in the buffer pool */
 static const ulint	BUF_PAGE_READ_MAX_RETRIES = 100;
-/** Number of pages to read ahead */
-static const ulint	BUF_READ_AHEAD_PAGES = 64;
 /** The maximum portion of the buffer pool that can be used for the
 read-ahead buffer.  (Divide buf_pool size by this amount) */
 static const ulint	BUF_READ_AHEAD_PORTION = 32;
@@ -1697,6 +1751,9 @@ buf_chunk_init(
 				" buffer pool page frames to MPOL_INTERLEAVE"
 				" (error: " << strerror(errno) << ").";
 		}
+	} else {
+		buf_chunk_numa_bind(chunk->mem, chunk->mem_size(),
+				    buf_pool->instance_no);
 	}
 #endif /* HAVE_LIBNUMA */
 
@@ -1929,6 +1986,7 @@ buf_pool_init_instance(
 	buf_pool_mutex_enter(buf_pool);
 
 	if (buf_pool_size > 0) {
+		buf_pool->instance_no = instance_no;
 		buf_pool->n_chunks
 			= buf_pool_size / srv_buf_pool_chunk_unit;
 		chunk_size = srv_buf_pool_chunk_unit;
@@ -1983,7 +2041,6 @@ buf_pool_init_instance(
 			buf_pool->curr_size += chunk->size;
 		} while (++chunk < buf_pool->chunks + buf_pool->n_chunks);
 
-		buf_pool->instance_no = instance_no;
 		buf_pool->read_ahead_area =
 			ut_min(BUF_READ_AHEAD_PAGES,
 			       ut_2_power_up(buf_pool->curr_size /
@@ -2173,6 +2230,22 @@ buf_pool_init(
 
 	NUMA_MEMPOLICY_INTERLEAVE_IN_SCOPE;
 
+#ifdef HAVE_LIBNUMA
+	if (!srv_numa_bind) {
+	} else if (srv_numa_interleave) {
+		ib::info() << "Ignoring innodb_numa_bind because"
+			" innodb_numa_interleave is set";
+		srv_numa_bind = FALSE;
+	} else if (numa_available() < 0) {
+		ib::warn() << "Ignoring innodb_numa_bind because"
+			" NUMA is not available";
+		srv_numa_bind = FALSE;
+	} else {
+		ib::info() << "Binding buffer pool instances and"
+			" page cleaner threads to NUMA nodes";
+	}
+#endif /* HAVE_LIBNUMA */
+
 	buf_pool_resizing = false;
 	buf_pool_withdrawing = false;
 	buf_withdraw_clock = 0;
@@ -3764,6 +3837,23 @@ buf_page_make_young(
 	buf_pool_mutex_exit(buf_pool);
 }
 
+/** Move a page to the end of the buffer pool LRU list, so that it will
+be evicted first. This can be used for pages that were read only once,
+so that they do not replace more useful pages in the buffer pool.
+@param[in,out]	bpage	buffer block of a file page */
+void buf_page_make_old(buf_page_t* bpage)
+{
+	buf_pool_t*	buf_pool = buf_pool_from_bpage(bpage);
+
+	buf_pool_mutex_enter(buf_pool);
+
+	ut_a(buf_page_in_file(bpage));
+
+	buf_LRU_make_block_old(bpage);
+
+	buf_pool_mutex_exit(buf_pool);
+}
+
 /********************************************************************//**
 Moves a page to the start of the buffer pool LRU list if it is too old.
 This high-level function can be used to prevent an important page from
@@ -7509,6 +7599,7 @@ buf_page_encrypt_before_write(
 		ulint out_len = fil_page_compress(
 			src_frame, tmp,
 			fsp_flags_get_page_compression_level(space->flags),
+			space->page_compression_algorithm,
 			fil_space_get_block_size(space, bpage->id.page_no()),
 			encrypted);
 		if (!out_len) {
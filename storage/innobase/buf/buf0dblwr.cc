@@ -133,11 +133,30 @@ buf_dblwr_init(
 
 	mutex_create(LATCH_ID_BUF_DBLWR, &buf_dblwr->mutex);
 
-	buf_dblwr->b_event = os_event_create("dblwr_batch_event");
 	buf_dblwr->s_event = os_event_create("dblwr_single_event");
-	buf_dblwr->first_free = 0;
 	buf_dblwr->s_reserved = 0;
-	buf_dblwr->b_reserved = 0;
+
+	/* Partition the batch flush slots between the buffer pool
+	instances, so that the page cleaners do not have to wait for
+	each other's doublewrite batches to complete. */
+	buf_dblwr->n_batches = std::max<ulint>(
+		1, std::min<ulint>(srv_buf_pool_instances,
+				   srv_doublewrite_batch_size));
+	buf_dblwr->batches = static_cast<buf_dblwr_batch_t*>(
+		ut_zalloc_nokey(buf_dblwr->n_batches
+				* sizeof *buf_dblwr->batches));
+
+	for (ulint i = 0, first = 0; i < buf_dblwr->n_batches; i++) {
+		buf_dblwr_batch_t*	batch = &buf_dblwr->batches[i];
+
+		mutex_create(LATCH_ID_BUF_DBLWR, &batch->mutex);
+		batch->b_event = os_event_create("dblwr_batch_event");
+		batch->first = first;
+		batch->size = (i + 1 < buf_dblwr->n_batches)
+			? srv_doublewrite_batch_size / buf_dblwr->n_batches
+			: srv_doublewrite_batch_size - first;
+		first += batch->size;
+	}
 
 	buf_dblwr->block1 = mach_read_from_4(
 		doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK1);
@@ -687,9 +706,17 @@ buf_dblwr_free()
 	/* Free the double write data structures. */
 	ut_a(buf_dblwr != NULL);
 	ut_ad(buf_dblwr->s_reserved == 0);
-	ut_ad(buf_dblwr->b_reserved == 0);
 
-	os_event_destroy(buf_dblwr->b_event);
+	for (ulint i = 0; i < buf_dblwr->n_batches; i++) {
+		buf_dblwr_batch_t*	batch = &buf_dblwr->batches[i];
+		ut_ad(batch->b_reserved == 0);
+		os_event_destroy(batch->b_event);
+		mutex_free(&batch->mutex);
+	}
+
+	ut_free(buf_dblwr->batches);
+	buf_dblwr->batches = NULL;
+
 	os_event_destroy(buf_dblwr->s_event);
 	ut_free(buf_dblwr->write_buf_unaligned);
 	buf_dblwr->write_buf_unaligned = NULL;
@@ -721,28 +748,34 @@ buf_dblwr_update(
 	switch (flush_type) {
 	case BUF_FLUSH_LIST:
 	case BUF_FLUSH_LRU:
-		mutex_enter(&buf_dblwr->mutex);
+		{
+			buf_dblwr_batch_t*	batch = buf_dblwr->batch(
+				buf_pool_from_bpage(bpage)->instance_no);
 
-		ut_ad(buf_dblwr->batch_running);
-		ut_ad(buf_dblwr->b_reserved > 0);
-		ut_ad(buf_dblwr->b_reserved <= buf_dblwr->first_free);
+			mutex_enter(&batch->mutex);
 
-		buf_dblwr->b_reserved--;
+			ut_ad(batch->batch_running);
+			ut_ad(batch->b_reserved > 0);
+			ut_ad(batch->b_reserved <= batch->first_free);
 
-		if (buf_dblwr->b_reserved == 0) {
-			mutex_exit(&buf_dblwr->mutex);
-			/* This will finish the batch. Sync data files
-			to the disk. */
-			fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
-			mutex_enter(&buf_dblwr->mutex);
+			batch->b_reserved--;
 
-			/* We can now reuse the doublewrite memory buffer: */
-			buf_dblwr->first_free = 0;
-			buf_dblwr->batch_running = false;
-			os_event_set(buf_dblwr->b_event);
-		}
+			if (batch->b_reserved == 0) {
+				mutex_exit(&batch->mutex);
+				/* This will finish the batch. Sync data
+				files to the disk. */
+				fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
+				mutex_enter(&batch->mutex);
 
-		mutex_exit(&buf_dblwr->mutex);
+				/* We can now reuse this partition of
+				the doublewrite memory buffer: */
+				batch->first_free = 0;
+				batch->batch_running = false;
+				os_event_set(batch->b_event);
+			}
+
+			mutex_exit(&batch->mutex);
+		}
 		break;
 	case BUF_FLUSH_SINGLE_PAGE:
 		{
@@ -927,39 +960,59 @@ buf_dblwr_write_block_to_datafile(
 	}
 }
 
-/********************************************************************//**
-Flushes possible buffered writes from the doublewrite memory buffer to disk,
-and also wakes up the aio thread if simulated aio is used. It is very
-important to call this function after a batch of writes has been posted,
-and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
+/** Write a range of slots of the doublewrite memory buffer to the
+doublewrite buffer in the system tablespace.
+@param[in]	first	first slot to write
+@param[in]	n	number of slots to write */
+static
 void
-buf_dblwr_flush_buffered_writes()
+buf_dblwr_write_slots(ulint first, ulint n)
 {
-	byte*		write_buf;
-	ulint		first_free;
-	ulint		len;
+	while (n) {
+		ulint	page_no;
+		ulint	len;
+
+		if (first < TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
+			page_no = buf_dblwr->block1 + first;
+			len = std::min<ulint>(
+				n, TRX_SYS_DOUBLEWRITE_BLOCK_SIZE - first);
+		} else {
+			page_no = buf_dblwr->block2 + first
+				- TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
+			len = n;
+		}
 
-	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
-		/* Sync the writes to the disk. */
-		buf_dblwr_sync_datafiles();
-		/* Now we flush the data to disk (for example, with fsync) */
-		fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
-		return;
+		fil_io(IORequestWrite, true,
+		       page_id_t(TRX_SYS_SPACE, page_no), univ_page_size,
+		       0, len << srv_page_size_shift,
+		       buf_dblwr->write_buf + (first << srv_page_size_shift),
+		       NULL);
+
+		first += len;
+		n -= len;
 	}
+}
 
-	ut_ad(!srv_read_only_mode);
+/** Flush the buffered writes of one batch flush partition of the
+doublewrite buffer. If the partition is being written by another thread,
+wait for that batch to finish.
+@param[in,out]	batch	doublewrite buffer partition */
+static
+void
+buf_dblwr_flush_batch(buf_dblwr_batch_t* batch)
+{
+	ulint		first_free;
 
 try_again:
-	mutex_enter(&buf_dblwr->mutex);
+	mutex_enter(&batch->mutex);
 
 	/* Write first to doublewrite buffer blocks. We use synchronous
 	aio and thus know that file write has been completed when the
 	control returns. */
 
-	if (buf_dblwr->first_free == 0) {
+	if (batch->first_free == 0) {
 
-		mutex_exit(&buf_dblwr->mutex);
+		mutex_exit(&batch->mutex);
 
 		/* Wake possible simulated aio thread as there could be
 		system temporary tablespace pages active for flushing.
@@ -970,38 +1023,41 @@ buf_dblwr_flush_buffered_writes()
 		return;
 	}
 
-	if (buf_dblwr->batch_running) {
+	if (batch->batch_running) {
 		/* Another thread is running the batch right now. Wait
 		for it to finish. */
-		int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		int64_t	sig_count = os_event_reset(batch->b_event);
+		mutex_exit(&batch->mutex);
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
+		os_event_wait_low(batch->b_event, sig_count);
 		goto try_again;
 	}
 
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
+	ut_ad(batch->first_free == batch->b_reserved);
 
-	/* Disallow anyone else to post to doublewrite buffer or to
-	start another batch of flushing. */
-	buf_dblwr->batch_running = true;
-	first_free = buf_dblwr->first_free;
+	/* Disallow anyone else to post to this partition of the
+	doublewrite buffer or to start another batch of flushing
+	from it. */
+	batch->batch_running = true;
+	first_free = batch->first_free;
 
 	/* Now safe to release the mutex. Note that though no other
-	thread is allowed to post to the doublewrite batch flushing
-	but any threads working on single page flushes are allowed
-	to proceed. */
-	mutex_exit(&buf_dblwr->mutex);
+	thread is allowed to post to this doublewrite batch, the
+	other partitions and any threads working on single page
+	flushes are allowed to proceed. */
+	mutex_exit(&batch->mutex);
 
-	write_buf = buf_dblwr->write_buf;
+	buf_page_t**	block_arr = buf_dblwr->buf_block_arr + batch->first;
+	byte*		write_buf = buf_dblwr->write_buf
+		+ (batch->first << srv_page_size_shift);
 
 	for (ulint len2 = 0, i = 0;
-	     i < buf_dblwr->first_free;
+	     i < first_free;
 	     len2 += srv_page_size, i++) {
 
 		const buf_block_t*	block;
 
-		block = (buf_block_t*) buf_dblwr->buf_block_arr[i];
+		block = (buf_block_t*) block_arr[i];
 
 		if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
 		    || block->page.zip.data) {
@@ -1019,33 +1075,12 @@ buf_dblwr_flush_buffered_writes()
 		buf_dblwr_check_page_lsn(write_buf + len2);
 	}
 
-	/* Write out the first block of the doublewrite buffer */
-	len = std::min<ulint>(TRX_SYS_DOUBLEWRITE_BLOCK_SIZE,
-			      buf_dblwr->first_free) << srv_page_size_shift;
-
-	fil_io(IORequestWrite, true,
-	       page_id_t(TRX_SYS_SPACE, buf_dblwr->block1), univ_page_size,
-	       0, len, (void*) write_buf, NULL);
-
-	if (buf_dblwr->first_free <= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
-		/* No unwritten pages in the second block. */
-		goto flush;
-	}
-
-	/* Write out the second block of the doublewrite buffer. */
-	len = (buf_dblwr->first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
-	       << srv_page_size_shift;
-
-	write_buf = buf_dblwr->write_buf
-		+ (TRX_SYS_DOUBLEWRITE_BLOCK_SIZE << srv_page_size_shift);
-
-	fil_io(IORequestWrite, true,
-	       page_id_t(TRX_SYS_SPACE, buf_dblwr->block2), univ_page_size,
-	       0, len, (void*) write_buf, NULL);
+	/* Write out the slots of this partition, which may span
+	both blocks of the doublewrite buffer. */
+	buf_dblwr_write_slots(batch->first, first_free);
 
-flush:
 	/* increment the doublewrite flushed pages counter */
-	srv_stats.dblwr_pages_written.add(buf_dblwr->first_free);
+	srv_stats.dblwr_pages_written.add(first_free);
 	srv_stats.dblwr_writes.inc();
 
 	/* Now flush the doublewrite buffer data to disk */
@@ -1055,21 +1090,20 @@ buf_dblwr_flush_buffered_writes()
 	and in recovery we will find them in the doublewrite buffer
 	blocks. Next do the writes to the intended positions. */
 
-	/* Up to this point first_free and buf_dblwr->first_free are
-	same because we have set the buf_dblwr->batch_running flag
+	/* Up to this point first_free and batch->first_free are
+	same because we have set the batch->batch_running flag
 	disallowing any other thread to post any request but we
-	can't safely access buf_dblwr->first_free in the loop below.
+	can't safely access batch->first_free in the loop below.
 	This is so because it is possible that after we are done with
 	the last iteration and before we terminate the loop, the batch
 	gets finished in the IO helper thread and another thread posts
-	a new batch setting buf_dblwr->first_free to a higher value.
-	If this happens and we are using buf_dblwr->first_free in the
+	a new batch setting batch->first_free to a higher value.
+	If this happens and we are using batch->first_free in the
 	loop termination condition then we'll end up dispatching
 	the same block twice from two different threads. */
-	ut_ad(first_free == buf_dblwr->first_free);
+	ut_ad(first_free == batch->first_free);
 	for (ulint i = 0; i < first_free; i++) {
-		buf_dblwr_write_block_to_datafile(
-			buf_dblwr->buf_block_arr[i], false);
+		buf_dblwr_write_block_to_datafile(block_arr[i], false);
 	}
 
 	/* Wake possible simulated aio thread to actually post the
@@ -1079,6 +1113,37 @@ buf_dblwr_flush_buffered_writes()
 	os_aio_simulated_wake_handler_threads();
 }
 
+/********************************************************************//**
+Flushes possible buffered writes from the doublewrite memory buffer to disk,
+and also wakes up the aio thread if simulated aio is used. It is very
+important to call this function after a batch of writes has been posted,
+and also when we may have to wait for a page latch! Otherwise a deadlock
+of threads can occur.
+@param[in]	instance_no	buffer pool instance whose doublewrite
+batch partition to flush, or ULINT_UNDEFINED to flush all partitions */
+void
+buf_dblwr_flush_buffered_writes(ulint instance_no)
+{
+	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
+		/* Sync the writes to the disk. */
+		buf_dblwr_sync_datafiles();
+		/* Now we flush the data to disk (for example, with fsync) */
+		fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
+		return;
+	}
+
+	ut_ad(!srv_read_only_mode);
+
+	if (instance_no != ULINT_UNDEFINED) {
+		buf_dblwr_flush_batch(buf_dblwr->batch(instance_no));
+		return;
+	}
+
+	for (ulint i = 0; i < buf_dblwr->n_batches; i++) {
+		buf_dblwr_flush_batch(&buf_dblwr->batches[i]);
+	}
+}
+
 /********************************************************************//**
 Posts a buffer page for writing. If the doublewrite memory buffer is
 full, calls buf_dblwr_flush_buffered_writes and waits for for free
@@ -1090,36 +1155,39 @@ buf_dblwr_add_to_batch(
 {
 	ut_a(buf_page_in_file(bpage));
 
+	const ulint		instance_no
+		= buf_pool_from_bpage(bpage)->instance_no;
+	buf_dblwr_batch_t*	batch = buf_dblwr->batch(instance_no);
+
 try_again:
-	mutex_enter(&buf_dblwr->mutex);
+	mutex_enter(&batch->mutex);
 
-	ut_a(buf_dblwr->first_free <= srv_doublewrite_batch_size);
+	ut_a(batch->first_free <= batch->size);
 
-	if (buf_dblwr->batch_running) {
+	if (batch->batch_running) {
 
-		/* This not nearly as bad as it looks. There is only
-		page_cleaner thread which does background flushing
-		in batches therefore it is unlikely to be a contention
-		point. The only exception is when a user thread is
-		forced to do a flush batch because of a sync
-		checkpoint. */
-		int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		/* This not nearly as bad as it looks. Each buffer pool
+		instance is normally flushed by one page_cleaner thread,
+		and it is the only thread posting to this partition.
+		The only exception is when a user thread is forced to
+		do a flush batch because of a sync checkpoint. */
+		int64_t	sig_count = os_event_reset(batch->b_event);
+		mutex_exit(&batch->mutex);
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
+		os_event_wait_low(batch->b_event, sig_count);
 		goto try_again;
 	}
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (batch->first_free == batch->size) {
+		mutex_exit(&batch->mutex);
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(instance_no);
 
 		goto try_again;
 	}
 
-	byte*	p = buf_dblwr->write_buf
-		+ srv_page_size * buf_dblwr->first_free;
+	const ulint	slot = batch->first + batch->first_free;
+	byte*	p = buf_dblwr->write_buf + srv_page_size * slot;
 
 	/* We request frame here to get correct buffer in case of
 	encryption and/or page compression */
@@ -1142,24 +1210,24 @@ buf_dblwr_add_to_batch(
 		memcpy(p, frame, bpage->size.logical());
 	}
 
-	buf_dblwr->buf_block_arr[buf_dblwr->first_free] = bpage;
+	buf_dblwr->buf_block_arr[slot] = bpage;
 
-	buf_dblwr->first_free++;
-	buf_dblwr->b_reserved++;
+	batch->first_free++;
+	batch->b_reserved++;
 
-	ut_ad(!buf_dblwr->batch_running);
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
-	ut_ad(buf_dblwr->b_reserved <= srv_doublewrite_batch_size);
+	ut_ad(!batch->batch_running);
+	ut_ad(batch->first_free == batch->b_reserved);
+	ut_ad(batch->b_reserved <= batch->size);
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (batch->first_free == batch->size) {
+		mutex_exit(&batch->mutex);
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(instance_no);
 
 		return;
 	}
 
-	mutex_exit(&(buf_dblwr->mutex));
+	mutex_exit(&batch->mutex);
 }
 
 /********************************************************************//**
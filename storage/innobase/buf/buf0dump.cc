@@ -43,6 +43,7 @@ Created April 08, 2011 Vasil Dimov
 #include "ut0byte.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "mysql/service_wsrep.h" /* wsrep_recovery */
 #include <my_service_manager.h>
@@ -72,6 +73,14 @@ typedef ib_uint64_t	buf_dump_t;
 #define BUF_DUMP_SPACE(a)		((ulint) ((a) >> 32))
 #define BUF_DUMP_PAGE(a)		((ulint) ((a) & 0xFFFFFFFFUL))
 
+/** Number of pages of each buffer pool instance that buf_load() reads
+in one wave. buf_dump() writes the pages of each instance from the most
+to the least recently used; buf_load() reads the first wave of every
+instance before the second one, and sorts each wave by (space, page), so
+that the hottest pages arrive first while the reads within a wave still
+go to the data files in ascending order. */
+static const ulint	BUF_LOAD_WAVE_PAGES = 16384;
+
 /*****************************************************************//**
 Wakes up the buffer pool dump/load thread and instructs it to start
 a dump. This function is called by MySQL code via buffer_pool_dump_now()
@@ -552,13 +561,37 @@ buf_load()
 	}
 	/* else */
 
-	/* First scan the file to estimate how many entries are in it.
+	/* If dump is larger than the buffer pool(s), then we ignore the
+	extra trailing. This could happen if a dump is made, then buffer
+	pool is shrunk and then load is attempted. */
+	total_buffer_pools_pages = buf_pool_get_n_pages()
+		* srv_buf_pool_instances;
+
+	/* Recency rank of the next entry of each buffer pool instance */
+	std::vector<ulint>	n_instance(srv_buf_pool_instances);
+	/* Number of entries in each wave, later the start of each wave
+	in dump[] */
+	std::vector<ulint>	wave_start;
+
+	/* First scan the file to estimate how many entries are in it,
+	and how many of them fall into each wave.
 	This file is tiny (approx 500KB per 1GB buffer pool), reading it
 	two times is fine. */
 	dump_n = 0;
 	while (fscanf(f, ULINTPF "," ULINTPF, &space_id, &page_no) == 2
 	       && !SHUTTING_DOWN()) {
-		dump_n++;
+		if (dump_n++ < total_buffer_pools_pages
+		    && space_id <= ULINT32_MASK && page_no <= ULINT32_MASK) {
+			const ulint	wave = n_instance[buf_pool_index(
+				buf_pool_get(page_id_t(space_id, page_no)))]++
+				/ BUF_LOAD_WAVE_PAGES;
+
+			if (wave >= wave_start.size()) {
+				wave_start.resize(wave + 1);
+			}
+
+			wave_start[wave]++;
+		}
 	}
 
 	if (!SHUTTING_DOWN() && !feof(f)) {
@@ -576,11 +609,6 @@ buf_load()
 		return;
 	}
 
-	/* If dump is larger than the buffer pool(s), then we ignore the
-	extra trailing. This could happen if a dump is made, then buffer
-	pool is shrunk and then load is attempted. */
-	total_buffer_pools_pages = buf_pool_get_n_pages()
-		* srv_buf_pool_instances;
 	if (dump_n > total_buffer_pools_pages) {
 		dump_n = total_buffer_pools_pages;
 	}
@@ -608,6 +636,19 @@ buf_load()
 
 	rewind(f);
 
+	/* Turn the wave sizes into start offsets. wave_fill[] is the
+	next free slot of each wave. */
+	std::vector<ulint>	wave_fill(wave_start.size());
+	ulint			n_counted = 0;
+
+	for (ulint w = 0; w < wave_start.size(); w++) {
+		wave_fill[w] = n_counted;
+		n_counted += wave_start[w];
+		wave_start[w] = wave_fill[w];
+	}
+
+	std::fill(n_instance.begin(), n_instance.end(), 0);
+
 	export_vars.innodb_buffer_pool_load_incomplete = 1;
 
 	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
@@ -643,16 +684,36 @@ buf_load()
 			return;
 		}
 
-		dump[i] = BUF_DUMP_CREATE(space_id, page_no);
-	}
+		const ulint	wave = n_instance[buf_pool_index(
+			buf_pool_get(page_id_t(space_id, page_no)))]++
+			/ BUF_LOAD_WAVE_PAGES;
+
+		if (wave >= wave_fill.size()
+		    || wave_fill[wave] == (wave + 1 < wave_start.size()
+					   ? wave_start[wave + 1]
+					   : n_counted)) {
+			/* The file was modified after the first scan. */
+			continue;
+		}
 
-	/* Set dump_n to the actual number of initialized elements,
-	i could be smaller than dump_n here if the file got truncated after
-	we read it the first time. */
-	dump_n = i;
+		dump[wave_fill[wave]++] = BUF_DUMP_CREATE(space_id, page_no);
+	}
 
 	fclose(f);
 
+	/* Close the gaps that are left if the file got truncated after
+	we read it the first time, and sort each wave, so that the pages
+	within a wave are read in (space, page) order. */
+	dump_n = 0;
+
+	for (ulint w = 0; w < wave_start.size() && !SHUTTING_DOWN(); w++) {
+		buf_dump_t*	first = dump + dump_n;
+
+		dump_n += wave_fill[w] - wave_start[w];
+		std::copy(dump + wave_start[w], dump + wave_fill[w], first);
+		std::sort(first, dump + dump_n);
+	}
+
 	if (dump_n == 0) {
 		ut_free(dump);
 		ut_sprintf_timestamp(now);
@@ -662,16 +723,13 @@ buf_load()
 		return;
 	}
 
-	if (!SHUTTING_DOWN()) {
-		std::sort(dump, dump + dump_n);
-	}
-
 	ulint		last_check_time = 0;
 	ulint		last_activity_cnt = 0;
 
 	/* Avoid calling the expensive fil_space_acquire_silent() for each
-	page within the same tablespace. dump[] is sorted by (space, page),
-	so all pages from a given tablespace are consecutive. */
+	page within the same tablespace. Each wave of dump[] is sorted by
+	(space, page), so the pages from a given tablespace are
+	consecutive within a wave. */
 	ulint		cur_space_id = BUF_DUMP_SPACE(dump[0]);
 	fil_space_t*	space = fil_space_acquire_silent(cur_space_id);
 	page_size_t	page_size(space ? space->flags : 0);
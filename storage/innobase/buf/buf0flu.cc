@@ -42,6 +42,7 @@ Created 11/11/1995 Heikki Tuuri
 #include "buf0rea.h"
 #include "ibuf0ibuf.h"
 #include "log0log.h"
+#include "log0online.h"
 #include "os0file.h"
 #include "trx0sys.h"
 #include "srv0mon.h"
@@ -62,6 +63,10 @@ static const ulint buf_flush_wait_flushed_sleep_time = 10000;
 
 #include <my_service_manager.h>
 
+#ifdef HAVE_LIBNUMA
+#include <numa.h>
+#endif /* HAVE_LIBNUMA */
+
 /** Number of pages flushed through non flush_list flushes. */
 static ulint buf_lru_flush_page_count = 0;
 
@@ -139,6 +144,12 @@ struct page_cleaner_slot_t {
 	ulint			flush_list_pass;
 					/*!< count to attempt flush_list
 					flushing */
+#ifdef HAVE_LIBNUMA
+	int			numa_node;
+					/*!< NUMA node of the buffer pool
+					instance, or -1 if innodb_numa_bind
+					is not in effect */
+#endif /* HAVE_LIBNUMA */
 };
 
 /** Page cleaner structure common for all threads */
@@ -1055,6 +1066,11 @@ buf_flush_write_block_low(
 		log_write_up_to(bpage->newest_modification, true);
 	}
 
+	if (srv_track_changed_pages
+	    && space->purpose == FIL_TYPE_TABLESPACE) {
+		log_online_track_page(bpage->id, bpage->newest_modification);
+	}
+
 	switch (buf_page_get_state(bpage)) {
 	case BUF_BLOCK_POOL_WATCH:
 	case BUF_BLOCK_ZIP_PAGE: /* The page should be dirty. */
@@ -1969,7 +1985,7 @@ buf_flush_end(
 	buf_pool_mutex_exit(buf_pool);
 
 	if (!srv_read_only_mode) {
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(buf_pool->instance_no);
 	} else {
 		os_aio_simulated_wake_handler_threads();
 	}
@@ -2598,10 +2614,12 @@ page_cleaner_flush_pages_recommendation(
 		sum_pages_for_lsn += pages_for_lsn;
 
 		mutex_enter(&page_cleaner.mutex);
-		ut_ad(page_cleaner.slots[i].state
-		      == PAGE_CLEANER_STATE_NONE);
-		page_cleaner.slots[i].n_pages_requested
-			= pages_for_lsn / buf_flush_lsn_scan_factor + 1;
+		if (page_cleaner.slots[i].state
+		    == PAGE_CLEANER_STATE_NONE) {
+			page_cleaner.slots[i].n_pages_requested
+				= pages_for_lsn / buf_flush_lsn_scan_factor
+				+ 1;
+		}
 		mutex_exit(&page_cleaner.mutex);
 	}
 
@@ -2624,10 +2642,13 @@ page_cleaner_flush_pages_recommendation(
 	/* Normalize request for each instance */
 	mutex_enter(&page_cleaner.mutex);
 	ut_ad(page_cleaner.n_slots_requested == 0);
-	ut_ad(page_cleaner.n_slots_flushing == 0);
-	ut_ad(page_cleaner.n_slots_finished == 0);
 
 	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		if (page_cleaner.slots[i].state != PAGE_CLEANER_STATE_NONE) {
+			/* still busy with an earlier request */
+			continue;
+		}
+
 		/* if REDO has enough of free space,
 		don't care about age distribution of pages */
 		page_cleaner.slots[i].n_pages_requested = pct_for_lsn > 30 ?
@@ -2703,6 +2724,12 @@ buf_flush_page_cleaner_init(void)
 	page_cleaner.is_started = os_event_create("pc_is_started");
 	page_cleaner.n_slots = static_cast<ulint>(srv_buf_pool_instances);
 
+#ifdef HAVE_LIBNUMA
+	for (ulint i = 0; i < page_cleaner.n_slots; i++) {
+		page_cleaner.slots[i].numa_node = buf_numa_node(i);
+	}
+#endif /* HAVE_LIBNUMA */
+
 	ut_d(page_cleaner.n_disabled_debug = 0);
 
 	page_cleaner.is_running = true;
@@ -2710,6 +2737,8 @@ buf_flush_page_cleaner_init(void)
 
 /**
 Requests for all slots to flush all buffer pool instances.
+The instances that are still being flushed for an earlier request
+(see pc_wait_finished()) are skipped.
 @param min_n	wished minimum mumber of blocks flushed
 		(it is not guaranteed that the actual number is that big)
 @param lsn_limit in the case BUF_FLUSH_LIST all blocks whose
@@ -2734,8 +2763,9 @@ pc_request(
 	mutex_enter(&page_cleaner.mutex);
 
 	ut_ad(page_cleaner.n_slots_requested == 0);
-	ut_ad(page_cleaner.n_slots_flushing == 0);
-	ut_ad(page_cleaner.n_slots_finished == 0);
+	/* A request to flush everything must reach every instance. */
+	ut_ad(min_n != ULINT_MAX || page_cleaner.n_slots_flushing == 0);
+	ut_ad(min_n != ULINT_MAX || page_cleaner.n_slots_finished == 0);
 
 	page_cleaner.requested = (min_n > 0);
 	page_cleaner.lsn_limit = lsn_limit;
@@ -2743,7 +2773,9 @@ pc_request(
 	for (ulint i = 0; i < page_cleaner.n_slots; i++) {
 		page_cleaner_slot_t* slot = &page_cleaner.slots[i];
 
-		ut_ad(slot->state == PAGE_CLEANER_STATE_NONE);
+		if (slot->state != PAGE_CLEANER_STATE_NONE) {
+			continue;
+		}
 
 		if (min_n == ULINT_MAX) {
 			slot->n_pages_requested = ULINT_MAX;
@@ -2755,23 +2787,25 @@ pc_request(
 		page_cleaner_flush_pages_recommendation() */
 
 		slot->state = PAGE_CLEANER_STATE_REQUESTED;
+		page_cleaner.n_slots_requested++;
 	}
 
-	page_cleaner.n_slots_requested = page_cleaner.n_slots;
-	page_cleaner.n_slots_flushing = 0;
-	page_cleaner.n_slots_finished = 0;
-
-	os_event_set(page_cleaner.is_requested);
+	if (page_cleaner.n_slots_requested) {
+		os_event_reset(page_cleaner.is_finished);
+		os_event_set(page_cleaner.is_requested);
+	}
 
 	mutex_exit(&page_cleaner.mutex);
 }
 
 /**
 Do flush for one slot.
+@param[in]	numa_node	NUMA node whose buffer pool instances
+should be preferred, or -1 for no preference
 @return	the number of the slots which has not been treated yet. */
 static
 ulint
-pc_flush_slot(void)
+pc_flush_slot(int numa_node = -1)
 {
 	ulint	lru_tm = 0;
 	ulint	list_tm = 0;
@@ -2786,12 +2820,30 @@ pc_flush_slot(void)
 		page_cleaner_slot_t*	slot = NULL;
 		ulint			i;
 
+		ulint			n = page_cleaner.n_slots;
+
 		for (i = 0; i < page_cleaner.n_slots; i++) {
 			slot = &page_cleaner.slots[i];
 
-			if (slot->state == PAGE_CLEANER_STATE_REQUESTED) {
-				break;
+			if (slot->state != PAGE_CLEANER_STATE_REQUESTED) {
+				continue;
 			}
+#ifdef HAVE_LIBNUMA
+			/* Prefer the instances that are local to
+			this thread, remembering the first remote one. */
+			if (numa_node >= 0 && slot->numa_node != numa_node) {
+				if (n == page_cleaner.n_slots) {
+					n = i;
+				}
+				continue;
+			}
+#endif /* HAVE_LIBNUMA */
+			break;
+		}
+
+		if (i == page_cleaner.n_slots) {
+			i = n;
+			slot = &page_cleaner.slots[i];
 		}
 
 		/* slot should be found because
@@ -2876,33 +2928,57 @@ pc_flush_slot(void)
 
 /**
 Wait until all flush requests are finished.
-@param n_flushed_lru	number of pages flushed from the end of the LRU list.
-@param n_flushed_list	number of pages flushed from the end of the
-			flush_list.
+With a deadline, the instances that are still being flushed when it
+passes are left to finish on their own, so that one slow instance does
+not hold back the flushing of the others; they are accounted for by a
+later call, and pc_request() skips them until then.
+@param n_flushed_lru	incremented by the number of pages flushed from
+			the end of the LRU list.
+@param n_flushed_list	incremented by the number of pages flushed from
+			the end of the flush_list.
+@param deadline		ut_time_ms() until which to wait,
+			or ULINT_UNDEFINED to wait for all instances
 @return			true if all flush_list flushing batch were success. */
 static
 bool
 pc_wait_finished(
 	ulint*	n_flushed_lru,
-	ulint*	n_flushed_list)
+	ulint*	n_flushed_list,
+	ulint	deadline = ULINT_UNDEFINED)
 {
 	bool	all_succeeded = true;
 
-	*n_flushed_lru = 0;
-	*n_flushed_list = 0;
+	mutex_enter(&page_cleaner.mutex);
+	const bool busy = page_cleaner.n_slots_requested
+		|| page_cleaner.n_slots_flushing;
+	mutex_exit(&page_cleaner.mutex);
 
-	os_event_wait(page_cleaner.is_finished);
+	if (!busy) {
+	} else if (deadline == ULINT_UNDEFINED) {
+		os_event_wait(page_cleaner.is_finished);
+	} else {
+		ulint	now = ut_time_ms();
+
+		if (now < deadline) {
+			os_event_wait_time(page_cleaner.is_finished,
+					   (deadline - now) * 1000);
+		}
+	}
 
 	mutex_enter(&page_cleaner.mutex);
 
-	ut_ad(page_cleaner.n_slots_requested == 0);
-	ut_ad(page_cleaner.n_slots_flushing == 0);
-	ut_ad(page_cleaner.n_slots_finished == page_cleaner.n_slots);
+	ut_ad(deadline != ULINT_UNDEFINED
+	      || (page_cleaner.n_slots_requested == 0
+		  && page_cleaner.n_slots_flushing == 0));
 
 	for (ulint i = 0; i < page_cleaner.n_slots; i++) {
 		page_cleaner_slot_t* slot = &page_cleaner.slots[i];
 
-		ut_ad(slot->state == PAGE_CLEANER_STATE_FINISHED);
+		if (slot->state != PAGE_CLEANER_STATE_FINISHED) {
+			ut_ad(deadline != ULINT_UNDEFINED
+			      || slot->state == PAGE_CLEANER_STATE_NONE);
+			continue;
+		}
 
 		*n_flushed_lru += slot->n_flushed_lru;
 		*n_flushed_list += slot->n_flushed_list;
@@ -2915,7 +2991,10 @@ pc_wait_finished(
 
 	page_cleaner.n_slots_finished = 0;
 
-	os_event_reset(page_cleaner.is_finished);
+	if (!page_cleaner.n_slots_requested
+	    && !page_cleaner.n_slots_flushing) {
+		os_event_reset(page_cleaner.is_finished);
+	}
 
 	mutex_exit(&page_cleaner.mutex);
 
@@ -3198,6 +3277,14 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 			buf_flush_sync_lsn = 0;
 			mutex_exit(&page_cleaner.mutex);
 
+			ulint	n_flushed_lru = 0;
+			ulint	n_flushed_list = 0;
+
+			/* Wait for the instances that are still being
+			flushed for an earlier request, so that all of
+			them will be requested to flush up to lsn_limit. */
+			pc_wait_finished(&n_flushed_lru, &n_flushed_list);
+
 			/* Request flushing for threads */
 			pc_request(ULINT_MAX, lsn_limit);
 
@@ -3212,8 +3299,6 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 			page_cleaner.flush_pass++;
 
 			/* Wait for all slots to be finished */
-			ulint	n_flushed_lru = 0;
-			ulint	n_flushed_list = 0;
 			pc_wait_finished(&n_flushed_lru, &n_flushed_list);
 
 			if (n_flushed_list > 0 || n_flushed_lru > 0) {
@@ -3257,11 +3342,13 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 			page_cleaner.flush_time += ut_time_ms() - tm;
 			page_cleaner.flush_pass++ ;
 
-			/* Wait for all slots to be finished */
+			/* Wait for the slots to be finished, but not
+			beyond the start of the next iteration */
 			ulint	n_flushed_lru = 0;
 			ulint	n_flushed_list = 0;
 
-			pc_wait_finished(&n_flushed_lru, &n_flushed_list);
+			pc_wait_finished(&n_flushed_lru, &n_flushed_list,
+					 next_loop_time);
 
 			if (n_flushed_list > 0 || n_flushed_lru > 0) {
 				buf_flush_stats(n_flushed_list, n_flushed_lru);
@@ -3316,6 +3403,14 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 	}
 
 	ut_ad(srv_shutdown_state > 0);
+
+	{
+		/* Wait for the instances that are still being flushed
+		for an earlier request. */
+		ulint	n_flushed_lru = 0;
+		ulint	n_flushed_list = 0;
+		pc_wait_finished(&n_flushed_lru, &n_flushed_list);
+	}
 	if (srv_fast_shutdown == 2
 	    || srv_shutdown_state == SRV_SHUTDOWN_EXIT_THREADS) {
 		/* In very fast shutdown or when innodb failed to start, we
@@ -3472,6 +3567,12 @@ DECLARE_THREAD(buf_flush_page_cleaner_worker)(
 
 	mutex_enter(&page_cleaner.mutex);
 	ulint thread_no = page_cleaner.n_workers++;
+#ifdef HAVE_LIBNUMA
+	/* The coordinator is page cleaner thread 0. */
+	const int numa_node = buf_numa_node(thread_no + 1);
+#else
+	const int numa_node = -1;
+#endif /* HAVE_LIBNUMA */
 
 	DBUG_LOG("ib_buf", "Thread " << cleaner_thread_id
 		 << " started; n_workers=" << page_cleaner.n_workers);
@@ -3491,6 +3592,14 @@ DECLARE_THREAD(buf_flush_page_cleaner_worker)(
 	}
 #endif /* UNIV_LINUX */
 
+#ifdef HAVE_LIBNUMA
+	if (numa_node >= 0 && numa_run_on_node(numa_node) != 0) {
+		ib::warn() << "Failed to bind page_cleaner worker "
+			<< thread_no << " to NUMA node " << numa_node
+			<< ": " << strerror(errno);
+	}
+#endif /* HAVE_LIBNUMA */
+
 	while (true) {
 		os_event_wait(page_cleaner.is_requested);
 
@@ -3514,7 +3623,7 @@ DECLARE_THREAD(buf_flush_page_cleaner_worker)(
 			break;
 		}
 
-		pc_flush_slot();
+		pc_flush_slot(numa_node);
 	}
 
 	mutex_enter(&page_cleaner.mutex);
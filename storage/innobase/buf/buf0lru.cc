@@ -123,6 +123,11 @@ least this many milliseconds ago.  Not protected by any mutex or latch. */
 uint	buf_LRU_old_threshold_ms;
 /* @} */
 
+/** Keep decompressed pages of ROW_FORMAT=COMPRESSED tables while the
+unzip_LRU list is at most this percentage of the LRU list.
+Not protected by any mutex or latch. */
+uint	buf_LRU_unzip_pct;
+
 /******************************************************************//**
 Takes a block out of the LRU list and page hash table.
 If the block is compressed-only (BUF_BLOCK_ZIP_PAGE),
@@ -187,11 +192,11 @@ buf_LRU_evict_from_unzip_LRU(
 		return(FALSE);
 	}
 
-	/* If unzip_LRU is at most 10% of the size of the LRU list,
-	then use the LRU.  This slack allows us to keep hot
-	decompressed pages in the buffer pool. */
-	if (UT_LIST_GET_LEN(buf_pool->unzip_LRU)
-	    <= UT_LIST_GET_LEN(buf_pool->LRU) / 10) {
+	/* If unzip_LRU is at most buf_LRU_unzip_pct percent of the size
+	of the LRU list, then use the LRU.  This slack allows us to keep
+	hot decompressed pages in the buffer pool. */
+	if (UT_LIST_GET_LEN(buf_pool->unzip_LRU) * 100
+	    <= UT_LIST_GET_LEN(buf_pool->LRU) * buf_LRU_unzip_pct) {
 		return(FALSE);
 	}
 
@@ -1557,6 +1562,38 @@ buf_LRU_make_block_young(
 	buf_LRU_add_block_low(bpage, FALSE);
 }
 
+/** Move a block to the end of the LRU list.
+@param[in,out]	bpage	control block */
+void buf_LRU_make_block_old(buf_page_t* bpage)
+{
+	buf_pool_t*	buf_pool = buf_pool_from_bpage(bpage);
+
+	ut_ad(buf_pool_mutex_own(buf_pool));
+
+	if (UT_LIST_GET_LEN(buf_pool->LRU) <= BUF_LRU_OLD_MIN_LEN
+	    || bpage == UT_LIST_GET_LAST(buf_pool->LRU)) {
+		/* buf_pool->LRU_old must remain defined after
+		buf_LRU_remove_block() */
+		return;
+	}
+
+	buf_LRU_remove_block(bpage);
+
+	UT_LIST_ADD_LAST(buf_pool->LRU, bpage);
+	ut_d(bpage->in_LRU_list = TRUE);
+
+	incr_LRU_size_in_bytes(bpage, buf_pool);
+
+	ut_ad(buf_pool->LRU_old);
+	buf_pool->LRU_old_len++;
+	buf_page_set_old(bpage, TRUE);
+	buf_LRU_old_adjust_len(buf_pool);
+
+	if (buf_page_belongs_to_unzip_LRU(bpage)) {
+		buf_unzip_LRU_add_block((buf_block_t*) bpage, TRUE);
+	}
+}
+
 /******************************************************************//**
 Try to free a block.  If bpage is a descriptor of a compressed-only
 page, the descriptor object will be freed as well.
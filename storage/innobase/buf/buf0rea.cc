@@ -776,6 +776,87 @@ buf_read_ahead_linear(
 	return(count);
 }
 
+/** Applies logical read-ahead: issues asynchronous read requests for
+B-tree pages that a range scan is about to access, as found in the
+node pointers of their parent page. The caller checks whether
+innodb_logical_read_ahead or innodb_scan_no_cache is enabled.
+NOTE: the calling thread may own latches on pages: this function cannot
+end up waiting for these latches!
+@param[in]	space_id	tablespace id
+@param[in]	page_size	page size
+@param[in]	page_nos	array of page numbers to read
+@param[in]	n_stored	number of page numbers in the array
+@return number of page read requests issued */
+ulint
+buf_read_ahead_logical(
+	ulint			space_id,
+	const page_size_t&	page_size,
+	const ulint*		page_nos,
+	ulint			n_stored)
+{
+	ulint		count = 0;
+	dberr_t		err;
+
+	if (!n_stored) {
+		return(0);
+	}
+
+	if (srv_startup_is_before_trx_rollback_phase) {
+		/* No read-ahead to avoid thread deadlocks */
+		return(0);
+	}
+
+	buf_pool_t*	buf_pool = buf_pool_get(
+		page_id_t(space_id, page_nos[0]));
+
+	buf_pool_mutex_enter(buf_pool);
+
+	if (buf_pool->n_pend_reads
+	    > buf_pool->curr_size / BUF_READ_AHEAD_PEND_LIMIT) {
+		buf_pool_mutex_exit(buf_pool);
+
+		return(0);
+	}
+
+	buf_pool_mutex_exit(buf_pool);
+
+	for (ulint i = 0; i < n_stored; i++) {
+		const page_id_t	page_id(space_id, page_nos[i]);
+
+		if (ibuf_bitmap_page(page_id, page_size)) {
+			continue;
+		}
+
+		count += buf_read_page_low(
+			&err, false, IORequest::DO_NOT_WAKE,
+			BUF_READ_ANY_PAGE, page_id, page_size, false);
+
+		if (err == DB_TABLESPACE_DELETED) {
+			break;
+		}
+	}
+
+	/* In simulated aio we wake the aio handler threads only after
+	queuing all aio requests, in native aio the following call does
+	nothing: */
+
+	os_aio_simulated_wake_handler_threads();
+
+	if (count) {
+		DBUG_PRINT("ib_buf", ("logical read-ahead " ULINTPF
+				      " pages, " ULINTPF ":" ULINTPF,
+				      count, space_id, page_nos[0]));
+
+		/* Read ahead is considered one I/O operation for the
+		purpose of LRU policy decision. */
+		buf_LRU_stat_inc_io();
+
+		buf_pool->stat.n_ra_pages_read += count;
+	}
+
+	return(count);
+}
+
 /********************************************************************//**
 Issues read requests for pages which the ibuf module wants to read in, in
 order to contract the insert buffer tree. Technically, this function is like
@@ -510,6 +510,11 @@ dict_table_close(
 					index creation */
 {
 	if (!dict_locked) {
+		if (table->release_if_not_last()) {
+			MONITOR_DEC(MONITOR_TABLE_REFERENCE);
+			return;
+		}
+
 		mutex_enter(&dict_sys->mutex);
 	}
 
@@ -1121,6 +1126,8 @@ dict_init(void)
 
 	rw_lock_create(dict_operation_lock_key,
 		       dict_operation_lock, SYNC_DICT_OPERATION);
+	rw_lock_create(dict_table_hash_latch_key,
+		       &dict_sys->table_hash_latch, SYNC_NO_ORDER_CHECK);
 
 	if (!srv_read_only_mode) {
 		dict_foreign_err_file = os_file_create_tmpfile();
@@ -1172,6 +1179,28 @@ dict_table_open_on_name(
 	DBUG_ENTER("dict_table_open_on_name");
 	DBUG_PRINT("dict_table_open_on_name", ("table: '%s'", table_name));
 
+	if (!dict_locked && ignore_err == DICT_ERR_IGNORE_NONE) {
+		/* Try to acquire a cached table without dict_sys->mutex.
+		Tables that are not cached, unreadable, corrupted or
+		have orphan indexes from an aborted ALTER TABLE are
+		handled below. We do not move the table to the MRU
+		position; a table that is in use cannot be evicted. */
+		const ulint fold = ut_fold_string(table_name);
+
+		rw_lock_s_lock(&dict_sys->table_hash_latch);
+		HASH_SEARCH(name_hash, dict_sys->table_hash, fold,
+			    dict_table_t*, table, ut_ad(table->cached),
+			    !strcmp(table->name.m_name, table_name));
+		if (table && table->is_readable() && !table->corrupted
+		    && !table->drop_aborted) {
+			table->acquire();
+			rw_lock_s_unlock(&dict_sys->table_hash_latch);
+			MONITOR_INC(MONITOR_TABLE_REFERENCE);
+			DBUG_RETURN(table);
+		}
+		rw_lock_s_unlock(&dict_sys->table_hash_latch);
+	}
+
 	if (!dict_locked) {
 		mutex_enter(&dict_sys->mutex);
 	}
@@ -1302,8 +1331,10 @@ void dict_table_t::add_to_cache()
 		ut_ad(table2 == NULL);
 #endif /* UNIV_DEBUG */
 	}
+	rw_lock_x_lock(&dict_sys->table_hash_latch);
 	HASH_INSERT(dict_table_t, name_hash, dict_sys->table_hash, fold,
 		    this);
+	rw_lock_x_unlock(&dict_sys->table_hash_latch);
 
 	/* Look for a table with the same id: error if such exists */
 	hash_table_t* id_hash = is_temporary()
@@ -1441,6 +1472,10 @@ dict_make_room_in_cache(
 
 	        prev_table = UT_LIST_GET_PREV(table_LRU, table);
 
+		/* Prevent dict_table_open_on_name() from acquiring
+		the table between the check and the eviction. */
+		rw_lock_x_lock(&dict_sys->table_hash_latch);
+
 		if (dict_table_can_be_evicted(table)) {
 
 			DBUG_EXECUTE_IF("crash_if_fts_table_is_evicted",
@@ -1455,6 +1490,8 @@ dict_make_room_in_cache(
 			++n_evicted;
 		}
 
+		rw_lock_x_unlock(&dict_sys->table_hash_latch);
+
 		table = prev_table;
 	}
 
@@ -1694,7 +1731,10 @@ dict_table_rename_in_cache(
 		}
 	}
 
-	/* Remove table from the hash tables of tables */
+	/* Remove table from the hash tables of tables. Hold the latch
+	until the table is reinserted, because dict_table_open_on_name()
+	may be comparing table->name without holding dict_sys->mutex. */
+	rw_lock_x_lock(&dict_sys->table_hash_latch);
 	HASH_DELETE(dict_table_t, name_hash, dict_sys->table_hash,
 		    ut_fold_string(old_name), table);
 
@@ -1712,6 +1752,7 @@ dict_table_rename_in_cache(
 	/* Add table to hash table of tables */
 	HASH_INSERT(dict_table_t, name_hash, dict_sys->table_hash, fold,
 		    table);
+	rw_lock_x_unlock(&dict_sys->table_hash_latch);
 
 	if (!rename_also_foreigns) {
 		/* In ALTER TABLE we think of the rename table operation
@@ -1996,11 +2037,18 @@ void dict_table_remove_from_cache(dict_table_t* table, bool lru, bool keep)
 
 	ut_ad(table);
 	ut_ad(dict_lru_validate());
-	ut_a(table->get_ref_count() == 0);
 	ut_a(table->n_rec_locks == 0);
 	ut_ad(mutex_own(&dict_sys->mutex));
 	ut_ad(table->magic_n == DICT_TABLE_MAGIC_N);
 
+	/* Remove the table from the name hash table first, so that
+	dict_table_open_on_name() can no longer acquire it. */
+	rw_lock_x_lock(&dict_sys->table_hash_latch);
+	ut_a(table->get_ref_count() == 0);
+	HASH_DELETE(dict_table_t, name_hash, dict_sys->table_hash,
+		    ut_fold_string(table->name.m_name), table);
+	rw_lock_x_unlock(&dict_sys->table_hash_latch);
+
 	/* Remove the foreign constraints from the cache */
 	std::for_each(table->foreign_set.begin(), table->foreign_set.end(),
 		      dict_foreign_remove_partial());
@@ -2025,11 +2073,6 @@ void dict_table_remove_from_cache(dict_table_t* table, bool lru, bool keep)
 		dict_index_remove_from_cache_low(table, index, lru);
 	}
 
-	/* Remove table from the hash tables of tables */
-
-	HASH_DELETE(dict_table_t, name_hash, dict_sys->table_hash,
-		    ut_fold_string(table->name.m_name), table);
-
 	hash_table_t* id_hash = table->is_temporary()
 		? dict_sys->temp_id_hash : dict_sys->table_id_hash;
 	const ulint id_fold = ut_fold_ull(table->id);
@@ -6551,6 +6594,7 @@ dict_resize()
 	dict_table_t*	table;
 
 	mutex_enter(&dict_sys->mutex);
+	rw_lock_x_lock(&dict_sys->table_hash_latch);
 
 	/* all table entries are in table_LRU and table_non_LRU lists */
 	hash_table_free(dict_sys->table_hash);
@@ -6590,6 +6634,7 @@ dict_resize()
 		HASH_INSERT(dict_table_t, id_hash, id_hash, id_fold, table);
 	}
 
+	rw_lock_x_unlock(&dict_sys->table_hash_latch);
 	mutex_exit(&dict_sys->mutex);
 }
 
@@ -6635,6 +6680,7 @@ dict_close(void)
 
 	mutex_exit(&dict_sys->mutex);
 	mutex_free(&dict_sys->mutex);
+	rw_lock_free(&dict_sys->table_hash_latch);
 
 	rw_lock_free(dict_operation_lock);
 
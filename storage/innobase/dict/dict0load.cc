@@ -45,6 +45,7 @@ Created 4/24/1996 Heikki Tuuri
 #include "srv0srv.h"
 #include <stack>
 #include <set>
+#include <vector>
 
 /** Following are the InnoDB system tables. The positions in
 this array are referenced by enum dict_system_table_id. */
@@ -1336,11 +1337,107 @@ dict_sys_tables_rec_read(
 	return(true);
 }
 
+/** A file-per-table tablespace that dict_check_sys_tables() will open */
+struct dict_check_space_t {
+	/** table name */
+	table_name_t	name;
+	/** tablespace identifier */
+	ulint		id;
+	/** SYS_TABLES.TYPE */
+	ulint		flags;
+	/** data file path from SYS_DATAFILES, or NULL */
+	char*		filepath;
+};
+
+typedef std::vector<dict_check_space_t, ut_allocator<dict_check_space_t> >
+	dict_check_spaces_t;
+
+/** Minimum number of tablespaces per tablespace header prefetch thread */
+static const ulint	DICT_PREFETCH_MIN_SPACES = 64;
+
+/** State shared by the tablespace header prefetch threads */
+struct dict_prefetch_t {
+	/** the tablespaces to prefetch */
+	const dict_check_spaces_t*	spaces;
+	/** whether the first page of each file will be validated */
+	bool				validate;
+	/** index of the next tablespace to prefetch */
+	ulint				next;
+	/** number of running threads */
+	ulint				n_threads;
+	/** set when the last thread exits */
+	os_event_t			done;
+};
+
+/** Open the data files of tablespaces ahead of dict_check_sys_tables(),
+so that the file system metadata and, when the tablespaces are going to
+be validated, the first page of each file are already cached when the
+files are opened and validated in fil_ibd_open(). Errors are ignored;
+they will be reported by fil_ibd_open().
+@param[in,out]	arg	dict_prefetch_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(dict_prefetch_thread)(void* arg)
+{
+	my_thread_init();
+
+	dict_prefetch_t*	p = static_cast<dict_prefetch_t*>(arg);
+	byte*			buf = p->validate
+		? static_cast<byte*>(ut_malloc_nokey(UNIV_PAGE_SIZE_MIN))
+		: NULL;
+
+	for (ulint i; (i = my_atomic_addlint(&p->next, 1))
+		     < p->spaces->size(); ) {
+		const dict_check_space_t&	space = (*p->spaces)[i];
+		char*				path = space.filepath
+			? mem_strdup(space.filepath)
+			: fil_make_filepath(NULL, space.name.m_name, IBD,
+					    false);
+
+		if (!path) {
+			continue;
+		}
+
+		bool		success;
+		pfs_os_file_t	file = os_file_create_simple_no_error_handling(
+			innodb_data_file_key, path, OS_FILE_OPEN,
+			OS_FILE_READ_ONLY, true, &success);
+
+		if (success) {
+			if (buf) {
+				ulint	n_read;
+				os_file_read_no_error_handling(
+					IORequestRead, file, buf, 0,
+					UNIV_PAGE_SIZE_MIN, &n_read);
+			}
+
+			os_file_close(file);
+		}
+
+		ut_free(path);
+	}
+
+	ut_free(buf);
+
+	if (my_atomic_addlint(&p->n_threads, ulint(-1)) == 1) {
+		os_event_set(p->done);
+	}
+
+	my_thread_end();
+
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /** Load and check each non-predefined tablespace mentioned in SYS_TABLES.
 Search SYS_TABLES and check each tablespace mentioned that has not
 already been added to the fil_system.  If it is valid, add it to the
 file_system list.  Perform extra validation on the table if recovery from
 the REDO log occurred.
+SYS_TABLES is scanned first, and the data files are then opened while
+srv_n_read_io_threads helper threads are prefetching them.
 @param[in]	validate	Whether to do validation on the table.
 @return the highest space ID found. */
 UNIV_INLINE
@@ -1348,10 +1445,11 @@ ulint
 dict_check_sys_tables(
 	bool		validate)
 {
-	ulint		max_space_id = 0;
-	btr_pcur_t	pcur;
-	const rec_t*	rec;
-	mtr_t		mtr;
+	ulint			max_space_id = 0;
+	btr_pcur_t		pcur;
+	const rec_t*		rec;
+	mtr_t			mtr;
+	dict_check_spaces_t	spaces;
 
 	DBUG_ENTER("dict_check_sys_tables");
 
@@ -1442,27 +1540,58 @@ dict_check_sys_tables(
 		location) or this path is the same file but looks different,
 		fil_ibd_open() will update the dictionary with what is
 		opened. */
-		char*	filepath = dict_get_first_path(space_id);
+		dict_check_space_t	space = {
+			table_name, space_id, flags,
+			dict_get_first_path(space_id)
+		};
+		spaces.push_back(space);
+
+		max_space_id = ut_max(max_space_id, space_id);
+	}
+
+	mtr_commit(&mtr);
 
+	dict_prefetch_t	prefetch = {
+		&spaces, validate, 0,
+		ut_min(ulint(srv_n_read_io_threads),
+		       spaces.size() / DICT_PREFETCH_MIN_SPACES),
+		NULL
+	};
+
+	if (prefetch.n_threads > 1) {
+		prefetch.done = os_event_create(0);
+
+		for (ulint i = prefetch.n_threads; i--; ) {
+			os_thread_create(dict_prefetch_thread, &prefetch,
+					 NULL);
+		}
+	}
+
+	for (dict_check_spaces_t::iterator i = spaces.begin();
+	     i != spaces.end(); ++i) {
 		/* Check that the .ibd file exists. */
 		if (!fil_ibd_open(
 			    validate,
 			    !srv_read_only_mode && srv_log_file_size != 0,
 			    FIL_TYPE_TABLESPACE,
-			    space_id, dict_tf_to_fsp_flags(flags),
-			    table_name, filepath)) {
+			    i->id, dict_tf_to_fsp_flags(i->flags),
+			    i->name, i->filepath)) {
 			ib::warn() << "Ignoring tablespace for "
-				<< table_name
+				<< i->name
 				<< " because it could not be opened.";
 		}
+	}
 
-		max_space_id = ut_max(max_space_id, space_id);
-
-		ut_free(table_name.m_name);
-		ut_free(filepath);
+	if (prefetch.done) {
+		os_event_wait(prefetch.done);
+		os_event_destroy(prefetch.done);
 	}
 
-	mtr_commit(&mtr);
+	for (dict_check_spaces_t::iterator i = spaces.begin();
+	     i != spaces.end(); ++i) {
+		ut_free(i->name.m_name);
+		ut_free(i->filepath);
+	}
 
 	DBUG_RETURN(max_space_id);
 }
@@ -1472,6 +1472,7 @@ dict_stats_analyze_index_below_cur(
 	ulint*		offsets2;
 	ulint*		offsets_rec;
 	ulint		size;
+	bool		in_pool;
 	mtr_t		mtr;
 
 	index = btr_cur_get_index(cur);
@@ -1519,6 +1520,8 @@ dict_stats_analyze_index_below_cur(
 
 		dberr_t err = DB_SUCCESS;
 
+		in_pool = buf_page_peek(page_id);
+
 		block = buf_page_get_gen(page_id, page_size, RW_S_LATCH,
 					 NULL /* no guessed block */,
 					 BUF_GET, __FILE__, __LINE__, &mtr, &err);
@@ -1587,6 +1590,12 @@ dict_stats_analyze_index_below_cur(
 		     __func__, page_no, n_diff);
 #endif
 
+	if (!in_pool) {
+		/* The leaf page was read only for sampling it. Do not
+		let it replace more useful pages in the buffer pool. */
+		buf_page_make_old(&block->page);
+	}
+
 	mtr_commit(&mtr);
 	mem_heap_free(heap);
 }
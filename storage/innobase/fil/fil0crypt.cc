@@ -1196,6 +1196,17 @@ fil_crypt_space_needs_rotation(
 			break;
 		}
 
+		/* All remaining pages of the space have already been
+		handed out to other threads. Rather than joining them
+		only to find nothing left, move on to the next space,
+		so that many small tablespaces are rotated in parallel
+		instead of one at a time by all threads. */
+		if (crypt_data->rotate_state.active_threads > 0
+		    && crypt_data->rotate_state.next_offset
+		    > crypt_data->rotate_state.max_offset) {
+			break;
+		}
+
 		/* No need to rotate space if encryption is disabled */
 		if (crypt_data->not_encrypted()) {
 			break;
@@ -779,17 +779,20 @@ fil_try_to_close_file_in_LRU(
 	bool	print_info)
 {
 	fil_node_t*	node;
+	fil_node_t*	prev;
+	ulint		n = UT_LIST_GET_LEN(fil_system.LRU);
 
 	ut_ad(mutex_own(&fil_system.mutex));
 
 	if (print_info) {
-		ib::info() << "fil_sys open file LRU len "
-			<< UT_LIST_GET_LEN(fil_system.LRU);
+		ib::info() << "fil_sys open file LRU len " << n;
 	}
 
 	for (node = UT_LIST_GET_LAST(fil_system.LRU);
-	     node != NULL;
-	     node = UT_LIST_GET_PREV(LRU, node)) {
+	     node != NULL && n--;
+	     node = prev) {
+
+		prev = UT_LIST_GET_PREV(LRU, node);
 
 		if (node->modification_counter == node->flush_counter
 		    && node->n_pending_flushes == 0
@@ -800,6 +803,14 @@ fil_try_to_close_file_in_LRU(
 			return(true);
 		}
 
+		/* Move the node that cannot be closed yet to the head
+		of the list, so that the next call will not have to
+		skip over it again. Otherwise, with many modified
+		files at the tail, every file open would scan most of
+		the list while holding fil_system.mutex. */
+		UT_LIST_REMOVE(fil_system.LRU, node);
+		UT_LIST_ADD_FIRST(fil_system.LRU, node);
+
 		if (!print_info) {
 			continue;
 		}
@@ -77,17 +77,20 @@ Updated 14/02/2015
 @param[in]	buf		page to be compressed
 @param[out]	out_buf		compressed page
 @param[in]	level		compression level
+@param[in]	algorithm	PAGE_ZLIB_ALGORITHM or similar,
+				or 0 for innodb_compression_algorithm
 @param[in]	block_size	file system block size
 @param[in]	encrypted	whether the page will be subsequently encrypted
 @return actual length of compressed page
 @retval	0	if the page was not compressed */
 ulint fil_page_compress(const byte* buf, byte* out_buf, ulint level,
-			ulint block_size, bool encrypted)
+			ulint algorithm, ulint block_size, bool encrypted)
 {
 	int comp_level = int(level);
 	ulint header_len = FIL_PAGE_DATA + FIL_PAGE_COMPRESSED_SIZE;
 	/* Cache to avoid change during function execution */
-	ulint comp_method = innodb_compression_algorithm;
+	ulint comp_method = algorithm
+		? algorithm : innodb_compression_algorithm;
 
 	if (encrypted) {
 		header_len += FIL_PAGE_COMPRESSION_METHOD_SIZE;
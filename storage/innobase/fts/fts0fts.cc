@@ -3983,17 +3983,16 @@ fts_sync_add_deleted_cache(
 }
 
 /** Write the words and ilist to disk.
-@param[in,out]	trx		transaction
+@param[in,out]	sync		sync state
 @param[in]	index_cache	index cache
-@param[in]	unlock_cache	whether unlock cache when write node
 @return DB_SUCCESS if all went well else error code */
 static MY_ATTRIBUTE((nonnull, warn_unused_result))
 dberr_t
 fts_sync_write_words(
-	trx_t*			trx,
-	fts_index_cache_t*	index_cache,
-	bool			unlock_cache)
+	fts_sync_t*		sync,
+	fts_index_cache_t*	index_cache)
 {
+	trx_t*		trx = sync->trx;
 	fts_table_t	fts_table;
 	ulint		n_nodes = 0;
 	ulint		n_words = 0;
@@ -4042,7 +4041,7 @@ fts_sync_write_words(
 
 			/*FIXME: we need to handle the error properly. */
 			if (error == DB_SUCCESS) {
-				if (unlock_cache) {
+				if (sync->unlock_cache) {
 					rw_lock_x_unlock(
 						&table->fts->cache->lock);
 				}
@@ -4060,9 +4059,16 @@ fts_sync_write_words(
 					os_thread_sleep(1000000);
 				);
 
-				if (unlock_cache) {
+				if (sync->unlock_cache) {
 					rw_lock_x_lock(
 						&table->fts->cache->lock);
+
+					/* Once the cache has outgrown
+					the budget of this sync, keep
+					the lock so that we catch up. */
+					sync->unlock_cache
+						= table->fts->cache->total_size
+						<= sync->unlock_max_size;
 				}
 			}
 		}
@@ -4131,7 +4137,7 @@ fts_sync_index(
 
 	ut_ad(rbt_validate(index_cache->words));
 
-	return(fts_sync_write_words(trx, index_cache, sync->unlock_cache));
+	return(fts_sync_write_words(sync, index_cache));
 }
 
 /** Check if index cache has been synced completely
@@ -4342,6 +4348,9 @@ fts_sync(
 	}
 
 	sync->unlock_cache = unlock_cache;
+	/* Let DML keep adding to the cache while it is being written
+	out, until it has grown by half of innodb_ft_cache_size. */
+	sync->unlock_max_size = cache->total_size + fts_max_cache_size / 2;
 	sync->in_progress = true;
 
 	DEBUG_SYNC_C("fts_sync_begin");
@@ -4354,10 +4363,9 @@ fts_sync(
 	}
 
 begin_sync:
-	if (cache->total_size > fts_max_cache_size) {
+	if (cache->total_size > sync->unlock_max_size) {
 		/* Avoid the case: sync never finish when
 		insert/update keeps comming. */
-		ut_ad(sync->unlock_cache);
 		sync->unlock_cache = false;
 	}
 
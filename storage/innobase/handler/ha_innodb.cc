@@ -655,6 +655,7 @@ static PSI_rwlock_info all_innodb_rwlocks[] = {
 	PSI_RWLOCK_KEY(buf_block_debug_latch),
 #  endif /* UNIV_DEBUG */
 	PSI_RWLOCK_KEY(dict_operation_lock),
+	PSI_RWLOCK_KEY(dict_table_hash_latch),
 	PSI_RWLOCK_KEY(fil_space_latch),
 	PSI_RWLOCK_KEY(checkpoint_lock),
 	PSI_RWLOCK_KEY(fts_cache_rw_lock),
@@ -738,6 +739,11 @@ ha_create_table_option innodb_table_option_list[]=
   HA_TOPTION_ENUM("ENCRYPTED", encryption, "DEFAULT,YES,NO", 0),
   /* With this option the user defines the key identifier using for the encryption */
   HA_TOPTION_SYSVAR("ENCRYPTION_KEY_ID", encryption_key_id, default_encryption_key_id),
+  /* With this option the user can override innodb_compression_algorithm
+  for a page compressed table. The values are in the order of
+  PAGE_ZLIB_ALGORITHM and so on. */
+  HA_TOPTION_ENUM("PAGE_COMPRESSION_ALGORITHM", page_compression_algorithm,
+		  "DEFAULT,ZLIB,LZ4,LZO,LZMA,BZIP2,SNAPPY", 0),
 
   HA_TOPTION_END
 };
@@ -928,6 +934,13 @@ static MYSQL_THDVAR_BOOL(strict_mode, PLUGIN_VAR_OPCMDARG,
   "Use strict mode when evaluating create options.",
   NULL, NULL, TRUE);
 
+static MYSQL_THDVAR_BOOL(scan_no_cache, PLUGIN_VAR_OPCMDARG,
+  "Whether index and table scans evict the pages that they read from the"
+  " data files first, so that one-pass scans do not push other pages out"
+  " of the buffer pool. Such scans also read ahead the following leaf"
+  " pages as with innodb_logical_read_ahead.",
+  NULL, NULL, FALSE);
+
 static MYSQL_THDVAR_BOOL(ft_enable_stopword, PLUGIN_VAR_OPCMDARG,
   "Create FTS index with stopword.",
   NULL, NULL,
@@ -1810,6 +1823,16 @@ thd_lock_wait_timeout(
 	return(THDVAR(thd, lock_wait_timeout));
 }
 
+/** Determine if scans should avoid polluting the buffer pool.
+@param[in]	thd	thread handle, or NULL to query
+			the global innodb_scan_no_cache
+@return the value of innodb_scan_no_cache */
+bool
+thd_scan_no_cache(THD* thd)
+{
+	return(THDVAR(thd, scan_no_cache));
+}
+
 /** Get the value of innodb_tmpdir.
 @param[in]	thd	thread handle, or NULL to query
 			the global innodb_tmpdir.
@@ -2914,10 +2937,15 @@ ha_innobase::ha_innobase(
 			  | HA_CAN_RTREEKEYS
                           | HA_CAN_TABLES_WITHOUT_ROLLBACK
 			  | HA_CONCURRENT_OPTIMIZE
+			  | HA_DO_RANGE_FILTER_PUSHDOWN
+			  | HA_FAST_INDEX_NEXT
+			  | HA_CAN_FORCE_BULK_DELETE
 			  |  (srv_force_primary_key ? HA_REQUIRE_PRIMARY_KEY : 0)
 		  ),
 	m_start_of_scan(),
-        m_mysql_has_locked()
+        m_mysql_has_locked(),
+	m_bulk_delete(),
+	m_bulk_deleted()
 {}
 
 /*********************************************************************//**
@@ -6160,6 +6188,16 @@ ha_innobase::open(const char* name, int, uint)
 		}
 	}
 
+	if (fil_space_t* space = ib_table->space) {
+		if (FSP_FLAGS_HAS_PAGE_COMPRESSION(space->flags)) {
+			/* PAGE_COMPRESSION_ALGORITHM is only stored in
+			the .frm file. Pages that are written before the
+			table is opened use innodb_compression_algorithm. */
+			space->page_compression_algorithm = table->s
+				->option_struct->page_compression_algorithm;
+		}
+	}
+
 	m_prebuilt = row_create_prebuilt(ib_table, table->s->reclength);
 
 	m_prebuilt->default_rec = table->s->default_values;
@@ -7572,11 +7610,27 @@ ha_innobase::build_template(
 	/* Note that in InnoDB, i is the column number in the table.
 	MySQL calls columns 'fields'. */
 
+	/* A pushed rowid filter is checked in the index condition
+	pushdown phase, for the records of a secondary index. The
+	filter is looked up with the PRIMARY KEY columns, which must
+	be converted to the MySQL format in that phase. */
+	const bool check_rowid_filter = pushed_rowid_filter
+		&& active_index != MAX_KEY
+		&& !dict_index_is_clust(m_prebuilt->index)
+		&& (pushed_idx_cond_keyno == MAX_KEY
+		    || active_index == pushed_idx_cond_keyno);
+
+	if (check_rowid_filter) {
+		fetch_primary_key_cols = TRUE;
+	}
+
 	if (active_index != MAX_KEY
-	    && active_index == pushed_idx_cond_keyno) {
+	    && (active_index == pushed_idx_cond_keyno
+		|| check_rowid_filter)) {
 		ulint	num_v = 0;
 
-		/* Push down an index condition or an end_range check. */
+		/* Push down an index condition, an end_range check or a
+		rowid filter. */
 		for (i = 0; i < n_fields; i++) {
 			ibool		index_contains;
 
@@ -8927,9 +8981,14 @@ ha_innobase::delete_row(
 	innobase_srv_conc_exit_innodb(m_prebuilt);
 
 	/* Tell the InnoDB server that there might be work for
-	utility threads: */
+	utility threads. In a bulk delete, this is done once by
+	end_bulk_delete(), to not write the shared counter for every row. */
 
-	innobase_active_small();
+	if (m_bulk_delete) {
+		m_bulk_deleted++;
+	} else {
+		innobase_active_small();
+	}
 
 #ifdef WITH_WSREP
 	if (error == DB_SUCCESS                            &&
@@ -8948,6 +9007,41 @@ ha_innobase::delete_row(
 			    error, m_prebuilt->table->flags, m_user_thd));
 }
 
+/** Start a DELETE of many rows, which are deleted one by one
+by delete_row().
+@retval false (bulk delete is used) */
+
+bool
+ha_innobase::start_bulk_delete()
+{
+	m_bulk_delete = true;
+	m_bulk_deleted = 0;
+	return(false);
+}
+
+/** End a DELETE of many rows, and account the deleted rows to
+the activity of the server.
+@return 0 */
+
+int
+ha_innobase::end_bulk_delete()
+{
+	if (m_bulk_deleted) {
+		ulong	before = innobase_active_counter;
+
+		innobase_active_counter += m_bulk_deleted;
+
+		if (innobase_active_counter / INNOBASE_WAKE_INTERVAL
+		    != before / INNOBASE_WAKE_INTERVAL) {
+			srv_active_wake_master_thread();
+		}
+	}
+
+	m_bulk_delete = false;
+	m_bulk_deleted = 0;
+	return(0);
+}
+
 /** Delete all rows from the table.
 @return error number or 0 */
 
@@ -11457,6 +11551,37 @@ create_table_info_t::create_options_are_invalid()
 	return(ret);
 }
 
+/** Determine if a page_compressed algorithm is available in this build.
+@param[in]	algorithm	PAGE_ZLIB_ALGORITHM or similar
+@return	whether the algorithm can be used */
+static bool page_compression_algorithm_available(ulint algorithm)
+{
+	switch (algorithm) {
+#ifndef HAVE_LZ4
+	case PAGE_LZ4_ALGORITHM:
+		return false;
+#endif
+#ifndef HAVE_LZO
+	case PAGE_LZO_ALGORITHM:
+		return false;
+#endif
+#ifndef HAVE_LZMA
+	case PAGE_LZMA_ALGORITHM:
+		return false;
+#endif
+#ifndef HAVE_BZIP2
+	case PAGE_BZIP2_ALGORITHM:
+		return false;
+#endif
+#ifndef HAVE_SNAPPY
+	case PAGE_SNAPPY_ALGORITHM:
+		return false;
+#endif
+	default:
+		return algorithm <= PAGE_ALGORITHM_LAST;
+	}
+}
+
 /*****************************************************************//**
 Check engine specific table options not handled by SQL-parser.
 @return	NULL if valid, string if not */
@@ -11561,6 +11686,28 @@ create_table_info_t::check_table_options()
 		}
 	}
 
+	if (options->page_compression_algorithm) {
+		if (!options->page_compressed) {
+			push_warning(
+				m_thd, Sql_condition::WARN_LEVEL_WARN,
+				HA_WRONG_CREATE_OPTION,
+				"InnoDB: PAGE_COMPRESSION_ALGORITHM requires"
+				" PAGE_COMPRESSED");
+			return "PAGE_COMPRESSION_ALGORITHM";
+		}
+
+		if (!page_compression_algorithm_available(
+			    options->page_compression_algorithm)) {
+			push_warning_printf(
+				m_thd, Sql_condition::WARN_LEVEL_WARN,
+				HA_WRONG_CREATE_OPTION,
+				"InnoDB: PAGE_COMPRESSION_ALGORITHM = %u"
+				" is not available in this build",
+				options->page_compression_algorithm);
+			return "PAGE_COMPRESSION_ALGORITHM";
+		}
+	}
+
 	/* If encryption is set up make sure that used key_id is found */
 	if (encrypt == FIL_ENCRYPTION_ON ||
 		(encrypt == FIL_ENCRYPTION_DEFAULT && srv_encrypt_tables)) {
@@ -15198,6 +15345,8 @@ MySQL calls this method at the end of each statement */
 int
 ha_innobase::reset()
 {
+	m_bulk_delete = false;
+	m_bulk_deleted = 0;
 	return(end_stmt());
 }
 
@@ -17265,6 +17414,17 @@ innodb_adaptive_hash_index_update(THD*, st_mysql_sys_var*, void*,
 }
 #endif /* BTR_CUR_HASH_ADAPT */
 
+/** Update innodb_thread_concurrency.
+@param[in]	save	to-be-assigned value */
+static
+void
+innodb_thread_concurrency_update(THD*, st_mysql_sys_var*, void*,
+				 const void* save)
+{
+	srv_thread_concurrency = *static_cast<const ulong*>(save);
+	srv_conc_update_concurrency();
+}
+
 /****************************************************************//**
 Update the system variable innodb_cmp_per_index using the "saved"
 value. This function is registered as a callback with MySQL. */
@@ -19386,6 +19546,12 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_ULONG(index_build_threads, srv_index_build_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum number of threads for sorting and loading secondary indexes"
+  " concurrently in index creation (1 to build them one at a time)",
+  NULL, NULL, 4, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -19406,6 +19572,13 @@ static MYSQL_SYSVAR_ULONG(write_io_threads, srv_n_write_io_threads,
   "Number of background write I/O threads in InnoDB.",
   NULL, NULL, 4, 1, 64, 0);
 
+static MYSQL_SYSVAR_BOOL(track_changed_pages, srv_track_changed_pages,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Write the identifiers of the pages written to the data files to"
+  " ib_modified_log_*.xdb files, so that incremental backups by"
+  " mariabackup can copy only the changed pages",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONG(force_recovery, srv_force_recovery,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Helps to save your data in case the disk image of the database becomes corrupt.",
@@ -19441,6 +19614,19 @@ static MYSQL_SYSVAR_ULONG(log_write_ahead_size, srv_log_write_ahead_size,
   NULL, innodb_log_write_ahead_size_update,
   8*1024L, OS_FILE_LOG_BLOCK_SIZE, UNIV_PAGE_SIZE_DEF, OS_FILE_LOG_BLOCK_SIZE);
 
+static MYSQL_SYSVAR_BOOL(log_concurrent_copy, srv_log_concurrent_copy,
+  PLUGIN_VAR_OPCMDARG,
+  "Whether mini-transaction commit only reserves space for the redo log"
+  " records while holding the log mutex, and copies them concurrently"
+  " with other threads",
+  NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_ULONG(log_flush_spin_rounds, srv_log_flush_spin_rounds,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of times a transaction commit polls for a pending redo log"
+  " flush to complete before waiting for it (0 to wait immediately)",
+  NULL, NULL, 0, 0, 1000000, 0);
+
 static MYSQL_SYSVAR_UINT(old_blocks_pct, innobase_old_blocks_pct,
   PLUGIN_VAR_RQCMDARG,
   "Percentage of the buffer pool to reserve for 'old' blocks.",
@@ -19453,6 +19639,13 @@ static MYSQL_SYSVAR_UINT(old_blocks_time, buf_LRU_old_threshold_ms,
   " The timeout is disabled if 0.",
   NULL, NULL, 1000, 0, UINT_MAX32, 0);
 
+static MYSQL_SYSVAR_UINT(unzip_lru_pct, buf_LRU_unzip_pct,
+  PLUGIN_VAR_RQCMDARG,
+  "Percentage of the buffer pool LRU list length up to which"
+  " uncompressed copies of ROW_FORMAT=COMPRESSED pages are preserved"
+  " when evicting pages (0 to evict them whenever possible)",
+  NULL, NULL, 10, 0, 100, 0);
+
 static MYSQL_SYSVAR_ULONG(open_files, innobase_open_files,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "How many files at the maximum InnoDB keeps open at the same time.",
@@ -19471,12 +19664,13 @@ static MYSQL_SYSVAR_UINT(spin_wait_delay, srv_spin_wait_delay,
 static MYSQL_SYSVAR_ULONG(thread_concurrency, srv_thread_concurrency,
   PLUGIN_VAR_RQCMDARG,
   "Helps in performance tuning in heavily concurrent environments. Sets the maximum number of threads allowed inside InnoDB. Value 0 will disable the thread throttling.",
-  NULL, NULL, 0, 0, 1000, 0);
+  NULL, innodb_thread_concurrency_update, 0, 0, 1000, 0);
 
 static MYSQL_SYSVAR_ULONG(
   adaptive_max_sleep_delay, srv_adaptive_max_sleep_delay,
   PLUGIN_VAR_RQCMDARG,
-  "The upper limit of the sleep delay in usec. Value of 0 disables it.",
+  "DEPRECATED. This option has no effect; threads that wait for"
+  " innodb_thread_concurrency are woken up in FIFO order.",
   NULL, NULL,
   150000,			/* Default setting */
   0,				/* Minimum value */
@@ -19490,8 +19684,8 @@ static MYSQL_SYSVAR_BOOL(prefix_index_cluster_optimization,
 
 static MYSQL_SYSVAR_ULONG(thread_sleep_delay, srv_thread_sleep_delay,
   PLUGIN_VAR_RQCMDARG,
-  "Time of innodb thread sleeping before joining InnoDB queue (usec)."
-  " Value 0 disable a sleep",
+  "DEPRECATED. This option has no effect; threads that wait for"
+  " innodb_thread_concurrency are woken up in FIFO order.",
   NULL, NULL,
   10000L,
   0L,
@@ -19576,11 +19770,25 @@ static MYSQL_SYSVAR_BOOL(use_native_aio, srv_use_native_aio,
   "Use native AIO if supported on this platform.",
   NULL, NULL, TRUE);
 
+#ifdef LINUX_IO_URING
+static MYSQL_SYSVAR_BOOL(use_io_uring, srv_use_io_uring,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Use io_uring instead of libaio for native AIO, if the kernel"
+  " supports it.",
+  NULL, NULL, FALSE);
+#endif /* LINUX_IO_URING */
+
 #ifdef HAVE_LIBNUMA
 static MYSQL_SYSVAR_BOOL(numa_interleave, srv_numa_interleave,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Use NUMA interleave memory policy to allocate InnoDB buffer pool.",
   NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_BOOL(numa_bind, srv_numa_bind,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Bind each InnoDB buffer pool instance and page cleaner thread"
+  " to a NUMA node. Ignored if innodb_numa_interleave is set.",
+  NULL, NULL, FALSE);
 #endif /* HAVE_LIBNUMA */
 
 static MYSQL_SYSVAR_ENUM(change_buffering, innodb_change_buffering,
@@ -19659,6 +19867,12 @@ static MYSQL_SYSVAR_BOOL(random_read_ahead, srv_random_read_ahead,
   "Whether to use read ahead for random access within an extent.",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_BOOL(logical_read_ahead, srv_logical_read_ahead,
+  PLUGIN_VAR_NOCMDARG,
+  "Whether index range scans read ahead the next leaf pages in key order,"
+  " as listed in their parent page.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONG(read_ahead_threshold, srv_read_ahead_threshold,
   PLUGIN_VAR_RQCMDARG,
   "Number of pages that must be accessed sequentially for InnoDB to"
@@ -19982,6 +20196,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(fast_shutdown),
   MYSQL_SYSVAR(read_io_threads),
   MYSQL_SYSVAR(write_io_threads),
+  MYSQL_SYSVAR(track_changed_pages),
   MYSQL_SYSVAR(file_per_table),
   MYSQL_SYSVAR(flush_log_at_timeout),
   MYSQL_SYSVAR(flush_log_at_trx_commit),
@@ -20006,6 +20221,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(log_file_size),
   MYSQL_SYSVAR(log_files_in_group),
   MYSQL_SYSVAR(log_write_ahead_size),
+  MYSQL_SYSVAR(log_concurrent_copy),
+  MYSQL_SYSVAR(log_flush_spin_rounds),
   MYSQL_SYSVAR(log_group_home_dir),
   MYSQL_SYSVAR(log_compressed_pages),
   MYSQL_SYSVAR(log_optimize_ddl),
@@ -20019,6 +20236,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(max_purge_lag_delay),
   MYSQL_SYSVAR(old_blocks_pct),
   MYSQL_SYSVAR(old_blocks_time),
+  MYSQL_SYSVAR(unzip_lru_pct),
   MYSQL_SYSVAR(open_files),
   MYSQL_SYSVAR(optimize_fulltext_only),
   MYSQL_SYSVAR(rollback_on_timeout),
@@ -20043,7 +20261,9 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(replication_delay),
   MYSQL_SYSVAR(status_file),
   MYSQL_SYSVAR(strict_mode),
+  MYSQL_SYSVAR(scan_no_cache),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(index_build_threads),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
@@ -20056,8 +20276,12 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(autoinc_lock_mode),
   MYSQL_SYSVAR(version),
   MYSQL_SYSVAR(use_native_aio),
+#ifdef LINUX_IO_URING
+  MYSQL_SYSVAR(use_io_uring),
+#endif /* LINUX_IO_URING */
 #ifdef HAVE_LIBNUMA
   MYSQL_SYSVAR(numa_interleave),
+  MYSQL_SYSVAR(numa_bind),
 #endif /* HAVE_LIBNUMA */
   MYSQL_SYSVAR(change_buffering),
   MYSQL_SYSVAR(change_buffer_max_size),
@@ -20069,6 +20293,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(disallow_writes),
 #endif /* WITH_INNODB_DISALLOW_WRITES */
   MYSQL_SYSVAR(random_read_ahead),
+  MYSQL_SYSVAR(logical_read_ahead),
   MYSQL_SYSVAR(read_ahead_threshold),
   MYSQL_SYSVAR(read_only),
   MYSQL_SYSVAR(io_capacity),
@@ -20860,6 +21085,27 @@ ha_innobase::idx_cond_push(
 	DBUG_RETURN(NULL);
 }
 
+/** Attempt to push down a rowid filter.
+@param[in] filter Rowid filter to be checked
+@return false if pushed; true if not pushed */
+
+bool
+ha_innobase::rowid_filter_push(
+	Range_rowid_filter*	filter)
+{
+	DBUG_ENTER("ha_innobase::rowid_filter_push");
+	DBUG_ASSERT(filter != NULL);
+
+	/* The filter contains PRIMARY KEY values, which a table without
+	a PRIMARY KEY does not have in its secondary index records. */
+	if (m_prebuilt->clust_index_was_generated) {
+		DBUG_RETURN(true);
+	}
+
+	pushed_rowid_filter = filter;
+	DBUG_RETURN(false);
+}
+
 /******************************************************************//**
 Use this when the args are passed to the format string from
 errmsg-utf8.txt directly as is.
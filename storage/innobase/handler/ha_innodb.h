@@ -44,6 +44,10 @@ struct ha_table_option_struct
 						value OFF.*/
 	uint		encryption;		/*!<  DEFAULT, ON, OFF */
 	ulonglong	encryption_key_id;	/*!< encryption key id  */
+	uint		page_compression_algorithm;
+						/*!< DEFAULT, or
+						PAGE_ZLIB_ALGORITHM
+						or similar */
 };
 /* JAN: TODO: MySQL 5.7 handler.h */
 struct st_handler_tablename
@@ -114,6 +118,10 @@ class ha_innobase: public handler
 
 	int delete_row(const uchar * buf);
 
+	bool start_bulk_delete();
+
+	int end_bulk_delete();
+
 	bool was_semi_consistent_read();
 
 	void try_semi_consistent_read(bool yes);
@@ -415,6 +423,11 @@ class ha_innobase: public handler
 	@param[in] idx_cond Index condition to be checked
 	@return idx_cond if pushed; NULL if not pushed */
 	Item* idx_cond_push(uint keyno, Item* idx_cond);
+
+	/** Attempt to push down a rowid filter.
+	@param[in] filter Rowid filter to be checked
+	@return false if pushed; true if not pushed */
+	bool rowid_filter_push(Range_rowid_filter* filter);
 	/* @} */
 
 protected:
@@ -493,6 +506,12 @@ class ha_innobase: public handler
 
         /** If mysql has locked with external_lock() */
         bool                    m_mysql_has_locked;
+
+	/** Whether start_bulk_delete() was called */
+	bool			m_bulk_delete;
+
+	/** Number of rows deleted since start_bulk_delete() */
+	ulint			m_bulk_deleted;
 };
 
 
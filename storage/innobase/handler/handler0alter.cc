@@ -166,8 +166,11 @@ inline void dict_table_t::prepare_instant(const dict_table_t& old,
 
 	if (!old.instant) {
 		/* Columns were not dropped or reordered.
-		Therefore columns must have been added at the end. */
-		DBUG_ASSERT(index.n_fields > oindex.n_fields);
+		Therefore columns must have been added at the end,
+		or NOT NULL must have been removed from some columns
+		of a ROW_FORMAT=REDUNDANT table. */
+		DBUG_ASSERT(index.n_fields > oindex.n_fields
+			    || !not_redundant());
 set_core_fields:
 		index.n_core_fields = oindex.n_core_fields;
 		index.n_core_null_bytes = oindex.n_core_null_bytes;
@@ -287,7 +290,8 @@ inline void dict_table_t::prepare_instant(const dict_table_t& old,
 				goto found_nullable;
 			}
 		}
-		ut_ad(UT_BITS_IN_BYTES(core_null) == oindex.n_core_null_bytes);
+		ut_ad(UT_BITS_IN_BYTES(core_null) == oindex.n_core_null_bytes
+		      || !not_redundant());
 		DBUG_ASSERT(i >= oindex.n_core_fields);
 		DBUG_ASSERT(j <= i);
 		DBUG_ASSERT(n_fields - (i - j) == index.n_fields);
@@ -345,7 +349,9 @@ inline void dict_index_t::instant_add_field(const dict_index_t& instant)
 	for (unsigned i = 0; i < n_fields; i++) {
 		DBUG_ASSERT(fields[i].same(instant.fields[i]));
 		DBUG_ASSERT(fields[i].col->is_nullable()
-			    == instant.fields[i].col->is_nullable());
+			    == instant.fields[i].col->is_nullable()
+			    || (!table->not_redundant()
+				&& instant.fields[i].col->is_nullable()));
 	}
 #endif
 	n_fields = instant.n_fields;
@@ -547,6 +553,7 @@ inline void dict_table_t::instant_column(const dict_table_t& table,
 		if (index->to_be_dropped) {
 			continue;
 		}
+		index->n_nullable = 0;
 		for (unsigned i = 0; i < index->n_fields; i++) {
 			dict_field_t& f = index->fields[i];
 			if (f.col >= table.cols
@@ -578,12 +585,15 @@ inline void dict_table_t::instant_column(const dict_table_t& table,
 				DBUG_ASSERT(!f.col->is_virtual());
 			}
 			f.name = f.col->name(*this);
+			index->n_nullable += f.col->is_nullable();
 			if (f.col->is_virtual()) {
 				reinterpret_cast<dict_v_col_t*>(f.col)
 					->v_indexes->push_back(
 						dict_v_idx_t(index, i));
 			}
 		}
+		index->n_core_null_bytes = UT_BITS_IN_BYTES(
+			unsigned(index->n_nullable));
 	}
 
 	n_cols = table.n_cols;
@@ -674,6 +684,8 @@ inline void dict_table_t::rollback_instant(
 			continue;
 		}
 
+		index->n_nullable = 0;
+
 		for (unsigned i = 0; i < index->n_fields; i++) {
 			dict_field_t& f = index->fields[i];
 			if (f.col->is_virtual()) {
@@ -702,7 +714,11 @@ inline void dict_table_t::rollback_instant(
 				DBUG_ASSERT(!f.col->is_virtual());
 			}
 			f.name = f.col->name(*this);
+			index->n_nullable += f.col->is_nullable();
 		}
+
+		index->n_core_null_bytes = UT_BITS_IN_BYTES(
+			unsigned(index->n_nullable));
 	}
 }
 
@@ -1313,7 +1329,17 @@ instant_alter_column_possible(
 	if (!(ha_alter_info->handler_flags
 	      & (ALTER_ADD_STORED_BASE_COLUMN
 		 | ALTER_DROP_STORED_COLUMN
-		 | ALTER_STORED_COLUMN_ORDER))) {
+		 | ALTER_STORED_COLUMN_ORDER
+		 | ALTER_COLUMN_NULLABLE))) {
+		return false;
+	}
+
+	/* In ROW_FORMAT=REDUNDANT, every field of a record carries an
+	SQL NULL flag in the record header, so removing NOT NULL does not
+	change the format of any record. In the other formats, the null
+	flags of the 'core' fields would have to be extended. */
+	if ((ha_alter_info->handler_flags & ALTER_COLUMN_NULLABLE)
+	    && ib_table.not_redundant()) {
 		return false;
 	}
 
@@ -1338,7 +1364,8 @@ instant_alter_column_possible(
 	    & ((INNOBASE_ALTER_REBUILD | INNOBASE_ONLINE_CREATE)
 	       & ~ALTER_DROP_STORED_COLUMN
 	       & ~ALTER_STORED_COLUMN_ORDER
-	       & ~ALTER_ADD_STORED_BASE_COLUMN & ~ALTER_OPTIONS)) {
+	       & ~ALTER_ADD_STORED_BASE_COLUMN
+	       & ~ALTER_COLUMN_NULLABLE & ~ALTER_OPTIONS)) {
 		return false;
 	}
 
@@ -4873,6 +4900,40 @@ static bool innobase_instant_add_col(
 					 trx);
 }
 
+/** Update SYS_COLUMNS.PRTYPE for instantly removing NOT NULL.
+@param[in]	table_id	table id
+@param[in]	pos		SYS_COLUMNS.POS
+@param[in]	prtype		new SYS_COLUMNS.PRTYPE
+@param[in,out]	trx		data dictionary transaction
+@retval true Failure
+@retval false Success. */
+static bool innobase_instant_change_col(
+	table_id_t	table_id,
+	ulint		pos,
+	ulint		prtype,
+	trx_t*		trx)
+{
+	pars_info_t*	info = pars_info_create();
+	pars_info_add_ull_literal(info, "id", table_id);
+	pars_info_add_int4_literal(info, "pos", pos);
+	pars_info_add_int4_literal(info, "prtype", prtype);
+
+	dberr_t err = que_eval_sql(
+			info,
+			"PROCEDURE CHANGE_COL () IS\n"
+			"BEGIN\n"
+			"UPDATE SYS_COLUMNS SET PRTYPE = :prtype\n"
+			"WHERE TABLE_ID = :id AND POS = :pos;\n"
+			"END;\n", FALSE, trx);
+	if (err != DB_SUCCESS) {
+		my_error(ER_INTERNAL_ERROR, MYF(0),
+			 "InnoDB: UPDATE SYS_COLUMNS failed");
+		return true;
+	}
+
+	return false;
+}
+
 /** Delete metadata from SYS_COLUMNS and SYS_VIRTUAL.
 @param[in]	id	table id
 @param[in]	pos	first SYS_COLUMNS.POS
@@ -5376,6 +5437,11 @@ static bool innobase_instant_try(
 		if (old && (!ctx->first_alter_pos
 			    || i < ctx->first_alter_pos - 1)) {
 			/* The record is already present in SYS_COLUMNS. */
+			if (old->prtype != col->prtype
+			    && innobase_instant_change_col(
+				    user_table->id, i, col->prtype, trx)) {
+				return true;
+			}
 		} else if (innobase_instant_add_col(user_table->id, i,
 						    (*af)->field_name.str,
 						    d->type, trx)) {
@@ -5415,6 +5481,14 @@ static bool innobase_instant_try(
 		return true;
         }
 
+	if (!ctx->first_alter_pos && index->n_fields == n_old_fields) {
+		/* Only NOT NULL was removed from some columns of a
+		ROW_FORMAT=REDUNDANT table. The metadata record (if any)
+		does not need to change. */
+		DBUG_ASSERT(!user_table->not_redundant());
+		return false;
+	}
+
 	unsigned i = unsigned(user_table->n_cols) - DATA_N_SYS_COLS;
 	DBUG_ASSERT(i >= altered_table->s->stored_fields);
 	DBUG_ASSERT(i <= altered_table->s->stored_fields + 1);
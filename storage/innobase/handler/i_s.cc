@@ -8984,6 +8984,14 @@ static ST_FIELD_INFO	innodb_mutexes_fields_info[] =
 	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
 	 STRUCT_FLD(old_name,		""),
 	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+#define MUTEXES_OS_WAIT_TIME		4
+	{STRUCT_FLD(field_name,		"OS_WAIT_TIME"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
 
 	END_OF_ST_FIELD_INFO
 };
@@ -9003,6 +9011,7 @@ i_s_innodb_mutexes_fill_table(
 {
 	rw_lock_t*	lock;
 	ulint		block_lock_oswait_count = 0;
+	uint64_t	block_lock_oswait_time = 0;
 	rw_lock_t*	block_lock = NULL;
 	Field**		fields = tables->table->field;
 
@@ -9068,6 +9077,7 @@ i_s_innodb_mutexes_fill_table(
 		if (buf_pool_is_block_lock(lock)) {
 			block_lock = lock;
 			block_lock_oswait_count += lock->count_os_wait;
+			block_lock_oswait_time += lock->os_wait_time;
 			continue;
 		}
 
@@ -9076,6 +9086,8 @@ i_s_innodb_mutexes_fill_table(
 		OK(fields[MUTEXES_CREATE_LINE]->store(lock->cline, true));
 		fields[MUTEXES_CREATE_LINE]->set_notnull();
 		OK(field_store_ulint(fields[MUTEXES_OS_WAITS], (longlong)lock->count_os_wait));
+		OK(fields[MUTEXES_OS_WAIT_TIME]->store(lock->os_wait_time,
+						       true));
 		OK(schema_table_store_record(thd, tables->table));
 	}
 
@@ -9090,6 +9102,8 @@ i_s_innodb_mutexes_fill_table(
 		OK(fields[MUTEXES_CREATE_LINE]->store(block_lock->cline, true));
 		fields[MUTEXES_CREATE_LINE]->set_notnull();
 		OK(field_store_ulint(fields[MUTEXES_OS_WAITS], (longlong)block_lock_oswait_count));
+		OK(fields[MUTEXES_OS_WAIT_TIME]->store(block_lock_oswait_time,
+						       true));
 		OK(schema_table_store_record(thd, tables->table));
 	}
 
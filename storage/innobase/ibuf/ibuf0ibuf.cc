@@ -53,6 +53,7 @@ my_bool	srv_ibuf_disable_background_merge;
 #include "log0recv.h"
 #include "que0que.h"
 #include "srv0start.h" /* srv_shutdown_state */
+#include "srv0mon.h"
 #include "rem0cmp.h"
 
 /*	STRUCTURE OF AN INSERT BUFFER RECORD
@@ -2668,6 +2669,39 @@ ibuf_contract(
 	return(ibuf_merge_pages(&n_pages, sync));
 }
 
+/** Determine how much of innodb_io_capacity was left unused by page
+reads and writes since the previous call. This is only invoked by the
+master thread, about once per second.
+@return number of page reads that can be spent on change buffer merge */
+static
+ulint
+ibuf_merge_spare_io()
+{
+	static ulint	last_n_io;
+	static ulint	last_time_ms;
+	buf_pool_stat_t	stat;
+
+	buf_get_total_stat(&stat);
+
+	const ulint	n_io = stat.n_pages_read + stat.n_pages_written;
+	const ulint	now = ut_time_ms();
+	const ulint	elapsed = std::min(now - last_time_ms, ulint(1000));
+	const ulint	used = n_io - last_n_io;
+	const bool	first = !last_time_ms;
+
+	last_n_io = n_io;
+	last_time_ms = now;
+
+	if (first) {
+		return(0);
+	}
+
+	const ulint	budget = srv_io_capacity * elapsed / 1000;
+
+	/* Leave half of the spare capacity for the foreground. */
+	return(budget > used ? (budget - used) / 2 : 0);
+}
+
 /** Contract the change buffer by reading pages to the buffer pool.
 @param[in]	full		If true, do a full contraction based
 on PCT_IO(100). If false, the size of contract batch is determined
@@ -2694,8 +2728,13 @@ ibuf_merge_in_background(
 		/* Caller has requested a full batch */
 		n_pages = PCT_IO(100);
 	} else {
-		/* By default we do a batch of 5% of the io_capacity */
-		n_pages = PCT_IO(5);
+		/* By default we do a batch of 5% of the io_capacity,
+		plus whatever was left unused of it during the last
+		second. Otherwise, after a write burst the change buffer
+		would only drain at 5% of the io_capacity until the
+		server becomes completely idle, and the merges would be
+		left to the reads of user threads. */
+		n_pages = PCT_IO(5) + ibuf_merge_spare_io();
 
 		mutex_enter(&ibuf_mutex);
 
@@ -2728,6 +2767,7 @@ ibuf_merge_in_background(
 
 		sum_bytes += n_bytes;
 		sum_pages += n_pag2;
+		MONITOR_INC_VALUE(MONITOR_IBUF_BACKGROUND_MERGE_PAGES, n_pag2);
 	}
 
 	return(sum_bytes);
@@ -393,6 +393,12 @@ btr_free(
 	const page_id_t		page_id,
 	const page_size_t&	page_size);
 
+/** Empty an index tree, keeping only an empty root page.
+This is used in the rollback of TRX_UNDO_EMPTY.
+@param[in,out]	index	index tree */
+void
+btr_clear(dict_index_t* index);
+
 /** Read the last used AUTO_INCREMENT value from PAGE_ROOT_AUTO_INC.
 @param[in,out]	index	clustered index
 @return	the last used AUTO_INCREMENT value
@@ -529,6 +529,13 @@ struct btr_pcur_t{
 	/** the transaction, if we know it; otherwise this field is not defined;
 	can ONLY BE USED in error prints in fatal assertion failures! */
 	trx_t*		trx_if_known;
+	/** whether the pages that were only read for this cursor should
+	be moved to the end of the LRU list when the cursor leaves them
+	(innodb_scan_no_cache) */
+	bool		scan_no_cache;
+	/** whether scan_no_cache holds and the page where the cursor
+	is positioned was only read for this cursor */
+	bool		block_read_by_scan;
 	/*-----------------------------*/
 	/* NOTE that the following fields may possess dynamically allocated
 	memory which should be freed if not needed anymore! */
@@ -545,6 +552,7 @@ struct btr_pcur_t{
 		modify_clock(0), withdraw_clock(0),
 		pos_state(BTR_PCUR_NOT_POSITIONED),
 		search_mode(PAGE_CUR_UNSUPP), trx_if_known(NULL),
+		scan_no_cache(false), block_read_by_scan(false),
 		old_rec_buf(NULL), buf_size(0)
 	{
 		btr_cur.init();
@@ -309,6 +309,14 @@ buf_pool_init(
 /*=========*/
 	ulint	size,		/*!< in: Size of the total pool in bytes */
 	ulint	n_instances);	/*!< in: Number of instances */
+#ifdef HAVE_LIBNUMA
+/** Determine the NUMA node that a buffer pool instance or a page cleaner
+thread is bound to when innodb_numa_bind is in effect.
+@param[in]	n	buffer pool instance or page cleaner thread number
+@return NUMA node number
+@retval -1 if innodb_numa_bind is not in effect */
+int buf_numa_node(ulint n);
+#endif /* HAVE_LIBNUMA */
 /********************************************************************//**
 Frees the buffer pool at shutdown.  This must not be invoked before
 freeing all mutexes. */
@@ -557,6 +565,11 @@ void
 buf_page_make_young(
 /*================*/
 	buf_page_t*	bpage);	/*!< in: buffer block of a file page */
+/** Move a page to the end of the buffer pool LRU list, so that it will
+be evicted first. This can be used for pages that were read only once,
+so that they do not replace more useful pages in the buffer pool.
+@param[in,out]	bpage	buffer block of a file page */
+void buf_page_make_old(buf_page_t* bpage);
 
 /** Returns TRUE if the page can be found in the buffer pool hash table.
 NOTE that it is possible that the page is not yet read from disk,
@@ -565,6 +578,12 @@ though.
 @return TRUE if found in the page hash table */
 inline bool buf_page_peek(const page_id_t page_id);
 
+/** Determine if a page has not been accessed in the buffer pool yet.
+@param[in]	page_id	page id
+@return whether the page is not in the buffer pool, or it was read
+ahead and it has not been accessed */
+inline bool buf_page_peek_unaccessed(const page_id_t page_id);
+
 #ifdef UNIV_DEBUG
 
 /** Sets file_page_was_freed TRUE if the page is found in the buffer pool.
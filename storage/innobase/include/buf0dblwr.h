@@ -105,9 +105,11 @@ Flushes possible buffered writes from the doublewrite memory buffer to disk,
 and also wakes up the aio thread if simulated aio is used. It is very
 important to call this function after a batch of writes has been posted,
 and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
+of threads can occur.
+@param[in]	instance_no	buffer pool instance whose doublewrite
+batch partition to flush, or ULINT_UNDEFINED to flush all partitions */
 void
-buf_dblwr_flush_buffered_writes();
+buf_dblwr_flush_buffered_writes(ulint instance_no = ULINT_UNDEFINED);
 
 /********************************************************************//**
 Writes a page to the doublewrite buffer on disk, sync it, then write
@@ -123,21 +125,39 @@ buf_dblwr_write_single_page(
 	buf_page_t*	bpage,	/*!< in: buffer block to write */
 	bool		sync);	/*!< in: true if sync IO requested */
 
-/** Doublewrite control struct */
-struct buf_dblwr_t{
-	ib_mutex_t	mutex;	/*!< mutex protecting the first_free
-				field and write_buf */
-	ulint		block1;	/*!< the page number of the first
-				doublewrite block (64 pages) */
-	ulint		block2;	/*!< page number of the second block */
-	ulint		first_free;/*!< first free position in write_buf
-				measured in units of srv_page_size */
+/** A partition of the batch flush area of the doublewrite buffer.
+Each buffer pool instance posts its batch flushes to one partition,
+so that page cleaners serving different instances can fill and write
+their doublewrite batches concurrently. */
+struct buf_dblwr_batch_t{
+	ib_mutex_t	mutex;	/*!< mutex protecting the fields below
+				and this partition of write_buf */
+	ulint		first;	/*!< first slot of this partition in
+				write_buf and buf_block_arr */
+	ulint		size;	/*!< number of slots in this partition */
+	ulint		first_free;/*!< first free position in this
+				partition, relative to first */
 	ulint		b_reserved;/*!< number of slots currently reserved
 				for batch flush. */
 	os_event_t	b_event;/*!< event where threads wait for a
 				batch flush to end;
 				os_event_set() and os_event_reset()
-				are protected by buf_dblwr_t::mutex */
+				are protected by buf_dblwr_batch_t::mutex */
+	bool		batch_running;/*!< set to TRUE if currently a batch
+				is being written from this partition */
+};
+
+/** Doublewrite control struct */
+struct buf_dblwr_t{
+	ib_mutex_t	mutex;	/*!< mutex protecting the slots
+				reserved for single page flushes */
+	ulint		block1;	/*!< the page number of the first
+				doublewrite block (64 pages) */
+	ulint		block2;	/*!< page number of the second block */
+	ulint		n_batches;/*!< number of batch flush partitions */
+	buf_dblwr_batch_t* batches;/*!< the batch flush partitions,
+				covering the first srv_doublewrite_batch_size
+				slots */
 	ulint		s_reserved;/*!< number of slots currently
 				reserved for single page flushes. */
 	os_event_t	s_event;/*!< event where threads wait for a
@@ -145,9 +165,6 @@ struct buf_dblwr_t{
 	bool*		in_use;	/*!< flag used to indicate if a slot is
 				in use. Only used for single page
 				flushes. */
-	bool		batch_running;/*!< set to TRUE if currently a batch
-				is being written from the doublewrite
-				buffer. */
 	byte*		write_buf;/*!< write buffer used in writing to the
 				doublewrite buffer, aligned to an
 				address divisible by srv_page_size
@@ -157,6 +174,14 @@ struct buf_dblwr_t{
 	buf_page_t**	buf_block_arr;/*!< array to store pointers to
 				the buffer blocks which have been
 				cached to write_buf */
+
+	/** Determine the batch flush partition of a page.
+	@param[in]	instance_no	buffer pool instance number
+	@return the partition that the instance posts its writes to */
+	buf_dblwr_batch_t* batch(ulint instance_no) const
+	{
+		return(&batches[instance_no % n_batches]);
+	}
 };
 
 #endif
@@ -185,6 +185,9 @@ void
 buf_LRU_make_block_young(
 /*=====================*/
 	buf_page_t*	bpage);	/*!< in: control block */
+/** Move a block to the end of the LRU list.
+@param[in,out]	bpage	control block */
+void buf_LRU_make_block_old(buf_page_t* bpage);
 /**********************************************************************//**
 Updates buf_pool->LRU_old_ratio.
 @return updated old_pct */
@@ -263,6 +266,11 @@ least this many milliseconds ago.  Not protected by any mutex or latch. */
 extern uint	buf_LRU_old_threshold_ms;
 /* @} */
 
+/** Keep decompressed pages of ROW_FORMAT=COMPRESSED tables while the
+unzip_LRU list is at most this percentage of the LRU list.
+Not protected by any mutex or latch. */
+extern uint	buf_LRU_unzip_pct;
+
 /** @brief Statistics for selecting the LRU list for eviction.
 
 These statistics are not 'of' LRU but 'for' LRU.  We keep count of I/O
@@ -115,6 +115,24 @@ buf_read_ahead_linear(
 	const page_size_t&	page_size,
 	ibool			inside_ibuf);
 
+/** Applies logical read-ahead: issues asynchronous read requests for
+B-tree pages that a range scan is about to access, as found in the
+node pointers of their parent page. The caller checks whether
+innodb_logical_read_ahead or innodb_scan_no_cache is enabled.
+NOTE: the calling thread may own latches on pages: this function cannot
+end up waiting for these latches!
+@param[in]	space_id	tablespace id
+@param[in]	page_size	page size
+@param[in]	page_nos	array of page numbers to read
+@param[in]	n_stored	number of page numbers in the array
+@return number of page read requests issued */
+ulint
+buf_read_ahead_logical(
+	ulint			space_id,
+	const page_size_t&	page_size,
+	const ulint*		page_nos,
+	ulint			n_stored);
+
 /********************************************************************//**
 Issues read requests for pages which the ibuf module wants to read in, in
 order to contract the insert buffer tree. Technically, this function is like
@@ -150,6 +168,9 @@ buf_read_recv_pages(
 	const ulint*	page_nos,
 	ulint		n_stored);
 
+/** Number of pages to read ahead */
+static const ulint	BUF_READ_AHEAD_PAGES = 64;
+
 /** The size in pages of the area which the read-ahead algorithms read if
 invoked */
 #define	BUF_READ_AHEAD_AREA(b)		((b)->read_ahead_area)
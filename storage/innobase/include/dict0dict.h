@@ -1573,6 +1573,12 @@ struct dict_sys_t{
 					the log records */
 	hash_table_t*	table_hash;	/*!< hash table of the tables, based
 					on name */
+	/** Protects table_hash against concurrent modification, so that
+	dict_table_open_on_name() can look up and acquire a cached table
+	without acquiring mutex. Modifications of table_hash are
+	X-latched while holding mutex; eviction holds the X-latch while
+	checking dict_table_t::get_ref_count(). */
+	rw_lock_t	table_hash_latch;
 	/** hash table of persistent table IDs */
 	hash_table_t*	table_id_hash;
 	/** hash table of temporary table IDs */
@@ -1568,6 +1568,12 @@ struct dict_table_t {
 	@return	whether the last handle was released */
 	inline bool release();
 
+	/** Release the table handle unless it is the last one.
+	This does not require dict_sys->mutex, because the table
+	cannot be evicted while other handles exist.
+	@return	whether the handle was released */
+	inline bool release_if_not_last();
+
 	/** @return whether the table supports transactions */
 	bool no_rollback() const
 	{
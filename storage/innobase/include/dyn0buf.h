@@ -172,7 +172,6 @@ class mtr_buf_t {
 	/** Default constructor */
 	mtr_buf_t()
 		:
-		m_heap(),
 		m_size()
 	{
 		UT_LIST_INIT(m_list, &block_t::m_node);
@@ -188,9 +187,8 @@ class mtr_buf_t {
 	/** Reset the buffer vector */
 	void erase()
 	{
-		if (m_heap != NULL) {
-			mem_heap_free(m_heap);
-			m_heap = NULL;
+		if (UT_LIST_GET_LEN(m_list) > 1) {
+			release_blocks();
 
 			/* Initialise the list and add the first block. */
 			UT_LIST_INIT(m_list, &block_t::m_node);
@@ -373,7 +371,7 @@ class mtr_buf_t {
 	bool is_small() const
 		MY_ATTRIBUTE((warn_unused_result))
 	{
-		return(m_heap == NULL);
+		return(UT_LIST_GET_LEN(m_list) == 1);
 	}
 
 private:
@@ -438,27 +436,16 @@ class mtr_buf_t {
 	}
 
 	/**
-	Allocate and add a new block to m_list */
-	block_t* add_block()
-	{
-		block_t*	block;
-
-		if (m_heap == NULL) {
-			m_heap = mem_heap_create(sizeof(*block));
-		}
-
-		block = reinterpret_cast<block_t*>(
-			mem_heap_alloc(m_heap, sizeof(*block)));
+	Allocate and add a new block to m_list. The block is taken from
+	a cache of blocks released by erase() on the current thread, and
+	only allocated from the heap if the cache is empty. */
+	block_t* add_block();
 
-		push_back(block);
-
-		return(block);
-	}
+	/** Return all blocks but m_first_block to the cache of the
+	current thread, or free them if the cache is full. */
+	void release_blocks();
 
 private:
-	/** Heap to use for memory allocation */
-	mem_heap_t*		m_heap;
-
 	/** Allocated blocks */
 	block_list_t		m_list;
 
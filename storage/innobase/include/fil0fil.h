@@ -175,6 +175,12 @@ struct fil_space_t {
 	punch hole */
 	bool		punch_hole;
 
+	/** PAGE_COMPRESSION_ALGORITHM of the table (PAGE_ZLIB_ALGORITHM
+	or similar), or 0 for innodb_compression_algorithm. This is not
+	persistent; it is copied from the .frm file in
+	ha_innobase::open(). */
+	ulint		page_compression_algorithm;
+
 	ulint		magic_n;/*!< FIL_SPACE_MAGIC_N */
 
 	/** @return whether the tablespace is about to be dropped */
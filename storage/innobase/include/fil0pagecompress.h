@@ -34,12 +34,14 @@ Created 11/12/2013 Jan Lindström jan.lindstrom@skysql.com
 @param[in]	buf		page to be compressed
 @param[out]	out_buf		compressed page
 @param[in]	level		compression level
+@param[in]	algorithm	PAGE_ZLIB_ALGORITHM or similar,
+				or 0 for innodb_compression_algorithm
 @param[in]	block_size	file system block size
 @param[in]	encrypted	whether the page will be subsequently encrypted
 @return actual length of compressed page
 @retval	0	if the page was not compressed */
 ulint fil_page_compress(const byte* buf, byte* out_buf, ulint level,
-			ulint block_size, bool encrypted)
+			ulint algorithm, ulint block_size, bool encrypted)
 	MY_ATTRIBUTE((nonnull, warn_unused_result));
 
 /** Decompress a page that may be subject to page_compressed compression.
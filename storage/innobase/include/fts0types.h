@@ -128,6 +128,9 @@ struct fts_sync_t {
 	bool		in_progress;	/*!< flag whether sync is in progress.*/
 	bool		unlock_cache;	/*!< flag whether unlock cache when
 					write fts node */
+	ulint		unlock_max_size;/*!< stop releasing the cache lock
+					when the cache grows beyond this
+					many bytes during the sync */
 	os_event_t	event;		/*!< sync finish event;
 					only os_event_set() and os_event_wait()
 					are used */
@@ -309,6 +309,13 @@ thd_lock_wait_timeout(
 /*==================*/
 	THD*	thd);	/*!< in: thread handle, or NULL to query
 			the global innodb_lock_wait_timeout */
+
+/** Determine if scans should avoid polluting the buffer pool.
+@param[in]	thd	thread handle, or NULL to query
+			the global innodb_scan_no_cache
+@return the value of innodb_scan_no_cache */
+bool
+thd_scan_no_cache(THD* thd);
 /** Get status of innodb_tmpdir.
 @param[in]	thd	thread handle, or NULL to query
 			the global innodb_tmpdir.
@@ -101,12 +101,22 @@ log_reserve_and_open(
 	ulint	len);
 /************************************************************//**
 Writes to the log the string given. It is assumed that the caller holds the
-log mutex. */
+log mutex. If str is NULL, only the space is reserved (and the log block
+headers are updated); the payload must then be written by
+log_write_reserved() before log_sys.n_pending_copies is decremented. */
 void
 log_write_low(
 /*==========*/
-	const byte*	str,		/*!< in: string */
+	const byte*	str,		/*!< in: string, or NULL */
 	ulint		str_len);	/*!< in: string length */
+/** Copy a string to log buffer space that was reserved by
+log_write_low(NULL, len). This is invoked without holding log_sys.mutex.
+@param[in]	buf	log_sys.buf at the time of the reservation
+@param[in,out]	offset	offset within buf; advanced past the string
+@param[in]	str	string
+@param[in]	str_len	string length */
+void
+log_write_reserved(byte* buf, ulint* offset, const byte* str, ulint str_len);
 /************************************************************//**
 Closes the log.
 @return lsn */
@@ -539,6 +549,15 @@ struct log_t{
 	ulong		max_buf_free;	/*!< recommended maximum value of
 					buf_free for the buffer in use, after
 					which the buffer is flushed */
+	ulint		n_pending_copies;
+					/*!< number of mini-transactions that
+					have reserved space in buf by
+					log_write_low(NULL, len) but have not
+					finished copying their records with
+					log_write_reserved(); buf must not be
+					written or switched while this is
+					nonzero. Incremented while holding
+					mutex, decremented without it. */
 	bool		check_flush_or_checkpoint;
 					/*!< this is set when there may
 					be need to flush the log buffer, or
@@ -0,0 +1,100 @@
+/*****************************************************************************
+
+Copyright (c) 2019, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/log0online.h
+Changed page tracking for incremental backups (innodb_track_changed_pages)
+
+The identifiers of the pages that are written to the data files are
+written to bitmap files ib_modified_log_<seq>_<start_lsn>.xdb in the
+data home directory, in the format of the XtraDB changed page bitmaps,
+so that mariabackup --incremental-basedir can copy only the changed pages.
+*******************************************************/
+
+#ifndef log0online_h
+#define log0online_h
+
+#include "univ.i"
+
+class page_id_t;
+
+/** File name stem of the bitmap files */
+#define LOG_ONLINE_FILE_NAME_STEM	"ib_modified_log_"
+
+/** The bitmap file block size in bytes. All writes are multiples of it. */
+enum {
+	MODIFIED_PAGE_BLOCK_SIZE = 4096
+};
+
+/** Offsets in a bitmap file block */
+enum {
+	MODIFIED_PAGE_IS_LAST_BLOCK = 0,/* 1 if last block in the current
+					write, 0 otherwise. */
+	MODIFIED_PAGE_START_LSN = 4,	/* The starting tracked LSN of this and
+					other blocks in the same write */
+	MODIFIED_PAGE_END_LSN = 12,	/* The ending tracked LSN of this and
+					other blocks in the same write */
+	MODIFIED_PAGE_SPACE_ID = 20,	/* The space ID of tracked pages in
+					this block */
+	MODIFIED_PAGE_1ST_PAGE_ID = 24,	/* The page ID of the first tracked
+					page in this block */
+	MODIFIED_PAGE_BLOCK_UNUSED_1 = 28,/* Unused in order to align the start
+					  of bitmap at 8 byte boundary */
+	MODIFIED_PAGE_BLOCK_BITMAP = 32,/* Start of the bitmap itself */
+	MODIFIED_PAGE_BLOCK_UNUSED_2 = MODIFIED_PAGE_BLOCK_SIZE - 8,
+					/* Unused in order to align the end of
+					bitmap at 8 byte boundary */
+	MODIFIED_PAGE_BLOCK_CHECKSUM = MODIFIED_PAGE_BLOCK_SIZE - 4
+					/* The checksum of the current block */
+};
+
+/** Length of the bitmap data in a block */
+enum { MODIFIED_PAGE_BLOCK_BITMAP_LEN
+       = MODIFIED_PAGE_BLOCK_UNUSED_2 - MODIFIED_PAGE_BLOCK_BITMAP };
+
+/** Length of the bitmap data in a block in page ids */
+enum { MODIFIED_PAGE_BLOCK_ID_COUNT = MODIFIED_PAGE_BLOCK_BITMAP_LEN * 8 };
+
+/** Calculate the checksum of a bitmap block.
+@param[in]	block	bitmap block
+@return checksum */
+ulint
+log_online_calc_checksum(const byte* block);
+
+/** Start tracking the changed pages, after redo log recovery. */
+void
+log_online_init();
+
+/** Stop tracking the changed pages, at shutdown. */
+void
+log_online_close();
+
+/** Note that a page of a persistent tablespace is being written.
+@param[in]	id	page identifier
+@param[in]	lsn	newest modification of the page */
+void
+log_online_track_page(const page_id_t& id, lsn_t lsn);
+
+/** Write the pages written so far to the bitmap file, before a log
+checkpoint is written.
+@param[in]	end_lsn	LSN up to which all modified pages have been
+written, that is, the oldest modification in the buffer pool */
+void
+log_online_write(lsn_t end_lsn);
+
+#endif /* log0online_h */
@@ -211,6 +211,9 @@ struct recv_sys_t{
 				page cleaner threads */
 	os_event_t		flush_end;/*!< event to signal that the page
 				cleaner has finished the request */
+	os_event_t		apply_done;/*!< event to signal that
+				n_addrs has reached 0 in a batch of
+				log rec application */
 	buf_flush_t		flush_type;/*!< type of the flush request.
 				BUF_FLUSH_LRU: flush end of LRU, keeping free blocks.
 				BUF_FLUSH_LIST: flush all of blocks. */
@@ -232,6 +232,27 @@ class ReadView
 		return(id < m_up_limit_id);
 	}
 
+	/** Check whether the view sees all changes of transactions whose
+	identifier is at most a given one, such as PAGE_MAX_TRX_ID.
+	Unlike sees(), this takes into account that the changes of the
+	creator of the view are visible to it.
+	@param id	maximum transaction identifier
+	@return whether the view sees all modifications up to id */
+	bool sees_all_up_to(trx_id_t id) const
+	{
+		if (id < m_up_limit_id) {
+			return(true);
+		}
+
+		if (id >= m_low_limit_id || m_ids.front() != m_creator_trx_id) {
+			return(false);
+		}
+
+		/* The creator is the oldest active transaction.
+		Check that there is no other one up to id. */
+		return(m_ids.size() == 1 || m_ids[1] > id);
+	}
+
 	/**
 	Write the limits to the file.
 	@param file		file to write to */
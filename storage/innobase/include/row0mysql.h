@@ -602,7 +602,13 @@ struct mysql_row_templ_t {
 	ulint	is_virtual;		/*!< if a column is a virtual column */
 };
 
+/* Number of rows in the first batch of fetch_cache */
 #define MYSQL_FETCH_CACHE_SIZE		8
+/* Maximum number of rows in fetch_cache */
+#define MYSQL_FETCH_CACHE_MAX_SIZE	128
+/* fetch_cache is not made bigger than this many bytes, unless
+MYSQL_FETCH_CACHE_SIZE rows do not fit */
+#define MYSQL_FETCH_CACHE_MAX_BYTES	(64U << 10)
 /* After fetching this many rows, we start caching them in fetch_cache */
 #define MYSQL_FETCH_CACHE_THRESHOLD	4
 
@@ -777,7 +783,7 @@ struct row_prebuilt_t {
 	ulint		n_rows_fetched;	/*!< number of rows fetched after
 					positioning the current cursor */
 	ulint		fetch_direction;/*!< ROW_SEL_NEXT or ROW_SEL_PREV */
-	byte*		fetch_cache[MYSQL_FETCH_CACHE_SIZE];
+	byte*		fetch_cache[MYSQL_FETCH_CACHE_MAX_SIZE];
 					/*!< a cache for fetched rows if we
 					fetch many rows from the same cursor:
 					it saves CPU time to fetch them in a
@@ -795,6 +801,13 @@ struct row_prebuilt_t {
 					fetched row in fetch_cache */
 	ulint		n_fetch_cached;	/*!< number of not yet fetched rows
 					in fetch_cache */
+	ulint		n_fetch_cache_alloc;/*!< number of allocated rows
+					in fetch_cache */
+	ulint		fetch_cache_batch;/*!< number of rows to fetch to
+					fetch_cache at a time; doubled after
+					each full batch while the cursor
+					keeps fetching, up to
+					n_fetch_cache_alloc */
 	mem_heap_t*	blob_heap;	/*!< in SELECTS BLOB fields are copied
 					to this heap */
 	mem_heap_t*	old_vers_heap;	/*!< memory heap where a previous
@@ -52,6 +52,13 @@ we could get a deadlock. Value of 0 will disable the concurrency check. */
 extern ulong	srv_thread_concurrency;
 
 struct row_prebuilt_t;
+
+/** Initialize the concurrency manager. */
+void srv_conc_init();
+
+/** Free the concurrency manager. */
+void srv_conc_close();
+
 /*********************************************************************//**
 Puts an OS thread to wait if there are too many concurrent threads
 (>= srv_thread_concurrency) inside InnoDB. The threads wait in a FIFO queue.
@@ -78,6 +85,10 @@ srv_conc_force_exit_innodb(
 	trx_t*	trx);		/*!< in: transaction object associated with
 				the thread */
 
+/** Wake up waiting threads after innodb_thread_concurrency was changed. */
+void
+srv_conc_update_concurrency();
+
 /*********************************************************************//**
 Get the count of threads waiting inside InnoDB. */
 ulint
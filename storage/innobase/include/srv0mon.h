@@ -332,6 +332,7 @@ enum monitor_id_t {
 	MONITOR_OVLD_LOG_WRITE_REQUEST,
 	MONITOR_OVLD_LOG_WRITES,
 	MONITOR_OVLD_LOG_PADDED,
+	MONITOR_MTR_BUF_BLOCK_ALLOC,
 
 	/* Page Manager related counters */
 	MONITOR_MODULE_PAGE,
@@ -372,6 +373,8 @@ enum monitor_id_t {
 	MONITOR_ADAPTIVE_HASH_ROW_REMOVED,
 	MONITOR_ADAPTIVE_HASH_ROW_REMOVE_NOT_FOUND,
 	MONITOR_ADAPTIVE_HASH_ROW_UPDATED,
+	MONITOR_ADAPTIVE_HASH_BUILD_MICROSECOND,
+	MONITOR_ADAPTIVE_HASH_DROP_MICROSECOND,
 #endif /* BTR_CUR_HASH_ADAPT */
 
 	/* Tablespace related counters */
@@ -388,6 +391,8 @@ enum monitor_id_t {
 	MONITOR_OVLD_IBUF_MERGE_DISCARD_PURGE,
 	MONITOR_OVLD_IBUF_MERGES,
 	MONITOR_OVLD_IBUF_SIZE,
+	MONITOR_OVLD_IBUF_MAX_SIZE,
+	MONITOR_IBUF_BACKGROUND_MERGE_PAGES,
 
 	/* Counters for server operations */
 	MONITOR_MODULE_SERVER,
@@ -263,6 +263,9 @@ extern ibool	srv_locks_unsafe_for_binlog;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** innodb_index_build_threads: maximum number of threads for
+sorting and loading secondary indexes in index creation */
+extern ulong	srv_index_build_threads;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -271,7 +274,13 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
+/** innodb_use_io_uring: whether to use io_uring instead of libaio
+for the Linux native AIO */
+extern my_bool	srv_use_io_uring;
 extern my_bool	srv_numa_interleave;
+/** innodb_numa_bind: whether to bind each buffer pool instance
+and page cleaner thread to a NUMA node */
+extern my_bool	srv_numa_bind;
 
 /* Use atomic writes i.e disable doublewrite buffer */
 extern my_bool srv_use_atomic_writes;
@@ -344,6 +353,12 @@ extern ulong	srv_log_buffer_size;
 extern ulong	srv_flush_log_at_trx_commit;
 extern uint	srv_flush_log_at_timeout;
 extern ulong	srv_log_write_ahead_size;
+/** innodb_log_concurrent_copy: whether mini-transaction commit copies
+redo log records to log_sys.buf without holding log_sys.mutex */
+extern my_bool	srv_log_concurrent_copy;
+/** innodb_log_flush_spin_rounds: how many times to poll for a pending
+redo log flush to complete before suspending the waiting thread */
+extern ulong	srv_log_flush_spin_rounds;
 extern my_bool	srv_adaptive_flushing;
 extern my_bool	srv_flush_sync;
 
@@ -393,9 +408,13 @@ extern ulint	srv_lock_table_size;
 
 extern ulint	srv_n_file_io_threads;
 extern my_bool	srv_random_read_ahead;
+/** innodb_logical_read_ahead */
+extern my_bool	srv_logical_read_ahead;
 extern ulong	srv_read_ahead_threshold;
 extern ulong	srv_n_read_io_threads;
 extern ulong	srv_n_write_io_threads;
+/** innodb_track_changed_pages */
+extern my_bool	srv_track_changed_pages;
 
 /* Defragmentation, Origianlly facebook default value is 100, but it's too high */
 #define SRV_DEFRAGMENT_FREQUENCY_DEFAULT 40
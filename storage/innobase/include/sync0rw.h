@@ -618,6 +618,9 @@ struct rw_lock_t
 	/** Count of os_waits. May not be accurate */
 	uint32_t	count_os_wait;
 
+	/** Microseconds spent in os_waits. May not be accurate */
+	uint64_t	os_wait_time;
+
 	/** All allocated rw locks are put into a list */
 	UT_LIST_NODE_T(rw_lock_t) list;
 
@@ -352,6 +352,7 @@ enum latch_id_t {
 	LATCH_ID_BUF_BLOCK_LOCK,
 	LATCH_ID_BUF_BLOCK_DEBUG,
 	LATCH_ID_DICT_OPERATION,
+	LATCH_ID_DICT_TABLE_HASH,
 	LATCH_ID_CHECKPOINT,
 	LATCH_ID_FIL_SPACE,
 	LATCH_ID_FTS_CACHE,
@@ -367,6 +368,8 @@ enum latch_id_t {
 	LATCH_ID_SCRUB_STAT_MUTEX,
 	LATCH_ID_DEFRAGMENT_MUTEX,
 	LATCH_ID_BTR_DEFRAGMENT_MUTEX,
+	LATCH_ID_LOG_ONLINE,
+	LATCH_ID_LOG_ONLINE_WRITE,
 	LATCH_ID_FIL_CRYPT_MUTEX,
 	LATCH_ID_FIL_CRYPT_STAT_MUTEX,
 	LATCH_ID_FIL_CRYPT_DATA_MUTEX,
@@ -1164,6 +1167,15 @@ static inline void my_atomic_storelint(ulint *A, ulint B)
 #endif
 }
 
+static inline bool my_atomic_caslint(ulint *A, ulint *B, ulint C)
+{
+#ifdef _WIN64
+  return my_atomic_cas64((int64*)A, (int64*)B, C);
+#else
+  return my_atomic_caslong(A, B, C);
+#endif
+}
+
 /** Simple non-atomic counter aligned to CACHE_LINE_SIZE
 @tparam	Type	the integer type of the counter */
 template <typename Type>
@@ -215,6 +215,9 @@ class purge_sys_t
 					TrxUndoRsegs::trx_no. It is protected
 					by the pq_mutex */
 	PQMutex		pq_mutex;	/*!< Mutex protecting purge_queue */
+	/** Number of rollback segments with trx_rseg_t::purge_pending
+	set; protected by my_atomic */
+	MY_ALIGNED(CACHE_LINE_SIZE) int32_t n_pending;
 
 	/** Undo tablespace file truncation (only accessed by the
 	srv_purge_coordinator_thread) */
@@ -277,6 +280,21 @@ class purge_sys_t
     my_atomic_store32_explicit(&m_enabled, false, MY_MEMORY_ORDER_RELAXED);
   }
 
+  /** Submit a rollback segment whose history list was empty to the
+  purge queue, without acquiring pq_mutex.
+  @param rseg    rollback segment
+  @param trx_no  trx_t::no of the committing transaction */
+  void enqueue(trx_rseg_t &rseg, trx_id_t trx_no)
+  {
+    ut_ad(mutex_own(&rseg.mutex));
+    ut_ad(!my_atomic_load64(reinterpret_cast<int64*>(&rseg.purge_pending)));
+    my_atomic_store64(reinterpret_cast<int64*>(&rseg.purge_pending),
+                      int64(trx_no));
+    my_atomic_add32(&n_pending, 1);
+  }
+  /** Move the submissions of enqueue() to purge_queue. */
+  void drain_pending();
+
   /** @return whether the purge coordinator thread is active */
   bool running();
   /** Stop purge during FLUSH TABLES FOR EXPORT */
@@ -64,6 +64,13 @@ trx_undo_rec_get_undo_no(
 /*=====================*/
 	const trx_undo_rec_t*	undo_rec);	/*!< in: undo log record */
 
+/** Read the table identifier from an undo log record.
+@param[in]	undo_rec	undo log record
+@return table identifier */
+UNIV_INLINE
+table_id_t
+trx_undo_rec_get_table_id(const trx_undo_rec_t* undo_rec);
+
 /**********************************************************************//**
 Returns the start of the undo record data area. */
 #define trx_undo_rec_get_ptr(undo_rec, undo_no)		\
@@ -169,6 +176,14 @@ trx_undo_rec_get_partial_row(
 @return	DB_SUCCESS or error code */
 dberr_t trx_undo_report_rename(trx_t* trx, const dict_table_t* table)
 	MY_ATTRIBUTE((nonnull, warn_unused_result));
+/** Report that an empty table is about to be bulk loaded without
+undo logging for the individual rows. On rollback, the table will be
+emptied again.
+@param[in,out]	trx	transaction
+@param[in,out]	table	empty table that the transaction locked in X mode
+@return	DB_SUCCESS or error code */
+dberr_t trx_undo_report_empty(trx_t* trx, dict_table_t* table)
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
 /***********************************************************************//**
 Writes information to an undo log about an insert, update, or a delete marking
 of a clustered index record. This information is used in a rollback of the
@@ -320,6 +335,8 @@ record */
 					fields of the record can change */
 #define	TRX_UNDO_DEL_MARK_REC	14	/* delete marking of a record; fields
 					do not change */
+#define	TRX_UNDO_EMPTY		15	/*!< bulk insert into an empty
+					table; rollback empties the table */
 #define	TRX_UNDO_CMPL_INFO_MULT	16U	/* compilation info is multiplied by
 					this and ORed to the type above */
 #define	TRX_UNDO_UPD_EXTERN	128U	/* This bit can be ORed to type_cmpl
@@ -165,6 +165,12 @@ struct trx_rseg_t {
 	/** Whether the log segment needs purge */
 	bool				needs_purge;
 
+	/** trx_t::no of a transaction that added an undo log to the
+	empty history list, not yet moved to purge_sys.purge_queue;
+	0 if none. Protected by my_atomic, not by mutex.
+	@see purge_sys_t::enqueue() */
+	trx_id_t			purge_pending;
+
 	/** Reference counter to track rseg allocated transactions. */
 	ulint				trx_ref_count;
 
@@ -811,6 +811,21 @@ class trx_sys_t
   */
   MY_ALIGNED(CACHE_LINE_SIZE) int32 rseg_history_len;
 
+  /**
+    Latch protecting the cached snapshot below. It is only ever acquired
+    with snapshot_cache_try_lock(), never waited for.
+  */
+  MY_ALIGNED(CACHE_LINE_SIZE) int32 m_snapshot_cache_latch;
+
+  /** m_rw_trx_hash_version of the cached snapshot, or 0 if none */
+  trx_id_t m_snapshot_cache_id;
+
+  /** min(trx->no) of the cached snapshot */
+  trx_id_t m_snapshot_cache_no;
+
+  /** Sorted transaction identifiers of the cached snapshot */
+  trx_ids_t m_snapshot_cache_ids;
+
   bool m_initialised;
 
 public:
@@ -956,6 +971,16 @@ class trx_sys_t
     of rw_trx_hash.iterate_no_dups(). It means that some transaction
     identifiers may appear multiple times in ids.
 
+    The identifiers are returned sorted. The last snapshot is cached, and it
+    is reused without iterating rw_trx_hash as long as
+    m_rw_trx_hash_version has not changed, that is, no transaction has been
+    registered or assigned a serialisation number since it was taken.
+    Transactions that were deregistered without a serialisation number in
+    the meantime (rolled back, or not modifying persistent tables) remain in
+    the cached snapshot, which makes it slightly pessimistic, but not wrong:
+    such transactions have nothing to be seen. If the cache is busy, we
+    simply take the snapshot the slow way.
+
     @param[in,out] caller_trx used to get access to rw_trx_hash_pins
     @param[out]    ids        array to store registered transaction identifiers
     @param[out]    max_trx_id variable to store m_max_trx_id value
@@ -972,11 +997,37 @@ class trx_sys_t
       ut_delay(1);
     arg.m_no= arg.m_id;
 
+    if (snapshot_cache_try_lock())
+    {
+      bool hit= m_snapshot_cache_id == arg.m_id;
+      if (hit)
+      {
+        ids->assign(m_snapshot_cache_ids.begin(), m_snapshot_cache_ids.end());
+        arg.m_no= m_snapshot_cache_no;
+      }
+      snapshot_cache_unlock();
+      if (hit)
+      {
+        *max_trx_id= arg.m_id;
+        *min_trx_no= arg.m_no;
+        return;
+      }
+    }
+
     ids->clear();
     ids->reserve(rw_trx_hash.size() + 32);
     rw_trx_hash.iterate(caller_trx,
                         reinterpret_cast<my_hash_walk_action>(copy_one_id),
                         &arg);
+    std::sort(ids->begin(), ids->end());
+
+    if (snapshot_cache_try_lock())
+    {
+      m_snapshot_cache_ids.assign(ids->begin(), ids->end());
+      m_snapshot_cache_no= arg.m_no;
+      m_snapshot_cache_id= arg.m_id;
+      snapshot_cache_unlock();
+    }
 
     *max_trx_id= arg.m_id;
     *min_trx_no= arg.m_no;
@@ -1149,6 +1200,27 @@ class trx_sys_t
   };
 
 
+  /**
+    Try to acquire the latch protecting the cached snapshot.
+    @return whether the latch was acquired
+  */
+  bool snapshot_cache_try_lock()
+  {
+    int32 unlocked= 0;
+    return my_atomic_load32_explicit(&m_snapshot_cache_latch,
+                                     MY_MEMORY_ORDER_RELAXED) == 0 &&
+           my_atomic_cas32(&m_snapshot_cache_latch, &unlocked, 1);
+  }
+
+
+  /** Release the latch protecting the cached snapshot. */
+  void snapshot_cache_unlock()
+  {
+    my_atomic_store32_explicit(&m_snapshot_cache_latch, 0,
+                               MY_MEMORY_ORDER_RELEASE);
+  }
+
+
   static my_bool copy_one_id(rw_trx_hash_element_t *element,
                              snapshot_ids_arg *arg)
   {
@@ -594,6 +594,12 @@ struct trx_lock_t {
 	/** Next available table_pool[] entry */
 	unsigned	table_cached;
 
+	/** The record lock that lock_rec_lock() most recently granted or
+	extended for this transaction, or NULL. Written and read only by
+	the thread that is serving the transaction; the lock object stays
+	allocated until lock_trx_release_locks() resets this. */
+	const lock_t*	last_rec_lock;
+
 	mem_heap_t*	lock_heap;	/*!< memory heap for trx_locks;
 					protected by lock_sys.mutex */
 
@@ -629,6 +635,9 @@ class trx_mod_table_time_t
 	undo_no_t	first;
 	/** First modification of a system versioned column */
 	undo_no_t	first_versioned;
+	/** Whether the current statement is inserting into the table
+	without undo logging, after writing TRX_UNDO_EMPTY */
+	bool		bulk;
 
 	/** Magic value signifying that a system versioned column of a
 	table was never modified in a transaction. */
@@ -638,7 +647,7 @@ class trx_mod_table_time_t
 	/** Constructor
 	@param[in]	rows	number of modified rows so far */
 	trx_mod_table_time_t(undo_no_t rows)
-		: first(rows), first_versioned(UNVERSIONED) {}
+		: first(rows), first_versioned(UNVERSIONED), bulk(false) {}
 
 #ifdef UNIV_DEBUG
 	/** Validation
@@ -661,6 +670,15 @@ class trx_mod_table_time_t
 		ut_ad(valid());
 	}
 
+	/** @return whether rows are being inserted without undo logging */
+	bool is_bulk_insert() const { return bulk; }
+
+	/** Start inserting rows without undo logging into an empty table */
+	void start_bulk_insert() { bulk = true; }
+
+	/** End the bulk insert at the end of the statement */
+	void end_bulk_insert() { bulk = false; }
+
 	/** Invoked after partial rollback
 	@param[in]	limit	number of surviving modified rows
 	@return	whether this should be erased from trx_t::mod_tables */
@@ -902,6 +920,9 @@ struct trx_t {
 					for secondary indexes when we decide
 					if we can use the insert buffer for
 					them, we set this FALSE */
+	bool		bulk_insert;	/*!< whether some table in
+					mod_tables is_bulk_insert() in
+					the current SQL statement */
 	bool		flush_log_later;/* In 2PC, we hold the
 					prepare_commit mutex across
 					both phases. In that case, we
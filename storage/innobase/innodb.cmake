@@ -19,6 +19,7 @@
 INCLUDE(CheckFunctionExists)
 INCLUDE(CheckCSourceCompiles)
 INCLUDE(CheckCSourceRuns)
+INCLUDE(CheckSymbolExists)
 INCLUDE(lz4.cmake)
 INCLUDE(lzo.cmake)
 INCLUDE(lzma.cmake)
@@ -61,6 +62,12 @@ IF(UNIX)
     IF(HAVE_LIBAIO_H AND HAVE_LIBAIO)
       ADD_DEFINITIONS(-DLINUX_NATIVE_AIO=1)
       LINK_LIBRARIES(aio)
+      CHECK_INCLUDE_FILES (linux/io_uring.h HAVE_LINUX_IO_URING_H)
+      CHECK_SYMBOL_EXISTS(__NR_io_uring_setup "sys/syscall.h"
+                          HAVE_NR_IO_URING_SETUP)
+      IF(HAVE_LINUX_IO_URING_H AND HAVE_NR_IO_URING_SETUP)
+        ADD_DEFINITIONS(-DLINUX_IO_URING=1)
+      ENDIF()
     ENDIF()
     IF(HAVE_LIBNUMA)
       LINK_LIBRARIES(numa)
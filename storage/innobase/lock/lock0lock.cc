@@ -443,7 +443,7 @@ lock_sec_rec_cons_read_sees(
 
 	ut_ad(max_trx_id > 0);
 
-	return(view->sees(max_trx_id));
+	return(view->sees_all_up_to(max_trx_id));
 }
 
 
@@ -1915,6 +1915,50 @@ lock_rec_add_to_queue(
 		type_mode, block, heap_no, index, trx, caller_owns_trx_mutex);
 }
 
+/** Check without acquiring lock_sys.mutex whether the record lock that
+lock_rec_lock() most recently granted to a transaction already covers
+a request. This avoids the lock_sys.mutex round trip when a record that
+was locked by a search is locked again for modification.
+
+The lock object belongs to trx, and the caller holds the page latch, so
+the bits of this page cannot be reset or moved by other threads while we
+are looking at them; other threads may set bits concurrently, but that
+can only lead us to miss, and fall back to lock_rec_has_expl().
+@param[in]	precise_mode	LOCK_S or LOCK_X possibly ORed to
+				LOCK_GAP or LOCK_REC_NOT_GAP
+@param[in]	block		buffer block containing the record
+@param[in]	heap_no		heap number of the record
+@param[in]	trx		transaction
+@return whether trx already holds a strong enough lock on the record */
+static
+bool
+lock_rec_has_expl_last(
+	ulint			precise_mode,
+	const buf_block_t*	block,
+	ulint			heap_no,
+	const trx_t*		trx)
+{
+	const lock_t*	lock = trx->lock.last_rec_lock;
+
+	ut_ad(!(precise_mode & LOCK_INSERT_INTENTION));
+
+	return(lock
+	       && lock->un_member.rec_lock.page_no == block->page.id.page_no()
+	       && lock->un_member.rec_lock.space == block->page.id.space()
+	       && lock_rec_get_nth_bit(lock, heap_no)
+	       && !lock_rec_get_insert_intention(lock)
+	       && lock_mode_stronger_or_eq(
+		       lock_get_mode(lock),
+		       static_cast<lock_mode>(precise_mode & LOCK_MODE_MASK))
+	       && !lock_get_wait(lock)
+	       && (!lock_rec_get_rec_not_gap(lock)
+		   || (precise_mode & LOCK_REC_NOT_GAP)
+		   || heap_no == PAGE_HEAP_NO_SUPREMUM)
+	       && (!lock_rec_get_gap(lock)
+		   || (precise_mode & LOCK_GAP)
+		   || heap_no == PAGE_HEAP_NO_SUPREMUM));
+}
+
 /*********************************************************************//**
 Tries to lock the specified record in the mode requested. If not immediately
 possible, enqueues a waiting lock request. This is a low-level function
@@ -1951,6 +1995,13 @@ lock_rec_lock(
   ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
   DBUG_EXECUTE_IF("innodb_report_deadlock", return DB_DEADLOCK;);
 
+  if (lock_rec_has_expl_last(mode, block, heap_no, trx))
+  {
+    /* The trx already has a strong enough lock on rec. */
+    MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
+    return DB_SUCCESS;
+  }
+
   lock_mutex_enter();
   ut_ad((LOCK_MODE_MASK & mode) != LOCK_S ||
         lock_table_has(trx, index->table, LOCK_IS));
@@ -1966,7 +2017,9 @@ lock_rec_lock(
         lock_rec_get_n_bits(lock) <= heap_no)
     {
       /* Do nothing if the trx already has a strong enough lock on rec */
-      if (!lock_rec_has_expl(mode, block, heap_no, trx))
+      if (const lock_t *expl= lock_rec_has_expl(mode, block, heap_no, trx))
+        trx->lock.last_rec_lock= expl;
+      else
       {
         if (
 #ifdef WITH_WSREP
@@ -2005,6 +2058,7 @@ lock_rec_lock(
         lock_rec_set_nth_bit(lock, heap_no);
         err= DB_SUCCESS_LOCKED_REC;
       }
+      trx->lock.last_rec_lock= lock;
     }
     trx_mutex_exit(trx);
   }
@@ -2015,7 +2069,7 @@ lock_rec_lock(
       Note that we don't own the trx mutex.
     */
     if (!impl)
-      lock_rec_create(
+      trx->lock.last_rec_lock= lock_rec_create(
 #ifdef WITH_WSREP
          NULL, NULL,
 #endif
@@ -3947,17 +4001,17 @@ lock_table(
 	return(err);
 }
 
-/*********************************************************************//**
-Creates a table IX lock object for a resurrected transaction. */
+/** Create a table lock object for a resurrected transaction.
+@param[in,out]	table	table
+@param[in,out]	trx	recovered transaction
+@param[in]	mode	LOCK_IX, or LOCK_X if TRX_UNDO_EMPTY was written */
 void
-lock_table_ix_resurrect(
-/*====================*/
-	dict_table_t*	table,	/*!< in/out: table */
-	trx_t*		trx)	/*!< in/out: transaction */
+lock_table_resurrect(dict_table_t* table, trx_t* trx, lock_mode mode)
 {
 	ut_ad(trx->is_recovered);
+	ut_ad(mode == LOCK_IX || mode == LOCK_X);
 
-	if (lock_table_has(trx, table, LOCK_IX)) {
+	if (lock_table_has(trx, table, mode)) {
 		return;
 	}
 
@@ -3967,10 +4021,10 @@ lock_table_ix_resurrect(
 	other transactions have in the table lock queue. */
 
 	ut_ad(!lock_table_other_has_incompatible(
-		      trx, LOCK_WAIT, table, LOCK_IX));
+		      trx, LOCK_WAIT, table, mode));
 
 	trx_mutex_enter(trx);
-	lock_table_create(table, LOCK_IX, trx);
+	lock_table_create(table, mode, trx);
 	lock_mutex_exit();
 	trx_mutex_exit(trx);
 }
@@ -6349,6 +6403,7 @@ lock_trx_release_locks(
 	}
 
 	trx->lock.n_rec_locks = 0;
+	trx->lock.last_rec_lock = NULL;
 
 	/* We don't remove the locks one by one from the vector for
 	efficiency reasons. We simply reset it because we would have
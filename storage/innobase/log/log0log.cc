@@ -37,6 +37,7 @@ Created 12/9/1995 Heikki Tuuri
 
 #include "log0log.h"
 #include "log0crypt.h"
+#include "log0online.h"
 #include "mem0mem.h"
 #include "buf0buf.h"
 #include "buf0flu.h"
@@ -157,6 +158,26 @@ log_buf_pool_get_oldest_modification(void)
 	return(lsn);
 }
 
+/** Wait until all mini-transactions that reserved log buffer space
+with log_write_low(NULL, len) have copied their records, so that the
+contents of log_sys.buf up to log_sys.buf_free can be written out.
+No new reservations can be made while the caller holds log_sys.mutex. */
+static
+void
+log_wait_for_pending_copies()
+{
+	ut_ad(log_mutex_own());
+
+	for (ulint i = 0; my_atomic_loadlint(&log_sys.n_pending_copies);
+	     i++) {
+		if (i < srv_n_spin_wait_rounds) {
+			ut_delay(srv_spin_wait_delay);
+		} else {
+			os_thread_yield();
+		}
+	}
+}
+
 /** Extends the log buffer.
 @param[in]	len	requested minimum size in bytes */
 void log_buffer_extend(ulong len)
@@ -205,6 +226,8 @@ void log_buffer_extend(ulong len)
 		log_mutex_enter_all();
 	}
 
+	log_wait_for_pending_copies();
+
 	ulong move_start = ut_calc_align_down(
 		log_sys.buf_free,
 		OS_FILE_LOG_BLOCK_SIZE);
@@ -421,10 +444,12 @@ log_write_low(
 			- log_sys.buf_free % OS_FILE_LOG_BLOCK_SIZE;
 	}
 
-	memcpy(log_sys.buf + log_sys.buf_free, str, len);
+	if (str) {
+		memcpy(log_sys.buf + log_sys.buf_free, str, len);
+		str += len;
+	}
 
 	str_len -= len;
-	str = str + len;
 
 	byte* log_block = static_cast<byte*>(
 		ut_align_down(log_sys.buf + log_sys.buf_free,
@@ -459,6 +484,36 @@ log_write_low(
 	srv_stats.log_write_requests.inc();
 }
 
+/** Copy a string to log buffer space that was reserved by
+log_write_low(NULL, len). This is invoked without holding log_sys.mutex.
+@param[in]	buf	log_sys.buf at the time of the reservation
+@param[in,out]	offset	offset within buf; advanced past the string
+@param[in]	str	string
+@param[in]	str_len	string length */
+void
+log_write_reserved(byte* buf, ulint* offset, const byte* str, ulint str_len)
+{
+	ut_ad(my_atomic_loadlint(&log_sys.n_pending_copies) > 0);
+	const ulint trailer_offset = log_sys.trailer_offset();
+
+	while (str_len > 0) {
+		ulint	len = std::min(str_len, trailer_offset
+				       - *offset % OS_FILE_LOG_BLOCK_SIZE);
+
+		memcpy(buf + *offset, str, len);
+		str += len;
+		str_len -= len;
+		*offset += len;
+
+		if (*offset % OS_FILE_LOG_BLOCK_SIZE == trailer_offset) {
+			/* Skip the trailer of this block and the header
+			of the next block, which were written by
+			log_write_low(NULL, len). */
+			*offset += log_sys.framing_size();
+		}
+	}
+}
+
 /************************************************************//**
 Closes the log.
 @return lsn */
@@ -613,6 +668,7 @@ void log_t::create()
 
   max_buf_free= srv_log_buffer_size / LOG_BUF_FLUSH_RATIO -
     LOG_BUF_FLUSH_MARGIN;
+  n_pending_copies= 0;
   check_flush_or_checkpoint= true;
 
   n_log_ios_old= n_log_ios;
@@ -930,6 +986,25 @@ log_buffer_switch()
 	log_sys.buf_next_to_write = log_sys.buf_free;
 }
 
+/** Wait for a pending log flush to complete. Before suspending the
+thread, poll for innodb_log_flush_spin_rounds, because a log flush
+on a fast storage device may complete sooner than a thread can be
+suspended and woken up. */
+static
+void
+log_wait_for_flush()
+{
+	for (ulong i = srv_log_flush_spin_rounds; i--; ) {
+		if (os_event_is_set(log_sys.flush_event)) {
+			return;
+		}
+
+		ut_delay(srv_spin_wait_delay);
+	}
+
+	os_event_wait(log_sys.flush_event);
+}
+
 /** Ensure that the log has been written to the log file up to a given
 log entry (such as that of a transaction commit). Start a new write, or
 wait and check if an already running write is covering the request.
@@ -996,7 +1071,7 @@ void log_write_up_to(lsn_t lsn, bool flush_to_disk, bool rotate_key)
 
 		log_write_mutex_exit();
 
-		os_event_wait(log_sys.flush_event);
+		log_wait_for_flush();
 
 		if (work_done) {
 			return;
@@ -1006,6 +1081,8 @@ void log_write_up_to(lsn_t lsn, bool flush_to_disk, bool rotate_key)
 	}
 
 	log_mutex_enter();
+	log_wait_for_pending_copies();
+
 	if (!flush_to_disk
 	    && log_sys.buf_free == log_sys.buf_next_to_write) {
 		/* Nothing to write and no flush to disk requested */
@@ -1503,6 +1580,13 @@ log_checkpoint(
 
 	log_write_up_to(flush_lsn, true, true);
 
+	/* All pages modified before oldest_lsn have been written.
+	Note them in the changed page bitmap before the checkpoint
+	that mariabackup will read. */
+	if (srv_track_changed_pages) {
+		log_online_write(oldest_lsn);
+	}
+
 	DBUG_EXECUTE_IF(
 		"using_wa_checkpoint_middle",
 		if (write_always) {
@@ -0,0 +1,509 @@
+/*****************************************************************************
+
+Copyright (c) 2019, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file log/log0online.cc
+Changed page tracking for incremental backups (innodb_track_changed_pages)
+
+A bitmap file consists of runs of blocks. Each run covers an LSN range
+(start_lsn, end_lsn] and contains the identifiers of all pages that were
+modified in that range; a reader may merge the runs that overlap the range
+it is interested in.
+
+The runs are derived from the page writes rather than by parsing the redo
+log: buf_flush_write_block_low() notes every page that is written together
+with its newest modification, and before a log checkpoint is written,
+log_online_write() writes out a run ending at the oldest modification in
+the buffer pool. Every page modified before that LSN must have been
+written by then. A page whose newest modification is after the end of the
+run is kept for the next run as well, so that it is found by readers
+starting from a later LSN.
+
+The pages written after the last run before a crash are not known after
+crash recovery. If the server was not shut down cleanly at the end of the
+last run, the old bitmap files are removed and tracking starts over at the
+current LSN, so that mariabackup falls back to a full scan for earlier
+base backups.
+*******************************************************/
+
+#include "log0online.h"
+#include "log0log.h"
+#include "log0recv.h"
+#include "buf0buf.h"
+#include "os0file.h"
+#include "srv0srv.h"
+#include "ut0new.h"
+
+#include <map>
+
+/** Bitmap files are switched when they exceed this size */
+static const os_offset_t LOG_ONLINE_FILE_SIZE_MAX = 100 << 20;
+
+/** Written pages, (space_id << 32 | page_no) to newest modification */
+typedef std::map<
+	ib_uint64_t,
+	lsn_t,
+	std::less<ib_uint64_t>,
+	ut_allocator<std::pair<const ib_uint64_t, lsn_t> > >
+	log_online_pages_t;
+
+/** Changed page tracking state */
+struct log_online_t {
+	/** whether the mutexes have been created */
+	bool			initialized;
+	/** whether pages are being tracked */
+	bool			active;
+	/** protects pages */
+	ib_mutex_t		mutex;
+	/** serializes log_online_write() and protects the fields below */
+	ib_mutex_t		write_mutex;
+	/** pages written since the last run, or written earlier but
+	modified after the end of the last run */
+	log_online_pages_t	pages;
+	/** directory of the bitmap files, without a trailing separator */
+	char			dir[FN_REFLEN];
+	/** path name of the current bitmap file */
+	char			name[FN_REFLEN];
+	/** current bitmap file */
+	pfs_os_file_t		file;
+	/** sequence number of the current bitmap file */
+	ulong			seq_num;
+	/** size of the current bitmap file */
+	os_offset_t		offset;
+	/** end LSN of the last run */
+	lsn_t			end_lsn;
+};
+
+static log_online_t	log_online;
+
+/** Calculate the checksum of a bitmap block.
+Algorithm borrowed from log_block_calc_checksum.
+@param[in]	block	bitmap block
+@return checksum */
+ulint
+log_online_calc_checksum(const byte* block)
+{
+	ulint	sum = 1;
+	ulint	sh = 0;
+
+	for (ulint i = 0; i < MODIFIED_PAGE_BLOCK_CHECKSUM; i++) {
+		ulint	b = block[i];
+		sum &= 0x7FFFFFFFUL;
+		sum += b;
+		sum += b << sh;
+		if (++sh > 24) {
+			sh = 0;
+		}
+	}
+
+	return(sum);
+}
+
+/** Check if a file is a bitmap file.
+@param[in]	info		directory entry
+@param[out]	seq_num		sequence number of the file
+@param[out]	start_lsn	start LSN of the file
+@return whether the file is a bitmap file */
+static
+bool
+log_online_is_bitmap_file(
+	const os_file_stat_t&	info,
+	ulong*			seq_num,
+	lsn_t*			start_lsn)
+{
+	char	stem[FN_REFLEN];
+
+	return((info.type == OS_FILE_TYPE_FILE
+		|| info.type == OS_FILE_TYPE_LINK)
+	       && sscanf(info.name, "%[a-z_]%lu_" LSN_PF ".xdb", stem,
+			 seq_num, start_lsn) == 3
+	       && !strcmp(stem, LOG_ONLINE_FILE_NAME_STEM));
+}
+
+/** Find the newest bitmap file, optionally removing all bitmap files.
+@param[in]	remove	whether to remove the bitmap files
+@param[out]	name	file name of the newest file, or "" if none
+@param[out]	seq_num	sequence number of the newest file, or 0
+@return false on error */
+static
+bool
+log_online_scan_dir(bool remove, char* name, ulong* seq_num)
+{
+	os_file_dir_t	dir = os_file_opendir(log_online.dir, false);
+	os_file_stat_t	info;
+
+	*name = '\0';
+	*seq_num = 0;
+
+	if (!dir) {
+		ib::error() << "Cannot open the directory " << log_online.dir
+			    << " of the changed page bitmap files";
+		return(false);
+	}
+
+	while (!os_file_readdir_next_file(log_online.dir, dir, &info)) {
+		ulong	file_seq_num;
+		lsn_t	file_start_lsn;
+
+		if (!log_online_is_bitmap_file(info, &file_seq_num,
+					       &file_start_lsn)) {
+			continue;
+		}
+
+		if (remove) {
+			char	path[FN_REFLEN];
+
+			snprintf(path, sizeof path, "%s%c%s", log_online.dir,
+				 OS_PATH_SEPARATOR, info.name);
+			os_file_delete_if_exists(innodb_log_file_key, path,
+						 NULL);
+		} else if (file_seq_num > *seq_num) {
+			*seq_num = file_seq_num;
+			strcpy(name, info.name);
+		}
+	}
+
+	os_file_closedir(dir);
+	return(true);
+}
+
+/** Read the end LSN of the last run in a bitmap file.
+@param[in]	file		bitmap file
+@param[in]	start_lsn	start LSN of the file
+@return end LSN, or 0 if the last run is incomplete or corrupted */
+static
+lsn_t
+log_online_read_end_lsn(pfs_os_file_t file, lsn_t start_lsn)
+{
+	os_offset_t	size = os_file_get_size(file);
+
+	if (size == 0) {
+		/* Created, but no run has been written yet */
+		return(start_lsn);
+	}
+
+	if (size == os_offset_t(-1) || size % MODIFIED_PAGE_BLOCK_SIZE) {
+		return(0);
+	}
+
+	byte*	block = static_cast<byte*>(
+		ut_malloc_nokey(MODIFIED_PAGE_BLOCK_SIZE));
+	lsn_t	end_lsn = 0;
+
+	if (os_file_read(IORequestRead, file, block,
+			 size - MODIFIED_PAGE_BLOCK_SIZE,
+			 MODIFIED_PAGE_BLOCK_SIZE) == DB_SUCCESS
+	    && mach_read_from_4(block + MODIFIED_PAGE_BLOCK_CHECKSUM)
+	    == log_online_calc_checksum(block)
+	    && mach_read_from_4(block + MODIFIED_PAGE_IS_LAST_BLOCK)) {
+		end_lsn = mach_read_from_8(block + MODIFIED_PAGE_END_LSN);
+	}
+
+	ut_free(block);
+	return(end_lsn);
+}
+
+/** Create a new bitmap file starting at log_online.end_lsn.
+@return whether the file was created */
+static
+bool
+log_online_create_file()
+{
+	bool	success;
+
+	log_online.seq_num++;
+	snprintf(log_online.name, sizeof log_online.name,
+		 "%s%c" LOG_ONLINE_FILE_NAME_STEM "%lu_" LSN_PF ".xdb",
+		 log_online.dir, OS_PATH_SEPARATOR, log_online.seq_num,
+		 log_online.end_lsn);
+
+	log_online.file = os_file_create_simple_no_error_handling(
+		innodb_log_file_key, log_online.name, OS_FILE_CREATE,
+		OS_FILE_READ_WRITE, false, &success);
+
+	if (!success) {
+		ib::error() << "Cannot create the changed page bitmap file "
+			    << log_online.name;
+		return(false);
+	}
+
+	log_online.offset = 0;
+	return(true);
+}
+
+/** Start tracking the changed pages, after redo log recovery. */
+void
+log_online_init()
+{
+	char	name[FN_REFLEN];
+	ulong	seq_num;
+	lsn_t	lsn;
+	bool	success;
+
+	if (!srv_track_changed_pages) {
+		return;
+	}
+
+	if (srv_read_only_mode) {
+		ib::warn() << "innodb_track_changed_pages is ignored in"
+			" read-only mode";
+		srv_track_changed_pages = FALSE;
+		return;
+	}
+
+	strncpy(log_online.dir, *srv_data_home ? srv_data_home : ".",
+		sizeof log_online.dir - 1);
+	for (size_t len = strlen(log_online.dir);
+	     len > 1 && (log_online.dir[len - 1] == OS_PATH_SEPARATOR
+			 || log_online.dir[len - 1] == OS_PATH_SEPARATOR_ALT);
+	     len--) {
+		log_online.dir[len - 1] = '\0';
+	}
+
+	lsn = log_get_lsn();
+
+	if (!log_online_scan_dir(false, name, &seq_num)) {
+		srv_track_changed_pages = FALSE;
+		return;
+	}
+
+	log_online.seq_num = seq_num;
+	log_online.end_lsn = lsn;
+
+	if (*name) {
+		lsn_t	start_lsn = 0;
+		lsn_t	end_lsn = 0;
+
+		sscanf(name, LOG_ONLINE_FILE_NAME_STEM "%*lu_" LSN_PF ".xdb",
+		       &start_lsn);
+		snprintf(log_online.name, sizeof log_online.name, "%s%c%s",
+			 log_online.dir, OS_PATH_SEPARATOR, name);
+		log_online.file = os_file_create_simple_no_error_handling(
+			innodb_log_file_key, log_online.name, OS_FILE_OPEN,
+			OS_FILE_READ_WRITE, false, &success);
+
+		if (success) {
+			end_lsn = log_online_read_end_lsn(log_online.file,
+							  start_lsn);
+		}
+
+		if (end_lsn == lsn && !recv_needed_recovery) {
+			/* Continue after the last run */
+			log_online.offset = os_file_get_size(log_online.file);
+		} else {
+			ib::warn() << "Changed page tracking was interrupted"
+				" at LSN " << end_lsn << ", the current LSN is "
+				<< lsn << ". Removing the old changed page"
+				" bitmap files; incremental backups based on"
+				" earlier backups will read all pages.";
+			if (success) {
+				os_file_close(log_online.file);
+			}
+			log_online_scan_dir(true, name, &seq_num);
+			*name = '\0';
+		}
+	}
+
+	if (!*name && !log_online_create_file()) {
+		srv_track_changed_pages = FALSE;
+		return;
+	}
+
+	mutex_create(LATCH_ID_LOG_ONLINE, &log_online.mutex);
+	mutex_create(LATCH_ID_LOG_ONLINE_WRITE, &log_online.write_mutex);
+	log_online.initialized = true;
+	log_online.active = true;
+
+	ib::info() << "Tracking changed pages in " << log_online.name
+		   << " from LSN " << log_online.end_lsn;
+}
+
+/** Stop tracking the changed pages, at shutdown. */
+void
+log_online_close()
+{
+	if (!log_online.initialized) {
+		return;
+	}
+
+	if (log_online.active) {
+		os_file_close(log_online.file);
+	}
+
+	log_online.active = false;
+	log_online.initialized = false;
+	log_online.pages.clear();
+	mutex_free(&log_online.write_mutex);
+	mutex_free(&log_online.mutex);
+}
+
+/** Note that a page of a persistent tablespace is being written.
+@param[in]	id	page identifier
+@param[in]	lsn	newest modification of the page */
+void
+log_online_track_page(const page_id_t& id, lsn_t lsn)
+{
+	if (!log_online.active) {
+		return;
+	}
+
+	mutex_enter(&log_online.mutex);
+	lsn_t&	newest = log_online.pages[ib_uint64_t(id.space()) << 32
+					  | id.page_no()];
+	if (newest < lsn) {
+		newest = lsn;
+	}
+	mutex_exit(&log_online.mutex);
+}
+
+/** Write a run of blocks for pages to the current bitmap file.
+@param[in]	pages	written pages
+@param[in]	end_lsn	end LSN of the run
+@return whether the run was written */
+static
+bool
+log_online_write_run(const log_online_pages_t& pages, lsn_t end_lsn)
+{
+	const ib_uint64_t	no_block = ~ib_uint64_t(0);
+	ib_uint64_t		block_id = no_block;
+	ulint			n_blocks = 0;
+	log_online_pages_t::const_iterator	it;
+
+	for (it = pages.begin(); it != pages.end(); ++it) {
+		ib_uint64_t	id = it->first - (it->first & 0xFFFFFFFF)
+			% MODIFIED_PAGE_BLOCK_ID_COUNT;
+		if (id != block_id) {
+			block_id = id;
+			n_blocks++;
+		}
+	}
+
+	/* A run without pages still advances the tracked LSN */
+	n_blocks = std::max<ulint>(n_blocks, 1);
+
+	const ulint	len = n_blocks * MODIFIED_PAGE_BLOCK_SIZE;
+	byte*		buf = static_cast<byte*>(ut_zalloc_nokey(len));
+	byte*		block = NULL;
+
+	block_id = no_block;
+
+	for (it = pages.begin(); it != pages.end(); ++it) {
+		ulint		page_no = ulint(it->first & 0xFFFFFFFF);
+		ulint		bit = page_no % MODIFIED_PAGE_BLOCK_ID_COUNT;
+		ib_uint64_t	id = it->first - bit;
+
+		if (id != block_id) {
+			block_id = id;
+			block = block ? block + MODIFIED_PAGE_BLOCK_SIZE : buf;
+			mach_write_to_4(block + MODIFIED_PAGE_SPACE_ID,
+					ulint(id >> 32));
+			mach_write_to_4(block + MODIFIED_PAGE_1ST_PAGE_ID,
+					page_no - bit);
+		}
+
+		/* The bitmap is read as an array of 64-bit words */
+		reinterpret_cast<ib_uint64_t*>(
+			block + MODIFIED_PAGE_BLOCK_BITMAP)[bit >> 6]
+			|= ib_uint64_t(1) << (bit & 63);
+	}
+
+	for (block = buf; block < buf + len;
+	     block += MODIFIED_PAGE_BLOCK_SIZE) {
+		mach_write_to_4(block + MODIFIED_PAGE_IS_LAST_BLOCK,
+				block + MODIFIED_PAGE_BLOCK_SIZE == buf + len);
+		mach_write_to_8(block + MODIFIED_PAGE_START_LSN,
+				log_online.end_lsn);
+		mach_write_to_8(block + MODIFIED_PAGE_END_LSN, end_lsn);
+		mach_write_to_4(block + MODIFIED_PAGE_BLOCK_CHECKSUM,
+				log_online_calc_checksum(block));
+	}
+
+	bool	success = os_file_write(IORequestWrite, log_online.name,
+					log_online.file, buf,
+					log_online.offset, len) == DB_SUCCESS
+		&& os_file_flush(log_online.file);
+
+	ut_free(buf);
+
+	if (success) {
+		log_online.offset += len;
+	}
+
+	return(success);
+}
+
+/** Write the pages written so far to the bitmap file, before a log
+checkpoint is written.
+@param[in]	end_lsn	LSN up to which all modified pages have been
+written, that is, the oldest modification in the buffer pool */
+void
+log_online_write(lsn_t end_lsn)
+{
+	if (!log_online.active) {
+		return;
+	}
+
+	mutex_enter(&log_online.write_mutex);
+
+	if (!log_online.active || end_lsn <= log_online.end_lsn) {
+		mutex_exit(&log_online.write_mutex);
+		return;
+	}
+
+	log_online_pages_t	pages;
+
+	mutex_enter(&log_online.mutex);
+	pages.swap(log_online.pages);
+	mutex_exit(&log_online.mutex);
+
+	bool	success = true;
+
+	if (log_online.offset >= LOG_ONLINE_FILE_SIZE_MAX) {
+		os_file_close(log_online.file);
+		success = log_online_create_file();
+	}
+
+	if (!success || !log_online_write_run(pages, end_lsn)) {
+		ib::error() << "Failed to write the changed page bitmap file "
+			    << log_online.name << "; changed page tracking"
+			" is stopped.";
+		if (success) {
+			os_file_close(log_online.file);
+		}
+		log_online.active = false;
+		mutex_exit(&log_online.write_mutex);
+		return;
+	}
+
+	log_online.end_lsn = end_lsn;
+
+	/* Keep the pages that were modified after the end of the run */
+	mutex_enter(&log_online.mutex);
+	for (log_online_pages_t::const_iterator it = pages.begin();
+	     it != pages.end(); ++it) {
+		if (it->second > end_lsn) {
+			lsn_t&	newest = log_online.pages[it->first];
+			if (newest < it->second) {
+				newest = it->second;
+			}
+		}
+	}
+	mutex_exit(&log_online.mutex);
+
+	mutex_exit(&log_online.write_mutex);
+}
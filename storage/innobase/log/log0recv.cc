@@ -27,6 +27,7 @@ Created 9/20/1997 Heikki Tuuri
 
 #include "univ.i"
 
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <string>
@@ -563,6 +564,10 @@ recv_sys_close()
 			os_event_destroy(recv_sys->flush_end);
 		}
 
+		if (recv_sys->apply_done != NULL) {
+			os_event_destroy(recv_sys->apply_done);
+		}
+
 		if (recv_sys->buf != NULL) {
 			ut_free_dodump(recv_sys->buf, recv_sys->buf_size);
 		}
@@ -672,6 +677,8 @@ recv_sys_init()
 		recv_sys->flush_end = os_event_create(0);
 	}
 
+	recv_sys->apply_done = os_event_create(0);
+
 	ulint size = buf_pool_get_curr_size();
 	/* Set appropriate value of recv_n_pool_free_frames. */
 	if (size >= 10 << 20) {
@@ -1953,6 +1960,8 @@ recv_recover_page(bool just_read_in, buf_block_t* block)
 			service_manager_extend_timeout(
 				INNODB_EXTEND_TIMEOUT_INTERVAL, "To recover: " ULINTPF " pages from log", n);
 		}
+	} else {
+		os_event_set(recv_sys->apply_done);
 	}
 
 	mutex_exit(&recv_sys->mutex);
@@ -2002,6 +2011,19 @@ static ulint recv_read_in_area(const page_id_t page_id)
 	return(n);
 }
 
+/** Pages that a batch of log records is applied to */
+typedef std::vector<recv_addr_t*, ut_allocator<recv_addr_t*> > recv_addrs_t;
+
+/** Order recv_addr_t by tablespace identifier and page number.
+@param[in]	a	page
+@param[in]	b	page
+@return whether a precedes b */
+static bool recv_addr_less(const recv_addr_t* a, const recv_addr_t* b)
+{
+	return a->space < b->space
+		|| (a->space == b->space && a->page_no < b->page_no);
+}
+
 /** Apply the hash table of stored log records to persistent data pages.
 @param[in]	last_batch	whether the change buffer merge will be
 				performed as part of the operation */
@@ -2063,6 +2085,13 @@ void recv_apply_hashed_log_recs(bool last_batch)
 		}
 	}
 
+	/* Visit the pages in (space,page_no) order rather than in
+	hash order, so that the read-ahead areas are submitted in
+	ascending file order and the I/O handler threads, which apply
+	the records on I/O completion, are kept busy with nearby pages. */
+	recv_addrs_t	addrs;
+	addrs.reserve(recv_sys->n_addrs);
+
 	for (ulint i = 0; i < hash_get_n_cells(recv_sys->addr_hash); i++) {
 		for (recv_addr_t* recv_addr = static_cast<recv_addr_t*>(
 			     HASH_GET_FIRST(recv_sys->addr_hash, i));
@@ -2077,44 +2106,55 @@ void recv_apply_hashed_log_recs(bool last_batch)
 				continue;
 			}
 
-			const page_id_t		page_id(recv_addr->space,
-							recv_addr->page_no);
-			bool			found;
-			const page_size_t&	page_size
-				= fil_space_get_page_size(recv_addr->space,
-							  &found);
+			addrs.push_back(recv_addr);
+		}
+	}
 
-			ut_ad(found);
+	std::sort(addrs.begin(), addrs.end(), recv_addr_less);
 
-			if (recv_addr->state == RECV_NOT_PROCESSED) {
-				mutex_exit(&recv_sys->mutex);
+	for (recv_addrs_t::const_iterator it = addrs.begin();
+	     it != addrs.end(); ++it) {
+		const recv_addr_t*	recv_addr = *it;
+		const page_id_t		page_id(recv_addr->space,
+						recv_addr->page_no);
+		bool			found;
+		const page_size_t&	page_size
+			= fil_space_get_page_size(recv_addr->space,
+						  &found);
 
-				if (buf_page_peek(page_id)) {
-					mtr_t	mtr;
-					mtr.start();
+		ut_ad(found);
 
-					buf_block_t* block = buf_page_get(
-						page_id, page_size,
-						RW_X_LATCH, &mtr);
+		if (recv_addr->state == RECV_NOT_PROCESSED) {
+			mutex_exit(&recv_sys->mutex);
 
-					buf_block_dbg_add_level(
-						block, SYNC_NO_ORDER_CHECK);
+			if (buf_page_peek(page_id)) {
+				mtr_t	mtr;
+				mtr.start();
 
-					recv_recover_page(FALSE, block);
-					mtr.commit();
-				} else {
-					recv_read_in_area(page_id);
-				}
+				buf_block_t* block = buf_page_get(
+					page_id, page_size,
+					RW_X_LATCH, &mtr);
+
+				buf_block_dbg_add_level(
+					block, SYNC_NO_ORDER_CHECK);
 
-				mutex_enter(&recv_sys->mutex);
+				recv_recover_page(FALSE, block);
+				mtr.commit();
+			} else {
+				recv_read_in_area(page_id);
 			}
+
+			mutex_enter(&recv_sys->mutex);
 		}
 	}
 
+	addrs.clear();
+
 	/* Wait until all the pages have been processed */
 
 	while (recv_sys->n_addrs != 0) {
 		bool abort = recv_sys->found_corrupt_log;
+		int64_t sig_count = os_event_reset(recv_sys->apply_done);
 
 		mutex_exit(&(recv_sys->mutex));
 
@@ -2122,7 +2162,8 @@ void recv_apply_hashed_log_recs(bool last_batch)
 			return;
 		}
 
-		os_thread_sleep(500000);
+		os_event_wait_time_low(recv_sys->apply_done, 500000,
+				       sig_count);
 
 		mutex_enter(&(recv_sys->mutex));
 	}
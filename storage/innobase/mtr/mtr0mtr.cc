@@ -34,6 +34,81 @@ Created 11/26/1995 Heikki Tuuri
 #include "log0log.h"
 
 #include "log0recv.h"
+#include "srv0mon.h"
+
+/** Number of mtr_buf_t::block_t that each thread keeps for reuse */
+static const ulint MTR_BUF_CACHED_BLOCKS = 64;
+
+/** Blocks of mtr_buf_t (the memo and log of a mini-transaction) that
+were released on this thread, to be reused by the next mini-transaction
+that outgrows mtr_buf_t::m_first_block. A thread executing large
+updates or page splits would otherwise allocate and free the same
+blocks for every mini-transaction. */
+struct mtr_buf_block_cache_t {
+	/** Cached blocks */
+	mtr_buf_t::block_t*	m_blocks[MTR_BUF_CACHED_BLOCKS];
+	/** Number of cached blocks */
+	ulint			m_n;
+
+	/** Free the cached blocks at thread exit. They were allocated
+	with malloc() and not ut_malloc(), because for the main thread
+	this happens after performance_schema has been shut down. */
+	~mtr_buf_block_cache_t()
+	{
+		while (m_n) {
+			free(m_blocks[--m_n]);
+		}
+	}
+};
+
+/** The mtr_buf_t::block_t cache of the current thread */
+static thread_local mtr_buf_block_cache_t	mtr_buf_block_cache;
+
+/** Allocate and add a new block to m_list. The block is taken from
+a cache of blocks released by erase() on the current thread, and
+only allocated from the heap if the cache is empty.
+@return the added block */
+mtr_buf_t::block_t*
+mtr_buf_t::add_block()
+{
+	mtr_buf_block_cache_t&	cache = mtr_buf_block_cache;
+	block_t*		block;
+
+	if (cache.m_n) {
+		block = cache.m_blocks[--cache.m_n];
+	} else {
+		block = static_cast<block_t*>(malloc(sizeof *block));
+		ut_a(block);
+		MONITOR_INC(MONITOR_MTR_BUF_BLOCK_ALLOC);
+	}
+
+	push_back(block);
+
+	return(block);
+}
+
+/** Return all blocks but m_first_block to the cache of the
+current thread, or free them if the cache is full. */
+void
+mtr_buf_t::release_blocks()
+{
+	mtr_buf_block_cache_t&	cache = mtr_buf_block_cache;
+
+	ut_ad(UT_LIST_GET_FIRST(m_list) == &m_first_block);
+
+	for (block_t* block = UT_LIST_GET_NEXT(m_node, &m_first_block);
+	     block != NULL; ) {
+		block_t*	next = UT_LIST_GET_NEXT(m_node, block);
+
+		if (cache.m_n < MTR_BUF_CACHED_BLOCKS) {
+			cache.m_blocks[cache.m_n++] = block;
+		} else {
+			free(block);
+		}
+
+		block = next;
+	}
+}
 
 /** Iterate over a memo block in reverse. */
 template <typename Functor>
@@ -382,7 +457,8 @@ class mtr_t::Command {
 	/** Constructor.
 	Takes ownership of the mtr->m_impl, is responsible for deleting it.
 	@param[in,out]	mtr	mini-transaction */
-	explicit Command(mtr_t* mtr) : m_impl(&mtr->m_impl), m_locks_released()
+	explicit Command(mtr_t* mtr) : m_impl(&mtr->m_impl), m_locks_released(),
+		m_copy_buf(NULL)
 	{}
 
 	/** Destructor */
@@ -408,8 +484,15 @@ class mtr_t::Command {
 	void release_resources();
 
 	/** Append the redo log records to the redo log buffer.
-	@param[in]	len	number of bytes to write */
-	void finish_write(ulint len);
+	@param[in]	len		number of bytes to write
+	@param[in]	defer_copy	whether to only reserve the space
+	while holding log_sys.mutex, and to copy the records in
+	copy_reserved() after log_sys.mutex has been released */
+	void finish_write(ulint len, bool defer_copy = false);
+
+	/** Copy the redo log records to the space that was reserved
+	by finish_write(len, true). */
+	void copy_reserved();
 
 private:
 	/** Prepare to write the mini-transaction log to the redo log buffer.
@@ -428,6 +511,14 @@ class mtr_t::Command {
 
 	/** End lsn of the possible log entry for this mtr */
 	lsn_t			m_end_lsn;
+
+	/** log_sys.buf at the time of finish_write(len, true),
+	or NULL if the records were already copied */
+	byte*			m_copy_buf;
+
+	/** offset of the space reserved by finish_write(len, true)
+	within m_copy_buf */
+	ulint			m_copy_offset;
 };
 
 /** Check if a mini-transaction is dirtying a clean page.
@@ -455,6 +546,29 @@ struct mtr_write_log_t {
 	}
 };
 
+/** Copy the block contents to reserved space in the REDO log buffer */
+struct mtr_write_reserved_t {
+	/** Constructor
+	@param[in]	buf	log_sys.buf at the time of the reservation
+	@param[in,out]	offset	offset of the reserved space within buf */
+	mtr_write_reserved_t(byte* buf, ulint* offset)
+		: m_buf(buf), m_offset(offset) {}
+
+	/** Append a block to the reserved space.
+	@return whether the appending should continue */
+	bool operator()(const mtr_buf_t::block_t* block) const
+	{
+		log_write_reserved(m_buf, m_offset,
+				   block->begin(), block->used());
+		return(true);
+	}
+
+	/** log_sys.buf at the time of the reservation */
+	byte*	m_buf;
+	/** current offset within m_buf */
+	ulint*	m_offset;
+};
+
 /** Append records to the system-wide redo log buffer.
 @param[in]	log	redo log records */
 void
@@ -817,11 +931,15 @@ mtr_t::Command::prepare_write()
 	return(len);
 }
 
-/** Append the redo log records to the redo log buffer
-@param[in] len	number of bytes to write */
+/** Append the redo log records to the redo log buffer.
+@param[in]	len		number of bytes to write
+@param[in]	defer_copy	whether to only reserve the space
+while holding log_sys.mutex, and to copy the records in
+copy_reserved() after log_sys.mutex has been released */
 void
 mtr_t::Command::finish_write(
-	ulint	len)
+	ulint	len,
+	bool	defer_copy)
 {
 	ut_ad(m_impl->m_log_mode == MTR_LOG_ALL);
 	ut_ad(log_mutex_own());
@@ -843,12 +961,38 @@ mtr_t::Command::finish_write(
 	/* Open the database log for log_write_low */
 	m_start_lsn = log_reserve_and_open(len);
 
-	mtr_write_log_t	write_log;
-	m_impl->m_log.for_each_block(write_log);
+	if (defer_copy) {
+		/* Only advance the LSN and initialize the log block
+		headers here. The records will be copied by
+		copy_reserved() concurrently with other threads. */
+		m_copy_buf = log_sys.buf;
+		m_copy_offset = log_sys.buf_free;
+		log_write_low(NULL, len);
+		my_atomic_addlint(&log_sys.n_pending_copies, 1);
+	} else {
+		mtr_write_log_t	write_log;
+		m_impl->m_log.for_each_block(write_log);
+	}
 
 	m_end_lsn = log_close();
 }
 
+/** Copy the redo log records to the space that was reserved
+by finish_write(len, true). */
+void
+mtr_t::Command::copy_reserved()
+{
+	ut_ad(m_copy_buf);
+	ut_ad(!log_mutex_own());
+
+	mtr_write_reserved_t	write_log(m_copy_buf, &m_copy_offset);
+	m_impl->m_log.for_each_block(write_log);
+
+	/* Allow log_write_up_to() to write out the log buffer. */
+	my_atomic_addlint(&log_sys.n_pending_copies, ulint(-1));
+	m_copy_buf = NULL;
+}
+
 /** Release the latches and blocks acquired by this mini-transaction */
 void
 mtr_t::Command::release_all()
@@ -893,7 +1037,12 @@ mtr_t::Command::execute()
 	ut_ad(m_impl->m_log_mode != MTR_LOG_NONE);
 
 	if (const ulint len = prepare_write()) {
-		finish_write(len);
+		/* If pages are being made dirty, log_flush_order_mutex
+		will be held until the blocks have been inserted into
+		the flush list. Copy the records while holding
+		log_sys.mutex in that case, as before. */
+		finish_write(len, srv_log_concurrent_copy
+			     && !m_impl->m_made_dirty);
 	}
 
 	if (m_impl->m_made_dirty) {
@@ -905,6 +1054,10 @@ mtr_t::Command::execute()
 	to insert into the flush list. */
 	log_mutex_exit();
 
+	if (m_copy_buf) {
+		copy_reserved();
+	}
+
 	m_impl->m_mtr->m_commit_lsn = m_end_lsn;
 
 	release_blocks();
@@ -56,6 +56,11 @@ Created 10/21/1995 Heikki Tuuri
 
 #ifdef LINUX_NATIVE_AIO
 #include <libaio.h>
+# ifdef LINUX_IO_URING
+#  include <linux/io_uring.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+# endif /* LINUX_IO_URING */
 #endif /* LINUX_NATIVE_AIO */
 
 #ifdef HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE
@@ -276,6 +281,247 @@ struct Slot {
 
 };
 
+#ifdef LINUX_IO_URING
+/** An io_uring instance for the Linux native AIO of one segment.
+The system calls are invoked directly, so that no library is needed.
+Any thread may submit requests, serialised by m_mutex; only the i/o
+handler thread of the segment reaps the completions. */
+class URing {
+public:
+	/** Create the submission and completion queues.
+	@param[in]	entries	maximum number of pending requests
+	@return whether the io_uring was successfully created */
+	bool create(unsigned entries)
+		MY_ATTRIBUTE((warn_unused_result));
+
+	/** Free the io_uring. */
+	void close();
+
+	/** Submit a read or write request for a slot.
+	@param[in]	slot	a reserved slot; NULL to submit a
+				no-op that wakes up the i/o handler thread
+	@return 0 on success, or a negative errno */
+	int submit(const Slot* slot)
+		MY_ATTRIBUTE((warn_unused_result));
+
+	/** Wait for at least one request to complete.
+	@param[out]	cqes	completed requests
+	@param[in]	n	maximum number of requests to reap
+	@return number of completed requests, or a negative errno */
+	int reap(io_uring_cqe* cqes, unsigned n)
+		MY_ATTRIBUTE((warn_unused_result));
+
+private:
+	/** io_uring file descriptor */
+	int		m_fd;
+	/** protects the submission queue tail */
+	OSMutex		m_mutex;
+
+	/** submission queue ring */
+	void*		m_sq_ring;
+	/** size of m_sq_ring */
+	size_t		m_sq_ring_size;
+	/** submission queue head, advanced by the kernel */
+	unsigned*	m_sq_head;
+	/** submission queue tail, advanced by us */
+	unsigned*	m_sq_tail;
+	/** submission queue index mask */
+	unsigned	m_sq_mask;
+	/** submission queue index array */
+	unsigned*	m_sq_array;
+	/** submission queue entries */
+	io_uring_sqe*	m_sqes;
+	/** size of m_sqes */
+	size_t		m_sqes_size;
+
+	/** completion queue ring (may be the same as m_sq_ring) */
+	void*		m_cq_ring;
+	/** size of m_cq_ring */
+	size_t		m_cq_ring_size;
+	/** completion queue head, advanced by us */
+	unsigned*	m_cq_head;
+	/** completion queue tail, advanced by the kernel */
+	unsigned*	m_cq_tail;
+	/** completion queue index mask */
+	unsigned	m_cq_mask;
+	/** completion queue entries */
+	io_uring_cqe*	m_cqes;
+};
+
+/** Create the submission and completion queues.
+@param[in]	entries	maximum number of pending requests
+@return whether the io_uring was successfully created */
+bool
+URing::create(unsigned entries)
+{
+	io_uring_params	params;
+
+	memset(&params, 0, sizeof params);
+
+	m_fd = static_cast<int>(
+		syscall(__NR_io_uring_setup, entries, &params));
+
+	if (m_fd < 0) {
+		return(false);
+	}
+
+	m_sq_ring_size = params.sq_off.array
+		+ params.sq_entries * sizeof(unsigned);
+	m_cq_ring_size = params.cq_off.cqes
+		+ params.cq_entries * sizeof(io_uring_cqe);
+
+	const bool single_mmap =
+#ifdef IORING_FEAT_SINGLE_MMAP
+		params.features & IORING_FEAT_SINGLE_MMAP;
+#else
+		false;
+#endif
+
+	if (single_mmap) {
+		m_sq_ring_size = m_cq_ring_size
+			= std::max(m_sq_ring_size, m_cq_ring_size);
+	}
+
+	m_sq_ring = mmap(NULL, m_sq_ring_size, PROT_READ | PROT_WRITE,
+			 MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+	m_cq_ring = single_mmap
+		? m_sq_ring
+		: mmap(NULL, m_cq_ring_size, PROT_READ | PROT_WRITE,
+		       MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+	m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+	m_sqes = static_cast<io_uring_sqe*>(
+		mmap(NULL, m_sqes_size, PROT_READ | PROT_WRITE,
+		     MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES));
+
+	if (m_sq_ring == MAP_FAILED || m_cq_ring == MAP_FAILED
+	    || m_sqes == MAP_FAILED) {
+		if (m_sqes != MAP_FAILED) {
+			munmap(m_sqes, m_sqes_size);
+		}
+		if (m_cq_ring != MAP_FAILED && m_cq_ring != m_sq_ring) {
+			munmap(m_cq_ring, m_cq_ring_size);
+		}
+		if (m_sq_ring != MAP_FAILED) {
+			munmap(m_sq_ring, m_sq_ring_size);
+		}
+		::close(m_fd);
+		return(false);
+	}
+
+	byte*	sq = static_cast<byte*>(m_sq_ring);
+	m_sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+	m_sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+	m_sq_mask = *reinterpret_cast<unsigned*>(
+		sq + params.sq_off.ring_mask);
+	m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+	byte*	cq = static_cast<byte*>(m_cq_ring);
+	m_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+	m_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+	m_cq_mask = *reinterpret_cast<unsigned*>(
+		cq + params.cq_off.ring_mask);
+	m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+	m_mutex.init();
+
+	return(true);
+}
+
+/** Free the io_uring. */
+void
+URing::close()
+{
+	m_mutex.destroy();
+	munmap(m_sqes, m_sqes_size);
+	if (m_cq_ring != m_sq_ring) {
+		munmap(m_cq_ring, m_cq_ring_size);
+	}
+	munmap(m_sq_ring, m_sq_ring_size);
+	::close(m_fd);
+}
+
+/** Submit a read or write request for a slot.
+@param[in]	slot	a reserved slot; NULL to submit a
+			no-op that wakes up the i/o handler thread
+@return 0 on success, or a negative errno */
+int
+URing::submit(const Slot* slot)
+{
+	m_mutex.enter();
+
+	/* Only we advance the tail. The kernel consumes all entries
+	in io_uring_enter(), so there always is a free entry. */
+	const unsigned	tail = *m_sq_tail;
+	const unsigned	index = tail & m_sq_mask;
+	io_uring_sqe*	sqe = &m_sqes[index];
+
+	memset(sqe, 0, sizeof *sqe);
+
+	if (slot == NULL) {
+		sqe->opcode = IORING_OP_NOP;
+	} else {
+		sqe->opcode = slot->type.is_read()
+			? IORING_OP_READ : IORING_OP_WRITE;
+		sqe->fd = slot->file;
+		sqe->addr = reinterpret_cast<uintptr_t>(slot->ptr);
+		sqe->len = static_cast<__u32>(slot->len);
+		sqe->off = slot->offset;
+		sqe->user_data = reinterpret_cast<uintptr_t>(slot);
+	}
+
+	m_sq_array[index] = index;
+	__atomic_store_n(m_sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+	int	ret = static_cast<int>(
+		syscall(__NR_io_uring_enter, m_fd, 1, 0, 0, NULL, 0));
+
+	if (ret != 1) {
+		/* The kernel did not consume the entry. Withdraw it,
+		so that it will not be submitted by a later call. */
+		__atomic_store_n(m_sq_tail, tail, __ATOMIC_RELEASE);
+		ret = ret < 0 ? -errno : -EAGAIN;
+	} else {
+		ret = 0;
+	}
+
+	m_mutex.exit();
+
+	return(ret);
+}
+
+/** Wait for at least one request to complete.
+@param[out]	cqes	completed requests
+@param[in]	n	maximum number of requests to reap
+@return number of completed requests, or a negative errno */
+int
+URing::reap(io_uring_cqe* cqes, unsigned n)
+{
+	for (;;) {
+		const unsigned	head = *m_cq_head;
+		const unsigned	tail = __atomic_load_n(
+			m_cq_tail, __ATOMIC_ACQUIRE);
+
+		if (head != tail) {
+			unsigned	i = 0;
+
+			for (; i < n && head + i != tail; i++) {
+				cqes[i] = m_cqes[(head + i) & m_cq_mask];
+			}
+
+			__atomic_store_n(m_cq_head, head + i,
+					 __ATOMIC_RELEASE);
+			return(static_cast<int>(i));
+		}
+
+		if (syscall(__NR_io_uring_enter, m_fd, 0, 1,
+			    IORING_ENTER_GETEVENTS, NULL, 0) < 0
+		    && errno != EINTR) {
+			return(-errno);
+		}
+	}
+}
+#endif /* LINUX_IO_URING */
+
 /** The asynchronous i/o array structure */
 class AIO {
 public:
@@ -428,6 +674,29 @@ class AIO {
 	static bool linux_create_io_ctx(unsigned max_events, io_context_t* io_ctx)
 		MY_ATTRIBUTE((warn_unused_result));
 
+#ifdef LINUX_IO_URING
+	/** Accessor for the io_uring
+	@param[in]	segment	Segment for which to get the io_uring
+	@return the io_uring for the segment, or NULL if libaio is used */
+	URing* uring(ulint segment)
+		MY_ATTRIBUTE((warn_unused_result))
+	{
+		ut_ad(segment < get_n_segments());
+
+		return(m_uring ? &m_uring[segment] : NULL);
+	}
+
+	/** Checks if the system supports io_uring with
+	IORING_OP_READ and IORING_OP_WRITE.
+	@return true if supported, false otherwise. */
+	static bool is_io_uring_supported()
+		MY_ATTRIBUTE((warn_unused_result));
+
+	/** Wake up all i/o handler threads that wait for io_uring
+	completions, so that they can notice the shutdown. */
+	static void uring_wake_at_shutdown();
+#endif /* LINUX_IO_URING */
+
 	/** Checks if the system supports native linux aio. On some kernel
 	versions where native aio is supported it won't work on tmpfs. In such
 	cases we can't use native aio as it is not possible to mix simulated
@@ -628,6 +897,12 @@ class AIO {
 	event for each possible pending IO. The size of the array
 	is equal to m_slots.size(). */
 	IOEvents		m_events;
+
+# ifdef LINUX_IO_URING
+	/** io_uring instances, one per segment, or NULL if
+	io_context_t of libaio is being used */
+	URing*			m_uring;
+# endif /* LINUX_IO_URING */
 #endif /* LINUX_NATIV_AIO */
 
 	/** The aio arrays for non-ibuf i/o and ibuf i/o, as well as
@@ -1722,6 +1997,18 @@ class LinuxAIOHandler {
 	each wakeup and that is why we use timed wait in io_getevents(). */
 	void collect();
 
+	/** Note that an IO request has completed.
+	@param[in,out]	slot	the completed request
+	@param[in]	n_bytes	number of bytes read or written
+	@param[in]	ret	0, or a negative errno */
+	void completed(Slot* slot, ssize_t n_bytes, int ret);
+
+#ifdef LINUX_IO_URING
+	/** Wait for completed IO requests on an io_uring.
+	@param[in,out]	uring	the io_uring of m_segment */
+	void collect(URing* uring);
+#endif /* LINUX_IO_URING */
+
 private:
 	/** Slot array */
 	AIO*			m_array;
@@ -1786,6 +2073,18 @@ LinuxAIOHandler::resubmit(Slot* slot)
 
 	iocb->data = slot;
 
+#ifdef LINUX_IO_URING
+	if (URing* uring = m_array->uring(m_segment)) {
+		int	ret = uring->submit(slot);
+
+		if (ret) {
+			errno = -ret;
+		}
+
+		return(ret ? DB_IO_PARTIAL_FAILED : DB_SUCCESS);
+	}
+#endif /* LINUX_IO_URING */
+
 	/* Resubmit an I/O request */
 	int	ret = io_submit(m_array->io_ctx(m_segment), 1, &iocb);
 
@@ -1890,6 +2189,13 @@ LinuxAIOHandler::collect()
 	ut_ad(m_array != NULL);
 	ut_ad(m_segment < m_array->get_n_segments());
 
+#ifdef LINUX_IO_URING
+	if (URing* uring = m_array->uring(m_segment)) {
+		collect(uring);
+		return;
+	}
+#endif /* LINUX_IO_URING */
+
 	/* Which io_context we are going to use. */
 	io_context*	io_ctx = m_array->io_ctx(m_segment);
 
@@ -1930,7 +2236,6 @@ LinuxAIOHandler::collect()
 
 			/* Some sanity checks. */
 			ut_a(slot != NULL);
-			ut_a(slot->is_reserved);
 
 			/* We are not scribbling previous segment. */
 			ut_a(slot->pos >= start_pos);
@@ -1938,29 +2243,7 @@ LinuxAIOHandler::collect()
 			/* We have not overstepped to next segment. */
 			ut_a(slot->pos < end_pos);
 
-			/* Deallocate unused blocks from file system.
-			This is newer done to page 0 or to log files.*/
-			if (slot->offset > 0
-			    && !slot->type.is_log()
-			    && slot->type.is_write()
-			    && slot->type.punch_hole()) {
-
-				slot->err = slot->type.punch_hole(
-					slot->file,
-					slot->offset, slot->len);
-			} else {
-				slot->err = DB_SUCCESS;
-			}
-
-			/* Mark this request as completed. The error handling
-			will be done in the calling function. */
-			m_array->acquire();
-
-			slot->ret = events[i].res2;
-			slot->io_already_done = true;
-			slot->n_bytes = events[i].res;
-
-			m_array->release();
+			completed(slot, events[i].res, int(events[i].res2));
 		}
 
 		if (srv_shutdown_state == SRV_SHUTDOWN_EXIT_THREADS
@@ -2000,6 +2283,76 @@ LinuxAIOHandler::collect()
 	}
 }
 
+/** Note that an IO request has completed.
+@param[in,out]	slot	the completed request
+@param[in]	n_bytes	number of bytes read or written
+@param[in]	ret	0, or a negative errno */
+void
+LinuxAIOHandler::completed(Slot* slot, ssize_t n_bytes, int ret)
+{
+	ut_a(slot->is_reserved);
+
+	/* Deallocate unused blocks from file system.
+	This is newer done to page 0 or to log files.*/
+	if (slot->offset > 0
+	    && !slot->type.is_log()
+	    && slot->type.is_write()
+	    && slot->type.punch_hole()) {
+
+		slot->err = slot->type.punch_hole(
+			slot->file,
+			slot->offset, slot->len);
+	} else {
+		slot->err = DB_SUCCESS;
+	}
+
+	/* Mark this request as completed. The error handling
+	will be done in the calling function. */
+	m_array->acquire();
+
+	slot->ret = ret;
+	slot->io_already_done = true;
+	slot->n_bytes = n_bytes;
+
+	m_array->release();
+}
+
+#ifdef LINUX_IO_URING
+/** Wait for completed IO requests on an io_uring.
+@param[in,out]	uring	the io_uring of m_segment */
+void
+LinuxAIOHandler::collect(URing* uring)
+{
+	io_uring_cqe	cqes[64];
+
+	int	ret = uring->reap(cqes, array_elements(cqes));
+
+	if (ret < 0) {
+		ib::fatal()
+			<< "Unexpected ret_code[" << ret
+			<< "] from io_uring_enter()!";
+	}
+
+	for (int i = 0; i < ret; ++i) {
+		Slot*	slot = reinterpret_cast<Slot*>(cqes[i].user_data);
+
+		if (slot == NULL) {
+			/* A no-op from AIO::uring_wake_at_shutdown() */
+			continue;
+		}
+
+		ut_a(slot->pos >= m_segment * m_n_slots);
+		ut_a(slot->pos < (m_segment + 1) * m_n_slots);
+
+		if (cqes[i].res < 0) {
+			completed(slot, 0, cqes[i].res);
+		} else {
+			completed(slot, cqes[i].res, 0);
+		}
+	}
+}
+#endif /* LINUX_IO_URING */
+
 /** Process a Linux AIO request
 @param[out]	m1		the messages passed with the
 @param[out]	m2		AIO request; note that in case the
@@ -2137,6 +2490,18 @@ AIO::linux_dispatch(Slot* slot)
 
 	io_ctx_index = (slot->pos * m_n_segments) / m_slots.size();
 
+#ifdef LINUX_IO_URING
+	if (m_uring) {
+		int	ret = m_uring[io_ctx_index].submit(slot);
+
+		if (ret) {
+			errno = -ret;
+		}
+
+		return(!ret);
+	}
+#endif /* LINUX_IO_URING */
+
 	int	ret = io_submit(m_aio_ctx[io_ctx_index], 1, &iocb);
 
 	/* io_submit() returns number of successfully queued requests
@@ -2234,25 +2599,17 @@ AIO::linux_create_io_ctx(
 	return(false);
 }
 
-/** Checks if the system supports native linux aio. On some kernel
-versions where native aio is supported it won't work on tmpfs. In such
-cases we can't use native aio as it is not possible to mix simulated
-and native aio.
-@return: true if supported, false otherwise. */
-bool
-AIO::is_linux_native_aio_supported()
+/** Open a file for checking whether asynchronous I/O works: a temporary
+file in tmpdir, or ib_logfile0 in read-only mode.
+@param[out]	name	buffer of 1000 bytes for the file name
+@return file descriptor, or -1 on failure */
+static
+int
+os_aio_open_check_file(char* name)
 {
-	int		fd;
-	io_context_t	io_ctx;
-	char		name[1000];
+	int	fd;
 
-	if (!linux_create_io_ctx(1, &io_ctx)) {
-
-		/* The platform does not support native aio. */
-
-		return(false);
-
-	} else if (!srv_read_only_mode) {
+	if (!srv_read_only_mode) {
 
 		/* Now check if tmpdir supports native aio ops. */
 		fd = innobase_mysql_tmpfile(NULL);
@@ -2261,39 +2618,153 @@ AIO::is_linux_native_aio_supported()
 			ib::warn()
 				<< "Unable to create temp file to check"
 				" native AIO support.";
-
-			return(false);
 		}
-	} else {
 
-		os_normalize_path(srv_log_group_home_dir);
+		return(fd);
+	}
 
-		ulint	dirnamelen = strlen(srv_log_group_home_dir);
+	os_normalize_path(srv_log_group_home_dir);
 
-		ut_a(dirnamelen < (sizeof name) - 10 - sizeof "ib_logfile");
+	ulint	dirnamelen = strlen(srv_log_group_home_dir);
 
-		memcpy(name, srv_log_group_home_dir, dirnamelen);
+	ut_a(dirnamelen < 1000 - 10 - sizeof "ib_logfile");
 
-		/* Add a path separator if needed. */
-		if (dirnamelen && name[dirnamelen - 1] != OS_PATH_SEPARATOR) {
+	memcpy(name, srv_log_group_home_dir, dirnamelen);
 
-			name[dirnamelen++] = OS_PATH_SEPARATOR;
-		}
+	/* Add a path separator if needed. */
+	if (dirnamelen && name[dirnamelen - 1] != OS_PATH_SEPARATOR) {
 
-		strcpy(name + dirnamelen, "ib_logfile0");
+		name[dirnamelen++] = OS_PATH_SEPARATOR;
+	}
 
-		fd = open(name, O_RDONLY | O_CLOEXEC);
+	strcpy(name + dirnamelen, "ib_logfile0");
 
-		if (fd == -1) {
+	fd = open(name, O_RDONLY | O_CLOEXEC);
 
-			ib::warn()
-				<< "Unable to open"
-				<< " \"" << name << "\" to check native"
-				<< " AIO read support.";
+	if (fd == -1) {
 
-			return(false);
+		ib::warn()
+			<< "Unable to open"
+			<< " \"" << name << "\" to check native"
+			<< " AIO read support.";
+	}
+
+	return(fd);
+}
+
+#ifdef LINUX_IO_URING
+/** Checks if the system supports io_uring with
+IORING_OP_READ and IORING_OP_WRITE.
+@return true if supported, false otherwise. */
+bool
+AIO::is_io_uring_supported()
+{
+	URing	uring;
+	char	name[1000];
+
+	if (!uring.create(1)) {
+		ib::warn() << "io_uring_setup() failed with errno "
+			   << errno << ".";
+		return(false);
+	}
+
+	int	fd = os_aio_open_check_file(name);
+
+	if (fd < 0) {
+		uring.close();
+		return(false);
+	}
+
+	byte*	buf = static_cast<byte*>(ut_malloc_nokey(srv_page_size * 2));
+	byte*	ptr = static_cast<byte*>(ut_align(buf, srv_page_size));
+
+	memset(buf, 0x00, srv_page_size * 2);
+
+	Slot	slot = Slot();
+
+	slot.type = IORequest(srv_read_only_mode
+			      ? IORequest::READ : IORequest::WRITE);
+	slot.file = fd;
+	slot.ptr = ptr;
+	slot.len = srv_read_only_mode ? 512 : srv_page_size;
+
+	int		ret = uring.submit(&slot);
+	io_uring_cqe	cqe;
+
+	if (!ret) {
+		ret = uring.reap(&cqe, 1);
+	}
+
+	if (ret == 1) {
+		/* An unsupported opcode would fail with EINVAL. */
+		ret = cqe.res < 0 ? cqe.res : 1;
+	}
+
+	ut_free(buf);
+	close(fd);
+	uring.close();
+
+	if (ret == 1) {
+		return(true);
+	}
+
+	ib::warn() << "io_uring check on "
+		   << (srv_read_only_mode ? name : "tmpdir")
+		   << " returned error[" << -ret << "]";
+
+	return(false);
+}
+
+/** Wake up all i/o handler threads that wait for io_uring
+completions, so that they can notice the shutdown. */
+void
+AIO::uring_wake_at_shutdown()
+{
+	AIO*	all_arrays[] = {s_reads, s_writes, s_log, s_ibuf};
+
+	for (size_t i = 0; i < array_elements(all_arrays); i++) {
+		AIO*	a = all_arrays[i];
+
+		if (a == NULL || a->m_uring == NULL) {
+			continue;
+		}
+
+		for (ulint segment = 0; segment < a->m_n_segments;
+		     segment++) {
+			/* If this fails, the thread will notice the
+			shutdown on the next completed request. */
+			int	ret = a->m_uring[segment].submit(NULL);
+			ut_a(ret <= 0);
 		}
 	}
+}
+#endif /* LINUX_IO_URING */
+
+/** Checks if the system supports native linux aio. On some kernel
+versions where native aio is supported it won't work on tmpfs. In such
+cases we can't use native aio as it is not possible to mix simulated
+and native aio.
+@return: true if supported, false otherwise. */
+bool
+AIO::is_linux_native_aio_supported()
+{
+	int		fd;
+	io_context_t	io_ctx;
+	char		name[1000];
+
+	if (!linux_create_io_ctx(1, &io_ctx)) {
+
+		/* The platform does not support native aio. */
+
+		return(false);
+
+	}
+
+	fd = os_aio_open_check_file(name);
+
+	if (fd < 0) {
+		return(false);
+	}
 
 	struct io_event	io_event;
 
@@ -5711,6 +6182,9 @@ AIO::AIO(
 # ifdef LINUX_NATIVE_AIO
 	,m_aio_ctx(),
 	m_events(m_slots.size())
+#  ifdef LINUX_IO_URING
+	,m_uring()
+#  endif /* LINUX_IO_URING */
 # endif /* LINUX_NATIVE_AIO */
 #ifdef WIN_ASYNC_IO
 	,m_completion_port(new_completion_port())
@@ -5766,6 +6240,39 @@ AIO::init_slots()
 dberr_t
 AIO::init_linux_native_aio()
 {
+#ifdef LINUX_IO_URING
+	if (srv_use_io_uring) {
+		/* Create one io_uring per segment in the array. */
+		ut_a(m_uring == NULL);
+
+		m_uring = static_cast<URing*>(
+			ut_zalloc_nokey(m_n_segments * sizeof *m_uring));
+
+		if (m_uring == NULL) {
+			return(DB_OUT_OF_MEMORY);
+		}
+
+		for (ulint i = 0; i < m_n_segments; ++i) {
+			if (!m_uring[i].create(unsigned(
+					slots_per_segment()))) {
+				ib::warn() << "io_uring_setup() failed with"
+					" errno " << errno << "; using"
+					" libaio for this AIO array.";
+				while (i--) {
+					m_uring[i].close();
+				}
+				ut_free(m_uring);
+				m_uring = NULL;
+				break;
+			}
+		}
+
+		if (m_uring != NULL) {
+			return(DB_SUCCESS);
+		}
+	}
+#endif /* LINUX_IO_URING */
+
 	/* Initialize the io_context array. One io_context
 	per segment in the array. */
 
@@ -5880,6 +6387,14 @@ AIO::~AIO()
 		m_events.clear();
 		ut_free(m_aio_ctx);
 	}
+# ifdef LINUX_IO_URING
+	if (m_uring != NULL) {
+		for (ulint i = 0; i < m_n_segments; ++i) {
+			m_uring[i].close();
+		}
+		ut_free(m_uring);
+	}
+# endif /* LINUX_IO_URING */
 #endif /* LINUX_NATIVE_AIO */
 #if defined(WIN_ASYNC_IO)
 	CloseHandle(m_completion_port);
@@ -5908,8 +6423,22 @@ AIO::start(
 	ulint		n_slots_sync)
 {
 #if defined(LINUX_NATIVE_AIO)
+# ifdef LINUX_IO_URING
+	if (!srv_use_native_aio) {
+		srv_use_io_uring = FALSE;
+	} else if (srv_use_io_uring) {
+		if (is_io_uring_supported()) {
+			ib::info() << "Using io_uring";
+		} else {
+			ib::warn() << "io_uring disabled; using libaio";
+			srv_use_io_uring = FALSE;
+		}
+	}
+# endif /* LINUX_IO_URING */
+
 	/* Check if native aio is supported on this system and tmpfs */
-	if (srv_use_native_aio && !is_linux_native_aio_supported()) {
+	if (srv_use_native_aio && !srv_use_io_uring
+	    && !is_linux_native_aio_supported()) {
 
 		ib::warn() << "Linux Native AIO disabled.";
 
@@ -6091,7 +6620,11 @@ os_aio_wake_all_threads_at_shutdown()
 	/* When using native AIO interface the io helper threads
 	wait on io_getevents with a timeout value of 500ms. At
 	each wake up these threads check the server status.
-	No need to do anything to wake them up. */
+	No need to do anything to wake them up. With io_uring,
+	the threads wait without a timeout. */
+# ifdef LINUX_IO_URING
+	AIO::uring_wake_at_shutdown();
+# endif /* LINUX_IO_URING */
 #endif /* !WIN_ASYNC_AIO */
 
 	if (srv_use_native_aio) {
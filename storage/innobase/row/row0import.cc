@@ -50,10 +50,11 @@ Created 2012-02-08 by Sunny Bains.
 #include <my_aes.h>
 #endif
 
-/** The size of the buffer to use for IO.
+/** The size of the buffer to use for IO. Large sequential reads and
+writes keep the storage busy while the pages are being converted.
 @param n physical page size
 @return number of pages */
-#define IO_BUFFER_SIZE(n)	((1024 * 1024) / n)
+#define IO_BUFFER_SIZE(n)	((4 * 1024 * 1024) / n)
 
 /** For gathering stats on records during phase I */
 struct row_stats_t {
@@ -3485,6 +3486,7 @@ fil_iterate(
 					    src,
 					    page_compress_buf,
 					    0,/* FIXME: compression level */
+					    0,/* innodb_compression_algorithm */
 					    512,/* FIXME: proper block size */
 					    encrypted)) {
 					/* FIXME: remove memcpy() */
@@ -3678,6 +3680,13 @@ fil_tablespace_iterate(
 			block->page.zip.data = block->frame + srv_page_size;
 		}
 
+#ifdef POSIX_FADV_SEQUENTIAL
+		/* Each page will be read exactly once, in ascending
+		order. Let the kernel read ahead while we are converting
+		the previously read pages. */
+		posix_fadvise(file, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif /* POSIX_FADV_SEQUENTIAL */
+
 		err = fil_iterate(iter, block, callback);
 
 		if (iter.crypt_data) {
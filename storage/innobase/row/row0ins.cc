@@ -2531,6 +2531,61 @@ row_ins_index_entry_big_rec(
 	return(error);
 }
 
+/** Determine if an insert into an empty table may be turned into a bulk
+insert that writes a single TRX_UNDO_EMPTY record instead of logging
+each row. This is only possible when the SQL statement cannot be
+partially rolled back (no IGNORE or REPLACE), and when the user
+explicitly disabled the checks that could raise errors in the middle of
+the statement (SET unique_checks=0, foreign_key_checks=0).
+A temporary table is only visible to the current connection and cannot
+be part of a FOREIGN KEY relationship, so emptying it is always a correct
+statement rollback and the checks do not matter.
+@param[in]	trx	transaction
+@param[in]	index	clustered index
+@return whether the bulk insert may be started */
+static
+bool
+row_ins_bulk_insert_possible(const trx_t* trx, const dict_index_t* index)
+{
+	const dict_table_t*	table = index->table;
+
+	if ((!table->is_temporary()
+	     && (trx->check_unique_secondary || trx->check_foreigns))
+	    || trx->duplicates || !trx->mysql_thd || trx->ddl
+	    || trx->internal || trx->dict_operation != TRX_DICT_OP_NONE
+	    || table->skip_alter_undo
+	    || table->fts || table->versioned() || index->is_instant()
+	    || table->space == fil_system.sys_space) {
+		return false;
+	}
+
+	for (const dict_index_t* i = index; i;
+	     i = dict_table_get_next_index(i)) {
+		if (dict_index_is_online_ddl(i)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/** Determine if the current SQL statement is inserting into
+an initially empty table without undo logging.
+@param[in]	trx	transaction
+@param[in]	table	table
+@return whether trx_undo_report_empty() was invoked */
+static
+bool
+row_ins_is_bulk_insert(const trx_t* trx, dict_table_t* table)
+{
+	if (!trx->bulk_insert) {
+		return false;
+	}
+
+	trx_mod_tables_t::const_iterator i = trx->mod_tables.find(table);
+	return i != trx->mod_tables.end() && i->second.is_bulk_insert();
+}
+
 /***************************************************************//**
 Tries to insert an entry into a clustered index, ignoring foreign key
 constraints. If a record with the same unique key is found, the other
@@ -2567,6 +2622,7 @@ row_ins_clust_index_entry_low(
 	mem_heap_t*	offsets_heap	= NULL;
 	ulint           offsets_[REC_OFFS_NORMAL_SIZE];
 	ulint*          offsets         = offsets_;
+	bool		table_locked	= false;
 	rec_offs_init(offsets_);
 
 	DBUG_ENTER("row_ins_clust_index_entry_low");
@@ -2577,6 +2633,12 @@ row_ins_clust_index_entry_low(
 	ut_ad(!n_uniq || n_uniq == dict_index_get_n_unique(index));
 	ut_ad(!thr_get_trx(thr)->in_rollback);
 
+	if (!(flags & BTR_NO_UNDO_LOG_FLAG)
+	    && row_ins_is_bulk_insert(thr_get_trx(thr), index->table)) {
+		flags |= BTR_NO_UNDO_LOG_FLAG | BTR_NO_LOCKING_FLAG;
+	}
+
+restart:
 	mtr_start(&mtr);
 
 	if (index->table->is_temporary()) {
@@ -2647,6 +2709,34 @@ row_ins_clust_index_entry_low(
 	}
 #endif /* UNIV_DEBUG */
 
+	if (!(flags & BTR_NO_UNDO_LOG_FLAG)
+	    && page_is_empty(btr_cur_get_page(cursor))
+	    && btr_cur_get_block(cursor)->page.id.page_no() == index->page
+	    && !entry->info_bits && !dup_chk_only
+	    && row_ins_bulk_insert_possible(thr_get_trx(thr), index)) {
+		/* The table is empty. Instead of writing an undo log
+		record for every row, lock the table exclusively and
+		write a single record that will empty the table on
+		rollback. */
+		if (!table_locked) {
+			mtr.commit();
+			err = lock_table(0, index->table, LOCK_X, thr);
+			if (err != DB_SUCCESS) {
+				goto func_exit;
+			}
+			/* Check again that the table is empty. */
+			table_locked = true;
+			goto restart;
+		}
+
+		err = trx_undo_report_empty(thr_get_trx(thr), index->table);
+		if (err != DB_SUCCESS) {
+			goto err_exit;
+		}
+
+		flags |= BTR_NO_UNDO_LOG_FLAG | BTR_NO_LOCKING_FLAG;
+	}
+
 	if (UNIV_UNLIKELY(entry->info_bits != 0)) {
 		ut_ad(entry->is_metadata());
 		ut_ad(flags == BTR_NO_LOCKING_FLAG);
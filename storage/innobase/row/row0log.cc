@@ -1716,10 +1716,22 @@ row_log_table_apply_insert_low(
 
 	entry = row_build_index_entry(row, NULL, index, heap);
 
+	/* Like row_ins_clust_index_entry(), try an optimistic descent
+	first, so that most replayed inserts only latch a leaf page
+	instead of the whole path and index->lock. */
+	const ulint	orig_n_fields = entry->n_fields;
+
 	error = row_ins_clust_index_entry_low(
-		flags, BTR_MODIFY_TREE, index, index->n_uniq,
+		flags, BTR_MODIFY_LEAF, index, index->n_uniq,
 		entry, 0, thr, false);
 
+	if (error == DB_FAIL) {
+		entry->n_fields = orig_n_fields;
+		error = row_ins_clust_index_entry_low(
+			flags, BTR_MODIFY_TREE, index, index->n_uniq,
+			entry, 0, thr, false);
+	}
+
 	switch (error) {
 	case DB_SUCCESS:
 		break;
@@ -1740,10 +1752,17 @@ row_log_table_apply_insert_low(
 
 		entry = row_build_index_entry(row, NULL, index, heap);
 		error = row_ins_sec_index_entry_low(
-			flags, BTR_MODIFY_TREE,
+			flags, BTR_MODIFY_LEAF,
 			index, offsets_heap, heap, entry,
 			thr_get_trx(thr)->id, thr, false);
 
+		if (error == DB_FAIL) {
+			error = row_ins_sec_index_entry_low(
+				flags, BTR_MODIFY_TREE,
+				index, offsets_heap, heap, entry,
+				thr_get_trx(thr)->id, thr, false);
+		}
+
 		if (error != DB_SUCCESS) {
 			if (error == DB_DUPLICATE_KEY) {
 				thr_get_trx(thr)->error_key_num = n_index;
@@ -2363,13 +2382,23 @@ row_log_table_apply_update(
 
 		mtr_commit(&mtr);
 
+		static const ulint	flags
+			= (BTR_CREATE_FLAG
+			   | BTR_NO_LOCKING_FLAG
+			   | BTR_NO_UNDO_LOG_FLAG
+			   | BTR_KEEP_SYS_FLAG);
+
 		entry = row_build_index_entry(row, NULL, index, heap);
 		error = row_ins_sec_index_entry_low(
-			BTR_CREATE_FLAG | BTR_NO_LOCKING_FLAG
-			| BTR_NO_UNDO_LOG_FLAG | BTR_KEEP_SYS_FLAG,
-			BTR_MODIFY_TREE, index, offsets_heap, heap,
+			flags, BTR_MODIFY_LEAF, index, offsets_heap, heap,
 			entry, thr_get_trx(thr)->id, thr, false);
 
+		if (error == DB_FAIL) {
+			error = row_ins_sec_index_entry_low(
+				flags, BTR_MODIFY_TREE, index, offsets_heap,
+				heap, entry, thr_get_trx(thr)->id, thr, false);
+		}
+
 		/* Report correct index name for duplicate key error. */
 		if (error == DB_DUPLICATE_KEY) {
 			thr_get_trx(thr)->error_key_num = n_index;
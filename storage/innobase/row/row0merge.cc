@@ -143,6 +143,8 @@ class index_tuple_info_t {
 			log_sys.check_flush_or_checkpoint = true;
 		);
 
+		sort_on_hilbert_curve();
+
 		for (idx_tuple_vec::iterator it = m_dtuple_vec->begin();
 		     it != m_dtuple_vec->end();
 		     ++it) {
@@ -251,6 +253,101 @@ class index_tuple_info_t {
 	}
 
 private:
+	/** Map a point to its position on a Hilbert curve.
+	@param[in]	x	x coordinate, on a 65536x65536 grid
+	@param[in]	y	y coordinate, on a 65536x65536 grid
+	@return	distance from the start of the curve */
+	static uint64_t hilbert_distance(uint32_t x, uint32_t y)
+	{
+		uint64_t	d = 0;
+
+		for (uint32_t s = 1U << 15; s; s >>= 1) {
+			const uint32_t	rx = !!(x & s);
+			const uint32_t	ry = !!(y & s);
+
+			d += uint64_t(s) * s * ((3 * rx) ^ ry);
+
+			if (!ry) {
+				if (rx) {
+					x = 0xFFFF - x;
+					y = 0xFFFF - y;
+				}
+				std::swap(x, y);
+			}
+		}
+
+		return(d);
+	}
+
+	/** Sort the cached rows by the Hilbert curve position of the
+	centre of their minimum bounding rectangle. Rows that are close
+	in space will then be inserted one after another, so that the
+	R-tree descents keep hitting the same pages, and page splits
+	produce tighter MBRs than with the clustered index order. */
+	void sort_on_hilbert_curve() UNIV_NOTHROW
+	{
+		const ulint	n = m_dtuple_vec->size();
+
+		if (n < 3) {
+			return;
+		}
+
+		typedef std::pair<uint64_t, dtuple_t*>	hilbert_key;
+		std::vector<hilbert_key, ut_allocator<hilbert_key> >	keys;
+		keys.reserve(n);
+
+		rtr_mbr_t	mbr;
+		double		xmin = DBL_MAX, xmax = -DBL_MAX;
+		double		ymin = DBL_MAX, ymax = -DBL_MAX;
+
+		for (ulint i = 0; i < n; i++) {
+			rtr_get_mbr_from_tuple((*m_dtuple_vec)[i], &mbr);
+			xmin = std::min(xmin, mbr.xmin + mbr.xmax);
+			xmax = std::max(xmax, mbr.xmin + mbr.xmax);
+			ymin = std::min(ymin, mbr.ymin + mbr.ymax);
+			ymax = std::max(ymax, mbr.ymin + mbr.ymax);
+		}
+
+		const double	xscale = xmax > xmin
+			? 65535 / (xmax - xmin) : 0;
+		const double	yscale = ymax > ymin
+			? 65535 / (ymax - ymin) : 0;
+
+		if (!(xscale > 0 || yscale > 0)) {
+			/* All centres coincide, or the MBRs are not
+			finite. */
+			return;
+		}
+
+		for (ulint i = 0; i < n; i++) {
+			dtuple_t*	dtuple = (*m_dtuple_vec)[i];
+			rtr_get_mbr_from_tuple(dtuple, &mbr);
+			const double	x = (mbr.xmin + mbr.xmax - xmin)
+				* xscale;
+			const double	y = (mbr.ymin + mbr.ymax - ymin)
+				* yscale;
+			keys.push_back(hilbert_key(hilbert_distance(
+						     x >= 0 && x <= 65535
+						     ? uint32_t(x) : 0,
+						     y >= 0 && y <= 65535
+						     ? uint32_t(y) : 0),
+					     dtuple));
+		}
+
+		std::stable_sort(keys.begin(), keys.end(), key_less);
+
+		for (ulint i = 0; i < n; i++) {
+			(*m_dtuple_vec)[i] = keys[i].second;
+		}
+	}
+
+	/** Compare the Hilbert curve positions of two rows */
+	static bool key_less(const std::pair<uint64_t, dtuple_t*>& a,
+			     const std::pair<uint64_t, dtuple_t*>& b)
+	{
+		return(a.first < b.first);
+	}
+
 	/** Cache index rows made from a cluster index scan. Usually
 	for rows on single cluster index page */
 	typedef std::vector<dtuple_t*, ut_allocator<dtuple_t*> >
@@ -3371,8 +3468,9 @@ row_merge_sort(
 	sol10-64 in buildbot.
 	*/
 #ifndef UNIV_SOLARIS
-	/* Progress report only for "normal" indexes. */
-	if (!(dup->index->type & DICT_FTS)) {
+	/* Progress report only for "normal" indexes, and not
+	from the index build threads. */
+	if (update_progress && !(dup->index->type & DICT_FTS)) {
 		thd_progress_init(trx->mysql_thd, 1);
 	}
 #endif /* UNIV_SOLARIS */
@@ -3389,7 +3487,7 @@ row_merge_sort(
 		show processlist progress field */
 		/* Progress report only for "normal" indexes. */
 #ifndef UNIV_SOLARIS
-		if (!(dup->index->type & DICT_FTS)) {
+		if (update_progress && !(dup->index->type & DICT_FTS)) {
 			thd_progress_report(trx->mysql_thd, file->offset - num_runs, file->offset);
 		}
 #endif /* UNIV_SOLARIS */
@@ -3418,7 +3516,7 @@ row_merge_sort(
 
 	/* Progress report only for "normal" indexes. */
 #ifndef UNIV_SOLARIS
-	if (!(dup->index->type & DICT_FTS)) {
+	if (update_progress && !(dup->index->type & DICT_FTS)) {
 		thd_progress_end(trx->mysql_thd);
 	}
 #endif /* UNIV_SOLARIS */
@@ -4544,6 +4642,127 @@ row_merge_write_redo(
 	mtr.commit();
 }
 
+/** A secondary index that is sorted and loaded by an index build thread */
+struct row_merge_build_task_t {
+	/** the index being created */
+	dict_index_t*	index;
+	/** the file containing the index entries */
+	merge_file_t*	file;
+	/** the outcome */
+	dberr_t		error;
+};
+
+/** State shared by the index build threads */
+struct row_merge_build_t {
+	/** the indexes to build */
+	row_merge_build_task_t*	tasks;
+	/** number of elements in tasks[] */
+	ulint			n_tasks;
+	/** index of the next task, updated by my_atomic_addlint() */
+	ulint			next;
+	/** number of running threads */
+	ulint			n_threads;
+	/** set when the last thread exits */
+	os_event_t		done;
+	/** transaction */
+	trx_t*			trx;
+	/** MySQL table */
+	struct TABLE*		table;
+	/** mapping of old column numbers to new ones, or NULL */
+	const ulint*		col_map;
+	/** table where rows are read from */
+	const dict_table_t*	old_table;
+	/** tablespace identifier of the indexes */
+	ulint			space_id;
+	/** flush observer, or NULL */
+	FlushObserver*		flush_observer;
+	/** directory for temporary files, or NULL */
+	const char*		path;
+	/** the value of onlineddl_pct_progress when the threads started */
+	double			pct_progress;
+};
+
+/** Sort and load secondary indexes, on behalf of row_merge_build_indexes().
+Each thread has its own merge buffers and temporary file. Progress is
+not reported, because the THD may only be accessed by its own thread.
+@param[in,out]	arg	row_merge_build_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_merge_build_thread)(void* arg)
+{
+	my_thread_init();
+
+	row_merge_build_t*		b = static_cast<row_merge_build_t*>(arg);
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	ut_new_pfx_t			block_pfx;
+	ut_new_pfx_t			crypt_pfx;
+	const size_t			block_size = 3 * srv_sort_buf_size;
+	row_merge_block_t*		block = alloc.allocate_large(
+		block_size, &block_pfx);
+	row_merge_block_t*		crypt_block = NULL;
+	pfs_os_file_t			tmpfd = OS_FILE_CLOSED;
+
+	if (block && log_tmp_is_encrypted()) {
+		crypt_block = alloc.allocate_large(block_size, &crypt_pfx);
+	}
+
+	for (ulint i; (i = my_atomic_addlint(&b->next, 1)) < b->n_tasks; ) {
+		row_merge_build_task_t*	task = &b->tasks[i];
+
+		if (!block || (log_tmp_is_encrypted() && !crypt_block)) {
+			task->error = DB_OUT_OF_MEMORY;
+			continue;
+		}
+
+		if (!row_merge_tmpfile_if_needed(&tmpfd, b->path)) {
+			task->error = DB_OUT_OF_MEMORY;
+			continue;
+		}
+
+		row_merge_dup_t	dup = {task->index, b->table, b->col_map, 0};
+
+		dberr_t	error = row_merge_sort(
+			b->trx, &dup, task->file, block, &tmpfd, false,
+			b->pct_progress, 0, crypt_block, b->space_id);
+
+		if (error == DB_SUCCESS) {
+			BtrBulk	btr_bulk(task->index, b->trx,
+					 b->flush_observer);
+
+			error = row_merge_insert_index_tuples(
+				task->index, b->old_table, task->file->fd,
+				block, NULL, &btr_bulk, task->file->n_rec,
+				b->pct_progress, 0, crypt_block,
+				b->space_id, NULL);
+
+			error = btr_bulk.finish(error);
+		}
+
+		task->error = error;
+	}
+
+	row_merge_file_destroy_low(tmpfd);
+
+	if (block) {
+		alloc.deallocate_large(block, &block_pfx, block_size);
+	}
+
+	if (crypt_block) {
+		alloc.deallocate_large(crypt_block, &crypt_pfx, block_size);
+	}
+
+	if (my_atomic_addlint(&b->n_threads, ulint(-1)) == 1) {
+		os_event_set(b->done);
+	}
+
+	my_thread_end();
+
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /** Build indexes on a table by reading a clustered index, creating a temporary
 file containing index entries, merge sorting these index entries and inserting
 sorted index entries to indexes.
@@ -4608,6 +4827,9 @@ row_merge_build_indexes(
 	fts_psort_t*		merge_info = NULL;
 	int64_t			sig_count = 0;
 	bool			fts_psort_initiated = false;
+	row_merge_build_task_t*	build_tasks = NULL;
+	ulint			n_build_tasks = 0;
+	ulint			next_build_task = 0;
 
 	double total_static_cost = 0;
 	double total_dynamic_cost = 0;
@@ -4784,6 +5006,79 @@ row_merge_build_indexes(
 	/* Now we have files containing index entries ready for
 	sorting and inserting. */
 
+	if (srv_index_build_threads > 1) {
+		/* Sort and load non-unique secondary indexes concurrently.
+		Unique indexes are built below, because duplicate keys are
+		reported through the MySQL table. */
+		build_tasks = static_cast<row_merge_build_task_t*>(
+			ut_malloc_nokey(n_indexes * sizeof *build_tasks));
+
+		ulint	n_tasks = 0;
+
+		for (i = 0; i < n_indexes; i++) {
+			if (!(indexes[i]->type
+			      & (DICT_FTS | DICT_SPATIAL | DICT_UNIQUE
+				 | DICT_CLUSTERED))
+			    && merge_files[i].fd != OS_FILE_CLOSED) {
+				row_merge_build_task_t&	task
+					= build_tasks[n_tasks++];
+				task.index = indexes[i];
+				task.file = &merge_files[i];
+				task.error = DB_SUCCESS;
+			}
+		}
+
+		if (n_tasks < 2) {
+			n_tasks = 0;
+		} else {
+			row_merge_build_t	b = {
+				build_tasks, n_tasks, 0,
+				ut_min(n_tasks, ulint(srv_index_build_threads)),
+				os_event_create(0), trx, table, col_map,
+				old_table, new_table->space->id,
+				flush_observer,
+				thd_innodb_tmpdir(trx->mysql_thd),
+				pct_progress
+			};
+
+			if (global_system_variables.log_warnings > 2) {
+				sql_print_information(
+					"InnoDB: Online DDL : Start building "
+					ULINTPF " indexes with " ULINTPF
+					" threads", n_tasks, b.n_threads);
+			}
+
+			for (j = b.n_threads; j--; ) {
+				os_thread_create(row_merge_build_thread, &b,
+						 NULL);
+			}
+
+			os_event_wait(b.done);
+			os_event_destroy(b.done);
+
+			for (j = 0; j < n_tasks; j++) {
+				pct_progress += (COST_BUILD_INDEX_STATIC
+						 + (total_dynamic_cost
+						    * build_tasks[j].file->offset
+						    / total_index_blocks))
+					/ (total_static_cost
+					   + total_dynamic_cost)
+					* (PCT_COST_MERGESORT_INDEX
+					   + PCT_COST_INSERT_INDEX) * 100;
+			}
+
+			onlineddl_pct_progress = ulint(pct_progress * 100);
+
+			if (global_system_variables.log_warnings > 2) {
+				sql_print_information(
+					"InnoDB: Online DDL : End of building "
+					ULINTPF " indexes", n_tasks);
+			}
+		}
+
+		n_build_tasks = n_tasks;
+	}
+
 	for (i = 0; i < n_indexes; i++) {
 		dict_index_t*	sort_idx = indexes[i];
 
@@ -4791,7 +5086,11 @@ row_merge_build_indexes(
 			continue;
 		}
 
-		if (indexes[i]->type & DICT_FTS) {
+		if (next_build_task < n_build_tasks
+		    && build_tasks[next_build_task].index == sort_idx) {
+			/* The index was built by row_merge_build_thread() */
+			error = build_tasks[next_build_task++].error;
+		} else if (indexes[i]->type & DICT_FTS) {
 			os_event_t	fts_parallel_merge_event;
 
 			sort_idx = fts_sort_idx;
@@ -5020,6 +5319,7 @@ row_merge_build_indexes(
 	}
 
 	ut_free(merge_files);
+	ut_free(build_tasks);
 
 	alloc.deallocate_large(block, &block_pfx, block_size);
 
@@ -1050,6 +1050,7 @@ row_purge_parse_undo_rec(
 
 	switch (type) {
 	case TRX_UNDO_RENAME_TABLE:
+	case TRX_UNDO_EMPTY:
 		return false;
 	case TRX_UNDO_INSERT_METADATA:
 	case TRX_UNDO_INSERT_REC:
@@ -1302,7 +1303,9 @@ row_purge_end(
 
 	ut_a(thr->run_node != NULL);
 
-	mem_heap_empty(node->heap);
+	/* node->heap will be emptied by trx_purge_attach_undo_recs()
+	when all nodes are done: it may contain undo log records
+	that were assigned to other nodes. */
 }
 
 /***********************************************************//**
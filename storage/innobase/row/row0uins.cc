@@ -409,6 +409,19 @@ static bool row_undo_ins_parse_undo_rec(undo_node_t* node, bool dict_locked)
 	case TRX_UNDO_INSERT_METADATA:
 	case TRX_UNDO_INSERT_REC:
 		break;
+	case TRX_UNDO_EMPTY:
+		if (fil_table_accessible(node->table)) {
+			for (dict_index_t* index = dict_table_get_first_index(
+				     node->table);
+			     index; index = dict_table_get_next_index(index)) {
+				if (index->page != FIL_NULL
+				    && !index->is_corrupted()) {
+					btr_clear(index);
+				}
+			}
+			node->table->stat_n_rows = 0;
+		}
+		goto close_table;
 	case TRX_UNDO_RENAME_TABLE:
 		dict_table_t* table = node->table;
 		ut_ad(!table->is_temporary());
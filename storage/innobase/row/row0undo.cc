@@ -379,6 +379,7 @@ static bool row_undo_rec_get(undo_node_t* node)
 	case TRX_UNDO_RENAME_TABLE:
 		ut_ad(undo == insert || undo == update);
 		/* fall through */
+	case TRX_UNDO_EMPTY:
 	case TRX_UNDO_INSERT_REC:
 		ut_ad(undo == insert || undo == update || undo == temp);
 		node->roll_ptr |= 1ULL << ROLL_PTR_INSERT_FLAG_POS;
@@ -65,6 +65,21 @@ we could get a deadlock. Value of 0 will disable the concurrency check. */
 
 ulong	srv_thread_concurrency	= 0;
 
+/** A thread waiting for permission to enter InnoDB */
+struct srv_conc_slot_t {
+	/** the waiting transaction */
+	trx_t*		trx;
+	/** signalled when the slot has been removed from the queue */
+	os_event_t	event;
+	/** whether a seat in InnoDB was reserved for the thread;
+	false if the thread should enter regardless of the limit */
+	bool		admitted;
+	/** whether the slot is in srv_conc.queue */
+	bool		queued;
+	/** the queue of waiting threads */
+	UT_LIST_NODE_T(srv_conc_slot_t) list;
+};
+
 /** Variables tracking the active and waiting threads. */
 struct srv_conc_t {
 	char		pad[CACHE_LINE_SIZE  - (sizeof(ulint) + sizeof(lint))];
@@ -75,11 +90,37 @@ struct srv_conc_t {
 	/** Number of OS threads waiting in the FIFO for permission to
 	enter InnoDB */
 	ulint	n_waiting;
+
+	/** Mutex protecting queue and last_priority */
+	MY_ALIGNED(CACHE_LINE_SIZE) OSMutex	mutex;
+
+	/** Threads waiting for permission to enter InnoDB. Threads of
+	transactions that hold locks are at the start of the queue;
+	otherwise the order is first in, first out. */
+	UT_LIST_BASE_NODE_T(srv_conc_slot_t)	queue;
+
+	/** The last slot of a transaction that holds locks, or NULL */
+	srv_conc_slot_t*	last_priority;
 };
 
 /* Control variables for tracking concurrency. */
 static srv_conc_t	srv_conc;
 
+/** Initialize the concurrency manager. */
+void srv_conc_init()
+{
+	srv_conc.mutex.init();
+	UT_LIST_INIT(srv_conc.queue, &srv_conc_slot_t::list);
+	srv_conc.last_priority = NULL;
+}
+
+/** Free the concurrency manager. */
+void srv_conc_close()
+{
+	ut_ad(!UT_LIST_GET_LEN(srv_conc.queue));
+	srv_conc.mutex.destroy();
+}
+
 /*********************************************************************//**
 Note that a user thread is entering InnoDB. */
 static
@@ -93,123 +134,159 @@ srv_enter_innodb_with_tickets(
 	trx->n_tickets_to_enter_innodb = srv_n_free_tickets_to_enter;
 }
 
-/*********************************************************************//**
-Handle the scheduling of a user thread that wants to enter InnoDB.  Setting
-srv_adaptive_max_sleep_delay > 0 switches the adaptive sleep calibration to
-ON. When set, we want to wait in the queue for as little time as possible.
-However, very short waits will result in a lot of context switches and that
-is also not desirable. When threads need to sleep multiple times we increment
-os_thread_sleep_delay by one. When we see threads getting a slot without
-waiting and there are no other threads waiting in the queue, we try and reduce
-the wait as much as we can. Currently we reduce it by half each time. If the
-thread only had to wait for one turn before it was able to enter InnoDB we
-decrement it by one. This is to try and keep the sleep time stable around the
-"optimum" sleep time. */
-static
-void
-srv_conc_enter_innodb_with_atomics(
-/*===============================*/
-	trx_t*	trx)			/*!< in/out: transaction that wants
-					to enter InnoDB */
+/** Try to reserve a seat in InnoDB.
+@return whether a seat was reserved */
+static bool srv_conc_reserve()
 {
-	ulint	n_sleeps = 0;
-	ibool	notified_mysql = FALSE;
-
-	ut_a(!trx->declared_to_be_inside_innodb);
+	ulint	n_active = my_atomic_loadlint(&srv_conc.n_active);
 
-	for (;;) {
-		ulint	sleep_in_us;
-#ifdef WITH_WSREP
-		if (wsrep_on(trx->mysql_thd) &&
-		    wsrep_trx_is_aborting(trx->mysql_thd)) {
-			if (wsrep_debug) {
-				ib::info() <<
-					"srv_conc_enter due to MUST_ABORT";
-			}
-			srv_conc_force_enter_innodb(trx);
-			return;
+	while (n_active < srv_thread_concurrency) {
+		if (my_atomic_caslint(&srv_conc.n_active, &n_active,
+				      n_active + 1)) {
+			return(true);
 		}
-#endif /* WITH_WSREP */
-
-		if (srv_thread_concurrency == 0) {
-			if (notified_mysql) {
-				my_atomic_addlint(&srv_conc.n_waiting,
-						  ulint(-1));
-				thd_wait_end(trx->mysql_thd);
-			}
+	}
 
-			return;
-		}
+	return(false);
+}
 
-		if (srv_conc.n_active < srv_thread_concurrency) {
-			ulint	n_active;
+/** Remove a slot from the queue and wake up its thread.
+@param[in,out]	slot		waiting thread
+@param[in]	admitted	whether a seat was reserved for the thread */
+static void srv_conc_dequeue(srv_conc_slot_t* slot, bool admitted)
+{
+	ut_ad(slot->queued);
 
-			/* Check if there are any free tickets. */
-			n_active = my_atomic_addlint(
-				&srv_conc.n_active, 1) + 1;
+	if (slot == srv_conc.last_priority) {
+		srv_conc.last_priority = UT_LIST_GET_PREV(list, slot);
+	}
 
-			if (n_active <= srv_thread_concurrency) {
+	UT_LIST_REMOVE(srv_conc.queue, slot);
+	slot->queued = false;
+	slot->admitted = admitted;
+	os_event_set(slot->event);
+}
 
-				srv_enter_innodb_with_tickets(trx);
+/** Admit waiting threads in queue order while there are free seats.
+If innodb_thread_concurrency=0, admit all waiting threads. */
+static void srv_conc_wake_waiters()
+{
+	srv_conc.mutex.enter();
+
+	while (srv_conc_slot_t* slot = UT_LIST_GET_FIRST(srv_conc.queue)) {
+		if (!srv_thread_concurrency) {
+			srv_conc_dequeue(slot, false);
+		} else if (srv_conc_reserve()) {
+			srv_conc_dequeue(slot, true);
+		} else {
+			break;
+		}
+	}
 
-				if (notified_mysql) {
-					my_atomic_addlint(&srv_conc.n_waiting,
-							  ulint(-1));
-					thd_wait_end(trx->mysql_thd);
-				}
+	srv_conc.mutex.exit();
+}
 
-				if (srv_adaptive_max_sleep_delay > 0) {
-					if (srv_thread_sleep_delay > 20
-					    && n_sleeps == 1) {
+/** Handle the scheduling of a user thread that wants to enter InnoDB.
+If there is no free seat, the thread is appended to a queue and suspended
+until srv_conc_exit_innodb_with_atomics() hands over a seat to it.
+Threads of transactions that hold locks are queued before other threads,
+so that they can release their locks sooner.
+@param[in,out]	trx	transaction that wants to enter InnoDB */
+static
+void
+srv_conc_enter_innodb_with_atomics(
+/*===============================*/
+	trx_t*	trx)
+{
+	ut_a(!trx->declared_to_be_inside_innodb);
 
-						--srv_thread_sleep_delay;
-					}
+	if (!srv_thread_concurrency) {
+		return;
+	}
 
-					if (srv_conc.n_waiting == 0) {
-						srv_thread_sleep_delay >>= 1;
-					}
-				}
+	/* Do not overtake any waiting threads. */
+	if (!my_atomic_loadlint(&srv_conc.n_waiting) && srv_conc_reserve()) {
+		srv_enter_innodb_with_tickets(trx);
+		return;
+	}
 
-				return;
-			}
+#ifdef WITH_WSREP
+	if (wsrep_on(trx->mysql_thd) &&
+	    wsrep_trx_is_aborting(trx->mysql_thd)) {
+		if (wsrep_debug) {
+			ib::info() << "srv_conc_enter due to MUST_ABORT";
+		}
+		srv_conc_force_enter_innodb(trx);
+		return;
+	}
+#endif /* WITH_WSREP */
 
-			/* Since there were no free seats, we relinquish
-			the overbooked ticket. */
+	srv_conc_slot_t	slot;
+	slot.trx = trx;
+	slot.admitted = false;
+	slot.queued = false;
 
-			my_atomic_addlint(&srv_conc.n_active, ulint(-1));
-		}
+	srv_conc.mutex.enter();
 
-		if (!notified_mysql) {
-			my_atomic_addlint(&srv_conc.n_waiting, 1);
+	/* Announce the waiting before checking for a free seat, so that
+	srv_conc_exit_innodb_with_atomics() will either leave a seat
+	for us or find us in the queue. */
+	my_atomic_addlint(&srv_conc.n_waiting, 1);
 
-			thd_wait_begin(trx->mysql_thd, THD_WAIT_USER_LOCK);
+	if (!srv_thread_concurrency
+	    || (!UT_LIST_GET_LEN(srv_conc.queue) && srv_conc_reserve())) {
+		my_atomic_addlint(&srv_conc.n_waiting, ulint(-1));
+		srv_conc.mutex.exit();
 
-			notified_mysql = TRUE;
+		if (srv_thread_concurrency) {
+			srv_enter_innodb_with_tickets(trx);
 		}
 
-		DEBUG_SYNC_C("user_thread_waiting");
-		trx->op_info = "sleeping before entering InnoDB";
+		return;
+	}
+
+	slot.event = os_event_create(0);
+	slot.queued = true;
+
+	if (!UT_LIST_GET_LEN(trx->lock.trx_locks)) {
+		UT_LIST_ADD_LAST(srv_conc.queue, &slot);
+	} else if (srv_conc.last_priority) {
+		UT_LIST_INSERT_AFTER(srv_conc.queue, srv_conc.last_priority,
+				     &slot);
+		srv_conc.last_priority = &slot;
+	} else {
+		UT_LIST_ADD_FIRST(srv_conc.queue, &slot);
+		srv_conc.last_priority = &slot;
+	}
 
-		sleep_in_us = srv_thread_sleep_delay;
+	srv_conc.mutex.exit();
 
-		/* Guard against overflow when adaptive sleep delay is on. */
+	thd_wait_begin(trx->mysql_thd, THD_WAIT_USER_LOCK);
+	DEBUG_SYNC_C("user_thread_waiting");
+	trx->op_info = "waiting to enter InnoDB";
 
-		if (srv_adaptive_max_sleep_delay > 0
-		    && sleep_in_us > srv_adaptive_max_sleep_delay) {
+	for (;;) {
+		srv_conc.mutex.enter();
+		const bool queued = slot.queued;
+		int64_t sig_count = queued ? os_event_reset(slot.event) : 0;
+		srv_conc.mutex.exit();
 
-			sleep_in_us = srv_adaptive_max_sleep_delay;
-			srv_thread_sleep_delay = static_cast<ulong>(sleep_in_us);
+		if (!queued) {
+			break;
 		}
 
-		os_thread_sleep(sleep_in_us);
-
-		trx->op_info = "";
+		os_event_wait_low(slot.event, sig_count);
+	}
 
-		++n_sleeps;
+	trx->op_info = "";
+	thd_wait_end(trx->mysql_thd);
+	os_event_destroy(slot.event);
+	my_atomic_addlint(&srv_conc.n_waiting, ulint(-1));
 
-		if (srv_adaptive_max_sleep_delay > 0 && n_sleeps > 1) {
-			++srv_thread_sleep_delay;
-		}
+	if (slot.admitted) {
+		srv_enter_innodb_with_tickets(trx);
+	} else {
+		srv_conc_force_enter_innodb(trx);
 	}
 }
 
@@ -225,6 +302,10 @@ srv_conc_exit_innodb_with_atomics(
 	trx->declared_to_be_inside_innodb = FALSE;
 
 	my_atomic_addlint(&srv_conc.n_active, ulint(-1));
+
+	if (my_atomic_loadlint(&srv_conc.n_waiting)) {
+		srv_conc_wake_waiters();
+	}
 }
 
 /*********************************************************************//**
@@ -285,6 +366,15 @@ srv_conc_force_exit_innodb(
 	ut_ad(!sync_check_iterate(sync_check()));
 }
 
+/** Wake up waiting threads after innodb_thread_concurrency was changed. */
+void
+srv_conc_update_concurrency()
+{
+	if (my_atomic_loadlint(&srv_conc.n_waiting)) {
+		srv_conc_wake_waiters();
+	}
+}
+
 /*********************************************************************//**
 Get the count of threads waiting inside InnoDB. */
 ulint
@@ -311,25 +401,21 @@ wsrep_srv_conc_cancel_wait(
 	trx_t*	trx)	/*!< in: transaction object associated with the
 			thread */
 {
-#ifdef HAVE_ATOMIC_BUILTINS
-	/* aborting transactions will enter innodb by force in
-	   srv_conc_enter_innodb_with_atomics(). No need to cancel here,
-	   thr will wake up after os_sleep and let to enter innodb
-	*/
-	if (wsrep_debug) {
-		ib::info() << "WSREP: conc slot cancel, no atomics";
-	}
-#else
-	// JAN: TODO: MySQL 5.7
-	//os_fast_mutex_lock(&srv_conc_mutex);
-	if (trx->wsrep_event) {
-		if (wsrep_debug) {
-			ib::info() << "WSREP: conc slot cancel";
+	srv_conc.mutex.enter();
+
+	for (srv_conc_slot_t* slot = UT_LIST_GET_FIRST(srv_conc.queue);
+	     slot != NULL; slot = UT_LIST_GET_NEXT(list, slot)) {
+		if (slot->trx == trx) {
+			if (wsrep_debug) {
+				ib::info() << "WSREP: conc slot cancel";
+			}
+			/* The thread will enter InnoDB by force. */
+			srv_conc_dequeue(slot, false);
+			break;
 		}
-		os_event_set(trx->wsrep_event);
 	}
-	//os_fast_mutex_unlock(&srv_conc_mutex);
-#endif
+
+	srv_conc.mutex.exit();
 }
 #endif /* WITH_WSREP */
 
@@ -946,6 +946,12 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_LOG_PADDED},
 
+	{"log_mtr_blocks_allocated", "recovery",
+	 "Number of mini-transaction memo or log blocks allocated"
+	 " because the per-thread block cache was empty",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_MTR_BUF_BLOCK_ALLOC},
+
 	/* ========== Counters for Page Compression ========== */
 	{"module_compress", "compression", "Page Compression Info",
 	 MONITOR_MODULE,
@@ -1089,6 +1095,18 @@ static monitor_info_t	innodb_counter_info[] =
 	 "Number of Adaptive Hash Index rows updated",
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_ADAPTIVE_HASH_ROW_UPDATED},
+
+	{"adaptive_hash_build_usec", "adaptive_hash_index",
+	 "Time (in microseconds) spent adding index pages to the"
+	 " Adaptive Hash Index",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_ADAPTIVE_HASH_BUILD_MICROSECOND},
+
+	{"adaptive_hash_drop_usec", "adaptive_hash_index",
+	 "Time (in microseconds) spent removing index pages from the"
+	 " Adaptive Hash Index",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_ADAPTIVE_HASH_DROP_MICROSECOND},
 #endif /* BTR_CUR_HASH_ADAPT */
 
 	/* ========== Counters for tablespace ========== */
@@ -1153,6 +1171,18 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_IBUF_SIZE},
 
+	{"ibuf_max_size", "change_buffer",
+	 "Maximum change buffer size in pages",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DISPLAY_CURRENT | MONITOR_DEFAULT_ON),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_IBUF_MAX_SIZE},
+
+	{"ibuf_background_merge_pages", "change_buffer",
+	 "Number of pages read by the master thread to merge"
+	 " buffered changes",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_IBUF_BACKGROUND_MERGE_PAGES},
+
 	/* ========== Counters for server operations ========== */
 	{"module_innodb", "innodb",
 	 "Counter for general InnoDB server wide operations and properties",
@@ -1979,6 +2009,10 @@ srv_mon_process_existing_counter(
 		value = ibuf->size;
 		break;
 
+	case MONITOR_OVLD_IBUF_MAX_SIZE:
+		value = ibuf->max_size;
+		break;
+
 	case MONITOR_OVLD_SERVER_ACTIVITY:
 		value = srv_get_activity_count();
 		break;
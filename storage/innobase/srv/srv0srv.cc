@@ -157,6 +157,8 @@ on duplicate key checking and foreign key checking */
 ibool	srv_locks_unsafe_for_binlog;
 /** Sort buffer size in index creation */
 ulong	srv_sort_buf_size;
+/** innodb_index_build_threads */
+ulong	srv_index_build_threads;
 /** Maximum modification log file size for online index creation */
 unsigned long long	srv_online_max_size;
 
@@ -165,7 +167,11 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 my_bool	srv_use_native_aio;
+/** innodb_use_io_uring */
+my_bool	srv_use_io_uring;
 my_bool	srv_numa_interleave;
+/** innodb_numa_bind */
+my_bool	srv_numa_bind;
 /** copy of innodb_use_atomic_writes; @see innodb_init_params() */
 my_bool	srv_use_atomic_writes;
 /** innodb_compression_algorithm; used with page compression */
@@ -197,6 +203,10 @@ ulong		srv_page_size;
 ulong		srv_page_size_shift;
 /** innodb_log_write_ahead_size */
 ulong		srv_log_write_ahead_size;
+/** innodb_log_concurrent_copy */
+my_bool		srv_log_concurrent_copy;
+/** innodb_log_flush_spin_rounds */
+ulong		srv_log_flush_spin_rounds;
 
 page_size_t	univ_page_size(0, 0, false);
 
@@ -262,9 +272,13 @@ ulong	srv_idle_flush_pct;
 ulong	srv_n_read_io_threads;
 /** innodb_write_io_threads */
 ulong	srv_n_write_io_threads;
+/** innodb_track_changed_pages */
+my_bool	srv_track_changed_pages;
 
 /** innodb_random_read_ahead */
 my_bool	srv_random_read_ahead;
+/** innodb_logical_read_ahead */
+my_bool	srv_logical_read_ahead;
 /** innodb_read_ahead_threshold; the number of pages that must be present
 in the buffer cache and accessed sequentially for InnoDB to trigger a
 readahead request. */
@@ -1010,6 +1024,7 @@ void
 srv_init()
 {
 	mutex_create(LATCH_ID_SRV_INNODB_MONITOR, &srv_innodb_monitor_mutex);
+	srv_conc_init();
 
 	srv_sys.n_sys_threads = srv_read_only_mode
 		? 0
@@ -1086,6 +1101,7 @@ srv_free(void)
 
 	mutex_free(&srv_innodb_monitor_mutex);
 	mutex_free(&page_zip_stat_per_index_mutex);
+	srv_conc_close();
 
 	if (!srv_read_only_mode) {
 		mutex_free(&srv_sys.mutex);
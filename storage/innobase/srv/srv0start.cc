@@ -63,6 +63,7 @@ Created 2/16/1996 Heikki Tuuri
 #include "mtr0mtr.h"
 #include "log0crypt.h"
 #include "log0recv.h"
+#include "log0online.h"
 #include "page0page.h"
 #include "page0cur.h"
 #include "trx0trx.h"
@@ -1848,6 +1849,8 @@ dberr_t srv_start(bool create_new_db)
 		if (err != DB_SUCCESS) {
 			return(srv_init_abort(err));
 		}
+
+		log_online_init();
 	} else {
 		/* We always try to do a recovery, even if the database had
 		been shut down normally: this is the normal startup path */
@@ -2016,6 +2019,8 @@ dberr_t srv_start(bool create_new_db)
 			return(err);
 		}
 
+		log_online_init();
+
 		/* Upgrade or resize or rebuild the redo logs before
 		generating any dirty pages, so that the old redo log
 		files will not be written to. */
@@ -2519,6 +2524,7 @@ void innodb_shutdown()
 	if (ibuf) {
 		ibuf_close();
 	}
+	log_online_close();
 	log_sys.close();
 	purge_sys.close();
 	trx_sys.close();
@@ -230,6 +230,7 @@ rw_lock_create_func(
 	ut_ad(cline <= 8192);
 	lock->cline = cline;
 	lock->count_os_wait = 0;
+	lock->os_wait_time = 0;
 	lock->last_x_file_name = "not yet reserved";
 	lock->last_x_line = 0;
 	lock->event = os_event_create(0);
@@ -277,6 +278,23 @@ rw_lock_free_func(
 	ut_d(lock->magic_n = 0);
 }
 
+/** Suspend the thread on a reserved wait array cell, and add the time
+spent waiting to rw_lock_t::os_wait_time. Reading the clock is cheap
+compared to the context switches of an OS wait.
+@param[in,out]	lock		rw-lock that is being waited for
+@param[in,out]	sync_arr	wait array
+@param[in,out]	cell		reserved cell in sync_arr */
+static inline
+void
+rw_lock_wait(rw_lock_t* lock, sync_array_t* sync_arr, sync_cell_t* cell)
+{
+	const uintmax_t	start = ut_time_us(NULL);
+
+	sync_array_wait_event(sync_arr, cell);
+
+	lock->os_wait_time += ut_time_us(NULL) - start;
+}
+
 /******************************************************************//**
 Lock an rw-lock in shared mode for the current thread. If the rw-lock is
 locked in exclusive mode, or there is an exclusive lock request waiting,
@@ -377,7 +395,7 @@ rw_lock_s_lock_spin(
 		}
 #endif
 #endif
-		sync_array_wait_event(sync_arr, cell);
+		rw_lock_wait(lock, sync_arr, cell);
 
 		i = 0;
 
@@ -458,7 +476,7 @@ rw_lock_x_lock_wait_func(
 					lock, pass, RW_LOCK_X_WAIT,
 					file_name, line));
 
-			sync_array_wait_event(sync_arr, cell);
+			rw_lock_wait(lock, sync_arr, cell);
 
 			ut_d(rw_lock_remove_debug_info(
 					lock, pass, RW_LOCK_X_WAIT));
@@ -735,7 +753,7 @@ rw_lock_x_lock_func(
 
 	++count_os_wait;
 
-	sync_array_wait_event(sync_arr, cell);
+	rw_lock_wait(lock, sync_arr, cell);
 
 	i = 0;
 
@@ -837,7 +855,7 @@ rw_lock_sx_lock_func(
 
 	++count_os_wait;
 
-	sync_array_wait_event(sync_arr, cell);
+	rw_lock_wait(lock, sync_arr, cell);
 
 	i = 0;
 
@@ -43,6 +43,8 @@ Created 3/26/1996 Heikki Tuuri
 #include "trx0trx.h"
 #include <mysql/service_wsrep.h>
 
+#include <map>
+
 /** Maximum allowable purge history length.  <=0 means 'infinite'. */
 ulong		srv_max_purge_lag = 0;
 
@@ -88,19 +90,29 @@ inline bool TrxUndoRsegsIterator::set_next()
 		expected commit done by caller assuming rollback
 		segments from given transaction are done. */
 		purge_sys.tail.commit = (*m_iter)->last_commit;
-	} else if (!purge_sys.purge_queue.empty()) {
+	} else {
+		purge_sys.drain_pending();
+
+		/* Any transaction whose trx_t::no is below the limit of
+		the purge view has completed purge_sys_t::enqueue().
+		Transactions above the limit may still be submitting
+		a smaller trx_t::no than the top of the queue. */
+		if (purge_sys.purge_queue.empty()
+		    || purge_sys.purge_queue.top().trx_no()
+		    >= purge_sys.view.low_limit_no()) {
+			/* Nothing to purge yet, reset iterator. */
+			purge_sys.rseg = NULL;
+			mutex_exit(&purge_sys.pq_mutex);
+			m_rsegs = NullElement;
+			m_iter = m_rsegs.begin();
+			return false;
+		}
+
 		m_rsegs = purge_sys.purge_queue.top();
 		purge_sys.purge_queue.pop();
 		ut_ad(purge_sys.purge_queue.empty()
 		      || purge_sys.purge_queue.top() != m_rsegs);
 		m_iter = m_rsegs.begin();
-	} else {
-		/* Queue is empty, reset iterator. */
-		purge_sys.rseg = NULL;
-		mutex_exit(&purge_sys.pq_mutex);
-		m_rsegs = NullElement;
-		m_iter = m_rsegs.begin();
-		return false;
 	}
 
 	purge_sys.rseg = *m_iter++;
@@ -174,6 +186,7 @@ void purge_sys_t::create()
   hdr_offset= 0;
   rw_lock_create(trx_purge_latch_key, &latch, SYNC_PURGE_LATCH);
   mutex_create(LATCH_ID_PURGE_SYS_PQ, &pq_mutex);
+  n_pending= 0;
   truncate.current= NULL;
   truncate.last= NULL;
 }
@@ -200,6 +213,25 @@ void purge_sys_t::close()
   os_event_destroy(event);
 }
 
+/** Move the submissions of enqueue() to purge_queue. */
+void purge_sys_t::drain_pending()
+{
+  ut_ad(mutex_own(&pq_mutex));
+
+  for (ulint i= 0; my_atomic_load32(&n_pending) && i < TRX_SYS_N_RSEGS; i++)
+  {
+    trx_rseg_t *rseg= trx_sys.rseg_array[i];
+    if (!rseg)
+      continue;
+    if (trx_id_t trx_no= trx_id_t(my_atomic_fas64(
+          reinterpret_cast<int64*>(&rseg->purge_pending), 0)))
+    {
+      purge_queue.push(TrxUndoRsegs(trx_no, *rseg));
+      my_atomic_add32(&n_pending, -1);
+    }
+  }
+}
+
 /*================ UNDO LOG HISTORY LIST =============================*/
 
 /** Prepend the history list with an undo log.
@@ -520,6 +552,7 @@ static void trx_purge_cleanse_purge_queue(const fil_space_t& space)
 	purge_elem_list_t			purge_elem_list;
 
 	mutex_enter(&purge_sys.pq_mutex);
+	purge_sys.drain_pending();
 
 	/* Remove rseg instances that are in the purge queue before we start
 	truncate of corresponding UNDO truncate. */
@@ -1146,6 +1179,14 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 		node->done = FALSE;
 	}
 
+	/* All nodes are done; release the records of the previous batch.
+	A node may have been handed records that were copied to the
+	heap of another node. */
+	for (thr = UT_LIST_GET_FIRST(purge_sys.query->thrs); thr != NULL;
+	     thr = UT_LIST_GET_NEXT(thrs, thr)) {
+		mem_heap_empty(static_cast<purge_node_t*>(thr->child)->heap);
+	}
+
 	/* There should never be fewer nodes than threads, the inverse
 	however is allowed because we only use purge threads as needed. */
 	ut_a(i == n_purge_threads);
@@ -1161,6 +1202,15 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 
 	const ulint batch_size = srv_purge_batch_size;
 
+	/* All records of a table are assigned to the same node, so that
+	the purge threads do not contend for the same index pages.
+	The tables are assigned to the nodes in round-robin fashion. */
+	typedef std::map<table_id_t, que_thr_t*, std::less<table_id_t>,
+			 ut_allocator<std::pair<const table_id_t,
+						que_thr_t*> > >
+		table_thr_map_t;
+	table_thr_map_t	table_thrs;
+
 	for (;;) {
 		purge_node_t*		node;
 		trx_purge_rec_t*	purge_rec;
@@ -1186,6 +1236,24 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 			&purge_rec->roll_ptr, &n_pages_handled, node->heap);
 
 		if (purge_rec->undo_rec != NULL) {
+			bool	advance = true;
+
+			if (purge_rec->undo_rec != &trx_purge_dummy_rec) {
+				std::pair<table_thr_map_t::iterator, bool> p
+					= table_thrs.insert(
+						table_thr_map_t::value_type(
+							trx_undo_rec_get_table_id(
+								purge_rec
+								->undo_rec),
+							thr));
+				if (!p.second) {
+					/* Keep the round-robin position
+					for the next new table. */
+					advance = false;
+					node = static_cast<purge_node_t*>(
+						p.first->second->child);
+				}
+			}
 
 			if (node->undo_recs == NULL) {
 				node->undo_recs = ib_vector_create(
@@ -1202,6 +1270,10 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 
 				break;
 			}
+
+			if (!advance) {
+				continue;
+			}
 		} else {
 			break;
 		}
@@ -2027,6 +2027,117 @@ dberr_t trx_undo_report_rename(trx_t* trx, const dict_table_t* table)
 	return err;
 }
 
+/** Write a TRX_UNDO_EMPTY record.
+@param[in]	trx	transaction
+@param[in]	table	table that is being bulk loaded
+@param[in,out]	block	undo page
+@param[in,out]	mtr	mini-transaction
+@return	byte offset of the undo log record
+@retval	0	in case of failure */
+static
+ulint
+trx_undo_page_report_empty(const trx_t* trx, const dict_table_t* table,
+			   buf_block_t* block, mtr_t* mtr)
+{
+	byte*	ptr_first_free  = TRX_UNDO_PAGE_HDR + TRX_UNDO_PAGE_FREE
+		+ block->frame;
+	ulint	first_free = mach_read_from_2(ptr_first_free);
+	ut_ad(first_free >= TRX_UNDO_PAGE_HDR + TRX_UNDO_PAGE_HDR_SIZE);
+	ut_ad(first_free <= srv_page_size);
+	byte* start = block->frame + first_free;
+
+	if (trx_undo_left(block, start) < 2 + 1 + 11 + 11 + 2) {
+		ut_ad(first_free > TRX_UNDO_PAGE_HDR
+		      + TRX_UNDO_PAGE_HDR_SIZE);
+		return 0;
+	}
+
+	byte* ptr = start + 2;
+	*ptr++ = TRX_UNDO_EMPTY;
+	ptr += mach_u64_write_much_compressed(ptr, trx->undo_no);
+	ptr += mach_u64_write_much_compressed(ptr, table->id);
+	mach_write_to_2(ptr, first_free);
+	ptr += 2;
+	ulint offset = page_offset(ptr);
+	mach_write_to_2(start, offset);
+	mach_write_to_2(ptr_first_free, offset);
+
+	trx_undof_page_add_undo_rec_log(block, first_free, offset, mtr);
+	return first_free;
+}
+
+/** Report that an empty table is about to be bulk loaded without
+undo logging for the individual rows. On rollback, the table will be
+emptied again.
+@param[in,out]	trx	transaction
+@param[in,out]	table	empty table that the transaction locked in X mode
+@return	DB_SUCCESS or error code */
+dberr_t trx_undo_report_empty(trx_t* trx, dict_table_t* table)
+{
+	mtr_t		mtr;
+	dberr_t		err;
+	trx_undo_t**	pundo;
+	trx_rseg_t*	rseg;
+	const bool	is_temp = table->is_temporary();
+
+	mtr.start();
+
+	if (is_temp) {
+		mtr.set_log_mode(MTR_LOG_NO_REDO);
+		rseg = trx->get_temp_rseg();
+		pundo = &trx->rsegs.m_noredo.undo;
+	} else {
+		ut_ad(!trx->read_only);
+		ut_ad(trx->id);
+		rseg = trx->rsegs.m_redo.rseg;
+		pundo = &trx->rsegs.m_redo.undo;
+	}
+
+	if (buf_block_t* block = trx_undo_assign_low(trx, rseg, pundo,
+						     &err, &mtr)) {
+		trx_undo_t*	undo = *pundo;
+		ut_ad(err == DB_SUCCESS);
+		ut_ad(undo);
+		for (ut_d(int loop_count = 0);;) {
+			ut_ad(++loop_count < 2);
+			ut_ad(undo->last_page_no == block->page.id.page_no());
+
+			if (ulint offset = trx_undo_page_report_empty(
+				    trx, table, block, &mtr)) {
+				undo->withdraw_clock = buf_withdraw_clock;
+				undo->top_page_no = undo->last_page_no;
+				undo->top_offset  = offset;
+				undo->top_undo_no = trx->undo_no++;
+				undo->guess_block = block;
+				ut_ad(!undo->empty());
+
+				trx->mod_tables.insert(
+					trx_mod_tables_t::value_type(
+						table, undo->top_undo_no))
+					.first->second.start_bulk_insert();
+				trx->bulk_insert = true;
+				err = DB_SUCCESS;
+				break;
+			} else {
+				mtr.commit();
+				mtr.start();
+				if (is_temp) {
+					mtr.set_log_mode(MTR_LOG_NO_REDO);
+				}
+				block = trx_undo_add_page(undo, &mtr);
+				if (!block) {
+					err = DB_OUT_OF_FILE_SPACE;
+					break;
+				}
+			}
+		}
+
+		mtr.commit();
+	}
+
+	return err;
+}
+
 /***********************************************************************//**
 Writes information to an undo log about an insert, update, or a delete marking
 of a clustered index record. This information is used in a rollback of the
@@ -2073,6 +2184,14 @@ trx_undo_report_row_operation(
 	ut_ad(trx_state_eq(trx, TRX_STATE_ACTIVE));
 	ut_ad(!trx->in_rollback);
 
+	/* Each undo log record is written in a mini-transaction of its
+	own, which is committed before the clustered index record is
+	modified, so that the redo log for the undo log record will
+	precede the change that DB_ROLL_PTR will point from. The undo
+	page must not stay latched across rows either, because
+	consistent reads of old row versions (trx_undo_get_undo_rec())
+	and purge latch the same pages. With undo->guess_block, the
+	buffer pool lookup is cheap. */
 	mtr.start();
 	trx_undo_t**	pundo;
 	trx_rseg_t*	rseg;
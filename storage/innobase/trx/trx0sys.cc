@@ -213,6 +213,8 @@ trx_sys_t::create()
 	mutex_create(LATCH_ID_TRX_SYS, &mutex);
 	UT_LIST_INIT(trx_list, &trx_t::trx_list);
 	my_atomic_store32(&rseg_history_len, 0);
+	my_atomic_store32(&m_snapshot_cache_latch, 0);
+	m_snapshot_cache_id = 0;
 
 	rw_trx_hash.init();
 }
@@ -325,6 +327,7 @@ trx_sys_t::close()
 	}
 
 	rw_trx_hash.destroy();
+	trx_ids_t().swap(m_snapshot_cache_ids);
 
 	/* There can't be any active transactions. */
 
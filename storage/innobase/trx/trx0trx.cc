@@ -130,6 +130,8 @@ trx_init(
 
 	trx->check_unique_secondary = true;
 
+	trx->bulk_insert = false;
+
 	trx->lock.n_rec_locks = 0;
 
 	trx->dict_operation = TRX_DICT_OP_NONE;
@@ -390,6 +392,7 @@ trx_t *trx_create()
 	ut_ad(trx->lock.n_rec_locks == 0);
 	ut_ad(trx->lock.table_cached == 0);
 	ut_ad(trx->lock.rec_cached == 0);
+	ut_ad(!trx->lock.last_rec_lock);
 	ut_ad(UT_LIST_GET_LEN(trx->lock.evicted_tables) == 0);
 
 #ifdef WITH_WSREP
@@ -540,6 +543,7 @@ trx_resurrect_table_locks(
 	page_t*			undo_page;
 	trx_undo_rec_t*		undo_rec;
 	table_id_set		tables;
+	table_id_set		empty_tables;
 
 	ut_ad(trx_state_eq(trx, TRX_STATE_ACTIVE) ||
 	      trx_state_eq(trx, TRX_STATE_PREPARED));
@@ -577,6 +581,9 @@ trx_resurrect_table_locks(
 			undo_rec, &type, &cmpl_info,
 			&updated_extern, &undo_no, &table_id);
 		tables.insert(table_id);
+		if (type == TRX_UNDO_EMPTY) {
+			empty_tables.insert(table_id);
+		}
 
 		undo_rec = trx_undo_get_prev_rec(
 			undo_rec, undo->hdr_page_no,
@@ -602,11 +609,16 @@ trx_resurrect_table_locks(
 					trx_mod_tables_t::value_type(table,
 								     0));
 			}
-			lock_table_ix_resurrect(table, trx);
+			/* The rollback of TRX_UNDO_EMPTY will empty
+			the table, so no other transaction may access it. */
+			const lock_mode mode = empty_tables.count(*i)
+				? LOCK_X : LOCK_IX;
+			lock_table_resurrect(table, trx, mode);
 
 			DBUG_LOG("ib_trx",
 				 "resurrect " << ib::hex(trx->id)
-				 << " IX lock on " << table->name);
+				 << (mode == LOCK_X ? " X" : " IX")
+				 << " lock on " << table->name);
 
 			dict_table_close(table, FALSE, FALSE);
 		}
@@ -1011,19 +1023,17 @@ trx_serialise(trx_t* trx)
 	ut_ad(rseg);
 	ut_ad(mutex_own(&rseg->mutex));
 
-	if (rseg->last_page_no == FIL_NULL) {
-		mutex_enter(&purge_sys.pq_mutex);
-	}
-
 	trx_sys.assign_new_trx_no(trx);
 
 	/* If the rollback segment is not empty then the
 	new trx_t::no can't be less than any trx_t::no
 	already in the rollback segment. User threads only
-	produce events when a rollback segment is empty. */
+	produce events when a rollback segment is empty.
+	The purge coordinator will move the event to
+	purge_sys.purge_queue once trx->no is below the
+	purge view. */
 	if (rseg->last_page_no == FIL_NULL) {
-		purge_sys.purge_queue.push(TrxUndoRsegs(trx->no, *rseg));
-		mutex_exit(&purge_sys.pq_mutex);
+		purge_sys.enqueue(*rseg, trx->no);
 	}
 }
 
@@ -1263,7 +1273,10 @@ void trx_t::evict_table(table_id_t table_id)
 		return;
 	}
 
+	rw_lock_x_lock(&dict_sys->table_hash_latch);
+
 	if (!table->release()) {
+		rw_lock_x_unlock(&dict_sys->table_hash_latch);
 		/* This must be a DDL operation that is being rolled
 		back in an active connection. */
 		ut_a(table->get_ref_count() == 1);
@@ -1277,6 +1290,7 @@ void trx_t::evict_table(table_id_t table_id)
 	const bool locked = UT_LIST_GET_LEN(table->locks);
 	ut_ad(!locked || UT_LIST_GET_FIRST(table->locks)->trx == this);
 	dict_table_remove_from_cache(table, true, locked);
+	rw_lock_x_unlock(&dict_sys->table_hash_latch);
 	if (locked) {
 		UT_LIST_ADD_FIRST(lock.evicted_tables, table);
 	}
@@ -1343,6 +1357,9 @@ trx_commit_in_memory(
 
 		if (trx->read_only || trx->rsegs.m_redo.rseg == NULL) {
 			MONITOR_INC(MONITOR_TRX_RO_COMMIT);
+			/* A bulk insert into a temporary table may
+			have registered the table. */
+			trx->mod_tables.clear();
 		} else {
 			trx_update_mod_tables_timestamp(trx);
 			MONITOR_INC(MONITOR_TRX_RW_COMMIT);
@@ -1757,6 +1774,16 @@ trx_mark_sql_stat_end(
 	case TRX_STATE_ACTIVE:
 		trx->last_sql_stat_start.least_undo_no = trx->undo_no;
 
+		if (trx->bulk_insert) {
+			trx->bulk_insert = false;
+
+			for (trx_mod_tables_t::iterator i
+				     = trx->mod_tables.begin();
+			     i != trx->mod_tables.end(); i++) {
+				i->second.end_bulk_insert();
+			}
+		}
+
 		if (trx->fts_trx != NULL) {
 			fts_savepoint_laststmt_refresh(trx);
 		}
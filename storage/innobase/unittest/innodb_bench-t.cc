@@ -0,0 +1,389 @@
+/*****************************************************************************
+
+Copyright (c) 2018, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file unittest/innodb_bench-t.cc
+Multi-threaded microbenchmarks of InnoDB subsystems.
+
+The subsystems are created in memory only, without any data files or
+background threads, and each workload repeatedly executes one
+operation that is protected by a subsystem-wide latch:
+
+log_sys	append a redo log record in a mini-transaction commit
+lock_sys	look up the record locks of a page under lock_sys.mutex
+trx_sys	register a read-write transaction and open a read view
+page_hash	look up a page in buf_pool->page_hash
+
+Usage: innodb_bench-t [--threads=N] [--iterations=N] [workload...]
+
+For each workload, the throughput and a histogram of the operation
+latency are reported as TAP diagnostics. Without arguments, every
+workload is run briefly, so that the program can be run as a unit test.
+*******************************************************/
+
+#include "univ.i"
+#include "buf0buf.h"
+#include "data0type.h"
+#include "lock0lock.h"
+#include "log0log.h"
+#include "mtr0log.h"
+#include "row0mysql.h"
+#include "srv0srv.h"
+#include "srv0start.h"
+#include "sync0debug.h"
+#include "trx0sys.h"
+#include "trx0trx.h"
+
+#include <my_sys.h>
+#include <tap.h>
+
+/** The key of current_thd, created by mysqld */
+extern pthread_key_t	THR_THD;
+/** The temporary directories, initialized by mysqld */
+extern MY_TMPDIR	mysql_tmpdir_list;
+
+/** Number of latency histogram buckets; bucket i counts the operations
+that took less than 2^i nanoseconds */
+static const ulint	N_BUCKETS = 40;
+
+/** State of a benchmark thread */
+struct bench_thread_t {
+	/** thread number */
+	ulint		n;
+	/** number of operations to execute */
+	ulint		n_ops;
+	/** transaction for the trx_sys workload */
+	trx_t*		trx;
+	/** latency histogram */
+	ulint		latency[N_BUCKETS];
+	/** thread handle */
+	pthread_t	handle;
+};
+
+/** A workload */
+struct bench_workload_t {
+	/** name of the workload */
+	const char*	name;
+	/** execute one operation
+	@param[in,out]	thr	benchmark thread
+	@param[in]	i	sequence number of the operation */
+	void		(*op)(bench_thread_t* thr, ulint i);
+};
+
+/** The workload that is being run */
+static const bench_workload_t*	bench_workload;
+/** Number of threads that are ready to start */
+static ulint			bench_n_ready;
+/** Whether the threads may start executing the workload */
+static int32			bench_go;
+/** Maximum number of benchmark threads */
+static const ulint		BENCH_MAX_THREADS = 512;
+
+/** Pretend that the redo log buffer was written to the log files,
+so that log_reserve_and_open() will not try to write it. */
+static void bench_log_written()
+{
+	log_mutex_enter();
+
+	if (log_sys.buf_free > log_sys.max_buf_free) {
+		const ulint	last = ut_2pow_round(log_sys.buf_free,
+						     ulint(OS_FILE_LOG_BLOCK_SIZE));
+		memmove(log_sys.buf, log_sys.buf + last,
+			OS_FILE_LOG_BLOCK_SIZE);
+		log_sys.buf_free -= last;
+		log_sys.buf_next_to_write = log_sys.buf_free;
+		log_sys.write_lsn = log_sys.flushed_to_disk_lsn
+			= log_sys.last_checkpoint_lsn = log_sys.lsn;
+	}
+
+	log_mutex_exit();
+}
+
+/** Commit a mini-transaction that writes a 32-byte MLOG_WRITE_STRING
+record for a page of the system tablespace. */
+static void bench_log_sys(bench_thread_t* thr, ulint i)
+{
+	if (log_sys.buf_free > log_sys.max_buf_free) {
+		bench_log_written();
+	}
+
+	mtr_t	mtr;
+	byte	str[32];
+
+	memset(str, int(thr->n), sizeof str);
+
+	mtr.start();
+	mtr.set_modified();
+
+	byte*	log_ptr = mlog_open(&mtr, 11 + 2 + 2);
+	log_ptr = mlog_write_initial_log_record_low(
+		MLOG_WRITE_STRING, TRX_SYS_SPACE, thr->n, log_ptr, &mtr);
+	mach_write_to_2(log_ptr, ulint(i % (srv_page_size - sizeof str)));
+	mach_write_to_2(log_ptr + 2, sizeof str);
+	mlog_close(&mtr, log_ptr + 4);
+	mlog_catenate_string(&mtr, str, sizeof str);
+
+	mtr.commit();
+}
+
+/** Look up the record locks on a page. */
+static void bench_lock_sys(bench_thread_t* thr, ulint i)
+{
+	lock_mutex_enter();
+	const void*	lock = HASH_GET_FIRST(lock_sys.rec_hash,
+					      lock_rec_hash(thr->n, i));
+	lock_mutex_exit();
+	ut_a(!lock);
+}
+
+/** Register a read-write transaction, take a MVCC snapshot that
+includes the transactions of the other threads, and deregister. */
+static void bench_trx_sys(bench_thread_t* thr, ulint)
+{
+	trx_t*	trx = thr->trx;
+
+	trx_sys.register_rw(trx);
+	trx->read_view.open(trx);
+	trx->read_view.close();
+	trx_sys.deregister_rw(trx);
+	trx->id = 0;
+}
+
+/** Look up a page that is not in the buffer pool. */
+static void bench_page_hash(bench_thread_t* thr, ulint i)
+{
+	ut_a(!buf_page_peek(page_id_t(thr->n, i)));
+}
+
+/** The workloads */
+static const bench_workload_t	bench_workloads[] = {
+	{ "log_sys", bench_log_sys },
+	{ "lock_sys", bench_lock_sys },
+	{ "trx_sys", bench_trx_sys },
+	{ "page_hash", bench_page_hash }
+};
+
+/** Benchmark thread.
+@param[in,out]	arg	bench_thread_t
+@return NULL */
+extern "C" void* bench_thread(void* arg)
+{
+	bench_thread_t*	thr = static_cast<bench_thread_t*>(arg);
+	my_thread_init();
+
+	my_atomic_addlint(&bench_n_ready, 1);
+
+	while (!my_atomic_load32_explicit(&bench_go,
+					  MY_MEMORY_ORDER_ACQUIRE)) {
+		ut_delay(1);
+	}
+
+	for (ulint i = 0; i < thr->n_ops; i++) {
+		const ulonglong	start = my_interval_timer();
+		bench_workload->op(thr, i);
+		const ulonglong	ns = my_interval_timer() - start;
+
+		ulint	bucket = 0;
+		while (bucket < N_BUCKETS - 1 && ns >= 1ULL << bucket) {
+			bucket++;
+		}
+
+		thr->latency[bucket]++;
+	}
+
+	my_thread_end();
+	return(NULL);
+}
+
+/** Run a workload and report the results.
+@param[in]	workload	workload
+@param[in]	n_threads	number of threads
+@param[in]	n_ops		number of operations per thread */
+static void bench_run(
+	const bench_workload_t*	workload,
+	ulint			n_threads,
+	ulint			n_ops)
+{
+	bench_thread_t*	thr = static_cast<bench_thread_t*>(
+		ut_zalloc_nokey(n_threads * sizeof *thr));
+	ulint		latency[N_BUCKETS];
+
+	memset(latency, 0, sizeof latency);
+	bench_workload = workload;
+	bench_n_ready = 0;
+	bench_go = false;
+
+	for (ulint i = 0; i < n_threads; i++) {
+		thr[i].n = i + 1;
+		thr[i].n_ops = n_ops;
+		thr[i].trx = trx_create();
+		thr[i].trx->state = TRX_STATE_ACTIVE;
+		pthread_create(&thr[i].handle, NULL, bench_thread, &thr[i]);
+	}
+
+	while (my_atomic_loadlint(&bench_n_ready) < n_threads) {
+		os_thread_yield();
+	}
+
+	const ulonglong	start = my_interval_timer();
+	my_atomic_store32_explicit(&bench_go, true, MY_MEMORY_ORDER_RELEASE);
+
+	for (ulint i = 0; i < n_threads; i++) {
+		pthread_join(thr[i].handle, NULL);
+	}
+
+	const ulonglong	ns = my_interval_timer() - start;
+
+	for (ulint i = 0; i < n_threads; i++) {
+		thr[i].trx->state = TRX_STATE_NOT_STARTED;
+		trx_free(thr[i].trx);
+
+		for (ulint b = 0; b < N_BUCKETS; b++) {
+			latency[b] += thr[i].latency[b];
+		}
+	}
+
+	ut_free(thr);
+
+	const ulint	total = n_threads * n_ops;
+
+	ok(true, "%s: " ULINTPF " threads, " ULINTPF " operations in %g s,"
+	   " %.0f ops/s",
+	   workload->name, n_threads, total, double(ns) / 1e9,
+	   double(total) * 1e9 / double(ns ? ns : 1));
+
+	ulint	sum = 0;
+
+	for (ulint b = 0; b < N_BUCKETS; b++) {
+		if (!latency[b]) {
+			continue;
+		}
+
+		sum += latency[b];
+		diag("  < %llu ns: " ULINTPF " (%.1f%%)",
+		     1ULL << b, latency[b], 100.0 * double(sum) / double(total));
+	}
+}
+
+/** Create the subsystems that the workloads use. */
+static void bench_init()
+{
+	srv_page_size_shift = UNIV_PAGE_SIZE_SHIFT_DEF;
+	srv_page_size = UNIV_PAGE_SIZE_DEF;
+	srv_n_spin_wait_rounds = 30;
+	srv_spin_wait_delay = 4;
+	srv_sync_array_size = 1;
+	srv_max_n_threads = 2 * BENCH_MAX_THREADS;
+	srv_log_buffer_size = 16 << 20;
+	srv_lock_table_size = 5 * (8 << 20) / srv_page_size;
+	srv_buf_pool_size = srv_buf_pool_chunk_unit = 8 << 20;
+	srv_buf_pool_instances = 1;
+
+	/* Let current_thd return NULL. */
+	ut_a(!pthread_key_create(&THR_THD, NULL));
+	/* lock_sys.create() creates a temporary file. */
+	ut_a(!init_tmpdir(&mysql_tmpdir_list, NULL));
+	/* Load the character sets for dict_ind_init(). */
+	data_mysql_default_charset_coll = my_charset_latin1.number;
+	ut_a(get_charset(uint(data_mysql_default_charset_coll), MYF(0)));
+
+	srv_boot();
+	ut_a(buf_pool_init(srv_buf_pool_size, srv_buf_pool_instances)
+	     == DB_SUCCESS);
+	log_sys.create();
+	/* The log is never written; let log_close() assume that
+	a checkpoint is never needed. */
+	log_sys.log_group_capacity = log_sys.max_modified_age_async
+		= log_sys.max_modified_age_sync
+		= log_sys.max_checkpoint_age_async
+		= log_sys.max_checkpoint_age = LSN_MAX;
+	lock_sys.create(srv_lock_table_size);
+	trx_sys.create();
+}
+
+/** Free the subsystems. */
+static void bench_close()
+{
+	srv_shutdown_state = SRV_SHUTDOWN_EXIT_THREADS;
+	log_sys.close();
+	trx_sys.close();
+	lock_sys.close();
+	trx_pool_close();
+	row_mysql_close();
+	srv_free();
+	buf_pool_free(srv_buf_pool_instances);
+	sync_check_close();
+	free_tmpdir(&mysql_tmpdir_list);
+	pthread_key_delete(THR_THD);
+}
+
+int main(int argc, char** argv)
+{
+	MY_INIT(argv[0]);
+
+	ulint	n_threads = 4;
+	ulint	n_ops = 10000;
+	bool	selected[UT_ARR_SIZE(bench_workloads)] = { false };
+	ulint	n_selected = 0;
+
+	for (int i = 1; i < argc; i++) {
+		const char*	arg = argv[i];
+
+		if (!strncmp(arg, "--threads=", 10)) {
+			n_threads = strtoul(arg + 10, NULL, 10);
+			continue;
+		} else if (!strncmp(arg, "--iterations=", 13)) {
+			n_ops = strtoul(arg + 13, NULL, 10);
+			continue;
+		}
+
+		ulint	w = 0;
+
+		while (strcmp(bench_workloads[w].name, arg)) {
+			if (++w == UT_ARR_SIZE(bench_workloads)) {
+				BAIL_OUT("unknown workload %s;"
+					 " usage: %s [--threads=N]"
+					 " [--iterations=N] [workload...]",
+					 arg, argv[0]);
+			}
+		}
+
+		selected[w] = true;
+		n_selected++;
+	}
+
+	if (!n_threads || n_threads > BENCH_MAX_THREADS || !n_ops) {
+		BAIL_OUT("invalid number of threads or iterations");
+	}
+
+	plan(int(n_selected ? n_selected : UT_ARR_SIZE(bench_workloads)));
+	diag("N CPUs: %d", my_getncpus());
+
+	bench_init();
+
+	for (ulint w = 0; w < UT_ARR_SIZE(bench_workloads); w++) {
+		if (!n_selected || selected[w]) {
+			bench_run(&bench_workloads[w], n_threads, n_ops);
+		}
+	}
+
+	bench_close();
+
+	my_end(0);
+	return(exit_status());
+}
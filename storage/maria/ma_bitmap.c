@@ -339,6 +339,13 @@ my_bool _ma_bitmap_end(MARIA_SHARE *share)
               share->bitmap.waiting_for_flush_all_requested == 0);
   DBUG_ASSERT(share->bitmap.pinned_pages.elements == 0);
 
+  /*
+    The pages of a temporary or deleted table are thrown away when the
+    file is closed, so don't write the bitmap to the page cache, where it
+    could force out pages of other tables
+  */
+  if (share->temporary || share->deleting)
+    share->bitmap.changed= 0;
   res= _ma_bitmap_flush(share);
   mysql_mutex_destroy(&share->bitmap.bitmap_lock);
   mysql_cond_destroy(&share->bitmap.bitmap_cond);
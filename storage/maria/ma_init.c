@@ -107,6 +107,7 @@ void maria_end(void)
     if (translog_status == TRANSLOG_OK || translog_status == TRANSLOG_READONLY)
       translog_destroy();
     end_pagecache(maria_log_pagecache, TRUE);
+    end_temp_pagecaches();
     end_pagecache(maria_pagecache, TRUE);
     ma_control_file_end();
     mysql_mutex_destroy(&THR_LOCK_maria);
@@ -8108,6 +8108,17 @@ my_bool translog_flush(TRANSLOG_ADDRESS lsn)
       DBUG_RETURN(0);
     }
     log_descriptor.next_pass_max_lsn= LSN_IMPOSSIBLE;
+    /*
+      The pass we waited for may have flushed beyond our goal, as it
+      writes whole buffers. Then another pass would only sync() the
+      files again. Threads with smaller goals don't depend on us, as
+      they are woken by the end of that pass too.
+    */
+    if (cmp_translog_addr(log_descriptor.flushed, lsn) >= 0)
+    {
+      mysql_mutex_unlock(&log_descriptor.log_flush_lock);
+      DBUG_RETURN(0);
+    }
   }
   log_descriptor.flush_in_progress= 1;
   flush_horizon= log_descriptor.previous_flush_horizon;
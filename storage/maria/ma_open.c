@@ -322,9 +322,13 @@ MARIA_HA *maria_open(const char *name, int mode, uint open_flags)
     share= &share_buff;
     bzero((uchar*) &share_buff,sizeof(share_buff));
     share_buff.state.key_root=key_root;
-    share_buff.pagecache= multi_pagecache_search((uchar*) name_buff,
-						 (uint) strlen(name_buff),
-                                                 maria_pagecache);
+    if (internal_table && maria_temp_pagecache_count)
+      share_buff.pagecache= temp_pagecache_search((uchar*) name_buff,
+                                                  (uint) strlen(name_buff));
+    else
+      share_buff.pagecache= multi_pagecache_search((uchar*) name_buff,
+                                                   (uint) strlen(name_buff),
+                                                   maria_pagecache);
 
     DBUG_EXECUTE_IF("maria_pretend_crashed_table_on_open",
                     if (strstr(name, "/t1"))
@@ -327,6 +327,12 @@ extern my_bool multi_pagecache_set(const uchar *key, uint length,
 				   PAGECACHE *pagecache);
 extern void multi_pagecache_change(PAGECACHE *old_data,
 				   PAGECACHE *new_data);
+extern my_bool init_temp_pagecaches(uint count, size_t use_mem,
+                                    uint division_limit, uint age_threshold,
+                                    uint block_size,
+                                    uint changed_blocks_hash_size);
+extern void end_temp_pagecaches(void);
+extern PAGECACHE *temp_pagecache_search(const uchar *key, uint length);
 extern int reset_pagecache_counters(const char *name,
                                     PAGECACHE *pagecache);
 #ifndef DBUG_OFF
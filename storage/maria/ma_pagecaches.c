@@ -102,3 +102,90 @@ void multi_pagecache_change(PAGECACHE *old_data,
 {
   safe_hash_change(&pagecache_hash, (uchar*) old_data, (uchar*) new_data);
 }
+
+
+/*****************************************************************************
+  Page caches of internal temporary tables
+
+  Internal temporary tables are neither logged nor checkpointed, so they
+  don't have to use maria_pagecache. Spreading them over several page
+  caches lets sessions that use big temporary tables at the same time
+  work under different cache_lock mutexes.
+*****************************************************************************/
+
+/*
+  Create the page caches for internal temporary tables
+
+  SYNOPSIS
+    init_temp_pagecaches()
+    count			Number of page caches, 0 to use maria_pagecache
+    use_mem			Memory for all of them together
+
+  NOTES
+    The number of page caches is reduced if each would get less than
+    16 blocks.
+
+  RETURN
+    0  ok
+    1  error
+*/
+
+my_bool init_temp_pagecaches(uint count, size_t use_mem,
+                             uint division_limit, uint age_threshold,
+                             uint block_size, uint changed_blocks_hash_size)
+{
+  uint i;
+  DBUG_ENTER("init_temp_pagecaches");
+
+  set_if_smaller(count, (uint) MY_MIN(use_mem / (block_size * 16), UINT_MAX));
+  if (!count)
+    DBUG_RETURN(0);
+  if (!(maria_temp_pagecaches= (PAGECACHE*) my_malloc(count * sizeof(PAGECACHE),
+                                                      MYF(MY_WME |
+                                                          MY_ZEROFILL))))
+    DBUG_RETURN(1);
+  for (i= 0; i < count; i++)
+  {
+    maria_temp_pagecache_count= i;
+    if (!init_pagecache(&maria_temp_pagecaches[i], use_mem / count,
+                        division_limit, age_threshold, block_size,
+                        changed_blocks_hash_size, 0))
+    {
+      end_temp_pagecaches();
+      DBUG_RETURN(1);
+    }
+  }
+  maria_temp_pagecache_count= count;
+  DBUG_RETURN(0);
+}
+
+
+void end_temp_pagecaches(void)
+{
+  uint i;
+  for (i= 0; i < maria_temp_pagecache_count; i++)
+    end_pagecache(&maria_temp_pagecaches[i], TRUE);
+  my_free(maria_temp_pagecaches);
+  maria_temp_pagecaches= 0;
+  maria_temp_pagecache_count= 0;
+}
+
+
+/*
+  Get the page cache of an internal temporary table
+
+  SYNOPSIS
+    temp_pagecache_search()
+    key				Path to the table
+    length			Length of key
+
+  NOTES
+    Must only be called if maria_temp_pagecache_count is not 0
+*/
+
+PAGECACHE *temp_pagecache_search(const uchar *key, uint length)
+{
+  DBUG_ASSERT(maria_temp_pagecache_count);
+  return &maria_temp_pagecaches[my_checksum(0, key, length) %
+                                maria_temp_pagecache_count];
+}
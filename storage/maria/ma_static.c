@@ -57,6 +57,10 @@ ulong    maria_data_pointer_size= 6;
 PAGECACHE maria_pagecache_var;
 PAGECACHE *maria_pagecache= &maria_pagecache_var;
 
+/* Page caches of internal temporary tables, if not maria_pagecache */
+PAGECACHE *maria_temp_pagecaches= 0;
+uint maria_temp_pagecache_count= 0;
+
 PAGECACHE maria_log_pagecache_var;
 PAGECACHE *maria_log_pagecache= &maria_log_pagecache_var;
 MY_TMPDIR *maria_tmpdir;                        /* Tempdir for redo */
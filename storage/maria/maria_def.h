@@ -49,6 +49,8 @@
 #define HA_OPEN_IGNORE_MOVED_STATE (1U << 30)
 
 extern PAGECACHE maria_pagecache_var, *maria_pagecache;
+extern PAGECACHE *maria_temp_pagecaches;
+extern uint maria_temp_pagecache_count;
 int maria_assign_to_pagecache(MARIA_HA *info, ulonglong key_map,
 			      PAGECACHE *key_cache);
 void maria_change_pagecache(PAGECACHE *old_key_cache,
@@ -159,9 +159,6 @@ int oqgraph3::cursor::restore_position()
 
   if (_origid || _destid)
   {
-    if (int rc= table.file->ha_index_init(_index, 1))
-      return rc;
-
     restore_record(&table, s->default_values);
 
     if (_origid)
@@ -2282,7 +2282,7 @@ start_mutex_wait_v1(PSI_mutex_locker_state *state,
         Complete shortcut.
       */
       /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (counted) */
-      pfs_mutex->m_mutex_stat.m_wait_stat.aggregate_counted();
+      pfs_mutex->m_mutex_stat.m_wait_stat.aggregate_counted(0);
       return NULL;
     }
   }
@@ -2380,7 +2380,7 @@ start_rwlock_wait_v1(PSI_rwlock_locker_state *state,
         Complete shortcut.
       */
       /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (counted) */
-      pfs_rwlock->m_rwlock_stat.m_wait_stat.aggregate_counted();
+      pfs_rwlock->m_rwlock_stat.m_wait_stat.aggregate_counted(0);
       return NULL;
     }
   }
@@ -3473,6 +3473,7 @@ static void end_mutex_wait_v1(PSI_mutex_locker* locker, int rc)
   PFS_mutex *mutex= reinterpret_cast<PFS_mutex *> (state->m_mutex);
   DBUG_ASSERT(mutex != NULL);
   PFS_thread *thread= reinterpret_cast<PFS_thread *> (state->m_thread);
+  uint part= pfs_stat_partition(thread);
 
   uint flags= state->m_flags;
 
@@ -3481,12 +3482,12 @@ static void end_mutex_wait_v1(PSI_mutex_locker* locker, int rc)
     timer_end= state->m_timer();
     wait_time= timer_end - state->m_timer_start;
     /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (timed) */
-    mutex->m_mutex_stat.m_wait_stat.aggregate_value(wait_time);
+    mutex->m_mutex_stat.m_wait_stat.aggregate_value(part, wait_time);
   }
   else
   {
     /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (counted) */
-    mutex->m_mutex_stat.m_wait_stat.aggregate_counted();
+    mutex->m_mutex_stat.m_wait_stat.aggregate_counted(part);
   }
 
   if (likely(rc == 0))
@@ -3544,18 +3545,20 @@ static void end_rwlock_rdwait_v1(PSI_rwlock_locker* locker, int rc)
 
   PFS_rwlock *rwlock= reinterpret_cast<PFS_rwlock *> (state->m_rwlock);
   DBUG_ASSERT(rwlock != NULL);
+  uint part=
+    pfs_stat_partition(reinterpret_cast<PFS_thread *> (state->m_thread));
 
   if (state->m_flags & STATE_FLAG_TIMED)
   {
     timer_end= state->m_timer();
     wait_time= timer_end - state->m_timer_start;
     /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (timed) */
-    rwlock->m_rwlock_stat.m_wait_stat.aggregate_value(wait_time);
+    rwlock->m_rwlock_stat.m_wait_stat.aggregate_value(part, wait_time);
   }
   else
   {
     /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (counted) */
-    rwlock->m_rwlock_stat.m_wait_stat.aggregate_counted();
+    rwlock->m_rwlock_stat.m_wait_stat.aggregate_counted(part);
   }
 
   if (rc == 0)
@@ -3626,18 +3629,19 @@ static void end_rwlock_wrwait_v1(PSI_rwlock_locker* locker, int rc)
   PFS_rwlock *rwlock= reinterpret_cast<PFS_rwlock *> (state->m_rwlock);
   DBUG_ASSERT(rwlock != NULL);
   PFS_thread *thread= reinterpret_cast<PFS_thread *> (state->m_thread);
+  uint part= pfs_stat_partition(thread);
 
   if (state->m_flags & STATE_FLAG_TIMED)
   {
     timer_end= state->m_timer();
     wait_time= timer_end - state->m_timer_start;
     /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (timed) */
-    rwlock->m_rwlock_stat.m_wait_stat.aggregate_value(wait_time);
+    rwlock->m_rwlock_stat.m_wait_stat.aggregate_value(part, wait_time);
   }
   else
   {
     /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (counted) */
-    rwlock->m_rwlock_stat.m_wait_stat.aggregate_counted();
+    rwlock->m_rwlock_stat.m_wait_stat.aggregate_counted(part);
   }
 
   if (likely(rc == 0))
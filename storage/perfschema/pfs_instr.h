@@ -557,6 +557,17 @@ struct PFS_ALIGNED PFS_thread : PFS_connection_slice
   uint m_session_connect_attrs_cs_number;
 };
 
+/**
+  Partition of a @c PFS_partitioned_stat to aggregate to for a thread.
+  Waits outside of an instrumented thread are aggregated to partition 0.
+*/
+inline uint pfs_stat_partition(const PFS_thread *thread)
+{
+  if (thread == NULL)
+    return 0;
+  return (uint) (thread->m_thread_internal_id & (PFS_STAT_PARTITIONS - 1));
+}
+
 extern PFS_stage_stat *global_instr_class_stages_array;
 extern PFS_statement_stat *global_instr_class_statements_array;
 
@@ -19,6 +19,7 @@
 #include "sql_const.h"
 /* memcpy */
 #include "string.h"
+#include "pfs_global.h"
 
 /**
   @file storage/perfschema/pfs_stat.h
@@ -94,6 +95,58 @@ struct PFS_single_stat
   }
 };
 
+/**
+  Number of partitions of a @c PFS_partitioned_stat.
+  Must be a power of 2.
+*/
+#define PFS_STAT_PARTITIONS 8
+
+/**
+  Single statistic, partitioned by thread.
+  The waits on a hot mutex or rwlock instance are aggregated by all the
+  threads that use it. To avoid that they all write to the same cache
+  line, each thread writes to its own partition, and the partitions are
+  merged when the statistic is read.
+*/
+struct PFS_partitioned_stat
+{
+  struct PFS_ALIGNED partition
+  {
+    PFS_single_stat m_stat;
+  };
+
+  partition m_partitions[PFS_STAT_PARTITIONS];
+
+  inline void reset(void)
+  {
+    for (uint i= 0; i < PFS_STAT_PARTITIONS; i++)
+      m_partitions[i].m_stat.reset();
+  }
+
+  inline void aggregate(const PFS_partitioned_stat *stat)
+  {
+    for (uint i= 0; i < PFS_STAT_PARTITIONS; i++)
+      m_partitions[i].m_stat.aggregate(& stat->m_partitions[i].m_stat);
+  }
+
+  /** Merge all the partitions into a single statistic. */
+  inline void sum(PFS_single_stat *result) const
+  {
+    for (uint i= 0; i < PFS_STAT_PARTITIONS; i++)
+      result->aggregate(& m_partitions[i].m_stat);
+  }
+
+  inline void aggregate_counted(uint part)
+  {
+    m_partitions[part].m_stat.aggregate_counted();
+  }
+
+  inline void aggregate_value(uint part, ulonglong value)
+  {
+    m_partitions[part].m_stat.aggregate_value(value);
+  }
+};
+
 /** Combined statistic. */
 struct PFS_byte_stat : public PFS_single_stat
 {
@@ -148,8 +201,8 @@ struct PFS_byte_stat : public PFS_single_stat
 /** Statistics for mutex usage. */
 struct PFS_mutex_stat
 {
-  /** Wait statistics. */
-  PFS_single_stat m_wait_stat;
+  /** Wait statistics, partitioned by thread. */
+  PFS_partitioned_stat m_wait_stat;
   /**
     Lock statistics.
     This statistic is not exposed in user visible tables yet.
@@ -172,8 +225,8 @@ struct PFS_mutex_stat
 /** Statistics for rwlock usage. */
 struct PFS_rwlock_stat
 {
-  /** Wait statistics. */
-  PFS_single_stat m_wait_stat;
+  /** Wait statistics, partitioned by thread. */
+  PFS_partitioned_stat m_wait_stat;
   /**
     RWLock read lock usage statistics.
     This statistic is not exposed in user visible tables yet.
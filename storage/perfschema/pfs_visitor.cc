@@ -885,12 +885,12 @@ PFS_instance_wait_visitor::~PFS_instance_wait_visitor()
 
 void PFS_instance_wait_visitor::visit_mutex_class(PFS_mutex_class *pfs)
 {
-  m_stat.aggregate(&pfs->m_mutex_stat.m_wait_stat);
+  pfs->m_mutex_stat.m_wait_stat.sum(&m_stat);
 }
 
 void PFS_instance_wait_visitor::visit_rwlock_class(PFS_rwlock_class *pfs)
 {
-  m_stat.aggregate(&pfs->m_rwlock_stat.m_wait_stat);
+  pfs->m_rwlock_stat.m_wait_stat.sum(&m_stat);
 }
 
 void PFS_instance_wait_visitor::visit_cond_class(PFS_cond_class *pfs)
@@ -910,12 +910,12 @@ void PFS_instance_wait_visitor::visit_socket_class(PFS_socket_class *pfs)
 
 void PFS_instance_wait_visitor::visit_mutex(PFS_mutex *pfs)
 {
-  m_stat.aggregate(& pfs->m_mutex_stat.m_wait_stat);
+  pfs->m_mutex_stat.m_wait_stat.sum(&m_stat);
 }
 
 void PFS_instance_wait_visitor::visit_rwlock(PFS_rwlock *pfs)
 {
-  m_stat.aggregate(& pfs->m_rwlock_stat.m_wait_stat);
+  pfs->m_rwlock_stat.m_wait_stat.sum(&m_stat);
 }
 
 void PFS_instance_wait_visitor::visit_cond(PFS_cond *pfs)
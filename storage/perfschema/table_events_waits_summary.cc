@@ -102,7 +102,9 @@ void table_events_waits_summary_by_instance::make_mutex_row(PFS_mutex *pfs)
   if (unlikely(safe_class == NULL))
     return;
 
-  make_instr_row(pfs, safe_class, pfs->m_identity, &pfs->m_mutex_stat.m_wait_stat);
+  PFS_single_stat stat;
+  pfs->m_mutex_stat.m_wait_stat.sum(&stat);
+  make_instr_row(pfs, safe_class, pfs->m_identity, &stat);
 }
 
 /**
@@ -116,7 +118,9 @@ void table_events_waits_summary_by_instance::make_rwlock_row(PFS_rwlock *pfs)
   if (unlikely(safe_class == NULL))
     return;
 
-  make_instr_row(pfs, safe_class, pfs->m_identity, &pfs->m_rwlock_stat.m_wait_stat);
+  PFS_single_stat stat;
+  pfs->m_rwlock_stat.m_wait_stat.sum(&stat);
+  make_instr_row(pfs, safe_class, pfs->m_identity, &stat);
 }
 
 /**
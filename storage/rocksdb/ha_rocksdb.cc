@@ -10500,6 +10500,7 @@ int ha_rocksdb::rnd_next_with_direction(uchar *const buf, bool move_forward) {
 int ha_rocksdb::rnd_end() {
   DBUG_ENTER_FUNC();
 
+  m_ds_mrr.dsmrr_close();
   release_scan_iterator();
 
   DBUG_RETURN(HA_EXIT_SUCCESS);
@@ -10540,6 +10541,7 @@ int ha_rocksdb::index_init(uint idx, bool sorted) {
 int ha_rocksdb::index_end() {
   DBUG_ENTER_FUNC();
 
+  m_ds_mrr.dsmrr_close();
   release_scan_iterator();
 
   bitmap_free(&m_lookup_bitmap);
@@ -12101,6 +12103,45 @@ class Item *ha_rocksdb::idx_cond_push(uint keyno, class Item *const idx_cond) {
   DBUG_RETURN(nullptr);
 }
 
+/*
+  Multi Range Read implementation: use DS-MRR, so that with mrr=on the
+  rows found in a secondary index are read in primary key order
+*/
+
+int ha_rocksdb::multi_range_read_init(RANGE_SEQ_IF *seq, void *seq_init_param,
+                                      uint n_ranges, uint mode,
+                                      HANDLER_BUFFER *buf) {
+  return m_ds_mrr.dsmrr_init(this, seq, seq_init_param, n_ranges, mode, buf);
+}
+
+int ha_rocksdb::multi_range_read_next(range_id_t *range_info) {
+  return m_ds_mrr.dsmrr_next(range_info);
+}
+
+ha_rows ha_rocksdb::multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
+                                                void *seq_init_param,
+                                                uint n_ranges, uint *bufsz,
+                                                uint *flags,
+                                                Cost_estimate *cost) {
+  /* this->table is not known earlier, see ha_maria */
+  m_ds_mrr.init(this, table);
+  return m_ds_mrr.dsmrr_info_const(keyno, seq, seq_init_param, n_ranges, bufsz,
+                                   flags, cost);
+}
+
+ha_rows ha_rocksdb::multi_range_read_info(uint keyno, uint n_ranges, uint keys,
+                                          uint key_parts, uint *bufsz,
+                                          uint *flags, Cost_estimate *cost) {
+  m_ds_mrr.init(this, table);
+  return m_ds_mrr.dsmrr_info(keyno, n_ranges, keys, key_parts, bufsz, flags,
+                             cost);
+}
+
+int ha_rocksdb::multi_range_read_explain_info(uint mrr_mode, char *str,
+                                              size_t size) {
+  return m_ds_mrr.dsmrr_explain_info(mrr_mode, str, size);
+}
+
 /*
   Checks if inplace alter is supported for a given operation.
 */
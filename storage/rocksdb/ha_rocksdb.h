@@ -517,6 +517,8 @@ class ha_rocksdb : public my_core::handler {
 
   Rdb_tbl_def *m_tbl_def;
 
+  DsMrr_impl m_ds_mrr;
+
   /* Primary Key encoder from KeyTupleFormat to StorageFormat */
   std::shared_ptr<Rdb_key_def> m_pk_descr;
 
@@ -1091,6 +1093,24 @@ class ha_rocksdb : public my_core::handler {
   /*
     Default implementation from cancel_pushed_idx_cond() suits us
   */
+
+  /*
+    Multi Range Read: DS-MRR, which looks up the primary keys found in a
+    secondary index in key order
+  */
+  int multi_range_read_init(RANGE_SEQ_IF *seq, void *seq_init_param,
+                            uint n_ranges, uint mode,
+                            HANDLER_BUFFER *buf) override;
+  int multi_range_read_next(range_id_t *range_info) override;
+  ha_rows multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
+                                      void *seq_init_param, uint n_ranges,
+                                      uint *bufsz, uint *flags,
+                                      Cost_estimate *cost) override;
+  ha_rows multi_range_read_info(uint keyno, uint n_ranges, uint keys,
+                                uint key_parts, uint *bufsz, uint *flags,
+                                Cost_estimate *cost) override;
+  int multi_range_read_explain_info(uint mrr_mode, char *str,
+                                    size_t size) override;
 private:
   struct key_def_cf_info {
     rocksdb::ColumnFamilyHandle *cf_handle;
@@ -1330,6 +1350,8 @@ class ha_rocksdb : public my_core::handler {
     /* Free blob data */
     m_retrieved_record.Reset();
 
+    m_ds_mrr.dsmrr_close();
+
     DBUG_RETURN(HA_EXIT_SUCCESS);
   }
 
@@ -334,6 +334,7 @@ Rdb_sst_info::Rdb_sst_info(rocksdb::DB *const db, const std::string &tablename,
       m_sst_count(0), m_background_error(HA_EXIT_SUCCESS), m_committed(false),
 #if defined(RDB_SST_INFO_USE_THREAD)
       m_queue(), m_mutex(), m_cond(), m_thread(nullptr), m_finished(false),
+      m_background_status(), m_background_file(),
 #endif
       m_sst_file(nullptr), m_tracing(tracing), m_print_client_error(true) {
   m_prefix = db->GetName() + "/";
@@ -368,7 +369,9 @@ Rdb_sst_info::Rdb_sst_info(rocksdb::DB *const db, const std::string &tablename,
 Rdb_sst_info::~Rdb_sst_info() {
   DBUG_ASSERT(m_sst_file == nullptr);
 #if defined(RDB_SST_INFO_USE_THREAD)
-  DBUG_ASSERT(m_thread == nullptr);
+  // commit() is not called after an error in put(), don't leave the thread
+  // running on a freed object
+  stop_thread();
 #endif
   mysql_mutex_destroy(&m_commit_mutex);
 }
@@ -444,6 +447,9 @@ int Rdb_sst_info::put(const rocksdb::Slice &key, const rocksdb::Slice &value) {
     // While we are here, check to see if we have had any errors from the
     // background thread - we don't want to wait for the end to report them
     if (have_background_error()) {
+#if defined(RDB_SST_INFO_USE_THREAD)
+      report_background_error();
+#endif
       return get_and_reset_background_error();
     }
   }
@@ -491,16 +497,7 @@ int Rdb_sst_info::commit(bool print_client_error) {
   }
 
 #if defined(RDB_SST_INFO_USE_THREAD)
-  if (m_thread != nullptr) {
-    // Tell the background thread we are done
-    m_finished = true;
-    m_cond.notify_one();
-
-    // Wait for the background thread to finish
-    m_thread->join();
-    delete m_thread;
-    m_thread = nullptr;
-  }
+  stop_thread();
 #endif
 
   m_committed = true;
@@ -508,6 +505,9 @@ int Rdb_sst_info::commit(bool print_client_error) {
 
   // Did we get any errors?
   if (have_background_error()) {
+#if defined(RDB_SST_INFO_USE_THREAD)
+    report_background_error();
+#endif
     ret = get_and_reset_background_error();
   }
 
@@ -521,12 +521,8 @@ void Rdb_sst_info::set_error_msg(const std::string &sst_file_name,
   if (!m_print_client_error)
     return;
 
-#if defined(RDB_SST_INFO_USE_THREAD)
-  // Both the foreground and background threads can set the error message
-  // so lock the mutex to protect it.  We only want the first error that
-  // we encounter.
-  const std::lock_guard<std::mutex> guard(m_mutex);
-#endif
+  // Only called by the loading thread, the background thread reports its
+  // errors through report_background_error()
   if (s.IsInvalidArgument() &&
       strcmp(s.getState(), "Keys must be added in order") == 0) {
     my_printf_error(ER_KEYS_OUT_OF_ORDER,
@@ -554,9 +550,9 @@ void Rdb_sst_info::thread_fcn(void *object) {
 void Rdb_sst_info::run_thread() {
   std::unique_lock<std::mutex> lk(m_mutex);
 
-  do {
-    // Wait for notification or 1 second to pass
-    m_cond.wait_for(lk, std::chrono::seconds(1));
+  for (;;) {
+    // Wait for a file to commit or for the main thread to finish
+    m_cond.wait(lk, [this] { return !m_queue.empty() || m_finished; });
 
     // Inner loop pulls off all Rdb_sst_file_ordered entries and processes them
     while (!m_queue.empty()) {
@@ -568,23 +564,66 @@ void Rdb_sst_info::run_thread() {
 
       // Close out the sst file and add it to the database
       const rocksdb::Status s = sst_file->commit();
-      if (!s.ok()) {
-        set_error_msg(sst_file->get_name(), s);
-        set_background_error(HA_ERR_ROCKSDB_BULK_LOAD);
-      }
+      const std::string name = sst_file->get_name();
 
       delete sst_file;
 
       // Reacquire the lock for the next inner loop iteration
       lk.lock();
+
+      // There is no client to send the error to in this thread, so keep
+      // the first one for report_background_error()
+      if (!s.ok()) {
+        if (m_background_status.ok()) {
+          m_background_status = s;
+          m_background_file = name;
+        }
+        set_background_error(HA_ERR_ROCKSDB_BULK_LOAD);
+      }
     }
 
     // If the queue is empty and the main thread has indicated we should exit
     // break out of the loop.
-  } while (!m_finished);
+    if (m_finished)
+      break;
+  }
 
   DBUG_ASSERT(m_queue.empty());
 }
+
+// Wait until the background thread has committed all queued files
+void Rdb_sst_info::stop_thread() {
+  if (m_thread != nullptr) {
+    // Tell the background thread we are done
+    {
+      const std::lock_guard<std::mutex> guard(m_mutex);
+      m_finished = true;
+    }
+    m_cond.notify_one();
+
+    // Wait for the background thread to finish
+    m_thread->join();
+    delete m_thread;
+    m_thread = nullptr;
+  }
+}
+
+// Send the error of the background thread, if any, to the client
+void Rdb_sst_info::report_background_error() {
+  rocksdb::Status s;
+  std::string name;
+
+  {
+    const std::lock_guard<std::mutex> guard(m_mutex);
+    s = m_background_status;
+    name = m_background_file;
+    m_background_status = rocksdb::Status::OK();
+  }
+
+  if (!s.ok()) {
+    set_error_msg(name, s);
+  }
+}
 #endif
 
 void Rdb_sst_info::init(const rocksdb::DB *const db) {
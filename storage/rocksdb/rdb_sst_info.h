@@ -34,7 +34,11 @@
 /* MyRocks header files */
 #include "./rdb_utils.h"
 
-// #define RDB_SST_INFO_USE_THREAD /* uncomment to use threads */
+/*
+  Finish and ingest full sst files in a background thread, while the next
+  one is being written. Comment out to do it in the loading thread.
+*/
+#define RDB_SST_INFO_USE_THREAD
 
 namespace myrocks {
 
@@ -136,6 +140,12 @@ class Rdb_sst_info {
   std::condition_variable m_cond;
   std::thread *m_thread;
   bool m_finished;
+  /*
+    The first error of the background thread, which can't report it to the
+    client itself
+  */
+  rocksdb::Status m_background_status;
+  std::string m_background_file;
 #endif
   Rdb_sst_file_ordered *m_sst_file;
   const bool m_tracing;
@@ -148,6 +158,8 @@ class Rdb_sst_info {
 
 #if defined(RDB_SST_INFO_USE_THREAD)
   void run_thread();
+  void stop_thread();
+  void report_background_error();
 
   static void thread_fcn(void *object);
 #endif
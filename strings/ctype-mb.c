@@ -321,6 +321,15 @@ size_t my_charpos_mb(CHARSET_INFO *cs __attribute__((unused)),
   
   while (length && pos < end)
   {
+    /* A byte below 0x80 at a character boundary is a character by itself */
+    if ((uchar) *pos < 0x80)
+    {
+      size_t ascii= my_ascii_prefix_length((const uchar *) pos,
+                                           (const uchar *) end, length);
+      pos+= ascii;
+      length-= ascii;
+      continue;
+    }
     uint mb_len;
     pos+= (mb_len= my_ismbchar(cs, pos, end)) ? mb_len : 1;
     length--;
@@ -5213,10 +5213,12 @@ int my_charlen_utf8(CHARSET_INFO *cs __attribute__((unused)),
 #define MY_FUNCTION_NAME(x)       my_ ## x ## _utf8
 #define CHARLEN(cs,str,end)       my_charlen_utf8(cs,str,end)
 #define DEFINE_WELL_FORMED_CHAR_LENGTH_USING_CHARLEN
+#define WELL_FORMED_ASCII_PREFIX
 #include "ctype-mb.ic"
 #undef MY_FUNCTION_NAME
 #undef CHARLEN
 #undef DEFINE_WELL_FORMED_CHAR_LENGTH_USING_CHARLEN
+#undef WELL_FORMED_ASCII_PREFIX
 /* my_well_formed_char_length_utf8 */
 
 
@@ -7466,12 +7468,25 @@ my_casedn_utf8mb4(CHARSET_INFO *cs,
   const char *srcend= src + srclen;
   char *dstend= dst + dstlen, *dst0= dst;
   MY_UNICASE_INFO *uni_plane= cs->caseinfo;
+  const MY_UNICASE_CHARACTER *page0= uni_plane->page[0];
   DBUG_ASSERT(src != dst || cs->casedn_multiply == 1);
 
-  while ((src < srcend) &&
-         (srcres= my_mb_wc_utf8mb4(cs, &wc,
-                                   (uchar*) src, (uchar*) srcend)) > 0)
+  while (src < srcend)
   {
+    /*
+      ASCII fast path: no conversion to and from Unicode is needed, unless
+      the collation maps the character outside of ASCII, e.g. 'I' in Turkish.
+    */
+    if ((uchar) *src < 0x80 && dst < dstend &&
+        (wc= page0[(uchar) *src].tolower) < 0x80)
+    {
+      *dst++= (char) wc;
+      src++;
+      continue;
+    }
+    if ((srcres= my_mb_wc_utf8mb4(cs, &wc,
+                                  (uchar*) src, (uchar*) srcend)) <= 0)
+      break;
     my_tolower_utf8mb4(uni_plane, &wc);
     if ((dstres= my_wc_mb_utf8mb4(cs, wc, (uchar*) dst, (uchar*) dstend)) <= 0)
       break;
@@ -7636,10 +7651,12 @@ my_charlen_utf8mb4(CHARSET_INFO *cs __attribute__((unused)),
 #define MY_FUNCTION_NAME(x)       my_ ## x ## _utf8mb4
 #define CHARLEN(cs,str,end)       my_charlen_utf8mb4(cs,str,end)
 #define DEFINE_WELL_FORMED_CHAR_LENGTH_USING_CHARLEN
+#define WELL_FORMED_ASCII_PREFIX
 #include "ctype-mb.ic"
 #undef MY_FUNCTION_NAME
 #undef CHARLEN
 #undef DEFINE_WELL_FORMED_CHAR_LENGTH_USING_CHARLEN
+#undef WELL_FORMED_ASCII_PREFIX
 /* my_well_formed_char_length_utf8mb4 */
 
 
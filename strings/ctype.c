@@ -1061,6 +1061,60 @@ my_convert_using_func(char *to, size_t to_length,
 }
 
 
+/*
+  Convert a string from an 8-bit character set to utf8 or utf8mb4,
+  using the Unicode table of the 8-bit character set directly instead
+  of calling mb_wc() and wc_mb() for every character.
+  The result is the same as of my_convert_using_func().
+*/
+
+static uint32
+my_convert_8bit_to_utf8(char *to, uint32 to_length,
+                        const char *from, uint32 from_length,
+                        CHARSET_INFO *from_cs, uint *errors)
+{
+  const uint16 *tab_to_uni= from_cs->tab_to_uni;
+  const uchar *s= (const uchar*) from, *s_end= s + from_length;
+  uchar *d= (uchar*) to, *d_end= d + to_length;
+  uint error_count= 0;
+
+  for ( ; s < s_end; s++)
+  {
+    my_wc_t wc= tab_to_uni[*s];
+    if (wc < 0x80)
+    {
+      if (!wc && *s)
+      {
+        error_count++;                  /* No Unicode mapping */
+        wc= '?';
+      }
+      if (d >= d_end)
+        break;
+      *d++= (uchar) wc;
+    }
+    else if (wc < 0x800)
+    {
+      if (d + 2 > d_end)
+        break;
+      d[0]= (uchar) (0xC0 | (wc >> 6));
+      d[1]= (uchar) (0x80 | (wc & 0x3F));
+      d+= 2;
+    }
+    else
+    {
+      if (d + 3 > d_end)
+        break;
+      d[0]= (uchar) (0xE0 | (wc >> 12));
+      d[1]= (uchar) (0x80 | ((wc >> 6) & 0x3F));
+      d[2]= (uchar) (0x80 | (wc & 0x3F));
+      d+= 3;
+    }
+  }
+  *errors= error_count;
+  return (uint32) (d - (uchar*) to);
+}
+
+
 /*
   Convert a string between two character sets.
    Optimized for quick copying of ASCII characters in the range 0x00..0x7F.
@@ -1083,6 +1137,15 @@ my_convert(char *to, uint32 to_length, CHARSET_INFO *to_cs,
            CHARSET_INFO *from_cs, uint *errors)
 {
   uint32 length, length2;
+  /*
+    Single byte character sets map to BMP only, so they can be converted
+    to utf8 and utf8mb4 with their Unicode table.
+  */
+  if (from_cs->mbmaxlen == 1 && from_cs->tab_to_uni &&
+      to_cs->mbminlen == 1 &&
+      (to_cs->state & (MY_CS_UNICODE | MY_CS_NONASCII)) == MY_CS_UNICODE)
+    return my_convert_8bit_to_utf8(to, to_length, from, from_length,
+                                   from_cs, errors);
   /*
     If any of the character sets is not ASCII compatible,
     immediately switch to slow mb_wc->wc_mb method.
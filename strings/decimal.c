@@ -1110,6 +1110,85 @@ int decimal2longlong(const decimal_t *from, longlong *to)
   return E_DEC_OK;
 }
 
+
+/*
+  Convert decimal to an integer scaled by 10^scale
+
+  SYNOPSIS
+    decimal2scaled_longlong()
+      from    - value to convert
+      scale   - number of fraction digits to keep, at most 18
+      to      - points to where the result should be stored
+
+  RETURN VALUE
+    E_DEC_OK
+    E_DEC_TRUNCATED  from has nonzero digits after scale, *to is not changed
+    E_DEC_OVERFLOW   from * 10^scale doesn't fit in longlong, *to is not
+                     changed
+*/
+
+int decimal2scaled_longlong(const decimal_t *from, int scale, longlong *to)
+{
+  dec1 *buf=from->buf, *frac_end;
+  longlong x=0;
+  int intg, frac;
+
+  DBUG_ASSERT(scale >= 0 && scale <= 18);
+  /* As in decimal2longlong(), calculate -|from| */
+  for (intg=from->intg; intg > 0; intg-=DIG_PER_DEC1)
+  {
+    longlong y=x;
+    x=x*DIG_BASE - *buf++;
+    if (unlikely(y < (LONGLONG_MIN/DIG_BASE) || x > y))
+      return E_DEC_OVERFLOW;
+  }
+  frac_end= buf + ROUND_UP(from->frac);
+  for (frac=scale; frac > 0; frac-=DIG_PER_DEC1)
+  {
+    int digits= MY_MIN(frac, DIG_PER_DEC1);
+    dec1 word= buf < frac_end ? *buf++ : 0;
+    longlong y=x;
+    if (word % powers10[DIG_PER_DEC1 - digits])
+      return E_DEC_TRUNCATED;
+    x=x*powers10[digits] - word / powers10[DIG_PER_DEC1 - digits];
+    if (unlikely(y < (LONGLONG_MIN/powers10[digits]) || x > y))
+      return E_DEC_OVERFLOW;
+  }
+  for (; buf < frac_end; buf++)
+    if (*buf)
+      return E_DEC_TRUNCATED;
+  if (!from->sign)
+  {
+    if (unlikely(x == LONGLONG_MIN))
+      return E_DEC_OVERFLOW;
+    x= -x;
+  }
+  *to= x;
+  return E_DEC_OK;
+}
+
+
+/*
+  Convert an integer scaled by 10^scale to decimal
+
+  SYNOPSIS
+    scaled_longlong2decimal()
+      from    - value to convert
+      scale   - number of fraction digits in from
+      to      - points to where the result should be stored
+
+  RETURN VALUE
+    E_DEC_OK/E_DEC_TRUNCATED/E_DEC_OVERFLOW
+*/
+
+int scaled_longlong2decimal(longlong from, int scale, decimal_t *to)
+{
+  int error= longlong2decimal(from, to);
+  if (!error && scale)
+    error= decimal_shift(to, -scale);
+  return error;
+}
+
 /*
   Convert decimal to its binary fixed-length representation
   two representations of the same length can be compared with memcmp
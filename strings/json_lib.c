@@ -352,8 +352,20 @@ int json_read_string_const_chr(json_string_t *js)
 static int skip_str_constant(json_engine_t *j)
 {
   int t, c_len;
+  my_bool ascii_based= my_charset_is_ascii_based(j->s.cs);
   for (;;)
   {
+    if (ascii_based)
+    {
+      /*
+        Plain ASCII characters, which are most of a typical document,
+        don't need the charset handler.
+      */
+      const uchar *c= j->s.c_str;
+      while (c < j->s.str_end && *c < 128 && json_instr_chr_map[*c] <= S_ETC)
+        c++;
+      j->s.c_str= c;
+    }
     if ((c_len= json_next_char(&j->s)) > 0)
     {
       j->s.c_str+= c_len;
@@ -1746,6 +1758,17 @@ int json_get_path_next(json_engine_t *je, json_path_t *p)
 }
 
 
+int json_get_path_skip_level(json_engine_t *je)
+{
+  DBUG_ASSERT(!json_value_scalar(je));
+  if (json_skip_level(je))
+    return 1;
+  /* Now json_get_path_next() has to handle it as a scalar value. */
+  je->value_type= JSON_VALUE_NULL;
+  return 0;
+}
+
+
 int json_path_parts_compare(
     const json_path_step_t *a, const json_path_step_t *a_end,
     const json_path_step_t *b, const json_path_step_t *b_end,
@@ -105,6 +105,27 @@ static inline const uchar *skip_trailing_space(const uchar *ptr,size_t len)
 }
 
 
+/*
+  Return the number of leading ASCII (< 0x80) bytes in [s, e),
+  but not more than max_length. Checks 8 bytes at a time.
+*/
+static inline size_t my_ascii_prefix_length(const uchar *s, const uchar *e,
+                                            size_t max_length)
+{
+  const uchar *s0= s;
+  if ((size_t) (e - s) > max_length)
+    e= s + max_length;
+  for ( ; s + 8 <= e; s+= 8)
+  {
+    if (uint8korr(s) & 0x8080808080808080ULL)
+      break;
+  }
+  for ( ; s < e && *s < 0x80; s++)
+  { }
+  return (size_t) (s - s0);
+}
+
+
 uint my_8bit_charset_flags_from_data(CHARSET_INFO *cs);
 uint my_8bit_collation_flags_from_data(CHARSET_INFO *cs);
 
@@ -84,6 +84,9 @@ static const uchar *js1= (const uchar *) "[123, \"text\"]";
 static const uchar *js2= (const uchar *) "{\"key1\":123, \"key2\":\"text\"}";
 static const uchar *js3= (const uchar *) "{\"key1\":{\"ikey1\":321},"
                                           "\"key2\":[\"text\", 321]}";
+static const uchar *js4= (const uchar *) "[\"a string long enough to skip\","
+                                          " \"with \\\"escapes\\\" and \xC3\xA4\"]";
+static const uchar *js5= (const uchar *) "[\"control \x01 character\"]";
 
 /*
   Test json_lib functions to parse JSON.
@@ -103,6 +106,10 @@ test_json_parsing()
   ok(r.n_steps == 12 && r.n_keys == 3 && r.n_objects == 2 &&
      r.n_arrays == 1 && r.keyname_csum == 44,
      "complex json");
+  parse_json(js4, &r);
+  ok(r.n_steps == 5 && r.n_values == 3 && r.error == 0, "strings");
+  parse_json(js5, &r);
+  ok(r.error == JE_NOT_JSON_CHR, "control character in string");
 }
 
 
@@ -175,7 +182,7 @@ int main()
 {
   ci= &my_charset_utf8_general_ci;
 
-  plan(6);
+  plan(8);
   diag("Testing json_lib functions.");
 
   test_json_parsing();
@@ -0,0 +1,52 @@
+/* Copyright (c) 2019, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <tap.h>
+
+static uchar buf[1000];
+
+int main(int argc __attribute__((unused)), char **argv)
+{
+  uint i, bad= 0;
+  ha_checksum whole;
+
+  MY_INIT(argv[0]);
+  plan(4);
+
+  for (i= 0; i < sizeof(buf); i++)
+    buf[i]= (uchar) (i % 251);
+
+  ok(my_checksum(0, (uchar*) "123456789", 9) == 0xcbf43926,
+     "crc32 of 9 bytes");
+  memset(buf, 'a', 64);
+  ok(my_checksum(0, buf, 64) == 0x89b46555, "crc32 of 64 bytes");
+  for (i= 0; i < 64; i++)
+    buf[i]= (uchar) (i % 251);
+  whole= my_checksum(0, buf, sizeof(buf));
+  ok(whole == 0x721746a6, "crc32 of 1000 bytes");
+
+  /* Any split of the block must give the same result */
+  for (i= 0; i <= sizeof(buf); i++)
+  {
+    if (my_checksum(my_checksum(0, buf, i), buf + i, sizeof(buf) - i) != whole)
+      bad++;
+  }
+  ok(bad == 0, "crc32 of a block computed in two parts");
+
+  my_end(0);
+  return exit_status();
+}
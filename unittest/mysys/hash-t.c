@@ -0,0 +1,86 @@
+/* Copyright (c) 2019, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <m_string.h>
+#include <hash.h>
+#include <tap.h>
+
+#define RECORDS 1000
+
+static char records[RECORDS][16];
+
+static uchar *get_key(const uchar *record, size_t *length,
+                      my_bool not_used __attribute__((unused)))
+{
+  *length= strlen((const char*) record);
+  return (uchar*) record;
+}
+
+static uint count_dups(HASH *hash, const char *key)
+{
+  HASH_SEARCH_STATE state;
+  uint count= 0;
+  uchar *found;
+
+  for (found= my_hash_first(hash, (const uchar*) key, strlen(key), &state);
+       found;
+       found= my_hash_next(hash, (const uchar*) key, strlen(key), &state))
+    count++;
+  return count;
+}
+
+int main(int argc __attribute__((unused)), char **argv)
+{
+  HASH hash;
+  uint i, found= 0;
+  char key[16];
+
+  MY_INIT(argv[0]);
+  plan(6);
+
+  my_hash_init(&hash, &my_charset_latin1, 16, 0, 0, get_key, 0, 0);
+  for (i= 0; i < RECORDS; i++)
+  {
+    sprintf(records[i], "key%u", i / 2);
+    my_hash_insert(&hash, (uchar*) records[i]);
+  }
+  ok(hash.records == RECORDS, "inserted %lu records", hash.records);
+
+  for (i= 0; i < RECORDS / 2; i++)
+  {
+    sprintf(key, "KEY%u", i);
+    if (my_hash_search(&hash, (uchar*) key, strlen(key)))
+      found++;
+  }
+  ok(found == RECORDS / 2, "found %u keys case insensitively", found);
+
+  ok(count_dups(&hash, "Key7") == 2, "both records of a key found");
+  ok(!my_hash_search(&hash, (uchar*) "key", 3), "prefix of a key not found");
+
+  strcpy(key, records[14]);
+  strcpy(records[14], "other");
+  my_hash_update(&hash, (uchar*) records[14], (uchar*) key, strlen(key));
+  ok(count_dups(&hash, "key7") == 1 && count_dups(&hash, "OTHER") == 1,
+     "key of a record updated");
+
+  my_hash_delete(&hash, (uchar*) records[15]);
+  ok(count_dups(&hash, "key7") == 0, "records of a key deleted");
+
+  my_hash_free(&hash);
+  my_end(0);
+  return exit_status();
+}
@@ -0,0 +1,96 @@
+/* Copyright (c) 2018, MariaDB
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include <my_global.h>
+#include <m_string.h>
+#include <my_sys.h>
+#include <tap.h>
+
+enum key_kind { RANDOM_BYTES, FEW_LETTERS_PADDED, SMALL_INTEGERS, ALL_EQUAL };
+
+static const char *kind_name[]=
+{ "random bytes", "few letters, padded", "small integers", "all equal" };
+
+/*
+  Sort n keys of the given size with msd_radixsort_for_str_ptr()
+  and check that the result is in the same order as with my_qsort2().
+*/
+static void test_sort(uint n, size_t size, enum key_kind kind)
+{
+  uchar *data= (uchar*) malloc(n * size);
+  uchar **keys= (uchar**) malloc(n * sizeof(uchar*));
+  uchar **expected= (uchar**) malloc(n * sizeof(uchar*));
+  uchar **buffer= (uchar**) malloc(n * sizeof(uchar*));
+  uint i;
+  size_t j;
+  my_bool sorted= TRUE;
+
+  for (i= 0; i < n; i++)
+  {
+    uchar *key= data + i * size;
+    uint value= (uint) rand() % (n / 4 + 1);
+    for (j= 0; j < size; j++)
+    {
+      switch (kind) {
+      case RANDOM_BYTES:
+        key[j]= (uchar) rand();
+        break;
+      case FEW_LETTERS_PADDED:
+        key[j]= j < size / 3 ? "abcd"[rand() % 4] : ' ';
+        break;
+      case SMALL_INTEGERS:
+        key[j]= j + 4 < size ? 0 : (uchar) (value >> (8 * (size - 1 - j)));
+        break;
+      case ALL_EQUAL:
+        key[j]= 'x';
+        break;
+      }
+    }
+    keys[i]= expected[i]= key;
+  }
+
+  my_qsort2(expected, n, sizeof(uchar*), get_ptr_compare(size), &size);
+  msd_radixsort_for_str_ptr(keys, n, size, buffer);
+
+  for (i= 0; i < n && sorted; i++)
+    sorted= !memcmp(keys[i], expected[i], size);
+  ok(sorted, "%u keys of %u bytes, %s", n, (uint) size, kind_name[kind]);
+
+  free(buffer);
+  free(expected);
+  free(keys);
+  free(data);
+}
+
+int main(void)
+{
+  plan(12);
+  srand(1);
+
+  test_sort(1000, 4, RANDOM_BYTES);
+  test_sort(100000, 16, RANDOM_BYTES);
+  test_sort(20000, 1, RANDOM_BYTES);
+  test_sort(1000, 300, FEW_LETTERS_PADDED);
+  test_sort(50000, 64, FEW_LETTERS_PADDED);
+  test_sort(100000, 30, FEW_LETTERS_PADDED);
+  test_sort(1000, 4, SMALL_INTEGERS);
+  test_sort(200000, 8, SMALL_INTEGERS);
+  test_sort(50000, 20, SMALL_INTEGERS);
+  test_sort(1000, 10, ALL_EQUAL);
+  test_sort(10000, 200, ALL_EQUAL);
+  test_sort(63, 10, RANDOM_BYTES);
+
+  return exit_status();
+}
@@ -758,11 +758,87 @@ test_strcollsp()
 }
 
 
+typedef struct
+{
+  const char *str;
+  size_t len;
+  size_t nchars;        /* characters to scan */
+  size_t well_formed;   /* expected result of well_formed_char_length() */
+  size_t error_pos;     /* expected position of the bad byte, or len */
+  size_t charpos;       /* expected result of charpos() */
+} ASCII_RUN_PARAM;
+
+
+/*
+  Strings with ASCII runs longer and shorter than the 8 bytes that are
+  skipped at a time, mixed with multi-byte and bad characters.
+*/
+static ASCII_RUN_PARAM ascii_run_utf8mb4[]=
+{
+  {CSTR("abcdefghijklmnop"), 100, 16, 16, 18},
+  {CSTR("abcdefghijklmnop"),  10, 10, 16, 10},
+  {CSTR("abcdefghijklmnop"),   8,  8, 16,  8},
+  {CSTR("abcdefghi\xC3\xA4jklmnopq"),  100, 18, 19, 21},
+  {CSTR("abcdefghi\xC3\xA4jklmnopq"),   10, 10, 19, 11},
+  {CSTR("abcdefghi\xF0\x9F\x98\x80jklmnopq"), 100, 18, 21, 23},
+  {CSTR("abcdefghijk\xFFlmnopq"), 100, 11, 11, 20},
+  {CSTR("abcdefghijk\xC3"), 100, 11, 11, 14},
+  {NULL, 0, 0, 0, 0, 0}
+};
+
+
+static int
+test_ascii_runs(CHARSET_INFO *cs, const ASCII_RUN_PARAM *param)
+{
+  int failed= 0;
+  const ASCII_RUN_PARAM *p;
+  for (p= param; p->str; p++)
+  {
+    MY_STRCOPY_STATUS status;
+    size_t res= cs->cset->well_formed_char_length(cs, p->str, p->str + p->len,
+                                                  p->nchars, &status);
+    size_t error_pos= status.m_well_formed_error_pos ?
+                      (size_t) (status.m_well_formed_error_pos - p->str) :
+                      p->len;
+    size_t charpos= cs->cset->charpos(cs, p->str, p->str + p->len, p->nchars);
+    if (res != p->well_formed || error_pos != p->error_pos ||
+        charpos != p->charpos)
+    {
+      diag("%s nchars=%d: well_formed=%d error_pos=%d charpos=%d, "
+           "expected %d %d %d", cs->name, (int) p->nchars,
+           (int) res, (int) error_pos, (int) charpos,
+           (int) p->well_formed, (int) p->error_pos, (int) p->charpos);
+      failed++;
+    }
+  }
+  return failed;
+}
+
+
+/*
+  Test casedn() on ASCII, non-ASCII and characters that the collation
+  maps out of ASCII.
+*/
+static int
+test_casedn(CHARSET_INFO *cs, const char *src, size_t srclen,
+            const char *expected, size_t expected_len)
+{
+  char dst[64];
+  size_t len= cs->cset->casedn(cs, src, srclen, dst, sizeof(dst));
+  if (len != expected_len || memcmp(dst, expected, len))
+  {
+    diag("%s casedn() failed for '%.*s'", cs->name, (int) srclen, src);
+    return 1;
+  }
+  return 0;
+}
+
+
 int main()
 {
   size_t i, failed= 0;
   
-  plan(2);
+  plan(4);
   diag("Testing my_like_range_xxx() functions");
   
   for (i= 0; i < array_elements(charset_list); i++)
@@ -780,5 +856,28 @@ int main()
   failed= test_strcollsp();
   ok(failed == 0, "Testing cs->coll->strnncollsp()");
 
+  diag("Testing well_formed_char_length() and charpos() on ASCII runs");
+  failed= 0;
+#ifdef HAVE_CHARSET_utf8mb4
+  failed+= test_ascii_runs(&my_charset_utf8mb4_general_ci, ascii_run_utf8mb4);
+#endif
+  ok(failed == 0, "Testing well_formed_char_length() and charpos()");
+
+  diag("Testing casedn()");
+  failed= 0;
+#ifdef HAVE_CHARSET_utf8mb4
+  failed+= test_casedn(&my_charset_utf8mb4_general_ci,
+                       CSTR("ABCDEFGHIJ\xC3\x84KLM"),
+                       CSTR("abcdefghij\xC3\xA4klm"));
+  {
+    /* 'I' is lowercased to U+0131 LATIN SMALL LETTER DOTLESS I */
+    struct charset_info_st turkish= my_charset_utf8mb4_general_ci;
+    turkish.caseinfo= &my_unicase_turkish;
+    failed+= test_casedn(&turkish, CSTR("ABCDEFGHIJKLM"),
+                         CSTR("abcdefgh\xC4\xB1jklm"));
+  }
+#endif
+  ok(failed == 0, "Testing casedn()");
+
   return exit_status();
 }
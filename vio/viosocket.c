@@ -32,6 +32,9 @@
   #pragma comment(lib, "ws2_32.lib")
 #endif
 #include "my_context.h"
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
 #include <mysql_async.h>
 
 #ifdef FIONREAD_IN_SYS_FILIO
@@ -316,6 +319,47 @@ size_t vio_write(Vio *vio, const uchar* buf, size_t size)
   DBUG_RETURN(ret);
 }
 
+
+#ifndef _WIN32
+/**
+  Write the buffers of an I/O vector with a single system call.
+
+  Plain sockets are written with writev(). For other transports, e.g. SSL,
+  only the first buffer is written.
+
+  @return number of bytes written, which may be less than the total size
+          of the buffers, or -1 in case of error
+*/
+
+size_t vio_writev(Vio *vio, const struct iovec *iov, int iovcnt)
+{
+  ssize_t ret;
+  DBUG_ENTER("vio_writev");
+  DBUG_PRINT("enter", ("sd: %d  iovcnt: %d",
+                       (int)mysql_socket_getfd(vio->mysql_socket), iovcnt));
+
+  if ((vio->type != VIO_TYPE_TCPIP && vio->type != VIO_TYPE_SOCKET) ||
+      vio->async_context)
+    DBUG_RETURN(vio->write(vio, (const uchar*) iov[0].iov_base,
+                           iov[0].iov_len));
+
+  while ((ret= writev(mysql_socket_getfd(vio->mysql_socket), iov,
+                      iovcnt)) == -1)
+  {
+    int error= socket_errno;
+    /* The operation would block? */
+    if (error != SOCKET_EAGAIN && error != SOCKET_EWOULDBLOCK)
+      break;
+
+    /* Wait for the output buffer to become writable.*/
+    if ((ret= vio_socket_io_wait(vio, VIO_IO_EVENT_WRITE)))
+      break;
+  }
+  DBUG_PRINT("exit", ("%d", (int) ret));
+  DBUG_RETURN(ret);
+}
+#endif /* _WIN32 */
+
 int vio_socket_shutdown(Vio *vio, int how)
 {
   int ret= shutdown(mysql_socket_getfd(vio->mysql_socket), how);
@@ -461,6 +505,37 @@ int vio_nodelay(Vio *vio, my_bool on)
   DBUG_RETURN(r);
 }
 
+/*
+  Set TCP_CORK (send only full segments until it is cleared, and then
+  send the rest at once)
+*/
+int vio_cork(Vio *vio, my_bool on)
+{
+  int r= 0;
+  DBUG_ENTER("vio_cork");
+
+#ifdef TCP_CORK
+  if ((vio->type == VIO_TYPE_TCPIP || vio->type == VIO_TYPE_SSL) &&
+      vio->corked != MY_TEST(on))
+  {
+    int cork= MY_TEST(on);
+    r= mysql_socket_setsockopt(vio->mysql_socket, IPPROTO_TCP, TCP_CORK,
+                               (void*) &cork, sizeof(cork));
+    if (r)
+    {
+      DBUG_PRINT("warning",
+                 ("Couldn't set socket option TCP_CORK, error %d",
+                  socket_errno));
+      r= -1;
+    }
+    else
+      vio->corked= (my_bool) cork;
+  }
+#endif
+  DBUG_PRINT("exit", ("%d", r));
+  DBUG_RETURN(r);
+}
+
 int vio_fastsend(Vio * vio)
 {
   int r=0;